@@ -5,20 +5,24 @@
 #include <nlohmann/json.hpp>
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <SimpleAmqpClient/Channel.h>
+#include "EmotionWire.hpp"
+#include "Logger.hpp"
 #include <filesystem>
 #include <fstream>
-#include <iostream>
+#include <sstream>
 #include <iomanip>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <cstdlib>
 
 using json = nlohmann::json;
 using MatrixXd = Eigen::MatrixXd;
 using VectorXd = Eigen::VectorXd;
 
-// Structure du modèle (inchangée, identique à l'original)
+// Structure du modèle (paramètres bruts lus depuis model.json)
 struct Model {
     MatrixXd W_reg;
     VectorXd b_reg;
@@ -30,9 +34,8 @@ struct Model {
     std::vector<int> rareEmotionIndices;
     int polyDegree;
 
+    // Prédiction de référence (chemin non fusionné), utilisée pour valider CompiledModel
     std::unordered_map<std::string, double> predict(const std::unordered_map<std::string, double>& input) const {
-        std::cout << "Début de predict: input.size() = " << input.size() << ", dimNames.size() = " << dimNames.size() << "\n";
-
         for (const auto& dim : dimNames) {
             if (!input.count(dim)) {
                 throw std::runtime_error("Dimension manquante dans l'input : " + dim);
@@ -42,14 +45,8 @@ struct Model {
         VectorXd x(dimNames.size());
         for (size_t i = 0; i < dimNames.size(); ++i) {
             x(i) = input.at(dimNames[i]);
-            std::cout << "x[" << i << "] = " << x(i) << " (" << dimNames[i] << ")\n";
         }
 
-        std::cout << "x.size() = " << x.size() << ", xMean.size() = " << xMean.size() << ", xStd.size() = " << xStd.size() << "\n";
-        std::cout << "x: " << x.transpose() << "\n";
-        std::cout << "xMean: " << xMean.transpose() << "\n";
-        std::cout << "xStd: " << xStd.transpose() << "\n";
-
         if (x.size() != xMean.size() || x.size() != xStd.size()) {
             throw std::runtime_error("Incohérence dans les dimensions : x=" + std::to_string(x.size()) + ", xMean=" + std::to_string(xMean.size()) + ", xStd=" + std::to_string(xStd.size()));
         }
@@ -61,10 +58,7 @@ struct Model {
         }
 
         VectorXd xNorm = (x - xMean).cwiseQuotient(xStd);
-        std::cout << "xNorm: " << xNorm.transpose() << "\n";
-
         VectorXd xProj = pcaComponents.transpose() * xNorm;
-        std::cout << "xProj: " << xProj.transpose() << "\n";
 
         VectorXd xPoly(polyDimNames.size());
         int idx = 0;
@@ -90,13 +84,8 @@ struct Model {
             throw std::runtime_error("Incohérence dans la taille des features polynomiales : attendu " + std::to_string(W_reg.rows()) + ", obtenu " + std::to_string(idx));
         }
 
-        std::cout << "xPoly: " << xPoly.transpose() << "\n";
-
         VectorXd yStdPred = W_reg.transpose() * xPoly + b_reg;
-        std::cout << "yStdPred: " << yStdPred.transpose() << "\n";
-
         VectorXd y = yStdPred.cwiseProduct(yStd) + yMean;
-        std::cout << "y: " << y.transpose() << "\n";
 
         std::unordered_map<std::string, double> res;
         for (size_t i = 0; i < emoNames.size(); ++i) {
@@ -108,6 +97,114 @@ struct Model {
     }
 };
 
+// Modèle compilé : standardisation → ACP → polynôme → régression → déstandardisation
+// précalculés en matrices. Une ligne d'entrée = une trame ; un lot de N trames
+// est prédit en une (degré 1) ou deux (degré 2) multiplications matricielles,
+// sans allocation une fois l'espace de travail dimensionné.
+struct CompiledModel {
+    using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    int nDims = 0;
+    int nProj = 0;
+    int nFeatures = 0;
+    int nEmotions = 0;
+    int polyDegree = 1;
+
+    // Degré 1 : Y = X·A + c (chaîne entièrement affine, fusionnée)
+    // Degré 2 : P = X·A + c ; Y = [P, P², Pi·Pj]·B + d
+    MatrixXd A;
+    Eigen::RowVectorXd c;
+    MatrixXd B;
+    Eigen::RowVectorXd d;
+
+    // Espace de travail préalloué pour un lot de taille maximale donnée
+    struct Workspace {
+        RowMatrix input;      // N × nDims (rempli par l'appelant)
+        RowMatrix proj;       // N × nProj (degré 2)
+        RowMatrix features;   // N × nFeatures (degré 2)
+        RowMatrix output;     // N × nEmotions
+
+        Workspace(const CompiledModel& m, int capacity)
+            : input(capacity, m.nDims)
+            , proj(m.polyDegree == 1 ? 0 : capacity, m.nProj)
+            , features(m.polyDegree == 1 ? 0 : capacity, m.nFeatures)
+            , output(capacity, m.nEmotions) {}
+
+        [[nodiscard]] int capacity() const { return static_cast<int>(input.rows()); }
+    };
+
+    static CompiledModel compile(const Model& m) {
+        CompiledModel cm;
+        cm.nDims = static_cast<int>(m.dimNames.size());
+        cm.nProj = static_cast<int>(m.pcaComponents.cols());
+        cm.nFeatures = static_cast<int>(m.W_reg.rows());
+        cm.nEmotions = static_cast<int>(m.emoNames.size());
+        cm.polyDegree = m.polyDegree;
+
+        if (m.pcaComponents.rows() != cm.nDims) {
+            throw std::runtime_error("Incohérence ACP : " + std::to_string(m.pcaComponents.rows()) + " lignes pour " + std::to_string(cm.nDims) + " dimensions");
+        }
+        for (int i = 0; i < m.xStd.size(); ++i) {
+            if (m.xStd(i) <= 1e-6) {
+                throw std::runtime_error("xStd[" + std::to_string(i) + "] = " + std::to_string(m.xStd(i)) + " est nul ou négatif");
+            }
+        }
+        int expected = cm.polyDegree == 1 ? cm.nProj : 2 * cm.nProj + cm.nProj * (cm.nProj - 1) / 2;
+        if (expected != cm.nFeatures) {
+            throw std::runtime_error("Incohérence dans la taille des features polynomiales : attendu " + std::to_string(cm.nFeatures) + ", obtenu " + std::to_string(expected));
+        }
+
+        // Standardisation + ACP : xProj = (x - μ)/σ · P = x·G - μ·G
+        MatrixXd G = m.xStd.cwiseInverse().asDiagonal() * m.pcaComponents;
+        Eigen::RowVectorXd g0 = -(m.xMean.transpose() * G);
+
+        // Régression + déstandardisation : y = f·W·diag(yStd) + b∘yStd + yMean
+        MatrixXd Wy = m.W_reg * m.yStd.asDiagonal();
+        Eigen::RowVectorXd by = m.b_reg.cwiseProduct(m.yStd).transpose() + m.yMean.transpose();
+
+        if (cm.polyDegree == 1) {
+            cm.A = G * Wy;
+            cm.c = g0 * Wy + by;
+        } else {
+            cm.A = G;
+            cm.c = g0;
+            cm.B = Wy;
+            cm.d = by;
+        }
+        return cm;
+    }
+
+    // Prédit les `rows` premières lignes de ws.input dans ws.output (valeurs bornées à [0, 1])
+    void predictBatch(Workspace& ws, int rows) const {
+        auto X = ws.input.topRows(rows);
+        auto Y = ws.output.topRows(rows);
+
+        if (polyDegree == 1) {
+            Y.noalias() = X * A;
+            Y.rowwise() += c;
+        } else {
+            auto P = ws.proj.topRows(rows);
+            auto F = ws.features.topRows(rows);
+            P.noalias() = X * A;
+            P.rowwise() += c;
+
+            F.leftCols(nProj) = P;
+            F.middleCols(nProj, nProj) = P.cwiseProduct(P);
+            int col = 2 * nProj;
+            for (int i = 0; i < nProj; ++i) {
+                for (int j = i + 1; j < nProj; ++j) {
+                    F.col(col++) = P.col(i).cwiseProduct(P.col(j));
+                }
+            }
+
+            Y.noalias() = F * B;
+            Y.rowwise() += d;
+        }
+
+        Y = Y.cwiseMax(0.0).cwiseMin(1.0);
+    }
+};
+
 // Charger le modèle depuis model.json (inchangé, identique à l'original)
 Model load_model(const std::string& path) {
     std::ifstream f(path);
@@ -168,17 +265,94 @@ Model load_model(const std::string& path) {
     m.rareEmotionIndices = j["rare_emotion_indices"].get<std::vector<int>>();
     m.polyDegree = j["poly_degree"].get<int>();
 
-    std::cout << "Modèle chargé : " << m.dimNames.size() << " dimensions, " << m.polyDimNames.size() << " features polynomiales, " << m.emoNames.size() << " émotions\n";
+    MCEE_LOG_INFO("Emotion", "Modèle chargé : ", m.dimNames.size(), " dimensions, ", m.polyDimNames.size(),
+                  " features polynomiales, ", m.emoNames.size(), " émotions");
     return m;
 }
 
+// Remplit une ligne d'entrée depuis le message ; false si une dimension est absente ou invalide
+bool fill_input_row(const json& input_json, const Model& model, CompiledModel::RowMatrix& input, int row) {
+    for (size_t i = 0; i < model.dimNames.size(); ++i) {
+        const auto& dim = model.dimNames[i];
+        auto it = input_json.find(dim);
+        if (it == input_json.end()) {
+            MCEE_LOG_WARN("Emotion", "Dimension manquante : ", dim);
+            return false;
+        }
+        if (!it->is_number()) {
+            MCEE_LOG_WARN("Emotion", "Type invalide pour ", dim);
+            return false;
+        }
+        double v = it->get<double>();
+        if (v < 0.0 || v > 1.0) {
+            MCEE_LOG_WARN("Emotion", "Valeur hors limites pour ", dim, ": ", v);
+            return false;
+        }
+        input(row, static_cast<Eigen::Index>(i)) = v;
+    }
+    return true;
+}
+
 int main() {
+    // Journal asynchrone : MCEE_LOG_LEVEL / MCEE_LOG_FORMAT / MCEE_LOG_FILE
+    mcee::LoggerConfig log_config;
+    if (std::getenv("EMOTION_VERBOSE") != nullptr) {
+        log_config.level = mcee::LogLevel::DEBUG;  // Ancien mode verbeux
+    }
+    mcee::Logger::instance().configureFromEnv(log_config);
+
     try {
         // Chemins des fichiers
         const std::string model_path = "model.json";
 
         // Charger le modèle
         Model model = load_model(model_path);
+        CompiledModel compiled = CompiledModel::compile(model);
+
+        // Taille maximale d'un lot et prefetch QoS du consommateur (prefetch ≥ lot)
+        int batch_max = 64;
+        if (const char* env = std::getenv("EMOTION_BATCH_MAX")) {
+            batch_max = std::max(1, std::atoi(env));
+        }
+        int prefetch = batch_max;
+        if (const char* env = std::getenv("EMOTION_PREFETCH")) {
+            prefetch = std::max(1, std::atoi(env));
+        }
+        batch_max = std::min(batch_max, prefetch);
+
+        // Format de sortie : JSON (défaut, débogage) ou trame binaire EmotionWire (f32 / f64)
+        bool binary_wire = false;
+        mcee::WirePrecision wire_precision = mcee::WirePrecision::FLOAT32;
+        if (const char* env = std::getenv("EMOTION_WIRE")) {
+            std::string format = env;
+            binary_wire = (format == "f32" || format == "f64");
+            if (format == "f64") {
+                wire_precision = mcee::WirePrecision::FLOAT64;
+            }
+        }
+
+        CompiledModel::Workspace workspace(compiled, batch_max);
+
+        // Vérification du chemin compilé contre la prédiction de référence
+        {
+            std::unordered_map<std::string, double> probe;
+            for (size_t i = 0; i < model.dimNames.size(); ++i) {
+                double v = 0.25 + 0.5 * static_cast<double>(i) / std::max<size_t>(1, model.dimNames.size());
+                probe[model.dimNames[i]] = v;
+                workspace.input(0, static_cast<Eigen::Index>(i)) = v;
+            }
+            auto ref = model.predict(probe);
+            compiled.predictBatch(workspace, 1);
+            double max_err = 0.0;
+            for (size_t e = 0; e < model.emoNames.size(); ++e) {
+                max_err = std::max(max_err, std::abs(ref.at(model.emoNames[e]) - workspace.output(0, static_cast<Eigen::Index>(e))));
+            }
+            if (max_err > 1e-9) {
+                throw std::runtime_error("Modèle compilé incohérent avec la référence (écart " + std::to_string(max_err) + ")");
+            }
+            MCEE_LOG_INFO("Emotion", "Modèle compilé (degré ", compiled.polyDegree, ", lot max ", batch_max,
+                          ", prefetch ", prefetch, ")");
+        }
 
         // Connexion à RabbitMQ
         AmqpClient::Channel::OpenOpts opts;
@@ -204,7 +378,7 @@ int main() {
         const std::string mcee_queue = "mcee_emotions_queue";
         channel->DeclareQueue(mcee_queue, false, true, false, false);  // durable=true
         channel->BindQueue(mcee_queue, output_exchange, routing_key);
-        std::cout << "[Emotion] Queue MCEE créée/vérifiée: " << mcee_queue << "\n";
+        MCEE_LOG_INFO("Emotion", "Queue MCEE créée/vérifiée: ", mcee_queue);
 
         // Liste des émotions dans l'ordre
         std::vector<std::string> ordered_emo = {
@@ -215,11 +389,43 @@ int main() {
             "Soulagement", "Tristesse", "Satisfaction", "Sympathie", "Triomphe"
         };
 
-        std::cout << "En attente de messages RabbitMQ sur la queue " << input_queue << "...\n";
+        // Colonne de sortie du modèle pour chaque émotion publiée
+        std::vector<Eigen::Index> output_column;
+        for (const auto& emo : ordered_emo) {
+            auto it = std::find(model.emoNames.begin(), model.emoNames.end(), emo);
+            if (it == model.emoNames.end()) {
+                throw std::runtime_error("Émotion absente du modèle : " + emo);
+            }
+            output_column.push_back(static_cast<Eigen::Index>(it - model.emoNames.begin()));
+        }
+
+        MCEE_LOG_INFO("Emotion", "Format de sortie : ",
+                      (binary_wire ? mcee::WIRE_CONTENT_TYPE_FRAME : mcee::WIRE_CONTENT_TYPE_JSON));
+        MCEE_LOG_INFO("Emotion", "En attente de messages RabbitMQ sur la queue ", input_queue, "...");
+
+        // Consommateur de messages (les trames déjà livrées sont prédites ensemble)
+        std::string consumer_tag = channel->BasicConsume(input_queue, "", true, false, false, prefetch);
 
-        // Consommateur de messages
-        // Consommateur de messages
-    std::string consumer_tag = channel->BasicConsume(input_queue, "", true, false, false, 1); // Changed no_ack to false explicitly
+        std::vector<AmqpClient::Envelope::ptr_t> batch;
+        batch.reserve(batch_max);
+
+        // Ajoute un message au lot courant (acquitté et ignoré s'il est invalide)
+        auto enqueue = [&](const AmqpClient::Envelope::ptr_t& envelope) {
+            const std::string& msg_str = envelope->Message()->Body();
+            json input_json = json::parse(msg_str, nullptr, false);
+            if (input_json.is_discarded() || !input_json.is_object()) {
+                MCEE_LOG_WARN("Emotion", "Erreur de parsing JSON, message ignoré");
+                channel->BasicAck(envelope); // Acquitter même en cas d'erreur
+                return;
+            }
+
+            if (!fill_input_row(input_json, model, workspace.input, static_cast<int>(batch.size()))) {
+                MCEE_LOG_WARN("Emotion", "Message JSON invalide, ignoré");
+                channel->BasicAck(envelope); // Acquitter le message
+                return;
+            }
+            batch.push_back(envelope);
+        };
 
     while (true) {
         // Recevoir un message RabbitMQ
@@ -229,99 +435,83 @@ int main() {
             continue; // Pas de message, continuer
         }
 
-        try {
-            // Convertir le message en JSON
-            std::string msg_str(envelope->Message()->Body().begin(), envelope->Message()->Body().end());
-            std::cout << "Message brut reçu : " << msg_str << "\n";
-            json input_json;
-            try {
-                input_json = json::parse(msg_str);
-            } catch (const json::parse_error& e) {
-                std::cerr << "Erreur de parsing JSON : " << e.what() << "\n";
-                channel->BasicAck(envelope); // Acquitter même en cas d'erreur
-                continue;
-            }
+        batch.clear();
+        enqueue(envelope);
 
-            // Extraire les 14 dimensions
-            std::unordered_map<std::string, double> dims;
-            bool valid_input = true;
-            for (const auto& dim : model.dimNames) {
-                if (input_json.contains(dim)) {
-                    try {
-                        dims[dim] = input_json[dim].get<double>();
-                        if (dims[dim] < 0.0 || dims[dim] > 1.0) {
-                            std::cerr << "Valeur hors limites pour " << dim << ": " << dims[dim] << "\n";
-                            valid_input = false;
-                            break;
-                        }
-                    } catch (const json::type_error& e) {
-                        std::cerr << "Type invalide pour " << dim << ": " << e.what() << "\n";
-                        valid_input = false;
-                        break;
+        // Drainer sans attendre les trames déjà livrées (jusqu'à batch_max)
+        while (static_cast<int>(batch.size()) < batch_max &&
+               channel->BasicConsumeMessage(consumer_tag, envelope, 0) && envelope) {
+            enqueue(envelope);
+        }
+
+        if (batch.empty()) {
+            continue;
+        }
+
+        try {
+            // Faire la prédiction du lot
+            const int rows = static_cast<int>(batch.size());
+            compiled.predictBatch(workspace, rows);
+
+            const int64_t timestamp_ms = mcee::wireNowMs();
+
+            for (int r = 0; r < rows; ++r) {
+                // Préparer le message pour la centrale émotionnelle
+                AmqpClient::BasicMessage::ptr_t message;
+                if (binary_wire) {
+                    mcee::EmotionFrame frame;
+                    frame.timestamp_ms = timestamp_ms;
+                    for (size_t k = 0; k < ordered_emo.size() && k < mcee::WIRE_EMOTION_COUNT; ++k) {
+                        frame.emotions[k] = workspace.output(r, output_column[k]);
                     }
+                    message = AmqpClient::BasicMessage::Create(mcee::encodeEmotionFrame(frame, wire_precision));
+                    message->ContentType(mcee::WIRE_CONTENT_TYPE_FRAME);
                 } else {
-                    std::cerr << "Dimension manquante : " << dim << "\n";
-                    valid_input = false;
-                    break;
+                    json output_json;
+                    for (size_t k = 0; k < ordered_emo.size(); ++k) {
+                        output_json[ordered_emo[k]] = workspace.output(r, output_column[k]);
+                    }
+                    message = AmqpClient::BasicMessage::Create(output_json.dump());
+                    message->ContentType(mcee::WIRE_CONTENT_TYPE_JSON);
                 }
-            }
-
-            if (!valid_input) {
-                std::cerr << "Message JSON invalide, ignoré\n";
-                channel->BasicAck(envelope); // Acquitter le message
-                continue;
-            }
-
-            // Afficher les dimensions reçues
-            std::cout << "\n=== Nouveau message reçu ===\n";
-            std::cout << "Dimensions d'entrée :\n";
-            for (const auto& dim : model.dimNames) {
-                std::cout << std::setw(15) << std::left << dim << " : " << std::fixed << std::setprecision(3) << dims[dim] << "\n";
-            }
-            std::cout << "\n";
 
-            // Faire la prédiction
-            auto pred = model.predict(dims);
-
-            // Préparer le message JSON pour la centrale émotionnelle
-            json output_json;
-            for (const auto& emo : ordered_emo) {
-                output_json[emo] = pred.at(emo);
-            }
+                if (mcee::Logger::instance().shouldLog(mcee::LogLevel::DEBUG)) {
+                    std::ostringstream predictions;
+                    predictions << std::fixed << std::setprecision(3);
+                    for (size_t k = 0; k < ordered_emo.size(); ++k) {
+                        predictions << (k ? ", " : "") << ordered_emo[k] << "=" << workspace.output(r, output_column[k]);
+                    }
+                    MCEE_LOG_DEBUG("Emotion", "Prédictions : ", predictions.str());
+                }
 
-            // Afficher les prédictions
-            std::cout << "Prédictions des émotions :\n";
-            std::cout << std::setw(30) << std::left << "Émotion" << " | " << std::setw(10) << "Prédite" << "\n";
-            std::cout << std::string(50, '-') << "\n";
-            for (const auto& emo : ordered_emo) {
-                std::cout << std::setw(30) << std::left << emo << " | "
-                          << std::fixed << std::setprecision(3) << pred.at(emo) << "\n";
+                // Envoyer les prédictions via RabbitMQ
+                channel->BasicPublish(
+                    output_exchange,
+                    routing_key,
+                    message,
+                    false, // Non obligatoire
+                    false  // Non persistant
+                );
             }
 
-            // Envoyer les prédictions via RabbitMQ
-            std::string output_str = output_json.dump();
-            channel->BasicPublish(
-                output_exchange,
-                routing_key,
-                AmqpClient::BasicMessage::Create(output_str),
-                false, // Non obligatoire
-                false  // Non persistant
-            );
-
-            std::cout << "\nPrédictions envoyées à la centrale émotionnelle via RabbitMQ\n";
+            // Acquitter tout le lot en une fois (delivery tags croissants sur ce channel)
+            channel->BasicAck(batch.back()->GetDeliveryInfo(), true);
 
-            // Acquitter le message reçu
-            channel->BasicAck(envelope);
+            MCEE_LOG_DEBUG("Emotion", "Lot de ", rows, " prédiction(s) envoyé à la centrale émotionnelle");
         } catch (const std::exception& e) {
-            std::cerr << "Erreur lors du traitement du message : " << e.what() << "\n";
-            channel->BasicReject(envelope, true); // Rejeter et remettre en queue
+            MCEE_LOG_ERROR("Emotion", "Erreur lors du traitement du lot : ", e.what());
+            for (const auto& env : batch) {
+                try {
+                    channel->BasicReject(env, true); // Rejeter et remettre en queue
+                } catch (...) {}
+            }
             continue;
         }
     }
     } catch (const std::exception& e) {
-        std::cerr << "\nErreur : " << e.what() << "\n";
+        MCEE_LOG_ERROR("Emotion", "Erreur : ", e.what());
         return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,994 @@
+/**
+ * @file mcee_bench.cpp
+ * @brief Micro- et macro-benchmarks des chemins critiques du MCEE
+ *
+ * Charges synthétiques reproductibles (graine fixe), sans RabbitMQ ni
+ * Neo4j : MCT, MLT (10 / 1k / 100k patterns, chargement snapshot / JSON),
+ * PatternMatcher, PhaseDetector, MCTGraph, EmotionUpdater, ADDO, MemoryManager, voie rapide d'urgence,
+ * prompts et cache LLM (sans réseau) et rejeu du pipeline complet
+ * depuis une trace de trames.
+ *
+ * Usage :
+ *   mcee_bench [--filter <sous-chaîne>] [--min-time-ms <ms>] [--json <fichier>]
+ *              [--trace <fichier.jsonl>] [--write-trace <fichier.jsonl>] [--frames <n>]
+ *
+ * La trace est au format des messages de la file émotions : un objet JSON
+ * { "Joie": 0.4, ... } par ligne. La sortie JSON reprend le schéma de
+ * Google Benchmark (name, iterations, real_time, time_unit) pour être
+ * exploitée par les mêmes outils de suivi. Le journal des moteurs est
+ * limité à WARN (MCEE_LOG_LEVEL pour mesurer avec un autre niveau).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#include "ADDOEngine.hpp"
+#include "EmergencyLane.hpp"
+#include "EmotionUpdater.hpp"
+#include "Executor.hpp"
+#include "JsonScanner.hpp"
+#include "LLMClient.hpp"
+#include "LLMResponseCache.hpp"
+#include "Logger.hpp"
+#include "MCEEEngine.hpp"
+#include "MCT.hpp"
+#include "MCTGraph.hpp"
+#include "MLT.hpp"
+#include "MemoryManager.hpp"
+#include "PatternMatcher.hpp"
+#include "PhaseDetector.hpp"
+#include "SemanticIndex.hpp"
+#include "SpeechInput.hpp"
+#include "Types.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mcee;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint32_t SEED = 42;
+
+// Empêche le compilateur d'éliminer les résultats mesurés
+volatile double g_sink = 0.0;
+
+struct BenchOptions {
+    std::string filter;
+    double min_time_ms = 200.0;
+    std::string json_path;
+    std::string trace_path;
+    std::string write_trace_path;
+    size_t frames = 2000;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double mean_ns = 0.0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    double min_ns = 0.0;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HARNAIS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class BenchRunner
+ * @brief Mesure par échantillons : chaque échantillon chronomètre un lot
+ *        d'appels, jusqu'à min_time_ms cumulées
+ */
+class BenchRunner {
+public:
+    explicit BenchRunner(const BenchOptions& options) : options_(options) {}
+
+    [[nodiscard]] bool enabled(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    /**
+     * @param op Opération mesurée (un appel = une itération)
+     * @param batch Appels par échantillon (opérations très courtes)
+     */
+    void run(const std::string& name, const std::function<void()>& op, size_t batch = 1) {
+        if (!enabled(name)) return;
+
+        using clock = std::chrono::steady_clock;
+        std::vector<double> samples;
+        double total_ns = 0.0;
+        uint64_t iterations = 0;
+
+        // Échauffement (caches, allocations initiales)
+        for (size_t i = 0; i < batch; ++i) op();
+
+        while (total_ns < options_.min_time_ms * 1e6 || samples.size() < 5) {
+            auto t0 = clock::now();
+            for (size_t i = 0; i < batch; ++i) op();
+            double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+            samples.push_back(ns / static_cast<double>(batch));
+            total_ns += ns;
+            iterations += batch;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.mean_ns = total_ns / static_cast<double>(iterations);
+        result.p50_ns = samples[samples.size() / 2];
+        result.p99_ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        result.min_ns = samples.front();
+        results_.push_back(result);
+
+        std::cout << std::left << std::setw(44) << name << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(1) << result.mean_ns << " ns"
+                  << "  p50=" << result.p50_ns << "  p99=" << result.p99_ns
+                  << "  (" << iterations << " it)" << std::endl;
+    }
+
+    /**
+     * @brief Exécute une préparation coûteuse sans la journaliser
+     */
+    void quietly(const std::function<void()>& fn) {
+        LogLevel saved = Logger::instance().level();
+        Logger::instance().setLevel(LogLevel::OFF);
+        fn();
+        Logger::instance().setLevel(saved);
+    }
+
+    [[nodiscard]] json toJson() const {
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        json out;
+        out["context"] = {
+            {"date", date},
+            {"executable", "mcee_bench"},
+            {"mcee_version", "3.0"},
+            {"num_cpus", std::thread::hardware_concurrency()},
+            {"compiler", __VERSION__},
+#if defined(__AVX2__)
+            {"simd", "avx2"},
+#elif defined(__ARM_NEON)
+            {"simd", "neon"},
+#else
+            {"simd", "scalar"},
+#endif
+#ifdef NDEBUG
+            {"library_build_type", "release"},
+#else
+            {"library_build_type", "debug"},
+#endif
+            {"seed", SEED}
+        };
+        out["benchmarks"] = json::array();
+        for (const auto& r : results_) {
+            out["benchmarks"].push_back({
+                {"name", r.name},
+                {"run_type", "iteration"},
+                {"iterations", r.iterations},
+                {"real_time", r.mean_ns},
+                {"cpu_time", r.mean_ns},
+                {"time_unit", "ns"},
+                {"p50", r.p50_ns},
+                {"p99", r.p99_ns},
+                {"min", r.min_ns}
+            });
+        }
+        return out;
+    }
+
+private:
+    BenchOptions options_;
+    std::vector<BenchResult> results_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHARGES SYNTHÉTIQUES
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Marche aléatoire bornée sur les 24 émotions
+ */
+class StateGenerator {
+public:
+    explicit StateGenerator(uint32_t seed) : rng_(seed) {
+        for (auto& v : current_) v = uniform_(rng_) * 0.5;
+    }
+
+    EmotionalState next() {
+        std::normal_distribution<double> step(0.0, 0.05);
+        EmotionalState state;
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            current_[i] = std::clamp(current_[i] + step(rng_), 0.0, 1.0);
+            state.emotions[i] = current_[i];
+        }
+        return state;
+    }
+
+    EmotionalSignature signature() {
+        EmotionalSignature sig{};
+        double sum = 0.0;
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            sig.mean_emotions[i] = uniform_(rng_);
+            sig.std_dev[i] = uniform_(rng_) * 0.1;
+            sum += sig.mean_emotions[i];
+        }
+        sig.global_intensity = sum / NUM_EMOTIONS;
+        sig.global_valence = uniform_(rng_) * 2.0 - 1.0;
+        sig.global_arousal = uniform_(rng_);
+        sig.stability = uniform_(rng_);
+        return sig;
+    }
+
+private:
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+    std::array<double, NUM_EMOTIONS> current_{};
+};
+
+using RawFrame = std::unordered_map<std::string, double>;
+
+std::vector<RawFrame> syntheticTrace(size_t frames) {
+    StateGenerator gen(SEED);
+    std::vector<RawFrame> trace;
+    trace.reserve(frames);
+    for (size_t f = 0; f < frames; ++f) {
+        EmotionalState state = gen.next();
+        RawFrame raw;
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            raw[EMOTION_NAMES[i]] = state.emotions[i];
+        }
+        trace.push_back(std::move(raw));
+    }
+    return trace;
+}
+
+std::vector<RawFrame> loadTrace(const std::string& path) {
+    std::vector<RawFrame> trace;
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("trace introuvable: " + path);
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        json j = json::parse(line);
+        RawFrame raw;
+        for (const auto& name : EMOTION_NAMES) {
+            raw[name] = j.contains(name) ? j[name].get<double>() : 0.0;
+        }
+        trace.push_back(std::move(raw));
+    }
+    return trace;
+}
+
+void writeTrace(const std::string& path, const std::vector<RawFrame>& trace) {
+    std::ofstream file(path);
+    for (const auto& raw : trace) {
+        json j(raw);
+        file << j.dump() << "\n";
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// BENCHMARKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void benchMCT(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 4096; ++i) states.push_back(gen.next());
+
+    MCTConfig config;
+    config.log_validation_errors = false;
+    MCT mct(config);
+    size_t cursor = 0;
+
+    runner.run("MCT/push", [&]() {
+        mct.push(states[cursor++ & 4095]);
+    }, 64);
+
+    runner.run("MCT/integrate", [&]() {
+        g_sink = g_sink + mct.integrate().stability;
+    });
+
+    runner.run("MCT/extractSignature", [&]() {
+        auto sig = mct.extractSignature();
+        if (sig) g_sink = g_sink + sig->global_intensity;
+    });
+}
+
+void benchMLT(BenchRunner& runner) {
+    for (size_t count : {size_t(10), size_t(1000), size_t(100000)}) {
+        std::string name = "MLT/findBestMatch/" + std::to_string(count);
+        if (!runner.enabled(name)) continue;
+
+        StateGenerator gen(SEED + static_cast<uint32_t>(count));
+        MLTConfig config;
+        config.max_patterns = count;
+        auto mlt = std::make_shared<MLT>(config);
+        runner.quietly([&]() {
+            for (size_t i = mlt->patternCount(); i < count; ++i) {
+                mlt->createPattern(gen.signature(), "bench_" + std::to_string(i));
+            }
+        });
+
+        std::vector<EmotionalSignature> queries;
+        for (size_t i = 0; i < 256; ++i) queries.push_back(gen.signature());
+        size_t cursor = 0;
+
+        runner.run(name, [&]() {
+            auto match = mlt->findBestMatch(queries[cursor++ & 255]);
+            if (match) g_sink = g_sink + match->similarity;
+        }, count >= 100000 ? 1 : 16);
+    }
+}
+
+void benchMLTMerge(BenchRunner& runner) {
+    for (size_t count : {size_t(1000), size_t(5000)}) {
+        std::string name = "MLT/findMergeCandidates/" + std::to_string(count);
+        if (!runner.enabled(name)) continue;
+
+        StateGenerator gen(SEED + static_cast<uint32_t>(count));
+        MLTConfig config;
+        config.max_patterns = count;
+        config.min_activations_for_fusion = 0;
+        auto mlt = std::make_shared<MLT>(config);
+        runner.quietly([&]() {
+            for (size_t i = mlt->patternCount(); i < count; ++i) {
+                mlt->createPattern(gen.signature(), "bench_" + std::to_string(i));
+            }
+        });
+
+        runner.run(name, [&]() {
+            g_sink = g_sink + static_cast<double>(mlt->findMergeCandidates().size());
+        }, 1);
+    }
+}
+
+void benchMLTPersistence(BenchRunner& runner) {
+    const size_t count = 10000;
+    const bool wanted = runner.enabled("MLT/loadSnapshot/10000") || runner.enabled("MLT/loadJson/10000");
+    if (!wanted) return;
+
+    StateGenerator gen(SEED);
+    MLTConfig config;
+    config.max_patterns = count;
+    MLT mlt(config);
+    for (size_t i = mlt.patternCount(); i < count; ++i) {
+        mlt.createPattern(gen.signature(), "bench_" + std::to_string(i));
+    }
+
+    const std::string snapshot_path = "mcee_bench_patterns.mltp";
+    const std::string json_path = "mcee_bench_patterns.json";
+    mlt.saveSnapshot(snapshot_path);
+    mlt.exportJson(json_path);
+
+    runner.run("MLT/loadSnapshot/10000", [&]() {
+        MLT loaded(config);
+        if (loaded.loadFromFile(snapshot_path)) g_sink = g_sink + static_cast<double>(loaded.patternCount());
+    }, 1);
+
+    runner.run("MLT/loadJson/10000", [&]() {
+        MLT loaded(config);
+        if (loaded.loadFromFile(json_path)) g_sink = g_sink + static_cast<double>(loaded.patternCount());
+    }, 1);
+
+    std::remove(snapshot_path.c_str());
+    std::remove(json_path.c_str());
+}
+
+void benchPatternMatcher(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    MCTConfig mct_config;
+    mct_config.log_validation_errors = false;
+
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 1024; ++i) states.push_back(gen.next());
+
+    if (runner.enabled("PatternMatcher/match")) {
+        auto mct = std::make_shared<MCT>(mct_config);
+        auto mlt = std::make_shared<MLT>();
+        PatternMatcher matcher(mct, mlt);
+        size_t cursor = 0;
+
+        runner.quietly([&]() {
+            for (size_t i = 0; i < 60; ++i) mct->push(states[i]);
+        });
+
+        runner.run("PatternMatcher/match", [&]() {
+            mct->push(states[cursor++ & 1023]);
+            g_sink = g_sink + matcher.match().similarity;
+        });
+    }
+
+    // Régime stable : la signature ne bouge pas, le matching incrémental
+    // réutilise le dernier résultat ; "/full" mesure le scan complet
+    for (bool incremental : {true, false}) {
+        std::string name = incremental ? "PatternMatcher/match/steady" : "PatternMatcher/match/steady/full";
+        if (!runner.enabled(name)) continue;
+
+        auto mct = std::make_shared<MCT>(mct_config);
+        auto mlt = std::make_shared<MLT>();
+        PatternMatcherConfig config;
+        config.incremental_matching = incremental;
+        PatternMatcher matcher(mct, mlt, config);
+        const EmotionalState& steady = states[0];
+
+        runner.quietly([&]() {
+            for (size_t i = 0; i < 60; ++i) mct->push(steady);
+            matcher.match();
+        });
+
+        runner.run(name, [&]() {
+            mct->push(steady);
+            g_sink = g_sink + matcher.match().similarity;
+        });
+    }
+}
+
+void benchPhaseDetector(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 1024; ++i) states.push_back(gen.next());
+    size_t cursor = 0;
+
+    std::unique_ptr<PhaseDetector> detector;
+    runner.quietly([&]() { detector = std::make_unique<PhaseDetector>(0.15, 0.0); });
+
+    runner.run("PhaseDetector/detectPhase", [&]() {
+        // Durée minimale nulle : les transitions (et l'hystérésis) sont exercées
+        g_sink = g_sink + static_cast<double>(detector->detectPhase(states[cursor++ & 1023]));
+    }, 64);
+
+    std::vector<PhaseDetector::PhaseScores> scores(states.size());
+    runner.run("PhaseDetector/scorePhases/1024", [&]() {
+        PhaseDetector::scorePhases(states, scores);
+        g_sink = g_sink + scores.back()[Phase::SERENITE];
+    });
+}
+
+void benchMCTGraph(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    static const char* lemmas[] = {"réunion", "projet", "peur", "joie", "client", "retard", "succès", "équipe"};
+
+    MCTGraph graph;
+    size_t sentence = 0;
+
+    runner.run("MCTGraph/insert", [&]() {
+        std::string sid = "s" + std::to_string(sentence++);
+        for (size_t w = 0; w < 4; ++w) {
+            graph.addWord(lemmas[(sentence + w) & 7], "NOUN", sid);
+        }
+        graph.addEmotion(gen.next(), 3.0);
+    });
+
+    MCTGraph causal;
+    std::vector<std::string> emotion_ids;
+    runner.quietly([&]() {
+        for (size_t s = 0; s < 200; ++s) {
+            std::string sid = "c" + std::to_string(s);
+            for (size_t w = 0; w < 4; ++w) {
+                causal.addWord(lemmas[(s + w) & 7], "NOUN", sid);
+            }
+            emotion_ids.push_back(causal.addEmotion(gen.next(), 3.0));
+        }
+    });
+    size_t cursor = 0;
+
+    runner.run("MCTGraph/detectCausality", [&]() {
+        causal.detectCausality(emotion_ids[cursor++ % emotion_ids.size()]);
+    });
+
+    runner.run("MCTGraph/createSnapshot", [&]() {
+        g_sink = g_sink + static_cast<double>(causal.createSnapshot().edges.size());
+    });
+
+    runner.run("MCTGraph/captureView", [&]() {
+        g_sink = g_sink + static_cast<double>(causal.captureView().getEdgeCount());
+    });
+
+    runner.run("MCTGraph/analyzeCausality/32", [&]() {
+        g_sink = g_sink + static_cast<double>(causal.analyzeCausality(32).size());
+    });
+
+    runner.run("MCTGraph/statistics", [&]() {
+        g_sink = g_sink + static_cast<double>(causal.captureView().statistics().causal_edges);
+    });
+}
+
+void benchSpeechInput(BenchRunner& runner) {
+    static const char* texts[] = {
+        "Je suis vraiment content de te revoir, merci pour tout",
+        "Attention danger, il faut partir vite, c'est une urgence",
+        "Je ne comprends pas pourquoi ce projet est encore en retard",
+        "Quelle belle journée calme et paisible au bord du lac"
+    };
+
+    SpeechInput speech;
+    size_t cursor = 0;
+    runner.run("SpeechInput/processText", [&]() {
+        g_sink = g_sink + speech.processText(texts[cursor++ & 3]).sentiment_score;
+    });
+}
+
+void benchEmotionUpdater(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    EmotionUpdater updater;
+    EmotionalState state = gen.next();
+    Feedback feedback{0.2, -0.1};
+    std::array<double, NUM_EMOTIONS> influences{};
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) influences[i] = 0.01 * static_cast<double>(i % 5);
+
+    runner.run("EmotionUpdater/updateAllEmotions", [&]() {
+        updater.updateAllEmotions(state, feedback, 0.1, influences, 0.5);
+        g_sink = g_sink + state.E_global;
+    }, 64);
+
+    // Trame complète du pipeline : mise à jour, variance vs souvenirs, E_global, résumé
+    std::vector<MemoryRef> memories(8);
+    for (auto& ref : memories) {
+        Memory memory;
+        memory.emotions = gen.next().emotions;
+        ref.memory = std::make_shared<const Memory>(std::move(memory));
+    }
+
+    runner.run("EmotionUpdater/updateState", [&]() {
+        const auto summary = updater.updateState(state, feedback, 0.1, influences, 0.5,
+                                                 memories, state.E_global);
+        g_sink = g_sink + summary.valence() + state.E_global;
+    }, 64);
+
+    runner.run("EmotionalState/summarize", [&]() {
+        const auto summary = state.summarize();
+        g_sink = g_sink + summary.valence() + summary.dominant_value;
+    }, 64);
+}
+
+void benchADDO(BenchRunner& runner) {
+    if (!runner.enabled("ADDO/update") && !runner.enabled("ADDO/update/production") &&
+        !runner.enabled("ADDO/updateBatch/1024") && !runner.enabled("ADDO/goalTrend")) return;
+
+    StateGenerator gen(SEED);
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 256; ++i) states.push_back(gen.next());
+    size_t cursor = 0;
+
+    ADDOConfig config;
+    config.stochasticity_seed = SEED;
+    std::vector<std::unique_ptr<RuntimeADDOEngine>> engines;
+    std::unique_ptr<ProductionADDOEngine> production;
+    runner.quietly([&]() {
+        for (size_t i = 0; i < 1024; ++i) engines.push_back(std::make_unique<RuntimeADDOEngine>(config));
+        production = std::make_unique<ProductionADDOEngine>();
+    });
+
+    runner.run("ADDO/update", [&]() {
+        const auto goal = engines.front()->update(states[cursor++ & 255], 0.2, 0.6);
+        g_sink = g_sink + goal.G;
+    }, 64);
+
+    // Même mise à jour, coefficients constexpr du profil de production
+    runner.run("ADDO/update/production", [&]() {
+        const auto goal = production->update(states[cursor++ & 255], 0.2, 0.6);
+        g_sink = g_sink + goal.G;
+    }, 64);
+
+    // Tendance et stabilité sur l'historique plein (100 objectifs)
+    runner.run("ADDO/goalTrend", [&]() {
+        g_sink = g_sink + engines.front()->getGoalTrend() + engines.front()->getGoalStability();
+    }, 64);
+
+    // Une trame de 1024 sessions hébergées : un appel, états réécrits en place
+    std::vector<RuntimeADDOEngine*> batch;
+    std::vector<GoalUpdateInput> inputs(engines.size());
+    std::vector<GoalState> goals(engines.size());
+    for (size_t i = 0; i < engines.size(); ++i) {
+        batch.push_back(engines[i].get());
+        inputs[i].emotional_state = &states[i & 255];
+        inputs[i].sentiment = 0.2;
+        inputs[i].wisdom = 0.6;
+    }
+
+    runner.run("ADDO/updateBatch/1024", [&]() {
+        RuntimeADDOEngine::updateBatch(batch, inputs, goals);
+        g_sink = g_sink + goals.back().G;
+    });
+}
+
+void benchEmergencyLane(BenchRunner& runner) {
+    StateGenerator gen(SEED);
+    EmergencyLane lane;
+    lane.setThreshold(0.5);
+
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 256; ++i) states.push_back(gen.next());
+    size_t cursor = 0;
+
+    runner.run("EmergencyLane/evaluate", [&]() {
+        EmergencyLaneEvent event;
+        if (lane.evaluate(states[cursor++ & 255].emotions, std::chrono::steady_clock::now(), event)) {
+            g_sink = g_sink + event.value;
+        }
+    }, 256);
+
+    // Aller-retour producteur → consommateur de la file d'urgence (même thread)
+    runner.run("EmergencyLane/post+pop", [&]() {
+        EmergencyLaneEvent event;
+        event.value = 0.9;
+        std::atomic<bool> keep_going{true};
+        lane.post(event);
+        if (lane.waitNext(event, keep_going)) g_sink = g_sink + event.value;
+    }, 64);
+}
+
+void benchJsonIngest(BenchRunner& runner) {
+    if (!runner.enabled("Ingest/emotions/dom") && !runner.enabled("Ingest/emotions/scanner") &&
+        !runner.enabled("Ingest/tokens/dom/64") && !runner.enabled("Ingest/tokens/scanner/64")) return;
+
+    // Corps tels que publiés par le module émotions et le module NLP
+    StateGenerator gen(SEED);
+    json emotions = json::object();
+    EmotionalState state = gen.next();
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) emotions[EMOTION_NAMES[i]] = state.emotions[i];
+    emotions["timestamp"] = 1700000000000LL;
+    const std::string emotions_body = emotions.dump();
+
+    json tokens = {{"sentence_id", "bench_sentence"}, {"tokens", json::array()}, {"relations", json::array()}};
+    for (size_t i = 0; i < 64; ++i) {
+        tokens["tokens"].push_back({{"text", "mots" + std::to_string(i)}, {"lemma", "mot" + std::to_string(i)},
+                                    {"pos", "NOUN"}, {"sentiment", 0.1 * static_cast<double>(i % 10)}});
+        if (i > 0) tokens["relations"].push_back({{"source", i - 1}, {"target", i}, {"type", "nsubj"}});
+    }
+    const std::string tokens_body = tokens.dump();
+
+    runner.run("Ingest/emotions/dom", [&]() {
+        json input = json::parse(emotions_body);
+        double sum = 0.0;
+        for (const auto& name : EMOTION_NAMES) {
+            if (input.contains(name)) sum += input[name].get<double>();
+        }
+        g_sink = g_sink + sum;
+    }, 64);
+
+    runner.run("Ingest/emotions/scanner", [&]() {
+        std::array<double, NUM_EMOTIONS> values{};
+        JsonScanner scan(emotions_body);
+        scan.beginObject();
+        std::string_view key;
+        while (scan.nextField(key)) {
+            size_t index = emotionIndex(key);
+            if (index < NUM_EMOTIONS) values[index] = scan.readNumber();
+            else scan.skipValue();
+        }
+        g_sink = g_sink + values[EMO_PEUR];
+    }, 64);
+
+    runner.run("Ingest/tokens/dom/64", [&]() {
+        json input = json::parse(tokens_body);
+        size_t bytes = 0;
+        for (const auto& token : input["tokens"]) {
+            std::string lemma = token.value("lemma", token.value("text", ""));
+            std::string pos = token.value("pos", "UNKNOWN");
+            bytes += lemma.size() + pos.size();
+        }
+        g_sink = g_sink + static_cast<double>(bytes);
+    }, 16);
+
+    runner.run("Ingest/tokens/scanner/64", [&]() {
+        std::string scratch;
+        std::string_view key, tokens_json;
+        JsonScanner scan(tokens_body);
+        scan.beginObject();
+        while (scan.nextField(key)) {
+            if (key == "tokens") tokens_json = scan.captureValue();
+            else scan.skipValue();
+        }
+        size_t bytes = 0;
+        JsonScanner list(tokens_json);
+        list.beginArray();
+        while (list.nextElement()) {
+            list.beginObject();
+            while (list.nextField(key)) {
+                if (key == "lemma" || key == "pos") bytes += list.readString(scratch).size();
+                else list.skipValue();
+            }
+        }
+        g_sink = g_sink + static_cast<double>(bytes);
+    }, 16);
+}
+
+void benchExecutor(BenchRunner& runner) {
+    if (!runner.enabled("Executor/submit+get") && !runner.enabled("Executor/fork-join/8") &&
+        !runner.enabled("TaskLane/post+waitIdle")) return;
+
+    auto executor = Executor::shared();
+
+    // Aller-retour complet : soumission, réveil d'un worker, résolution
+    runner.run("Executor/submit+get", [&]() {
+        auto future = executor->submit(TaskClass::PIPELINE, []() { return 1.0; });
+        g_sink = g_sink + future.get();
+    }, 64);
+
+    // Découpage façon DecisionEngine::forEachOption (tranche 0 sur l'appelant)
+    std::vector<double> values(8 * 64, 0.5);
+    runner.run("Executor/fork-join/8", [&]() {
+        std::vector<TaskFuture<double>> futures;
+        futures.reserve(7);
+        for (size_t t = 1; t < 8; ++t) {
+            futures.push_back(executor->submit(TaskClass::PIPELINE, [&values, t]() {
+                return std::accumulate(values.begin() + t * 64, values.begin() + (t + 1) * 64, 0.0);
+            }));
+        }
+        double sum = std::accumulate(values.begin(), values.begin() + 64, 0.0);
+        for (auto& f : futures) sum += f.get();
+        g_sink = g_sink + sum;
+    }, 16);
+
+    // Voie de largeur 1 (MLT, MDDO) : débit des tâches courtes sérialisées
+    TaskLane lane(TaskClass::BACKGROUND, 1, TaskLane::UNBOUNDED, executor);
+    std::atomic<uint64_t> counter{0};
+    runner.run("TaskLane/post+waitIdle", [&]() {
+        for (int i = 0; i < 256; ++i) {
+            lane.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        lane.waitIdle();
+    }, 1);
+    g_sink = g_sink + static_cast<double>(counter.load());
+}
+
+void benchMemoryManager(BenchRunner& runner) {
+    if (!runner.enabled("MemoryManager/recordMemory") &&
+        !runner.enabled("MemoryManager/queryRelevantMemories/2048")) return;
+
+    // Niveaux pleins : chaque enregistrement non fusionné rétrograde un souvenir vers le tiède
+    MemoryTierConfig config;
+    config.hot_capacity = 2048;
+    config.warm_capacity = 16384;
+    MemoryManager manager(config);
+    StateGenerator gen(SEED);
+
+    std::vector<EmotionalState> states;
+    for (size_t i = 0; i < 1024; ++i) states.push_back(gen.next());
+    size_t cursor = 0;
+    runner.quietly([&]() {
+        for (size_t i = 0; i < config.hot_capacity + config.warm_capacity; ++i) {
+            manager.recordMemory(gen.next(), Phase::SERENITE, "bench_" + std::to_string(i % 64));
+        }
+    });
+
+    runner.run("MemoryManager/recordMemory", [&]() {
+        const size_t i = cursor++;
+        manager.recordMemory(states[i & 1023], Phase::SERENITE,
+                             "bench_" + std::to_string(i & 63));
+    }, 16);
+
+    runner.run("MemoryManager/queryRelevantMemories/2048", [&]() {
+        auto memories = manager.queryRelevantMemories(Phase::SERENITE, states[cursor++ & 1023], 10);
+        g_sink = g_sink + static_cast<double>(memories.size());
+    }, 16);
+}
+
+void benchSemanticIndex(BenchRunner& runner) {
+    if (!runner.enabled("SemanticIndex/topK/1024/int8") &&
+        !runner.enabled("SemanticIndex/topK/1024/float16")) return;
+
+    // Embeddings de phrase typiques : 384 dimensions
+    constexpr size_t DIM = 384;
+    std::mt19937 rng(SEED);
+    std::normal_distribution<double> normal(0.0, 0.05);
+    auto embedding = [&]() {
+        std::vector<double> v(DIM);
+        for (auto& x : v) x = normal(rng);
+        return v;
+    };
+
+    std::vector<std::vector<double>> queries;
+    for (size_t i = 0; i < 64; ++i) queries.push_back(embedding());
+
+    for (auto mode : {EmbeddingQuantization::INT8, EmbeddingQuantization::FLOAT16}) {
+        SemanticIndex index(mode);
+        runner.quietly([&]() {
+            for (size_t i = 0; i < 1024; ++i) index.upsert("memory_" + std::to_string(i), embedding());
+        });
+
+        size_t cursor = 0;
+        runner.run(std::string("SemanticIndex/topK/1024/") + quantizationName(mode), [&]() {
+            auto hits = index.topK(queries[cursor++ & 63], 20, 0.0);
+            g_sink = g_sink + static_cast<double>(hits.size());
+        });
+    }
+}
+
+void benchLLMPrompt(BenchRunner& runner) {
+    if (!runner.enabled("LLMClient/renderUserPrompt") && !runner.enabled("LLMResponseCache/find")) return;
+
+    LLMClientConfig config;
+    config.mode = LLMMode::RABBITMQ;  // Jamais initialisé : aucune connexion
+    LLMClient client(config);
+
+    LLMContext context;
+    context.Ft = -0.42;
+    context.Ct = 0.71;
+    context.sentiment_label = "négatif";
+    context.emotions = {{"Peur", "réunion", 0.81}, {"Anxiété", "retard", 0.55}, {"Tristesse", "", 0.34}};
+    context.dominant_emotion = "Peur";
+    context.dominant_score = 0.81;
+    context.context_words = {"réunion", "projet", "client", "retard", "équipe"};
+    context.activated_memories = {"souvenir_12", "souvenir_48"};
+
+    const std::string question = "Comment aborder la réunion de demain ?";
+    std::string prompt;
+    runner.run("LLMClient/renderUserPrompt", [&]() {
+        client.renderUserPrompt(question, context, prompt);
+        g_sink = g_sink + static_cast<double>(prompt.size());
+    });
+
+    LLMResponseCache cache;
+    LLMRequest request;
+    request.user_question = question;
+    request.emotional_context = context;
+    request.cache_scope = "ANXIETE";
+
+    LLMResponse response;
+    response.success = true;
+    response.content = std::string(600, 'x');
+    const uint64_t scope = LLMResponseCache::scopeKey(request, config.temperature, config.max_tokens);
+    const uint64_t key = LLMResponseCache::questionKey(scope, question);
+    runner.quietly([&]() { cache.store(key, scope, {}, response); });
+
+    runner.run("LLMResponseCache/find", [&]() {
+        uint64_t k = LLMResponseCache::questionKey(scope, request.user_question);
+        auto hit = cache.find(k, scope, {}, std::chrono::minutes(10), 0.0);
+        g_sink = g_sink + static_cast<double>(hit ? hit->content.size() : 0);
+    });
+}
+
+void benchPipeline(BenchRunner& runner, const std::vector<RawFrame>& trace) {
+    if (!runner.enabled("Pipeline/replay") || trace.empty()) return;
+
+    // Entrée directe sans start() : pipeline exécuté de façon synchrone
+    std::unique_ptr<MCEEEngine> engine;
+    runner.quietly([&]() { engine = std::make_unique<MCEEEngine>(); });
+    size_t cursor = 0;
+
+    runner.run("Pipeline/replay", [&]() {
+        engine->processEmotions(trace[cursor++ % trace.size()]);
+    });
+
+    // Chemin stable attendu proche de zéro (hors copie du corps publié par SimpleAmqpClient)
+    const MCEEStats stats = engine->getStats();
+    if (stats.frame_heap_counting) {
+        std::cout << "[Bench] Pipeline/replay: " << std::fixed << std::setprecision(2)
+                  << stats.frame_heap_allocations << " allocations du tas par trame, "
+                  << stats.frame_arena_spills << " débordements d'arène\n";
+    }
+
+    std::cout << "[Bench] Pipeline/replay: matching réutilisé sur " << std::fixed << std::setprecision(1)
+              << 100.0 * stats.pattern_match_skip_rate << " % des trames\n";
+
+    const PrefetchStats prefetch = engine->getPrefetchStats();
+    std::cout << "[Bench] Pipeline/replay: préchargement " << prefetch.predictions << " prédictions, "
+              << prefetch.hits << " hits / " << prefetch.late << " en retard / " << prefetch.misses
+              << " ratés (taux " << std::setprecision(2) << prefetch.hitRate() << ")\n";
+
+    runner.quietly([&]() { engine.reset(); });
+}
+
+void printUsage() {
+    std::cout << "Usage: mcee_bench [--filter <sous-chaîne>] [--min-time-ms <ms>] [--json <fichier>]\n"
+              << "                  [--trace <fichier.jsonl>] [--write-trace <fichier.jsonl>] [--frames <n>]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    LoggerConfig log_config;
+    log_config.level = LogLevel::WARN;
+    Logger::instance().configureFromEnv(log_config);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("valeur manquante pour " + arg);
+            }
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--filter") {
+                options.filter = value();
+            } else if (arg == "--min-time-ms") {
+                options.min_time_ms = std::stod(value());
+            } else if (arg == "--json") {
+                options.json_path = value();
+            } else if (arg == "--trace") {
+                options.trace_path = value();
+            } else if (arg == "--write-trace") {
+                options.write_trace_path = value();
+            } else if (arg == "--frames") {
+                options.frames = std::stoul(value());
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                std::cerr << "[Bench] Option inconnue: " << arg << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[Bench] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<RawFrame> trace;
+    try {
+        trace = options.trace_path.empty() ? syntheticTrace(options.frames)
+                                           : loadTrace(options.trace_path);
+        if (!options.write_trace_path.empty()) {
+            writeTrace(options.write_trace_path, trace);
+            std::cout << "[Bench] Trace écrite: " << options.write_trace_path
+                      << " (" << trace.size() << " trames)\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Bench] Erreur trace: " << e.what() << "\n";
+        return 1;
+    }
+
+    BenchRunner runner(options);
+    benchMCT(runner);
+    benchMLT(runner);
+    benchMLTMerge(runner);
+    benchMLTPersistence(runner);
+    benchPatternMatcher(runner);
+    benchPhaseDetector(runner);
+    benchMCTGraph(runner);
+    benchSpeechInput(runner);
+    benchEmotionUpdater(runner);
+    benchADDO(runner);
+    benchEmergencyLane(runner);
+    benchJsonIngest(runner);
+    benchExecutor(runner);
+    benchMemoryManager(runner);
+    benchSemanticIndex(runner);
+    benchLLMPrompt(runner);
+    benchPipeline(runner, trace);
+
+    json report = runner.toJson();
+    if (!options.json_path.empty()) {
+        std::ofstream out(options.json_path);
+        if (!out) {
+            std::cerr << "[Bench] Impossible d'écrire " << options.json_path << "\n";
+            return 1;
+        }
+        out << report.dump(2) << "\n";
+        std::cout << "[Bench] Résultats JSON: " << options.json_path << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,739 @@
+/**
+ * @file mcee_loadgen.cpp
+ * @brief Générateur de charge et mesure de latence de bout en bout (RabbitMQ)
+ *
+ * Injecte dans la topologie réelle (exchanges émotions, parole, tokens) des
+ * trames synthétiques ou une trace enregistrée (--trace, mêmes formats que
+ * --record), pour un nombre de sessions et des débits donnés, puis consomme
+ * l'exchange de sortie du MCEE :
+ * - chaque trame émotions porte l'en-tête RabbitMQConfig::trace_header,
+ *   l'heure d'envoi *prévue* (horloge monotone, ns) ; le MCEE le renvoie sur
+ *   l'état publié qui en résulte. La latence part de l'heure prévue et non
+ *   de l'envoi effectif : un générateur en retard ne masque pas l'attente
+ *   (omission coordonnée) ; ce retard est mesuré à part (send_lag) ;
+ * - la profondeur des files d'entrée est relevée par déclaration passive
+ *   toutes les --sample-ms ;
+ * - le rapport donne p50/p99/p999 de bout en bout, débits envoyés et reçus,
+ *   profondeurs par file dans le temps (--json pour la série complète).
+ *
+ * Les sessions sont distinguées par l'en-tête RabbitMQConfig::session_header
+ * (MCEE lancé avec --multi-session) ; un moteur autonome les confond. Les
+ * états fusionnés sous surcharge, ou retenus par la politique de publication,
+ * portent l'estampille de la plus ancienne trame qu'ils reflètent : les
+ * autres trames ne reçoivent pas de réponse propre (colonne « sans réponse »).
+ *
+ * Usage :
+ *   mcee_loadgen [--host <h>] [--port <p>] [--user <u>] [--pass <p>]
+ *                [--sessions <n>] [--rate <Hz>] [--speech-rate <Hz>] [--tokens-rate <Hz>]
+ *                [--binary] [--producers <n>] [--duration <s>] [--warmup <s>] [--drain <s>]
+ *                [--trace <fichier>] [--speed <x>] [--sample-ms <ms>] [--json <fichier>]
+ *                [--max-p99-ms <ms>] [--max-p999-ms <ms>]
+ *
+ * Les débits sont par session. Avec --max-p99-ms / --max-p999-ms, le code
+ * de sortie vaut 2 si un seuil est dépassé (qualification avant mise en
+ * production).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#include "EmotionWire.hpp"
+#include "Logger.hpp"
+#include "MCEEEngine.hpp"
+#include "Metrics.hpp"
+#include "SessionTrace.hpp"
+#include "Types.hpp"
+
+#include <SimpleAmqpClient/SimpleAmqpClient.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcee;
+using json = nlohmann::json;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t SEED = 42;
+
+struct LoadOptions {
+    RabbitMQConfig rabbitmq;
+    size_t sessions = 1;
+    double rate_hz = 10.0;              // Trames émotions par seconde et par session
+    double speech_rate_hz = 0.0;
+    double tokens_rate_hz = 0.0;
+    bool binary = false;                // Trames EmotionWire plutôt que JSON
+    size_t producers = 1;
+    double duration_seconds = 30.0;
+    double warmup_seconds = 5.0;        // Latences non comptées au début
+    double drain_seconds = 5.0;         // Attente des dernières réponses
+    std::string trace_path;
+    double speed = 1.0;                 // Accélération du rejeu de trace
+    int sample_ms = 250;
+    std::string json_path;
+    std::string session_prefix = "loadgen";
+    std::vector<std::string> queues = {"mcee_emotions_queue", "mcee_speech_queue", "mcee_tokens_queue"};
+    double max_p99_ms = 0.0;            // 0 : pas de seuil
+    double max_p999_ms = 0.0;
+};
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+AmqpClient::Channel::ptr_t openChannel(const RabbitMQConfig& config) {
+    AmqpClient::Channel::OpenOpts opts;
+    opts.host = config.host;
+    opts.port = config.port;
+    opts.auth = AmqpClient::Channel::OpenOpts::BasicAuth{config.user, config.password};
+    return AmqpClient::Channel::Open(opts);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// COMPTEURS PARTAGÉS
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct LoadCounters {
+    std::atomic<uint64_t> emotions_sent{0};
+    std::atomic<uint64_t> speech_sent{0};
+    std::atomic<uint64_t> tokens_sent{0};
+    std::atomic<uint64_t> emotions_measured{0};  // Envoyées après l'échauffement
+    std::atomic<uint64_t> send_errors{0};
+
+    std::atomic<uint64_t> messages_received{0};
+    std::atomic<uint64_t> states_received{0};    // Un lot compte pour ses états
+    std::atomic<uint64_t> traced{0};             // Réponses mesurées
+    std::atomic<uint64_t> untraced{0};           // Sans estampille (heartbeat, autre producteur)
+
+    LatencyHistogram end_to_end;                 // Envoi prévu → réception de l'état
+    LatencyHistogram send_lag;                   // Envoi prévu → envoi effectif
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONTENU SYNTHÉTIQUE
+// ═══════════════════════════════════════════════════════════════════════════
+
+const std::array<const char*, 8> SENTENCES = {
+    "Je suis vraiment content de te revoir aujourd'hui",
+    "Ce retard commence à m'inquiéter sérieusement",
+    "Merci beaucoup pour ton aide précieuse",
+    "Je ne comprends pas pourquoi tout échoue encore",
+    "Attention, il y a un danger immédiat devant nous",
+    "La réunion de demain me rend un peu nerveux",
+    "Quelle belle surprise, je ne m'y attendais pas",
+    "Je me sens seul depuis quelques jours"
+};
+
+const std::array<const char*, 4> POS_CYCLE = {"PRON", "VERB", "ADV", "ADJ"};
+
+/**
+ * @brief Marche aléatoire des 24 émotions d'une session
+ */
+class EmotionWalk {
+public:
+    explicit EmotionWalk(std::mt19937& rng) {
+        std::uniform_real_distribution<double> uniform(0.0, 0.5);
+        for (auto& v : current_) v = uniform(rng);
+    }
+
+    const std::array<double, NUM_EMOTIONS>& next(std::mt19937& rng) {
+        std::normal_distribution<double> step(0.0, 0.05);
+        for (auto& v : current_) v = std::clamp(v + step(rng), 0.0, 1.0);
+        return current_;
+    }
+
+private:
+    std::array<double, NUM_EMOTIONS> current_{};
+};
+
+std::string emotionsBody(const std::array<double, NUM_EMOTIONS>& values, bool binary) {
+    if (binary) {
+        EmotionFrame frame;
+        frame.timestamp_ms = wireNowMs();
+        double sum = 0.0;
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            frame.emotions[i] = values[i];
+            sum += values[i];
+        }
+        frame.e_global = sum / NUM_EMOTIONS;
+        return encodeEmotionFrame(frame);
+    }
+    json body = json::object();
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+        body[EMOTION_NAMES[i]] = values[i];
+    }
+    return body.dump();
+}
+
+std::string speechBody(size_t sentence) {
+    return json{{"text", SENTENCES[sentence % SENTENCES.size()]}, {"source", "user"}, {"confidence", 0.9}}.dump();
+}
+
+std::string tokensBody(const std::string& session, uint64_t n, size_t sentence) {
+    json tokens = json::array();
+    json relations = json::array();
+    std::string text = SENTENCES[sentence % SENTENCES.size()];
+    size_t index = 0, start = 0;
+    while (start < text.size()) {
+        size_t end = text.find(' ', start);
+        if (end == std::string::npos) end = text.size();
+        std::string word = text.substr(start, end - start);
+        std::string lemma = word;
+        std::transform(lemma.begin(), lemma.end(), lemma.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        tokens.push_back({{"text", word}, {"lemma", lemma}, {"pos", POS_CYCLE[index % POS_CYCLE.size()]},
+                          {"sentiment", 0.0}});
+        if (index > 0) {
+            relations.push_back({{"source", index - 1}, {"target", index}, {"type", "dep"}});
+        }
+        ++index;
+        start = end + 1;
+    }
+    return json{{"sentence_id", session + "-" + std::to_string(n)}, {"tokens", std::move(tokens)},
+                {"relations", std::move(relations)}}.dump();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PRODUCTEURS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Publie un message d'entrée, estampillé s'il s'agit d'émotions
+ */
+void publishInput(const AmqpClient::Channel::ptr_t& channel, const RabbitMQConfig& config, MCEEInput input,
+                  const std::string& session, std::string body, const std::string& content_type, int64_t trace) {
+    auto message = AmqpClient::BasicMessage::Create(std::move(body));
+    if (!content_type.empty()) {
+        message->ContentType(content_type);
+    }
+
+    AmqpClient::Table headers;
+    if (!session.empty()) {
+        headers[config.session_header] = AmqpClient::TableValue(session);
+    }
+    if (trace != 0) {
+        headers[config.trace_header] = AmqpClient::TableValue(trace);
+    }
+    message->HeaderTable(headers);
+
+    switch (input) {
+        case MCEEInput::EMOTIONS:
+            channel->BasicPublish(config.emotions_exchange, config.emotions_routing_key, message, false, false);
+            break;
+        case MCEEInput::SPEECH:
+            channel->BasicPublish(config.speech_exchange, config.speech_routing_key, message, false, false);
+            break;
+        case MCEEInput::TOKENS:
+            channel->BasicPublish(config.tokens_exchange, config.tokens_routing_key, message, false, false);
+            break;
+    }
+}
+
+/**
+ * @brief Flux synthétique d'un producteur : sessions i ≡ index (mod producers)
+ *
+ * Trois échéanciers à pas fixe (émotions, parole, tokens), chacun parcourant
+ * les sessions du producteur à tour de rôle ; le plus en avance est servi.
+ */
+void syntheticProducer(const LoadOptions& options, size_t index, Clock::time_point start,
+                       Clock::time_point measure_start, Clock::time_point end, LoadCounters& counters) {
+    std::vector<std::string> sessions;
+    for (size_t s = index; s < options.sessions; s += options.producers) {
+        sessions.push_back(options.session_prefix + "-" + std::to_string(s));
+    }
+    if (sessions.empty()) return;
+
+    std::mt19937 rng(SEED + static_cast<uint32_t>(index));
+    std::vector<EmotionWalk> walks;
+    for (size_t s = 0; s < sessions.size(); ++s) walks.emplace_back(rng);
+
+    struct Stream {
+        MCEEInput input;
+        double rate_hz;
+        Clock::time_point due;
+        Clock::duration period{};
+        size_t cursor = 0;
+        uint64_t sent = 0;
+    };
+    std::vector<Stream> streams;
+    for (auto [input, rate] : {std::pair{MCEEInput::EMOTIONS, options.rate_hz},
+                               std::pair{MCEEInput::SPEECH, options.speech_rate_hz},
+                               std::pair{MCEEInput::TOKENS, options.tokens_rate_hz}}) {
+        if (rate <= 0.0) continue;
+        Stream stream{input, rate, start};
+        stream.period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / (rate * static_cast<double>(sessions.size()))));
+        streams.push_back(stream);
+    }
+    if (streams.empty()) return;
+
+    auto channel = openChannel(options.rabbitmq);
+    const std::string content_type = options.binary ? WIRE_CONTENT_TYPE_FRAME : WIRE_CONTENT_TYPE_JSON;
+
+    while (true) {
+        auto it = std::min_element(streams.begin(), streams.end(),
+                                   [](const Stream& a, const Stream& b) { return a.due < b.due; });
+        Stream& stream = *it;
+        if (stream.due >= end) break;
+        std::this_thread::sleep_until(stream.due);
+
+        const size_t s = stream.cursor++ % sessions.size();
+        try {
+            switch (stream.input) {
+                case MCEEInput::EMOTIONS: {
+                    const int64_t trace = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        stream.due.time_since_epoch()).count();
+                    publishInput(channel, options.rabbitmq, MCEEInput::EMOTIONS, sessions[s],
+                                 emotionsBody(walks[s].next(rng), options.binary), content_type, trace);
+                    counters.emotions_sent.fetch_add(1, std::memory_order_relaxed);
+                    if (stream.due >= measure_start) {
+                        counters.emotions_measured.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+                case MCEEInput::SPEECH:
+                    publishInput(channel, options.rabbitmq, MCEEInput::SPEECH, sessions[s],
+                                 speechBody(stream.sent), WIRE_CONTENT_TYPE_JSON, 0);
+                    counters.speech_sent.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case MCEEInput::TOKENS:
+                    publishInput(channel, options.rabbitmq, MCEEInput::TOKENS, sessions[s],
+                                 tokensBody(sessions[s], stream.sent, stream.sent), WIRE_CONTENT_TYPE_JSON, 0);
+                    counters.tokens_sent.fetch_add(1, std::memory_order_relaxed);
+                    break;
+            }
+            counters.send_lag.recordSince(stream.due);
+        } catch (const std::exception& e) {
+            if (counters.send_errors.fetch_add(1, std::memory_order_relaxed) == 0) {
+                std::cerr << "[LoadGen] Erreur d'envoi: " << e.what() << "\n";
+            }
+            channel = openChannel(options.rabbitmq);
+        }
+        stream.sent++;
+        stream.due += stream.period;
+    }
+}
+
+/**
+ * @brief Rejoue une trace à son rythme d'origine (× speed), en boucle jusqu'à la fin
+ */
+void traceProducer(const LoadOptions& options, const TraceReader& trace, Clock::time_point start,
+                   Clock::time_point measure_start, Clock::time_point end, LoadCounters& counters) {
+    const auto& records = trace.records();
+    if (records.empty()) return;
+
+    const double t0 = records.front().time;
+    const double span = std::max(records.back().time - t0, 1e-3);
+    auto channel = openChannel(options.rabbitmq);
+
+    for (size_t lap = 0;; ++lap) {
+        for (const auto& record : records) {
+            const double offset = (static_cast<double>(lap) * span + (record.time - t0)) / options.speed;
+            const auto due = start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(offset));
+            if (due >= end) return;
+            std::this_thread::sleep_until(due);
+
+            const std::string session = record.session.empty()
+                ? options.session_prefix : std::string(record.session);
+            const int64_t trace_ns = record.input == MCEEInput::EMOTIONS
+                ? std::chrono::duration_cast<std::chrono::nanoseconds>(due.time_since_epoch()).count() : 0;
+            try {
+                publishInput(channel, options.rabbitmq, record.input, session, std::string(record.body),
+                             std::string(record.content_type), trace_ns);
+                switch (record.input) {
+                    case MCEEInput::EMOTIONS:
+                        counters.emotions_sent.fetch_add(1, std::memory_order_relaxed);
+                        if (due >= measure_start) {
+                            counters.emotions_measured.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        break;
+                    case MCEEInput::SPEECH:
+                        counters.speech_sent.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    case MCEEInput::TOKENS:
+                        counters.tokens_sent.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                }
+                counters.send_lag.recordSince(due);
+            } catch (const std::exception& e) {
+                if (counters.send_errors.fetch_add(1, std::memory_order_relaxed) == 0) {
+                    std::cerr << "[LoadGen] Erreur d'envoi: " << e.what() << "\n";
+                }
+                channel = openChannel(options.rabbitmq);
+            }
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONSOMMATEUR DE SORTIE
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Consomme l'exchange de sortie jusqu'à stop ; latence des états estampillés
+ */
+void outputConsumer(const LoadOptions& options, const AmqpClient::Channel::ptr_t& channel,
+                    const std::string& consumer_tag, int64_t measure_start_ns,
+                    const std::atomic<bool>& stop, LoadCounters& counters) {
+    std::vector<EmotionFrame> batch;
+    while (!stop.load(std::memory_order_acquire)) {
+        AmqpClient::Envelope::ptr_t envelope;
+        if (!channel->BasicConsumeMessage(consumer_tag, envelope, 100) || !envelope) {
+            continue;
+        }
+        const int64_t received_ns = nowNs();
+        const auto message = envelope->Message();
+
+        uint64_t states = 1;
+        if (message->ContentTypeIsSet() && isEmotionBatchContentType(message->ContentType()) &&
+            decodeEmotionBatch(message->Body(), batch)) {
+            states = batch.size();
+        }
+        counters.messages_received.fetch_add(1, std::memory_order_relaxed);
+        counters.states_received.fetch_add(states, std::memory_order_relaxed);
+
+        const int64_t trace = MCEEEngine::traceStamp(message, options.rabbitmq.trace_header);
+        if (trace == 0) {
+            counters.untraced.fetch_add(1, std::memory_order_relaxed);
+        } else if (trace >= measure_start_ns) {
+            counters.traced.fetch_add(1, std::memory_order_relaxed);
+            counters.end_to_end.record(static_cast<uint64_t>(std::max<int64_t>(0, received_ns - trace)));
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PROFONDEUR DES FILES
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct DepthSample {
+    double t = 0.0;                     // Secondes depuis le départ
+    uint64_t sent = 0;                  // Cumuls (tous flux)
+    uint64_t received = 0;
+    std::vector<int64_t> depths;        // Par file (-1 : inconnue)
+};
+
+/**
+ * @brief Relève la profondeur des files par déclaration passive ; affiche une ligne par seconde
+ */
+void depthMonitor(const LoadOptions& options, Clock::time_point start, const std::atomic<bool>& stop,
+                  LoadCounters& counters, std::vector<DepthSample>& samples) {
+    AmqpClient::Channel::ptr_t channel = openChannel(options.rabbitmq);
+    auto next_print = start + std::chrono::seconds(1);
+    uint64_t printed_sent = 0, printed_received = 0;
+
+    while (!stop.load(std::memory_order_acquire)) {
+        DepthSample sample;
+        sample.t = std::chrono::duration<double>(Clock::now() - start).count();
+        sample.sent = counters.emotions_sent.load() + counters.speech_sent.load() + counters.tokens_sent.load();
+        sample.received = counters.states_received.load();
+        for (const auto& queue : options.queues) {
+            int64_t depth = -1;
+            try {
+                if (!channel) channel = openChannel(options.rabbitmq);
+                uint32_t message_count = 0, consumer_count = 0;
+                channel->DeclareQueueWithCounts(queue, message_count, consumer_count, true);
+                depth = message_count;
+            } catch (const std::exception&) {
+                channel.reset();    // File absente : le broker ferme le channel
+            }
+            sample.depths.push_back(depth);
+        }
+        samples.push_back(sample);
+
+        if (Clock::now() >= next_print) {
+            std::printf("[LoadGen] t=%5.1fs  envoyés %7llu/s  reçus %7llu/s  p99 %8.3f ms ",
+                        sample.t, static_cast<unsigned long long>(sample.sent - printed_sent),
+                        static_cast<unsigned long long>(sample.received - printed_received),
+                        static_cast<double>(counters.end_to_end.snapshot().percentileNs(0.99)) / 1e6);
+            for (size_t q = 0; q < options.queues.size(); ++q) {
+                std::printf(" %s=%lld", options.queues[q].c_str(), static_cast<long long>(sample.depths[q]));
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+            printed_sent = sample.sent;
+            printed_received = sample.received;
+            next_print += std::chrono::seconds(1);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(options.sample_ms));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RAPPORT
+// ═══════════════════════════════════════════════════════════════════════════
+
+json latencyJson(const LatencySnapshot& snap) {
+    auto ms = [](uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+    return {
+        {"count", snap.count},
+        {"mean_ms", snap.meanNs() / 1e6},
+        {"p50_ms", ms(snap.percentileNs(0.50))},
+        {"p90_ms", ms(snap.percentileNs(0.90))},
+        {"p99_ms", ms(snap.percentileNs(0.99))},
+        {"p999_ms", ms(snap.percentileNs(0.999))},
+        {"max_ms", ms(snap.max_ns)}
+    };
+}
+
+json buildReport(const LoadOptions& options, const LoadCounters& counters, double measured_seconds,
+                 const std::vector<DepthSample>& samples) {
+    const uint64_t measured = counters.emotions_measured.load();
+    const uint64_t traced = counters.traced.load();
+
+    json queues = json::object();
+    for (size_t q = 0; q < options.queues.size(); ++q) {
+        int64_t max_depth = 0;
+        double sum = 0.0;
+        size_t known = 0;
+        for (const auto& sample : samples) {
+            if (sample.depths[q] < 0) continue;
+            max_depth = std::max(max_depth, sample.depths[q]);
+            sum += static_cast<double>(sample.depths[q]);
+            ++known;
+        }
+        queues[options.queues[q]] = {{"max", max_depth}, {"mean", known > 0 ? sum / static_cast<double>(known) : 0.0}};
+    }
+
+    json series = json::array();
+    for (const auto& sample : samples) {
+        series.push_back({{"t", sample.t}, {"sent", sample.sent}, {"received", sample.received},
+                          {"depths", sample.depths}});
+    }
+
+    return {
+        {"config", {
+            {"sessions", options.sessions},
+            {"rate_hz", options.rate_hz},
+            {"speech_rate_hz", options.speech_rate_hz},
+            {"tokens_rate_hz", options.tokens_rate_hz},
+            {"binary", options.binary},
+            {"producers", options.producers},
+            {"duration_s", options.duration_seconds},
+            {"warmup_s", options.warmup_seconds},
+            {"trace", options.trace_path},
+            {"speed", options.speed}
+        }},
+        {"sent", {
+            {"emotions", counters.emotions_sent.load()},
+            {"speech", counters.speech_sent.load()},
+            {"tokens", counters.tokens_sent.load()},
+            {"errors", counters.send_errors.load()}
+        }},
+        {"received", {
+            {"messages", counters.messages_received.load()},
+            {"states", counters.states_received.load()},
+            {"traced", traced},
+            {"untraced", counters.untraced.load()},
+            {"unanswered", measured > traced ? measured - traced : 0}
+        }},
+        {"throughput", {
+            {"emotions_sent_per_s", measured_seconds > 0.0 ? static_cast<double>(measured) / measured_seconds : 0.0},
+            {"states_received_per_s", measured_seconds > 0.0 ? static_cast<double>(traced) / measured_seconds : 0.0}
+        }},
+        {"end_to_end", latencyJson(counters.end_to_end.snapshot())},
+        {"send_lag", latencyJson(counters.send_lag.snapshot())},
+        {"queues", std::move(queues)},
+        {"series", std::move(series)}
+    };
+}
+
+void printReport(const json& report) {
+    const auto& e2e = report["end_to_end"];
+    const auto& lag = report["send_lag"];
+    std::printf("\n═══ Rapport de charge ═══\n");
+    std::printf("Envoyés        : %llu émotions, %llu parole, %llu tokens (%llu erreurs)\n",
+                report["sent"]["emotions"].get<unsigned long long>(), report["sent"]["speech"].get<unsigned long long>(),
+                report["sent"]["tokens"].get<unsigned long long>(), report["sent"]["errors"].get<unsigned long long>());
+    std::printf("Reçus          : %llu messages, %llu états, %llu mesurés, %llu sans réponse\n",
+                report["received"]["messages"].get<unsigned long long>(),
+                report["received"]["states"].get<unsigned long long>(),
+                report["received"]["traced"].get<unsigned long long>(),
+                report["received"]["unanswered"].get<unsigned long long>());
+    std::printf("Débit          : %.1f trames/s envoyées, %.1f états/s reçus\n",
+                report["throughput"]["emotions_sent_per_s"].get<double>(),
+                report["throughput"]["states_received_per_s"].get<double>());
+    std::printf("Bout en bout   : p50 %.3f ms  p99 %.3f ms  p999 %.3f ms  max %.3f ms\n",
+                e2e["p50_ms"].get<double>(), e2e["p99_ms"].get<double>(),
+                e2e["p999_ms"].get<double>(), e2e["max_ms"].get<double>());
+    std::printf("Retard d'envoi : p99 %.3f ms  max %.3f ms\n",
+                lag["p99_ms"].get<double>(), lag["max_ms"].get<double>());
+    for (const auto& [queue, depth] : report["queues"].items()) {
+        std::printf("File %-20s : max %lld, moyenne %.1f\n", queue.c_str(),
+                    depth["max"].get<long long>(), depth["mean"].get<double>());
+    }
+}
+
+void printUsage() {
+    std::cout << "Usage: mcee_loadgen [--host <h>] [--port <p>] [--user <u>] [--pass <p>]\n"
+              << "                    [--sessions <n>] [--rate <Hz>] [--speech-rate <Hz>] [--tokens-rate <Hz>]\n"
+              << "                    [--binary] [--producers <n>] [--duration <s>] [--warmup <s>] [--drain <s>]\n"
+              << "                    [--trace <fichier>] [--speed <x>] [--sample-ms <ms>] [--json <fichier>]\n"
+              << "                    [--max-p99-ms <ms>] [--max-p999-ms <ms>]\n"
+              << "Débits par session ; --trace rejoue une trace enregistrée (--record) à la place.\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LoadOptions options;
+    LoggerConfig log_config;
+    log_config.level = LogLevel::WARN;
+    Logger::instance().configureFromEnv(log_config);
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("valeur manquante pour " + arg);
+            }
+            return argv[++i];
+        };
+
+        try {
+            if (arg == "--host") options.rabbitmq.host = value();
+            else if (arg == "--port") options.rabbitmq.port = std::stoi(value());
+            else if (arg == "--user") options.rabbitmq.user = value();
+            else if (arg == "--pass") options.rabbitmq.password = value();
+            else if (arg == "--sessions") options.sessions = std::max<size_t>(1, std::stoul(value()));
+            else if (arg == "--rate") options.rate_hz = std::stod(value());
+            else if (arg == "--speech-rate") options.speech_rate_hz = std::stod(value());
+            else if (arg == "--tokens-rate") options.tokens_rate_hz = std::stod(value());
+            else if (arg == "--binary") options.binary = true;
+            else if (arg == "--producers") options.producers = std::max<size_t>(1, std::stoul(value()));
+            else if (arg == "--duration") options.duration_seconds = std::stod(value());
+            else if (arg == "--warmup") options.warmup_seconds = std::stod(value());
+            else if (arg == "--drain") options.drain_seconds = std::stod(value());
+            else if (arg == "--trace") options.trace_path = value();
+            else if (arg == "--speed") options.speed = std::max(1e-3, std::stod(value()));
+            else if (arg == "--sample-ms") options.sample_ms = std::max(10, std::stoi(value()));
+            else if (arg == "--json") options.json_path = value();
+            else if (arg == "--max-p99-ms") options.max_p99_ms = std::stod(value());
+            else if (arg == "--max-p999-ms") options.max_p999_ms = std::stod(value());
+            else if (arg == "--help" || arg == "-h") {
+                printUsage();
+                return 0;
+            } else {
+                std::cerr << "[LoadGen] Option inconnue: " << arg << "\n";
+                printUsage();
+                return 1;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[LoadGen] " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    TraceReader trace;
+    if (!options.trace_path.empty()) {
+        std::string error;
+        if (!trace.open(options.trace_path, &error)) {
+            std::cerr << "[LoadGen] Trace illisible: " << error << "\n";
+            return 1;
+        }
+        options.producers = 1;   // Ordre de la trace conservé
+    }
+
+    LoadCounters counters;
+    std::vector<DepthSample> samples;
+    std::atomic<bool> stop_consumer{false};
+    std::atomic<bool> stop_monitor{false};
+
+    try {
+        // Queue exclusive liée à la sortie, déclarée avant le premier envoi
+        auto output_channel = openChannel(options.rabbitmq);
+        output_channel->DeclareExchange(options.rabbitmq.output_exchange,
+                                        AmqpClient::Channel::EXCHANGE_TYPE_TOPIC, false, true, false);
+        const std::string output_queue = output_channel->DeclareQueue("", false, false, true, true);
+        output_channel->BindQueue(output_queue, options.rabbitmq.output_exchange,
+                                  options.rabbitmq.output_routing_key);
+        const std::string consumer_tag = output_channel->BasicConsume(output_queue, "", true, true, true, 1024);
+
+        // Départ commun légèrement différé : connexions des producteurs ouvertes
+        const auto start = Clock::now() + std::chrono::milliseconds(200);
+        const auto measure_start = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.warmup_seconds));
+        const auto end = start + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(options.warmup_seconds + options.duration_seconds));
+        const int64_t measure_start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            measure_start.time_since_epoch()).count();
+
+        std::thread consumer(outputConsumer, std::cref(options), std::cref(output_channel),
+                             std::cref(consumer_tag), measure_start_ns, std::cref(stop_consumer),
+                             std::ref(counters));
+        std::thread monitor(depthMonitor, std::cref(options), start, std::cref(stop_monitor),
+                            std::ref(counters), std::ref(samples));
+
+        std::vector<std::thread> producers;
+        if (!options.trace_path.empty()) {
+            producers.emplace_back(traceProducer, std::cref(options), std::cref(trace), start, measure_start,
+                                   end, std::ref(counters));
+        } else {
+            for (size_t p = 0; p < options.producers; ++p) {
+                producers.emplace_back(syntheticProducer, std::cref(options), p, start, measure_start, end,
+                                       std::ref(counters));
+            }
+        }
+        for (auto& producer : producers) producer.join();
+
+        // Dernières réponses en vol
+        std::this_thread::sleep_for(std::chrono::duration<double>(options.drain_seconds));
+        stop_consumer.store(true, std::memory_order_release);
+        stop_monitor.store(true, std::memory_order_release);
+        consumer.join();
+        monitor.join();
+
+        const json report = buildReport(options, counters, options.duration_seconds, samples);
+        printReport(report);
+
+        if (!options.json_path.empty()) {
+            std::ofstream out(options.json_path);
+            if (!out) {
+                std::cerr << "[LoadGen] Impossible d'écrire " << options.json_path << "\n";
+                return 1;
+            }
+            out << report.dump(2) << "\n";
+            std::cout << "[LoadGen] Rapport JSON: " << options.json_path << "\n";
+        }
+
+        bool failed = false;
+        if (options.max_p99_ms > 0.0 && report["end_to_end"]["p99_ms"].get<double>() > options.max_p99_ms) {
+            std::cerr << "[LoadGen] ✗ p99 au-dessus de " << options.max_p99_ms << " ms\n";
+            failed = true;
+        }
+        if (options.max_p999_ms > 0.0 && report["end_to_end"]["p999_ms"].get<double>() > options.max_p999_ms) {
+            std::cerr << "[LoadGen] ✗ p999 au-dessus de " << options.max_p999_ms << " ms\n";
+            failed = true;
+        }
+        if (counters.traced.load() == 0) {
+            std::cerr << "[LoadGen] ✗ Aucun état estampillé reçu (MCEE démarré ? en-tête "
+                      << options.rabbitmq.trace_header << " renvoyé ?)\n";
+            failed = true;
+        }
+        return failed ? 2 : 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "[LoadGen] Erreur RabbitMQ: " << e.what() << "\n";
+        stop_consumer.store(true);
+        stop_monitor.store(true);
+        return 1;
+    }
+}
@@ -14,6 +14,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <string>
 #include <chrono>
 #include <functional>
@@ -122,6 +123,7 @@ struct ADDOConfig {
     // ─────────────────────────────────────────────────────────────────────────
     double stochasticity_amplitude = 0.05;     // Amplitude du bruit
     double stochasticity_bias = 0.0;           // Biais (opportunités vs crises)
+    uint64_t stochasticity_seed = 0;           // Graine du bruit (0 = aléatoire)
 
     // ─────────────────────────────────────────────────────────────────────────
     // Influence Mémoire Graphe M_graph(t)
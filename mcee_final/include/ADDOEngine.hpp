@@ -12,31 +12,49 @@
 #pragma once
 
 #include "ADDOConfig.hpp"
+#include "ConfigProfile.hpp"
 #include "ConscienceConfig.hpp"
+#include "GoalKernels.hpp"
 #include "MCTGraph.hpp"
+#include "RollingWindow.hpp"
 #include "Types.hpp"
+#include <nlohmann/json.hpp>
 #include <memory>
-#include <deque>
 #include <mutex>
+#include <span>
 
 namespace mcee {
 
+/**
+ * @brief Entrées d'une session pour ADDOEngine::updateBatch
+ */
+struct GoalUpdateInput {
+    const EmotionalState* emotional_state = nullptr;
+    double sentiment = 0.0;     // Ft
+    double wisdom = 0.0;        // Wt
+};
+
 /**
  * @class ADDOEngine
  * @brief Moteur de détermination dynamique des objectifs
+ *
+ * Les matrices d'interactions et le mapping émotions sont partagés entre
+ * toutes les instances (goal::GoalKernels::defaults()) sous forme creuse.
+ * Profile fournit la configuration (ConfigProfile.hpp).
  */
-class ADDOEngine {
+template <typename Profile>
+class BasicADDOEngine {
 public:
     /**
      * @brief Constructeur avec configuration
-     * @param config Configuration ADDO
+     * @param profile Configuration ADDO (ou profil statique)
      */
-    explicit ADDOEngine(const ADDOConfig& config = ADDOConfig{});
+    explicit BasicADDOEngine(Profile profile = Profile{});
 
     /**
      * @brief Destructeur
      */
-    ~ADDOEngine() = default;
+    ~BasicADDOEngine() = default;
 
     // ═══════════════════════════════════════════════════════════════════════
     // MISE À JOUR PRINCIPALE
@@ -66,6 +84,19 @@ public:
                                double wisdom,
                                const MemoryGraphInfluence& memory_influence);
 
+    /**
+     * @brief Avance les objectifs de plusieurs sessions en un appel
+     * @param engines Moteurs des sessions (un verrou pris à la fois)
+     * @param inputs Entrées, une par moteur
+     * @param out États résultants, réécrits en place (pas de copie rendue)
+     *
+     * Chaque moteur suit exactement le chemin de update() ; les tables
+     * creuses communes restent chaudes en cache d'une session à l'autre.
+     */
+    static void updateBatch(std::span<BasicADDOEngine* const> engines,
+                            std::span<const GoalUpdateInput> inputs,
+                            std::span<GoalState> out);
+
     // ═══════════════════════════════════════════════════════════════════════
     // MODIFICATION DES VARIABLES
     // ═══════════════════════════════════════════════════════════════════════
@@ -184,12 +215,12 @@ public:
     /**
      * @brief Retourne la configuration
      */
-    [[nodiscard]] const ADDOConfig& getConfig() const { return config_; }
+    [[nodiscard]] const ADDOConfig& getConfig() const { return cfg(); }
 
     /**
      * @brief Retourne le mapping émotions → variables
      */
-    [[nodiscard]] const EmotionVariableMapping& getEmotionMapping() const { return emotion_mapping_; }
+    [[nodiscard]] const EmotionVariableMapping& getEmotionMapping() const { return kernels_.emotion_mapping; }
 
     // ═══════════════════════════════════════════════════════════════════════
     // INTÉGRATION MCTGraph
@@ -214,31 +245,50 @@ public:
     void setGoalChangeCallback(GoalChangeCallback callback);
     void setEmergencyCallback(EmergencyGoalCallback callback);
 
+    // ═══════════════════════════════════════════════════════════════════════
+    // SÉRIALISATION (checkpoint)
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Variables P/w/L, résilience, mode urgence, objectif et historique
+     */
+    [[nodiscard]] nlohmann::json toJson() const;
+
+    /**
+     * @brief Restaure un état produit par toJson() (la configuration est conservée)
+     */
+    void fromJson(const nlohmann::json& j);
+
     // ═══════════════════════════════════════════════════════════════════════
     // HISTORIQUE
     // ═══════════════════════════════════════════════════════════════════════
 
     /**
-     * @brief Retourne l'historique des objectifs
+     * @brief Retourne l'historique des objectifs (100 derniers, plus ancien en tête)
      */
-    [[nodiscard]] const std::deque<double>& getGoalHistory() const;
+    [[nodiscard]] const RingBuffer<double>& getGoalHistory() const;
 
     /**
      * @brief Retourne la tendance de l'objectif (croissant/décroissant)
+     *
+     * Pente des moindres carrés × n/2 : écart attendu entre la moitié
+     * récente et la moitié ancienne de l'historique. O(1).
      */
     [[nodiscard]] double getGoalTrend() const;
 
     /**
-     * @brief Retourne la stabilité de l'objectif
+     * @brief Retourne la stabilité de l'objectif (1 - 2·écart-type, O(1))
      */
     [[nodiscard]] double getGoalStability() const;
 
 private:
-    ADDOConfig config_;
+    [[no_unique_address]] Profile profile_;
+
+    [[nodiscard]] constexpr const ADDOConfig& cfg() const noexcept { return profile_.get(); }
+
     GoalState current_state_;
     GoalVariables variables_;
-    InteractionMatrix interactions_;
-    EmotionVariableMapping emotion_mapping_;
+    const goal::GoalKernels& kernels_;          // Tables creuses partagées
 
     // Connexion au MCTGraph pour M_graph(t)
     std::shared_ptr<MCTGraph> mct_graph_;
@@ -249,18 +299,17 @@ private:
     bool emergency_mode_ = false;
     std::string emergency_goal_;
 
-    // Historique
-    std::deque<double> goal_history_;
+    // Historique (fenêtre fixe, statistiques incrémentales)
     static constexpr size_t MAX_HISTORY_SIZE = 100;
+    RollingWindow<double> goal_history_{MAX_HISTORY_SIZE};
 
     // Callbacks
     GoalUpdateCallback on_update_;
     GoalChangeCallback on_goal_change_;
     EmergencyGoalCallback on_emergency_;
 
-    // Générateur aléatoire pour stochasticité
-    std::mt19937 rng_;
-    std::normal_distribution<double> noise_dist_;
+    // Générateur à compteur pour la stochasticité
+    goal::CounterRng rng_;
 
     mutable std::mutex mutex_;
 
@@ -268,6 +317,14 @@ private:
     // Méthodes privées
     // ─────────────────────────────────────────────────────────────────────────
 
+    /**
+     * @brief Corps de updateWithMemory (mutex_ déjà pris)
+     */
+    void advance(const EmotionalState& emotional_state,
+                 double sentiment,
+                 double wisdom,
+                 const MemoryGraphInfluence& memory_influence);
+
     /**
      * @brief Calcule Σ w_i·P_i·L_i
      */
@@ -341,4 +398,8 @@ private:
     void updateFromMCTGraph();
 };
 
+using RuntimeADDOEngine = BasicADDOEngine<RuntimeProfile<ADDOConfig>>;
+using ProductionADDOEngine = BasicADDOEngine<ProductionADDOProfile>;
+using ADDOEngine = BasicADDOEngine<ADDOProfile>;
+
 } // namespace mcee
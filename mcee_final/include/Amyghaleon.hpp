@@ -19,6 +19,7 @@
 #include "Types.hpp"
 #include "PhaseConfig.hpp"
 #include <functional>
+#include <span>
 #include <vector>
 
 namespace mcee {
@@ -45,7 +46,7 @@ public:
      */
     [[nodiscard]] bool checkEmergency(
         const EmotionalState& state,
-        const std::vector<Memory>& active_memories,
+        std::span<const MemoryRef> active_memories,
         double phase_threshold
     ) const;
 
@@ -83,10 +84,21 @@ public:
      * @return true si trauma activé
      */
     [[nodiscard]] bool isTraumaActivated(
-        const Memory& memory,
+        const MemoryRef& memory,
         double threshold
     ) const;
 
+    /**
+     * @brief Action associée à une émotion critique (littéral, sans allocation)
+     * @param emotion_index Indice EMO_* de l'émotion
+     */
+    [[nodiscard]] static const char* actionFor(size_t emotion_index);
+
+    /**
+     * @brief Priorité associée à une intensité (littéral, sans allocation)
+     */
+    [[nodiscard]] static const char* priorityFor(double emotion_value);
+
 private:
     size_t emergency_count_ = 0;
     EmergencyCallback on_emergency_;
@@ -0,0 +1,294 @@
+/**
+ * @file BoltClient.hpp
+ * @brief Transport Bolt natif (PackStream sur TCP) vers Neo4j
+ *
+ * Implémentation minimale du protocole Bolt (versions 5.0 et 4.2–4.4) :
+ * négociation, authentification basic / none, RUN + PULL en autocommit,
+ * RESET après échec. Les valeurs PackStream sont échangées sous forme de
+ * nlohmann::json, comme le reste du client Neo4j.
+ *
+ * - Pipelining : Connection::pipeline écrit tous les RUN/PULL d'un lot
+ *   en un seul envoi puis lit les réponses dans l'ordre.
+ * - Requêtes préparées : Statement encode une fois le texte Cypher ; le
+ *   serveur met en cache le plan de chaque texte paramétré constant.
+ * - Décodage en flux : chaque RECORD est décodé à son arrivée et passé au
+ *   RecordHandler, sans matérialiser le résultat complet.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcee::bolt {
+
+using json = nlohmann::json;
+
+/**
+ * @brief Erreur de transport (connexion, négociation, trame invalide)
+ *
+ * Les échecs Cypher rapportés par le serveur ne lèvent pas : ils sont
+ * retournés dans QueryResult et la connexion reste utilisable.
+ */
+class BoltError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Paramètres de connexion Bolt
+ */
+struct BoltConfig {
+    std::string host = "localhost";
+    int port = 7687;
+    std::string user = "neo4j";
+    std::string password;                  // Vide : authentification "none"
+    std::string database;                  // Vide : base par défaut du serveur
+    std::string user_agent = "mcee/3.0";
+    int connect_timeout_ms = 2000;
+    int io_timeout_ms = 5000;              // Lecture / écriture d'une trame
+    size_t pool_size = 4;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PACKSTREAM
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Encode une valeur JSON en PackStream (ajoutée à out)
+ *
+ * Entiers → INT, réels → FLOAT, objets → MAP, tableaux → LIST.
+ * Les chaînes binaires JSON (json::binary) deviennent BYTES.
+ */
+void pack(std::string& out, const json& value);
+
+/// En-tête de chaîne PackStream suivi des octets
+void packString(std::string& out, std::string_view s);
+
+/**
+ * @brief Décodeur PackStream sur un message complet
+ *
+ * Node et Relationship sont réduits à leurs propriétés ; les autres
+ * structures (dates, points...) deviennent {"tag": t, "fields": [...]}.
+ */
+class Unpacker {
+public:
+    Unpacker(const uint8_t* data, size_t size) noexcept : p_(data), end_(data + size) {}
+
+    /// En-tête de structure : nombre de champs et signature
+    void structHeader(size_t& fields, uint8_t& tag);
+
+    /// Longueur d'une liste (lève si la valeur n'est pas une liste)
+    size_t listHeader();
+
+    json value();
+
+    [[nodiscard]] bool atEnd() const noexcept { return p_ == end_; }
+
+private:
+    uint8_t byte();
+    uint64_t bigEndian(size_t bytes);
+    std::string string(size_t size);
+    json list(size_t size);
+    json map(size_t size);
+    json structure(size_t size);
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REQUÊTES
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Requête Cypher paramétrée, encodée une fois
+ */
+class Statement {
+public:
+    explicit Statement(std::string cypher);
+
+    [[nodiscard]] const std::string& cypher() const noexcept { return cypher_; }
+    [[nodiscard]] const std::string& packed() const noexcept { return packed_; }
+
+private:
+    std::string cypher_;
+    std::string packed_;                   // Chaîne PackStream (en-tête + UTF-8)
+};
+
+/**
+ * @brief Reçoit chaque enregistrement au fil du décodage
+ * @param fields Noms des colonnes (réponse au RUN)
+ * @param values Valeurs de l'enregistrement (vecteur réutilisé d'un enregistrement à l'autre)
+ */
+using RecordHandler = std::function<void(const std::vector<std::string>& fields,
+                                         std::vector<json>& values)>;
+
+struct Query {
+    const Statement* statement = nullptr;  // Requête préparée, ou
+    std::string cypher;                    // texte ad hoc si statement est nul
+    json params = json::object();
+    RecordHandler on_record;               // Enregistrements ignorés si vide
+};
+
+struct QueryResult {
+    bool success = false;
+    bool ignored = false;                  // Non exécutée : une requête précédente du lot a échoué
+    std::string code;                      // Code d'erreur Neo.* du serveur
+    std::string error;
+    size_t records = 0;
+    json summary;                          // Métadonnées du SUCCESS final (compteurs, bookmark)
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONNEXION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class Connection
+ * @brief Connexion Bolt authentifiée (un seul appelant à la fois)
+ */
+class Connection {
+public:
+    /**
+     * @brief Ouvre, négocie et authentifie une connexion
+     * @throws BoltError si le serveur est injoignable ou refuse la session
+     */
+    static std::unique_ptr<Connection> open(const BoltConfig& config);
+
+    ~Connection();
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    /**
+     * @brief Exécute un lot de requêtes en un aller-retour réseau
+     *
+     * Après un échec, le serveur ignore la suite du lot : les requêtes
+     * concernées sont marquées ignored (à resoumettre) et la connexion est
+     * réinitialisée par un RESET.
+     * @throws BoltError sur erreur de transport (connexion alors inutilisable)
+     */
+    std::vector<QueryResult> pipeline(std::span<const Query> queries);
+
+    /// Une requête (pipeline d'un élément)
+    QueryResult run(const Query& query);
+
+    [[nodiscard]] bool healthy() const noexcept { return fd_ >= 0 && !broken_; }
+    [[nodiscard]] uint8_t majorVersion() const noexcept { return major_; }
+    [[nodiscard]] uint8_t minorVersion() const noexcept { return minor_; }
+
+private:
+    Connection(int fd, const BoltConfig& config);
+
+    void handshake();
+    void hello();
+    void close() noexcept;
+
+    void appendRun(std::string& out, const Query& query) const;
+    static void appendPull(std::string& out);
+    static void appendMessage(std::string& out, const std::string& message);
+
+    void writeAll(const std::string& data);
+    void readExact(uint8_t* dst, size_t size);
+
+    /**
+     * @brief Lit un message complet (chunks jusqu'au marqueur 0x0000)
+     * @return Signature du message ; body décode les champs (dans message_)
+     */
+    uint8_t readMessage(Unpacker& body);
+
+    /// Lit la réponse à un RUN ou un PULL ; false sur FAILURE / IGNORED
+    bool readSummary(QueryResult& result, json* metadata);
+
+    int fd_ = -1;
+    bool broken_ = false;
+    uint8_t major_ = 0;
+    uint8_t minor_ = 0;
+    BoltConfig config_;
+    std::string db_extra_;                 // Map "extra" du RUN, encodée une fois
+
+    std::vector<uint8_t> in_;              // Tampon de lecture du socket
+    size_t in_begin_ = 0;
+    size_t in_end_ = 0;
+    std::string message_;                  // Message réassemblé
+    std::vector<std::string> fields_;
+    std::vector<json> values_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POOL
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class Pool
+ * @brief Connexions ouvertes à la demande, jusqu'à pool_size
+ */
+class Pool {
+public:
+    explicit Pool(BoltConfig config);
+    ~Pool();
+
+    /**
+     * @brief Connexion empruntée, rendue au pool à la destruction
+     *
+     * Une connexion en erreur de transport est fermée au lieu d'être rendue.
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        Lease(Pool* pool, std::unique_ptr<Connection> connection) noexcept
+            : pool_(pool), connection_(std::move(connection)) {}
+        Lease(Lease&&) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Connection* operator->() const noexcept { return connection_.get(); }
+        Connection& operator*() const noexcept { return *connection_; }
+        explicit operator bool() const noexcept { return connection_ != nullptr; }
+
+    private:
+        void release() noexcept;
+
+        Pool* pool_ = nullptr;
+        std::unique_ptr<Connection> connection_;
+    };
+
+    /**
+     * @brief Emprunte une connexion (ouverte si besoin)
+     * @throws BoltError si l'ouverture échoue ou si aucune ne se libère à temps
+     */
+    Lease acquire(std::chrono::milliseconds timeout);
+
+    /// Ferme les connexions inactives ; les emprunts en cours se ferment au retour
+    void close();
+
+    [[nodiscard]] size_t openConnections() const;
+    [[nodiscard]] const BoltConfig& config() const noexcept { return config_; }
+
+private:
+    void giveBack(std::unique_ptr<Connection> connection) noexcept;
+
+    BoltConfig config_;
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::vector<std::unique_ptr<Connection>> idle_;
+    size_t open_ = 0;
+    bool closed_ = false;
+};
+
+} // namespace mcee::bolt
@@ -0,0 +1,124 @@
+/**
+ * @file ConfigProfile.hpp
+ * @brief Profils de configuration des moteurs Conscience, ADDO et Décision
+ *
+ * ConscienceEngine, ADDOEngine et DecisionEngine lisaient leurs coefficients
+ * dans une copie de la configuration à chaque trame : le compilateur ne
+ * pouvait ni replier les produits par des constantes ni retirer les branches
+ * des fonctions désactivées (méta-actions, stochasticité, sigmoïde...).
+ * Chaque moteur est désormais paramétré par un profil :
+ * - RuntimeProfile<Config> conserve la configuration en membre, modifiable
+ *   (expérimentation, bench, valeurs lues au démarrage) ;
+ * - StaticProfile<Config, Values> renvoie une configuration constexpr : les
+ *   lectures deviennent des constantes de compilation et le moteur n'en
+ *   stocke aucune copie.
+ *
+ * Les deux instanciations sont compilées ; l'option MCEE_PRODUCTION_PROFILE
+ * choisit celle que désignent les alias ConscienceEngine, ADDOEngine et
+ * DecisionEngine (profil de production figé, sinon profil d'exécution).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ADDOConfig.hpp"
+#include "ConscienceConfig.hpp"
+#include "DecisionConfig.hpp"
+#include <cassert>
+
+namespace mcee {
+
+/**
+ * @brief Configuration portée par l'instance, modifiable
+ */
+template <typename Config>
+class RuntimeProfile {
+public:
+    using config_type = Config;
+    static constexpr bool is_static = false;
+
+    RuntimeProfile() = default;
+    RuntimeProfile(const Config& config) : config_(config) {}   // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] const Config& get() const noexcept { return config_; }
+    [[nodiscard]] Config& mutableConfig() noexcept { return config_; }
+
+private:
+    Config config_;
+};
+
+/**
+ * @brief Configuration fixée à la compilation
+ *
+ * Ne se construit qu'à partir de ses propres valeurs : passer une autre
+ * configuration à un moteur de profil statique est une erreur.
+ */
+template <typename Config, const Config& Values>
+class StaticProfile {
+public:
+    using config_type = Config;
+    static constexpr bool is_static = true;
+
+    constexpr StaticProfile() = default;
+    constexpr StaticProfile(const Config& config) noexcept {   // NOLINT(google-explicit-constructor)
+        assert(&config == &Values && "profil statique : configuration fixée à la compilation");
+        (void)config;
+    }
+
+    [[nodiscard]] static constexpr const Config& get() noexcept { return Values; }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PROFIL DE PRODUCTION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Valeurs appliquées par MCEEEngine aux moteurs de session
+ */
+inline constexpr ConscienceConfig PRODUCTION_CONSCIENCE_CONFIG = [] {
+    ConscienceConfig config;
+    config.beta_memory = 0.15;
+    config.delta_environment = 0.1;
+    config.omega_trauma = 5.0;
+    config.lambda_feedback = 0.2;
+    config.sentiment_smoothing = 0.1;
+    return config;
+}();
+
+inline constexpr ADDOConfig PRODUCTION_ADDO_CONFIG = [] {
+    ADDOConfig config;
+    config.use_wisdom_modulation = true;
+    config.use_sentiment_for_S = true;
+    config.emergency_override = true;
+    return config;
+}();
+
+inline constexpr DecisionConfig PRODUCTION_DECISION_CONFIG = [] {
+    DecisionConfig config;
+    config.tau_max_ms = 5000.0;
+    config.theta_veto = 0.80;
+    config.enable_meta_actions = true;
+    return config;
+}();
+
+using ProductionConscienceProfile = StaticProfile<ConscienceConfig, PRODUCTION_CONSCIENCE_CONFIG>;
+using ProductionADDOProfile = StaticProfile<ADDOConfig, PRODUCTION_ADDO_CONFIG>;
+using ProductionDecisionProfile = StaticProfile<DecisionConfig, PRODUCTION_DECISION_CONFIG>;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PROFIL DU BUILD
+// ═══════════════════════════════════════════════════════════════════════════
+
+#ifdef MCEE_PRODUCTION_PROFILE
+using ConscienceProfile = ProductionConscienceProfile;
+using ADDOProfile = ProductionADDOProfile;
+using DecisionProfile = ProductionDecisionProfile;
+#else
+using ConscienceProfile = RuntimeProfile<ConscienceConfig>;
+using ADDOProfile = RuntimeProfile<ADDOConfig>;
+using DecisionProfile = RuntimeProfile<DecisionConfig>;
+#endif
+
+} // namespace mcee
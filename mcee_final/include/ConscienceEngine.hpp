@@ -1,10 +1,13 @@
 #pragma once
 
+#include "ConfigProfile.hpp"
 #include "ConscienceConfig.hpp"
+#include "RollingWindow.hpp"
 #include "Types.hpp"
+#include <nlohmann/json.hpp>
 #include <memory>
 #include <mutex>
-#include <deque>
+#include <optional>
 #include <chrono>
 
 namespace mcee {
@@ -26,18 +29,22 @@ namespace mcee {
  *   - Ent      : Score environnemental
  *   - Wt       : Sagesse (croissance logarithmique)
  *   - γk       : Coefficients de sentiment par composante
+ *
+ * Profile fournit la configuration (ConfigProfile.hpp) : copie modifiable
+ * ou constantes de compilation du profil de production.
  * ═══════════════════════════════════════════════════════════════════════════
  */
-class ConscienceEngine {
+template <typename Profile>
+class BasicConscienceEngine {
 public:
-    explicit ConscienceEngine(const ConscienceConfig& config = ConscienceConfig{});
-    ~ConscienceEngine() = default;
+    explicit BasicConscienceEngine(Profile profile = Profile{});
+    ~BasicConscienceEngine() = default;
 
     // Non-copiable, déplaçable
-    ConscienceEngine(const ConscienceEngine&) = delete;
-    ConscienceEngine& operator=(const ConscienceEngine&) = delete;
-    ConscienceEngine(ConscienceEngine&&) = default;
-    ConscienceEngine& operator=(ConscienceEngine&&) = default;
+    BasicConscienceEngine(const BasicConscienceEngine&) = delete;
+    BasicConscienceEngine& operator=(const BasicConscienceEngine&) = delete;
+    BasicConscienceEngine(BasicConscienceEngine&&) = default;
+    BasicConscienceEngine& operator=(BasicConscienceEngine&&) = default;
 
     // ═══════════════════════════════════════════════════════════
     // MISE À JOUR PRINCIPALE
@@ -133,9 +140,23 @@ public:
     [[nodiscard]] double getSentimentMovingAverage() const;
 
     /**
-     * Récupère la configuration
+     * Récupère la configuration (αi initiaux : voir getEmotionCoefficients)
      */
-    [[nodiscard]] const ConscienceConfig& getConfig() const { return config_; }
+    [[nodiscard]] const ConscienceConfig& getConfig() const { return cfg(); }
+
+    // ═══════════════════════════════════════════════════════════
+    // SÉRIALISATION (checkpoint)
+    // ═══════════════════════════════════════════════════════════
+
+    /**
+     * Sagesse, expérience, traumas actifs, coefficients αi et historique du sentiment
+     */
+    [[nodiscard]] nlohmann::json toJson() const;
+
+    /**
+     * Restaure un état produit par toJson() (la configuration est conservée)
+     */
+    void fromJson(const nlohmann::json& j);
 
     // ═══════════════════════════════════════════════════════════
     // CALLBACKS
@@ -146,7 +167,12 @@ public:
     void setMLTModulationCallback(MLTModulationCallback callback);
 
 private:
-    ConscienceConfig config_;
+    [[no_unique_address]] Profile profile_;
+
+    [[nodiscard]] constexpr const ConscienceConfig& cfg() const noexcept { return profile_.get(); }
+
+    // Coefficients αi courants (modulés par MLT)
+    std::array<double, 24> alpha_emotions_;
 
     // État courant
     ConscienceSentimentState current_state_;
@@ -154,9 +180,8 @@ private:
     // Traumas actifs
     std::vector<TraumaState> active_traumas_;
 
-    // Historique du sentiment pour moyenne mobile
-    std::deque<double> sentiment_history_;
-    double sentiment_ema_ = 0.0;  // Exponential moving average
+    // Historique du sentiment (fenêtre de sentiment_window_seconds, EMA incluse)
+    RollingWindow<double> sentiment_history_;
 
     // Sagesse et expérience
     double experience_ = 0.0;
@@ -220,4 +245,8 @@ private:
     std::string determineDominantState(double consciousness, double sentiment) const;
 };
 
+using RuntimeConscienceEngine = BasicConscienceEngine<RuntimeProfile<ConscienceConfig>>;
+using ProductionConscienceEngine = BasicConscienceEngine<ProductionConscienceProfile>;
+using ConscienceEngine = BasicConscienceEngine<ConscienceProfile>;
+
 } // namespace mcee
@@ -0,0 +1,134 @@
+/**
+ * @file CowVector.hpp
+ * @brief Vecteur paginé à copie sur écriture, figeable en O(pages)
+ *
+ * Les éléments sont rangés par pages de 2^PageBits, chacune détenue par
+ * un shared_ptr. Copier le vecteur ne copie que la table des pages : la
+ * copie est une vue figée qui partage les pages avec l'original. Une
+ * écriture sur une page partagée la duplique d'abord (une seule fois par
+ * page et par vue vivante) ; les lecteurs de la vue ne voient donc jamais
+ * de modification.
+ *
+ * Un même CowVector n'est pas thread-safe ; deux copies peuvent en
+ * revanche être utilisées depuis des threads différents (la vue figée en
+ * lecture pendant que l'original est modifié sous le verrou du
+ * propriétaire).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+template <typename T, unsigned PageBits = 8>
+class CowVector {
+public:
+    static constexpr size_t PAGE_SIZE = size_t{1} << PageBits;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+        const_iterator(const CowVector* owner, size_t index) : owner_(owner), index_(index) {}
+
+        reference operator*() const { return (*owner_)[index_]; }
+        pointer operator->() const { return &(*owner_)[index_]; }
+        const_iterator& operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { auto copy = *this; ++index_; return copy; }
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const CowVector* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    const T& operator[](size_t i) const { return (*pages_[i >> PageBits])[i & MASK]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    /**
+     * @brief Accès en écriture (duplique la page si une vue la partage)
+     */
+    T& mut(size_t i) { return (*ownPage(i >> PageBits))[i & MASK]; }
+
+    void push_back(T value) {
+        if (size_ == pages_.size() * PAGE_SIZE) {
+            auto page = std::make_shared<Page>();
+            page->reserve(PAGE_SIZE);
+            pages_.push_back(std::move(page));
+        }
+        ownPage(pages_.size() - 1)->push_back(std::move(value));
+        ++size_;
+    }
+
+    void pop_back() {
+        if (size_ == 0) return;
+        const size_t last = pages_.size() - 1;
+        if (pages_[last]->size() == 1) {
+            pages_.pop_back();  // Page vidée : la vue éventuelle garde la sienne
+        } else {
+            ownPage(last)->pop_back();
+        }
+        --size_;
+    }
+
+    void clear() {
+        pages_.clear();
+        size_ = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t capacity() const { return pages_.size() * PAGE_SIZE; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size_); }
+
+    /// Copie dense (pour les API qui exposent un std::vector)
+    std::vector<T> toVector() const {
+        std::vector<T> out;
+        out.reserve(size_);
+        for (const auto& page : pages_) {
+            out.insert(out.end(), page->begin(), page->end());
+        }
+        return out;
+    }
+
+private:
+    using Page = std::vector<T>;
+    static constexpr size_t MASK = PAGE_SIZE - 1;
+
+    std::vector<std::shared_ptr<Page>> pages_;
+    size_t size_ = 0;
+
+    Page* ownPage(size_t p) {
+        auto& page = pages_[p];
+        if (page.use_count() > 1) {
+            auto copy = std::make_shared<Page>();
+            copy->reserve(PAGE_SIZE);
+            copy->insert(copy->end(), page->begin(), page->end());
+            page = std::move(copy);
+        } else {
+            // use_count() est une lecture relâchée : synchroniser avec la
+            // libération de la dernière vue avant de réécrire la page
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return page.get();
+    }
+};
+
+} // namespace mcee
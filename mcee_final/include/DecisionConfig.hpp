@@ -61,6 +61,8 @@ struct DecisionConfig {
     double alpha_ctx = 0.40;             // Poids similarité contextuelle
     double beta_emo = 0.40;              // Poids similarité émotionnelle
     double gamma_temp = 0.20;            // Poids proximité temporelle
+    size_t episode_top_k = 5;            // Épisodes rappelés par décision
+    size_t max_episodes = 4096;          // Capacité ME (0 = illimitée)
 
     // ─────────────────────────────────────────────────────────────────────────
     // Génération d'options
@@ -69,6 +71,12 @@ struct DecisionConfig {
     size_t top_k_refinement = 4;         // Options raffinées
     size_t max_simulation_depth = 3;     // Profondeur simulation max
 
+    // ─────────────────────────────────────────────────────────────────────────
+    // Projection parallèle (phases 3-4)
+    // ─────────────────────────────────────────────────────────────────────────
+    size_t projection_threads = 4;       // Tâches de projection/score (1 = séquentiel)
+    size_t parallel_min_options = 16;    // En dessous : projection séquentielle
+
     // ─────────────────────────────────────────────────────────────────────────
     // Profondeur de simulation (équation 3)
     // depth = 1 + ⌊κ_threshold / uncertainty(a_i)⌋
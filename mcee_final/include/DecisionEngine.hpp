@@ -14,33 +14,43 @@
 #pragma once
 
 #include "DecisionConfig.hpp"
+#include "ConfigProfile.hpp"
 #include "ConscienceConfig.hpp"
 #include "ADDOConfig.hpp"
+#include "EpisodeIndex.hpp"
 #include "MCTGraph.hpp"
+#include "RingBuffer.hpp"
 #include "Types.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <vector>
-#include <deque>
 #include <mutex>
 #include <random>
+#include <unordered_map>
 
 namespace mcee {
 
 /**
  * @class DecisionEngine
  * @brief Moteur de prise de décision réfléchie à 4 phases
+ *
+ * Profile fournit la configuration (ConfigProfile.hpp) ; sous un profil
+ * statique, les seuils ne sont pas modifiables.
  */
-class DecisionEngine {
+template <typename Profile>
+class BasicDecisionEngine {
 public:
     /**
      * @brief Constructeur avec configuration
      */
-    explicit DecisionEngine(const DecisionConfig& config = DecisionConfig{});
+    explicit BasicDecisionEngine(Profile profile = Profile{});
 
     /**
      * @brief Destructeur
      */
-    ~DecisionEngine() = default;
+    ~BasicDecisionEngine() = default;
 
     // ═══════════════════════════════════════════════════════════════════════
     // DÉCISION PRINCIPALE
@@ -131,12 +141,15 @@ public:
 
     /**
      * @brief Projette les conséquences d'une action
+     * @param deadline Fin du budget de délibération : la simulation n'est
+     *                 plus approfondie au-delà
      */
     ActionProjection projectAction(
         const ActionOption& action,
         const SituationFrame& frame,
         const MemoryContext& memory,
-        const GoalState& goals
+        const GoalState& goals,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()
     );
 
     /**
@@ -213,24 +226,24 @@ public:
     // ═══════════════════════════════════════════════════════════════════════
 
     /**
-     * @brief Modifie le seuil de veto
+     * @brief Modifie le seuil de veto (profil d'exécution uniquement)
      */
-    void setVetoThreshold(double theta);
+    void setVetoThreshold(double theta) requires (!Profile::is_static);
 
     /**
-     * @brief Active/désactive les méta-actions
+     * @brief Active/désactive les méta-actions (profil d'exécution uniquement)
      */
-    void enableMetaActions(bool enable);
+    void enableMetaActions(bool enable) requires (!Profile::is_static);
 
     /**
      * @brief Retourne la configuration
      */
-    [[nodiscard]] const DecisionConfig& getConfig() const { return config_; }
+    [[nodiscard]] const DecisionConfig& getConfig() const { return cfg(); }
 
     /**
-     * @brief Retourne l'historique des décisions
+     * @brief Retourne l'historique des décisions (100 dernières, plus ancienne en tête)
      */
-    [[nodiscard]] const std::deque<DecisionResult>& getDecisionHistory() const;
+    [[nodiscard]] const RingBuffer<DecisionResult>& getDecisionHistory() const;
 
     /**
      * @brief Retourne les statistiques
@@ -256,7 +269,9 @@ public:
     void setMCTGraph(std::shared_ptr<MCTGraph> mct_graph);
 
 private:
-    DecisionConfig config_;
+    [[no_unique_address]] Profile profile_;
+
+    [[nodiscard]] constexpr const DecisionConfig& cfg() const noexcept { return profile_.get(); }
 
     // Connexion au MCTGraph pour associations récentes
     std::shared_ptr<MCTGraph> mct_graph_;
@@ -266,15 +281,23 @@ private:
     std::vector<MemoryProcedure> procedures_;
     std::vector<SemanticConcept> concepts_;
 
-    // Historique
-    std::deque<DecisionResult> decision_history_;
+    // Index dérivés (positions dans les vecteurs ci-dessus)
+    EpisodeIndex episode_index_;
+    std::unordered_map<std::string, std::vector<size_t>> episodes_by_action_;
+    std::unordered_map<std::string, std::vector<size_t>> procedures_by_context_;
+    std::unordered_map<std::string, size_t> procedure_by_key_;    // id ou nom → 1re position
+    size_t next_episode_seq_ = 0;
+    std::vector<std::pair<double, size_t>> recall_buffer_;
+
+    // Historique (capacité fixe, la plus ancienne décision est écrasée)
     static constexpr size_t MAX_HISTORY_SIZE = 100;
+    RingBuffer<DecisionResult> decision_history_{MAX_HISTORY_SIZE};
 
-    // Statistiques
-    size_t total_decisions_ = 0;
-    size_t reflex_decisions_ = 0;
-    size_t meta_action_decisions_ = 0;
-    size_t veto_count_ = 0;
+    // Statistiques (atomiques : les phases 3-4 tournent hors du mutex)
+    std::atomic<size_t> total_decisions_{0};
+    std::atomic<size_t> reflex_decisions_{0};
+    std::atomic<size_t> meta_action_decisions_{0};
+    std::atomic<size_t> veto_count_{0};
 
     // Callbacks
     DecisionCallback on_decision_;
@@ -295,6 +318,21 @@ private:
     // Méthodes privées
     // ─────────────────────────────────────────────────────────────────────────
 
+    /**
+     * @brief Ajoute un épisode et ses index (mutex_ déjà pris)
+     */
+    void storeEpisode(const MemoryEpisode& episode);
+
+    /**
+     * @brief Ajoute une procédure et ses index (mutex_ déjà pris)
+     */
+    void storeProcedure(const MemoryProcedure& procedure);
+
+    /**
+     * @brief Évince les épisodes les plus anciens au-delà de max_episodes
+     */
+    void enforceEpisodeCapacity();
+
     /**
      * @brief Calcule la similarité entre un épisode et la situation (Éq. 2)
      * sim = α·sim_ctx + β·sim_emo + γ·sim_temp
@@ -308,7 +346,16 @@ private:
      * @brief Calcule la profondeur de simulation adaptative (Éq. 3)
      * depth = 1 + ⌊κ_threshold / uncertainty(a_i)⌋
      */
-    [[nodiscard]] size_t computeSimulationDepth(double uncertainty) const;
+    [[nodiscard]] size_t computeSimulationDepth(
+        double uncertainty,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()
+    ) const;
+
+    /**
+     * @brief Applique fn à chaque option, réparties sur projection_threads tâches
+     */
+    void forEachOption(std::vector<ActionOption>& options,
+                       const std::function<void(ActionOption&)>& fn) const;
 
     /**
      * @brief Modifie les poids de score selon Ft
@@ -384,4 +431,8 @@ private:
     ) const;
 };
 
+using RuntimeDecisionEngine = BasicDecisionEngine<RuntimeProfile<DecisionConfig>>;
+using ProductionDecisionEngine = BasicDecisionEngine<ProductionDecisionProfile>;
+using DecisionEngine = BasicDecisionEngine<DecisionProfile>;
+
 } // namespace mcee
@@ -0,0 +1,126 @@
+/**
+ * @file EmergencyLane.hpp
+ * @brief Voie rapide Amyghaleon, évaluée à l'ingestion des émotions
+ *
+ * Un pic de peur ou d'horreur ne doit pas attendre derrière MCTGraph,
+ * PatternMatcher et la requête mémoire. La voie rapide applique la règle
+ * « émotion critique > seuil » d'Amyghaleon directement sur le vecteur
+ * brut, dans le thread de consommation, avec le seuil du pattern actif
+ * publié par l'étage [match] : trois comparaisons, aucun verrou, aucune
+ * allocation. Les déclenchements passent par une file sans verrou vers une
+ * tâche de publication (classe EMERGENCY de l'Executor) ; le pipeline complet applique ensuite
+ * les effets internes (feedback, trauma) et publie l'état.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "Types.hpp"
+#include "PhaseConfig.hpp"
+#include "LockFreeQueue.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace mcee {
+
+/**
+ * @brief Déclenchement de la voie rapide (taille fixe, sans allocation)
+ */
+struct EmergencyLaneEvent {
+    size_t emotion_index = EMO_PEUR;    // Émotion critique la plus élevée
+    double value = 0.0;
+    double threshold = 0.0;             // Seuil du pattern actif lors de l'évaluation
+    Phase phase = Phase::SERENITE;
+    std::chrono::steady_clock::time_point ingest_time;
+};
+
+/**
+ * @class EmergencyLane
+ * @brief Seuils précalculés et file d'urgence prioritaire
+ *
+ * evaluate() et post() peuvent être appelés depuis n'importe quel thread
+ * d'ingestion ; un seul consommateur à la fois (tryNext ou waitNext).
+ */
+class EmergencyLane {
+public:
+    static constexpr double DEFAULT_THRESHOLD = 0.85;   // Sérénité, avant le premier match
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    explicit EmergencyLane(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Publie le seuil d'urgence du pattern actif (étage [match])
+     */
+    void setThreshold(double threshold) noexcept {
+        threshold_.store(threshold, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publie la phase courante (étage [update])
+     */
+    void setPhase(Phase phase) noexcept {
+        phase_.store(phase, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] double threshold() const noexcept {
+        return threshold_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Évalue une trame brute (même règle que l'étape 1 de checkEmergency)
+     * @param emotions Vecteur brut des 24 émotions
+     * @param ingest_time Réception du message
+     * @param event Déclenchement rempli si true
+     * @return true si une émotion critique dépasse le seuil
+     */
+    bool evaluate(const std::array<double, NUM_EMOTIONS>& emotions,
+                  std::chrono::steady_clock::time_point ingest_time,
+                  EmergencyLaneEvent& event) noexcept;
+
+    /**
+     * @brief Confie un déclenchement à la publication sans attendre
+     * @return false si la file est pleine (déclenchement compté comme perdu)
+     */
+    bool post(const EmergencyLaneEvent& event) noexcept;
+
+    /**
+     * @brief Retire le prochain déclenchement s'il y en a un (consommateur unique)
+     */
+    bool tryNext(EmergencyLaneEvent& event) noexcept {
+        return queue_.tryPop(event);
+    }
+
+    /**
+     * @brief Attend le prochain déclenchement (consommateur unique)
+     * @return false si arrêt demandé et file vide
+     */
+    bool waitNext(EmergencyLaneEvent& event, const std::atomic<bool>& keep_going) {
+        return queue_.waitPop(event, keep_going);
+    }
+
+    void wake() { queue_.wake(); }
+
+    /**
+     * @brief Réponse Amyghaleon équivalente au déclenchement
+     */
+    [[nodiscard]] static EmergencyResponse toResponse(const EmergencyLaneEvent& event);
+
+    [[nodiscard]] size_t triggerCount() const { return triggered_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t droppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    [[nodiscard]] size_t pending() const { return queue_.size(); }
+
+private:
+    static_assert(std::atomic<double>::is_always_lock_free, "seuil d'urgence lu sans verrou");
+
+    std::atomic<double> threshold_{DEFAULT_THRESHOLD};
+    std::atomic<Phase> phase_{Phase::SERENITE};
+    std::atomic<size_t> triggered_{0};
+    std::atomic<size_t> dropped_{0};
+    BoundedMPSCQueue<EmergencyLaneEvent> queue_;
+};
+
+} // namespace mcee
@@ -14,6 +14,11 @@
  * - Δt: Delta temps (décroissance naturelle)
  * - IS: Influence des souvenirs
  * - Wt: Coefficient de sagesse
+ *
+ * Seul δ·IS dépend de l'émotion : α·Fb_ext + β·Fb_int − γ·Δt + θ·Wt est
+ * calculé une fois par trame. updateState() fusionne mise à jour, bornage,
+ * variance vs souvenirs, E_global et résumé (dominante, valence, intensité)
+ * en une passe par blocs de EMOTION_LANES, vectorisable sans -ffast-math.
  */
 
 #ifndef MCEE_EMOTION_UPDATER_HPP
@@ -22,6 +27,7 @@
 #include "Types.hpp"
 #include "PhaseConfig.hpp"
 #include <array>
+#include <span>
 #include <vector>
 
 namespace mcee {
@@ -78,6 +84,24 @@ public:
         double wisdom
     );
 
+    /**
+     * @brief Mise à jour complète d'une trame en une passe
+     *
+     * Équivaut à updateAllEmotions, puis computeGlobalVariance(state, memories)
+     * et computeEGlobal(state, E_global_prev, variance) ; remplit
+     * state.emotions, state.variance_global et state.E_global.
+     * @return Résumé de l'état mis à jour
+     */
+    EmotionSummary updateState(
+        EmotionalState& state,
+        const Feedback& feedback,
+        double delta_t,
+        const std::array<double, NUM_EMOTIONS>& memory_influences,
+        double wisdom,
+        std::span<const MemoryRef> memories,
+        double E_global_prev
+    ) const;
+
     /**
      * @brief Calcule la variance d'une émotion par rapport aux souvenirs
      * @param E_current Valeur actuelle de l'émotion
@@ -99,7 +123,7 @@ public:
      */
     [[nodiscard]] double computeGlobalVariance(
         const EmotionalState& state,
-        const std::vector<Memory>& memories
+        std::span<const MemoryRef> memories
     ) const;
 
     /**
@@ -125,12 +149,36 @@ public:
     [[nodiscard]] double getTheta() const { return theta_; }
 
 private:
+    /**
+     * @brief E_i + terme commun + δ·IS_i, borné dans [0, 1], et réductions
+     */
+    EmotionSummary updateKernel(
+        const std::array<double, NUM_EMOTIONS>& current,
+        double common_term,
+        const std::array<double, NUM_EMOTIONS>& memory_influences,
+        std::array<double, NUM_EMOTIONS>& next
+    ) const;
+
+    [[nodiscard]] double commonTerm(const Feedback& feedback, double delta_t, double wisdom) const {
+        return alpha_ * feedback.external + beta_ * feedback.internal - gamma_ * delta_t + theta_ * wisdom;
+    }
+
+    /**
+     * @brief Var_global = (1/24)·Σ_i (1/m)·Σ_j (E_i − S_i,j)², sans allocation
+     */
+    static double memoryVariance(
+        const std::array<double, NUM_EMOTIONS>& emotions,
+        std::span<const MemoryRef> memories
+    );
+
+    static double eGlobal(double sum, double E_global_prev, double variance_global);
+
     // Coefficients dynamiques selon la phase
-    double alpha_;  // Coefficient feedback externe
-    double beta_;   // Coefficient feedback interne
-    double gamma_;  // Coefficient décroissance
-    double delta_;  // Coefficient influence souvenirs
-    double theta_;  // Coefficient sagesse
+    double alpha_{0.0};  // Coefficient feedback externe
+    double beta_{0.0};   // Coefficient feedback interne
+    double gamma_{0.0};  // Coefficient décroissance
+    double delta_{0.0};  // Coefficient influence souvenirs
+    double theta_{0.0};  // Coefficient sagesse
 };
 
 } // namespace mcee
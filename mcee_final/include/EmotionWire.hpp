@@ -0,0 +1,264 @@
+/**
+ * @file EmotionWire.hpp
+ * @brief Trame binaire versionnée de l'état à 24 émotions (RabbitMQ)
+ *
+ * Alternative compacte au JSON pour les flux haute fréquence : un en-tête
+ * fixe (timestamp, E_global, id de pattern) suivi des 24 émotions en
+ * float32 ou float64, dans l'ordre canonique de EMOTION_NAMES. Le format
+ * est annoncé par le content-type AMQP ; un consommateur qui ne le
+ * reconnaît pas retombe sur le JSON, conservé pour le débogage.
+ *
+ * Disposition (little-endian) :
+ *   [0]  magic "MCEF"          4 octets
+ *   [4]  version               u8
+ *   [5]  précision             u8 (0 = float64, 1 = float32)
+ *   [6]  nombre d'émotions     u16
+ *   [8]  timestamp_ms          i64 (epoch, horloge système)
+ *   [16] E_global              f64
+ *   [24] longueur pattern_id   u16, puis les octets de l'id
+ *   [..] émotions              nombre × (4 | 8) octets
+ *
+ * Lot de trames (content-type ...emotion-batch) :
+ *   [0]  magic "MCEB"          4 octets
+ *   [4]  version               u8
+ *   [5]  réservé               u8
+ *   [6]  nombre de trames      u16
+ *   [8]  par trame : longueur u32, puis la trame "MCEF" complète
+ *
+ * Autonome (pas de dépendance à Types.hpp) : inclus aussi par les modules
+ * emotion et reves.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace mcee {
+
+constexpr const char* WIRE_CONTENT_TYPE_JSON = "application/json";
+constexpr const char* WIRE_CONTENT_TYPE_FRAME = "application/vnd.mcee.emotion-frame";
+constexpr const char* WIRE_CONTENT_TYPE_BATCH = "application/vnd.mcee.emotion-batch";
+constexpr uint8_t WIRE_VERSION = 1;
+constexpr size_t WIRE_EMOTION_COUNT = 24;
+constexpr size_t WIRE_HEADER_SIZE = 26;
+
+enum class WirePrecision : uint8_t {
+    FLOAT64 = 0,
+    FLOAT32 = 1
+};
+
+/**
+ * @brief Contenu d'une trame émotionnelle
+ */
+struct EmotionFrame {
+    int64_t timestamp_ms = 0;
+    double e_global = 0.0;
+    std::string pattern_id;
+    std::array<double, WIRE_EMOTION_COUNT> emotions{};
+};
+
+namespace wire_detail {
+
+inline void putU64(std::string& out, uint64_t v, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+}
+
+inline uint64_t getU64(const unsigned char* p, size_t bytes) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return v;
+}
+
+inline void putF64(std::string& out, double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    putU64(out, bits, 8);
+}
+
+inline double getF64(const unsigned char* p) {
+    uint64_t bits = getU64(p, 8);
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+inline void putF32(std::string& out, double d) {
+    float f = static_cast<float>(d);
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    putU64(out, bits, 4);
+}
+
+inline double getF32(const unsigned char* p) {
+    uint32_t bits = static_cast<uint32_t>(getU64(p, 4));
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return static_cast<double>(f);
+}
+
+} // namespace wire_detail
+
+/**
+ * @brief Horodatage courant au format de la trame
+ */
+inline int64_t wireNowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Vrai si le content-type AMQP annonce une trame binaire
+ */
+inline bool isEmotionFrameContentType(const std::string& content_type) {
+    return content_type.compare(0, std::strlen(WIRE_CONTENT_TYPE_FRAME), WIRE_CONTENT_TYPE_FRAME) == 0;
+}
+
+/**
+ * @brief Vrai si le content-type AMQP annonce un lot de trames
+ */
+inline bool isEmotionBatchContentType(const std::string& content_type) {
+    return content_type.compare(0, std::strlen(WIRE_CONTENT_TYPE_BATCH), WIRE_CONTENT_TYPE_BATCH) == 0;
+}
+
+/**
+ * @brief Encode une trame
+ * @param precision float32 (défaut, 96 octets d'émotions) ou float64
+ */
+inline std::string encodeEmotionFrame(const EmotionFrame& frame,
+                                      WirePrecision precision = WirePrecision::FLOAT32) {
+    using namespace wire_detail;
+
+    const size_t id_len = frame.pattern_id.size() < 0xFFFF ? frame.pattern_id.size() : 0xFFFF;
+    const size_t value_size = precision == WirePrecision::FLOAT32 ? 4 : 8;
+
+    std::string out;
+    out.reserve(WIRE_HEADER_SIZE + id_len + WIRE_EMOTION_COUNT * value_size);
+
+    out.append("MCEF", 4);
+    out.push_back(static_cast<char>(WIRE_VERSION));
+    out.push_back(static_cast<char>(precision));
+    putU64(out, WIRE_EMOTION_COUNT, 2);
+    putU64(out, static_cast<uint64_t>(frame.timestamp_ms), 8);
+    putF64(out, frame.e_global);
+    putU64(out, id_len, 2);
+    out.append(frame.pattern_id.data(), id_len);
+
+    for (double v : frame.emotions) {
+        if (precision == WirePrecision::FLOAT32) {
+            putF32(out, v);
+        } else {
+            putF64(out, v);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Décode une trame
+ * @return false si le message est tronqué, d'une autre version ou mal formé
+ */
+inline bool decodeEmotionFrame(const std::string& body, EmotionFrame& out) {
+    using namespace wire_detail;
+
+    if (body.size() < WIRE_HEADER_SIZE || body.compare(0, 4, "MCEF") != 0) {
+        return false;
+    }
+    const auto* p = reinterpret_cast<const unsigned char*>(body.data());
+    if (p[4] != WIRE_VERSION) {
+        return false;
+    }
+
+    size_t value_size;
+    if (p[5] == static_cast<uint8_t>(WirePrecision::FLOAT32)) {
+        value_size = 4;
+    } else if (p[5] == static_cast<uint8_t>(WirePrecision::FLOAT64)) {
+        value_size = 8;
+    } else {
+        return false;
+    }
+
+    const size_t count = static_cast<size_t>(getU64(p + 6, 2));
+    const size_t id_len = static_cast<size_t>(getU64(p + 24, 2));
+    if (count != WIRE_EMOTION_COUNT ||
+        body.size() != WIRE_HEADER_SIZE + id_len + count * value_size) {
+        return false;
+    }
+
+    out.timestamp_ms = static_cast<int64_t>(getU64(p + 8, 8));
+    out.e_global = getF64(p + 16);
+    out.pattern_id.assign(body.data() + WIRE_HEADER_SIZE, id_len);
+
+    const unsigned char* values = p + WIRE_HEADER_SIZE + id_len;
+    for (size_t i = 0; i < count; ++i) {
+        out.emotions[i] = value_size == 4 ? getF32(values + i * 4) : getF64(values + i * 8);
+    }
+    return true;
+}
+
+/**
+ * @brief Encode un lot de trames (au plus 65535), dans l'ordre donné
+ */
+inline std::string encodeEmotionBatch(const std::vector<EmotionFrame>& frames,
+                                      WirePrecision precision = WirePrecision::FLOAT32) {
+    using namespace wire_detail;
+
+    const size_t count = frames.size() < 0xFFFF ? frames.size() : 0xFFFF;
+    std::string out;
+    out.append("MCEB", 4);
+    out.push_back(static_cast<char>(WIRE_VERSION));
+    out.push_back('\0');
+    putU64(out, count, 2);
+    for (size_t i = 0; i < count; ++i) {
+        const std::string frame = encodeEmotionFrame(frames[i], precision);
+        putU64(out, frame.size(), 4);
+        out.append(frame);
+    }
+    return out;
+}
+
+/**
+ * @brief Décode un lot de trames
+ * @return false si le lot ou l'une de ses trames est mal formé
+ */
+inline bool decodeEmotionBatch(const std::string& body, std::vector<EmotionFrame>& out) {
+    using namespace wire_detail;
+
+    out.clear();
+    if (body.size() < 8 || body.compare(0, 4, "MCEB") != 0) {
+        return false;
+    }
+    const auto* p = reinterpret_cast<const unsigned char*>(body.data());
+    if (p[4] != WIRE_VERSION) {
+        return false;
+    }
+
+    const size_t count = static_cast<size_t>(getU64(p + 6, 2));
+    size_t offset = 8;
+    out.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (body.size() - offset < 4) return false;
+        const size_t size = static_cast<size_t>(getU64(p + offset, 4));
+        offset += 4;
+        if (body.size() - offset < size) return false;
+        EmotionFrame frame;
+        if (!decodeEmotionFrame(body.substr(offset, size), frame)) return false;
+        out.push_back(std::move(frame));
+        offset += size;
+    }
+    return offset == body.size();
+}
+
+} // namespace mcee
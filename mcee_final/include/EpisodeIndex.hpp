@@ -0,0 +1,97 @@
+/**
+ * @file EpisodeIndex.hpp
+ * @brief Index du rappel épisodique (ME) de DecisionEngine
+ *
+ * Les épisodes sont partitionnés par type de contexte interné ; dans
+ * chaque partition, les émotions comparées par l'équation 2 sont rangées
+ * par colonne, de façon contiguë. Le score d'une partition se calcule en
+ * quelques boucles séquentielles (vectorisables par le compilateur), et
+ * les partitions dont la borne supérieure ne peut plus entrer dans le
+ * top-k sont ignorées.
+ *
+ * L'index ne possède pas les épisodes : il référence leur position dans
+ * le vecteur de DecisionEngine et doit être reconstruit si elle change.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "DecisionConfig.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @class EpisodeIndex
+ * @brief Top-k des épisodes les plus similaires à Σ(t)
+ *
+ * Non thread-safe : protégé par le mutex de DecisionEngine.
+ */
+class EpisodeIndex {
+public:
+    /// Émotions comparées par sim_emo (cf. computeEpisodeSimilarity)
+    static constexpr size_t COMPARED_EMOTIONS = 6;
+
+    EpisodeIndex();
+
+    /**
+     * @brief Indexe un épisode
+     * @param row Position de l'épisode dans le vecteur propriétaire
+     */
+    void add(size_t row, const MemoryEpisode& episode);
+
+    /**
+     * @brief Réindexe tout le vecteur (après éviction)
+     */
+    void rebuild(const std::vector<MemoryEpisode>& episodes);
+
+    void clear();
+
+    /**
+     * @brief Les k épisodes les plus similaires (Éq. 2)
+     * @param out Paires (similarité, position), de la plus similaire à la moins
+     *            similaire ; à similarité égale, l'épisode le plus ancien d'abord
+     */
+    void topK(const SituationFrame& frame,
+              const DecisionConfig& config,
+              size_t k,
+              std::chrono::steady_clock::time_point now,
+              std::vector<std::pair<double, size_t>>& out) const;
+
+    /**
+     * @brief sim_ctx entre deux types de contexte
+     */
+    static double contextSimilarity(const std::string& a, const std::string& b);
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] size_t partitionCount() const { return partitions_.size(); }
+
+private:
+    struct Partition {
+        std::string context_type;
+        std::vector<std::vector<double>> emotion_cols;   // Une colonne par émotion résolue
+        std::vector<std::chrono::steady_clock::time_point> timestamps;
+        std::vector<size_t> rows;
+    };
+
+    // Indices dans EMOTION_NAMES des émotions comparées qui existent
+    std::vector<size_t> emotion_slots_;
+
+    std::vector<Partition> partitions_;
+    std::unordered_map<std::string, uint32_t> partition_of_;
+    size_t size_{0};
+
+    // Tampons de scoring réutilisés entre requêtes
+    mutable std::vector<double> distances_;
+    mutable std::vector<std::pair<double, uint32_t>> partition_order_;
+};
+
+} // namespace mcee
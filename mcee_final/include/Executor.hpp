@@ -0,0 +1,662 @@
+/**
+ * @file Executor.hpp
+ * @brief Exécuteur partagé : pool à vol de tâches, classes de priorité,
+ *        futures, annulation et minuteries
+ *
+ * Un seul pool de workers (un par cœur) sert tous les modules. Chaque worker
+ * a sa propre file par classe ; il sert d'abord la sienne, puis vole dans
+ * celles des autres, toujours dans l'ordre des classes :
+ *   EMERGENCY > PIPELINE > BACKGROUND
+ * Un worker supplémentaire, réservé à EMERGENCY, garantit qu'une urgence ne
+ * reste jamais derrière des appels LLM ou une passe d'apprentissage.
+ *
+ * Les files sont bornées par classe : une soumission au-delà est rejetée
+ * (TaskRejected) au lieu de faire croître la mémoire ou le nombre de threads.
+ * TaskLane ajoute au-dessus une file propre à un module, avec sa propre
+ * concurrence maximale (appels LLM bloquants, passe unique d'apprentissage).
+ *
+ * Les threads de consommation RabbitMQ et les étages du pipeline restent des
+ * threads dédiés : ils bloquent sur leur canal ou leur file par conception.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "Metrics.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Classe de priorité d'une tâche (ordre de service)
+ */
+enum class TaskClass : uint8_t {
+    EMERGENCY = 0,      // Voie rapide Amyghaleon
+    PIPELINE = 1,       // Réponses, recherches, délibérations
+    BACKGROUND = 2      // Apprentissage, snapshots, métriques
+};
+
+inline constexpr size_t TASK_CLASS_COUNT = 3;
+
+[[nodiscard]] const char* taskClassName(TaskClass cls) noexcept;
+
+/**
+ * @brief Tâche rejetée (file de sa classe pleine ou exécuteur arrêté)
+ */
+class TaskRejected : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Tâche annulée avant son exécution
+ */
+class TaskCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ANNULATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class CancellationToken
+ * @brief Vue en lecture d'une annulation ; un jeton par défaut n'est jamais annulé
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    [[nodiscard]] bool isCancelled() const noexcept {
+        return state_ && state_->cancelled.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool canBeCancelled() const noexcept { return state_ != nullptr; }
+
+    /**
+     * @brief Appelle callback à l'annulation (tout de suite si déjà annulé)
+     */
+    void onCancel(std::function<void()> callback) const;
+
+private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::vector<std::function<void()>> callbacks;
+    };
+
+    std::shared_ptr<State> state_;
+
+    friend class CancellationSource;
+};
+
+/**
+ * @class CancellationSource
+ * @brief Émetteur d'une annulation, partagée par tous ses jetons
+ */
+class CancellationSource {
+public:
+    CancellationSource() : state_(std::make_shared<CancellationToken::State>()) {}
+
+    [[nodiscard]] CancellationToken token() const;
+
+    /**
+     * @brief Annule (idempotent) : les tâches en file ne s'exécuteront pas
+     */
+    void cancel();
+
+    [[nodiscard]] bool isCancelled() const noexcept {
+        return state_->cancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    std::shared_ptr<CancellationToken::State> state_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FUTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+class Executor;
+
+namespace detail {
+
+struct Unit {};
+
+template <typename T>
+using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+/**
+ * @brief État partagé d'une future : attente, erreur et continuations
+ */
+class FutureStateBase {
+public:
+    explicit FutureStateBase(Executor* executor) : executor_(executor) {}
+    virtual ~FutureStateBase() = default;
+
+    [[nodiscard]] bool ready() const noexcept { return ready_.load(std::memory_order_acquire); }
+    [[nodiscard]] Executor* executor() const noexcept { return executor_; }
+
+    /**
+     * @brief Attend la résolution ; sur un worker, exécute des tâches en file
+     *        pendant l'attente pour ne jamais bloquer le pool sur lui-même
+     */
+    void wait() const;
+    [[nodiscard]] bool waitUntil(std::chrono::steady_clock::time_point deadline) const;
+
+    void setError(std::exception_ptr error);
+
+    /**
+     * @brief Appelé à la résolution, sur le thread qui résout (tout de suite
+     *        si déjà résolue)
+     */
+    void onReady(std::function<void()> callback);
+
+    [[nodiscard]] std::exception_ptr error() const;
+
+protected:
+    template <typename Store>
+    void resolve(Store&& store) {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (ready_.load(std::memory_order_relaxed)) return;
+            store();
+            ready_.store(true, std::memory_order_release);
+            callbacks.swap(callbacks_);
+        }
+        cv_.notify_all();
+        for (auto& callback : callbacks) callback();
+    }
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable cv_;
+    std::atomic<bool> ready_{false};
+    std::exception_ptr error_;
+    std::vector<std::function<void()>> callbacks_;
+    Executor* executor_;
+};
+
+template <typename T>
+class FutureState : public FutureStateBase {
+public:
+    using FutureStateBase::FutureStateBase;
+
+    void setValue(Stored<T> value) {
+        resolve([&]() { value_.emplace(std::move(value)); });
+    }
+
+    /// Valeur (déplacée) ou exception de la tâche
+    Stored<T> take() {
+        wait();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) std::rethrow_exception(error_);
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<Stored<T>> value_;
+};
+
+} // namespace detail
+
+/**
+ * @class TaskFuture
+ * @brief Résultat d'une tâche soumise à l'Executor
+ *
+ * Contrairement à std::async, détruire une TaskFuture ne bloque pas : la
+ * tâche continue et son résultat est simplement abandonné.
+ */
+template <typename T>
+class TaskFuture {
+public:
+    TaskFuture() = default;
+    explicit TaskFuture(std::shared_ptr<detail::FutureState<T>> state) : state_(std::move(state)) {}
+
+    [[nodiscard]] bool valid() const noexcept { return state_ != nullptr; }
+    [[nodiscard]] bool ready() const noexcept { return state_ && state_->ready(); }
+
+    void wait() const { state_->wait(); }
+
+    [[nodiscard]] bool waitUntil(std::chrono::steady_clock::time_point deadline) const {
+        return state_->waitUntil(deadline);
+    }
+
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool waitFor(std::chrono::duration<Rep, Period> timeout) const {
+        return state_->waitUntil(std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+    }
+
+    /**
+     * @brief Résultat (une seule fois) ; relance l'exception de la tâche,
+     *        TaskCancelled ou TaskRejected
+     */
+    T get() {
+        if constexpr (std::is_void_v<T>) {
+            state_->take();
+        } else {
+            return state_->take();
+        }
+    }
+
+    /**
+     * @brief Continuation soumise dans la classe cls quand cette tâche se
+     *        termine ; reçoit le résultat (consommé). Une erreur se propage
+     *        sans appeler fn.
+     */
+    template <typename F>
+    auto then(TaskClass cls, F fn);
+
+private:
+    std::shared_ptr<detail::FutureState<T>> state_;
+
+    template <typename> friend class TaskFuture;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EXÉCUTEUR
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Configuration de l'exécuteur
+ */
+struct ExecutorConfig {
+    size_t threads = 0;                         // Workers ; 0 = un par cœur
+    bool reserve_emergency_worker = true;       // Worker en plus, réservé à EMERGENCY
+    std::array<size_t, TASK_CLASS_COUNT> max_queued{
+        1024,   // EMERGENCY
+        8192,   // PIPELINE
+        4096    // BACKGROUND
+    };
+};
+
+/**
+ * @brief Lit la section "executor" d'un fichier JSON
+ * @return false si le fichier est illisible ou sans section (config inchangée)
+ */
+bool readExecutorConfig(const std::string& path, ExecutorConfig& config);
+
+/**
+ * @brief Compteurs d'une classe de priorité
+ */
+struct ExecutorClassStats {
+    size_t queued = 0;          // En file à l'instant
+    uint64_t submitted = 0;
+    uint64_t executed = 0;
+    uint64_t rejected = 0;      // File pleine ou exécuteur arrêté
+    uint64_t cancelled = 0;     // Annulées avant exécution
+    uint64_t failed = 0;        // Terminées sur une exception
+};
+
+/**
+ * @class Executor
+ * @brief Pool de workers à vol de tâches, classes de priorité bornées
+ */
+class Executor {
+public:
+    explicit Executor(const ExecutorConfig& config = ExecutorConfig());
+
+    /**
+     * @brief Arrête : les tâches encore en file sont annulées
+     */
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Exécuteur du processus, créé au premier appel
+     */
+    static std::shared_ptr<Executor> shared();
+
+    /**
+     * @brief Configure l'exécuteur partagé avant sa création
+     * @return false s'il existe déjà (configuration ignorée)
+     */
+    static bool configureShared(const ExecutorConfig& config);
+
+    /**
+     * @brief Exécuteur dont le thread courant est un worker (nullptr sinon)
+     */
+    [[nodiscard]] static Executor* current() noexcept;
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // SOUMISSION
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Soumet une tâche et rend sa future
+     *
+     * Depuis un worker, la tâche va dans la file de ce worker ; sinon, dans
+     * celle d'un worker choisi à tour de rôle. Une file pleine ou un
+     * exécuteur arrêté rendent une future déjà en erreur (TaskRejected).
+     */
+    template <typename F>
+    auto submit(TaskClass cls, F fn, CancellationToken token = {})
+        -> TaskFuture<std::invoke_result_t<F>>;
+
+    /**
+     * @brief Soumet une tâche sans résultat
+     * @return false si rejetée
+     */
+    bool post(TaskClass cls, std::function<void()> fn, CancellationToken token = {});
+
+    /**
+     * @brief Soumet une tâche après un délai (abandonnée si annulée d'ici là)
+     */
+    bool postAfter(std::chrono::steady_clock::duration delay, TaskClass cls,
+                   std::function<void()> fn, CancellationToken token = {});
+
+    /**
+     * @brief Tâche périodique : fn, puis attente de period, tant que token
+     *        n'est pas annulé (une exécution à la fois, jamais de chevauchement)
+     * @return Future résolue quand la tâche s'arrête (annulation ou arrêt de
+     *         l'exécuteur), après sa dernière exécution
+     */
+    TaskFuture<void> schedulePeriodic(std::chrono::steady_clock::duration period, TaskClass cls,
+                                      std::function<void()> fn, CancellationToken token);
+
+    /**
+     * @brief Exécute une tâche en file depuis un worker de cet exécuteur
+     * @return false si rien à faire, ou si le thread n'est pas un worker
+     */
+    bool runPendingTask();
+
+    /**
+     * @brief Arrête les workers et la minuterie (idempotent)
+     */
+    void shutdown();
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // MÉTRIQUES
+    // ═══════════════════════════════════════════════════════════════════════
+
+    [[nodiscard]] size_t workerCount() const { return workers_.size(); }
+    [[nodiscard]] const ExecutorConfig& getConfig() const { return config_; }
+    [[nodiscard]] ExecutorClassStats classStats(TaskClass cls) const;
+
+    /**
+     * @brief Familles mcee_executor_* (profondeur, issues, attente par classe)
+     */
+    void renderMetrics(PrometheusWriter& out) const;
+
+    /**
+     * @brief Attente en file (soumission → début d'exécution) d'une classe
+     */
+    [[nodiscard]] const LatencyHistogram& queueWait(TaskClass cls) const {
+        return counters_[static_cast<size_t>(cls)].wait;
+    }
+
+private:
+    using TaskBody = std::function<bool(bool run)>;   // run=false : annulée ; false si exception
+
+    struct Task {
+        TaskBody body;
+        CancellationToken token;
+        std::chrono::steady_clock::time_point enqueued;
+        TaskClass cls = TaskClass::PIPELINE;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::array<std::deque<Task>, TASK_CLASS_COUNT> tasks;
+        bool closed = false;
+        bool emergency_only = false;
+    };
+
+    struct ClassCounters {
+        std::atomic<size_t> queued{0};
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> cancelled{0};
+        std::atomic<uint64_t> failed{0};
+        LatencyHistogram wait;
+    };
+
+    struct TimerEntry {
+        std::chrono::steady_clock::time_point due;
+        uint64_t seq = 0;
+        std::function<void(bool fire)> fire;   // fire=false : abandonnée
+        CancellationToken token;
+    };
+
+    /// Minuterie partagée avec les rappels d'annulation (qui peuvent survivre à l'exécuteur)
+    struct TimerQueue {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<TimerEntry> heap;
+        uint64_t next_seq = 0;
+        bool sweep = false;                     // Annulation signalée : entrées à purger
+        bool stop = false;
+    };
+
+    struct Periodic;
+
+    ExecutorConfig config_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    size_t general_workers_ = 0;                // Workers toutes classes (index < general_workers_)
+
+    std::array<ClassCounters, TASK_CLASS_COUNT> counters_;
+    std::atomic<size_t> queued_total_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<bool> stop_{false};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable emergency_cv_;
+
+    std::shared_ptr<TimerQueue> timers_;
+    std::thread timer_thread_;
+    std::once_flag shutdown_once_;
+
+    /**
+     * @brief Met une tâche en file
+     * @param bounded Refuse au-delà de max_queued (les TaskLane bornent elles-mêmes)
+     */
+    bool enqueue(Task&& task, bool bounded);
+
+    bool popTask(size_t index, Task& out);
+    void execute(Task& task);
+    void workerLoop(size_t index);
+
+    void addTimer(std::chrono::steady_clock::time_point due, std::function<void(bool)> fire,
+                  CancellationToken token);
+    void timerLoop();
+    void armPeriodic(const std::shared_ptr<Periodic>& periodic);
+
+    friend class TaskLane;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VOIE D'UN MODULE
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class TaskLane
+ * @brief File bornée d'un module sur l'Executor, à concurrence limitée
+ *
+ * Les tâches d'une voie ne prennent jamais plus de max_concurrency workers :
+ * des appels bloquants (LLM, Neo4j) ne peuvent pas occuper tout le pool.
+ * Avec max_concurrency = 1, les tâches s'exécutent une par une, dans l'ordre.
+ * La voie suit ses tâches en cours : close() les attend, ce qui permet au
+ * module propriétaire de capturer this sans risque.
+ */
+class TaskLane {
+public:
+    static constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+    /**
+     * @param executor nullptr : Executor::shared(), résolu à la première tâche
+     */
+    explicit TaskLane(TaskClass cls, size_t max_concurrency = 1, size_t max_pending = UNBOUNDED,
+                      std::shared_ptr<Executor> executor = nullptr);
+
+    /**
+     * @brief Ferme la voie (attend les tâches en cours)
+     */
+    ~TaskLane();
+
+    TaskLane(const TaskLane&) = delete;
+    TaskLane& operator=(const TaskLane&) = delete;
+
+    /**
+     * @brief Confie une tâche à la voie
+     * @return false si la file est pleine ou la voie fermée
+     */
+    bool post(std::function<void()> task);
+
+    /**
+     * @brief Refuse les nouvelles tâches, abandonne la file, attend les
+     *        tâches en cours (sauf celle qui appelle close())
+     * @return Nombre de tâches abandonnées
+     */
+    size_t close();
+
+    /**
+     * @brief Rouvre une voie fermée
+     */
+    void open();
+
+    /**
+     * @brief Attend que la file soit vide et qu'aucune tâche ne tourne
+     */
+    void waitIdle() const;
+
+    void setLimits(size_t max_concurrency, size_t max_pending);
+
+    [[nodiscard]] size_t pending() const;
+    [[nodiscard]] size_t running() const;
+    [[nodiscard]] uint64_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+    [[nodiscard]] TaskClass taskClass() const { return cls_; }
+
+private:
+    TaskClass cls_;
+    size_t max_concurrency_;
+    size_t max_pending_;
+    std::shared_ptr<Executor> executor_;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable idle_cv_;
+    std::deque<std::function<void()>> queue_;
+    size_t running_ = 0;
+    bool closed_ = false;
+    std::atomic<uint64_t> rejected_{0};
+
+    /// Lance autant de tâches que la concurrence le permet (mutex_ tenu, relâché)
+    void dispatch(std::unique_lock<std::mutex>& lock);
+    void finish();
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IMPLÉMENTATION DES MODÈLES
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename F>
+auto Executor::submit(TaskClass cls, F fn, CancellationToken token)
+    -> TaskFuture<std::invoke_result_t<F>>
+{
+    using R = std::invoke_result_t<F>;
+    auto state = std::make_shared<detail::FutureState<R>>(this);
+
+    Task task;
+    task.cls = cls;
+    task.token = std::move(token);
+    task.body = [state, fn = std::move(fn)](bool run) mutable -> bool {
+        if (!run) {
+            state->setError(std::make_exception_ptr(TaskCancelled("tâche annulée")));
+            return true;
+        }
+        try {
+            if constexpr (std::is_void_v<R>) {
+                fn();
+                state->setValue(detail::Unit{});
+            } else {
+                state->setValue(fn());
+            }
+            return true;
+        } catch (...) {
+            state->setError(std::current_exception());
+            return false;
+        }
+    };
+
+    if (!enqueue(std::move(task), true)) {
+        state->setError(std::make_exception_ptr(TaskRejected(
+            std::string("file ") + taskClassName(cls) + " pleine ou exécuteur arrêté")));
+    }
+    return TaskFuture<R>(std::move(state));
+}
+
+template <typename T>
+template <typename F>
+auto TaskFuture<T>::then(TaskClass cls, F fn) {
+    using R = std::conditional_t<std::is_void_v<T>, std::invoke_result<F>,
+                                 std::invoke_result<F, T>>;
+    using U = typename R::type;
+
+    Executor* executor = state_->executor();
+    auto next = std::make_shared<detail::FutureState<U>>(executor);
+    auto source = state_;
+
+    source->onReady([executor, cls, source, next, fn = std::move(fn)]() mutable {
+        if (auto error = source->error()) {
+            next->setError(error);
+            return;
+        }
+        auto run = [source, next, fn = std::move(fn)]() mutable {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    source->take();
+                    if constexpr (std::is_void_v<U>) {
+                        fn();
+                        next->setValue(detail::Unit{});
+                    } else {
+                        next->setValue(fn());
+                    }
+                } else {
+                    if constexpr (std::is_void_v<U>) {
+                        fn(source->take());
+                        next->setValue(detail::Unit{});
+                    } else {
+                        next->setValue(fn(source->take()));
+                    }
+                }
+            } catch (...) {
+                next->setError(std::current_exception());
+            }
+        };
+        // Rejetée ou annulée avant de s'exécuter : l'erreur passe à la suite
+        auto step = executor->submit(cls, std::move(run));
+        auto* step_state = step.state_.get();
+        step_state->onReady([step_state, next]() {
+            if (auto error = step_state->error()) next->setError(error);
+        });
+    });
+    return TaskFuture<U>(std::move(next));
+}
+
+} // namespace mcee
@@ -0,0 +1,142 @@
+/**
+ * @file FrameArena.hpp
+ * @brief Arène monotone par trame et compteur d'allocations du tas global
+ *
+ * Chaque étage du pipeline possède une FrameArena : un tampon alloué une
+ * fois à la construction, servi par un std::pmr::monotonic_buffer_resource
+ * et rembobiné à la fin de chaque trame (FrameArena::Scope). Les
+ * conteneurs temporaires d'un étage (souvenirs interrogés, contexte du
+ * souvenir, texte JSON publié) prennent son polymorphic_allocator ; rien
+ * de ce qui y est alloué ne doit survivre à l'étage.
+ *
+ * Un dépassement du tampon n'est pas une erreur : la ressource amont
+ * (le tas) prend le relais jusqu'au rembobinage et le débordement est
+ * compté. Un compteur régulièrement non nul signale un tampon trop petit.
+ *
+ * HeapAllocationScope mesure les allocations du tas global faites par le
+ * thread courant ; il n'est alimenté que si les opérateurs new globaux
+ * sont instrumentés (option CMake MCEE_COUNT_HEAP_ALLOCATIONS).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace mcee {
+
+namespace heap {
+
+/// Vrai si operator new est instrumenté dans ce binaire
+bool countingEnabled() noexcept;
+
+/// Allocations du tas global faites par le thread appelant depuis son démarrage
+uint64_t threadAllocations() noexcept;
+
+} // namespace heap
+
+/**
+ * @brief Ajoute à un compteur les allocations du thread courant pendant la portée
+ */
+class HeapAllocationScope {
+public:
+    explicit HeapAllocationScope(uint64_t& counter) noexcept
+        : counter_(counter), start_(heap::threadAllocations()) {}
+    ~HeapAllocationScope() { counter_ += heap::threadAllocations() - start_; }
+
+    HeapAllocationScope(const HeapAllocationScope&) = delete;
+    HeapAllocationScope& operator=(const HeapAllocationScope&) = delete;
+
+private:
+    uint64_t& counter_;
+    uint64_t start_;
+};
+
+/**
+ * @brief Arène monotone rembobinée à chaque trame
+ *
+ * Un seul thread à la fois (l'étage propriétaire) alloue dans l'arène ;
+ * les compteurs peuvent être lus depuis n'importe quel thread.
+ */
+class FrameArena {
+public:
+    /**
+     * @brief Rembobine l'arène à la sortie de la portée (fin de trame)
+     */
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena) noexcept : arena_(arena) {}
+        ~Scope() { arena_.reset(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameArena& arena_;
+    };
+
+    explicit FrameArena(size_t capacity)
+        : capacity_(capacity)
+        , buffer_(std::make_unique<std::byte[]>(capacity))
+        , upstream_(*this)
+        , resource_(buffer_.get(), capacity_, &upstream_) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() noexcept { return &resource_; }
+
+    template <typename T = std::byte>
+    [[nodiscard]] std::pmr::polymorphic_allocator<T> allocator() noexcept { return {&resource_}; }
+
+    /// Libère les débordements et repart du début du tampon
+    void reset() noexcept {
+        resource_.release();
+        frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] uint64_t frames() const noexcept { return frames_.load(std::memory_order_relaxed); }
+    /// Blocs demandés au tas parce que le tampon était plein
+    [[nodiscard]] uint64_t spills() const noexcept { return spills_.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64_t spilledBytes() const noexcept { return spilled_bytes_.load(std::memory_order_relaxed); }
+
+private:
+    /// Ressource amont : le tas, avec comptage des débordements
+    class SpillResource final : public std::pmr::memory_resource {
+    public:
+        explicit SpillResource(FrameArena& owner) noexcept : owner_(owner) {}
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            owner_.spills_.fetch_add(1, std::memory_order_relaxed);
+            owner_.spilled_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+        FrameArena& owner_;
+    };
+
+    size_t capacity_;
+    std::unique_ptr<std::byte[]> buffer_;
+    SpillResource upstream_;
+    std::pmr::monotonic_buffer_resource resource_;
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> spills_{0};
+    std::atomic<uint64_t> spilled_bytes_{0};
+};
+
+} // namespace mcee
@@ -0,0 +1,197 @@
+/**
+ * @file GoalKernels.hpp
+ * @brief Noyaux de taille fixe pour la dynamique des objectifs ADDO
+ *
+ * Les termes de G(t) sont des produits vecteur / matrice de dimension
+ * NUM_GOAL_VARIABLES connue à la compilation : les boucles sont déroulées
+ * et les sommes réparties sur plusieurs accumulateurs pour que le
+ * compilateur les vectorise sans -ffast-math.
+ *
+ * Les matrices d'interactions (16×16, symétriques, une quarantaine de
+ * coefficients non nuls) et le mapping émotions → variables (24×16) sont
+ * compilés une fois en listes creuses partagées par tous les moteurs
+ * (GoalKernels::defaults()) : une session ne porte plus que ses vecteurs
+ * P, w, L et l'état de son générateur.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ADDOConfig.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+namespace mcee {
+
+namespace goal {
+
+using Vector = std::array<double, NUM_GOAL_VARIABLES>;
+using Matrix = std::array<Vector, NUM_GOAL_VARIABLES>;
+
+static_assert(NUM_GOAL_VARIABLES % 4 == 0, "les noyaux supposent des blocs de 4 variables");
+
+/// Σ a_i·b_i·c_i (quatre accumulateurs indépendants)
+[[nodiscard]] inline double dot3(const Vector& a, const Vector& b, const Vector& c) noexcept {
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < NUM_GOAL_VARIABLES; i += 4) {
+        for (size_t k = 0; k < 4; ++k) {
+            acc[k] += a[i + k] * b[i + k] * c[i + k];
+        }
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/// Σ v_i
+[[nodiscard]] inline double sum(const Vector& v) noexcept {
+    double acc[4] = {0.0, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < NUM_GOAL_VARIABLES; i += 4) {
+        for (size_t k = 0; k < 4; ++k) acc[k] += v[i + k];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/**
+ * @brief Triangle supérieur creux d'une matrice symétrique (format COO)
+ *
+ * Seuls les coefficients c_ij > 0, i < j, sont retenus : c'est exactement
+ * ce que sommaient les doubles boucles d'origine.
+ */
+struct SparsePairs {
+    static constexpr size_t CAPACITY = NUM_GOAL_VARIABLES * (NUM_GOAL_VARIABLES - 1) / 2;
+
+    std::array<uint8_t, CAPACITY> row{};
+    std::array<uint8_t, CAPACITY> col{};
+    std::array<double, CAPACITY> coeff{};
+    size_t size = 0;
+
+    [[nodiscard]] static SparsePairs fromUpperTriangle(const Matrix& m) noexcept;
+
+    /// Σ c_ij·P_i·P_j sur les paires retenues
+    [[nodiscard]] double quadratic(const Vector& P) const noexcept {
+        double acc[2] = {0.0, 0.0};
+        size_t n = 0;
+        for (; n + 1 < size; n += 2) {
+            acc[0] += coeff[n] * P[row[n]] * P[col[n]];
+            acc[1] += coeff[n + 1] * P[row[n + 1]] * P[col[n + 1]];
+        }
+        if (n < size) acc[0] += coeff[n] * P[row[n]] * P[col[n]];
+        return acc[0] + acc[1];
+    }
+};
+
+/**
+ * @brief Mapping émotions → variables en lignes creuses (format CSR)
+ *
+ * Les poids |w| < MIN_WEIGHT sont écartés à la compilation ; l'ordre
+ * (émotion puis variable) est conservé car chaque contribution est bornée
+ * à [0, 1] avant la suivante.
+ */
+struct SparseEmotionRows {
+    static constexpr size_t NUM_EMOTIONS = EmotionVariableMapping::NUM_EMOTIONS;
+    static constexpr size_t CAPACITY = NUM_EMOTIONS * NUM_GOAL_VARIABLES;
+    static constexpr double MIN_WEIGHT = 0.01;
+    static constexpr double MIN_INTENSITY = 0.05;
+    static constexpr double DAMPING = 0.3;
+
+    std::array<uint16_t, NUM_EMOTIONS + 1> row_begin{};
+    std::array<uint8_t, CAPACITY> var{};
+    std::array<double, CAPACITY> weight{};   // Déjà multiplié par DAMPING
+
+    [[nodiscard]] static SparseEmotionRows fromMapping(const EmotionVariableMapping& mapping) noexcept;
+
+    /// P_v ← clamp(P_v + DAMPING·e·w_ev, 0, 1) pour chaque émotion active e
+    template <typename Emotions>
+    void apply(const Emotions& emotions, Vector& P) const noexcept {
+        for (size_t e = 0; e < NUM_EMOTIONS; ++e) {
+            const double intensity = emotions[e];
+            if (intensity < MIN_INTENSITY) continue;
+            for (size_t n = row_begin[e]; n < row_begin[e + 1]; ++n) {
+                double& p = P[var[n]];
+                p = std::clamp(p + intensity * weight[n], 0.0, 1.0);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Tables creuses partagées par tous les ADDOEngine
+ */
+struct GoalKernels {
+    InteractionMatrix interactions;
+    EmotionVariableMapping emotion_mapping;
+    SparsePairs positive;
+    SparsePairs negative;
+    SparseEmotionRows emotions;
+
+    GoalKernels();
+
+    /// Instance construite au premier appel depuis les matrices par défaut
+    [[nodiscard]] static const GoalKernels& defaults();
+};
+
+/**
+ * @brief Générateur normal à compteur (SplitMix64 + Box-Muller)
+ *
+ * Le tirage n est une fonction pure de (graine, n) : pas d'état à
+ * 5 Ko comme mt19937, avance arbitraire en O(1) et reproductibilité
+ * d'une session à graine fixée. Chaque paire de tirages partage une
+ * transformation de Box-Muller (cos puis sin).
+ */
+class CounterRng {
+public:
+    explicit CounterRng(uint64_t seed = 0) noexcept : seed_(seed) {}
+
+    [[nodiscard]] uint64_t seed() const noexcept { return seed_; }
+    [[nodiscard]] uint64_t counter() const noexcept { return counter_; }
+
+    /// Positionne le compteur (le prochain tirage sera le n-ième)
+    void seek(uint64_t n) noexcept {
+        counter_ = n;
+        has_spare_ = false;
+    }
+
+    /// Entier pseudo-aléatoire associé au compteur n
+    [[nodiscard]] static uint64_t hash(uint64_t seed, uint64_t n) noexcept {
+        uint64_t z = seed + (n + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /// Tirage N(mean, stddev)
+    [[nodiscard]] double normal(double mean, double stddev) noexcept {
+        const uint64_t n = counter_++;
+        if (has_spare_ && (n & 1u)) {
+            has_spare_ = false;
+            return mean + stddev * spare_;
+        }
+        const uint64_t block = n & ~uint64_t{1};
+        // u1 ∈ ]0, 1] (log fini), u2 ∈ [0, 1[
+        const double u1 = (static_cast<double>(hash(seed_, block) >> 11) + 1.0) * 0x1.0p-53;
+        const double u2 = static_cast<double>(hash(seed_, block + 1) >> 11) * 0x1.0p-53;
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        const double angle = 2.0 * std::numbers::pi * u2;
+        if (n & 1u) {
+            return mean + stddev * radius * std::sin(angle);
+        }
+        spare_ = radius * std::sin(angle);
+        has_spare_ = true;
+        return mean + stddev * radius * std::cos(angle);
+    }
+
+private:
+    uint64_t seed_;
+    uint64_t counter_ = 0;
+    double spare_ = 0.0;
+    bool has_spare_ = false;
+};
+
+} // namespace goal
+
+} // namespace mcee
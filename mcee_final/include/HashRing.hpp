@@ -0,0 +1,105 @@
+/**
+ * @file HashRing.hpp
+ * @brief Anneau de hachage cohérent (nœuds virtuels) pour répartir les sessions
+ *
+ * Chaque membre occupe weight × virtual_nodes points de l'anneau ; une clé
+ * appartient au premier point rencontré dans le sens horaire. L'arrivée ou
+ * le départ d'un membre ne déplace que les clés des arcs qu'il gagne ou
+ * perd (≈ 1/N des sessions), les autres restent sur leur nœud.
+ *
+ * Immuable une fois construit : les lecteurs partagent un
+ * shared_ptr<const HashRing> et un changement de membres produit un
+ * nouvel anneau.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+class HashRing {
+public:
+    struct Member {
+        std::string id;
+        unsigned weight = 1;
+    };
+
+    HashRing() = default;
+
+    /**
+     * @param members Membres (identifiants uniques ; l'ordre est indifférent)
+     * @param virtual_nodes Points par unité de poids
+     */
+    HashRing(std::vector<Member> members, unsigned virtual_nodes) {
+        std::sort(members.begin(), members.end(),
+                  [](const Member& a, const Member& b) { return a.id < b.id; });
+        members_ = std::move(members);
+
+        for (size_t m = 0; m < members_.size(); ++m) {
+            const unsigned points = std::max(1u, members_[m].weight) * std::max(1u, virtual_nodes);
+            for (unsigned v = 0; v < points; ++v) {
+                points_.push_back({hash(members_[m].id + '#' + std::to_string(v)), m});
+            }
+        }
+        std::sort(points_.begin(), points_.end());
+    }
+
+    [[nodiscard]] bool empty() const { return members_.empty(); }
+    [[nodiscard]] const std::vector<Member>& members() const { return members_; }
+
+    /**
+     * @brief Membre propriétaire de la clé (vide si l'anneau est vide)
+     */
+    [[nodiscard]] const std::string& owner(std::string_view key) const {
+        static const std::string none;
+        if (points_.empty()) return none;
+
+        const std::pair<uint64_t, size_t> probe{hash(key), 0};
+        auto it = std::lower_bound(points_.begin(), points_.end(), probe);
+        if (it == points_.end()) it = points_.begin();  // Retour au début de l'anneau
+        return members_[it->second].id;
+    }
+
+    /**
+     * @brief Vrai si l'anneau serait identique avec ces membres (ordre indifférent)
+     */
+    [[nodiscard]] bool sameMembers(std::vector<Member> members) const {
+        if (members.size() != members_.size()) return false;
+        std::sort(members.begin(), members.end(),
+                  [](const Member& a, const Member& b) { return a.id < b.id; });
+        for (size_t i = 0; i < members_.size(); ++i) {
+            if (members_[i].id != members[i].id || members_[i].weight != members[i].weight) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// FNV-1a 64 bits, suivi d'un brassage final (les clés proches divergent)
+    static uint64_t hash(std::string_view key) {
+        uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : key) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+
+private:
+    std::vector<Member> members_;
+    std::vector<std::pair<uint64_t, size_t>> points_;  // (position, index du membre), triés
+};
+
+} // namespace mcee
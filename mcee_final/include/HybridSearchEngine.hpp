@@ -10,7 +10,8 @@
  * Pipeline :
  * 1. Parse les tokens (lemmes, POS, entités)
  * 2. Recherche lexicale dans Neo4j (mots → souvenirs)
- * 3. Recherche sémantique (embedding → souvenirs similaires)
+ * 3. Recherche sémantique (embedding → souvenirs similaires) : index local
+ *    des souvenirs les plus souvent rendus, Neo4j pour le reste
  * 4. Fusion pondérée selon Ft et Ct
  * 5. Construction du contexte émotionnel pour LLMClient
  */
@@ -22,12 +23,19 @@
 #include "Neo4jClient.hpp"
 #include "ConscienceEngine.hpp"
 #include "LLMClient.hpp"
+#include "ShardedLRUCache.hpp"
+#include "SemanticIndex.hpp"
+#include "MemoryVectorIndex.hpp"
+#include "Executor.hpp"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <optional>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 
 namespace mcee {
 
@@ -146,6 +154,7 @@ struct SearchResponse {
     double overall_confidence = 0.0;
     SearchMode mode_used = SearchMode::BALANCED;
     double search_time_ms = 0.0;
+    bool degraded = false;              // Une branche a dépassé son délai
 
     // État de conscience utilisé
     double Ft = 0.0;
@@ -163,6 +172,7 @@ struct SearchResponse {
         j["overall_confidence"] = overall_confidence;
         j["mode_used"] = static_cast<int>(mode_used);
         j["search_time_ms"] = search_time_ms;
+        j["degraded"] = degraded;
         j["Ft"] = Ft;
         j["Ct"] = Ct;
         return j;
@@ -201,6 +211,28 @@ struct HybridSearchConfig {
     // Cache
     bool enable_cache = true;
     int cache_ttl_seconds = 300;
+    size_t cache_max_bytes = 8 * 1024 * 1024;   // Budget mémoire du cache de réponses
+    size_t cache_shards = 16;
+
+    // Embeddings : forme stockée (cache, index local) et envoyée à Neo4j
+    EmbeddingQuantization embedding_quantization = EmbeddingQuantization::INT8;
+
+    // Cache d'embeddings par question normalisée et par ensemble de lemmes :
+    // une question sans embedding reprend celui d'une question déjà vue
+    bool enable_embedding_cache = true;
+    int embedding_cache_ttl_seconds = 3600;
+    size_t embedding_cache_max_bytes = 2 * 1024 * 1024;
+
+    // Index sémantique local : souvenirs rendus au moins promote_after fois
+    // par Neo4j ; min_results résultats locaux dispensent de l'aller-retour
+    size_t semantic_index_capacity = 1024;      // 0 = désactivé
+    uint32_t semantic_index_promote_after = 2;
+    size_t semantic_local_min_results = 3;
+
+    // Exécution parallèle des branches lexicale / sémantique
+    bool parallel_branches = true;
+    int lexical_deadline_ms = 1500;     // Au-delà : résultats sémantiques seuls
+    int semantic_deadline_ms = 800;     // Au-delà : résultats lexicaux seuls
 
     // Debug
     bool verbose = false;
@@ -229,9 +261,9 @@ public:
     );
 
     /**
-     * @brief Destructeur
+     * @brief Destructeur (attend les branches abandonnées encore en vol)
      */
-    ~HybridSearchEngine() = default;
+    ~HybridSearchEngine();
 
     // Non-copyable
     HybridSearchEngine(const HybridSearchEngine&) = delete;
@@ -309,9 +341,35 @@ public:
     [[nodiscard]] const HybridSearchConfig& getConfig() const { return config_; }
 
     /**
-     * @brief Met à jour la configuration
+     * @brief Met à jour la configuration (un changement de quantification
+     *        vide l'index sémantique local)
+     */
+    void setConfig(const HybridSearchConfig& config);
+
+    /**
+     * @brief Compteurs du cache (hits, misses, évictions, requêtes coalescées)
+     */
+    [[nodiscard]] CacheStats getCacheStats() const;
+
+    /**
+     * @brief Compteurs du cache d'embeddings (consultations sans embedding fourni)
+     */
+    [[nodiscard]] CacheStats getEmbeddingCacheStats() const { return embedding_cache_.stats(); }
+
+    /**
+     * @brief Recherches sémantiques servies en local ou par Neo4j
+     */
+    [[nodiscard]] MemoryIndexStats getSemanticIndexStats() const;
+
+    /**
+     * @brief Nombre de recherches dégradées (branche hors délai)
      */
-    void setConfig(const HybridSearchConfig& config) { config_ = config; }
+    [[nodiscard]] uint64_t getDegradedSearchCount() const { return degraded_searches_.load(); }
+
+    /**
+     * @brief Vide le cache de réponses
+     */
+    void clearCache() { cache_.clear(); }
 
     /**
      * @brief Retourne le client Neo4j
@@ -328,9 +386,46 @@ private:
     std::shared_ptr<ConscienceEngine> conscience_;
     HybridSearchConfig config_;
 
-    // Cache simple (clé: hash des lemmas)
-    mutable std::unordered_map<std::string, std::pair<SearchResponse, std::chrono::steady_clock::time_point>> cache_;
-    mutable std::mutex cache_mutex_;
+    // Cache LRU partitionné (clé : empreinte des lemmes + embedding)
+    ShardedLRUCache<SearchResponse> cache_;
+
+    // Embeddings quantifiés par question normalisée / ensemble de lemmes
+    ShardedLRUCache<QuantizedEmbedding> embedding_cache_;
+
+    /**
+     * @brief Souvenir rendu par la recherche vectorielle Neo4j
+     */
+    struct HotMemory {
+        SearchResult result;        // Dernières métadonnées reçues (scores nuls)
+        uint32_t returns = 0;       // Retours Neo4j (divisés par deux au vieillissement)
+        bool requested = false;     // Embedding demandé à Neo4j
+    };
+
+    // Index local et suivi des souvenirs fréquents (verrou lecteurs/écrivain :
+    // les recherches locales se font en parallèle)
+    mutable std::shared_mutex semantic_mutex_;
+    SemanticIndex semantic_index_;
+    std::unordered_map<std::string, HotMemory> hot_memories_;
+    std::vector<std::string> promotion_queue_;
+    bool promoting_ = false;
+
+    // Récupération des embeddings à indexer (une tâche BACKGROUND à la fois)
+    TaskFuture<void> promotion_;
+    std::mutex promotion_mutex_;
+
+    std::atomic<uint64_t> semantic_queries_{0};
+    std::atomic<uint64_t> semantic_local_hits_{0};
+    std::atomic<uint64_t> semantic_fallbacks_{0};
+
+    // Une seule requête Neo4j en vol par clé
+    SingleFlight<std::vector<SearchResult>> lexical_flight_;
+    SingleFlight<std::vector<SearchResult>> semantic_flight_;
+
+    // Branches hors délai : conservées jusqu'à leur fin (elles utilisent
+    // this ; le destructeur les attend)
+    std::vector<TaskFuture<std::vector<SearchResult>>> stragglers_;
+    std::mutex stragglers_mutex_;
+    std::atomic<uint64_t> degraded_searches_{0};
 
     // ═══════════════════════════════════════════════════════════════════════
     // MÉTHODES PRIVÉES
@@ -342,10 +437,49 @@ private:
     std::vector<SearchResult> searchLexical(const std::vector<std::string>& lemmas);
 
     /**
-     * @brief Recherche sémantique par embedding
+     * @brief Recherche sémantique par embedding (Neo4j)
      */
     std::vector<SearchResult> searchSemantic(const std::vector<double>& embedding);
 
+    /**
+     * @brief Recherche sémantique dans l'index local
+     * @return Résultats, ou std::nullopt s'ils sont trop peu nombreux
+     */
+    std::optional<std::vector<SearchResult>> searchSemanticLocal(const std::vector<double>& embedding);
+
+    /**
+     * @brief Compte les retours Neo4j et planifie l'indexation des plus fréquents
+     */
+    void recordSemanticResults(const std::vector<SearchResult>& results);
+
+    /**
+     * @brief Tâche BACKGROUND : récupère et indexe les embeddings en attente
+     */
+    void promoteHotMemories();
+
+    /**
+     * @brief Embedding de la requête : celui fourni (mis en cache), sinon
+     *        celui d'une question ou d'un ensemble de lemmes déjà vus
+     */
+    std::vector<double> resolveEmbedding(const std::string& question,
+                                         const std::vector<std::string>& lemmas,
+                                         uint64_t lemmas_key,
+                                         const std::vector<double>& embedding);
+
+    /**
+     * @brief Attend une branche jusqu'à l'échéance
+     * @return Résultats, ou std::nullopt si l'échéance est dépassée
+     */
+    std::optional<std::vector<SearchResult>> awaitBranch(
+        TaskFuture<std::vector<SearchResult>>& branch,
+        std::chrono::steady_clock::time_point deadline,
+        const char* name);
+
+    /**
+     * @brief Retire les branches abandonnées terminées
+     */
+    void reapStragglers();
+
     /**
      * @brief Fusionne les résultats lexicaux et sémantiques
      */
@@ -385,14 +519,19 @@ private:
     ) const;
 
     /**
-     * @brief Génère une clé de cache
+     * @brief Empreinte des lemmes (indépendante de l'ordre)
+     */
+    uint64_t hashLemmas(const std::vector<std::string>& lemmas) const;
+
+    /**
+     * @brief Empreinte d'un embedding
      */
-    std::string generateCacheKey(const std::vector<std::string>& lemmas) const;
+    uint64_t hashEmbedding(const std::vector<double>& embedding) const;
 
     /**
-     * @brief Vérifie si une entrée de cache est valide
+     * @brief Taille mémoire estimée d'une réponse (budget du cache)
      */
-    bool isCacheValid(const std::string& key) const;
+    static size_t estimateBytes(const SearchResponse& response);
 
     /**
      * @brief Log verbose
@@ -0,0 +1,141 @@
+/**
+ * @file JsonScanner.hpp
+ * @brief Lecture JSON à la demande, sans DOM, sur le tampon du message
+ *
+ * Les consommateurs RabbitMQ lisent leurs champs directement dans le corps
+ * du message : pas d'arbre nlohmann, pas de copie des clés ni des chaînes
+ * sans échappement (les vues pointent dans le tampon d'entrée). Une chaîne
+ * échappée est décodée dans un tampon fourni par l'appelant.
+ *
+ * Le parcours est strictement séquentiel : chaque valeur est lue ou sautée
+ * avant de passer à la suivante. Un champ dont l'ordre importe peut être
+ * capturé (captureValue) et relu plus tard par un second JsonScanner.
+ *
+ * nlohmann::json reste utilisé pour les fichiers de configuration.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace mcee {
+
+/**
+ * @brief Document mal formé ou valeur d'un type inattendu
+ */
+class JsonScanError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class JsonType {
+    OBJECT, ARRAY, STRING, NUMBER, BOOLEAN, NUL, END
+};
+
+/**
+ * @class JsonScanner
+ * @brief Curseur sur un document JSON (vue non possédée)
+ *
+ * @code
+ * JsonScanner scan(body);
+ * scan.beginObject();
+ * std::string_view key;
+ * while (scan.nextField(key)) {
+ *     if (key == "text") text = scan.readString(scratch);
+ *     else scan.skipValue();
+ * }
+ * scan.expectEnd();
+ * @endcode
+ */
+class JsonScanner {
+public:
+    explicit JsonScanner(std::string_view text) noexcept : text_(text) {}
+
+    /**
+     * @brief Type de la prochaine valeur (END en fin de document)
+     */
+    [[nodiscard]] JsonType peek();
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // CONTENEURS
+    // ═══════════════════════════════════════════════════════════════════════
+
+    void beginObject();
+
+    /**
+     * @brief Passe au champ suivant de l'objet courant
+     * @param key Clé du champ, valide jusqu'au prochain nextField
+     * @return false à la fin de l'objet ('}' consommé)
+     */
+    bool nextField(std::string_view& key);
+
+    void beginArray();
+
+    /**
+     * @brief Passe à l'élément suivant du tableau courant
+     * @return false à la fin du tableau (']' consommé)
+     */
+    bool nextElement();
+
+    // ═══════════════════════════════════════════════════════════════════════
+    // VALEURS
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Lit une chaîne
+     * @param scratch Reçoit la chaîne décodée si elle contient des échappements
+     * @return Vue dans le document, ou dans scratch
+     */
+    std::string_view readString(std::string& scratch);
+
+    double readNumber();
+    bool readBool();
+
+    /**
+     * @brief Consomme un null ; false (rien consommé) si la valeur n'en est pas un
+     */
+    bool readNull();
+
+    /**
+     * @brief Saute la prochaine valeur, conteneurs compris
+     */
+    void skipValue();
+
+    /**
+     * @brief Saute la prochaine valeur et rend son texte brut
+     */
+    std::string_view captureValue();
+
+    /**
+     * @brief Vérifie qu'il ne reste que des espaces
+     */
+    void expectEnd();
+
+private:
+    static constexpr size_t MAX_DEPTH = 256;   // Au-delà : document rejeté
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    size_t depth_ = 0;
+    bool first_in_container_ = false;
+    std::string key_scratch_;
+
+    void skipSpaces() noexcept;
+    char peekChar();
+    void expect(char c);
+    void enter();
+    [[noreturn]] void fail(std::string_view what) const;
+
+    /// Position juste après la chaîne commençant à pos_ ; escaped si '\'
+    size_t scanString(bool& escaped) const;
+    void decodeString(size_t begin, size_t end, std::string& out) const;
+    void skipLiteral(std::string_view literal);
+};
+
+} // namespace mcee
@@ -0,0 +1,141 @@
+/**
+ * @file JsonWriter.hpp
+ * @brief Écriture JSON séquentielle, sans DOM, dans une chaîne fournie
+ *
+ * Pendant de JsonScanner pour la publication de l'état : les champs sont
+ * ajoutés directement au texte de sortie, qui peut vivre dans l'arène de
+ * la trame (std::pmr::string). Aucune vérification de structure : chaque
+ * begin doit être refermé par l'appelant. Les réels suivent la forme la
+ * plus courte qui se relit à l'identique ; NaN et infinis deviennent null
+ * (comme nlohmann::json::dump).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace mcee {
+
+/**
+ * @class JsonWriter
+ * @brief Curseur d'écriture (jusqu'à 64 niveaux d'imbrication)
+ *
+ * @code
+ * std::pmr::string body(arena.allocator<char>());
+ * JsonWriter out(body);
+ * out.beginObject();
+ * out.field("E_global", state.E_global);
+ * out.key("pattern"); out.beginObject(); out.field("id", id); out.endObject();
+ * out.endObject();
+ * @endcode
+ */
+template <typename String>
+class JsonWriter {
+public:
+    explicit JsonWriter(String& out) noexcept : out_(out) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    void key(std::string_view name) {
+        separator();
+        writeString(name);
+        out_.push_back(':');
+        after_key_ = true;
+    }
+
+    void value(std::string_view s) { separator(); writeString(s); }
+    void value(const char* s) { value(std::string_view(s)); }
+    void value(bool b) { separator(); out_.append(b ? "true" : "false"); }
+
+    template <typename T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    void value(T number) {
+        separator();
+        if constexpr (std::is_floating_point_v<T>) {
+            if (!std::isfinite(number)) {
+                out_.append("null");
+                return;
+            }
+        }
+        char buf[32];
+        auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), number);
+        out_.append(buf, static_cast<size_t>(end - buf));
+    }
+
+    template <typename T>
+    void field(std::string_view name, const T& v) {
+        key(name);
+        value(v);
+    }
+
+private:
+    void open(char c) {
+        separator();
+        out_.push_back(c);
+        ++depth_;
+        first_ |= (uint64_t{1} << depth_);
+    }
+
+    void close(char c) {
+        first_ &= ~(uint64_t{1} << depth_);
+        --depth_;
+        out_.push_back(c);
+    }
+
+    /// Virgule avant tout élément sauf le premier du niveau (et la valeur d'une clé)
+    void separator() {
+        if (after_key_) {
+            after_key_ = false;
+            return;
+        }
+        const uint64_t bit = uint64_t{1} << depth_;
+        if (first_ & bit) {
+            first_ &= ~bit;
+        } else if (depth_ > 0) {
+            out_.push_back(',');
+        }
+    }
+
+    void writeString(std::string_view s) {
+        out_.push_back('"');
+        size_t run = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            const auto c = static_cast<unsigned char>(s[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            out_.append(s.data() + run, i - run);
+            run = i + 1;
+            switch (c) {
+                case '"':  out_.append("\\\""); break;
+                case '\\': out_.append("\\\\"); break;
+                case '\n': out_.append("\\n"); break;
+                case '\r': out_.append("\\r"); break;
+                case '\t': out_.append("\\t"); break;
+                default: {
+                    char esc[7];
+                    std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+                    out_.append(esc, 6);
+                }
+            }
+        }
+        out_.append(s.data() + run, s.size() - run);
+        out_.push_back('"');
+    }
+
+    String& out_;
+    unsigned depth_ = 0;
+    uint64_t first_ = 0;
+    bool after_key_ = false;
+};
+
+} // namespace mcee
@@ -10,6 +10,14 @@
  * Modes de fonctionnement :
  * - DIRECT_HTTP : Appel HTTP direct via libcurl
  * - RABBITMQ : Via service Python intermédiaire
+ *
+ * Transport : handles CURL persistants (keep-alive, session TLS réutilisée,
+ * HTTP/2 si disponible), voie bornée de l'Executor pour les appels asynchrones
+ * et mode streaming (SSE) qui livre les tokens au fil de l'eau.
+ *
+ * Le prompt utilisateur vient d'un gabarit compilé une fois (PromptTemplate)
+ * et rendu dans des tampons réutilisés ; les réponses sont mises en cache
+ * (LLMResponseCache) par question normalisée, pattern et contexte.
  */
 
 #ifndef MCEE_LLM_CLIENT_HPP
@@ -17,6 +25,10 @@
 
 #include "Types.hpp"
 #include "ConscienceConfig.hpp"
+#include "Metrics.hpp"
+#include "PromptTemplate.hpp"
+#include "Executor.hpp"
+#include "ShardedLRUCache.hpp"
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -26,12 +38,17 @@
 #include <optional>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 #include <atomic>
 
 namespace mcee {
 
 using json = nlohmann::json;
 
+class LLMResponseCache;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // ENUMS ET CONSTANTES
 // ═══════════════════════════════════════════════════════════════════════════
@@ -181,6 +198,11 @@ struct LLMRequest {
     // Options de génération
     std::optional<double> temperature;
     std::optional<int> max_tokens;
+
+    // Cache de réponses
+    std::string cache_scope;                // Pattern dominant (partie de la clé)
+    std::vector<double> question_embedding; // Embedding de la question (hit approché)
+    bool bypass_cache = false;              // Force l'appel au fournisseur
 };
 
 /**
@@ -193,7 +215,9 @@ struct LLMResponse {
     int tokens_completion = 0;      // Tokens de la réponse
     int tokens_total = 0;           // Total tokens
     double generation_time_ms = 0;  // Temps de génération
+    double first_token_ms = 0;      // Délai avant le premier token (streaming)
     bool success = false;
+    bool from_cache = false;        // Servie par le cache, sans appel réseau
     std::string error_message;
 
     json toJson() const {
@@ -204,7 +228,9 @@ struct LLMResponse {
             {"tokens_completion", tokens_completion},
             {"tokens_total", tokens_total},
             {"generation_time_ms", generation_time_ms},
+            {"first_token_ms", first_token_ms},
             {"success", success},
+            {"from_cache", from_cache},
             {"error_message", error_message}
         };
     }
@@ -215,6 +241,11 @@ struct LLMResponse {
  */
 using LLMResponseCallback = std::function<void(const LLMResponse&)>;
 
+/**
+ * @brief Callback de streaming : reçoit chaque fragment de texte généré
+ */
+using LLMTokenCallback = std::function<void(const std::string& delta)>;
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONFIGURATION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -244,6 +275,21 @@ struct LLMClientConfig {
     int circuit_breaker_threshold = 5;  // Échecs consécutifs avant ouverture
     int circuit_breaker_timeout_s = 60; // Temps avant tentative de fermeture
 
+    // Transport HTTP (mode DIRECT_HTTP)
+    size_t http_pool_size = 4;          // Handles CURL persistants conservés
+    bool enable_http2 = true;           // HTTP/2 (multiplexage) si le serveur le supporte
+    int connect_timeout_ms = 5000;
+
+    // Exécution asynchrone
+    size_t worker_threads = 4;          // Appels asynchrones concurrents maximum (workers de l'Executor)
+    size_t max_pending_requests = 64;   // Au-delà, les requêtes asynchrones sont rejetées
+
+    // Cache de réponses (question normalisée + pattern + contexte)
+    bool enable_response_cache = true;
+    int response_cache_ttl_seconds = 600;
+    size_t response_cache_max_bytes = 4 * 1024 * 1024;
+    double response_cache_similarity = 0.0;   // Cosinus min entre embeddings (0 = clé exacte seule)
+
     // RabbitMQ (si mode RABBITMQ)
     std::string rabbitmq_host = "localhost";
     int rabbitmq_port = 5672;
@@ -265,6 +311,11 @@ Règles :
 - Sois concis mais chaleureux
 - Ne mentionne pas explicitement que tu as "détecté" des émotions)";
 
+    // Gabarit du prompt utilisateur (vide = gabarit par défaut). Emplacements :
+    // question, ft, sentiment, ct, dominant, dominant_pct, other_emotions,
+    // keywords, memories ; {{#nom}}...{{/nom}} n'est rendu que si nom est non vide
+    std::string user_prompt_template;
+
     // Debug
     bool verbose = false;
 
@@ -367,12 +418,39 @@ public:
     LLMResponse generate(const LLMRequest& request);
 
     /**
-     * @brief Génération asynchrone
+     * @brief Génère une réponse en streaming (SSE)
+     * @param request Requête complète
+     * @param on_token Appelé pour chaque fragment reçu (thread appelant)
+     * @return Réponse complète une fois le flux terminé
+     *
+     * En mode RABBITMQ, la réponse complète est livrée en un seul fragment.
+     */
+    LLMResponse generateStream(const LLMRequest& request, LLMTokenCallback on_token);
+
+    /**
+     * @brief Génération asynchrone (voie bornée sur l'Executor)
      * @param request Requête
-     * @param callback Callback appelé à la réception
+     * @param callback Callback appelé à la réception (ou au rejet si file pleine)
      */
     void generateAsync(const LLMRequest& request, LLMResponseCallback callback);
 
+    /**
+     * @brief Génération asynchrone en streaming
+     * @param request Requête
+     * @param on_token Fragments (thread worker)
+     * @param callback Réponse finale
+     */
+    void generateStreamAsync(const LLMRequest& request,
+                             LLMTokenCallback on_token,
+                             LLMResponseCallback callback);
+
+    /**
+     * @brief Exécute une tâche sur la voie du client (classe PIPELINE,
+     *        au plus worker_threads à la fois)
+     * @return false si la file est pleine ou le client arrêté
+     */
+    bool post(std::function<void()> task);
+
     /**
      * @brief Raccourci : reformule une question avec contexte
      * @param question Question utilisateur
@@ -393,6 +471,13 @@ public:
      */
     std::string buildUserPrompt(const std::string& question, const LLMContext& context) const;
 
+    /**
+     * @brief Rend le prompt utilisateur dans un tampon réutilisé
+     * @param out Vidé puis rempli (capacité conservée)
+     */
+    void renderUserPrompt(const std::string& question, const LLMContext& context,
+                          std::string& out) const;
+
     /**
      * @brief Construit la liste de messages pour l'API
      * @param question Question
@@ -401,6 +486,13 @@ public:
      */
     std::vector<ChatMessage> buildMessages(const std::string& question, const LLMContext& context) const;
 
+    /**
+     * @brief Remplit out (système, historique, utilisateur) en réutilisant
+     *        ses messages et leurs chaînes
+     */
+    void buildMessagesInto(const std::string& question, const LLMContext& context,
+                           std::vector<ChatMessage>& out) const;
+
     // ═══════════════════════════════════════════════════════════════════════
     // HISTORIQUE DE CONVERSATION
     // ═══════════════════════════════════════════════════════════════════════
@@ -444,11 +536,41 @@ public:
      */
     [[nodiscard]] uint64_t getTotalTokens() const { return total_tokens_.load(); }
 
+    /**
+     * @brief Retourne le nombre de requêtes asynchrones rejetées (file pleine)
+     */
+    [[nodiscard]] uint64_t getRejectedRequests() const { return rejected_requests_.load(); }
+
+    /**
+     * @brief Retourne le nombre de tâches en attente d'un worker
+     */
+    [[nodiscard]] size_t getPendingRequests() const;
+
     /**
      * @brief Vérifie si le circuit breaker est ouvert
      */
     [[nodiscard]] bool isCircuitOpen() const { return circuit_open_.load(); }
 
+    /**
+     * @brief Consultations du cache de réponses (hits exacts et approchés)
+     */
+    [[nodiscard]] CacheStats getResponseCacheStats() const;
+
+    /**
+     * @brief Hits servis par une question voisine (similarité d'embedding)
+     */
+    [[nodiscard]] uint64_t getResponseCacheNearHits() const;
+
+    /**
+     * @brief Vide le cache de réponses
+     */
+    void clearResponseCache();
+
+    /**
+     * @brief Latence de chaque tentative d'appel au fournisseur (HTTP ou RabbitMQ)
+     */
+    [[nodiscard]] const LatencyHistogram& getCallLatency() const { return call_latency_; }
+
     /**
      * @brief Retourne la configuration
      */
@@ -463,6 +585,12 @@ private:
     std::atomic<int> consecutive_failures_{0};
     std::chrono::steady_clock::time_point circuit_opened_at_;
 
+    // Gabarit du prompt utilisateur (compilé au constructeur)
+    PromptTemplate user_template_;
+
+    // Réponses déjà générées
+    std::unique_ptr<LLMResponseCache> response_cache_;
+
     // Historique de conversation
     std::vector<ChatMessage> history_;
     size_t history_limit_ = 20;
@@ -473,11 +601,21 @@ private:
     std::string response_queue_;
     std::string consumer_tag_;
     std::atomic<bool> rabbitmq_connected_{false};
+    std::mutex rabbitmq_mutex_;          // Un seul aller-retour à la fois sur le canal
+
+    // Pool de handles CURL persistants (CURL* opaques)
+    std::vector<void*> idle_handles_;
+    std::mutex handles_mutex_;
+
+    // Appels asynchrones : voie de l'Executor partagé, bornée
+    TaskLane lane_{TaskClass::PIPELINE};
 
     // Métriques
     std::atomic<uint64_t> total_requests_{0};
     std::atomic<uint64_t> successful_requests_{0};
     std::atomic<uint64_t> total_tokens_{0};
+    std::atomic<uint64_t> rejected_requests_{0};
+    LatencyHistogram call_latency_;
 
     // ═══════════════════════════════════════════════════════════════════════
     // MÉTHODES PRIVÉES
@@ -488,11 +626,37 @@ private:
      */
     bool initRabbitMQ();
 
+    /**
+     * @brief Génération commune (retry, circuit breaker, historique)
+     * @param on_token Vide pour une réponse bufferisée
+     */
+    LLMResponse generateImpl(const LLMRequest& request, const LLMTokenCallback& on_token);
+
     /**
      * @brief Appel HTTP direct à l'API
+     * @param on_token Si non vide, requête en streaming SSE
      */
     LLMResponse callDirectHTTP(const std::vector<ChatMessage>& messages,
-                               double temperature, int max_tokens);
+                               double temperature, int max_tokens,
+                               const LLMTokenCallback& on_token = {});
+
+    /**
+     * @brief Construit le corps JSON de la requête
+     */
+    json buildRequestBody(const std::vector<ChatMessage>& messages,
+                          double temperature, int max_tokens, bool stream) const;
+
+    /**
+     * @brief Emprunte / rend un handle CURL persistant
+     */
+    void* acquireHandle();
+    void releaseHandle(void* handle);
+    void releaseAllHandles();
+
+    /**
+     * @brief Ajoute une question et sa réponse à l'historique (borné)
+     */
+    void recordExchange(const std::string& question, const std::string& answer);
 
     /**
      * @brief Appel via RabbitMQ
@@ -540,6 +704,7 @@ struct PipelineResult {
     double llm_time_ms = 0;         // Temps LLM
     double total_time_ms = 0;       // Temps total
     bool success = false;
+    bool from_cache = false;        // Réponse servie par le cache du LLMClient
     std::string error;
 };
 
@@ -573,7 +738,18 @@ public:
     );
 
     /**
-     * @brief Traitement asynchrone
+     * @brief Traite une question en streamant la réponse du LLM
+     * @param on_token Fragments de réponse au fil de la génération
+     */
+    PipelineResult processStream(
+        const std::string& question,
+        const std::vector<std::string>& lemmas,
+        const std::vector<double>& embedding,
+        LLMTokenCallback on_token
+    );
+
+    /**
+     * @brief Traitement asynchrone (voie du LLMClient sur l'Executor)
      */
     void processAsync(
         const std::string& question,
@@ -0,0 +1,118 @@
+/**
+ * @file LLMResponseCache.hpp
+ * @brief Cache des réponses LLM par question normalisée et contexte
+ *
+ * La clé exacte combine la question normalisée (casse, espaces, ponctuation
+ * finale) et une portée : pattern dominant, empreinte du contexte de la
+ * recherche hybride et paramètres de génération. Un hit renvoie la réponse
+ * mémorisée sans aucun appel réseau.
+ *
+ * Si un seuil de similarité est configuré, une question reformulée peut
+ * aussi être servie : chaque portée garde les embeddings (normalisés, en
+ * float) de ses dernières questions, comparés au cosinus quand la clé
+ * exacte manque.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ShardedLRUCache.hpp"
+#include "LLMClient.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @class LLMResponseCache
+ * @brief Réponses LLM réutilisables, bornées en octets et expirées par TTL
+ */
+class LLMResponseCache {
+public:
+    static constexpr size_t NEAR_ENTRIES_PER_SCOPE = 32;  // Embeddings comparés par portée
+    static constexpr size_t MAX_NEAR_SCOPES = 1024;       // Au-delà, l'index approché repart de zéro
+
+    /**
+     * @param max_bytes Budget mémoire des réponses
+     */
+    explicit LLMResponseCache(size_t max_bytes = 4 * 1024 * 1024, size_t shards = 8);
+
+    LLMResponseCache(const LLMResponseCache&) = delete;
+    LLMResponseCache& operator=(const LLMResponseCache&) = delete;
+
+    /**
+     * @brief Question normalisée : minuscules ASCII, espaces réduits,
+     *        ponctuation finale retirée
+     */
+    static std::string normalizeQuestion(std::string_view question);
+
+    /**
+     * @brief Empreinte du contexte qui entre dans le prompt
+     *
+     * Sentiment, émotions principales, mots-clés et souvenirs ; Ft et Ct n'y
+     * entrent que par sentiment_label pour que de faibles variations ne
+     * rendent pas chaque question unique.
+     */
+    static uint64_t contextFingerprint(const LLMContext& context);
+
+    /**
+     * @brief Portée d'une requête (tout sauf la question)
+     */
+    static uint64_t scopeKey(const LLMRequest& request, double temperature, int max_tokens);
+
+    /**
+     * @brief Clé exacte d'une question dans une portée
+     */
+    static uint64_t questionKey(uint64_t scope, std::string_view question);
+
+    /**
+     * @brief Recherche une réponse : clé exacte, puis embedding le plus proche
+     *        de la portée si min_similarity > 0
+     * @param near Mis à true si la réponse vient d'une question voisine
+     */
+    std::shared_ptr<const LLMResponse> find(uint64_t key, uint64_t scope,
+                                            const std::vector<double>& embedding,
+                                            std::chrono::steady_clock::duration ttl,
+                                            double min_similarity,
+                                            bool* near = nullptr);
+
+    /**
+     * @brief Mémorise une réponse réussie
+     */
+    void store(uint64_t key, uint64_t scope, const std::vector<double>& embedding,
+               const LLMResponse& response);
+
+    void clear();
+
+    /**
+     * @brief Compteurs du cache ; un hit approché compte comme un hit (et
+     *        non comme le miss exact qui l'a précédé)
+     */
+    [[nodiscard]] CacheStats stats() const;
+    [[nodiscard]] uint64_t nearHits() const { return near_hits_.load(std::memory_order_relaxed); }
+
+private:
+    struct NearEntry {
+        uint64_t key;
+        std::vector<float> unit;    // Embedding normalisé
+    };
+
+    ShardedLRUCache<LLMResponse> entries_;
+
+    std::mutex near_mutex_;
+    std::unordered_map<uint64_t, std::deque<NearEntry>> near_;   // Par portée, plus récent en tête
+    std::atomic<uint64_t> near_hits_{0};
+
+    static bool normalize(const std::vector<double>& embedding, std::vector<float>& out);
+};
+
+} // namespace mcee
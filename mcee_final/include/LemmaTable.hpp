@@ -0,0 +1,129 @@
+/**
+ * @file LemmaTable.hpp
+ * @brief Table d'internement du vocabulaire, partagée par tout le processus
+ *
+ * Chaque chaîne (lemme, forme, catégorie grammaticale) reçoit un identifiant
+ * 32 bits dense et stable, et ses propriétés lexicales sont calculées une
+ * seule fois, à l'internement : négation, intensificateur, mot vide, mot
+ * d'urgence, score émotionnel (valence) par défaut. MCTGraph, SpeechInput et
+ * HybridSearchEngine consultent les mêmes listes ; une occurrence coûte une
+ * recherche de hachage, sans copie ni passage en minuscules.
+ *
+ * La table est partitionnée (un verrou lecteurs/écrivain par shard) et ne
+ * rétrécit jamais : les chaînes restent valides pour toute la durée du
+ * processus (vues rendues par text()). Le vocabulaire d'une langue étant
+ * borné, sa taille l'est aussi.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+using LemmaId = uint32_t;
+inline constexpr LemmaId NO_LEMMA = UINT32_MAX;
+
+/**
+ * @class LemmaTable
+ * @brief Chaîne ↔ identifiant, avec propriétés lexicales précalculées
+ */
+class LemmaTable {
+public:
+    enum Flag : uint16_t {
+        NEGATION    = 1 << 0,
+        INTENSIFIER = 1 << 1,
+        STOP_WORD   = 1 << 2,
+        URGENCY     = 1 << 3,
+        SCORED      = 1 << 4    // Score émotionnel par défaut connu
+    };
+
+    /**
+     * @brief Instance du processus (listes françaises par défaut)
+     */
+    static LemmaTable& instance();
+
+    /**
+     * @brief Identifiant de la chaîne, créé au premier appel
+     *
+     * Les propriétés sont déterminées sur la forme en minuscules (ASCII) ;
+     * la chaîne elle-même est conservée telle quelle.
+     */
+    LemmaId intern(std::string_view text);
+
+    /**
+     * @brief Identifiant d'une chaîne déjà internée, NO_LEMMA sinon
+     */
+    [[nodiscard]] LemmaId find(std::string_view text) const;
+
+    /// Chaîne internée (vide pour NO_LEMMA), valide pour toute la durée du processus
+    [[nodiscard]] std::string_view text(LemmaId id) const {
+        return id == NO_LEMMA ? std::string_view{} : std::string_view(entry(id).text);
+    }
+
+    [[nodiscard]] uint16_t flags(LemmaId id) const { return id == NO_LEMMA ? 0 : entry(id).flags; }
+    [[nodiscard]] bool has(LemmaId id, Flag flag) const { return (flags(id) & flag) != 0; }
+
+    /// Score émotionnel par défaut [-1, 1] (0 si inconnu)
+    [[nodiscard]] double emotionScore(LemmaId id) const { return id == NO_LEMMA ? 0.0 : entry(id).score; }
+
+    [[nodiscard]] size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    /// Taille approximative en mémoire (octets)
+    [[nodiscard]] size_t memoryUsage() const;
+
+    /// Scores émotionnels par défaut (source des dictionnaires de SpeechLexicon)
+    static const std::vector<std::pair<std::string_view, double>>& defaultEmotionScores();
+
+    LemmaTable(const LemmaTable&) = delete;
+    LemmaTable& operator=(const LemmaTable&) = delete;
+
+private:
+    LemmaTable();
+
+    struct Entry {
+        std::string text;
+        uint16_t flags = 0;
+        double score = 0.0;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t CHUNK_BITS = 12;                 // 4096 entrées par bloc
+    static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static constexpr size_t MAX_CHUNKS = 16384;              // 64 M chaînes
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string_view, LemmaId> index;   // Clés : vues sur Entry::text
+    };
+
+    // Blocs jamais déplacés ni libérés : une entrée publiée reste lisible sans verrou
+    const Entry& entry(LemmaId id) const {
+        return chunks_[id >> CHUNK_BITS].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+    }
+
+    Shard& shardFor(size_t hash) { return shards_[hash & (SHARD_COUNT - 1)]; }
+    const Shard& shardFor(size_t hash) const { return shards_[hash & (SHARD_COUNT - 1)]; }
+
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::unique_ptr<std::atomic<Entry*>[]> chunks_;
+    std::vector<std::unique_ptr<Entry[]>> owned_chunks_;
+    std::mutex growth_mutex_;                                 // Attribution des identifiants
+    std::atomic<size_t> size_{0};
+};
+
+} // namespace mcee
@@ -0,0 +1,183 @@
+/**
+ * @file LockFreeQueue.hpp
+ * @brief File bornée sans verrou (MPSC) pour relier les étages du pipeline
+ *
+ * Anneau à séquences (schéma de D. Vyukov) : chaque cellule porte un
+ * numéro de séquence qui indique si elle est libre ou occupée. Plusieurs
+ * producteurs peuvent pousser en parallèle, un seul consommateur dépile.
+ * Le consommateur peut s'endormir sur un compteur atomique (C++20
+ * std::atomic::wait) au lieu de scruter la file en boucle.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace mcee {
+
+/**
+ * @class BoundedMPSCQueue
+ * @brief File circulaire bornée multi-producteurs / mono-consommateur
+ *
+ * La capacité est arrondie à la puissance de 2 supérieure. Les opérations
+ * tryPush/tryPop ne bloquent jamais et n'allouent pas ; push() attend
+ * (spin puis yield) tant que la file est pleine, ce qui propage la
+ * contre-pression vers les consommateurs RabbitMQ.
+ */
+template <typename T>
+class BoundedMPSCQueue {
+public:
+    explicit BoundedMPSCQueue(size_t capacity = 1024)
+        : capacity_(roundUpPow2(capacity < 2 ? 2 : capacity))
+        , mask_(capacity_ - 1)
+        , cells_(std::make_unique<Cell[]>(capacity_))
+    {
+        for (size_t i = 0; i < capacity_; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+    BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+    /**
+     * @brief Tente d'insérer un élément sans attendre
+     * @return false si la file est pleine
+     */
+    bool tryPush(T&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // Pleine
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Insère un élément, en attendant si la file est pleine
+     * @param value Élément à insérer
+     * @param keep_going Drapeau d'arrêt (abandon si passe à false)
+     * @return false si abandonné avant insertion
+     */
+    bool push(T&& value, const std::atomic<bool>& keep_going) {
+        size_t spins = 0;
+        while (!tryPush(std::move(value))) {
+            if (!keep_going.load(std::memory_order_relaxed)) return false;
+            if (spins++ == 0) stalls_.fetch_add(1, std::memory_order_relaxed);
+            if (spins < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Tente de dépiler un élément (consommateur unique)
+     * @return false si la file est vide
+     */
+    bool tryPop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        Cell* cell = &cells_[pos & mask_];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff < 0) {
+            return false;  // Vide
+        }
+
+        out = std::move(cell->data);
+        cell->data = T{};
+        dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dépile un élément en s'endormant tant que la file est vide
+     * @param keep_going Drapeau d'arrêt ; la file est vidée avant de rendre false
+     * @return false si arrêt demandé et file vide
+     */
+    bool waitPop(T& out, const std::atomic<bool>& keep_going) {
+        for (;;) {
+            uint32_t observed = signal_.load(std::memory_order_acquire);
+            if (tryPop(out)) return true;
+            if (!keep_going.load(std::memory_order_acquire)) return false;
+            signal_.wait(observed, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Réveille le consommateur (utilisé à l'arrêt)
+     */
+    void wake() {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_all();
+    }
+
+    /**
+     * @brief Nombre approximatif d'éléments en attente
+     */
+    size_t size() const {
+        size_t enq = enqueue_pos_.load(std::memory_order_relaxed);
+        size_t deq = dequeue_pos_.load(std::memory_order_relaxed);
+        return enq > deq ? enq - deq : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * @brief Nombre de fois où un producteur a trouvé la file pleine
+     */
+    size_t stallCount() const { return stalls_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+
+    static size_t roundUpPow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    alignas(64) std::atomic<uint32_t> signal_{0};
+    std::atomic<size_t> stalls_{0};
+};
+
+} // namespace mcee
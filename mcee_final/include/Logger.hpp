@@ -0,0 +1,431 @@
+/**
+ * @file Logger.hpp
+ * @brief Journal asynchrone, hiérarchisé et structuré
+ *
+ * Les appelants formatent leur message dans un enregistrement de taille
+ * fixe et le déposent dans une file sans verrou (BoundedMPSCQueue) ; un
+ * thread de fond vide la file vers la sortie. Le chemin des trames ne
+ * touche donc jamais au terminal ni à journald : si la file est pleine,
+ * le message est compté comme perdu au lieu de bloquer.
+ *
+ * Les niveaux inférieurs à MCEE_LOG_COMPILED_LEVEL sont éliminés à la
+ * compilation (par défaut DEBUG en debug, INFO avec NDEBUG) ; les autres
+ * sont filtrés à l'exécution par le niveau configuré.
+ *
+ * Configuration par variables d'environnement (configureFromEnv) :
+ *   MCEE_LOG_LEVEL   trace | debug | info | warn | error | off
+ *   MCEE_LOG_FORMAT  text | json (une ligne JSON par enregistrement)
+ *   MCEE_LOG_FILE    fichier de sortie (défaut : stdout, WARN+ sur stderr)
+ *
+ * Autonome (pas de dépendance à Types.hpp) : inclus aussi par les modules
+ * emotion et reves.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "LockFreeQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace mcee {
+
+enum class LogLevel : int {
+    TRACE = 0,
+    DEBUG = 1,
+    INFO = 2,
+    WARN = 3,
+    ERROR = 4,
+    OFF = 5
+};
+
+enum class LogFormat {
+    TEXT,
+    JSON
+};
+
+#ifndef MCEE_LOG_COMPILED_LEVEL
+#ifdef NDEBUG
+#define MCEE_LOG_COMPILED_LEVEL 2
+#else
+#define MCEE_LOG_COMPILED_LEVEL 1
+#endif
+#endif
+
+/**
+ * @brief Configuration du journal
+ */
+struct LoggerConfig {
+    LogLevel level = LogLevel::INFO;
+    LogFormat format = LogFormat::TEXT;
+    std::string file_path;             // Vide : stdout (WARN+ sur stderr)
+};
+
+/**
+ * @brief Compteurs du journal
+ */
+struct LoggerStats {
+    uint64_t accepted = 0;             // Enregistrements déposés dans la file
+    uint64_t dropped = 0;              // Perdus car file pleine
+    uint64_t written = 0;              // Écrits par le thread de fond
+};
+
+/**
+ * @brief Enregistrement de taille fixe (aucune allocation dans la file)
+ */
+struct LogRecord {
+    static constexpr size_t QUEUE_CAPACITY = 4096;   // Enregistrements en attente (~4 Mo)
+    static constexpr size_t COMPONENT_CAPACITY = 24;
+    static constexpr size_t MESSAGE_CAPACITY = 976;  // Enregistrement de 1 Ko
+
+    int64_t timestamp_us = 0;          // Epoch, horloge système
+    LogLevel level = LogLevel::INFO;
+    uint32_t thread_id = 0;
+    uint16_t component_length = 0;
+    uint16_t message_length = 0;
+    char component[COMPONENT_CAPACITY];
+    char message[MESSAGE_CAPACITY];
+};
+
+inline const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "trace";
+        case LogLevel::DEBUG: return "debug";
+        case LogLevel::INFO:  return "info";
+        case LogLevel::WARN:  return "warn";
+        case LogLevel::ERROR: return "error";
+        case LogLevel::OFF:   return "off";
+    }
+    return "info";
+}
+
+inline LogLevel parseLogLevel(std::string_view name, LogLevel fallback = LogLevel::INFO) {
+    if (name == "trace") return LogLevel::TRACE;
+    if (name == "debug") return LogLevel::DEBUG;
+    if (name == "info") return LogLevel::INFO;
+    if (name == "warn" || name == "warning") return LogLevel::WARN;
+    if (name == "error") return LogLevel::ERROR;
+    if (name == "off") return LogLevel::OFF;
+    return fallback;
+}
+
+/**
+ * @class Logger
+ * @brief Journal global du processus (un thread d'écriture)
+ */
+class Logger {
+public:
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    ~Logger() { shutdown(); }
+
+    /**
+     * @brief Applique une configuration (vide la file en attente d'abord)
+     */
+    void configure(const LoggerConfig& config) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        stopWorker();
+
+        if (owns_output_ && output_) {
+            std::fclose(output_);
+        }
+        output_ = stdout;
+        owns_output_ = false;
+        if (!config.file_path.empty()) {
+            if (FILE* file = std::fopen(config.file_path.c_str(), "a")) {
+                output_ = file;
+                owns_output_ = true;
+            } else {
+                std::fprintf(stderr, "[Logger] Impossible d'ouvrir %s, sortie standard utilisée\n",
+                             config.file_path.c_str());
+            }
+        }
+
+        format_ = config.format;
+        level_.store(static_cast<int>(config.level), std::memory_order_relaxed);
+        startWorker();
+    }
+
+    /**
+     * @brief Configuration depuis MCEE_LOG_LEVEL / MCEE_LOG_FORMAT / MCEE_LOG_FILE
+     */
+    void configureFromEnv(LoggerConfig config = {}) {
+        if (const char* level = std::getenv("MCEE_LOG_LEVEL")) {
+            config.level = parseLogLevel(level, config.level);
+        }
+        if (const char* format = std::getenv("MCEE_LOG_FORMAT")) {
+            config.format = std::string_view(format) == "json" ? LogFormat::JSON : LogFormat::TEXT;
+        }
+        if (const char* file = std::getenv("MCEE_LOG_FILE")) {
+            config.file_path = file;
+        }
+        configure(config);
+    }
+
+    void setLevel(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    [[nodiscard]] LogLevel level() const { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+
+    [[nodiscard]] bool shouldLog(LogLevel level) const {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Formate les arguments (operator<<) et dépose l'enregistrement
+     *
+     * Ne bloque jamais : file pleine → enregistrement perdu et compté.
+     */
+    template <typename... Args>
+    void log(LogLevel level, std::string_view component, const Args&... args) {
+        LogRecord record;
+        record.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.level = level;
+        record.thread_id = static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        record.component_length = static_cast<uint16_t>(copyTruncated(
+            record.component, LogRecord::COMPONENT_CAPACITY, component));
+
+        // Flux réutilisé par thread, réécrit depuis le début : pas
+        // d'allocation une fois son tampon à la taille des messages
+        thread_local std::ostringstream stream;
+        stream.clear();
+        stream.seekp(0);
+        stream.flags(std::ios_base::skipws | std::ios_base::dec);
+        stream.precision(6);
+        (stream << ... << args);
+        size_t length = static_cast<size_t>(stream.tellp());
+        record.message_length = static_cast<uint16_t>(copyTruncated(
+            record.message, LogRecord::MESSAGE_CAPACITY, stream.view().substr(0, length)));
+
+        submit(std::move(record));
+    }
+
+    /**
+     * @brief Attend que les enregistrements déjà déposés soient écrits
+     */
+    void flush() {
+        uint64_t target = accepted_.load(std::memory_order_acquire);
+        while (running_.load(std::memory_order_acquire) &&
+               written_.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    /**
+     * @brief Vide la file et arrête le thread d'écriture
+     *
+     * Les messages suivants sont écrits de façon synchrone.
+     */
+    void shutdown() {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        stopWorker();
+        if (owns_output_ && output_) {
+            std::fclose(output_);
+            output_ = stdout;
+            owns_output_ = false;
+        }
+    }
+
+    [[nodiscard]] LoggerStats stats() const {
+        LoggerStats s;
+        s.accepted = accepted_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        s.written = written_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    Logger() : queue_(LogRecord::QUEUE_CAPACITY) {
+        startWorker();
+    }
+
+    static size_t copyTruncated(char* dest, size_t capacity, std::string_view src) {
+        size_t n = std::min(src.size(), capacity);
+        std::memcpy(dest, src.data(), n);
+        return n;
+    }
+
+    void submit(LogRecord&& record) {
+        if (!running_.load(std::memory_order_acquire)) {
+            write(record);  // Avant démarrage ou après arrêt : écriture directe
+            std::fflush(output_);
+            return;
+        }
+        if (queue_.tryPush(std::move(record))) {
+            accepted_.fetch_add(1, std::memory_order_release);
+        } else {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void startWorker() {
+        running_.store(true, std::memory_order_release);
+        worker_ = std::thread([this]() { drainLoop(); });
+    }
+
+    void stopWorker() {
+        if (!worker_.joinable()) return;
+        running_.store(false, std::memory_order_release);
+        queue_.wake();
+        worker_.join();
+
+        // Dépôts concurrents à l'arrêt : écrits ici plutôt que perdus
+        LogRecord record;
+        while (queue_.tryPop(record)) {
+            write(record);
+            written_.fetch_add(1, std::memory_order_release);
+        }
+        std::fflush(output_);
+        if (output_ != stdout) std::fflush(stdout);
+        std::fflush(stderr);
+    }
+
+    void drainLoop() {
+        LogRecord record;
+        while (queue_.waitPop(record, running_)) {
+            write(record);
+            written_.fetch_add(1, std::memory_order_release);
+            // Lot courant écrit : une seule synchronisation du flux
+            if (queue_.empty()) {
+                reportDrops();
+                std::fflush(output_);
+                if (output_ != stdout) std::fflush(stdout);
+            }
+        }
+    }
+
+    void reportDrops() {
+        uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+        if (dropped == reported_drops_) return;
+
+        LogRecord record;
+        record.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.level = LogLevel::WARN;
+        record.component_length = static_cast<uint16_t>(copyTruncated(
+            record.component, LogRecord::COMPONENT_CAPACITY, "Logger"));
+        int n = std::snprintf(record.message, LogRecord::MESSAGE_CAPACITY,
+                              "%llu message(s) perdu(s) (file pleine)",
+                              static_cast<unsigned long long>(dropped - reported_drops_));
+        record.message_length = static_cast<uint16_t>(std::max(n, 0));
+        write(record);
+        reported_drops_ = dropped;
+    }
+
+    void write(const LogRecord& record) {
+        FILE* out = (!owns_output_ && record.level >= LogLevel::WARN) ? stderr : output_;
+        std::string_view component(record.component, record.component_length);
+        std::string_view message(record.message, record.message_length);
+
+        std::time_t seconds = static_cast<std::time_t>(record.timestamp_us / 1000000);
+        std::tm tm{};
+        localtime_r(&seconds, &tm);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &tm);
+        int millis = static_cast<int>((record.timestamp_us / 1000) % 1000);
+
+        if (format_ == LogFormat::JSON) {
+            std::string line;
+            line.reserve(96 + message.size());
+            line += "{\"ts\":\"";
+            line += date;
+            char frac[8];
+            std::snprintf(frac, sizeof(frac), ".%03d", millis);
+            line += frac;
+            line += "\",\"level\":\"";
+            line += logLevelName(record.level);
+            line += "\",\"component\":\"";
+            appendJsonEscaped(line, component);
+            line += "\",\"thread\":";
+            line += std::to_string(record.thread_id);
+            line += ",\"msg\":\"";
+            appendJsonEscaped(line, message);
+            line += "\"}\n";
+            std::fwrite(line.data(), 1, line.size(), out);
+        } else {
+            std::fprintf(out, "%s.%03d %-5s [%.*s] %.*s\n", date, millis, logLevelName(record.level),
+                         static_cast<int>(component.size()), component.data(),
+                         static_cast<int>(message.size()), message.data());
+        }
+    }
+
+    static void appendJsonEscaped(std::string& out, std::string_view text) {
+        for (char c : text) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char esc[8];
+                        std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+                        out += esc;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+    }
+
+    std::mutex config_mutex_;
+    BoundedMPSCQueue<LogRecord> queue_;   // Jamais réallouée : les producteurs n'ont pas de verrou
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    std::atomic<int> level_{static_cast<int>(LogLevel::INFO)};
+    LogFormat format_ = LogFormat::TEXT;
+    FILE* output_ = stdout;
+    bool owns_output_ = false;
+
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_{0};
+    uint64_t reported_drops_ = 0;      // Thread d'écriture uniquement
+};
+
+} // namespace mcee
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MACROS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * MCEE_LOG_INFO("Composant", "texte ", valeur, ...) : les arguments ne sont
+ * évalués que si le niveau est actif ; les niveaux sous
+ * MCEE_LOG_COMPILED_LEVEL ne génèrent aucun code.
+ */
+#define MCEE_LOG(level, component, ...)                                                   \
+    do {                                                                                  \
+        if constexpr (static_cast<int>(level) >= MCEE_LOG_COMPILED_LEVEL) {               \
+            if (::mcee::Logger::instance().shouldLog(level)) {                            \
+                ::mcee::Logger::instance().log(level, component, __VA_ARGS__);            \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+#define MCEE_LOG_TRACE(component, ...) MCEE_LOG(::mcee::LogLevel::TRACE, component, __VA_ARGS__)
+#define MCEE_LOG_DEBUG(component, ...) MCEE_LOG(::mcee::LogLevel::DEBUG, component, __VA_ARGS__)
+#define MCEE_LOG_INFO(component, ...)  MCEE_LOG(::mcee::LogLevel::INFO, component, __VA_ARGS__)
+#define MCEE_LOG_WARN(component, ...)  MCEE_LOG(::mcee::LogLevel::WARN, component, __VA_ARGS__)
+#define MCEE_LOG_ERROR(component, ...) MCEE_LOG(::mcee::LogLevel::ERROR, component, __VA_ARGS__)
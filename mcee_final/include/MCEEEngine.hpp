@@ -22,6 +22,7 @@
 #include "PhaseDetector.hpp"
 #include "EmotionUpdater.hpp"
 #include "Amyghaleon.hpp"
+#include "EmergencyLane.hpp"
 #include "MemoryManager.hpp"
 #include "SpeechInput.hpp"
 #include "ConscienceEngine.hpp"
@@ -29,6 +30,15 @@
 #include "DecisionEngine.hpp"
 #include "LLMClient.hpp"
 #include "HybridSearchEngine.hpp"
+#include "PatternPrefetcher.hpp"
+#include "StateJournal.hpp"
+#include "PublishPolicy.hpp"
+#include "LockFreeQueue.hpp"
+#include "EmotionWire.hpp"
+#include "Metrics.hpp"
+#include "SessionTrace.hpp"
+#include "Executor.hpp"
+#include "FrameArena.hpp"
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <nlohmann/json.hpp>
 #include <atomic>
@@ -43,6 +53,14 @@ namespace mcee {
 
 using json = nlohmann::json;
 
+/**
+ * @brief Fusion des trames émotionnelles en retard (politique d'ingestion)
+ */
+enum class CoalesceMode {
+    LATEST,         // Seule la trame la plus récente est gardée
+    TIME_WEIGHTED   // Moyenne des trames pondérée par leur durée de validité
+};
+
 /**
  * @brief Configuration RabbitMQ
  */
@@ -68,9 +86,154 @@ struct RabbitMQConfig {
     std::string output_exchange = "mcee.emotional.output";
     std::string output_routing_key = "mcee.state";
 
+    // Voie rapide d'urgence (Amyghaleon à l'ingestion), sur l'exchange de sortie
+    std::string emergency_routing_key = "mcee.emergency";
+    std::string emergency_queue = "mcee_emergency_queue";   // Déclarée avec x-max-priority 10
+    uint8_t emergency_priority = 9;                         // Priorité AMQP des réponses d'urgence
+
     // Sortie snapshots MCTGraph (vers module rêves)
     std::string snapshot_exchange = "mcee.mct.snapshot";
     std::string snapshot_routing_key = "mct.graph";
+
+    // Mode de consommation : QoS prefetch, drainage par réveil, acquittement groupé
+    uint16_t consumer_prefetch = 64;        // Messages non acquittés autorisés par consommateur
+    size_t consumer_batch_max = 32;         // Messages drainés par réveil (≤ prefetch)
+    int consumer_poll_timeout_ms = 500;     // Attente du premier message d'un lot
+    int consumer_error_backoff_ms = 1000;   // Pause après une erreur de consommation
+    bool consumer_multi_ack = true;         // Un seul ack (multiple) par lot traité
+
+    // Politique d'ingestion sous surcharge (étage [match]) : au-delà d'une
+    // profondeur de file ou d'un âge de trame, les trames émotions
+    // consécutives sont fusionnées en une poussée MCT et le travail
+    // secondaire est délesté. Les trames d'urgence ne sont jamais fusionnées.
+    size_t ingest_coalesce_depth = 8;       // Trames en attente déclenchant la fusion (0 : jamais)
+    int ingest_coalesce_age_ms = 250;       // Âge de trame déclenchant la fusion (0 : jamais)
+    size_t ingest_coalesce_max = 64;        // Trames fusionnées au plus en une seule
+    CoalesceMode ingest_coalesce_mode = CoalesceMode::LATEST;
+    bool ingest_shed = true;                // Délester causalité MCTGraph, consolidation MLT, dumps et publications périmées
+
+    // Format de l'état publié : trame binaire EmotionWire (sinon JSON complet)
+    bool binary_state_output = false;
+    WirePrecision wire_precision = WirePrecision::FLOAT32;
+
+    // Sortie métriques (texte Prometheus, publié périodiquement)
+    std::string metrics_exchange = "mcee.metrics";
+    std::string metrics_routing_key = "mcee.prometheus";
+    double metrics_interval_seconds = 15.0;  // 0 : pas de publication
+
+    // Hébergement multi-session (MCEEHost) : clé de session des en-têtes AMQP,
+    // lue en entrée et recopiée sur chaque message publié par la session
+    std::string session_header = "session_id";
+
+    // Estampille opaque (int64) d'une trame émotions, renvoyée telle quelle sur
+    // l'état publié qui en résulte : latence de bout en bout (mcee_loadgen)
+    std::string trace_header = "mcee_trace";
+};
+
+/**
+ * @brief Configuration du pipeline par étages
+ *
+ * Les trames traversent trois étages reliés par des files bornées :
+ * ingest → [match] MCT/MCTGraph/PatternMatcher
+ *        → [update] souvenirs/Amyghaleon/EmotionUpdater
+ *        → [persist] consolidation MLT/souvenirs/publication
+ */
+struct PipelineConfig {
+    bool enabled = true;               // false : pipeline synchrone (sous state_mutex_)
+    size_t match_queue_capacity = 1024;
+    size_t update_queue_capacity = 256;
+    size_t persist_queue_capacity = 256;
+    size_t state_log_interval = 50;    // Dump diagnostique une trame sur N (0 : jamais)
+    size_t frame_arena_bytes = 64 * 1024;  // Arène des temporaires de [update] et de [persist]
+};
+
+/**
+ * @brief Trame circulant entre les étages du pipeline
+ */
+struct PipelineFrame {
+    enum class Kind {
+        EMOTIONS,   // Nouvel état brut à traiter
+        SPEECH,     // Analyse de parole (mise à jour du feedback externe)
+        FEEDBACK,   // Feedback imposé (setFeedback)
+        URGENCY,    // Plancher de feedback interne (urgence détectée dans le texte)
+        CHECKPOINT, // Capture de l'état par [match] puis [update] (journal)
+        PUBLISH     // Vidange de la politique de publication (minuterie, [persist] seul)
+    };
+
+    Kind kind = Kind::EMOTIONS;
+    EmotionalState state;                              // Brut à l'entrée, traité après [update]
+    std::shared_ptr<const MatchResult> match;          // Rempli par [match] (partagé si réutilisé)
+    EmotionSummary summary;                            // Rempli par [update] (état traité)
+    std::shared_ptr<const SpeechAnalysis> speech;      // Dernière parole connue de [match]
+    Feedback feedback;                                 // FEEDBACK / URGENCY / SPEECH (external)
+    std::string memory_context;                        // SPEECH : souvenir à enregistrer si non vide
+    Phase phase = Phase::SERENITE;                     // Phase legacy lors de [update]
+    bool reflex = false;                               // Urgence déjà publiée par la voie rapide
+    bool shed = false;                                 // Surcharge : travail secondaire délesté
+    uint32_t coalesced = 1;                            // Trames émotions fusionnées dans celle-ci
+    uint64_t heap_allocations = 0;                     // Allocations du tas pendant les étages
+    std::shared_ptr<nlohmann::json> checkpoint;        // CHECKPOINT : état capturé jusqu'ici
+    uint64_t checkpoint_seq = 0;                       // CHECKPOINT : dernier enregistrement couvert
+    std::chrono::steady_clock::time_point ingest_time;
+    int64_t trace = 0;                                 // EMOTIONS : en-tête trace_header (0 : absent)
+};
+
+/**
+ * @brief Trame lue au-delà d'une fusion, servie avant la file au tour suivant
+ */
+struct PendingFrame {
+    PipelineFrame frame;
+    bool present = false;
+};
+
+/**
+ * @brief Latences par étape du pipeline (une trame émotionnelle)
+ *
+ * Chaque histogramme n'est écrit que par le thread de son étage ;
+ * end_to_end mesure la soumission (consommation RabbitMQ) → publication.
+ */
+struct PipelineMetrics {
+    LatencyHistogram mct_push;            // [match] MCT::push
+    LatencyHistogram graph_insert;        // [match] MCTGraph::addEmotionWithContext
+    LatencyHistogram graph_causality;     // [match] MCTGraph::detectCausality
+    LatencyHistogram pattern_match;       // [match] identifyPattern
+    LatencyHistogram memory_query;        // [update] queryRelevantMemories
+    LatencyHistogram amyghaleon;          // [update] handleEmergency
+    LatencyHistogram emotion_update;      // [update] EmotionUpdater::updateAllEmotions
+    LatencyHistogram mlt_consolidation;   // [persist] consolidateToMLT
+    LatencyHistogram publish_state;       // [persist] publishState
+    LatencyHistogram end_to_end;          // submitFrame → publication
+    LatencyHistogram emergency_lane;      // Réception → publication de la voie rapide d'urgence
+};
+
+/**
+ * @brief Ressources communes aux sessions d'un MCEEHost
+ *
+ * Chaque session garde sa MCT, son MCTGraph, son PatternMatcher et son
+ * état émotionnel ; ces ressources, thread-safe ou immuables, ne sont
+ * instanciées qu'une fois par processus. La MLT commune n'est que lue :
+ * chaque session apprend dans sa propre couche (MLT(base)).
+ */
+struct SharedEngineResources {
+    std::shared_ptr<const MLT> mlt;                 // Patterns de base (figés dès le partage)
+    std::shared_ptr<const SpeechLexicon> lexicon;   // Dictionnaires de parole (immuables)
+    std::shared_ptr<LLMClient> llm_client;          // Transport LLM
+    std::shared_ptr<Neo4jClient> neo4j_client;      // Connexion Neo4j (nullptr : mode local)
+};
+
+/**
+ * @brief Empreinte mémoire approximative d'un moteur (octets)
+ *
+ * Les ressources partagées (SharedEngineResources) ne sont pas comptées.
+ */
+struct EngineFootprint {
+    size_t mct = 0;
+    size_t graph = 0;
+    size_t memories = 0;    // Souvenirs locaux et leur index
+    size_t speech = 0;      // Historique des analyses de parole
+    size_t engine = 0;      // Moteur, modules et files du pipeline
+
+    [[nodiscard]] size_t total() const { return mct + graph + memories + speech + engine; }
 };
 
 /**
@@ -92,7 +255,105 @@ public:
      * @brief Constructeur
      * @param rabbitmq_config Configuration RabbitMQ
      */
-    explicit MCEEEngine(const RabbitMQConfig& rabbitmq_config = RabbitMQConfig{});
+    explicit MCEEEngine(const RabbitMQConfig& rabbitmq_config = RabbitMQConfig{},
+                        const PipelineConfig& pipeline_config = PipelineConfig{});
+
+    /**
+     * @brief Constructeur d'une session hébergée (MCEEHost)
+     *
+     * Pipeline synchrone, sans thread ni connexion propre : l'hôte livre les
+     * messages (handle*Message), fournit le channel de publication et
+     * cadence graphTick() depuis le worker de la session.
+     *
+     * @param session_id Clé de session (recopiée dans les en-têtes publiés)
+     * @param shared Ressources communes (un membre nul est créé localement)
+     */
+    MCEEEngine(std::string session_id, const SharedEngineResources& shared,
+               const RabbitMQConfig& rabbitmq_config = RabbitMQConfig{});
+
+    /**
+     * @brief Crée les ressources partageables avec la configuration par défaut du moteur
+     *
+     * Neo4j n'est pas connecté ici (cf. readNeo4jConfig).
+     */
+    static SharedEngineResources createSharedResources();
+
+    /**
+     * @brief Lit la section "neo4j" d'un fichier de configuration
+     * @return true si la section est présente et activée
+     */
+    static bool readNeo4jConfig(const std::string& config_path, Neo4jClientConfig& config);
+
+    /**
+     * @brief Lit la section "memory" d'un fichier de configuration
+     * @return true si la section est présente
+     */
+    static bool readMemoryTierConfig(const std::string& config_path, MemoryTierConfig& config);
+
+    /**
+     * @brief Lit la section "prefetch" d'un fichier de configuration
+     * @return true si la section est présente
+     */
+    static bool readPrefetchConfig(const std::string& config_path, PrefetchConfig& config);
+
+    /**
+     * @brief Lit la section "journal" d'un fichier de configuration
+     * @return true si la section est présente
+     */
+    static bool readJournalConfig(const std::string& config_path, JournalConfig& config);
+
+    /**
+     * @brief Lit la section "publish" d'un fichier de configuration
+     * @return true si la section est présente
+     */
+    static bool readPublishPolicyConfig(const std::string& config_path, PublishPolicyConfig& config);
+
+    // ─────────────────────────────────────────────────────────────────────
+    // Politique d'ingestion de l'étage [match] (sans état : testable seule)
+    // ─────────────────────────────────────────────────────────────────────
+
+    /**
+     * @brief Vrai si la profondeur de file ou l'âge de la trame dépasse les seuils d'ingestion
+     */
+    [[nodiscard]] static bool ingestOverloaded(const PipelineFrame& frame, size_t queue_depth,
+                                               const RabbitMQConfig& config,
+                                               std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Fusionne dans frame les trames émotions qui la suivent en file
+     *
+     * S'arrête à la première trame d'un autre type ou d'urgence, placée
+     * dans next pour être traitée ensuite (l'ordre est conservé). En mode
+     * TIME_WEIGHTED, chaque trame pèse de son arrivée à celle de la suivante,
+     * la dernière jusqu'à now.
+     * @return true si next contient une trame à traiter
+     */
+    static bool coalesceBacklog(PipelineFrame& frame, PipelineFrame& next,
+                                BoundedMPSCQueue<PipelineFrame>& queue, const RabbitMQConfig& config,
+                                std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Prochaine trame de l'étage [match]
+     *
+     * Sert d'abord la trame lue au-delà d'une fusion (pending), sinon attend
+     * la file ; sous surcharge, fusionne le retard et marque la trame délestée.
+     * @return false si l'étage s'arrête
+     */
+    static bool takeMatchFrame(PipelineFrame& frame, PendingFrame& pending,
+                               BoundedMPSCQueue<PipelineFrame>& queue, const RabbitMQConfig& config,
+                               const std::atomic<bool>& running);
+
+    /**
+     * @brief Vrai si la publication d'une trame délestée est périmée
+     *
+     * Un état plus récent attend déjà l'étage [persist] : seul lui est publié.
+     */
+    [[nodiscard]] static bool publishIsStale(const PipelineFrame& frame, size_t persist_backlog);
+
+    /**
+     * @brief Convertit les émotions brutes en EmotionalState (bornées, E_global, variance)
+     */
+    static EmotionalState rawToState(const std::array<double, NUM_EMOTIONS>& raw);
 
     /**
      * @brief Destructeur
@@ -125,6 +386,11 @@ public:
      */
     void processEmotions(const std::unordered_map<std::string, double>& raw_emotions);
 
+    /**
+     * @brief Traite un état émotionnel déjà indexé (ordre de EMOTION_NAMES)
+     */
+    void processEmotions(const std::array<double, NUM_EMOTIONS>& raw_emotions, int64_t trace = 0);
+
     /**
      * @brief Traite un texte reçu du module de parole
      * @param text Texte à traiter
@@ -137,6 +403,102 @@ public:
      */
     void setFeedback(double external, double internal);
 
+    // ═══════════════════════════════════════════════════════════════
+    // ENTRÉES RABBITMQ (consommateurs propres ou MCEEHost)
+    // ═══════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Aiguille un message vers le handler de son flux
+     */
+    void handleInput(MCEEInput input, const std::string& body, const std::string& content_type = "",
+                     int64_t trace = 0);
+
+    /**
+     * @brief Enregistre chaque message reçu dans une trace (rejeu hors ligne)
+     */
+    void setTraceWriter(std::shared_ptr<TraceWriter> writer);
+
+    /**
+     * @brief Traite un message d'émotion RabbitMQ
+     * @param body Corps du message (JSON ou trame EmotionWire)
+     * @param content_type Content-type AMQP (vide : JSON)
+     * @param trace Estampille à renvoyer sur l'état publié (0 : aucune)
+     */
+    void handleEmotionMessage(const std::string& body, const std::string& content_type = "",
+                              int64_t trace = 0);
+
+    /**
+     * @brief Lit l'estampille d'un message reçu (0 si l'en-tête est absent)
+     */
+    static int64_t traceStamp(const AmqpClient::BasicMessage::ptr_t& message, const std::string& header);
+
+    /**
+     * @brief Traite un message de parole RabbitMQ
+     * @param body Corps du message (JSON)
+     */
+    void handleSpeechMessage(const std::string& body);
+
+    /**
+     * @brief Traite un message de tokens Neo4j/spaCy
+     * @param body Corps du message (JSON)
+     */
+    void handleTokensMessage(const std::string& body);
+
+    /**
+     * @brief Publie le delta MCTGraph puis exécute la maintenance du graphe
+     * @param keep_going Interrompt la maintenance entre deux tranches
+     */
+    void graphTick(const std::atomic<bool>& keep_going);
+
+    /**
+     * @brief Publications via un channel fourni (session hébergée)
+     *
+     * Le channel n'est utilisé que depuis le thread qui livre les messages.
+     */
+    void attachPublishChannel(AmqpClient::Channel::ptr_t channel);
+
+    /**
+     * @brief Clé de session (vide hors MCEEHost)
+     */
+    [[nodiscard]] const std::string& getSessionId() const { return session_id_; }
+
+    /**
+     * @brief Empreinte mémoire propre à ce moteur
+     */
+    [[nodiscard]] EngineFootprint memoryFootprint() const;
+
+    /**
+     * @brief État propre de la session, pour son transfert vers un autre nœud
+     *
+     * MCT (buffer compris), PatternMatcher et MCTGraph via leurs toJson,
+     * plus l'état émotionnel courant, le dernier match et la sagesse. Les
+     * souvenirs restent dans Neo4j, partagé par les nœuds.
+     */
+    [[nodiscard]] nlohmann::json exportSessionState() const;
+
+    /**
+     * @brief Restaure un état produit par exportSessionState()
+     *
+     * Remplace l'état accumulé localement (messages arrivés avant le transfert).
+     */
+    void importSessionState(const nlohmann::json& j);
+
+    /**
+     * @brief Reprend l'état du répertoire du journal puis journalise la suite
+     *
+     * À appeler après loadPatterns() et avant start() : restaure le dernier
+     * checkpoint (état de session, feedback, Conscience, ADDO, souvenirs
+     * locaux, snapshot MLT), rejoue les enregistrements postérieurs, puis
+     * ouvre un nouveau segment. Sans effet sur une session hébergée.
+     * @return false si le checkpoint est illisible ou le répertoire inutilisable
+     */
+    bool enableJournal(const JournalConfig& config);
+
+    /**
+     * @brief Compteurs du journal (zéros si désactivé)
+     */
+    [[nodiscard]] JournalStats getJournalStats() const;
+
     /**
      * @brief Retourne le gestionnaire de parole
      */
@@ -163,9 +525,27 @@ public:
     [[nodiscard]] std::string getCurrentPatternId() const;
 
     /**
-     * @brief Retourne les statistiques
+     * @brief Retourne les statistiques (avec profondeur des files du pipeline)
      */
-    [[nodiscard]] const MCEEStats& getStats() const { return stats_; }
+    [[nodiscard]] MCEEStats getStats() const;
+
+    /**
+     * @brief Urgences déclenchées (compteur seul, sans la copie de getStats)
+     */
+    [[nodiscard]] size_t getEmergencyTriggers() const { return stats_.emergency_triggers; }
+
+    /**
+     * @brief Latences par étape du pipeline
+     */
+    [[nodiscard]] const PipelineMetrics& getPipelineMetrics() const { return metrics_; }
+
+    /**
+     * @brief Métriques au format d'exposition texte Prometheus
+     *
+     * Histogrammes par étape et de bout en bout, aller-retour Neo4j,
+     * appels LLM, taux de succès du cache HybridSearch, files du pipeline.
+     */
+    [[nodiscard]] std::string renderMetrics() const;
 
     /**
      * @brief Retourne les coefficients actuels du pattern
@@ -250,6 +630,23 @@ public:
      */
     std::shared_ptr<HybridSearchEngine> getHybridSearchEngine() { return hybrid_search_; }
 
+    /**
+     * @brief Compteurs du préchargement des patterns probables
+     */
+    [[nodiscard]] PrefetchStats getPrefetchStats() const {
+        return prefetcher_ ? prefetcher_->getStats() : PrefetchStats{};
+    }
+
+    /**
+     * @brief Compteurs de la politique de publication de l'état
+     */
+    [[nodiscard]] PublishStats getPublishStats() const { return publish_policy_.getStats(); }
+
+    /**
+     * @brief Retourne le préchargeur (nullptr avant initialisation)
+     */
+    PatternPrefetcher* getPatternPrefetcher() { return prefetcher_.get(); }
+
     /**
      * @brief Génère une réponse émotionnellement adaptée via LLM
      * @param question Question utilisateur
@@ -322,6 +719,8 @@ public:
 private:
     // Configuration
     RabbitMQConfig rabbitmq_config_;
+    PipelineConfig pipeline_config_;
+    std::string session_id_;                // Session hébergée (vide : moteur autonome)
 
     // Nouveau système MCT/MLT (v3)
     std::shared_ptr<MCT> mct_;
@@ -342,14 +741,23 @@ private:
     PhaseDetector phase_detector_;
     EmotionUpdater emotion_updater_;
     Amyghaleon amyghaleon_;
+    EmergencyLane emergency_lane_;      // Voie rapide : seuil publié par [match], lu à l'ingestion
     MemoryManager memory_manager_;
     SpeechInput speech_input_;
+    std::unique_ptr<PatternPrefetcher> prefetcher_;  // Après memory_manager_ : détruit avant lui
+
+    // Journal d'état (WAL + checkpoints), si activé
+    std::unique_ptr<StateJournal> journal_;
+    std::mutex journal_tokens_mutex_;   // Ajout + application d'un message tokens, capture du graphe
+    std::string journal_scratch_;       // Charge en cours d'encodage (thread [match])
+    size_t journal_recovered_ = 0;
+    double journal_recovery_ms_ = 0.0;
 
     // État
     EmotionalState current_state_;
     EmotionalState previous_state_;
     Feedback current_feedback_;
-    SpeechAnalysis last_speech_analysis_;
+    std::shared_ptr<const SpeechAnalysis> last_speech_analysis_;
     double wisdom_ = 0.0;
     MCEEStats stats_;
 
@@ -359,6 +767,10 @@ private:
     AmqpClient::Channel::ptr_t speech_channel_;     // Channel dédié consommation parole
     AmqpClient::Channel::ptr_t tokens_channel_;     // Channel dédié consommation tokens
     AmqpClient::Channel::ptr_t publish_channel_;    // Channel dédié publications (état + snapshots)
+    std::shared_ptr<TraceWriter> trace_writer_;     // Messages reçus (SessionTrace), si enregistrement
+    AmqpClient::Channel::ptr_t emergency_channel_;  // Channel dédié urgences (étage update)
+    AmqpClient::Channel::ptr_t emergency_lane_channel_;  // Channel de la voie rapide (tâche de vidange uniquement)
+    AmqpClient::Channel::ptr_t metrics_channel_;    // Channel dédié métriques (timer)
     std::string emotions_consumer_tag_;
     std::string speech_consumer_tag_;
     std::string tokens_consumer_tag_;
@@ -368,10 +780,54 @@ private:
     std::thread emotions_consumer_thread_;
     std::thread speech_consumer_thread_;
     std::thread tokens_consumer_thread_;
-    std::thread snapshot_timer_thread_;
-    std::mutex state_mutex_;
+    std::atomic<bool> emergency_lane_running_{false};
+
+    // Tâches sur l'Executor : minuteries (snapshot, métriques) et vidange d'urgence
+    std::shared_ptr<Executor> executor_;
+    CancellationSource timer_source_;
+    TaskFuture<void> snapshot_timer_;
+    TaskFuture<void> metrics_timer_;
+    TaskFuture<void> publish_timer_;
+    std::atomic<bool> emergency_drain_scheduled_{false};
+
+    // Réponses asynchrones en cours (voie du LLMClient), attendues à la destruction
+    std::mutex async_mutex_;
+    std::condition_variable async_cv_;
+    size_t async_responses_ = 0;
+    std::mutex state_mutex_;            // Sérialise le pipeline synchrone uniquement
     StateCallback on_state_change_;
 
+    // Pipeline par étages (une file + un thread consommateur par étage)
+    BoundedMPSCQueue<PipelineFrame> match_queue_;
+    BoundedMPSCQueue<PipelineFrame> update_queue_;
+    BoundedMPSCQueue<PipelineFrame> persist_queue_;
+    std::atomic<bool> pipeline_active_{false};
+    std::atomic<bool> match_stage_running_{false};
+    std::atomic<bool> update_stage_running_{false};
+    std::atomic<bool> persist_stage_running_{false};
+    std::thread match_stage_thread_;
+    std::thread update_stage_thread_;
+    std::thread persist_stage_thread_;
+    std::atomic<uint64_t> persist_forwarded_{0};   // Trames EMOTIONS confiées à [persist] par [update]
+    std::atomic<uint64_t> persist_completed_{0};   // Trames EMOTIONS terminées par [persist]
+    std::atomic<size_t> frames_processed_{0};
+    PipelineMetrics metrics_;
+
+    // Publication de l'état : états retenus par la politique ([persist])
+    StatePublishPolicy publish_policy_;
+    std::vector<PublishItem> publish_items_;
+    std::atomic<bool> publish_flush_queued_{false};  // Trame PUBLISH en file [persist]
+
+    // Temporaires par trame : une arène par étage, rembobinée en fin de trame
+    FrameArena update_arena_;
+    FrameArena persist_arena_;
+    std::atomic<uint64_t> frame_heap_allocations_{0};  // Cumul des trames émotionnelles publiées
+
+    // Politique d'ingestion sous surcharge
+    std::atomic<uint64_t> ingest_coalesced_{0};        // Trames absorbées par une fusion
+    std::atomic<uint64_t> ingest_shed_{0};             // Trames traitées en mode délesté
+    std::atomic<uint64_t> ingest_publish_skipped_{0};  // Publications d'états déjà périmés évitées
+
     // Timestamps
     std::chrono::steady_clock::time_point last_update_time_;
     std::chrono::steady_clock::time_point pattern_start_time_;
@@ -381,10 +837,49 @@ private:
      */
     bool initRabbitMQ();
 
+    /**
+     * @brief Câble les modules (commun aux deux constructeurs)
+     * @param shared Ressources communes, nullptr : moteur autonome
+     */
+    void initialize(const SharedEngineResources* shared);
+
     /**
      * @brief Initialise le système MCT/MLT
      */
-    void initMemorySystem();
+    void initMemorySystem(const SharedEngineResources* shared);
+
+    /**
+     * @brief MLT et LLMClient avec la configuration par défaut du moteur
+     */
+    static std::shared_ptr<MLT> createMLT();
+    static std::shared_ptr<LLMClient> createLLMClient();
+
+    /**
+     * @brief Configuration d'une session hébergée : pipeline synchrone, files minimales
+     */
+    static PipelineConfig hostedPipelineConfig();
+
+    /**
+     * @brief Recopie la clé de session (et l'estampille, si non nulle) dans les en-têtes d'un message publié
+     */
+    void tagSession(const AmqpClient::BasicMessage::ptr_t& message, int64_t trace = 0) const;
+
+    /**
+     * @brief Boucle de consommation par lots commune aux trois consommateurs
+     *
+     * Attend le premier message (consumer_poll_timeout_ms), draine sans
+     * attendre jusqu'à consumer_batch_max messages déjà livrés, passe le lot
+     * au traitement puis l'acquitte en un seul BasicAck(multiple).
+     *
+     * @param channel Channel dédié du consommateur
+     * @param consumer_tag Tag renvoyé par BasicConsume
+     * @param label Nom pour les logs
+     * @param handler Traitement du lot (messages dans l'ordre de livraison)
+     */
+    void consumeBatchLoop(const AmqpClient::Channel::ptr_t& channel,
+                          const std::string& consumer_tag,
+                          const std::string& label,
+                          const std::function<void(const std::vector<AmqpClient::BasicMessage::ptr_t>&)>& handler);
 
     /**
      * @brief Boucle de consommation des émotions RabbitMQ
@@ -402,27 +897,26 @@ private:
     void tokensConsumeLoop();
 
     /**
-     * @brief Boucle du timer pour export snapshots MCTGraph
+     * @brief Programme les minuteries snapshot et métriques (classe BACKGROUND)
      */
-    void snapshotTimerLoop();
+    void startTimers();
 
     /**
-     * @brief Traite un message d'émotion RabbitMQ
-     * @param body Corps du message (JSON)
+     * @brief Programme une vidange de la voie rapide (classe EMERGENCY) si
+     *        aucune n'est déjà programmée
      */
-    void handleEmotionMessage(const std::string& body);
+    void scheduleEmergencyDrain();
 
     /**
-     * @brief Traite un message de parole RabbitMQ
-     * @param body Corps du message (JSON)
+     * @brief Publie les déclenchements en attente (un seul consommateur à la fois)
      */
-    void handleSpeechMessage(const std::string& body);
+    void drainEmergencyLane();
 
     /**
-     * @brief Traite un message de tokens Neo4j/spaCy
-     * @param body Corps du message (JSON)
+     * @brief Publie un déclenchement de la voie rapide (file prioritaire)
+     * @param channel Channel du thread appelant (nullptr : mesure seule, ex. rejeu)
      */
-    void handleTokensMessage(const std::string& body);
+    void publishEmergencyLane(const AmqpClient::Channel::ptr_t& channel, const EmergencyLaneEvent& event);
 
     /**
      * @brief Publie un snapshot MCTGraph vers le module rêves
@@ -430,20 +924,114 @@ private:
     void publishSnapshot(const MCTGraphSnapshot& snapshot);
 
     /**
-     * @brief Pipeline de traitement MCEE v3 complet
-     * @param raw_emotions Émotions brutes du module C++
+     * @brief Publie un delta (ou une keyframe) MCTGraph vers le module rêves
+     */
+    void publishGraphDelta(const MCTGraphDelta& delta);
+
+    /**
+     * @brief Publie renderMetrics() sur metrics_exchange
+     */
+    void publishMetrics();
+
+    /**
+     * @brief Publie les états retenus par la politique (un lot binaire si plusieurs)
+     */
+    void publishItems(std::vector<PublishItem>& items);
+
+    /**
+     * @brief Publie l'état en attente de la politique si le débit le permet
+     * @param force Tout publier (arrêt)
+     */
+    void flushPublishPolicy(bool force);
+
+    /**
+     * @brief Tick de la minuterie : vidange par [persist] (ou en synchrone)
      */
-    void processPipeline(const std::unordered_map<std::string, double>& raw_emotions);
+    void publishTick();
+
+    /**
+     * @brief Pipeline de traitement MCEE v3 complet (synchrone, trois étages enchaînés)
+     * @param frame Trame contenant l'état brut
+     */
+    void processPipeline(PipelineFrame& frame);
+
+    /**
+     * @brief Soumet une trame au pipeline (asynchrone si démarré, synchrone sinon)
+     */
+    void submitFrame(PipelineFrame&& frame);
+
+    /**
+     * @brief Démarre / arrête les threads des étages
+     */
+    void startPipeline();
+    void stopPipeline();
+
+    /**
+     * @brief Boucles des étages asynchrones
+     */
+    void matchStageLoop();
+    void updateStageLoop();
+    void persistStageLoop();
+
+    /**
+     * @brief Étage [match] : MCT, MCTGraph, PatternMatcher (steps 1-3)
+     * @return true si la trame doit poursuivre vers [update]
+     */
+    bool runMatchStage(PipelineFrame& frame);
+
+    /**
+     * @brief Étage [update] : souvenirs, Amyghaleon, EmotionUpdater (steps 4-13)
+     * @return true si la trame doit poursuivre vers [persist]
+     */
+    bool runUpdateStage(PipelineFrame& frame);
+
+    /**
+     * @brief Étage [persist] : consolidation MLT, souvenirs, publication (steps 14-17)
+     */
+    void runPersistStage(PipelineFrame& frame);
+
+    /**
+     * @brief Journalise une trame au moment où [match] l'applique
+     */
+    void journalFrame(const PipelineFrame& frame);
+
+    /**
+     * @brief Trame CHECKPOINT si un checkpoint est dû (capture de l'état [match])
+     * @param force Dès qu'un enregistrement n'est pas couvert (arrêt)
+     * @return false si aucun checkpoint n'est dû
+     */
+    bool beginCheckpoint(PipelineFrame& frame, bool force = false);
+
+    /**
+     * @brief Termine la capture d'une trame CHECKPOINT à son passage dans [update]
+     *
+     * Attend que [persist] ait fini les trames antérieures : souvenirs et
+     * patterns MLT sont alors exactement ceux des enregistrements
+     * ≤ checkpoint_seq. Le snapshot MLT est encodé ici ; le thread du
+     * journal n'écrit que des octets figés.
+     */
+    void completeCheckpoint(PipelineFrame& frame);
+
+    /**
+     * @brief Parts de l'état possédées par [match] et [update]
+     */
+    void captureMatchState(nlohmann::json& j) const;
+    void captureUpdateState(nlohmann::json& j) const;
+
+    /**
+     * @brief Rejoue un enregistrement du journal (reprise, exécution synchrone)
+     */
+    void applyJournalRecord(const JournalRecord& record);
 
     /**
      * @brief Étape 1: Ajoute l'état brut à la MCT
      */
-    void pushToMCT(const EmotionalState& state);
+    void pushToMCT(const EmotionalState& state, const SpeechAnalysis* speech);
 
     /**
      * @brief Étape 2: Identifie le pattern via MLT
      */
-    MatchResult identifyPattern();
+    std::shared_ptr<const MatchResult> identifyPattern();
 
     /**
      * @brief Étape 3: Applique les coefficients du pattern
@@ -453,12 +1041,15 @@ private:
     /**
      * @brief Étape 4: Consolide en MLT si significatif
      */
-    void consolidateToMLT();
+    void consolidateToMLT(const PipelineFrame& frame);
 
     /**
-     * @brief Publie l'état actuel via RabbitMQ
+     * @brief Publie un état via RabbitMQ
+     * @param scratch Ressource du texte JSON (arène de l'étage appelant)
+     * @param emergency true : channel d'urgence (jamais derrière la persistance)
      */
-    void publishState();
+    void publishState(const EmotionalState& state, const MatchResult& match,
+                      std::pmr::memory_resource* scratch, bool emergency = false, int64_t trace = 0);
 
     /**
      * @brief Met à jour la sagesse accumulée
@@ -467,8 +1058,11 @@ private:
 
     /**
      * @brief Gère les urgences (patterns à seuil bas)
+     * @param reflex true : déclenchement déjà décidé (et publié) par la voie rapide
+     * @param scratch Ressource des temporaires (arène de [update])
+     * @return true si une urgence a été déclenchée
      */
-    void handleEmergency(const MatchResult& match);
+    bool handleEmergency(const MatchResult& match, bool reflex, std::pmr::memory_resource* scratch);
 
     /**
      * @brief Exécute une action d'urgence
@@ -476,14 +1070,9 @@ private:
     void executeEmergencyAction(const EmergencyResponse& response);
 
     /**
-     * @brief Convertit les émotions brutes en EmotionalState
-     */
-    EmotionalState rawToState(const std::unordered_map<std::string, double>& raw) const;
-
-    /**
-     * @brief Affiche l'état émotionnel actuel
+     * @brief Affiche un état émotionnel
      */
-    void printState() const;
+    void printState(const EmotionalState& state, const MatchResult& match) const;
 
     /**
      * @brief Configure les callbacks MCT/MLT/Matcher
@@ -0,0 +1,349 @@
+/**
+ * @file MCEEHost.hpp
+ * @brief Hébergement de nombreuses sessions MCEE dans un seul processus
+ *
+ * Un MCEEEngine autonome possède ses consommateurs RabbitMQ, son timer de
+ * snapshot et toutes ses dépendances : un utilisateur = un processus.
+ * L'hôte partage au contraire ce qui peut l'être (MLT, lexique de parole,
+ * transport LLM, connexion Neo4j — cf. SharedEngineResources) et ne garde
+ * par session que l'état propre (MCT, MCTGraph, PatternMatcher, état
+ * émotionnel), dans un MCEEEngine en pipeline synchrone.
+ *
+ * Routage : les trois consommateurs lisent la clé de session dans les
+ * en-têtes AMQP (RabbitMQConfig::session_header) et confient le message au
+ * worker hash(clé) % N. Une session n'est donc jamais touchée que par son
+ * worker : ordre des messages conservé, aucun verrou entre sessions.
+ * Chaque worker publie sur son propre channel.
+ *
+ * Grappe (ClusterConfig::enabled) : plusieurs hôtes consomment les mêmes
+ * queues d'entrée. Chaque nœud publie un battement de cœur (identifiant,
+ * poids, charge) et construit un anneau de hachage cohérent (HashRing) des
+ * nœuds vivants ; un message dont la session appartient à un autre nœud lui
+ * est réexpédié sur sa queue mcee.node.<id>. Quand l'anneau change, chaque
+ * worker transfère au nouveau propriétaire les sessions qu'il a perdues
+ * (MCEEEngine::exportSessionState), au tick suivant.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MCEEEngine.hpp"
+#include "HashRing.hpp"
+#include "LockFreeQueue.hpp"
+#include <SimpleAmqpClient/SimpleAmqpClient.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Répartition des sessions entre plusieurs hôtes
+ */
+struct ClusterConfig {
+    bool enabled = false;
+    std::string node_id;                         // Vide : <hostname>-<pid>
+    unsigned weight = 1;                         // Part relative des sessions
+    unsigned virtual_nodes = 64;                 // Points de l'anneau par unité de poids
+    double heartbeat_interval_seconds = 2.0;
+    double node_timeout_seconds = 8.0;           // Nœud sans battement retiré de l'anneau
+    int max_hops = 2;                            // Réexpéditions avant traitement local
+    std::string heartbeat_exchange = "mcee.cluster.heartbeat";  // fanout
+    std::string route_exchange = "mcee.cluster.route";          // direct, clé = node_id
+};
+
+/**
+ * @brief Charge annoncée par un nœud de la grappe
+ */
+struct ClusterNodeLoad {
+    std::string node_id;
+    unsigned weight = 1;
+    size_t sessions = 0;
+    size_t queue_depth = 0;                      // Σ files des workers
+    size_t messages_routed = 0;
+    double last_seen_seconds = 0.0;              // Âge du dernier battement
+};
+
+/**
+ * @brief Configuration de l'hôte multi-session
+ */
+struct MCEEHostConfig {
+    size_t worker_count = 4;                     // Threads de traitement (sessions réparties par hash)
+    size_t worker_queue_capacity = 1024;         // Messages en attente par worker
+    size_t max_sessions = 10000;                 // Au-delà, les nouvelles clés sont refusées
+    std::string default_session = "default";     // Clé des messages sans en-tête de session
+    double session_idle_timeout_seconds = 900.0; // Session inactive libérée (0 : jamais)
+    double tick_interval_seconds = 1.0;          // Cadence des tâches périodiques des workers
+    double footprint_interval_seconds = 30.0;    // Rafraîchissement des empreintes mémoire
+    std::string config_path;                     // Configuration appliquée à chaque nouvelle session
+    std::string record_trace_path;               // Trace des messages traités (SessionTrace ; vide : aucune)
+    ClusterConfig cluster;
+};
+
+/**
+ * @brief Empreinte mémoire d'une session hébergée
+ */
+struct SessionFootprint {
+    std::string session_id;
+    EngineFootprint footprint;
+    size_t messages = 0;                         // Messages traités depuis la création
+    double idle_seconds = 0.0;
+};
+
+/**
+ * @brief Statistiques agrégées de l'hôte
+ */
+struct MCEEHostStats {
+    size_t sessions = 0;
+    size_t sessions_created = 0;
+    size_t sessions_evicted = 0;
+    size_t messages_routed = 0;
+    size_t messages_rejected = 0;                // max_sessions atteint
+    size_t messages_forwarded = 0;               // Réexpédiés au nœud propriétaire
+    size_t sessions_handed_off = 0;              // Transférées à un autre nœud
+    size_t sessions_received = 0;                // Reçues d'un autre nœud
+    size_t session_bytes = 0;                    // Σ empreintes (dernier rafraîchissement)
+    size_t shared_bytes = 0;                     // Lexique partagé (MLT comptée par ses patterns)
+};
+
+/**
+ * @class MCEEHost
+ * @brief Sessions MCEE légères sur un pool de workers partagé
+ */
+class MCEEHost {
+public:
+    explicit MCEEHost(const RabbitMQConfig& rabbitmq_config = RabbitMQConfig{},
+                      const MCEEHostConfig& host_config = MCEEHostConfig{});
+    ~MCEEHost();
+
+    MCEEHost(const MCEEHost&) = delete;
+    MCEEHost& operator=(const MCEEHost&) = delete;
+
+    /**
+     * @brief Connecte Neo4j (si configuré), RabbitMQ, puis démarre workers et consommateurs
+     */
+    bool start();
+
+    /**
+     * @brief Arrête les consommateurs, vide les files des workers puis libère les sessions
+     */
+    void stop();
+
+    [[nodiscard]] bool isRunning() const { return running_.load(); }
+
+    /**
+     * @brief Charge les patterns de la MLT partagée
+     *
+     * Remplace la base commune ; à appeler avant start() (les sessions déjà
+     * ouvertes gardent la base précédente).
+     */
+    bool loadPatterns(const std::string& path);
+
+    /**
+     * @brief Sauvegarde les patterns de la MLT partagée
+     *
+     * Base seule : l'apprentissage des sessions n'y est jamais versé.
+     */
+    bool savePatterns(const std::string& path) const;
+
+    /**
+     * @brief Confie un message au worker de sa session (appelé par les consommateurs)
+     *
+     * Attend si la file du worker est pleine (contre-pression).
+     * @param trace Estampille RabbitMQConfig::trace_header du message (0 : absente)
+     * @return false si l'hôte est arrêté
+     */
+    bool route(const std::string& session_id, MCEEInput input,
+               std::string body, std::string content_type = "", int64_t trace = 0);
+
+    /**
+     * @brief Empreintes par session (dernier rafraîchissement de chaque worker)
+     */
+    [[nodiscard]] std::vector<SessionFootprint> getSessionFootprints() const;
+
+    [[nodiscard]] MCEEHostStats getStats() const;
+
+    /**
+     * @brief Charge des nœuds vivants de la grappe (ce nœud compris)
+     */
+    [[nodiscard]] std::vector<ClusterNodeLoad> getClusterNodes() const;
+
+    [[nodiscard]] const std::string& getNodeId() const { return node_id_; }
+
+    /**
+     * @brief Métriques de l'hôte au format Prometheus (sessions, empreintes)
+     */
+    [[nodiscard]] std::string renderMetrics() const;
+
+    [[nodiscard]] const SharedEngineResources& getSharedResources() const { return shared_; }
+
+private:
+    /**
+     * @brief Message (ou tâche périodique) confié à un worker
+     */
+    struct HostTask {
+        enum class Kind { MESSAGE, TICK, HANDOFF };  // HANDOFF : body = exportSessionState()
+
+        Kind kind = Kind::MESSAGE;
+        MCEEInput input = MCEEInput::EMOTIONS;
+        std::string session_id;
+        std::string body;
+        std::string content_type;
+        int64_t trace = 0;
+    };
+
+    struct Session {
+        std::unique_ptr<MCEEEngine> engine;
+        std::chrono::steady_clock::time_point last_activity;
+        std::chrono::steady_clock::time_point next_graph_tick;
+        size_t messages = 0;
+    };
+
+    /**
+     * @brief Worker : une file, un thread, un channel de publication
+     *
+     * sessions n'est accédé que par le thread du worker ; footprints est
+     * recopié sous footprint_mutex pour les lecteurs externes.
+     */
+    struct Worker {
+        explicit Worker(size_t capacity) : queue(capacity) {}
+
+        BoundedMPSCQueue<HostTask> queue;
+        std::thread thread;
+        AmqpClient::Channel::ptr_t publish_channel;
+        std::unordered_map<std::string, Session> sessions;
+        std::chrono::steady_clock::time_point next_footprint;
+
+        mutable std::mutex footprint_mutex;
+        std::vector<SessionFootprint> footprints;
+    };
+
+    RabbitMQConfig rabbitmq_config_;
+    MCEEHostConfig host_config_;
+    SharedEngineResources shared_;
+    std::shared_ptr<TraceWriter> trace_writer_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> workers_running_{false};
+
+    // Consommateurs (un channel par thread, comme MCEEEngine)
+    AmqpClient::Channel::ptr_t emotions_channel_;
+    AmqpClient::Channel::ptr_t speech_channel_;
+    AmqpClient::Channel::ptr_t tokens_channel_;
+    AmqpClient::Channel::ptr_t metrics_channel_;
+    std::string emotions_consumer_tag_;
+    std::string speech_consumer_tag_;
+    std::string tokens_consumer_tag_;
+    std::thread emotions_consumer_thread_;
+    std::thread speech_consumer_thread_;
+    std::thread tokens_consumer_thread_;
+    std::thread timer_thread_;
+
+    std::atomic<size_t> session_count_{0};
+    std::atomic<size_t> sessions_created_{0};
+    std::atomic<size_t> sessions_evicted_{0};
+    std::atomic<size_t> messages_routed_{0};
+    std::atomic<size_t> messages_rejected_{0};
+
+    // Grappe : anneau lu par les consommateurs et les workers, membres tenus
+    // par le thread de grappe (recopiés sous ring_mutex_ pour getClusterNodes)
+    std::string node_id_;
+    AmqpClient::Channel::ptr_t cluster_channel_;
+    AmqpClient::Channel::ptr_t node_channel_;
+    std::string heartbeat_consumer_tag_;
+    std::string node_consumer_tag_;
+    std::thread cluster_thread_;
+    std::thread node_consumer_thread_;
+    std::atomic<bool> ingress_ready_{false};
+
+    mutable std::mutex ring_mutex_;
+    std::shared_ptr<const HashRing> ring_;
+    std::unordered_map<std::string, std::pair<ClusterNodeLoad, std::chrono::steady_clock::time_point>> members_;
+    std::vector<ClusterNodeLoad> members_view_;
+
+    std::atomic<size_t> messages_forwarded_{0};
+    std::atomic<size_t> sessions_handed_off_{0};
+    std::atomic<size_t> sessions_received_{0};
+
+    bool initRabbitMQ();
+    bool initCluster(const AmqpClient::Channel::OpenOpts& opts);
+
+    /**
+     * @brief Consomme une queue par lots et route chaque message vers son worker
+     * @param input Flux de la queue ; absent pour la queue de nœud (flux lu
+     *              dans l'en-tête posé par forward)
+     */
+    void consumeLoop(const AmqpClient::Channel::ptr_t& channel, const std::string& consumer_tag,
+                     std::optional<MCEEInput> input, const std::string& label);
+
+    /**
+     * @brief Traite localement ou réexpédie un message selon l'anneau
+     */
+    void dispatch(const AmqpClient::Channel::ptr_t& channel, const AmqpClient::BasicMessage::ptr_t& message,
+                  std::optional<MCEEInput> input);
+
+    /**
+     * @brief Publie un message (ou un transfert de session) sur la queue d'un nœud
+     * @param kind "emotions", "speech", "tokens" ou "handoff"
+     * @param trace Estampille du message d'origine, recopiée (0 : aucune)
+     */
+    void forward(const AmqpClient::Channel::ptr_t& channel, const std::string& node_id,
+                 const std::string& session_id, const std::string& kind, std::string body,
+                 const std::string& content_type, int hops, int64_t trace = 0);
+
+    /**
+     * @brief Battements de cœur : publication, réception, expiration, anneau
+     */
+    void clusterLoop();
+    void publishHeartbeat(bool leaving);
+    void rebuildRing();
+
+    [[nodiscard]] std::shared_ptr<const HashRing> currentRing() const;
+
+    /**
+     * @brief Vrai si la session revient à ce nœud (toujours hors grappe)
+     */
+    [[nodiscard]] bool ownsSession(const HashRing* ring, const std::string& session_id) const;
+
+    /**
+     * @brief Transfère les sessions qui n'appartiennent plus à ce nœud
+     */
+    void handOffSessions(Worker& worker, const HashRing& ring);
+
+    /**
+     * @brief Boucle d'un worker : messages, ticks (graphes, inactivité, empreintes)
+     */
+    void workerLoop(Worker& worker);
+
+    /**
+     * @brief Envoie un TICK à chaque worker ; publie les métriques de l'hôte
+     */
+    void timerLoop();
+
+    /**
+     * @brief Session existante ou créée (thread du worker uniquement)
+     * @return nullptr si max_sessions est atteint
+     */
+    Session* acquireSession(Worker& worker, const std::string& session_id);
+
+    void deliver(Session& session, const HostTask& task);
+    void tick(Worker& worker);
+
+    /**
+     * @brief Clé de session lue dans les en-têtes, default_session sinon
+     */
+    std::string sessionKey(const AmqpClient::BasicMessage::ptr_t& message) const;
+
+    Worker& workerFor(const std::string& session_id);
+};
+
+} // namespace mcee
@@ -13,8 +13,10 @@
 #pragma once
 
 #include "Types.hpp"
+#include "RingBuffer.hpp"
 #include <nlohmann/json.hpp>
 #include <deque>
+#include <cstdint>
 #include <vector>
 #include <chrono>
 #include <mutex>
@@ -33,9 +35,9 @@ struct TimestampedState {
     double speech_arousal{0.0};        // Arousal associé
     std::string context;               // Contexte textuel optionnel
     
-    TimestampedState() : timestamp(std::chrono::steady_clock::now()) {}
+    TimestampedState() : timestamp(SessionClock::now()) {}
     TimestampedState(const EmotionalState& s) 
-        : state(s), timestamp(std::chrono::steady_clock::now()) {}
+        : state(s), timestamp(SessionClock::now()) {}
 };
 
 /**
@@ -223,7 +225,12 @@ public:
     size_t size() const;
     bool empty() const;
     const MCTConfig& getConfig() const { return config_; }
-    void setConfig(const MCTConfig& config) { config_ = config; }
+
+    /**
+     * @brief Taille approximative en mémoire (octets, tampons compris)
+     */
+    size_t memoryUsage() const;
+    void setConfig(const MCTConfig& config);
     
     // ═══════════════════════════════════════════════════════════════
     // CALLBACKS
@@ -245,8 +252,49 @@ public:
     void fromJson(const nlohmann::json& j);
     
 private:
+    /**
+     * @brief Données incrémentales associées à chaque entrée du buffer
+     */
+    struct EntryStats {
+        std::array<double, 24> cumulative{};   // Somme préfixe des émotions (jusqu'à cette entrée incluse)
+        double weight_factor{1.0};             // exp((t - t_ref) / demi-vie)
+        uint32_t oscillation_mask{0};          // Bit i : changement de direction sur l'émotion i (bit 24 : E_global)
+    };
+
+    /**
+     * @brief Accumulateurs glissants (mis à jour en O(24) par push/pop)
+     *
+     * Sommes et sommes de carrés pour moyenne / variance, sommes pondérées
+     * par un facteur exponentiel relatif à ref_time pour la moyenne
+     * temporelle, et accumulateurs de régression pour la tendance. Une
+     * resynchronisation complète périodique borne la dérive numérique.
+     */
+    struct RunningStats {
+        std::array<double, 24> sum{};
+        std::array<double, 24> sum_sq{};
+        std::array<double, 24> weighted_sum{};
+        double weight_total{0.0};
+        double sum_e{0.0};                     // Σ E_global
+        double sum_seq_e{0.0};                 // Σ seq × E_global (seq relatif à seq_base)
+        std::array<double, 24> prefix_base{};  // Somme préfixe avant le front
+        std::array<int, 24> oscillations{};    // Oscillations (positions ≥ 2)
+        int global_oscillations{0};
+        std::chrono::steady_clock::time_point ref_time;
+        uint64_t seq_base{0};                  // Numéro de séquence de référence
+        uint64_t front_seq{0};                 // Numéro de séquence du front
+        size_t pushes_since_resync{0};
+    };
+
     MCTConfig config_;
-    std::deque<TimestampedState> buffer_;
+    RingBuffer<TimestampedState> buffer_;
+    RingBuffer<EntryStats> entry_stats_;
+    RunningStats stats_;
+
+    // Fenêtres glissantes du maximum par émotion (numéros de séquence, valeurs décroissantes)
+    std::array<RingBuffer<uint64_t>, 24> peak_windows_;
+
+    bool resyncing_{false};
+
     mutable std::mutex mutex_;
     
     // Callbacks
@@ -262,6 +310,30 @@ private:
     void invalidateCache();
     double computeWeight(const std::chrono::steady_clock::time_point& timestamp) const;
     std::array<double, 24> computeVelocity() const;
+    MCTIntegration integrateLocked() const;
+
+    /**
+     * @brief Ajoute une entrée et met à jour les accumulateurs (mutex_ tenu)
+     */
+    void appendLocked(TimestampedState ts);
+
+    /**
+     * @brief Retire l'entrée la plus ancienne et ses contributions (mutex_ tenu)
+     */
+    void popFrontLocked();
+
+    /**
+     * @brief Recalcule tous les accumulateurs depuis le buffer (mutex_ tenu)
+     */
+    void resyncLocked();
+
+    /**
+     * @brief Redimensionne les tampons selon config_.max_size (mutex_ tenu)
+     */
+    void applyCapacityLocked();
+
+    double halfLife() const;
+    double segmentMean(size_t emotion, size_t begin, size_t end) const;
 
     /**
      * @brief Sanitize un état émotionnel (clamp valeurs, corrige anomalies)
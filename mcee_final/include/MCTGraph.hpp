@@ -1,10 +1,16 @@
 #pragma once
 
 #include "Types.hpp"
+#include "CowVector.hpp"
+#include "LemmaTable.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <chrono>
+#include <deque>
 #include <mutex>
 #include <atomic>
 #include <functional>
@@ -43,6 +49,9 @@ struct MCTGraphConfig {
 
     // Seuil de causalité étendu pour émotions lentes (tristesse, nostalgie)
     double slow_emotion_causality_threshold_ms = 800.0;
+
+    // Publication par deltas : un message sur N est une keyframe complète (0 = toujours)
+    size_t delta_keyframe_interval = 10;
 };
 
 // ============================================================================
@@ -66,10 +75,10 @@ enum class EdgeType {
 
 struct WordNode {
     std::string id;                    // Identifiant unique
-    std::string lemma;                 // Forme lemmatisée
-    std::string pos;                   // Catégorie grammaticale (NOUN, VERB, ADJ...)
+    LemmaId lemma = NO_LEMMA;          // Forme lemmatisée (LemmaTable)
+    LemmaId pos = NO_LEMMA;            // Catégorie grammaticale (NOUN, VERB, ADJ...)
+    LemmaId original_form = NO_LEMMA;  // Forme originale du mot
     std::string sentence_id;           // ID de la phrase source
-    std::string original_form;         // Forme originale du mot
 
     std::chrono::steady_clock::time_point timestamp;
 
@@ -78,6 +87,10 @@ struct WordNode {
     bool is_negation = false;          // Mot de négation
     bool is_intensifier = false;       // Mot intensificateur
 
+    std::string_view lemmaText() const { return LemmaTable::instance().text(lemma); }
+    std::string_view posText() const { return LemmaTable::instance().text(pos); }
+    std::string_view originalText() const { return LemmaTable::instance().text(original_form); }
+
     nlohmann::json toJson() const;
     static WordNode fromJson(const nlohmann::json& j);
 };
@@ -153,7 +166,7 @@ struct MCTGraphSnapshot {
 
         double average_emotion_intensity = 0.0;
         std::string most_frequent_emotion;
-        std::vector<std::string> top_trigger_words;  // Mots causant le plus d'émotions
+        std::vector<std::string> top_trigger_words;  // Lemmes de plus forte causalité moyenne
 
         double graph_density = 0.0;    // Densité du graphe
         double time_span_seconds = 0.0; // Étendue temporelle couverte
@@ -163,6 +176,51 @@ struct MCTGraphSnapshot {
     static MCTGraphSnapshot fromJson(const nlohmann::json& j);
 };
 
+// ============================================================================
+// Delta de graphe pour la publication incrémentale
+// ============================================================================
+
+/**
+ * @brief Modifications du graphe entre deux séquences
+ *
+ * Un delta s'applique à l'état de `base_sequence` : retraits d'abord, puis
+ * insertions / mises à jour. Une keyframe porte le graphe entier et
+ * remplace l'état du consommateur. Les poids d'arêtes sont exprimés à
+ * l'époque `decay_epoch` ; une arête absente du delta a perdu
+ * facteur^(écart d'époques) depuis sa dernière transmission.
+ */
+struct MCTGraphDelta {
+    uint64_t sequence = 0;
+    uint64_t base_sequence = 0;        // 0 pour une keyframe
+    bool keyframe = false;
+
+    std::string snapshot_id;
+    std::chrono::system_clock::time_point timestamp;
+
+    // Nœuds et arêtes ajoutés ou modifiés (tout le graphe pour une keyframe)
+    std::vector<WordNode> word_nodes;
+    std::vector<EmotionNode> emotion_nodes;
+    std::vector<GraphEdge> edges;
+
+    // Retraits (élagage, décroissance, remplacement)
+    std::vector<std::string> removed_node_ids;
+    std::vector<std::string> removed_edge_ids;
+
+    uint32_t decay_epoch = 0;
+    double edge_decay_factor = 1.0;
+
+    // Statistiques du graphe complet à cette séquence
+    MCTGraphSnapshot::Statistics stats;
+
+    [[nodiscard]] size_t changeCount() const {
+        return word_nodes.size() + emotion_nodes.size() + edges.size() +
+               removed_node_ids.size() + removed_edge_ids.size();
+    }
+
+    nlohmann::json toJson() const;
+    static MCTGraphDelta fromJson(const nlohmann::json& j);
+};
+
 // ============================================================================
 // Résultat d'analyse causale
 // ============================================================================
@@ -199,11 +257,17 @@ public:
     // Ajout de nœuds
     // ========================================================================
 
-    /// Ajoute un mot extrait par Neo4j/spaCy
-    std::string addWord(const std::string& lemma,
-                        const std::string& pos,
-                        const std::string& sentence_id,
-                        const std::string& original_form = "");
+    /**
+     * @brief Ajoute un mot extrait par Neo4j/spaCy
+     *
+     * Lemme, forme et catégorie sont internés (LemmaTable) : une recherche
+     * de hachage chacun, propriétés lexicales (négation, intensificateur,
+     * score émotionnel par défaut) lues sur l'entrée de la table.
+     */
+    std::string addWord(std::string_view lemma,
+                        std::string_view pos,
+                        std::string_view sentence_id,
+                        std::string_view original_form = {});
 
     /// Ajoute un mot depuis un message JSON (format Neo4j)
     std::string addWordFromJson(const nlohmann::json& word_data);
@@ -237,6 +301,18 @@ public:
                                  const std::string& relation_type,
                                  double weight = -1.0);
 
+    /**
+     * @brief Relie sémantiquement toutes les occurrences de deux lemmes
+     *
+     * Occurrences lues dans l'index par lemme (sans parcours du graphe) ;
+     * le nombre d'arêtes est le produit des deux nombres d'occurrences.
+     * @return Nombre d'arêtes créées
+     */
+    size_t addSemanticEdgesByLemma(std::string_view lemma1,
+                                   std::string_view lemma2,
+                                   const std::string& relation_type,
+                                   double weight = -1.0);
+
     // ========================================================================
     // Détection automatique de causalité
     // ========================================================================
@@ -257,8 +333,18 @@ public:
     /// Récupère toutes les émotions déclenchées par un mot
     std::vector<EmotionNode> getTriggeredEmotions(const std::string& word_id) const;
 
-    /// Analyse causale globale
-    std::vector<CausalAnalysis> analyzeCausality() const;
+    /**
+     * @brief Analyse causale, par force moyenne décroissante
+     *
+     * Lue sur les agrégats maintenus à chaque insertion / libération d'arête :
+     * O(k log k) plus l'adjacence des k sources rendues, quelle que soit la
+     * taille du graphe.
+     *
+     * @param max_results Nombre maximal de sources rendues (k)
+     * @param min_strength Force minimale : le parcours s'arrête en deçà
+     */
+    std::vector<CausalAnalysis> analyzeCausality(size_t max_results = SIZE_MAX,
+                                                 double min_strength = 0.0) const;
 
     /// Récupère les voisins d'un nœud
     std::vector<std::string> getNeighbors(const std::string& node_id,
@@ -270,6 +356,12 @@ public:
     /// Récupère un nœud mot par ID
     std::optional<WordNode> getWordNode(const std::string& id) const;
 
+    /// IDs des occurrences vivantes d'un lemme (index lemme → nœuds, sans balayage)
+    std::vector<std::string> findWordsByLemma(std::string_view lemma) const;
+
+    /// Nombre d'occurrences vivantes d'un lemme, O(1)
+    size_t getLemmaCount(std::string_view lemma) const;
+
     /// Récupère un nœud émotion par ID
     std::optional<EmotionNode> getEmotionNode(const std::string& id) const;
 
@@ -277,12 +369,24 @@ public:
     // Maintenance du graphe
     // ========================================================================
 
-    /// Supprime les nœuds expirés (hors fenêtre temporelle)
-    size_t pruneExpiredNodes();
+    /// Supprime les nœuds expirés (hors fenêtre temporelle), au plus max_nodes
+    size_t pruneExpiredNodes(size_t max_nodes = SIZE_MAX);
 
     /// Applique la décroissance temporelle aux poids des arêtes
+    /// (O(1) : incrémente l'époque de décroissance, cf. maintenanceStep)
     void applyEdgeDecay();
 
+    /**
+     * @brief Tranche bornée de maintenance de fond
+     *
+     * Élague au plus `budget` nœuds expirés puis examine au plus `budget`
+     * arêtes pour libérer celles que la décroissance a fait passer sous
+     * le seuil. Le verrou n'est tenu que le temps de la tranche.
+     *
+     * @return true s'il reste du travail (rappeler après avoir rendu la main)
+     */
+    bool maintenanceStep(size_t budget);
+
     /// Nettoie le graphe complet
     void clear();
 
@@ -290,9 +394,31 @@ public:
     // Export et snapshots
     // ========================================================================
 
-    /// Génère un snapshot de l'état actuel du graphe
+    class View;
+
+    /**
+     * @brief Capture une vue figée du graphe
+     *
+     * Coût O(pages) sous le verrou : la vue partage les pages des pools
+     * (copie sur écriture), l'ingestion reprend aussitôt.
+     */
+    View captureView() const;
+
+    /// Génère un snapshot de l'état actuel du graphe (capture + rendu hors verrou)
     MCTGraphSnapshot createSnapshot() const;
 
+    /**
+     * @brief Delta depuis la capture précédente
+     *
+     * Sous le verrou : copie des seuls nœuds / arêtes modifiés, O(changements).
+     * Keyframe à la première capture, tous les delta_keyframe_interval
+     * messages, après clear()/loadFromJson, ou quand le journal dépasse la
+     * taille du graphe.
+     *
+     * @param force_keyframe Publie le graphe entier quoi qu'il arrive
+     */
+    MCTGraphDelta captureDelta(bool force_keyframe = false);
+
     /// Exporte le graphe en JSON
     nlohmann::json toJson() const;
 
@@ -324,21 +450,138 @@ public:
     /// Retourne la densité du graphe
     double getGraphDensity() const;
 
+    /// Taille approximative en mémoire (octets : pools, index, journal ; LemmaTable partagée exclue)
+    size_t memoryUsage() const;
+
     /// Retourne la configuration
     const MCTGraphConfig& getConfig() const { return config_; }
 
 private:
-    MCTGraphConfig config_;
+    // ========================================================================
+    // Cœur compact du graphe
+    //
+    // Les nœuds et arêtes sont désignés en interne par des handles 32 bits
+    // denses (index dans des slabs réutilisés via free-list). Les IDs texte
+    // ne sont résolus qu'à la frontière JSON/RabbitMQ : table d'internement
+    // node_ids_ pour les requêtes par ID, et rendu à la demande des IDs
+    // d'arêtes (EDGE_<ms>_<seq>) dans toJson / createSnapshot.
+    //
+    // Les pools (nœuds, arêtes, chaînes) sont des CowVector : captureView()
+    // fige leur table de pages, et une écriture ultérieure duplique la seule
+    // page touchée. Les poids d'arête sont stockés à leur époque de
+    // décroissance : poids effectif = weight × facteur^(époque − decay_epoch).
+    // ========================================================================
 
-    // Stockage des nœuds
-    std::unordered_map<std::string, WordNode> word_nodes_;
-    std::unordered_map<std::string, EmotionNode> emotion_nodes_;
+    using NodeHandle = uint32_t;
+    using EdgeHandle = uint32_t;
+    static constexpr uint32_t INVALID_HANDLE = UINT32_MAX;
+    static constexpr uint32_t NO_NAME = UINT32_MAX;
+    static constexpr double EDGE_RELEASE_WEIGHT = 0.01;   // Sous ce poids, l'arête est libérée
+    static constexpr uint32_t TALLY_REBASE_EPOCHS = 32;   // Écart max entre tally_epoch_ et decay_epoch_
+    static constexpr size_t TOP_TRIGGER_WORDS = 5;        // Lemmes de Statistics::top_trigger_words
+    static constexpr size_t TOP_TRIGGER_SCAN = 32;        // Sources examinées pour les trouver
+
+    struct NodeSlot {
+        NodeType type = NodeType::WORD;
+        bool alive = false;
+        uint32_t payload = 0;                  // Index dans words_ / emotions_
+        std::vector<EdgeHandle> edges;         // Adjacence (capacité conservée au recyclage)
+
+        // Arêtes CAUSAL sortantes vivantes : nombre, somme des poids à
+        // l'époque tally_epoch_, position dans causal_rank_
+        uint32_t causal_out = 0;
+        uint32_t rank_pos = INVALID_HANDLE;
+        double causal_weight = 0.0;
+    };
+
+    struct EdgeRecord {
+        NodeHandle source = INVALID_HANDLE;
+        NodeHandle target = INVALID_HANDLE;
+        EdgeType type = EdgeType::TEMPORAL;
+        bool alive = false;
+        uint32_t relation = NO_NAME;           // Relation sémantique internée
+        uint32_t name = NO_NAME;               // ID externe interné (arêtes chargées depuis JSON)
+        uint32_t decay_epoch = 0;              // Époque de décroissance de `weight`
+        uint64_t seq = 0;                      // Numéro pour le rendu de l'ID
+        double weight = 0.0;
+        double temporal_distance_ms = 0.0;
+        std::chrono::steady_clock::time_point created_at;
+    };
+
+    /// Table d'internement de chaînes (relations, IDs d'arêtes importés)
+    struct StringTable {
+        CowVector<std::string> strings;
+        std::unordered_map<std::string, uint32_t> index;
+
+        uint32_t intern(const std::string& s);
+        const std::string& at(uint32_t id) const { return strings[id]; }
+        void clear() { strings.clear(); index.clear(); }
+    };
 
-    // Stockage des arêtes (par ID)
-    std::unordered_map<std::string, GraphEdge> edges_;
+    MCTGraphConfig config_;
 
-    // Index d'adjacence (node_id → liste d'edge_ids)
-    std::unordered_map<std::string, std::vector<std::string>> adjacency_;
+    // Slab des nœuds (handle → slot) et pools denses par type
+    std::vector<NodeSlot> slots_;
+    std::vector<NodeHandle> free_slots_;
+    CowVector<WordNode> words_;
+    CowVector<NodeHandle> word_handles_;            // words_[i] ↔ slot word_handles_[i]
+    CowVector<EmotionNode> emotions_;
+    CowVector<NodeHandle> emotion_handles_;
+
+    // Internement des IDs de nœuds (frontière API / JSON)
+    std::unordered_map<std::string, NodeHandle> node_ids_;
+
+    // Occurrences vivantes de chaque lemme (ordre quelconque)
+    std::unordered_map<LemmaId, std::vector<NodeHandle>> lemma_index_;
+
+    // Slab des arêtes
+    CowVector<EdgeRecord> edges_;
+    std::vector<EdgeHandle> free_edges_;
+    size_t edge_count_ = 0;
+
+    // Décroissance paresseuse et balayage incrémental des arêtes affaiblies
+    uint32_t decay_epoch_ = 0;
+    EdgeHandle sweep_cursor_ = 0;
+    bool sweep_pending_ = false;
+
+    // Agrégats maintenus à chaque insertion / retrait (statistiques sans
+    // balayage). La décroissance multiplie tous les poids par le même
+    // facteur : l'ordre des sources causales n'en dépend pas, seules les
+    // sommes sont exprimées à l'époque de référence tally_epoch_ (rebasée
+    // tous les TALLY_REBASE_EPOCHS).
+    std::array<size_t, 3> edge_type_counts_{};
+    double emotion_intensity_sum_ = 0.0;
+    std::unordered_map<std::string, size_t> dominant_counts_;
+    std::vector<NodeHandle> causal_rank_;           // Tas max indexé : force causale moyenne
+    uint32_t tally_epoch_ = 0;
+
+    // Journal des modifications depuis le dernier delta (marques par
+    // génération : un handle n'est listé qu'une fois par delta)
+    std::vector<NodeHandle> dirty_nodes_;
+    std::vector<EdgeHandle> dirty_edges_;
+    std::vector<uint64_t> node_marks_;
+    std::vector<uint64_t> edge_marks_;
+    std::vector<std::string> removed_node_ids_;
+    std::vector<std::string> removed_edge_ids_;
+    uint64_t delta_sequence_ = 0;
+    uint64_t last_keyframe_sequence_ = 0;
+    bool resync_ = true;                            // Prochain delta : keyframe
+
+    StringTable names_;
+
+    // Index temporel par type (trié par timestamp, plus ancien en tête) :
+    // fenêtres de causalité / co-occurrence par recherche dichotomique,
+    // élagage par dépilement depuis la tête
+    struct TimeEntry {
+        std::chrono::steady_clock::time_point timestamp;
+        NodeHandle handle = INVALID_HANDLE;
+    };
+    std::deque<TimeEntry> word_timeline_;
+    std::deque<TimeEntry> emotion_timeline_;
+
+    // Marquage par époque (tests d'existence d'arête sans allocation)
+    mutable std::vector<uint32_t> visit_marks_;
+    mutable uint32_t visit_epoch_ = 0;
 
     // Compteur pour génération d'IDs
     mutable std::atomic<uint64_t> id_counter_{0};
@@ -357,7 +600,65 @@ private:
     // Méthodes privées
     // ========================================================================
 
-    std::string generateId(const std::string& prefix) const;
+    std::string generateId(std::string_view prefix) const;
+
+    // Accès par handle (mutex déjà verrouillé)
+    NodeHandle findNode(const std::string& id) const;
+    NodeHandle allocateSlot(NodeType type, uint32_t payload);
+    NodeHandle insertWordLocked(WordNode node);
+    NodeHandle insertEmotionLocked(EmotionNode node);
+    void removeNodeLocked(NodeHandle handle);
+    void indexTimeLocked(NodeHandle handle);
+    void unindexTimeLocked(NodeHandle handle);
+    std::deque<TimeEntry>& timelineOf(NodeHandle h) {
+        return isWord(h) ? word_timeline_ : emotion_timeline_;
+    }
+
+    WordNode& wordAt(NodeHandle h) { return words_.mut(slots_[h].payload); }
+    const WordNode& wordAt(NodeHandle h) const { return words_[slots_[h].payload]; }
+    EmotionNode& emotionAt(NodeHandle h) { return emotions_.mut(slots_[h].payload); }
+    const EmotionNode& emotionAt(NodeHandle h) const { return emotions_[slots_[h].payload]; }
+    const std::string& nodeId(NodeHandle h) const;
+    std::chrono::steady_clock::time_point nodeTimestamp(NodeHandle h) const;
+    bool isWord(NodeHandle h) const { return slots_[h].type == NodeType::WORD; }
+
+    void markNodeDirty(NodeHandle h);
+    void markEdgeDirty(EdgeHandle e);
+    void checkChangeLogLocked();
+    void resetChangeLogLocked();
+    View captureViewLocked() const;
+
+    EdgeHandle insertEdgeLocked(NodeHandle source, NodeHandle target, EdgeType type,
+                                double weight, double temporal_distance_ms);
+    void releaseEdgeLocked(EdgeHandle e);
+
+    // Agrégats incrémentaux (mutex déjà verrouillé)
+    void tallyEdgeLocked(const EdgeRecord& edge, bool added);
+    void tallyEmotionLocked(const EmotionNode& node, bool added);
+    void rebaseTalliesLocked();
+    double tallyWeight(const EdgeRecord& edge) const;
+    double tallyScale() const;
+    double causalKey(NodeHandle h) const {
+        return slots_[h].causal_weight / static_cast<double>(slots_[h].causal_out);
+    }
+    void rankUpdateLocked(NodeHandle h);
+    void rankSwap(size_t a, size_t b);
+    std::vector<NodeHandle> topCausalSourcesLocked(size_t k, double min_strength) const;
+    MCTGraphSnapshot::Statistics statisticsLocked() const;
+    std::string edgeId(EdgeHandle e) const;
+    double edgeWeight(const EdgeRecord& edge) const {
+        return effectiveWeight(edge, decay_epoch_, config_.edge_decay_factor);
+    }
+
+    static std::string recordId(const EdgeRecord& edge, const CowVector<std::string>& names);
+    static double effectiveWeight(const EdgeRecord& edge, uint32_t epoch, double factor);
+    static GraphEdge materializeRecord(const EdgeRecord& record, const std::string& source_id,
+                                       const std::string& target_id,
+                                       const CowVector<std::string>& names, double weight);
+
+    size_t pruneExpiredLocked(size_t max_nodes = SIZE_MAX);
+    void clearLocked();
+    uint32_t nextVisitEpoch() const;
 
     double calculateCausalWeight(const WordNode& word,
                                   const EmotionNode& emotion) const;
@@ -369,15 +670,55 @@ private:
     bool isWithinCausalityWindow(const WordNode& word,
                                   const EmotionNode& emotion) const;
 
-    void removeEdgesForNode(const std::string& node_id);
-
-    void updateAdjacency(const std::string& edge_id,
-                          const std::string& source_id,
-                          const std::string& target_id);
-
-    void computeSnapshotStatistics(MCTGraphSnapshot& snapshot) const;
 
     std::string findDominantEmotion(const std::array<double, 24>& emotions) const;
+
+public:
+    /**
+     * @class View
+     * @brief État figé du graphe, lisible sans verrou depuis un autre thread
+     *
+     * Les statistiques et le rendu portent sur un seul et même état : celui
+     * de la capture, quelles que soient les ingestions qui ont suivi.
+     */
+    class View {
+    public:
+        /// Matérialise le snapshot (IDs d'arêtes, statistiques) hors verrou
+        MCTGraphSnapshot toSnapshot() const;
+
+        /// Nœuds et arêtes au format de MCTGraph::toJson (sans la configuration)
+        nlohmann::json toJson() const;
+
+        /// Statistiques figées à la capture (agrégats du graphe, sans balayage)
+        const MCTGraphSnapshot::Statistics& statistics() const { return stats_; }
+
+        size_t getWordCount() const { return words_.size(); }
+        size_t getEmotionCount() const { return emotions_.size(); }
+        size_t getEdgeCount() const { return edge_count_; }
+
+    private:
+        friend class MCTGraph;
+
+        std::string snapshot_id_;
+        std::chrono::system_clock::time_point captured_at_;
+
+        CowVector<WordNode> words_;
+        CowVector<NodeHandle> word_handles_;
+        CowVector<EmotionNode> emotions_;
+        CowVector<NodeHandle> emotion_handles_;
+        CowVector<EdgeRecord> edges_;
+        CowVector<std::string> names_;
+        size_t slot_count_ = 0;
+        size_t edge_count_ = 0;
+        uint32_t decay_epoch_ = 0;
+        double decay_factor_ = 1.0;
+        MCTGraphSnapshot::Statistics stats_;
+
+        /// Handle → ID de nœud (table dense sur les slots de la capture)
+        std::vector<const std::string*> nodeIds() const;
+        GraphEdge materializeEdge(const EdgeRecord& record,
+                                  const std::vector<const std::string*>& ids) const;
+    };
 };
 
 // ============================================================================
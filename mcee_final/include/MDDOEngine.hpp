@@ -23,11 +23,16 @@
 
 #include "Types.hpp"
 #include "MemoryManager.hpp"
+#include "Executor.hpp"
+#include "RingBuffer.hpp"
 #include <string>
 #include <vector>
 #include <array>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <chrono>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -176,6 +181,11 @@ struct MDDOState {
  *         │                     │
  *         ▼                     ▼
  *   [Veto Amyghaleon?] ──► ActionIntention
+ *
+ * deliberateAsync confie la délibération à l'Executor partagé (voie PIPELINE
+ * de largeur 1) et rend la main immédiatement. Chaque phase, et chaque
+ * option simulée, est un point d'annulation : interrupt() coupe la
+ * délibération en cours au prochain point, sans attendre sa fin.
  */
 class MDDOEngine {
 public:
@@ -188,9 +198,12 @@ public:
     explicit MDDOEngine(const MDDOConfig& config = MDDOConfig());
 
     /**
-     * @brief Destructeur
+     * @brief Destructeur (annule et attend la délibération en cours)
      */
-    ~MDDOEngine() = default;
+    ~MDDOEngine();
+
+    MDDOEngine(const MDDOEngine&) = delete;
+    MDDOEngine& operator=(const MDDOEngine&) = delete;
 
     // ═══════════════════════════════════════════════════════════════════════
     // INTERFACE PRINCIPALE
@@ -199,23 +212,50 @@ public:
     /**
      * @brief Traite une situation et génère une intention d'action
      * @param situation Le cadre situationnel perçu
-     * @return L'intention d'action résultante
+     * @return L'intention d'action résultante (l'action d'urgence si
+     *         interrupt() est appelé pendant la délibération)
      */
     ActionIntention deliberate(const SituationFrame& situation);
 
     /**
-     * @brief Traite une situation de manière asynchrone
+     * @brief Traite une situation de manière asynchrone (non bloquant)
+     *
+     * Une requête encore en attente est remplacée par la nouvelle ; celle
+     * déjà en cours se termine normalement.
+     *
      * @param situation Le cadre situationnel perçu
-     * @param callback Fonction appelée avec le résultat
+     * @param callback Fonction appelée avec le résultat (worker de l'Executor)
+     * @return Identifiant de la requête (pour waitForIntention)
      */
-    void deliberateAsync(const SituationFrame& situation, IntentionCallback callback);
+    uint64_t deliberateAsync(const SituationFrame& situation, IntentionCallback callback);
+
+    /**
+     * @brief Attend le résultat d'une requête asynchrone
+     * @param request_id Identifiant rendu par deliberateAsync
+     * @param timeout_ms Délai d'attente ; par défaut le temps de délibération
+     *                   τ calculé pour l'urgence de la situation
+     * @return L'intention (ou celle d'une requête plus récente / d'urgence),
+     *         std::nullopt si le délai expire
+     */
+    std::optional<ActionIntention> waitForIntention(uint64_t request_id,
+                                                    std::optional<double> timeout_ms = std::nullopt);
 
     /**
      * @brief Interrompt la délibération en cours (appel d'urgence)
+     *
+     * Ne bloque pas : l'intention d'urgence est livrée immédiatement au
+     * callback, la délibération en cours s'arrête à son prochain point
+     * d'annulation et son résultat est abandonné.
+     *
      * @param emergency_action Action d'urgence à exécuter
      */
     void interrupt(const ActionOption& emergency_action);
 
+    /**
+     * @brief Vrai si une délibération asynchrone est en cours ou en attente
+     */
+    [[nodiscard]] bool isDeliberating() const;
+
     // ═══════════════════════════════════════════════════════════════════════
     // CONFIGURATION
     // ═══════════════════════════════════════════════════════════════════════
@@ -241,9 +281,9 @@ public:
     const MDDOConfig& getConfig() const { return config_; }
 
     /**
-     * @brief Obtient l'état actuel
+     * @brief Obtient une copie de l'état actuel
      */
-    const MDDOState& getState() const { return state_; }
+    MDDOState getState() const;
 
 private:
     // ═══════════════════════════════════════════════════════════════════════
@@ -264,10 +304,13 @@ private:
     /**
      * @brief Phase 3 : Génération et simulation des options
      * Utilise Monte-Carlo pour évaluer les conséquences
+     * @param epoch Époque d'interruption au lancement (point d'annulation par option)
+     * @return Options triées, ou std::nullopt si interrompu
      */
-    std::vector<ActionOption> simulate(
+    std::optional<std::vector<ActionOption>> simulate(
         const SituationFrame& situation,
-        const std::vector<Memory>& memories);
+        const std::vector<Memory>& memories,
+        uint64_t epoch);
 
     /**
      * @brief Phase 4 : Arbitrage final
@@ -294,7 +337,7 @@ private:
     /**
      * @brief Vérifie si l'Amyghaleon pose un veto
      */
-    bool checkVeto(const ActionOption& option);
+    bool checkVeto(const ActionOption& option, const SituationFrame& situation);
 
     /**
      * @brief Calcule le temps de délibération basé sur l'urgence
@@ -306,23 +349,75 @@ private:
      */
     double detectConflict(const std::vector<ActionOption>& options) const;
 
+    // ═══════════════════════════════════════════════════════════════════════
+    // DÉLIBÉRATION ASYNCHRONE
+    // ═══════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Les 4 phases, avec points d'annulation
+     * @return std::nullopt si interrupt() a été appelé depuis epoch
+     */
+    std::optional<ActionIntention> runDeliberation(const SituationFrame& situation, uint64_t epoch);
+
+    /**
+     * @brief Vrai si interrupt() a été appelé depuis epoch
+     */
+    [[nodiscard]] bool isCancelled(uint64_t epoch) const {
+        return interrupt_epoch_.load(std::memory_order_acquire) != epoch;
+    }
+
+    /**
+     * @brief Construit l'intention d'urgence
+     */
+    static ActionIntention makeEmergencyIntention(const ActionOption& emergency_action);
+
+    /**
+     * @brief Publie un résultat asynchrone (réveille les waitForIntention)
+     * @param epoch Époque au lancement : résultat abandonné si interrompu
+     */
+    void publishResult(const ActionIntention& intention, uint64_t request_id, uint64_t epoch);
+
+    /**
+     * @brief Tâche de délibération : traite les requêtes jusqu'à épuisement
+     */
+    void drainPending();
+
     // ═══════════════════════════════════════════════════════════════════════
     // DONNÉES MEMBRES
     // ═══════════════════════════════════════════════════════════════════════
 
     MDDOConfig config_;
     MDDOState state_;
+    mutable std::mutex state_mutex_;      // state_ et decision_history_
 
     MemoryManager* memory_manager_ = nullptr;
     VetoCallback veto_callback_;
     IntentionCallback intention_callback_;
 
+    // Délibération asynchrone : une requête en attente au plus (la plus récente)
+    struct PendingRequest {
+        SituationFrame situation;
+        uint64_t id = 0;
+    };
+    mutable std::mutex async_mutex_;
+    std::condition_variable result_cv_;
+    std::optional<PendingRequest> pending_;
+    bool in_flight_ = false;
+    bool drain_scheduled_ = false;        // Une tâche drainPending est en file ou en cours
+    bool stop_ = false;
+    uint64_t next_request_id_ = 0;
+    uint64_t completed_request_id_ = 0;   // Dernière requête terminée (ou remplacée)
+    double latest_budget_ms_ = 0.0;       // τ de la dernière requête soumise
+    std::optional<ActionIntention> last_result_;
+    std::atomic<uint64_t> interrupt_epoch_{0};
+    TaskLane lane_{TaskClass::PIPELINE};
+
     // Templates d'actions de base
     std::vector<ActionOption> action_templates_;
 
     // Cache des dernières décisions
-    std::vector<ActionIntention> decision_history_;
     static constexpr size_t MAX_HISTORY_SIZE = 100;
+    RingBuffer<ActionIntention> decision_history_{MAX_HISTORY_SIZE};
 };
 
 } // namespace mcee
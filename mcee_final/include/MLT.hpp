@@ -13,15 +13,20 @@
 
 #include "Types.hpp"
 #include "MCT.hpp"
+#include "PatternMatrix.hpp"
+#include "Executor.hpp"
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <optional>
 #include <functional>
 #include <chrono>
+#include <condition_variable>
 
 namespace mcee {
 
@@ -52,6 +57,8 @@ struct EmotionalPattern {
     int activation_count{0};                   // Nombre d'activations
     double confidence{0.5};                    // Confiance dans ce pattern [0, 1]
     double average_duration_seconds{0.0};      // Durée moyenne d'activation
+    uint64_t revision{0};                      // revision() de la dernière modification qui change le matching, non sérialisé
+    uint64_t coefficients_revision{0};         // Idem, hors signature et confiance (updatePattern), non sérialisé
     std::chrono::system_clock::time_point created_at;
     std::chrono::system_clock::time_point last_activated;
     std::chrono::system_clock::time_point last_modified;
@@ -92,6 +99,29 @@ struct PatternMatch {
     }
 };
 
+/**
+ * @brief Score d'un seul pattern (revalidation d'un match réutilisé)
+ */
+struct PatternScore {
+    double similarity{0.0};
+    double confidence{0.0};
+    uint64_t coefficients_revision{0};
+};
+
+/**
+ * @brief Successeur probable d'un pattern (préchargement)
+ *
+ * Copie des seuls champs utiles au préchargement : pas de pointeur vers
+ * la MLT, qui peut être modifiée entre la prédiction et son exécution.
+ */
+struct TransitionForecast {
+    std::string pattern_id;
+    std::string pattern_name;
+    double probability{0.0};
+    std::array<double, 24> mean_emotions{};    // Signature du pattern cible
+    std::vector<std::string> lemmas;           // Mots déclencheurs puis contextes associés
+};
+
 /**
  * @brief Configuration de la MLT
  */
@@ -109,6 +139,7 @@ struct MLTConfig {
     // Fusion de patterns
     double fusion_similarity_threshold{0.9};   // Similarité pour fusion automatique
     size_t min_activations_for_fusion{10};     // Activations min avant fusion
+    bool background_learning{true};            // runLearningPassAsync sur l'Executor (sinon synchrone)
     
     // Nettoyage
     size_t max_patterns{100};                  // Nombre max de patterns
@@ -116,7 +147,7 @@ struct MLTConfig {
     int days_before_pruning{30};               // Jours d'inactivité avant suppression
     
     // Persistance
-    std::string storage_path{"patterns.json"}; // Chemin de sauvegarde
+    std::string storage_path{"patterns.mltp"}; // Chemin de sauvegarde (".json" : format texte)
     bool auto_save{true};                      // Sauvegarde automatique
     int auto_save_interval_minutes{5};         // Intervalle de sauvegarde
 };
@@ -151,11 +182,34 @@ struct PatternEvent {
  * - Créer de nouveaux patterns quand nécessaire
  * - Fusionner des patterns similaires
  * - Faire évoluer les coefficients par apprentissage
+ *
+ * Couche de session (MLT(base)) : un ensemble de base partagé en lecture
+ * seule, sous une couche propre à la session. Toute lecture (matching,
+ * accesseurs, sérialisation) consulte la couche d'abord, qui masque la base
+ * à identifiant égal ; toute modification d'un pattern de base porte sur sa
+ * copie dans la couche. La base n'est lue que sous le verrou de la couche :
+ * elle doit être figée (plus aucune écriture) dès son partage.
  */
 class MLT {
 public:
     MLT();
     explicit MLT(const MLTConfig& config);
+
+    /**
+     * @brief Couche de session au-dessus d'un ensemble de base partagé
+     *
+     * La configuration est celle de la base. Une couche ne peut pas servir
+     * de base (std::invalid_argument).
+     */
+    explicit MLT(std::shared_ptr<const MLT> base);
+
+    /**
+     * @brief Destructeur (rejoint le thread d'apprentissage)
+     */
+    ~MLT();
+
+    MLT(const MLT&) = delete;
+    MLT& operator=(const MLT&) = delete;
     
     // ═══════════════════════════════════════════════════════════════
     // INITIALISATION
@@ -168,13 +222,46 @@ public:
     
     /**
      * @brief Charge les patterns depuis un fichier
+     *
+     * Le format est détecté : snapshot binaire (signature "MLTP") ou JSON.
      */
     bool loadFromFile(const std::string& path);
     
     /**
-     * @brief Sauvegarde les patterns dans un fichier
+     * @brief Sauvegarde les patterns dans un fichier (écriture atomique)
+     *
+     * JSON si le chemin se termine par ".json", snapshot binaire sinon.
+     * Couche de session : seul l'ensemble de base est écrit, l'apprentissage
+     * de la session n'est jamais versé dans le fichier commun.
      */
     bool saveToFile(const std::string& path) const;
+
+    /**
+     * @brief Remplace tous les patterns par ceux d'un snapshot binaire
+     *
+     * Le fichier est projeté en mémoire ; l'image des signatures est
+     * copiée telle quelle dans la matrice de scoring.
+     */
+    bool loadSnapshot(const std::string& path);
+
+    /**
+     * @brief Checkpoint binaire (fichier temporaire puis rename)
+     */
+    bool saveSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Image binaire du snapshot, encodée sous le verrou (sans écriture)
+     *
+     * Permet de figer les patterns à un instant précis et de confier
+     * l'écriture à un autre thread. Couche de session : la vue complète
+     * (base et couche), rechargée ensuite par loadSnapshot sans la base.
+     */
+    std::string encodeSnapshot() const;
+
+    /**
+     * @brief Export JSON lisible (outil de débogage et de migration)
+     */
+    bool exportJson(const std::string& path) const;
     
     // ═══════════════════════════════════════════════════════════════
     // MATCHING
@@ -201,6 +288,33 @@ public:
     double computeSimilarity(const EmotionalSignature& signature, 
                             const EmotionalPattern& pattern) const;
     
+    /**
+     * @brief Matching restreint aux successeurs probables d'un pattern
+     *
+     * Score le pattern from_id lui-même et ses k cibles de transition les
+     * plus probables (transition_probabilities), sans parcourir la matrice.
+     * Mêmes filtres et même tri que findMatches.
+     */
+    std::vector<PatternMatch> findTransitionMatches(const EmotionalSignature& signature,
+                                                    const std::string& from_id,
+                                                    size_t k) const;
+    
+    /**
+     * @brief Score d'un pattern actif sans parcourir la matrice ni le copier
+     * @return false si le pattern est absent ou inactif
+     */
+    bool scorePattern(const EmotionalSignature& signature,
+                      const std::string& pattern_id,
+                      PatternScore& score) const;
+    
+    /**
+     * @brief k successeurs les plus probables de from_id (probabilité décroissante)
+     * @param min_probability Transitions plus rares ignorées
+     */
+    std::vector<TransitionForecast> predictTransitions(const std::string& from_id,
+                                                       size_t k,
+                                                       double min_probability) const;
+    
     // ═══════════════════════════════════════════════════════════════
     // GESTION DES PATTERNS
     // ═══════════════════════════════════════════════════════════════
@@ -281,6 +395,24 @@ public:
      * @brief Déclenche une passe d'apprentissage globale
      */
     void runLearningPass();
+
+    /**
+     * @brief Passe d'apprentissage en tâche BACKGROUND de l'Executor (non bloquant)
+     *
+     * Les demandes reçues pendant une passe sont regroupées en une seule
+     * passe suivante. Synchrone si config.background_learning est faux.
+     */
+    void runLearningPassAsync();
+
+    /**
+     * @brief Vrai si une passe asynchrone est en cours ou en attente
+     */
+    [[nodiscard]] bool isLearning() const;
+
+    /**
+     * @brief Attend la fin des passes asynchrones en cours ou en attente
+     */
+    void waitForLearning() const;
     
     // ═══════════════════════════════════════════════════════════════
     // MAINTENANCE
@@ -288,8 +420,22 @@ public:
     
     /**
      * @brief Fusionne automatiquement les patterns trop similaires
+     *
+     * La recherche des paires tourne hors du mutex, sur une copie des
+     * signatures ; seules les fusions retenues passent sous le verrou.
+     * Chaque pattern est fusionné au plus une fois par passe.
      */
     void autoMerge();
+
+    /**
+     * @brief Paires fusionnables, par similarité décroissante (sans fusionner)
+     *
+     * Travaille sur une copie de la matrice de scoring : pour chaque
+     * pattern éligible, une ligne de scores vectorisée donne ses voisins
+     * au-dessus de fusion_similarity_threshold. Le mutex n'est tenu que
+     * le temps de la copie.
+     */
+    std::vector<std::pair<std::string, std::string>> findMergeCandidates() const;
     
     /**
      * @brief Supprime les patterns obsolètes
@@ -312,6 +458,30 @@ public:
     std::vector<EmotionalPattern> getBasePatterns() const;
     size_t patternCount() const;
     
+    /**
+     * @brief Révision des patterns, incrémentée à chaque modification de
+     *        signature, de coefficients ou de l'ensemble des patterns
+     *        (les activations et transitions ne comptent pas)
+     *
+     * Le pattern modifié reçoit la nouvelle valeur (EmotionalPattern::revision).
+     */
+    uint64_t revision() const { return revision_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Révision de chacun des patterns donnés (0 si absent)
+     *
+     * Une valeur inchangée garantit que le pattern n'a été ni modifié, ni
+     * supprimé, ni rechargé depuis la lecture précédente.
+     * @param revisions Remplacé par une révision par identifiant, dans l'ordre
+     */
+    void patternRevisions(const std::vector<std::string>& pattern_ids,
+                          std::vector<uint64_t>& revisions) const;
+    
+    /**
+     * @brief Ensemble de base partagé (nullptr : MLT racine)
+     */
+    const std::shared_ptr<const MLT>& base() const { return base_; }
+
     const MLTConfig& getConfig() const { return config_; }
     void setConfig(const MLTConfig& config) { config_ = config; }
     
@@ -334,7 +504,46 @@ private:
     std::unordered_map<std::string, EmotionalPattern> patterns_;
     mutable std::mutex mutex_;
     
+    // Signatures en colonnes pour le scoring vectorisé (miroir de patterns_)
+    PatternMatrix matrix_;
+    mutable std::vector<double> score_scratch_;
+    std::atomic<uint64_t> revision_{0};
+    
     PatternEventCallback event_callback_;
+
+    // Couche de session : base figée, patterns de base supprimés dans la session
+    std::shared_ptr<const MLT> base_;
+    std::unordered_set<std::string> hidden_;
+    mutable std::vector<double> base_scratch_;
+
+    // Passes d'apprentissage asynchrones (une seule à la fois sur la voie)
+    mutable std::mutex learning_mutex_;
+    mutable std::condition_variable learning_done_cv_;
+    bool learning_pending_ = false;
+    bool learning_in_flight_ = false;
+    bool learning_stop_ = false;
+
+    TaskLane learning_lane_{TaskClass::BACKGROUND};
+
+    void learningTask();
+
+    // Vue de la session (mutex_ tenu) : couche d'abord, puis base visible
+    const EmotionalPattern* findLocked(const std::string& id) const;
+    bool baseVisibleLocked(const std::string& id) const;
+    template <typename Fn> void forEachLocked(Fn&& fn) const;
+    size_t countLocked() const;
+
+    // Pattern modifiable, copié de la base dans la couche au besoin (mutex_ tenu)
+    EmotionalPattern* ownLocked(const std::string& id);
+
+    // Retire un pattern de la vue : supprimé de la couche, masqué dans la base (mutex_ tenu)
+    void eraseLocked(const std::string& id);
+
+    // Matrice de scoring de la vue complète (mutex_ tenu)
+    PatternMatrix viewMatrixLocked() const;
+
+    // Fusion de deux patterns (mutex_ tenu)
+    std::string mergeLocked(const std::string& id1, const std::string& id2);
     
     // Générateur d'ID unique
     std::string generatePatternId() const;
@@ -347,6 +556,13 @@ private:
                                          const EmotionalSignature& s2,
                                          double weight1 = 0.5) const;
     
+    // Reconstruit matrix_ depuis patterns_ (mutex_ tenu)
+    void rebuildMatrix();
+
+    // Nouvelle révision, attribuée au pattern modifié (mutex_ tenu) ;
+    // coefficients faux : seules la signature et la confiance ont changé
+    void touchLocked(EmotionalPattern& pattern, bool coefficients = true);
+    
     // Émet un événement
     void emitEvent(PatternEvent::Type type, 
                    const std::string& id,
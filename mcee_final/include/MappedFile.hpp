@@ -0,0 +1,170 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Projection mémoire en lecture seule et écriture atomique de fichiers
+ *
+ * MappedFile projette un fichier entier (mmap, PROT_READ) pour les formats
+ * binaires lus sans copie ; writeFileAtomic écrit dans un fichier
+ * temporaire voisin, le synchronise puis le renomme : un lecteur voit
+ * l'ancienne version ou la nouvelle, jamais un fichier tronqué.
+ *
+ * POSIX uniquement (Linux, macOS).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mcee {
+
+/**
+ * @class MappedFile
+ * @brief Fichier projeté en mémoire, démappé à la destruction
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data_ = other.data_;
+            size_ = other.size_;
+            other.data_ = nullptr;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Projette le fichier
+     * @param error [out] Cause de l'échec (errno)
+     * @return false si le fichier est absent, vide ou non projetable
+     */
+    bool open(const std::string& path, std::string* error = nullptr) {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return fail(error, "open");
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            fail(error, "fstat");
+            ::close(fd);
+            return false;
+        }
+        if (st.st_size <= 0) {
+            ::close(fd);
+            errno = 0;
+            return fail(error, "fichier vide");
+        }
+
+        void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // La projection reste valide après fermeture du descripteur
+        if (data == MAP_FAILED) {
+            return fail(error, "mmap");
+        }
+
+        data_ = static_cast<const unsigned char*>(data);
+        size_ = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    void close() {
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    [[nodiscard]] bool isOpen() const { return data_ != nullptr; }
+    [[nodiscard]] const unsigned char* data() const { return data_; }
+    [[nodiscard]] size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_{nullptr};
+    size_t size_{0};
+
+    static bool fail(std::string* error, const char* what) {
+        if (error) {
+            *error = std::string(what) + (errno ? std::string(": ") + std::strerror(errno) : "");
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Remplace atomiquement le contenu d'un fichier
+ *
+ * Écrit `path.tmp`, fsync, puis rename(2) sur `path`.
+ *
+ * @param error [out] Cause de l'échec (errno)
+ * @return false si une étape échoue (le fichier existant est alors intact)
+ */
+inline bool writeFileAtomic(const std::string& path, std::string_view data,
+                            std::string* error = nullptr) {
+    const std::string tmp_path = path + ".tmp";
+    auto fail = [&](const char* what) {
+        if (error) {
+            *error = std::string(what) + ": " + std::strerror(errno);
+        }
+        return false;
+    };
+
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return fail("open");
+    }
+
+    const char* p = data.data();
+    size_t remaining = data.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, p, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            bool ok = fail("write");
+            ::close(fd);
+            ::unlink(tmp_path.c_str());
+            return ok;
+        }
+        p += written;
+        remaining -= static_cast<size_t>(written);
+    }
+
+    if (::fsync(fd) != 0) {
+        bool ok = fail("fsync");
+        ::close(fd);
+        ::unlink(tmp_path.c_str());
+        return ok;
+    }
+    ::close(fd);
+
+    if (::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        bool ok = fail("rename");
+        ::unlink(tmp_path.c_str());
+        return ok;
+    }
+    return true;
+}
+
+} // namespace mcee
@@ -9,6 +9,13 @@
  *
  * Formule d'activation des souvenirs:
  * A(Si) = forget(Si,t) × (1 + R(Si)) × Σ[C(Si,Sk) × Me(Si,E_current) × U(Si)]
+ *
+ * Stockage hiérarchisé : un niveau chaud de capacité fixe (indexé), un
+ * niveau tiède compact (émotions quantifiées) et Neo4j comme niveau froid.
+ * L'oubli est paresseux : le poids effectif est calculé à la lecture à
+ * partir du poids de base et de l'horodatage du dernier renforcement, si
+ * bien que l'empreinte mémoire reste bornée sur des sessions de plusieurs
+ * jours.
  */
 
 #ifndef MCEE_MEMORY_MANAGER_HPP
@@ -17,14 +24,48 @@
 #include "Types.hpp"
 #include "PhaseConfig.hpp"
 #include "Neo4jClient.hpp"
+#include "MemoryVectorIndex.hpp"
 #include <vector>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
 
 namespace mcee {
 
+/**
+ * @brief Configuration du stockage hiérarchisé des souvenirs
+ */
+struct MemoryTierConfig {
+    size_t hot_capacity = 2048;            // Souvenirs indexés en RAM (niveau chaud)
+    size_t warm_capacity = 65536;          // Souvenirs compacts (niveau tiède), au-delà : Neo4j seul
+    double coalesce_similarity = 0.98;     // Cosinus au-delà duquel une trame renforce un souvenir existant
+    double reinforcement = 0.1;            // Part du poids initial ajoutée à chaque renforcement
+    double weight_half_life_hours = 720.0; // Demi-vie du poids (30 jours), ×10 pour les traumas
+    double min_weight = 0.01;              // Poids effectif sous lequel un souvenir est oublié
+};
+
+/**
+ * @brief Statistiques du stockage hiérarchisé
+ */
+struct MemoryTierStats {
+    size_t hot = 0;               // Souvenirs au niveau chaud
+    size_t warm = 0;              // Souvenirs au niveau tiède
+    size_t coalesced = 0;         // Trames fusionnées dans un souvenir existant
+    size_t demoted = 0;           // Rétrogradations chaud → tiède
+    size_t promoted = 0;          // Remontées tiède/Neo4j → chaud
+    size_t dropped_to_cold = 0;   // Souvenirs tièdes écrasés (conservés dans Neo4j seul)
+    size_t forgotten = 0;         // Souvenirs oubliés (poids effectif < min_weight)
+    size_t warm_hits = 0;         // Recherches complétées par le niveau tiède
+};
+
 /**
  * @class MemoryManager
  * @brief Gère les souvenirs et leur influence sur les émotions
@@ -33,22 +74,49 @@ class MemoryManager {
 public:
     /**
      * @brief Constructeur
+     * @param config Capacités des niveaux et paramètres d'oubli
      */
-    MemoryManager();
+    explicit MemoryManager(const MemoryTierConfig& config = {});
+
+    /**
+     * @brief Remplace la configuration des niveaux
+     *
+     * Une capacité chaude réduite s'applique immédiatement (rétrogradation
+     * des souvenirs les plus faibles).
+     */
+    void setTierConfig(const MemoryTierConfig& config);
+
+    [[nodiscard]] MemoryTierConfig getTierConfig() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return tier_config_;
+    }
 
     /**
      * @brief Récupère les souvenirs pertinents selon la phase
      * @param phase Phase émotionnelle actuelle
      * @param state État émotionnel actuel
      * @param max_count Nombre maximum de souvenirs à retourner
-     * @return Liste des souvenirs pertinents
+     * @return Références vers les souvenirs pertinents (niveau chaud, sans copie)
      */
-    [[nodiscard]] std::vector<Memory> queryRelevantMemories(
+    [[nodiscard]] std::vector<MemoryRef> queryRelevantMemories(
         Phase phase,
         const EmotionalState& state,
         size_t max_count = 10
     );
 
+    /**
+     * @brief Variante du pipeline : résultat et tri dans la ressource de `out`
+     *
+     * `out` est vidé puis rempli ; ses temporaires (scores à trier) sont
+     * alloués avec le même allocateur, typiquement l'arène de la trame.
+     */
+    void queryRelevantMemories(
+        Phase phase,
+        const EmotionalState& state,
+        size_t max_count,
+        std::pmr::vector<MemoryRef>& out
+    );
+
     /**
      * @brief Calcule l'influence des souvenirs sur chaque émotion
      * @param memories Souvenirs actifs
@@ -56,7 +124,7 @@ public:
      * @return Influences par émotion [0-1]
      */
     [[nodiscard]] std::array<double, NUM_EMOTIONS> computeMemoryInfluences(
-        const std::vector<Memory>& memories,
+        std::span<const MemoryRef> memories,
         double delta_coeff
     ) const;
 
@@ -65,12 +133,16 @@ public:
      * @param state État émotionnel lors de la création
      * @param phase Phase lors de la création
      * @param context Contexte du souvenir
-     * @return Le souvenir créé
+     * @return Le souvenir créé, ou le souvenir existant renforcé
+     *
+     * Une trame quasi identique (même contexte, cosinus ≥ coalesce_similarity)
+     * au souvenir chaud le plus proche ne crée pas de nouvelle entrée : elle
+     * renforce son poids et son compteur d'activation.
      */
     Memory recordMemory(
         const EmotionalState& state,
         Phase phase,
-        const std::string& context
+        std::string_view context
     );
 
     /**
@@ -87,6 +159,7 @@ public:
      * @return Nouvelle valeur d'activation
      */
     double updateActivation(Memory& memory, const EmotionalState& current_state);
+    double updateActivation(MemoryRef& memory, const EmotionalState& current_state);
 
     /**
      * @brief Décide si un souvenir doit être consolidé
@@ -100,14 +173,26 @@ public:
     ) const;
 
     /**
-     * @brief Retourne tous les souvenirs en mémoire
+     * @brief Copie de tous les souvenirs locaux (chauds puis tièdes), poids effectifs
      */
-    [[nodiscard]] const std::vector<Memory>& getAllMemories() const { return memories_; }
+    [[nodiscard]] std::vector<Memory> getAllMemories() const;
 
     /**
-     * @brief Retourne le nombre de souvenirs
+     * @brief Ajoute des souvenirs restaurés (checkpoint) au niveau chaud
+     *
+     * Les poids sont repris tels quels ; au-delà de hot_capacity, les plus
+     * faibles sont rétrogradés comme à l'enregistrement.
+     * @return Nombre de souvenirs ajoutés
      */
-    [[nodiscard]] size_t getMemoryCount() const { return memories_.size(); }
+    size_t importMemories(std::span<const Memory> memories);
+
+    /**
+     * @brief Retourne le nombre de souvenirs locaux (chauds + tièdes)
+     */
+    [[nodiscard]] size_t getMemoryCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hot_count_ + warm_count_;
+    }
 
     /**
      * @brief Retourne le nombre de traumas
@@ -117,6 +202,9 @@ public:
     /**
      * @brief Applique l'oubli aux souvenirs
      * @param decay_factor Facteur de décroissance
+     *
+     * O(1) : le facteur est cumulé (en logarithme) et appliqué à la lecture ;
+     * les souvenirs passés sous min_weight sont retirés quand on les croise.
      */
     void applyForget(double decay_factor = 0.01);
 
@@ -127,6 +215,16 @@ public:
      */
     bool setNeo4jConfig(const Neo4jClientConfig& config);
 
+    /**
+     * @brief Utilise un client Neo4j déjà connecté, partagé avec d'autres gestionnaires
+     *
+     * Chaque gestionnaire ouvre sa propre session Neo4j sur la connexion
+     * commune (un MCEEHost : une connexion, une session par utilisateur).
+     *
+     * @return true si le client est connecté
+     */
+    bool attachNeo4jClient(std::shared_ptr<Neo4jClient> client);
+
     /**
      * @brief Vérifie si Neo4j est connecté
      */
@@ -146,13 +244,17 @@ public:
     size_t loadFromNeo4j(const std::string& pattern_filter = "");
 
     /**
-     * @brief Recherche les souvenirs similaires dans Neo4j
+     * @brief Recherche les souvenirs similaires (chaud, tiède, puis Neo4j)
      * @param state État émotionnel de recherche
      * @param threshold Seuil de similarité
      * @param limit Nombre max de résultats
      * @return Souvenirs similaires
+     *
+     * L'index chaud répond en premier, puis le niveau tiède ; Neo4j n'est
+     * interrogé que si le local ne fournit pas assez de résultats (données
+     * froides). Les souvenirs trouvés hors du niveau chaud y sont remontés.
      */
-    std::vector<Memory> findSimilarInNeo4j(
+    std::vector<MemoryRef> findSimilarInNeo4j(
         const EmotionalState& state,
         double threshold = 0.85,
         size_t limit = 5
@@ -172,17 +274,94 @@ public:
         const std::string& trigger = ""
     );
 
+    /**
+     * @brief Statistiques de l'index vectoriel local (taux de hit)
+     */
+    [[nodiscard]] MemoryIndexStats getIndexStats() const;
+
+    /**
+     * @brief Occupation et mouvements entre niveaux
+     */
+    [[nodiscard]] MemoryTierStats getTierStats() const;
+
     /**
      * @brief Retourne le client Neo4j (pour accès avancé)
      */
     Neo4jClient* getNeo4jClient() { return neo4j_client_.get(); }
+    const Neo4jClient* getNeo4jClient() const { return neo4j_client_.get(); }
+
+    /**
+     * @brief Taille approximative des souvenirs locaux et de leur index (octets)
+     */
+    [[nodiscard]] size_t memoryUsage() const;
 
 private:
-    // Stockage local des souvenirs
-    std::vector<Memory> memories_;
+    /**
+     * @brief Emplacement du niveau chaud
+     *
+     * Le poids n'est pas stocké mais son logarithme ramené à une horloge
+     * d'oubli commune (cf. decayClockLocked) : poids effectif =
+     * exp(rank − horloge). Le rang est invariant dans le temps, ce qui
+     * ordonne les évictions et détecte l'oubli sans recalcul.
+     */
+    struct HotSlot {
+        std::shared_ptr<const Memory> memory;    // nullptr : emplacement libre
+        double rank = 0.0;                       // log(poids) + horloge au dernier renforcement
+        std::chrono::system_clock::time_point last_activated;
+        int activation_count = 0;
+        bool is_trauma = false;
+    };
+
+    /**
+     * @brief Souvenir compact du niveau tiède (64 octets, sans allocation)
+     */
+    struct WarmMemory {
+        std::array<uint8_t, NUM_EMOTIONS> emotions{};   // [0-1] quantifié sur 8 bits
+        uint32_t name_id = 0;                           // Chaînes internées (names_)
+        uint32_t dominant_id = 0;
+        float valence = 0.0f;
+        float intensity = 0.0f;
+        double rank = 0.0;                              // Cf. HotSlot::rank
+        int64_t last_activated_ms = 0;                  // system_clock, ms depuis l'époque
+        int32_t activation_count = 0;
+        uint8_t phase = 0;
+        bool is_trauma = false;
+        bool used = false;
+    };
+
+    // Configuration et verrou (partagés entre les étages update et persist)
+    MemoryTierConfig tier_config_;
+    mutable std::mutex mutex_;
+
+    // Niveau chaud : ligne i de l'index = hot_[i] (ligne nulle si libre), protégé par mutex_
+    std::vector<HotSlot> hot_;
+    std::vector<size_t> hot_free_;
+    size_t hot_count_ = 0;
+    MemoryVectorIndex index_;
+    std::vector<float> score_scratch_;
+    std::atomic<size_t> index_queries_{0};
+    std::atomic<size_t> index_local_hits_{0};
+    std::atomic<size_t> index_fallbacks_{0};
 
-    // Client Neo4j
-    std::unique_ptr<Neo4jClient> neo4j_client_;
+    // Niveau tiède : anneau de capacité fixe, l'entrée la plus ancienne part au froid
+    std::vector<WarmMemory> warm_;
+    size_t warm_head_ = 0;
+    size_t warm_count_ = 0;
+
+    // Chaînes internées du niveau tiède, avec compteur de références
+    std::vector<std::string> names_;
+    std::vector<uint32_t> name_refs_;
+    std::vector<uint32_t> name_free_;
+    std::unordered_map<std::string, uint32_t> name_ids_;
+
+    // Oubli cumulé par applyForget (logarithme du facteur restant)
+    double forget_log_ = 0.0;
+    double trauma_forget_log_ = 0.0;
+
+    MemoryTierStats tier_stats_;
+
+    // Client Neo4j (éventuellement partagé, cf. attachNeo4jClient)
+    std::shared_ptr<Neo4jClient> neo4j_client_;
     bool neo4j_enabled_ = false;
 
     // ID de session Neo4j
@@ -191,20 +370,93 @@ private:
     /**
      * @brief Calcule la correspondance émotionnelle entre état et souvenir
      * @param state État émotionnel actuel
-     * @param memory Souvenir à comparer
+     * @param emotions Émotions du souvenir
      * @return Score de correspondance [0-1]
      */
     [[nodiscard]] double computeEmotionalMatch(
         const EmotionalState& state,
-        const Memory& memory
+        const std::array<double, NUM_EMOTIONS>& emotions
     ) const;
 
     /**
      * @brief Calcule le facteur d'oubli d'un souvenir
-     * @param memory Souvenir
+     * @param last_activated Dernière activation
+     * @param is_trauma Les traumas résistent à l'oubli
      * @return Facteur d'oubli [0-1]
      */
-    [[nodiscard]] double computeForgetFactor(const Memory& memory) const;
+    [[nodiscard]] double computeForgetFactor(
+        std::chrono::system_clock::time_point last_activated,
+        bool is_trauma
+    ) const;
+
+    /**
+     * @brief Horloge d'oubli : log du facteur d'oubli cumulé depuis l'époque (mutex_ tenu)
+     *
+     * Croît avec le temps (demi-vie, ×10 pour les traumas) et avec applyForget.
+     */
+    [[nodiscard]] double decayClockLocked(
+        bool is_trauma,
+        std::chrono::system_clock::time_point now
+    ) const;
+
+    /**
+     * @brief Vrai si le souvenir chaud est oublié ; libère alors l'emplacement (mutex_ tenu)
+     */
+    bool forgetIfFadedLocked(size_t slot, double faded_rank);
+
+    /**
+     * @brief Construit la référence d'un souvenir chaud (mutex_ tenu)
+     */
+    [[nodiscard]] MemoryRef makeRefLocked(size_t slot, double clock, double trauma_clock) const;
+
+    /**
+     * @brief Ajoute un souvenir au niveau chaud, en rétrogradant au besoin (mutex_ tenu)
+     * @return Emplacement attribué
+     */
+    size_t appendLocked(const Memory& memory);
+    size_t appendLocked(HotSlot slot);
+
+    /**
+     * @brief Emplacement chaud le plus faible (non-traumas d'abord) (mutex_ tenu)
+     */
+    [[nodiscard]] size_t weakestHotLocked() const;
+
+    /**
+     * @brief Rétrograde un souvenir chaud vers le niveau tiède (mutex_ tenu)
+     */
+    void demoteLocked(size_t slot);
+
+    /**
+     * @brief Libère un emplacement chaud (mutex_ tenu)
+     */
+    void releaseHotLocked(size_t slot);
+
+    /**
+     * @brief Retire un souvenir du niveau tiède pour le remonter au chaud (mutex_ tenu)
+     * @return Emplacement chaud prêt à être inséré (cf. appendLocked)
+     */
+    HotSlot takeWarmLocked(size_t warm_pos, std::chrono::system_clock::time_point now);
+
+    /**
+     * @brief Libère une entrée tiède et ses chaînes internées (mutex_ tenu)
+     */
+    void releaseWarmLocked(size_t warm_pos);
+
+    /**
+     * @brief Reconstitue un souvenir complet depuis le niveau tiède (mutex_ tenu)
+     */
+    [[nodiscard]] Memory materializeWarmLocked(
+        const WarmMemory& warm,
+        std::chrono::system_clock::time_point now
+    ) const;
+
+    uint32_t internLocked(const std::string& text);
+    void releaseNameLocked(uint32_t id);
+
+    /**
+     * @brief Crée la session Neo4j de ce gestionnaire (asynchrone)
+     */
+    void openNeo4jSession();
 
     /**
      * @brief Calcule le poids initial selon la phase
@@ -0,0 +1,111 @@
+/**
+ * @file MemoryVectorIndex.hpp
+ * @brief Index vectoriel local (cosinus) sur les émotions des souvenirs
+ * @version 1.0
+ * @date 2025-12-21
+ *
+ * Les vecteurs d'émotions sont petits (NUM_EMOTIONS = 24) : un index plat,
+ * normalisé et contigu en float, répond à un top-k cosinus sur quelques
+ * milliers de souvenirs en quelques microsecondes, sans aller-retour Neo4j.
+ * La boucle de produit scalaire est écrite pour être vectorisée par le
+ * compilateur (SSE/AVX selon la cible).
+ */
+
+#ifndef MCEE_MEMORY_VECTOR_INDEX_HPP
+#define MCEE_MEMORY_VECTOR_INDEX_HPP
+
+#include "Types.hpp"
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Résultat d'une recherche dans l'index
+ */
+struct IndexHit {
+    size_t row = 0;            // Ligne dans l'index (= emplacement du niveau chaud)
+    double similarity = 0.0;   // Similarité cosinus [0-1]
+};
+
+/**
+ * @brief Statistiques d'utilisation de l'index local
+ */
+struct MemoryIndexStats {
+    size_t indexed = 0;            // Vecteurs indexés
+    size_t queries = 0;            // Recherches de similarité
+    size_t local_hits = 0;         // Recherches servies entièrement en local
+    size_t neo4j_fallbacks = 0;    // Recherches complétées par Neo4j (données froides)
+
+    [[nodiscard]] double hitRatio() const {
+        return queries > 0 ? static_cast<double>(local_hits) / static_cast<double>(queries) : 0.0;
+    }
+};
+
+/**
+ * @class MemoryVectorIndex
+ * @brief Index plat de vecteurs d'émotions normalisés
+ *
+ * La ligne i de l'index correspond au i-ème emplacement du niveau chaud
+ * (ligne nulle pour un emplacement libre).
+ * Non thread-safe : le propriétaire (MemoryManager) le protège par son mutex.
+ */
+class MemoryVectorIndex {
+public:
+    static constexpr size_t DIM = NUM_EMOTIONS;
+
+    /**
+     * @brief Ajoute un vecteur en fin d'index
+     * @return Ligne attribuée
+     */
+    size_t add(const std::array<double, NUM_EMOTIONS>& emotions);
+
+    /**
+     * @brief Remplace le vecteur d'une ligne existante
+     */
+    void set(size_t row, const std::array<double, NUM_EMOTIONS>& emotions);
+
+    /**
+     * @brief Reconstruit l'index à partir du stockage local
+     */
+    void rebuild(const std::vector<Memory>& memories);
+
+    /**
+     * @brief Vide l'index
+     */
+    void clear() { vectors_.clear(); }
+
+    /**
+     * @brief Calcule la similarité cosinus de la requête avec chaque ligne
+     * @param query Vecteur d'émotions (non normalisé)
+     * @param out Similarités, une par ligne
+     */
+    void cosineAll(const std::array<double, NUM_EMOTIONS>& query, std::vector<float>& out) const;
+
+    /**
+     * @brief Retourne les k lignes les plus similaires au-dessus du seuil
+     * @param query Vecteur d'émotions
+     * @param k Nombre maximum de résultats
+     * @param threshold Similarité minimale
+     * @return Résultats triés par similarité décroissante
+     */
+    [[nodiscard]] std::vector<IndexHit> topK(
+        const std::array<double, NUM_EMOTIONS>& query,
+        size_t k,
+        double threshold = 0.0
+    ) const;
+
+    [[nodiscard]] size_t size() const { return vectors_.size() / DIM; }
+    [[nodiscard]] bool empty() const { return vectors_.empty(); }
+
+private:
+    // Lignes de DIM floats normalisés (ligne nulle si norme ~0)
+    std::vector<float> vectors_;
+
+    static void normalizeInto(const std::array<double, NUM_EMOTIONS>& in, float* out);
+};
+
+} // namespace mcee
+
+#endif // MCEE_MEMORY_VECTOR_INDEX_HPP
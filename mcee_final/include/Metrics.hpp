@@ -0,0 +1,261 @@
+/**
+ * @file Metrics.hpp
+ * @brief Histogrammes de latence et exposition au format texte Prometheus
+ *
+ * LatencyHistogram suit le schéma HDR : un seau par puissance de deux,
+ * subdivisé linéairement en 8 sous-seaux. L'erreur relative d'un quantile
+ * est donc bornée à 12,5 % de 1 ns à ~18 minutes, pour ~2,5 Ko de
+ * compteurs. L'enregistrement est sans verrou (incréments atomiques
+ * relaxés) : il peut être appelé depuis n'importe quel thread du pipeline.
+ *
+ * PrometheusWriter produit le format d'exposition texte 0.0.4 ; les seaux
+ * fins sont regroupés sur des bornes `le` fixes exprimées en secondes.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace mcee {
+
+constexpr const char* PROMETHEUS_CONTENT_TYPE = "text/plain; version=0.0.4";
+
+/**
+ * @brief Géométrie des seaux partagée par l'histogramme et ses instantanés
+ */
+struct LatencyBuckets {
+    static constexpr unsigned SUB_BUCKET_BITS = 3;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = 40;     // 2^40 ns ≈ 18 minutes
+    static constexpr size_t COUNT = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    /// Seau d'une durée (les valeurs hors plage vont dans le dernier seau)
+    static constexpr size_t indexOf(uint64_t ns) {
+        if (ns < SUB_BUCKETS) {
+            return static_cast<size_t>(ns);
+        }
+        unsigned msb = static_cast<unsigned>(std::bit_width(ns)) - 1;
+        if (msb > MAX_EXPONENT) {
+            return COUNT - 1;
+        }
+        unsigned shift = msb - SUB_BUCKET_BITS;
+        uint64_t sub = (ns >> shift) & (SUB_BUCKETS - 1);
+        return static_cast<size_t>(SUB_BUCKETS + shift * SUB_BUCKETS + sub);
+    }
+
+    /// Borne inférieure (incluse) d'un seau, en ns
+    static constexpr uint64_t lowerBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+        return (SUB_BUCKETS + sub) << shift;
+    }
+
+    /// Borne supérieure (exclue) d'un seau, en ns
+    static constexpr uint64_t upperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index + 1;
+        }
+        uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+        return (SUB_BUCKETS + sub + 1) << shift;
+    }
+};
+
+/**
+ * @brief Copie d'un LatencyHistogram (seaux lus un à un, sans arrêt des écrivains)
+ */
+struct LatencySnapshot {
+    std::array<uint64_t, LatencyBuckets::COUNT> counts{};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+
+    /**
+     * @brief Quantile q ∈ [0, 1] en ns (milieu du seau, plafonné au max observé)
+     */
+    [[nodiscard]] uint64_t percentileNs(double q) const {
+        if (count == 0) return 0;
+        if (q <= 0.0) q = 0.0;
+        if (q >= 1.0) return max_ns;
+
+        uint64_t total = 0;
+        for (uint64_t c : counts) total += c;
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total)) + 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                uint64_t mid = (LatencyBuckets::lowerBound(i) + LatencyBuckets::upperBound(i)) / 2;
+                return mid < max_ns ? mid : max_ns;
+            }
+        }
+        return max_ns;
+    }
+
+    [[nodiscard]] double meanNs() const {
+        return count > 0 ? static_cast<double>(sum_ns) / static_cast<double>(count) : 0.0;
+    }
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Histogramme log-linéaire de durées, sans verrou
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t ns) noexcept {
+        counts_[LatencyBuckets::indexOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t previous = max_ns_.load(std::memory_order_relaxed);
+        while (ns > previous &&
+               !max_ns_.compare_exchange_weak(previous, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void record(std::chrono::steady_clock::duration elapsed) noexcept {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        record(ns > 0 ? static_cast<uint64_t>(ns) : 0);
+    }
+
+    /// Enregistre le temps écoulé depuis start
+    void recordSince(std::chrono::steady_clock::time_point start) noexcept {
+        record(std::chrono::steady_clock::now() - start);
+    }
+
+    [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] LatencySnapshot snapshot() const {
+        LatencySnapshot snap;
+        for (size_t i = 0; i < counts_.size(); ++i) {
+            snap.counts[i] = counts_[i].load(std::memory_order_relaxed);
+        }
+        snap.count = count_.load(std::memory_order_relaxed);
+        snap.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+        snap.max_ns = max_ns_.load(std::memory_order_relaxed);
+        return snap;
+    }
+
+    void reset() noexcept {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, LatencyBuckets::COUNT> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+/**
+ * @brief Chronomètre RAII : enregistre sa durée de vie dans un histogramme
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHistogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() { histogram_.recordSince(start_); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    LatencyHistogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @class PrometheusWriter
+ * @brief Construit un document au format d'exposition texte Prometheus
+ *
+ * Une famille (`family`) est déclarée une fois, puis reçoit une série par
+ * jeu d'étiquettes. Les étiquettes sont passées déjà formatées
+ * (`stage="match"`), sans accolades.
+ */
+class PrometheusWriter {
+public:
+    /// Bornes `le` des histogrammes, en secondes (10 µs → 10 s)
+    static constexpr std::array<double, 18> LATENCY_BOUNDS_SECONDS = {
+        1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+        1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2,
+        0.1, 0.25, 0.5, 1.0, 2.5, 10.0
+    };
+
+    void family(const std::string& name, const std::string& help, const char* type) {
+        out_ += "# HELP " + name + " " + help + "\n";
+        out_ += "# TYPE " + name + " " + type + "\n";
+    }
+
+    void sample(const std::string& name, double value, const std::string& labels = "") {
+        out_ += name;
+        if (!labels.empty()) {
+            out_ += "{" + labels + "}";
+        }
+        out_ += " " + formatNumber(value) + "\n";
+    }
+
+    /**
+     * @brief Série d'histogramme (`_bucket`, `_sum`, `_count`)
+     *
+     * Un seau fin est compté sous la borne `le` qui contient son milieu :
+     * les comptes cumulés sont exacts à la précision de l'histogramme près.
+     */
+    void histogram(const std::string& name, const LatencySnapshot& snap,
+                   const std::string& labels = "") {
+        const std::string prefix = labels.empty() ? "" : labels + ",";
+
+        size_t bucket = 0;
+        uint64_t cumulative = 0;
+        for (double bound : LATENCY_BOUNDS_SECONDS) {
+            const double bound_ns = bound * 1e9;
+            while (bucket < snap.counts.size() &&
+                   static_cast<double>(LatencyBuckets::lowerBound(bucket) +
+                                       LatencyBuckets::upperBound(bucket)) / 2.0 <= bound_ns) {
+                cumulative += snap.counts[bucket++];
+            }
+            sample(name + "_bucket", static_cast<double>(cumulative),
+                   prefix + "le=\"" + formatNumber(bound) + "\"");
+        }
+        // Total recompté depuis les seaux : +Inf ne peut pas être inférieur au dernier `le`
+        while (bucket < snap.counts.size()) {
+            cumulative += snap.counts[bucket++];
+        }
+        sample(name + "_bucket", static_cast<double>(cumulative), prefix + "le=\"+Inf\"");
+        sample(name + "_sum", static_cast<double>(snap.sum_ns) / 1e9, labels);
+        sample(name + "_count", static_cast<double>(cumulative), labels);
+    }
+
+    [[nodiscard]] const std::string& str() const { return out_; }
+
+    static std::string formatNumber(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+        return buffer;
+    }
+
+private:
+    std::string out_;
+};
+
+} // namespace mcee
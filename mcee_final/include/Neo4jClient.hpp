@@ -6,12 +6,19 @@
  *
  * Communique avec le service Neo4j Python via RabbitMQ.
  * Gère la synchronisation des souvenirs entre MCEE et Neo4j.
+ *
+ * En transport BOLT, create_memory (sans contexte à analyser), find_similar,
+ * reactivate, record_transition et executeCypher parlent Bolt directement
+ * au serveur ; les autres opérations restent servies par le pont RabbitMQ.
  */
 
 #ifndef MCEE_NEO4J_CLIENT_HPP
 #define MCEE_NEO4J_CLIENT_HPP
 
 #include "Types.hpp"
+#include "Metrics.hpp"
+#include "Executor.hpp"
+#include "BoltClient.hpp"
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <nlohmann/json.hpp>
 #include <string>
@@ -23,15 +30,27 @@
 #include <queue>
 #include <functional>
 #include <condition_variable>
+#include <future>
+#include <unordered_map>
 
 namespace mcee {
 
 using json = nlohmann::json;
 
+/**
+ * @brief Transport des requêtes Neo4j
+ */
+enum class Neo4jTransport {
+    RABBITMQ,   // Service Python via RabbitMQ (toutes les opérations)
+    BOLT        // Bolt natif pour les requêtes fixes, pont RabbitMQ pour le reste
+};
+
 /**
  * @brief Configuration du client Neo4j
  */
 struct Neo4jClientConfig {
+    Neo4jTransport transport = Neo4jTransport::RABBITMQ;
+
     // RabbitMQ
     std::string rabbitmq_host = "localhost";
     int rabbitmq_port = 5672;
@@ -48,6 +67,17 @@ struct Neo4jClientConfig {
 
     // Mode
     bool async_mode = true;  // true = async, false = sync
+
+    // Tampon d'écriture (mutations regroupées en un message "batch")
+    bool enable_write_batching = true;
+    size_t batch_max_size = 1000;          // Flush dès que le tampon atteint cette taille
+    int batch_flush_interval_ms = 50;      // Flush périodique du tampon
+    int batch_timeout_ms = 30000;          // Attente max de la réponse d'un lot
+    uint16_t response_prefetch = 256;      // Réponses non acquittées autorisées en vol
+
+    // Bolt (transport BOLT)
+    bolt::BoltConfig bolt;
+    bool bolt_fallback_rabbitmq = true;    // Pont RabbitMQ : opérations non natives, Bolt injoignable
 };
 
 /**
@@ -88,8 +118,8 @@ public:
     Neo4jClient& operator=(const Neo4jClient&) = delete;
 
     /**
-     * @brief Connecte au service RabbitMQ
-     * @return true si connexion réussie
+     * @brief Connecte au service RabbitMQ (et au serveur Bolt en transport BOLT)
+     * @return true si au moins un transport est disponible
      */
     bool connect();
 
@@ -103,6 +133,11 @@ public:
      */
     [[nodiscard]] bool isConnected() const { return connected_.load(); }
 
+    /**
+     * @brief Vrai si les requêtes fixes passent par Bolt
+     */
+    [[nodiscard]] bool usesBolt() const { return bolt_pool_ != nullptr; }
+
     // ═══════════════════════════════════════════════════════════════════════════
     // OPÉRATIONS MÉMOIRE
     // ═══════════════════════════════════════════════════════════════════════════
@@ -272,9 +307,72 @@ public:
      */
     json executeCypher(const std::string& query, const json& params = {});
 
+    // ═══════════════════════════════════════════════════════════════════════════
+    // BATCHING
+    // ═══════════════════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Crée plusieurs souvenirs / traumas en un minimum d'allers-retours
+     * @param memories Souvenirs à créer (les traumas sont routés vers create_trauma)
+     * @param context Contexte textuel des souvenirs non-trauma
+     * @return Nombre de créations confirmées par le service
+     *
+     * Les opérations sont découpées en lots de batch_max_size, publiés tous
+     * avant d'attendre la moindre réponse.
+     */
+    size_t createMemoriesBatch(
+        const std::vector<Memory>& memories,
+        const std::string& context = ""
+    );
+
+    /**
+     * @brief Envoie immédiatement le contenu du tampon d'écriture
+     * @param wait Attendre la réponse du service (borné par request_timeout_ms)
+     * @return true si le lot a été publié (et confirmé si wait)
+     */
+    bool flush(bool wait = false);
+
+    /**
+     * @brief Nombre de mutations en attente dans le tampon
+     */
+    [[nodiscard]] size_t pendingWrites() const;
+
+    /**
+     * @brief Nombre de requêtes publiées en attente de réponse
+     */
+    [[nodiscard]] size_t inFlightRequests() const;
+
+    /**
+     * @brief Latence aller-retour des requêtes suivies (publication → réponse)
+     */
+    [[nodiscard]] const LatencyHistogram& getRoundTripLatency() const { return round_trip_latency_; }
+
 private:
+    /**
+     * @brief Requête en vol : callback async ou promesse pour un appel sync
+     */
+    struct PendingRequest {
+        Neo4jCallback callback;
+        std::shared_ptr<std::promise<Neo4jResponse>> promise;
+        std::chrono::steady_clock::time_point sent_at{};
+    };
+
+    /**
+     * @brief Mutation en attente dans le tampon d'écriture
+     */
+    struct BufferedWrite {
+        std::string request_id;
+        std::string request_type;
+        json payload;
+        Neo4jCallback callback;
+    };
+
     Neo4jClientConfig config_;
-    AmqpClient::Channel::ptr_t channel_;
+    std::unique_ptr<bolt::Pool> bolt_pool_;       // Nul hors transport BOLT ou si injoignable
+    std::atomic<bool> bridge_connected_{false};   // Pont RabbitMQ disponible
+    AmqpClient::Channel::ptr_t channel_;          // Consommation des réponses (thread dédié)
+    AmqpClient::Channel::ptr_t publish_channel_;  // Publication des requêtes
+    std::mutex publish_mutex_;
     std::string response_queue_;
     std::string consumer_tag_;
 
@@ -285,14 +383,63 @@ private:
     // Thread pour consommer les réponses
     std::thread response_thread_;
 
-    // Callbacks en attente
-    std::mutex callbacks_mutex_;
-    std::unordered_map<std::string, Neo4jCallback> pending_callbacks_;
+    // Requêtes en vol, corrélées par request_id
+    mutable std::mutex pending_mutex_;
+    std::unordered_map<std::string, PendingRequest> pending_;
+    LatencyHistogram round_trip_latency_;
+
+    // Tampon d'écriture : flush périodique (minuterie de l'Executor) et
+    // flush anticipé quand le tampon est plein (une tâche en file au plus)
+    mutable std::mutex batch_mutex_;
+    std::vector<BufferedWrite> write_buffer_;
+    CancellationSource batch_source_;
+    TaskFuture<void> batch_timer_;
+    TaskLane flush_lane_{TaskClass::PIPELINE};
+    std::atomic<bool> flush_scheduled_{false};
+
+    /**
+     * @brief Ouvre les canaux RabbitMQ et le thread de réponses
+     */
+    bool connectBridge();
+
+    /**
+     * @brief Ouvre le pool Bolt (une connexion de test)
+     */
+    bool connectBolt();
+
+    /**
+     * @brief Vrai si la requête a un équivalent Cypher natif
+     */
+    bool isNative(const std::string& request_type, const json& payload) const;
+
+    /**
+     * @brief Requête Bolt d'une opération native
+     * @param data Réponse au format du service Python, remplie au décodage
+     */
+    bolt::Query nativeQuery(const std::string& request_type, const json& payload, json& data) const;
+
+    /**
+     * @brief Exécute des mutations natives en un pipeline Bolt
+     *
+     * Les requêtes ignorées après un échec sont resoumises ; chaque callback
+     * reçoit sa propre réponse. Une connexion perdue en cours de lot résout
+     * les mutations restantes en erreur (issue inconnue, pas de rejeu).
+     * @return false si aucune connexion n'a pu être obtenue (ops intactes,
+     *         à envoyer par le pont)
+     */
+    bool runNativeWrites(std::vector<BufferedWrite>& ops);
+
+    /**
+     * @brief Exécute une requête Bolt synchrone
+     * @return nullopt si aucune connexion n'a pu être obtenue
+     */
+    std::optional<bolt::QueryResult> runNative(const bolt::Query& query);
 
-    // Réponses synchrones en attente
-    std::mutex sync_mutex_;
-    std::condition_variable sync_cv_;
-    std::unordered_map<std::string, Neo4jResponse> sync_responses_;
+    /**
+     * @brief Publie des mutations sur le pont, en lots de batch_max_size
+     * @param wait Attendre les réponses (borné par batch_timeout_ms)
+     */
+    bool publishBatches(std::vector<BufferedWrite> ops, bool wait);
 
     /**
      * @brief Génère un ID de requête unique
@@ -312,12 +459,71 @@ private:
         Neo4jCallback callback = nullptr
     );
 
+    /**
+     * @brief Envoie une requête et retourne une promesse de réponse
+     * @param request_type Type de requête
+     * @param payload Données
+     * @param request_id [out] ID attribué (vide si échec d'envoi)
+     * @return Future résolue par le thread de réponses
+     */
+    std::future<Neo4jResponse> sendRequestAwaitable(
+        const std::string& request_type,
+        const json& payload,
+        std::string& request_id
+    );
+
+    /**
+     * @brief Enregistre une requête en vol puis la publie
+     * @param request_type Type de requête
+     * @param payload Données
+     * @param pending Callback et/ou promesse à résoudre à la réponse
+     * @return ID de la requête (vide si échec d'envoi)
+     */
+    std::string submit(
+        const std::string& request_type,
+        const json& payload,
+        PendingRequest pending
+    );
+
     /**
      * @brief Attend une réponse synchrone
      * @param request_id ID de la requête
-     * @return Réponse
+     * @param future Future obtenue via sendRequestAwaitable
+     * @param timeout_ms Délai max (request_timeout_ms si négatif)
+     * @return Réponse (erreur "Timeout" si délai dépassé)
+     */
+    Neo4jResponse waitForResponse(const std::string& request_id,
+                                  std::future<Neo4jResponse>& future,
+                                  int timeout_ms = -1);
+
+    /**
+     * @brief Place une mutation dans le tampon (ou l'envoie directement si désactivé)
+     * @return ID de la mutation
+     */
+    std::string enqueueWrite(
+        const std::string& request_type,
+        const json& payload,
+        Neo4jCallback callback
+    );
+
+    /**
+     * @brief Publie un lot de mutations en un seul message "batch"
+     * @param ops Mutations à envoyer
+     * @param request_id [out] ID du message batch
+     * @return Future de la réponse du lot
+     */
+    std::future<Neo4jResponse> sendBatch(std::vector<BufferedWrite> ops,
+                                         std::string& request_id);
+
+    /**
+     * @brief Soumet un flush anticipé (sans effet si un flush est déjà en file)
+     */
+    void scheduleFlush();
+
+    /**
+     * @brief Résout les requêtes en vol avec une erreur (déconnexion)
      */
-    Neo4jResponse waitForResponse(const std::string& request_id);
+    void failPending(const std::string& error);
 
     /**
      * @brief Boucle de consommation des réponses
@@ -14,9 +14,11 @@
 
 #include "MCT.hpp"
 #include "MLT.hpp"
+#include "RingBuffer.hpp"
 #include "Types.hpp"
 #include <nlohmann/json.hpp>
 #include <memory>
+#include <atomic>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -83,6 +85,11 @@ struct PatternMatcherConfig {
     // Matching
     size_t max_matches_returned{5};         // Nombre max de matches retournés
     
+    // Matching incrémental
+    bool incremental_matching{true};        // Saute / restreint le matching en régime stable
+    double signature_skip_epsilon{0.05};    // Dérive de similarité max tolérée pour réutiliser le dernier match
+    size_t transition_candidates{4};        // Successeurs probables scorés avant un scan complet
+    
     // Logging
     bool verbose_logging{false};
 };
@@ -117,9 +124,29 @@ public:
      * 3. Décide de la stratégie (utiliser/créer/modifier)
      * 4. Retourne le résultat avec les coefficients
      * 
+     * En matching incrémental, le dernier match confirmé est réutilisé
+     * sans scanner la MLT tant que (cf. canReuseLastMatch) :
+     * - la dérive de la signature depuis celle de ce match reste sous
+     *   signature_skip_epsilon ;
+     * - rescoré seul, le pattern retenu reste au-dessus du seuil haut et
+     *   devant ses alternatives majorées de cette dérive ;
+     * - aucune alternative n'a changé, ni les coefficients du retenu.
+     * Sinon le pattern courant et ses successeurs probables sont scorés d'abord ;
+     * le scan complet de la MLT n'a lieu que si aucun n'atteint
+     * high_match_threshold.
+     * 
      * @return Résultat du matching avec pattern et coefficients
      */
     MatchResult match();
+
+    /**
+     * @brief match() sans copie du résultat (chemin du pipeline)
+     *
+     * Le résultat est immuable et partagé : une frame servie par le
+     * dernier match reçoit le même objet que la précédente (incrément de
+     * compteur, aucune allocation).
+     */
+    std::shared_ptr<const MatchResult> matchShared();
     
     /**
      * @brief Matching avec une signature spécifique (sans utiliser MCT)
@@ -199,11 +226,11 @@ public:
     // ACCESSEURS
     // ═══════════════════════════════════════════════════════════════
     
-    void setMCT(std::shared_ptr<MCT> mct) { mct_ = mct; }
-    void setMLT(std::shared_ptr<MLT> mlt) { mlt_ = mlt; }
+    void setMCT(std::shared_ptr<MCT> mct) { mct_ = mct; has_last_match_ = false; }
+    void setMLT(std::shared_ptr<MLT> mlt) { mlt_ = mlt; has_last_match_ = false; }
     
     const PatternMatcherConfig& getConfig() const { return config_; }
-    void setConfig(const PatternMatcherConfig& config) { config_ = config; }
+    void setConfig(const PatternMatcherConfig& config) { config_ = config; has_last_match_ = false; }
     
     // Statistiques
     size_t getTotalMatches() const { return total_matches_; }
@@ -211,6 +238,14 @@ public:
     size_t getTransitionsRecorded() const { return transitions_recorded_; }
     double getAverageMatchSimilarity() const;
     
+    // Matching incrémental : frames sans scoring, sorties anticipées sur les
+    // successeurs probables, scans complets de la MLT
+    size_t getSkippedMatches() const { return skipped_matches_.load(std::memory_order_relaxed); }
+    size_t getEarlyExits() const { return early_exits_.load(std::memory_order_relaxed); }
+    size_t getFullScans() const { return full_scans_.load(std::memory_order_relaxed); }
+    double getSkipRate() const;
+    double getEarlyExitRate() const;
+    
     // ═══════════════════════════════════════════════════════════════
     // CALLBACKS
     // ═══════════════════════════════════════════════════════════════
@@ -243,15 +278,34 @@ private:
     int frames_in_current_pattern_{0};
     double current_match_similarity_{0.0};
     
-    // Historique
-    std::deque<std::pair<std::string, std::chrono::steady_clock::time_point>> pattern_history_;
-    size_t max_history_size_{100};
+    // Historique (100 derniers patterns, capacité fixe)
+    RingBuffer<std::pair<std::string, std::chrono::steady_clock::time_point>> pattern_history_{100};
     
     // Statistiques
     size_t total_matches_{0};
     size_t patterns_created_{0};
     size_t transitions_recorded_{0};
     double sum_similarities_{0.0};
+    // Compteurs du matching incrémental (lus par les métriques hors étage)
+    std::atomic<size_t> skipped_matches_{0};
+    std::atomic<size_t> early_exits_{0};
+    std::atomic<size_t> full_scans_{0};
+    
+    // Dernier matching confirmé, réutilisé tant que la signature reste proche.
+    // Il ne dépend que des patterns de son top-k : un pattern créé ou modifié
+    // hors de ce top-k n'est pris en compte qu'au matching suivant. La
+    // consolidation du retenu vers la signature ne l'invalide pas (il est
+    // rescoré à chaque frame)
+    EmotionalSignature last_signature_{};
+    double last_signature_norm_{0.0};
+    std::shared_ptr<const MatchResult> last_result_;
+    uint64_t last_coefficients_revision_{0};           // Coefficients du retenu (copiés dans le résultat)
+    double last_alternative_score_{0.0};               // Meilleur score similarité × confiance des alternatives
+    std::vector<std::string> last_alternatives_;
+    std::vector<uint64_t> last_alternative_revisions_; // MLT::patternRevisions au moment du match
+    mutable std::vector<uint64_t> revision_scratch_;
+    mutable double reuse_similarity_{0.0};             // Similarité du retenu rescoré par canReuseLastMatch
+    bool has_last_match_{false};
     
     // Signatures non matchées (candidates pour nouveau pattern)
     std::vector<EmotionalSignature> unmatched_signatures_;
@@ -266,6 +320,11 @@ private:
                                         const std::vector<PatternMatch>& alternatives);
     MatchResult createResultForNewPattern(const EmotionalSignature& signature);
     bool shouldSwitchPattern(const PatternMatch& new_match) const;
+    MatchDecision decide(const std::vector<PatternMatch>& matches) const;
+    std::vector<PatternMatch> findCandidates(const EmotionalSignature& signature);
+    bool canReuseLastMatch(const EmotionalSignature& signature) const;
+    void anchorLastMatch(const EmotionalSignature& signature, const MatchResult& result);
+    std::shared_ptr<const MatchResult> reuseLastMatch();
     void updateHistory(const std::string& pattern_id);
     void analyzeUnmatchedSignatures();
 };
@@ -0,0 +1,121 @@
+/**
+ * @file PatternMatrix.hpp
+ * @brief Stockage colonnaire (SoA) des signatures de patterns MLT
+ *
+ * Les signatures sont rangées par colonne : la colonne i contient
+ * l'émotion i normalisée de tous les patterns, de façon contiguë. Le score
+ * de similarité d'un lot de patterns se calcule alors avec des accès
+ * séquentiels, 4 patterns par registre AVX2 (2 en NEON), sans parcourir
+ * les nœuds de la table de hachage de la MLT.
+ *
+ * La correspondance id → ligne est stable tant que le pattern existe ;
+ * la suppression déplace la dernière ligne dans le trou.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MCT.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcee {
+
+struct EmotionalPattern;
+
+/**
+ * @class PatternMatrix
+ * @brief Matrice de signatures pour le scoring vectorisé de la MLT
+ *
+ * Non thread-safe : protégée par le mutex de la MLT propriétaire.
+ * Les pointeurs conservés vers les EmotionalPattern restent valides car
+ * les nœuds d'un unordered_map ne bougent pas lors d'un rehash.
+ */
+class PatternMatrix {
+public:
+    static constexpr size_t DIM = 24;
+    static constexpr size_t LANES = 4;   // Granularité de remplissage (AVX2 double)
+
+    /**
+     * @brief Insère ou met à jour la ligne d'un pattern
+     * @param pattern Pattern (référence stable dans la table de la MLT)
+     */
+    void upsert(const EmotionalPattern& pattern);
+
+    /**
+     * @brief Retire la ligne d'un pattern
+     */
+    void remove(const std::string& pattern_id);
+
+    void clear();
+
+    // ═══════════════════════════════════════════════════════════════
+    // IMAGE BINAIRE (snapshot MLT)
+    // ═══════════════════════════════════════════════════════════════
+
+    /**
+     * @brief Nombre de doubles de l'image d'une matrice de rows lignes
+     *
+     * Image : colonnes paddées à LANES, contiguës, dans l'ordre
+     * mean[0..DIM), std[0..DIM), valence, arousal, valid.
+     */
+    static size_t imageSize(size_t rows);
+
+    /**
+     * @brief Copie les colonnes dans out (imageSize(size()) doubles)
+     */
+    void writeImage(double* out) const;
+
+    /**
+     * @brief Remplace le contenu par une image, sans recalcul des lignes
+     * @param image Colonnes au format de writeImage (ex. projection mmap)
+     * @param patterns Pattern de chaque ligne, dans l'ordre de l'image
+     */
+    void loadImage(const double* image, const std::vector<const EmotionalPattern*>& patterns);
+
+    /**
+     * @brief Similarité de la signature avec chaque ligne
+     * @param signature Signature MCT
+     * @param out Scores [0, 1], un par ligne (même formule que MLT::computeSimilarity)
+     * @param first_row Lignes précédentes non calculées (score 0)
+     */
+    void score(const EmotionalSignature& signature, std::vector<double>& out,
+               size_t first_row = 0) const;
+
+    /**
+     * @brief Similarité d'une ligne avec les lignes suivantes (recherche des fusions)
+     */
+    void scoreRow(size_t row, std::vector<double>& out) const;
+
+    [[nodiscard]] size_t size() const { return rows_; }
+    [[nodiscard]] bool isActive(size_t row) const { return active_[row] != 0; }
+    [[nodiscard]] const EmotionalPattern* patternAt(size_t row) const { return patterns_[row]; }
+    [[nodiscard]] const std::string& idAt(size_t row) const { return ids_[row]; }
+
+private:
+    size_t rows_{0};
+
+    // Colonnes d'émotions normalisées (longueur paddée à LANES)
+    std::array<std::vector<double>, DIM> mean_cols_;
+    std::array<std::vector<double>, DIM> std_cols_;
+    std::vector<double> valence_;
+    std::vector<double> arousal_;
+    std::vector<double> valid_;          // 0 si norme nulle (similarité forcée à 0)
+
+    // Métadonnées par ligne
+    std::vector<uint8_t> active_;
+    std::vector<const EmotionalPattern*> patterns_;
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, size_t> row_of_;
+
+    void writeRow(size_t row, const EmotionalPattern& pattern);
+    void moveRow(size_t from, size_t to);
+    void resizePadded(size_t rows);
+};
+
+} // namespace mcee
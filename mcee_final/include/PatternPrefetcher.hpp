@@ -0,0 +1,158 @@
+/**
+ * @file PatternPrefetcher.hpp
+ * @brief Préchargement des souvenirs et du contexte des patterns probables
+ *
+ * Les souvenirs, le cache HybridSearch et le contexte LLM qu'il contient
+ * étaient chargés après la détection d'une transition : l'entrée en PEUR
+ * payait un aller-retour Neo4j à froid au moment le plus critique. À chaque
+ * changement de pattern, le préchargeur lit les successeurs les plus
+ * probables dans la MLT (transition_probabilities) et, en tâche de fond :
+ * - remonte au niveau chaud du MemoryManager les souvenirs proches de la
+ *   signature du pattern cible (findSimilarInNeo4j : chaud, tiède, Neo4j) ;
+ * - exécute searchByLemmas sur ses mots déclencheurs et contextes, ce qui
+ *   place la réponse et son LLMContext dans le cache HybridSearch.
+ *
+ * Le travail est borné (max_targets cibles, max_pending tâches en file sur
+ * une voie BACKGROUND à une tâche à la fois) et annulé dès que la
+ * prédiction change. Le taux de succès compte les transitions observées
+ * vers une cible déjà préchargée.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MLT.hpp"
+#include "Executor.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mcee {
+
+class MemoryManager;
+class HybridSearchEngine;
+
+/**
+ * @brief Configuration du préchargement (section "prefetch")
+ */
+struct PrefetchConfig {
+    bool enabled = true;
+    size_t max_targets = 2;             // Successeurs préchargés par pattern courant
+    double min_probability = 0.15;      // Transitions plus rares ignorées
+    size_t memories_per_target = 5;     // Souvenirs remontés au niveau chaud par cible
+    double memory_threshold = 0.7;      // Similarité minimale des souvenirs préchargés
+    size_t max_pending = 4;             // Tâches en file au plus (au-delà : cible abandonnée)
+    bool warm_search = true;            // searchByLemmas sur les mots du pattern cible
+};
+
+/**
+ * @brief Compteurs du préchargement
+ */
+struct PrefetchStats {
+    uint64_t predictions = 0;   // Prédictions émises (changements de pattern)
+    uint64_t warmed = 0;        // Cibles entièrement préchargées
+    uint64_t cancelled = 0;     // Cibles abandonnées (prédiction changée, budget)
+    uint64_t hits = 0;          // Transition vers une cible préchargée
+    uint64_t late = 0;          // Transition vers une cible encore en cours
+    uint64_t misses = 0;        // Transition non prédite
+
+    [[nodiscard]] double hitRate() const {
+        const uint64_t total = hits + late + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @class PatternPrefetcher
+ * @brief Précharge les successeurs probables du pattern courant
+ *
+ * onPattern() est appelé par un seul thread (étage [match]) ; les tâches
+ * de préchargement s'exécutent sur l'Executor partagé.
+ */
+class PatternPrefetcher {
+public:
+    /**
+     * @param mlt Source des probabilités de transition
+     * @param memory Gestionnaire de souvenirs à réchauffer (doit survivre au préchargeur)
+     */
+    PatternPrefetcher(std::shared_ptr<const MLT> mlt, MemoryManager& memory,
+                      const PrefetchConfig& config = PrefetchConfig{});
+
+    /**
+     * @brief Annule et attend le préchargement en cours
+     */
+    ~PatternPrefetcher();
+
+    PatternPrefetcher(const PatternPrefetcher&) = delete;
+    PatternPrefetcher& operator=(const PatternPrefetcher&) = delete;
+
+    /**
+     * @brief Cache HybridSearch à réchauffer (nullptr : souvenirs seuls)
+     */
+    void setHybridSearch(std::shared_ptr<HybridSearchEngine> search);
+
+    void setConfig(const PrefetchConfig& config);
+    [[nodiscard]] PrefetchConfig getConfig() const;
+
+    /**
+     * @brief Nouveau pattern courant : compte la prédiction précédente
+     *        puis précharge les successeurs probables de pattern_id
+     *
+     * Sans effet si pattern_id est déjà le pattern courant.
+     */
+    void onPattern(const std::string& pattern_id);
+
+    /**
+     * @brief Annule les tâches en file et attend celle en cours
+     */
+    void stop();
+
+    /**
+     * @brief Cibles de la prédiction courante (probabilité décroissante)
+     */
+    [[nodiscard]] std::vector<std::string> predictedTargets() const;
+
+    [[nodiscard]] PrefetchStats getStats() const;
+
+private:
+    /**
+     * @brief Cible de la prédiction courante
+     */
+    struct Target {
+        std::string pattern_id;
+        bool warmed = false;
+    };
+
+    /**
+     * @brief Précharge une cible (tâche de la voie)
+     */
+    void warm(const TransitionForecast& forecast, uint64_t generation, const CancellationToken& token);
+
+    std::shared_ptr<const MLT> mlt_;
+    MemoryManager& memory_;
+    std::shared_ptr<HybridSearchEngine> search_;
+
+    mutable std::mutex mutex_;           // config_, current_, targets_, generation_, source_
+    PrefetchConfig config_;
+    std::string current_;
+    std::vector<Target> targets_;
+    uint64_t generation_ = 0;            // Incrémentée à chaque nouvelle prédiction
+    CancellationSource source_;
+
+    TaskLane lane_;
+
+    std::atomic<uint64_t> predictions_{0};
+    std::atomic<uint64_t> warmed_{0};
+    std::atomic<uint64_t> cancelled_{0};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> late_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace mcee
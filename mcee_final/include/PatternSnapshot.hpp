@@ -0,0 +1,176 @@
+/**
+ * @file PatternSnapshot.hpp
+ * @brief Format binaire versionné des patterns MLT, lu par projection mémoire
+ *
+ * Alternative au JSON pour le démarrage et les checkpoints : le fichier
+ * est projeté (mmap) puis lu en place, sans DOM intermédiaire.
+ *
+ * Disposition (little-endian, sections alignées sur 8 octets) :
+ *   [en-tête]      SnapshotHeader, 128 octets
+ *   [image]        colonnes de PatternMatrix (cf. PatternMatrix::writeImage),
+ *                  copiées telles quelles dans le matcher
+ *   [records]      un PatternRecord de taille fixe par ligne de l'image
+ *   [refs]         StringRef des listes (parents, enfants, contextes, mots)
+ *   [transitions]  TransitionRecord (cible, probabilité)
+ *   [strings]      table des chaînes UTF-8, non terminées
+ *
+ * Le checksum (FNV-1a par mots de 64 bits) couvre tout ce qui suit
+ * l'en-tête ; un fichier tronqué ou d'une autre version est refusé.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MLT.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcee {
+
+constexpr uint32_t PATTERN_SNAPSHOT_VERSION = 1;
+
+namespace snapshot_format {
+
+struct StringRef {
+    uint32_t offset;   // Dans la table des chaînes
+    uint32_t length;
+};
+
+struct RangeRef {
+    uint32_t first;    // Premier élément (refs ou transitions)
+    uint32_t count;
+};
+
+struct TransitionRecord {
+    StringRef target;
+    double probability;
+};
+
+struct PatternRecord {
+    StringRef id;
+    StringRef name;
+    StringRef description;
+
+    double mean_emotions[24];
+    double std_dev[24];
+    double trend[24];
+    double acceleration[24];
+    double peak_position[24];
+    int32_t oscillation_count[24];
+    double global_intensity;
+    double global_valence;
+    double global_arousal;
+    double stability;
+    double dominant_frequency;
+
+    double alpha, beta, gamma, delta, theta;
+    double emergency_threshold;
+    double memory_trigger_threshold;
+    double confidence;
+    double average_duration_seconds;
+
+    int64_t created_at_ms;      // Epoch, horloge système
+    int64_t last_activated_ms;
+    int64_t last_modified_ms;
+    int32_t activation_count;
+    uint32_t flags;             // FLAG_*
+
+    RangeRef parent_ids;
+    RangeRef child_ids;
+    RangeRef associated_contexts;
+    RangeRef trigger_words;
+    RangeRef transitions;
+};
+
+constexpr uint32_t FLAG_BASE = 1u << 0;
+constexpr uint32_t FLAG_ACTIVE = 1u << 1;
+constexpr uint32_t FLAG_LOCKED = 1u << 2;
+
+struct SnapshotHeader {
+    char magic[4];              // "MLTP"
+    uint32_t version;
+    uint32_t dim;               // Émotions par signature (24)
+    uint32_t record_size;       // sizeof(PatternRecord) à l'écriture
+    uint64_t pattern_count;
+    uint64_t image_offset;
+    uint64_t records_offset;
+    uint64_t refs_offset;
+    uint64_t ref_count;
+    uint64_t transitions_offset;
+    uint64_t transition_count;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t file_size;
+    uint64_t checksum;
+    double min_similarity_threshold;
+    double high_similarity_threshold;
+    double learning_rate;
+};
+
+static_assert(sizeof(SnapshotHeader) == 128, "disposition de l'en-tête figée par la version");
+static_assert(sizeof(PatternRecord) % 8 == 0, "records alignés sur 8 octets");
+
+} // namespace snapshot_format
+
+/**
+ * @brief Vrai si le fichier commence par la signature "MLTP"
+ */
+bool isPatternSnapshotFile(const std::string& path);
+
+/**
+ * @brief Encode les patterns d'une matrice, dans l'ordre de ses lignes
+ * @param matrix Matrice de la MLT (ses lignes pointent vers les patterns)
+ * @param config Seuils sauvegardés avec les patterns (comme le JSON)
+ */
+std::string encodePatternSnapshot(const PatternMatrix& matrix, const MLTConfig& config);
+
+/**
+ * @class PatternSnapshotReader
+ * @brief Lecture en place d'un snapshot projeté en mémoire
+ *
+ * open() valide l'en-tête, le checksum et toutes les références ; les
+ * accesseurs ne refont aucune vérification.
+ */
+class PatternSnapshotReader {
+public:
+    /**
+     * @param error [out] Raison du refus
+     */
+    bool open(const std::string& path, std::string* error = nullptr);
+
+    [[nodiscard]] size_t size() const { return static_cast<size_t>(header_.pattern_count); }
+
+    /**
+     * @brief Image colonnaire, à passer à PatternMatrix::loadImage
+     */
+    [[nodiscard]] const double* image() const;
+
+    /**
+     * @brief Matérialise le pattern de la ligne index
+     */
+    void readPattern(size_t index, EmotionalPattern& out) const;
+
+    /**
+     * @brief Restaure les seuils sauvegardés
+     */
+    void applyConfig(MLTConfig& config) const;
+
+private:
+    MappedFile file_;
+    snapshot_format::SnapshotHeader header_{};
+
+    [[nodiscard]] const unsigned char* at(uint64_t offset) const { return file_.data() + offset; }
+    [[nodiscard]] snapshot_format::PatternRecord record(size_t index) const;
+    [[nodiscard]] snapshot_format::StringRef ref(uint32_t index) const;
+    [[nodiscard]] std::string_view string(const snapshot_format::StringRef& s) const;
+    [[nodiscard]] std::vector<std::string> strings(const snapshot_format::RangeRef& range) const;
+
+    bool validate(std::string* error);
+};
+
+} // namespace mcee
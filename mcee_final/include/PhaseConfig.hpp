@@ -9,10 +9,39 @@
 #define MCEE_PHASE_CONFIG_HPP
 
 #include "Types.hpp"
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 
 namespace mcee {
 
+constexpr size_t NUM_PHASES = 8;
+
+[[nodiscard]] constexpr size_t phaseIndex(Phase phase) noexcept {
+    return static_cast<size_t>(phase);
+}
+
+/**
+ * @brief Tableau dense indexé par Phase (une case par valeur de l'énumération)
+ */
+template <typename T>
+struct PhaseTable {
+    std::array<T, NUM_PHASES> values{};
+
+    [[nodiscard]] constexpr T& operator[](Phase phase) noexcept { return values[phaseIndex(phase)]; }
+    [[nodiscard]] constexpr const T& operator[](Phase phase) const noexcept {
+        return values[phaseIndex(phase)];
+    }
+
+    /// Accès vérifié (Phase hors énumération, ex. valeur désérialisée)
+    [[nodiscard]] constexpr const T& at(Phase phase) const {
+        if (phaseIndex(phase) >= NUM_PHASES) throw std::out_of_range("Phase hors table");
+        return values[phaseIndex(phase)];
+    }
+
+    [[nodiscard]] static constexpr size_t size() noexcept { return NUM_PHASES; }
+};
+
 /**
  * @brief Configurations par défaut des 8 phases émotionnelles
  * 
@@ -27,9 +56,9 @@ namespace mcee {
  * - Learning rate: Vitesse d'adaptation
  * - Focus: Filtrage attentionnel
  */
-inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
+inline constexpr PhaseTable<PhaseConfig> DEFAULT_PHASE_CONFIGS = {{{
     // SÉRÉNITÉ: Équilibre, apprentissage optimal
-    {Phase::SERENITE, {
+    PhaseConfig{
         .alpha = 0.25,                  // Feedback externe modéré
         .beta = 0.15,                   // Feedback interne bas
         .gamma = 0.12,                  // Décroissance normale
@@ -40,10 +69,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 1.0,
         .focus = 0.5,
         .priority = 1
-    }},
+    },
     
     // JOIE: Euphorie, renforcement positif
-    {Phase::JOIE, {
+    PhaseConfig{
         .alpha = 0.40,                  // Feedback externe élevé
         .beta = 0.25,                   // Feedback interne modéré
         .gamma = 0.08,                  // Décroissance lente
@@ -54,10 +83,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 1.3,
         .focus = 0.3,
         .priority = 2
-    }},
+    },
     
     // EXPLORATION: Apprentissage maximal, attention focalisée
-    {Phase::EXPLORATION, {
+    PhaseConfig{
         .alpha = 0.35,                  // Feedback externe élevé (perception)
         .beta = 0.10,                   // Feedback interne bas (focus externe)
         .gamma = 0.10,                  // Décroissance normale
@@ -68,10 +97,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 1.5,           // Apprentissage MAXIMAL
         .focus = 0.8,
         .priority = 2
-    }},
+    },
     
     // ANXIÉTÉ: Hypervigilance, biais négatif
-    {Phase::ANXIETE, {
+    PhaseConfig{
         .alpha = 0.40,                  // Feedback externe élevé
         .beta = 0.30,                   // Feedback interne élevé (stress)
         .gamma = 0.06,                  // Décroissance lente (persistant)
@@ -82,10 +111,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 0.8,
         .focus = 0.6,
         .priority = 3
-    }},
+    },
     
     // PEUR △!: URGENCE - Traumas dominants, réflexes
-    {Phase::PEUR, {
+    PhaseConfig{
         .alpha = 0.60,                  // Feedback externe MAXIMAL (danger!)
         .beta = 0.45,                   // Feedback interne ÉLEVÉ (stress)
         .gamma = 0.02,                  // Décroissance TRÈS LENTE (persistant)
@@ -96,10 +125,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 0.3,           // Pas d'apprentissage rationnel
         .focus = 0.95,                  // Focus MAXIMAL sur menace
         .priority = 5                   // PRIORITÉ MAXIMALE
-    }},
+    },
     
     // TRISTESSE: Rumination, introspection
-    {Phase::TRISTESSE, {
+    PhaseConfig{
         .alpha = 0.20,                  // Feedback externe bas (repli)
         .beta = 0.40,                   // Feedback interne élevé (rumination)
         .gamma = 0.05,                  // Décroissance très lente
@@ -110,10 +139,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 0.6,
         .focus = 0.4,
         .priority = 3
-    }},
+    },
     
     // DÉGOÛT: Évitement, associations négatives
-    {Phase::DEGOUT, {
+    PhaseConfig{
         .alpha = 0.50,                  // Feedback externe élevé (réactif)
         .beta = 0.25,                   // Feedback interne modéré
         .gamma = 0.08,                  // Décroissance normale
@@ -124,10 +153,10 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 0.9,
         .focus = 0.7,
         .priority = 4
-    }},
+    },
     
     // CONFUSION: Recherche d'info, incertitude
-    {Phase::CONFUSION, {
+    PhaseConfig{
         .alpha = 0.35,                  // Feedback externe modéré
         .beta = 0.30,                   // Feedback interne (incertitude)
         .gamma = 0.15,                  // Décroissance rapide (instable)
@@ -138,9 +167,75 @@ inline const std::unordered_map<Phase, PhaseConfig> DEFAULT_PHASE_CONFIGS = {
         .learning_rate = 0.7,
         .focus = 0.5,
         .priority = 2
-    }}
+    }
+}}};
+
+static_assert(DEFAULT_PHASE_CONFIGS[Phase::PEUR].priority == 5, "ordre des phases de la table");
+static_assert(DEFAULT_PHASE_CONFIGS[Phase::CONFUSION].gamma == 0.15, "ordre des phases de la table");
+
+/**
+ * @brief Terme d'un score de phase : weight·E_i, ou weight·(1 - E_i) si inverted
+ */
+struct PhaseScoreTerm {
+    size_t emotion = 0;
+    double weight = 0.0;
+    bool inverted = false;
 };
 
+/**
+ * @brief Termes des scores de phase (au plus 4 par phase, ordre de Phase)
+ */
+inline constexpr size_t MAX_PHASE_SCORE_TERMS = 4;
+inline constexpr PhaseTable<std::array<PhaseScoreTerm, MAX_PHASE_SCORE_TERMS>> DEFAULT_PHASE_SCORE_TERMS = {{{
+    // SÉRÉNITÉ: calme élevé, émotions équilibrées
+    {{{EMO_CALME, 0.4}, {EMO_SATISFACTION, 0.3}, {EMO_ANXIETE, 0.2, true}, {EMO_PEUR, 0.1, true}}},
+    // JOIE: joie et excitation élevées
+    {{{EMO_JOIE, 0.5}, {EMO_EXCITATION, 0.25}, {EMO_SATISFACTION, 0.15}, {EMO_TRISTESSE, 0.1, true}}},
+    // EXPLORATION: intérêt et fascination élevés
+    {{{EMO_INTERET, 0.35}, {EMO_FASCINATION, 0.35}, {EMO_EXCITATION, 0.2}, {EMO_PEUR, 0.1, true}}},
+    // ANXIÉTÉ: anxiété élevée sans peur extrême
+    {{{EMO_ANXIETE, 0.5}, {EMO_CONFUSION, 0.2}, {EMO_CALME, 0.2, true}, {EMO_PEUR, 0.1}}},
+    // PEUR: peur et horreur élevées
+    {{{EMO_PEUR, 0.4}, {EMO_HORREUR, 0.4}, {EMO_ANXIETE, 0.15}, {EMO_CALME, 0.05, true}}},
+    // TRISTESSE: tristesse élevée
+    {{{EMO_TRISTESSE, 0.5}, {EMO_NOSTALGIE, 0.25}, {EMO_JOIE, 0.15, true}, {EMO_EXCITATION, 0.1, true}}},
+    // DÉGOÛT: dégoût élevé
+    {{{EMO_DEGOUT, 0.6}, {EMO_SATISFACTION, 0.2, true}, {EMO_HORREUR, 0.2}}},
+    // CONFUSION: confusion élevée
+    {{{EMO_CONFUSION, 0.5}, {EMO_ANXIETE, 0.2}, {EMO_CALME, 0.2, true}, {EMO_SATISFACTION, 0.1, true}}}
+}}};
+
+/**
+ * @brief Scores de phase sous forme affine : score_p = bias_p + Σ_i W[p][i]·E_i
+ *
+ * Un terme inversé w·(1 - E_i) contribue w au biais et -w au poids. Les
+ * huit lignes de 24 poids (dont une vingtaine seulement non nuls) tiennent
+ * en 1,5 Ko : le produit complet reste en L1 et se vectorise sans branche.
+ */
+struct PhaseScoreMatrix {
+    static_assert(NUM_EMOTIONS % 4 == 0, "lignes parcourues par blocs de 4 émotions");
+
+    std::array<std::array<double, NUM_EMOTIONS>, NUM_PHASES> weights{};
+    std::array<double, NUM_PHASES> bias{};
+
+    [[nodiscard]] static constexpr PhaseScoreMatrix fromTerms(
+        const PhaseTable<std::array<PhaseScoreTerm, MAX_PHASE_SCORE_TERMS>>& terms) noexcept
+    {
+        PhaseScoreMatrix m;
+        for (size_t p = 0; p < NUM_PHASES; ++p) {
+            for (const auto& term : terms.values[p]) {
+                if (term.weight == 0.0) continue;
+                m.weights[p][term.emotion] += term.inverted ? -term.weight : term.weight;
+                if (term.inverted) m.bias[p] += term.weight;
+            }
+        }
+        return m;
+    }
+};
+
+inline constexpr PhaseScoreMatrix DEFAULT_PHASE_SCORE_MATRIX =
+    PhaseScoreMatrix::fromTerms(DEFAULT_PHASE_SCORE_TERMS);
+
 /**
  * @brief Émotions critiques pour Amyghaleon
  */
@@ -151,10 +246,10 @@ inline const std::array<std::string, 3> CRITICAL_EMOTIONS = {
 /**
  * @brief Indices des émotions critiques
  */
-inline const std::array<size_t, 3> CRITICAL_EMOTION_INDICES = {
-    14,  // Peur
-    15,  // Horreur
-    4    // Anxiété
+inline constexpr std::array<size_t, 3> CRITICAL_EMOTION_INDICES = {
+    EMO_PEUR,
+    EMO_HORREUR,
+    EMO_ANXIETE
 };
 
 /**
@@ -11,8 +11,8 @@
 #include "Types.hpp"
 #include "PhaseConfig.hpp"
 #include <chrono>
-#include <unordered_map>
 #include <functional>
+#include <span>
 
 namespace mcee {
 
@@ -25,10 +25,16 @@ namespace mcee {
  * - L'hystérésis pour éviter les oscillations
  * - La durée minimale dans une phase
  * - Les transitions d'urgence vers PEUR
+ *
+ * Les scores sont un produit matrice 24×8 (DEFAULT_PHASE_SCORE_MATRIX) par
+ * le vecteur d'émotions, dans un PhaseTable<double> : ni allocation ni
+ * recherche par clé. La pondération de priorité est une table de facteurs
+ * recalculée au chargement de la configuration.
  */
 class PhaseDetector {
 public:
     using TransitionCallback = std::function<void(Phase from, Phase to, double duration)>;
+    using PhaseScores = PhaseTable<double>;
 
     /**
      * @brief Constructeur
@@ -47,6 +53,25 @@ public:
      */
     Phase detectPhase(const EmotionalState& state);
 
+    /**
+     * @brief Scores normalisés (max = 1) de chaque phase pour un lot d'états
+     *
+     * Sans effet sur l'état du détecteur (rejeu, hôte multi-sessions).
+     * @param states États émotionnels
+     * @param out Scores, un par état (out.size() >= states.size())
+     */
+    static void scorePhases(std::span<const EmotionalState> states, std::span<PhaseScores> out) noexcept;
+
+    /**
+     * @brief Scores normalisés (max = 1) d'un état
+     */
+    [[nodiscard]] static PhaseScores scorePhases(const EmotionalState& state) noexcept;
+
+    /**
+     * @brief Phase de meilleur score pondéré par la priorité (première en cas d'égalité)
+     */
+    [[nodiscard]] Phase bestPhase(const PhaseScores& scores) const noexcept;
+
     /**
      * @brief Retourne la configuration de la phase actuelle
      * @return PhaseConfig avec les coefficients
@@ -108,7 +133,8 @@ private:
     // Configuration
     double hysteresis_margin_;
     double min_phase_duration_s_;
-    std::unordered_map<Phase, PhaseConfig> phase_configs_;
+    PhaseTable<PhaseConfig> phase_configs_;
+    PhaseTable<double> priority_weights_;    // 1 + 0.1·priorité
     
     // Statistiques
     size_t transition_count_ = 0;
@@ -117,11 +143,14 @@ private:
     TransitionCallback on_transition_;
 
     /**
-     * @brief Calcule les scores pour chaque phase
-     * @param state État émotionnel
-     * @return Map phase -> score
+     * @brief Scores bruts (non normalisés) de chaque phase
+     */
+    [[nodiscard]] static PhaseScores computePhaseScores(const EmotionalState& state) noexcept;
+
+    /**
+     * @brief Recalcule priority_weights_ depuis phase_configs_
      */
-    std::unordered_map<Phase, double> computePhaseScores(const EmotionalState& state) const;
+    void refreshPriorityWeights() noexcept;
 
     /**
      * @brief Vérifie si une transition d'urgence est nécessaire
@@ -144,14 +173,11 @@ private:
 
     /**
      * @brief Applique l'hystérésis pour éviter les oscillations
-     * @param scores Scores des phases
+     * @param scores Scores normalisés des phases
      * @param best_phase Meilleure phase candidate
      * @return true si transition autorisée
      */
-    bool applyHysteresis(
-        const std::unordered_map<Phase, double>& scores,
-        Phase best_phase
-    ) const;
+    [[nodiscard]] bool applyHysteresis(const PhaseScores& scores, Phase best_phase) const noexcept;
 };
 
 } // namespace mcee
@@ -0,0 +1,69 @@
+/**
+ * @file PromptTemplate.hpp
+ * @brief Gabarits de prompt compilés en segments
+ *
+ * Un gabarit est analysé une seule fois en une suite de segments : texte
+ * littéral, emplacement {{nom}} et section {{#nom}}...{{/nom}}, rendue
+ * seulement si l'emplacement correspondant est non vide. Le rendu ne fait
+ * que concaténer les segments dans un tampon fourni par l'appelant, qui
+ * garde sa capacité d'un prompt à l'autre.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @class PromptTemplate
+ * @brief Gabarit précompilé : littéraux, emplacements et sections conditionnelles
+ */
+class PromptTemplate {
+public:
+    PromptTemplate() = default;
+
+    /**
+     * @brief Compile un gabarit
+     * @param text Gabarit ({{nom}}, {{#nom}}...{{/nom}})
+     * @param slots Noms des emplacements, dans l'ordre des valeurs de render()
+     * @param error Renseigné si le gabarit est invalide (emplacement inconnu,
+     *              section mal fermée)
+     * @return Gabarit compilé, ou nullopt si invalide
+     */
+    static std::optional<PromptTemplate> compile(std::string_view text,
+                                                 const std::vector<std::string>& slots,
+                                                 std::string* error = nullptr);
+
+    /**
+     * @brief Rend le gabarit dans out (vidé, capacité conservée)
+     * @param values Une valeur par emplacement, dans l'ordre de compile()
+     */
+    void render(std::span<const std::string_view> values, std::string& out) const;
+
+    [[nodiscard]] size_t slotCount() const { return slot_count_; }
+    [[nodiscard]] bool empty() const { return segments_.empty(); }
+
+private:
+    struct Segment {
+        enum class Kind : uint8_t { LITERAL, SLOT, SECTION };
+        Kind kind;
+        uint32_t slot;      // SLOT, SECTION : index de l'emplacement
+        uint32_t offset;    // LITERAL : position dans literals_
+        uint32_t length;    // LITERAL : longueur ; SECTION : segments à sauter si vide
+    };
+
+    std::string literals_;          // Littéraux concaténés
+    std::vector<Segment> segments_;
+    size_t slot_count_ = 0;
+};
+
+} // namespace mcee
@@ -0,0 +1,151 @@
+/**
+ * @file PublishPolicy.hpp
+ * @brief Publication de l'état pilotée par les changements, à débit borné
+ *
+ * publishState envoyait un message par trame traitée : le module rêves,
+ * les consommateurs de décisions et les tableaux de bord relisaient chacun
+ * autant d'états qu'il en arrivait, même inchangés. La politique ne retient
+ * un état que s'il diffère du dernier publié (E_global, émotion dominante,
+ * pattern) ou si le dernier envoi date de plus de heartbeat_seconds :
+ * - un changement de pattern est publié immédiatement, avec le lot en cours ;
+ * - les autres sont limités à max_rate_hz, le plus récent remplaçant
+ *   celui en attente (le dernier l'emporte) ;
+ * - en binaire, jusqu'à batch_max états partent dans un même message
+ *   (EmotionBatch), au plus tard batch_delay_ms après le premier.
+ *
+ * Les urgences Amyghaleon ne passent pas par la politique : elles sont
+ * publiées sur leur propre channel dès leur détection.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "Types.hpp"
+#include "PatternMatcher.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Configuration de la politique (section "publish")
+ */
+struct PublishPolicyConfig {
+    bool enabled = false;               // false : un message par trame (comportement historique)
+    double min_e_global_delta = 0.02;   // Écart d'E_global au dernier publié rendant l'état significatif
+    bool on_dominant_change = true;     // Changement d'émotion dominante significatif
+    double max_rate_hz = 20.0;          // Messages non urgents par seconde au plus (0 : illimité)
+    double heartbeat_seconds = 1.0;     // État republié au moins aussi souvent (0 : jamais)
+    size_t batch_max = 1;               // États par message (binaire uniquement ; 1 : pas de lot)
+    int batch_delay_ms = 50;            // Âge maximal d'un lot incomplet
+};
+
+/**
+ * @brief État retenu pour publication
+ */
+struct PublishItem {
+    EmotionalState state;
+    std::shared_ptr<const MatchResult> match;
+    int64_t trace = 0;          // Estampille de la trame d'origine (RabbitMQConfig::trace_header)
+};
+
+/**
+ * @brief Compteurs de la politique
+ */
+struct PublishStats {
+    uint64_t offered = 0;       // États proposés
+    uint64_t published = 0;     // États publiés
+    uint64_t suppressed = 0;    // Non significatifs (ou revenus près du dernier publié)
+    uint64_t coalesced = 0;     // Remplacés par un plus récent avant publication
+    uint64_t immediate = 0;     // Publiés sans attendre (changement de pattern)
+    uint64_t messages = 0;      // Messages émis (un lot compte pour un)
+};
+
+/**
+ * @class StatePublishPolicy
+ * @brief Décide quels états publier, et quand
+ *
+ * offer() et flush() sont appelés par l'étage [persist] (ou sous
+ * state_mutex_ en synchrone) ; hasPending() peut être lu depuis une minuterie.
+ */
+class StatePublishPolicy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit StatePublishPolicy(const PublishPolicyConfig& config = PublishPolicyConfig{});
+
+    void setConfig(const PublishPolicyConfig& config);
+    [[nodiscard]] PublishPolicyConfig getConfig() const;
+
+    /**
+     * @brief Propose un état traité
+     * @param dominant Indice de l'émotion dominante (EmotionSummary)
+     * @param out [out] États à publier maintenant, en un seul message si plusieurs
+     * @param trace Estampille de la trame, portée par l'état retenu
+     */
+    void offer(const EmotionalState& state, size_t dominant, std::shared_ptr<const MatchResult> match,
+               Clock::time_point now, std::vector<PublishItem>& out, int64_t trace = 0);
+
+    /**
+     * @brief Publie l'état en attente dès que le débit le permet, et le lot échu
+     * @param force Tout émettre sans attendre (arrêt)
+     */
+    void flush(Clock::time_point now, std::vector<PublishItem>& out, bool force = false);
+
+    /**
+     * @brief Vrai si un état ou un lot attend (minuterie de vidange)
+     */
+    [[nodiscard]] bool hasPending() const { return has_pending_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Période de la minuterie de vidange
+     */
+    [[nodiscard]] Clock::duration flushInterval() const;
+
+    /**
+     * @brief Compte un message émis (lot ou état seul)
+     */
+    void recordMessage() { messages_.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] PublishStats getStats() const;
+
+private:
+    [[nodiscard]] bool rateAllows(Clock::time_point now) const;
+    void admit(PublishItem&& item, size_t dominant, Clock::time_point now);
+    void emitBatch(std::vector<PublishItem>& out);
+    void updatePending();
+
+    mutable std::mutex mutex_;                  // config_ et état de la politique
+    PublishPolicyConfig config_;
+
+    bool has_published_ = false;
+    double last_e_global_ = 0.0;                // Dernier état retenu (publié ou mis en lot)
+    size_t last_dominant_ = 0;
+    std::string last_pattern_id_;
+    Clock::time_point last_admit_{};            // Dernière admission (débit)
+
+    bool has_held_ = false;
+    PublishItem held_;                          // En attente du débit (le dernier l'emporte)
+    size_t held_dominant_ = 0;
+    std::vector<PublishItem> batch_;            // Admis, en attente de leur message
+    Clock::time_point batch_start_{};
+
+    std::atomic<bool> has_pending_{false};
+
+    std::atomic<uint64_t> offered_{0};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> suppressed_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> immediate_{0};
+    std::atomic<uint64_t> messages_{0};
+};
+
+} // namespace mcee
@@ -0,0 +1,137 @@
+/**
+ * @file ReplayEngine.hpp
+ * @brief Rejeu hors ligne de sessions enregistrées (SessionTrace)
+ *
+ * Rejoue une trace de messages à travers le pipeline complet, sans
+ * RabbitMQ ni attente : chaque session est un MCEEEngine hébergé
+ * (synchrone, sans channel de publication) exécuté sur un thread du pool,
+ * pendant que SessionClock lui présente le temps de la trace. Δt, fenêtres
+ * MCT/MCTGraph et durées de phases sont donc ceux de l'enregistrement, et
+ * une heure de session se rejoue en quelques secondes.
+ *
+ * Sert à comparer des configurations (seuils du PatternMatcher, paramètres
+ * de la MLT) sur le même trafic : statistiques agrégées et trace JSONL des
+ * décisions (pattern retenu, similarité, création, urgences) par trame.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MCEEEngine.hpp"
+#include "SessionTrace.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Configuration d'un rejeu
+ */
+struct ReplayConfig {
+    size_t threads = 0;                         // Sessions rejouées en parallèle (0 : cœurs disponibles)
+    std::string config_path;                    // Configuration moteur (phases), comme MCEEHost
+    std::string patterns_path;                  // Patterns initiaux (vide : patterns de base)
+    bool shared_mlt = false;                    // Patterns chargés une fois pour toutes les sessions (chacune apprend dans sa couche)
+    MLTConfig mlt;                              // Paramètres de la MLT rejouée
+    PatternMatcherConfig pattern_matcher;       // Seuils appliqués à chaque session
+    std::string output_path;                    // Trace JSONL des décisions (vide : aucune)
+    bool graph_ticks = true;                    // graphTick au rythme snapshot_interval du temps de trace
+};
+
+/**
+ * @brief Lit les sections "replay", "mlt" et "pattern_matcher" d'un fichier JSON
+ * @return false si le fichier est illisible (config inchangée)
+ */
+bool readReplayConfig(const std::string& path, ReplayConfig& config);
+
+/**
+ * @brief Résultat d'une session rejouée
+ */
+struct ReplaySessionResult {
+    std::string session_id;
+    size_t messages = 0;
+    size_t frames = 0;                          // Trames ayant traversé le pipeline
+    size_t pattern_switches = 0;                // Changements de pattern entre trames
+    size_t new_patterns = 0;
+    size_t emergencies = 0;
+    double trace_seconds = 0.0;                 // Durée couverte par la trace
+    double wall_seconds = 0.0;
+    std::string final_pattern;
+    double final_wisdom = 0.0;
+};
+
+/**
+ * @brief Statistiques agrégées d'un rejeu
+ */
+struct ReplayStats {
+    size_t sessions = 0;
+    size_t messages = 0;
+    size_t emotion_messages = 0;
+    size_t speech_messages = 0;
+    size_t token_messages = 0;
+    size_t frames = 0;
+    size_t pattern_switches = 0;
+    size_t new_patterns = 0;
+    size_t emergencies = 0;
+    double mean_similarity = 0.0;
+    double mean_confidence = 0.0;
+    std::map<std::string, size_t> pattern_frames;   // Trames par pattern retenu
+    double trace_seconds = 0.0;                     // Somme des durées de sessions
+    double wall_seconds = 0.0;
+
+    [[nodiscard]] double speedup() const {
+        return wall_seconds > 0.0 ? trace_seconds / wall_seconds : 0.0;
+    }
+
+    [[nodiscard]] nlohmann::json toJson() const;
+};
+
+/**
+ * @class ReplayEngine
+ * @brief Rejoue une trace, une session par thread à la fois
+ */
+class ReplayEngine {
+public:
+    explicit ReplayEngine(ReplayConfig config = ReplayConfig{});
+
+    /**
+     * @brief Rejoue toutes les sessions de la trace
+     *
+     * Bloquant ; les sessions les plus longues partent en premier.
+     */
+    ReplayStats run(const TraceReader& trace);
+
+    [[nodiscard]] const std::vector<ReplaySessionResult>& getSessionResults() const {
+        return session_results_;
+    }
+
+    [[nodiscard]] const ReplayConfig& getConfig() const { return config_; }
+
+private:
+    struct SessionStats {
+        size_t frames = 0;
+        size_t pattern_switches = 0;
+        size_t new_patterns = 0;
+        double similarity_sum = 0.0;
+        double confidence_sum = 0.0;
+        std::map<std::string, size_t> pattern_frames;
+    };
+
+    ReplayConfig config_;
+    std::vector<ReplaySessionResult> session_results_;
+
+    std::shared_ptr<MLT> createMLT() const;
+
+    /**
+     * @param events Indices des messages de la session, par temps croissant
+     * @param decisions [out] Lignes JSONL de la trace des décisions
+     */
+    ReplaySessionResult replaySession(const TraceReader& trace, const std::vector<size_t>& events,
+                                      const SharedEngineResources& shared, double t0,
+                                      SessionStats& stats, std::string* decisions) const;
+};
+
+} // namespace mcee
@@ -0,0 +1,151 @@
+/**
+ * @file RingBuffer.hpp
+ * @brief Tampon circulaire à capacité fixe
+ *
+ * Remplace std::deque pour les fenêtres glissantes : stockage contigu
+ * alloué une fois, push_back/pop_front en O(1) sans allocation, accès
+ * indexé depuis l'élément le plus ancien.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @class RingBuffer
+ * @brief File circulaire bornée (index 0 = plus ancien)
+ *
+ * push_back sur un tampon plein écrase l'élément le plus ancien.
+ * Non thread-safe.
+ */
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 1)
+        : storage_(capacity < 1 ? 1 : capacity) {}
+
+    /**
+     * @brief Ajoute un élément en fin (écrase le plus ancien si plein)
+     */
+    void push_back(T value) {
+        if (count_ == storage_.size()) {
+            storage_[head_] = std::move(value);
+            head_ = wrap(head_ + 1);
+            return;
+        }
+        storage_[wrap(head_ + count_)] = std::move(value);
+        ++count_;
+    }
+
+    /**
+     * @brief Retire l'élément le plus ancien
+     */
+    void pop_front() {
+        if (count_ == 0) return;
+        storage_[head_] = T{};
+        head_ = wrap(head_ + 1);
+        --count_;
+    }
+
+    /**
+     * @brief Retire l'élément le plus récent
+     */
+    void pop_back() {
+        if (count_ == 0) return;
+        --count_;
+        storage_[wrap(head_ + count_)] = T{};
+    }
+
+    T& front() { return storage_[head_]; }
+    const T& front() const { return storage_[head_]; }
+    T& back() { return storage_[wrap(head_ + count_ - 1)]; }
+    const T& back() const { return storage_[wrap(head_ + count_ - 1)]; }
+
+    T& operator[](size_t i) { return storage_[wrap(head_ + i)]; }
+    const T& operator[](size_t i) const { return storage_[wrap(head_ + i)]; }
+
+    [[nodiscard]] size_t size() const { return count_; }
+    [[nodiscard]] bool empty() const { return count_ == 0; }
+    [[nodiscard]] bool full() const { return count_ == storage_.size(); }
+    [[nodiscard]] size_t capacity() const { return storage_.size(); }
+
+    void clear() {
+        for (size_t i = 0; i < count_; ++i) {
+            (*this)[i] = T{};
+        }
+        head_ = 0;
+        count_ = 0;
+    }
+
+    /**
+     * @brief Change la capacité en conservant les éléments les plus récents
+     */
+    void setCapacity(size_t capacity) {
+        if (capacity < 1) capacity = 1;
+        if (capacity == storage_.size()) return;
+
+        std::vector<T> next(capacity);
+        size_t keep = count_ < capacity ? count_ : capacity;
+        for (size_t i = 0; i < keep; ++i) {
+            next[i] = std::move((*this)[count_ - keep + i]);
+        }
+        storage_ = std::move(next);
+        head_ = 0;
+        count_ = keep;
+    }
+
+    // ═══════════════════════════════════════════════════════════════
+    // ITÉRATION (du plus ancien au plus récent)
+    // ═══════════════════════════════════════════════════════════════
+
+    template <typename Owner, typename Ref>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::remove_reference_t<Ref>*;
+        using reference = Ref;
+
+        Iterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+        Ref operator*() const { return (*owner_)[index_]; }
+        pointer operator->() const { return &(*owner_)[index_]; }
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+        bool operator==(const Iterator& o) const { return index_ == o.index_; }
+        bool operator!=(const Iterator& o) const { return index_ != o.index_; }
+
+    private:
+        Owner* owner_;
+        size_t index_;
+    };
+
+    using iterator = Iterator<RingBuffer, T&>;
+    using const_iterator = Iterator<const RingBuffer, const T&>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count_); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count_); }
+
+private:
+    std::vector<T> storage_;
+    size_t head_{0};
+    size_t count_{0};
+
+    size_t wrap(size_t i) const {
+        size_t cap = storage_.size();
+        return i >= cap ? i - cap : i;
+    }
+};
+
+} // namespace mcee
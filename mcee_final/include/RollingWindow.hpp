@@ -0,0 +1,133 @@
+/**
+ * @file RollingWindow.hpp
+ * @brief Fenêtre glissante à capacité fixe avec statistiques en O(1)
+ *
+ * RingBuffer de valeurs numériques accompagné d'accumulateurs mis à jour
+ * à chaque push_back : somme, somme des carrés, Σ k·x_k (k = rang depuis
+ * le plus ancien) pour la pente des moindres carrés, et moyenne mobile
+ * exponentielle. Moyenne, variance, pente et EMA se lisent sans parcourir
+ * la fenêtre ; l'empreinte mémoire est fixée à la construction.
+ *
+ * Les retraits soustraient des valeurs déjà sommées : pour borner la
+ * dérive d'arrondi, les accumulateurs sont recalculés exactement une
+ * fois par tour complet du tampon (coût amorti O(1)).
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "RingBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace mcee {
+
+/**
+ * @class RollingWindow
+ * @brief Fenêtre des `capacity` dernières valeurs (index 0 = plus ancienne)
+ *
+ * Non thread-safe (protégée par le verrou du moteur propriétaire).
+ */
+template <typename T = double>
+class RollingWindow {
+    static_assert(std::is_arithmetic_v<T>, "RollingWindow attend des valeurs numériques");
+
+public:
+    /**
+     * @param capacity Nombre de valeurs conservées
+     * @param ema_alpha Lissage de l'EMA (EMA_t = α·x_t + (1-α)·EMA_{t-1}, EMA_0 = 0)
+     */
+    explicit RollingWindow(size_t capacity = 1, double ema_alpha = 0.1)
+        : values_(capacity), ema_alpha_(ema_alpha) {}
+
+    void push_back(T value) {
+        const double x = static_cast<double>(value);
+
+        if (values_.full()) {
+            // Le plus ancien sort : les rangs des suivants baissent de 1
+            const double oldest = static_cast<double>(values_.front());
+            sum_ -= oldest;
+            sum_sq_ -= oldest * oldest;
+            weighted_sum_ -= sum_;
+        }
+        values_.push_back(value);
+        weighted_sum_ += static_cast<double>(values_.size() - 1) * x;
+        sum_ += x;
+        sum_sq_ += x * x;
+        ema_ = ema_alpha_ * x + (1.0 - ema_alpha_) * ema_;
+
+        if (++pushes_since_rebuild_ >= values_.capacity()) {
+            rebuild();
+        }
+    }
+
+    void clear() {
+        values_.clear();
+        sum_ = sum_sq_ = weighted_sum_ = 0.0;
+        ema_ = 0.0;
+        pushes_since_rebuild_ = 0;
+    }
+
+    /// Valeurs de la fenêtre, de la plus ancienne à la plus récente
+    [[nodiscard]] const RingBuffer<T>& values() const { return values_; }
+
+    [[nodiscard]] size_t size() const { return values_.size(); }
+    [[nodiscard]] bool empty() const { return values_.empty(); }
+    [[nodiscard]] size_t capacity() const { return values_.capacity(); }
+    [[nodiscard]] T back() const { return values_.back(); }
+
+    [[nodiscard]] double sum() const { return sum_; }
+
+    [[nodiscard]] double mean() const {
+        return values_.empty() ? 0.0 : sum_ / static_cast<double>(values_.size());
+    }
+
+    /// Variance de population
+    [[nodiscard]] double variance() const {
+        if (values_.empty()) return 0.0;
+        const double n = static_cast<double>(values_.size());
+        const double m = sum_ / n;
+        return std::max(0.0, sum_sq_ / n - m * m);
+    }
+
+    [[nodiscard]] double stddev() const { return std::sqrt(variance()); }
+
+    /// Pente des moindres carrés de x en fonction du rang (unité : par échantillon)
+    [[nodiscard]] double slope() const {
+        const size_t count = values_.size();
+        if (count < 2) return 0.0;
+        const double n = static_cast<double>(count);
+        const double sum_k = n * (n - 1.0) / 2.0;
+        const double sum_k2 = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+        return (n * weighted_sum_ - sum_k * sum_) / (n * sum_k2 - sum_k * sum_k);
+    }
+
+    [[nodiscard]] double ema() const { return ema_; }
+    [[nodiscard]] double emaAlpha() const { return ema_alpha_; }
+
+private:
+    void rebuild() {
+        sum_ = sum_sq_ = weighted_sum_ = 0.0;
+        for (size_t k = 0; k < values_.size(); ++k) {
+            const double x = static_cast<double>(values_[k]);
+            sum_ += x;
+            sum_sq_ += x * x;
+            weighted_sum_ += static_cast<double>(k) * x;
+        }
+        pushes_since_rebuild_ = 0;
+    }
+
+    RingBuffer<T> values_;
+    double ema_alpha_;
+    double ema_ = 0.0;
+    double sum_ = 0.0;
+    double sum_sq_ = 0.0;
+    double weighted_sum_ = 0.0;        // Σ k·x_k
+    size_t pushes_since_rebuild_ = 0;
+};
+
+} // namespace mcee
@@ -0,0 +1,150 @@
+/**
+ * @file SemanticIndex.hpp
+ * @brief Embeddings quantifiés et index sémantique local (top-k cosinus)
+ *
+ * Un embedding de question (384 à 1536 dimensions) occupe 8 octets par
+ * composante en double. QuantizedEmbedding le conserve en float32, float16
+ * (2 octets) ou int8 avec un facteur d'échelle (1 octet) : c'est la forme
+ * stockée par le cache d'embeddings et par l'index de HybridSearchEngine.
+ *
+ * SemanticIndex est un index plat de ces vecteurs : les souvenirs le plus
+ * souvent rendus par la recherche vectorielle Neo4j y sont recopiés pour
+ * répondre en local aux questions voisines. La similarité est calculée sur
+ * les valeurs quantifiées (norme incluse), sans décompression.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Représentation stockée d'un embedding
+ */
+enum class EmbeddingQuantization : uint8_t {
+    NONE,       // float32
+    FLOAT16,    // IEEE 754 demi-précision
+    INT8        // Entiers [-127, 127] × échelle (max |x| / 127)
+};
+
+[[nodiscard]] const char* quantizationName(EmbeddingQuantization mode) noexcept;
+
+/**
+ * @class QuantizedEmbedding
+ * @brief Embedding compact, immuable une fois encodé
+ */
+class QuantizedEmbedding {
+public:
+    QuantizedEmbedding() = default;
+
+    static QuantizedEmbedding encode(const std::vector<double>& values, EmbeddingQuantization mode);
+
+    /// Valeurs reconstruites (erreur bornée par la quantification)
+    [[nodiscard]] std::vector<double> decode() const;
+
+    /**
+     * @brief Produit scalaire avec un vecteur float de même dimension
+     */
+    [[nodiscard]] double dot(const float* query) const;
+
+    /**
+     * @brief Produit scalaire avec un autre embedding de même dimension
+     *        (somme entière si les deux sont en INT8)
+     */
+    [[nodiscard]] double dot(const QuantizedEmbedding& other) const;
+
+    [[nodiscard]] size_t dim() const { return dim_; }
+    [[nodiscard]] bool empty() const { return dim_ == 0; }
+    [[nodiscard]] EmbeddingQuantization mode() const { return mode_; }
+
+    /// Norme des valeurs reconstruites (dénominateur du cosinus)
+    [[nodiscard]] double norm() const { return norm_; }
+
+    /// INT8 : valeur = code × scale()
+    [[nodiscard]] float scale() const { return scale_; }
+    [[nodiscard]] const int8_t* int8Codes() const {
+        return reinterpret_cast<const int8_t*>(data_.data());
+    }
+
+    /// Taille en mémoire (octets, budget des caches)
+    [[nodiscard]] size_t bytes() const { return sizeof(*this) + data_.capacity(); }
+
+private:
+    EmbeddingQuantization mode_ = EmbeddingQuantization::NONE;
+    uint32_t dim_ = 0;
+    float scale_ = 1.0f;
+    double norm_ = 0.0;
+    std::vector<uint8_t> data_;     // float32, float16 ou int8 selon mode_
+};
+
+/**
+ * @brief Résultat d'une recherche dans l'index sémantique
+ */
+struct SemanticHit {
+    std::string_view id;        // Vue sur l'identifiant indexé (valide jusqu'à la modification suivante)
+    double similarity = 0.0;    // Cosinus [-1, 1]
+};
+
+/**
+ * @class SemanticIndex
+ * @brief Index plat d'embeddings quantifiés, identifiés par chaîne
+ *
+ * La dimension est fixée par le premier vecteur inséré ; les vecteurs d'une
+ * autre dimension sont refusés. Non thread-safe : le propriétaire
+ * (HybridSearchEngine) le protège par son verrou.
+ */
+class SemanticIndex {
+public:
+    explicit SemanticIndex(EmbeddingQuantization mode = EmbeddingQuantization::INT8)
+        : mode_(mode) {}
+
+    /**
+     * @brief Ajoute ou remplace le vecteur d'un identifiant
+     * @return false si la dimension diffère de celle de l'index (ou vecteur nul)
+     */
+    bool upsert(const std::string& id, const std::vector<double>& embedding);
+
+    /**
+     * @brief Retire un identifiant (la dernière ligne prend sa place)
+     */
+    void erase(const std::string& id);
+
+    void clear();
+
+    /**
+     * @brief Retourne les k vecteurs les plus similaires au-dessus du seuil
+     * @return Résultats triés par similarité décroissante
+     */
+    [[nodiscard]] std::vector<SemanticHit> topK(
+        const std::vector<double>& query,
+        size_t k,
+        double threshold = 0.0
+    ) const;
+
+    [[nodiscard]] bool contains(const std::string& id) const { return rows_by_id_.count(id) > 0; }
+    [[nodiscard]] size_t size() const { return rows_.size(); }
+    [[nodiscard]] size_t dim() const { return dim_; }
+    [[nodiscard]] EmbeddingQuantization mode() const { return mode_; }
+
+    /// Taille approximative en mémoire (octets)
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    EmbeddingQuantization mode_;
+    size_t dim_ = 0;
+
+    std::vector<QuantizedEmbedding> rows_;
+    std::vector<std::string> ids_;                          // Parallèle à rows_
+    std::unordered_map<std::string, size_t> rows_by_id_;
+};
+
+} // namespace mcee
@@ -0,0 +1,76 @@
+/**
+ * @file SessionClock.hpp
+ * @brief Horloge des sessions : steady_clock en direct, temps de trace en rejeu
+ *
+ * Tout ce qui mesure le temps *émotionnel* d'une session (Δt de
+ * l'EmotionUpdater, pondération et fenêtre de la MCT, fenêtres du
+ * MCTGraph, durées des patterns et des phases) lit SessionClock::now()
+ * au lieu de steady_clock::now(). Les latences, délais d'attente et
+ * cadences des threads restent sur l'horloge réelle.
+ *
+ * Le temps virtuel est propre au thread : un rejeu installe un
+ * VirtualScope dans chaque thread qui exécute une session, les autres
+ * threads (et le mode direct) ne voient que steady_clock.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace mcee {
+
+class SessionClock {
+public:
+    using clock = std::chrono::steady_clock;
+    using time_point = clock::time_point;
+    using duration = clock::duration;
+
+    static time_point now() {
+        const time_point* virtual_now = current();
+        return virtual_now ? *virtual_now : clock::now();
+    }
+
+    [[nodiscard]] static bool isVirtual() { return current() != nullptr; }
+
+    /**
+     * @brief Temps virtuel du thread courant pendant la durée de vie de l'objet
+     *
+     * Les portées s'imbriquent ; la précédente est rétablie à la destruction.
+     */
+    class VirtualScope {
+    public:
+        explicit VirtualScope(time_point start = clock::now())
+            : now_(start), previous_(current()) {
+            current() = &now_;
+        }
+
+        ~VirtualScope() { current() = previous_; }
+
+        VirtualScope(const VirtualScope&) = delete;
+        VirtualScope& operator=(const VirtualScope&) = delete;
+
+        /// Le temps ne recule jamais (traces légèrement désordonnées)
+        void set(time_point t) {
+            if (t > now_) now_ = t;
+        }
+
+        void advance(duration d) { now_ += d; }
+
+        [[nodiscard]] time_point now() const { return now_; }
+
+    private:
+        time_point now_;
+        const time_point* previous_;
+    };
+
+private:
+    static const time_point*& current() {
+        thread_local const time_point* virtual_now = nullptr;
+        return virtual_now;
+    }
+};
+
+} // namespace mcee
@@ -0,0 +1,138 @@
+/**
+ * @file SessionTrace.hpp
+ * @brief Enregistrement et relecture des messages d'entrée des sessions
+ *
+ * Une trace est la suite des messages reçus (émotions, parole, tokens),
+ * horodatés à la réception (epoch, horloge système) et attribués à leur
+ * session. Deux formats, choisis par l'extension :
+ *
+ *   .mctr   binaire : "MCTR" + version u32, puis par message un en-tête
+ *           fixe de 24 octets (temps f64, flux u8, 3 octets nuls,
+ *           longueurs u32 de la session, du content-type et du corps)
+ *           suivi des trois chaînes. Lu par projection mémoire, sans copie.
+ *   autres  JSONL : {"t", "session", "input", "content_type", "body"} ;
+ *           les trames binaires EmotionWire y sont écrites en JSON.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Flux d'entrée d'un message
+ */
+enum class MCEEInput {
+    EMOTIONS,   // handleEmotionMessage
+    SPEECH,     // handleSpeechMessage
+    TOKENS      // handleTokensMessage
+};
+
+inline const char* mceeInputName(MCEEInput input) {
+    switch (input) {
+        case MCEEInput::EMOTIONS: return "emotions";
+        case MCEEInput::SPEECH: return "speech";
+        case MCEEInput::TOKENS: return "tokens";
+    }
+    return "emotions";
+}
+
+inline std::optional<MCEEInput> parseMCEEInput(std::string_view name) {
+    if (name == "emotions") return MCEEInput::EMOTIONS;
+    if (name == "speech") return MCEEInput::SPEECH;
+    if (name == "tokens") return MCEEInput::TOKENS;
+    return std::nullopt;
+}
+
+constexpr uint32_t SESSION_TRACE_VERSION = 1;
+
+/**
+ * @brief Message d'une trace (vues sur le stockage du lecteur)
+ */
+struct TraceRecord {
+    double time = 0.0;                 // Secondes depuis l'epoch (réception)
+    MCEEInput input = MCEEInput::EMOTIONS;
+    std::string_view session;
+    std::string_view content_type;
+    std::string_view body;
+};
+
+/**
+ * @class TraceWriter
+ * @brief Ajoute les messages reçus à un fichier de trace (thread-safe)
+ */
+class TraceWriter {
+public:
+    TraceWriter() = default;
+    ~TraceWriter() { close(); }
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    /**
+     * @brief Ouvre (ou crée) la trace en ajout ; binaire si l'extension est .mctr
+     */
+    bool open(const std::string& path);
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return out_.is_open(); }
+
+    /**
+     * @brief Enregistre un message reçu maintenant
+     */
+    void record(std::string_view session, MCEEInput input, std::string_view body,
+                std::string_view content_type = {});
+
+    void write(const TraceRecord& record);
+    void flush();
+
+    [[nodiscard]] size_t recorded() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::ofstream out_;
+    bool binary_ = false;
+    size_t recorded_ = 0;
+};
+
+/**
+ * @class TraceReader
+ * @brief Trace entière en mémoire, dans l'ordre du fichier
+ */
+class TraceReader {
+public:
+    /**
+     * @param error [out] Raison du refus (ligne JSONL ou enregistrement binaire fautif)
+     */
+    bool open(const std::string& path, std::string* error = nullptr);
+
+    [[nodiscard]] const std::vector<TraceRecord>& records() const { return records_; }
+    [[nodiscard]] size_t size() const { return records_.size(); }
+
+private:
+    MappedFile file_;                  // Trace binaire (les vues pointent dedans)
+    std::deque<std::string> storage_;  // Chaînes des traces JSONL (adresses stables)
+    std::vector<TraceRecord> records_;
+
+    bool parseBinary(std::string* error);
+    bool parseJsonl(const std::string& path, std::string* error);
+};
+
+/**
+ * @brief Vrai si le fichier commence par la signature "MCTR"
+ */
+bool isBinaryTraceFile(const std::string& path);
+
+} // namespace mcee
@@ -0,0 +1,279 @@
+/**
+ * @file ShardedLRUCache.hpp
+ * @brief Cache LRU partitionné, borné en octets, avec coalescence des requêtes
+ *
+ * Les clés sont des empreintes 64 bits (pas de construction de chaîne) ;
+ * la clé choisit un shard, chaque shard a son propre verrou, sa liste LRU
+ * et sa part du budget mémoire. Les entrées expirent après un TTL et les
+ * plus anciennes sont évincées dès que le shard dépasse son budget.
+ *
+ * SingleFlight regroupe les appels concurrents sur une même clé : un seul
+ * calcul est lancé, les autres appelants attendent son résultat.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mcee {
+
+/**
+ * @brief Compteurs d'utilisation du cache
+ */
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;      // Entrées retirées pour respecter le budget
+    uint64_t expirations = 0;    // Entrées retirées car TTL dépassé
+    uint64_t coalesced = 0;      // Appels servis par un calcul déjà en cours
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    [[nodiscard]] double hitRatio() const {
+        uint64_t total = hits + misses;
+        return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+    }
+};
+
+/**
+ * @brief Combine une empreinte dans une graine (schéma boost::hash_combine 64 bits)
+ */
+inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4));
+}
+
+/**
+ * @class ShardedLRUCache
+ * @brief Cache clé 64 bits → valeur immuable partagée
+ *
+ * Les valeurs sont rendues en shared_ptr<const V> : un lecteur garde sa
+ * copie valide même si l'entrée est évincée entre-temps.
+ */
+template <typename V>
+class ShardedLRUCache {
+public:
+    using ValuePtr = std::shared_ptr<const V>;
+
+    /**
+     * @param max_bytes Budget mémoire total (réparti entre les shards)
+     * @param shards Nombre de shards (arrondi à la puissance de 2 supérieure)
+     */
+    explicit ShardedLRUCache(size_t max_bytes = 8 * 1024 * 1024, size_t shards = 16)
+        : shards_(roundUpPow2(shards < 1 ? 1 : shards))
+        , mask_(shards_.size() - 1) {
+        setByteBudget(max_bytes);
+    }
+
+    ShardedLRUCache(const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+    /**
+     * @brief Recherche une entrée non expirée (la remonte en tête LRU)
+     * @param ttl Âge maximal accepté
+     */
+    ValuePtr get(uint64_t key, std::chrono::steady_clock::duration ttl) {
+        auto& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto entry = it->second;
+        if (std::chrono::steady_clock::now() - entry->inserted_at >= ttl) {
+            shard.bytes -= entry->bytes;
+            shard.lru.erase(entry);
+            shard.index.erase(it);
+            expirations_.fetch_add(1, std::memory_order_relaxed);
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return entry->value;
+    }
+
+    /**
+     * @brief Insère ou remplace une entrée
+     * @param bytes Taille estimée de la valeur (pour le budget)
+     */
+    void put(uint64_t key, ValuePtr value, size_t bytes) {
+        auto& shard = shardFor(key);
+        size_t budget = shard_budget_.load(std::memory_order_relaxed);
+        if (bytes > budget) {
+            return;  // Plus gros qu'un shard entier : non mis en cache
+        }
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->bytes;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+
+        shard.lru.push_front(Entry{key, std::move(value), bytes, std::chrono::steady_clock::now()});
+        shard.index[key] = shard.lru.begin();
+        shard.bytes += bytes;
+
+        while (shard.bytes > budget && !shard.lru.empty()) {
+            auto& victim = shard.lru.back();
+            shard.bytes -= victim.bytes;
+            shard.index.erase(victim.key);
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void erase(uint64_t key) {
+        auto& shard = shardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->bytes;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+    }
+
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.lru.clear();
+            shard.index.clear();
+            shard.bytes = 0;
+        }
+    }
+
+    /**
+     * @brief Change le budget (appliqué aux insertions suivantes)
+     */
+    void setByteBudget(size_t max_bytes) {
+        shard_budget_.store(max_bytes / shards_.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Agrège les compteurs (coalesced est renseigné par SingleFlight)
+     */
+    [[nodiscard]] CacheStats stats() const {
+        CacheStats s;
+        s.hits = hits_.load(std::memory_order_relaxed);
+        s.misses = misses_.load(std::memory_order_relaxed);
+        s.evictions = evictions_.load(std::memory_order_relaxed);
+        s.expirations = expirations_.load(std::memory_order_relaxed);
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            s.entries += shard.index.size();
+            s.bytes += shard.bytes;
+        }
+        return s;
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        ValuePtr value;
+        size_t bytes;
+        std::chrono::steady_clock::time_point inserted_at;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;                 // Tête = plus récemment utilisé
+        std::unordered_map<uint64_t, typename std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    std::vector<Shard> shards_;
+    size_t mask_;
+    std::atomic<size_t> shard_budget_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> expirations_{0};
+
+    Shard& shardFor(uint64_t key) {
+        // Bits hauts mélangés : les empreintes voisines se répartissent
+        return shards_[(key ^ (key >> 29)) & mask_];
+    }
+
+    static size_t roundUpPow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+};
+
+/**
+ * @class SingleFlight
+ * @brief Un seul calcul en vol par clé ; les appels concurrents le partagent
+ */
+template <typename V>
+class SingleFlight {
+public:
+    /**
+     * @brief Exécute fn pour la clé, ou attend le calcul déjà en cours
+     * @param shared Mis à true si le résultat provient d'un autre appelant
+     */
+    V run(uint64_t key, const std::function<V()>& fn, bool* shared = nullptr) {
+        std::shared_future<V> future;
+        std::shared_ptr<std::promise<V>> promise;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = inflight_.find(key);
+            if (it != inflight_.end()) {
+                future = it->second;
+            } else {
+                promise = std::make_shared<std::promise<V>>();
+                future = promise->get_future().share();
+                inflight_.emplace(key, future);
+            }
+        }
+
+        if (!promise) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            if (shared) *shared = true;
+            return future.get();
+        }
+
+        if (shared) *shared = false;
+        try {
+            promise->set_value(fn());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            inflight_.erase(key);
+        }
+        return future.get();
+    }
+
+    [[nodiscard]] uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_future<V>> inflight_;
+    std::atomic<uint64_t> coalesced_{0};
+};
+
+} // namespace mcee
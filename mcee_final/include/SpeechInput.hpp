@@ -15,12 +15,16 @@
 #define MCEE_SPEECH_INPUT_HPP
 
 #include "Types.hpp"
+#include "LemmaTable.hpp"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
 #include <chrono>
+#include <memory>
 #include <queue>
 #include <mutex>
 
@@ -42,7 +46,7 @@ struct SpeechAnalysis {
     bool contains_question = false;                // Est une question
     std::chrono::steady_clock::time_point timestamp;
     
-    SpeechAnalysis() : timestamp(std::chrono::steady_clock::now()) {}
+    SpeechAnalysis() : timestamp(SessionClock::now()) {}
 };
 
 /**
@@ -54,7 +58,72 @@ struct TextInput {
     double confidence = 1.0;                       // Confiance de la transcription
     std::chrono::steady_clock::time_point timestamp;
     
-    TextInput() : timestamp(std::chrono::steady_clock::now()) {}
+    TextInput() : timestamp(SessionClock::now()) {}
+};
+
+/**
+ * @brief Dictionnaires de mots et leur lexique compilé
+ *
+ * Immuable une fois publié : plusieurs SpeechInput (une par session d'un
+ * MCEEHost) partagent la même instance ; une modification en construit
+ * une copie (cf. SpeechInput::addCustomKeywords).
+ */
+struct SpeechLexicon {
+    std::unordered_set<std::string> threat_words;
+    std::unordered_set<std::string> positive_words;
+    std::unordered_set<std::string> negative_words;
+    std::unordered_set<std::string> high_arousal_words;
+    std::unordered_set<std::string> low_arousal_words;
+    std::unordered_map<std::string, double> emotion_word_scores;
+
+    /**
+     * @brief Entrée du lexique compilé : appartenance à chaque dictionnaire
+     *
+     * Mots vides et mots d'urgence ne dépendent pas du lexique : ce sont
+     * des propriétés de la LemmaTable, communes à tout le processus, recopiées
+     * ici à la compilation.
+     */
+    struct Entry {
+        enum : uint16_t {
+            THREAT       = 1 << 0,
+            POSITIVE     = 1 << 1,
+            NEGATIVE     = 1 << 2,
+            HIGH_AROUSAL = 1 << 3,
+            LOW_AROUSAL  = 1 << 4,
+            SCORED       = 1 << 5    // Présent dans emotion_word_scores
+        };
+        uint16_t flags = 0;
+        double score = 0.0;
+        LemmaId lemma = NO_LEMMA;
+        uint16_t lemma_flags = 0;   // LemmaTable::Flag
+    };
+
+    // Fusion de tous les dictionnaires et des classes de la LemmaTable : une
+    // seule recherche par token, sans verrou (vue figée, clés internées)
+    std::unordered_map<std::string_view, Entry> compiled;
+
+    /**
+     * @brief Entrée d'un token (nullptr hors lexique)
+     */
+    [[nodiscard]] const Entry* lookup(std::string_view word) const {
+        auto it = compiled.find(word);
+        return it != compiled.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Dictionnaires français par défaut, compilés
+     */
+    static std::shared_ptr<const SpeechLexicon> createDefault();
+
+    /**
+     * @brief Reconstruit compiled à partir des dictionnaires
+     */
+    void compile();
+
+    /**
+     * @brief Taille approximative en mémoire (octets)
+     */
+    [[nodiscard]] size_t memoryUsage() const;
 };
 
 /**
@@ -67,10 +136,15 @@ public:
     using UrgencyCallback = std::function<void(const std::string&, double)>;
 
     /**
-     * @brief Constructeur
+     * @brief Constructeur (dictionnaires par défaut)
      */
     SpeechInput();
 
+    /**
+     * @brief Constructeur sur un lexique partagé
+     */
+    explicit SpeechInput(std::shared_ptr<const SpeechLexicon> lexicon);
+
     /**
      * @brief Traite un nouveau texte reçu
      * @param input Entrée textuelle
@@ -142,14 +216,21 @@ public:
     [[nodiscard]] size_t getProcessedCount() const { return processed_count_; }
     [[nodiscard]] double getAverageSentiment() const { return average_sentiment_; }
 
+    /**
+     * @brief Lexique courant (partageable avec d'autres SpeechInput)
+     */
+    [[nodiscard]] std::shared_ptr<const SpeechLexicon> getLexicon() const { return lexicon_; }
+
+    /**
+     * @brief Taille approximative de l'état propre à cette instance (octets)
+     *
+     * Le lexique, potentiellement partagé, n'est pas compté.
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
 private:
-    // Dictionnaires de mots
-    std::unordered_set<std::string> threat_words_;
-    std::unordered_set<std::string> positive_words_;
-    std::unordered_set<std::string> negative_words_;
-    std::unordered_set<std::string> high_arousal_words_;
-    std::unordered_set<std::string> low_arousal_words_;
-    std::unordered_map<std::string, double> emotion_word_scores_;
+    // Dictionnaires (partagés, copiés à la modification)
+    std::shared_ptr<const SpeechLexicon> lexicon_;
 
     // Historique
     std::vector<SpeechAnalysis> analysis_history_;
@@ -166,49 +247,29 @@ private:
     UrgencyCallback on_urgency_;
 
     /**
-     * @brief Initialise les dictionnaires par défaut
+     * @brief Applique une modification sur une copie du lexique, puis la publie
      */
-    void initDefaultDictionaries();
+    void updateLexicon(const std::function<void(SpeechLexicon&)>& edit);
 
     /**
      * @brief Normalise un texte (minuscules, suppression ponctuation)
+     * @param has_question_mark Mis à true si le texte brut contient '?'
      */
-    [[nodiscard]] std::string normalizeText(const std::string& text) const;
-
-    /**
-     * @brief Tokenize un texte en mots
-     */
-    [[nodiscard]] std::vector<std::string> tokenize(const std::string& text) const;
-
-    /**
-     * @brief Analyse le sentiment du texte
-     */
-    [[nodiscard]] double analyzeSentiment(const std::vector<std::string>& tokens) const;
-
-    /**
-     * @brief Analyse le niveau d'activation (arousal)
-     */
-    [[nodiscard]] double analyzeArousal(const std::vector<std::string>& tokens) const;
-
-    /**
-     * @brief Détecte les menaces dans le texte
-     */
-    [[nodiscard]] bool detectThreats(const std::vector<std::string>& tokens) const;
-
-    /**
-     * @brief Extrait les mots-clés significatifs
-     */
-    [[nodiscard]] std::vector<std::string> extractKeywords(const std::vector<std::string>& tokens) const;
+    [[nodiscard]] std::string normalizeText(const std::string& text, bool* has_question_mark = nullptr) const;
 
     /**
-     * @brief Extrait les mots émotionnels
+     * @brief Analyse en une passe : tokens, sentiment, arousal, menaces,
+     *        mots-clés, mots émotionnels et indices de question
+     * @return Nombre de tokens (0 : analyse laissée vide)
      */
-    [[nodiscard]] std::vector<std::string> extractEmotionWords(const std::vector<std::string>& tokens) const;
+    size_t analyzeTokens(std::string_view normalized, SpeechAnalysis& analysis,
+                         size_t& urgency_keywords) const;
 
     /**
      * @brief Calcule le score d'urgence
+     * @param urgency_keywords Mots d'urgence parmi les mots-clés retenus
      */
-    [[nodiscard]] double computeUrgencyScore(const SpeechAnalysis& analysis) const;
+    [[nodiscard]] double computeUrgencyScore(const SpeechAnalysis& analysis, size_t urgency_keywords) const;
 
     /**
      * @brief Met à jour l'historique
@@ -0,0 +1,317 @@
+/**
+ * @file StateJournal.hpp
+ * @brief Journal d'écriture anticipée (WAL) et checkpoints de l'état du moteur
+ *
+ * Au redémarrage, le moteur ne retrouvait que les patterns MLT : MCT,
+ * MCTGraph, PatternMatcher, Conscience, ADDO et souvenirs locaux repartaient
+ * de zéro. Le journal reçoit, dans l'ordre où l'étage [match] les applique,
+ * les trames du pipeline (émotions, parole, feedback, urgence) et les
+ * messages tokens du MCTGraph. Les enregistrements s'accumulent en mémoire
+ * et un thread dédié les écrit puis les synchronise par lots (group
+ * commit), au plus tard commit_interval_ms après leur ajout.
+ *
+ * Périodiquement, le moteur capture l'état de ses composants (toJson) ; le
+ * journal l'écrit en CBOR derrière un en-tête vérifié, avec le snapshot
+ * binaire de la MLT, puis supprime les segments entièrement couverts. La
+ * reprise lit le dernier checkpoint puis rejoue les enregistrements
+ * postérieurs.
+ *
+ * Fichiers du répertoire :
+ *   checkpoint.bin       "MCKP", version u32, seq u64, taille u64,
+ *                        checksum u64, état CBOR
+ *   patterns-<seq>.mltp  snapshot MLT référencé par le checkpoint
+ *   wal-<seq>.log        "MCWL", version u32, premier seq u64 ; puis par
+ *                        enregistrement : taille u32, type u8, 3 octets
+ *                        nuls, seq u64, checksum u64, charge
+ *
+ * Une fin de segment invalide (arrêt brutal pendant une écriture) arrête la
+ * relecture de ce segment ; chaque ouverture démarre un nouveau segment.
+ *
+ * @version 3.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mcee {
+
+constexpr uint32_t STATE_JOURNAL_VERSION = 1;
+
+/**
+ * @brief Nature d'un enregistrement du WAL
+ */
+enum class JournalRecordType : uint8_t {
+    EMOTIONS = 1,   // Trame émotions appliquée : 24 × f64, réflexe u8
+    SPEECH = 2,     // Parole : feedback externe, sentiment, activation, urgence (f64), texte, contexte
+    FEEDBACK = 3,   // Feedback imposé : external f64, internal f64
+    URGENCY = 4,    // Plancher de feedback interne f64
+    TOKENS = 5      // Message tokens tel que reçu
+};
+
+/**
+ * @brief Configuration du journal (section "journal")
+ */
+struct JournalConfig {
+    bool enabled = false;
+    std::string directory = "mcee_state";
+    int commit_interval_ms = 5;                 // Délai maximal avant écriture d'un lot
+    size_t group_commit_bytes = 256 * 1024;     // Lot écrit sans attendre le délai au-delà
+    bool sync = true;                           // fdatasync après chaque lot
+    double checkpoint_interval_seconds = 30.0;
+    size_t checkpoint_every_records = 20000;    // Checkpoint anticipé (0 : délai seul)
+};
+
+/**
+ * @brief Enregistrement relu (charge : vue sur le segment projeté)
+ */
+struct JournalRecord {
+    uint64_t seq = 0;
+    JournalRecordType type = JournalRecordType::EMOTIONS;
+    std::string_view payload;
+};
+
+/**
+ * @brief Résultat de la reprise
+ */
+struct JournalRecovery {
+    bool has_checkpoint = false;
+    uint64_t checkpoint_seq = 0;
+    nlohmann::json state;               // État capturé par le checkpoint
+    std::string patterns_path;          // Snapshot MLT du checkpoint (vide si absent)
+    uint64_t last_seq = 0;              // Dernier enregistrement valide (checkpoint compris)
+    size_t replayed = 0;                // Enregistrements postérieurs au checkpoint
+    size_t truncated_segments = 0;      // Segments à fin invalide
+};
+
+/**
+ * @brief Compteurs du journal
+ */
+struct JournalStats {
+    uint64_t appended = 0;              // Enregistrements ajoutés depuis l'ouverture
+    uint64_t commits = 0;               // Lots écrits (et synchronisés)
+    uint64_t bytes_written = 0;
+    uint64_t checkpoints = 0;
+    uint64_t checkpoint_failures = 0;
+    uint64_t last_checkpoint_seq = 0;
+    size_t recovered_records = 0;       // Rejoués à l'ouverture (renseigné par le moteur)
+    double recovery_ms = 0.0;           // Durée de la reprise (renseignée par le moteur)
+};
+
+/**
+ * @brief Écrit le snapshot MLT d'un checkpoint au chemin donné
+ */
+using PatternSnapshotWriter = std::function<bool(const std::string& path)>;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHARGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Encode une charge : valeurs natives, chaînes préfixées par leur taille u32
+ */
+class JournalPayloadWriter {
+public:
+    explicit JournalPayloadWriter(std::string& out) noexcept : out_(out) { out_.clear(); }
+
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(std::string_view s) {
+        put(static_cast<uint32_t>(s.size()));
+        out_.append(s);
+    }
+
+private:
+    std::string& out_;
+};
+
+/**
+ * @brief Relit une charge produite par JournalPayloadWriter
+ */
+class JournalPayloadReader {
+public:
+    explicit JournalPayloadReader(std::string_view in) noexcept : in_(in) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (in_.size() < sizeof(T)) return false;
+        std::memcpy(&value, in_.data(), sizeof(T));
+        in_.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool getString(std::string_view& s) {
+        uint32_t size = 0;
+        if (!get(size) || in_.size() < size) return false;
+        s = in_.substr(0, size);
+        in_.remove_prefix(size);
+        return true;
+    }
+
+private:
+    std::string_view in_;
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// JOURNAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @class StateJournal
+ * @brief WAL à validation groupée et checkpoints asynchrones
+ *
+ * append() peut être appelé depuis plusieurs threads ; l'ordre des numéros
+ * de séquence est celui des appels.
+ */
+class StateJournal {
+public:
+    StateJournal() = default;
+    ~StateJournal();
+
+    StateJournal(const StateJournal&) = delete;
+    StateJournal& operator=(const StateJournal&) = delete;
+
+    /**
+     * @brief Lit le dernier checkpoint valide du répertoire
+     * @return false si le checkpoint existe mais est illisible (error renseigné)
+     */
+    static bool readCheckpoint(const std::string& directory, JournalRecovery& recovery,
+                               std::string* error = nullptr);
+
+    /**
+     * @brief Rejoue les enregistrements postérieurs à recovery.checkpoint_seq
+     *
+     * Met à jour last_seq, replayed et truncated_segments.
+     */
+    static void replay(const std::string& directory, JournalRecovery& recovery,
+                       const std::function<void(const JournalRecord&)>& apply);
+
+    /**
+     * @brief Ouvre un nouveau segment et démarre le thread de validation
+     * @param last_seq Dernier numéro déjà présent dans le répertoire (reprise)
+     */
+    bool open(const JournalConfig& config, uint64_t last_seq);
+
+    /**
+     * @brief Valide les enregistrements en attente, termine le checkpoint en cours, ferme
+     */
+    void close();
+
+    [[nodiscard]] bool isOpen() const { return open_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Ajoute un enregistrement au lot courant
+     * @return Numéro de séquence attribué (0 si le journal est fermé)
+     */
+    uint64_t append(JournalRecordType type, std::string_view payload);
+
+    /**
+     * @brief Attend que tous les enregistrements ajoutés soient écrits
+     */
+    void commit();
+
+    /**
+     * @brief Vrai si un checkpoint est dû (délai ou volume) et aucun n'est en cours
+     * @param force Dû dès qu'un enregistrement n'est pas couvert
+     */
+    [[nodiscard]] bool checkpointDue(bool force = false) const;
+
+    /**
+     * @brief Réserve le checkpoint dû : marqué en cours, compteurs remis à zéro
+     *
+     * Appelé par le moteur au moment où il lit lastSeq() ; checkpointDue()
+     * reste faux jusqu'à l'écriture ou l'abandon du checkpoint réservé.
+     * @return false si aucun checkpoint n'est dû (ou déjà réservé)
+     */
+    bool beginCheckpoint(bool force = false);
+
+    /**
+     * @brief Libère un checkpoint réservé qui ne sera pas confié au journal
+     *
+     * Les enregistrements non couverts redeviennent comptés : le prochain
+     * checkpoint est dû immédiatement.
+     */
+    void abandonCheckpoint();
+
+    /**
+     * @brief Numéro du dernier enregistrement ajouté
+     */
+    [[nodiscard]] uint64_t lastSeq() const;
+
+    /**
+     * @brief Confie un état capturé au thread du journal (après beginCheckpoint)
+     *
+     * L'état doit refléter exactement les enregistrements ≤ seq. Le
+     * snapshot MLT (facultatif) est écrit avant le checkpoint qui le
+     * référence ; les segments et snapshots couverts sont ensuite supprimés.
+     * Le thread du journal ne fait qu'écrire : write_patterns ne doit pas
+     * relire un état qui a pu évoluer depuis la capture.
+     */
+    void checkpoint(uint64_t seq, nlohmann::json state, PatternSnapshotWriter write_patterns = {});
+
+    [[nodiscard]] JournalStats getStats() const;
+    [[nodiscard]] const JournalConfig& getConfig() const { return config_; }
+
+private:
+    struct PendingCheckpoint {
+        uint64_t seq = 0;
+        nlohmann::json state;
+        PatternSnapshotWriter write_patterns;
+    };
+
+    void commitLoop();
+    bool writeBatch(const std::string& batch);
+    bool openSegment(uint64_t first_seq);
+    void writeCheckpoint(PendingCheckpoint& checkpoint);
+    void removeCovered(uint64_t checkpoint_seq, const std::string& keep_patterns);
+
+    JournalConfig config_;
+    int fd_ = -1;                                  // Segment courant (thread de validation)
+    std::vector<std::pair<uint64_t, std::string>> segments_;  // Premier seq, chemin
+
+    mutable std::mutex mutex_;                     // pending_, seq_, checkpoint_, drapeaux
+    std::condition_variable wake_;
+    std::condition_variable committed_;
+    std::string pending_;
+    uint64_t seq_ = 0;
+    uint64_t durable_seq_ = 0;
+    bool has_checkpoint_ = false;
+    PendingCheckpoint checkpoint_;
+    bool commit_requested_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+    std::atomic<bool> open_{false};
+
+    std::atomic<bool> checkpoint_in_flight_{false};
+    std::atomic<uint64_t> since_checkpoint_{0};
+    std::atomic<int64_t> next_checkpoint_ns_{0};   // steady_clock
+
+    std::atomic<uint64_t> appended_{0};
+    std::atomic<uint64_t> commits_{0};
+    std::atomic<uint64_t> bytes_written_{0};
+    std::atomic<uint64_t> checkpoints_{0};
+    std::atomic<uint64_t> checkpoint_failures_{0};
+    std::atomic<uint64_t> last_checkpoint_seq_{0};
+};
+
+} // namespace mcee
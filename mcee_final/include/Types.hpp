@@ -8,9 +8,15 @@
 #ifndef MCEE_TYPES_HPP
 #define MCEE_TYPES_HPP
 
+#include "SessionClock.hpp"
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <cmath>
@@ -23,9 +29,9 @@ constexpr double DEFAULT_HYSTERESIS_MARGIN = 0.15;
 constexpr double DEFAULT_MIN_PHASE_DURATION = 30.0; // secondes
 
 /**
- * @brief Liste ordonnée des 24 émotions
+ * @brief Liste ordonnée des 24 émotions (constante de compilation)
  */
-inline const std::array<std::string, NUM_EMOTIONS> EMOTION_NAMES = {
+inline constexpr std::array<std::string_view, NUM_EMOTIONS> EMOTION_NAME_VIEWS = {
     "Admiration", "Adoration", "Appréciation esthétique", "Amusement",
     "Anxiété", "Émerveillement", "Gêne", "Ennui",
     "Calme", "Confusion", "Dégoût", "Douleur empathique",
@@ -34,6 +40,129 @@ inline const std::array<std::string, NUM_EMOTIONS> EMOTION_NAMES = {
     "Tristesse", "Satisfaction", "Sympathie", "Triomphe"
 };
 
+/**
+ * @brief Liste ordonnée des 24 émotions
+ */
+inline const std::array<std::string, NUM_EMOTIONS> EMOTION_NAMES = [] {
+    std::array<std::string, NUM_EMOTIONS> names;
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+        names[i] = std::string(EMOTION_NAME_VIEWS[i]);
+    }
+    return names;
+}();
+
+/**
+ * @brief Indice de chaque émotion dans EMOTION_NAMES
+ *
+ * À préférer à getEmotion("…") dans les boucles chaudes : l'indice est
+ * résolu à la compilation au lieu d'une recherche par chaîne.
+ */
+enum EmotionIndex : size_t {
+    EMO_ADMIRATION, EMO_ADORATION, EMO_APPRECIATION_ESTHETIQUE, EMO_AMUSEMENT,
+    EMO_ANXIETE, EMO_EMERVEILLEMENT, EMO_GENE, EMO_ENNUI,
+    EMO_CALME, EMO_CONFUSION, EMO_DEGOUT, EMO_DOULEUR_EMPATHIQUE,
+    EMO_FASCINATION, EMO_EXCITATION, EMO_PEUR, EMO_HORREUR,
+    EMO_INTERET, EMO_JOIE, EMO_NOSTALGIE, EMO_SOULAGEMENT,
+    EMO_TRISTESSE, EMO_SATISFACTION, EMO_SYMPATHIE, EMO_TRIOMPHE
+};
+
+namespace emotion_hash_detail {
+
+inline constexpr size_t SLOTS = 64;
+
+constexpr uint32_t hash(std::string_view name, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;    // FNV-1a
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+constexpr size_t slot(std::string_view name, uint32_t seed) {
+    return (hash(name, seed) >> 7) % SLOTS;
+}
+
+struct Table {
+    uint32_t seed = 0;
+    std::array<uint8_t, SLOTS> index{};   // NUM_EMOTIONS = case vide
+    bool perfect = false;
+};
+
+/// Premier germe sans collision entre les 24 noms (cherché à la compilation)
+constexpr Table build() {
+    for (uint32_t seed = 0; seed < 65536; ++seed) {
+        Table table;
+        table.seed = seed;
+        table.index.fill(static_cast<uint8_t>(NUM_EMOTIONS));
+        bool collision = false;
+        for (size_t i = 0; i < NUM_EMOTIONS && !collision; ++i) {
+            auto& cell = table.index[slot(EMOTION_NAME_VIEWS[i], seed)];
+            collision = cell != NUM_EMOTIONS;
+            cell = static_cast<uint8_t>(i);
+        }
+        if (!collision) {
+            table.perfect = true;
+            return table;
+        }
+    }
+    return Table{};
+}
+
+inline constexpr Table TABLE = build();
+static_assert(TABLE.perfect, "pas de hachage parfait des noms d'émotions");
+
+} // namespace emotion_hash_detail
+
+/**
+ * @brief Indice d'une émotion par son nom, NUM_EMOTIONS si inconnue
+ *
+ * Hachage parfait calculé à la compilation : un hachage et une seule
+ * comparaison de chaîne, quel que soit le nom.
+ */
+constexpr size_t emotionIndex(std::string_view name) {
+    using namespace emotion_hash_detail;
+    size_t i = TABLE.index[slot(name, TABLE.seed)];
+    return (i < NUM_EMOTIONS && EMOTION_NAME_VIEWS[i] == name) ? i : NUM_EMOTIONS;
+}
+
+static_assert(EMO_TRIOMPHE + 1 == NUM_EMOTIONS, "une constante EMO_ par émotion");
+static_assert(emotionIndex("Peur") == EMO_PEUR && emotionIndex("Anxiété") == EMO_ANXIETE &&
+              emotionIndex("Triomphe") == EMO_TRIOMPHE, "EmotionIndex aligné sur EMOTION_NAMES");
+static_assert([] {
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+        if (emotionIndex(EMOTION_NAME_VIEWS[i]) != i) return false;
+    }
+    return emotionIndex("Colère") == NUM_EMOTIONS && emotionIndex("") == NUM_EMOTIONS;
+}(), "emotionIndex retrouve chaque nom et rejette les inconnus");
+
+/**
+ * @brief Masque de valence : 1 pour les émotions positives, 0 pour les négatives
+ *
+ * Positives : 0-3, 5, 8, 12, 13, 16, 17, 19, 21, 22, 23 ; toutes les autres
+ * sont négatives (Σ positives + Σ négatives = Σ émotions).
+ */
+inline constexpr std::array<double, NUM_EMOTIONS> POSITIVE_VALENCE_MASK = [] {
+    std::array<double, NUM_EMOTIONS> mask{};
+    for (size_t i : {EMO_ADMIRATION, EMO_ADORATION, EMO_APPRECIATION_ESTHETIQUE, EMO_AMUSEMENT,
+                     EMO_EMERVEILLEMENT, EMO_CALME, EMO_FASCINATION, EMO_EXCITATION,
+                     EMO_INTERET, EMO_JOIE, EMO_SOULAGEMENT, EMO_SATISFACTION,
+                     EMO_SYMPATHIE, EMO_TRIOMPHE}) {
+        mask[i] = 1.0;
+    }
+    return mask;
+}();
+
+/**
+ * @brief Largeur des réductions des noyaux sur les 24 émotions
+ *
+ * Quatre accumulateurs indépendants (un registre AVX de doubles) : le
+ * compilateur vectorise les sommes sans réassocier de flottants. 24 est
+ * multiple de la largeur, aucun remplissage n'est nécessaire.
+ */
+constexpr size_t EMOTION_LANES = 4;
+static_assert(NUM_EMOTIONS % EMOTION_LANES == 0, "les noyaux parcourent les émotions par blocs entiers");
+
 /**
  * @brief Les 8 phases émotionnelles du système
  */
@@ -102,82 +231,132 @@ struct PhaseConfig {
 /**
  * @brief État émotionnel complet (24 émotions)
  */
+/**
+ * @brief Réductions d'un vecteur d'émotions : somme, part positive, dominante
+ */
+struct EmotionSummary {
+    double sum = 0.0;                  // Σ E_i
+    double positive = 0.0;             // Σ E_i des émotions positives
+    size_t dominant = 0;               // Indice de la plus forte (la première à égalité)
+    double dominant_value = 0.0;
+
+    [[nodiscard]] double meanIntensity() const { return sum / NUM_EMOTIONS; }
+
+    /// Part positive de l'intensité ; 0.5 pour un état éteint
+    [[nodiscard]] double valence() const { return sum < 1e-6 ? 0.5 : positive / sum; }
+
+    [[nodiscard]] const std::string& dominantName() const { return EMOTION_NAMES[dominant]; }
+
+    /**
+     * @brief Accumulation d'un bloc de EMOTION_LANES émotions (premier indice base)
+     */
+    struct Lanes {
+        double sum[EMOTION_LANES] = {};
+        double positive[EMOTION_LANES] = {};
+        double best[EMOTION_LANES];
+        size_t best_index[EMOTION_LANES] = {};
+
+        Lanes() {
+            for (double& b : best) b = -std::numeric_limits<double>::infinity();
+        }
+
+        void add(const double* values, size_t base) {
+            for (size_t l = 0; l < EMOTION_LANES; ++l) {
+                const double v = values[l];
+                sum[l] += v;
+                positive[l] += v * POSITIVE_VALENCE_MASK[base + l];
+                const bool better = v > best[l];
+                best[l] = better ? v : best[l];
+                best_index[l] = better ? base + l : best_index[l];
+            }
+        }
+
+        [[nodiscard]] EmotionSummary reduce() const {
+            EmotionSummary out;
+            out.dominant = best_index[0];
+            out.dominant_value = best[0];
+            for (size_t l = 0; l < EMOTION_LANES; ++l) {
+                out.sum += sum[l];
+                out.positive += positive[l];
+                if (best[l] > out.dominant_value ||
+                    (best[l] == out.dominant_value && best_index[l] < out.dominant)) {
+                    out.dominant = best_index[l];
+                    out.dominant_value = best[l];
+                }
+            }
+            return out;
+        }
+    };
+
+    /**
+     * @brief Une passe sur les émotions
+     */
+    static EmotionSummary of(const std::array<double, NUM_EMOTIONS>& emotions) {
+        Lanes lanes;
+        for (size_t base = 0; base < NUM_EMOTIONS; base += EMOTION_LANES) {
+            lanes.add(emotions.data() + base, base);
+        }
+        return lanes.reduce();
+    }
+};
+
 struct EmotionalState {
-    std::array<double, NUM_EMOTIONS> emotions{};
+    alignas(32) std::array<double, NUM_EMOTIONS> emotions{};
     double E_global = 0.0;
     double variance_global = 0.0;
     std::chrono::steady_clock::time_point timestamp;
     
-    EmotionalState() : timestamp(std::chrono::steady_clock::now()) {
+    EmotionalState() : timestamp(SessionClock::now()) {
         emotions.fill(0.0);
     }
     
     /**
      * @brief Accès à une émotion par son nom
      */
-    double getEmotion(const std::string& name) const {
-        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-            if (EMOTION_NAMES[i] == name) {
-                return emotions[i];
-            }
-        }
-        return 0.0;
+    double getEmotion(std::string_view name) const {
+        const size_t i = emotionIndex(name);
+        return i < NUM_EMOTIONS ? emotions[i] : 0.0;
     }
     
     /**
      * @brief Définir une émotion par son nom
      */
-    void setEmotion(const std::string& name, double value) {
-        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-            if (EMOTION_NAMES[i] == name) {
-                emotions[i] = std::clamp(value, 0.0, 1.0);
-                return;
-            }
+    void setEmotion(std::string_view name, double value) {
+        const size_t i = emotionIndex(name);
+        if (i < NUM_EMOTIONS) {
+            emotions[i] = std::clamp(value, 0.0, 1.0);
         }
     }
     
+    /**
+     * @brief Dominante, intensité et valence en une passe
+     *
+     * À préférer aux accesseurs ci-dessous quand plusieurs sont nécessaires.
+     */
+    EmotionSummary summarize() const {
+        return EmotionSummary::of(emotions);
+    }
+
     /**
      * @brief Trouve l'émotion dominante
      */
     std::pair<std::string, double> getDominant() const {
-        size_t maxIdx = 0;
-        double maxVal = emotions[0];
-        for (size_t i = 1; i < NUM_EMOTIONS; ++i) {
-            if (emotions[i] > maxVal) {
-                maxVal = emotions[i];
-                maxIdx = i;
-            }
-        }
-        return {EMOTION_NAMES[maxIdx], maxVal};
+        const auto summary = summarize();
+        return {summary.dominantName(), summary.dominant_value};
     }
     
     /**
      * @brief Calcule l'intensité moyenne
      */
     double getMeanIntensity() const {
-        double sum = 0.0;
-        for (const auto& e : emotions) {
-            sum += e;
-        }
-        return sum / NUM_EMOTIONS;
+        return summarize().meanIntensity();
     }
     
     /**
      * @brief Calcule la valence (positif vs négatif)
      */
     double getValence() const {
-        // Émotions positives: indices 0-3, 5, 8, 12, 13, 16, 17, 19, 21, 22, 23
-        // Émotions négatives: indices 4, 6, 7, 9, 10, 11, 14, 15, 18, 20
-        static const std::array<size_t, 14> positiveIndices = {0, 1, 2, 3, 5, 8, 12, 13, 16, 17, 19, 21, 22, 23};
-        static const std::array<size_t, 10> negativeIndices = {4, 6, 7, 9, 10, 11, 14, 15, 18, 20};
-        
-        double posSum = 0.0, negSum = 0.0;
-        for (auto i : positiveIndices) posSum += emotions[i];
-        for (auto i : negativeIndices) negSum += emotions[i];
-        
-        double total = posSum + negSum;
-        if (total < 1e-6) return 0.5;
-        return posSum / total;
+        return summarize().valence();
     }
 };
 
@@ -218,6 +397,25 @@ struct Memory {
     int activation_count = 0;
 };
 
+/**
+ * @brief Accès léger à un souvenir du stockage local (sans copie du contenu)
+ *
+ * Le contenu (nom, émotions, dominante) est partagé avec le stockage et
+ * immuable ; seules les grandeurs dynamiques (poids effectif au moment de
+ * la requête, activation) sont portées par la référence. Le souvenir reste
+ * valide même s'il est rétrogradé ou oublié entre-temps.
+ */
+struct MemoryRef {
+    std::shared_ptr<const Memory> memory;
+    double weight = 0.0;           // Poids effectif (oubli paresseux appliqué)
+    double activation = 0.0;
+    int activation_count = 0;
+    std::chrono::system_clock::time_point last_activated;
+
+    const Memory* operator->() const { return memory.get(); }
+    const Memory& operator*() const { return *memory; }
+};
+
 /**
  * @brief Statistiques du moteur MCEE
  */
@@ -229,6 +427,41 @@ struct MCEEStats {
     size_t emergency_triggers = 0;
     double wisdom = 0.0;
     std::chrono::steady_clock::time_point start_time;
+
+    // Pipeline par étages (ingest → match → update → persist)
+    size_t match_queue_depth = 0;      // Trames en attente de MCT/PatternMatcher
+    size_t update_queue_depth = 0;     // Trames en attente d'EmotionUpdater/Amyghaleon
+    size_t persist_queue_depth = 0;    // Trames en attente de persistance/publication
+    size_t pipeline_stalls = 0;        // Poussées retardées (file pleine)
+    size_t frames_processed = 0;       // Trames ayant traversé tout le pipeline
+    double end_to_end_p50_ms = 0.0;    // Soumission → publication, médiane
+    double end_to_end_p99_ms = 0.0;    // Soumission → publication, 99e centile
+
+    // Politique d'ingestion sous surcharge
+    size_t ingest_coalesced = 0;       // Trames émotions absorbées par une fusion
+    size_t ingest_shed = 0;            // Trames traitées sans le travail secondaire
+    size_t ingest_publish_skipped = 0; // États périmés non publiés (plus récent en file)
+
+    // Temporaires par trame (arènes de [update] et [persist])
+    bool frame_heap_counting = false;      // operator new instrumenté (MCEE_COUNT_HEAP_ALLOCATIONS)
+    double frame_heap_allocations = 0.0;   // Allocations du tas par trame publiée, en moyenne
+    size_t frame_arena_spills = 0;         // Blocs demandés au tas, arène pleine
+
+    // Index vectoriel local des souvenirs
+    size_t memory_index_size = 0;      // Souvenirs indexés en local
+    double memory_index_hit_ratio = 0.0;  // Recherches servies sans Neo4j
+    size_t memory_warm_size = 0;       // Souvenirs compacts (niveau tiède)
+    size_t memory_coalesced = 0;       // Trames fusionnées dans un souvenir existant
+
+    // Matching incrémental du PatternMatcher
+    double pattern_match_skip_rate = 0.0;        // Frames servies par le dernier match
+    double pattern_match_early_exit_rate = 0.0;  // Rematchs résolus sur les successeurs probables
+
+    // Voie rapide d'urgence (Amyghaleon à l'ingestion)
+    size_t emergency_lane_triggers = 0;
+    size_t emergency_lane_dropped = 0;     // File d'urgence pleine
+    double emergency_lane_p99_ms = 0.0;    // Réception → publication, 99e centile
+    double emergency_lane_max_ms = 0.0;    // Pire cas observé
     
     MCEEStats() : start_time(std::chrono::steady_clock::now()) {}
 };
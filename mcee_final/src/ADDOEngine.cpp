@@ -6,11 +6,11 @@
  */
 
 #include "ADDOEngine.hpp"
-#include <numeric>
+#include "Logger.hpp"
 #include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <iomanip>
+#include <random>
 
 namespace mcee {
 
@@ -18,14 +18,17 @@ namespace mcee {
 // CONSTRUCTEUR
 // ═══════════════════════════════════════════════════════════════════════════
 
-ADDOEngine::ADDOEngine(const ADDOConfig& config)
-    : config_(config)
-    , resilience_(config.resilience_base)
-    , rng_(std::random_device{}())
-    , noise_dist_(config.stochasticity_bias, config.stochasticity_amplitude)
+template <typename Profile>
+BasicADDOEngine<Profile>::BasicADDOEngine(Profile profile)
+    : profile_(std::move(profile))
+    , kernels_(goal::GoalKernels::defaults())
+    , resilience_(cfg().resilience_base)
+    , rng_(cfg().stochasticity_seed != 0
+               ? cfg().stochasticity_seed
+               : (uint64_t{std::random_device{}()} << 32) | std::random_device{}())
 {
     // Initialiser les poids depuis la configuration
-    variables_.w = config_.initial_weights;
+    variables_.w = cfg().initial_weights;
 
     // Initialiser les variables à des valeurs neutres
     variables_.P.fill(0.5);
@@ -33,33 +36,59 @@ ADDOEngine::ADDOEngine(const ADDOConfig& config)
     // Contraintes par défaut (pas de limitation)
     variables_.L.fill(1.0);
 
-    std::cout << "[ADDO] Moteur initialisé avec " << NUM_GOAL_VARIABLES
-              << " variables\n";
-    std::cout << "[ADDO] Résilience initiale: " << resilience_ << "\n";
+    MCEE_LOG_INFO("ADDO", "Moteur initialisé avec ", NUM_GOAL_VARIABLES, " variables");
+    MCEE_LOG_INFO("ADDO", "Résilience initiale: ", resilience_);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MISE À JOUR PRINCIPALE
 // ═══════════════════════════════════════════════════════════════════════════
 
-GoalState ADDOEngine::update(const EmotionalState& emotional_state,
+template <typename Profile>
+GoalState BasicADDOEngine<Profile>::update(const EmotionalState& emotional_state,
                               double sentiment,
                               double wisdom)
 {
     return updateWithMemory(emotional_state, sentiment, wisdom, memory_influence_);
 }
 
-GoalState ADDOEngine::updateWithMemory(const EmotionalState& emotional_state,
+template <typename Profile>
+GoalState BasicADDOEngine<Profile>::updateWithMemory(const EmotionalState& emotional_state,
                                         double sentiment,
                                         double wisdom,
                                         const MemoryGraphInfluence& memory_influence)
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    advance(emotional_state, sentiment, wisdom, memory_influence);
+    return current_state_;
+}
 
+template <typename Profile>
+void BasicADDOEngine<Profile>::updateBatch(std::span<BasicADDOEngine* const> engines,
+                             std::span<const GoalUpdateInput> inputs,
+                             std::span<GoalState> out)
+{
+    const size_t n = std::min({engines.size(), inputs.size(), out.size()});
+    for (size_t i = 0; i < n; ++i) {
+        BasicADDOEngine& engine = *engines[i];
+        const GoalUpdateInput& input = inputs[i];
+        std::lock_guard<std::mutex> lock(engine.mutex_);
+        engine.advance(*input.emotional_state, input.sentiment, input.wisdom,
+                       engine.memory_influence_);
+        out[i] = engine.current_state_;
+    }
+}
+
+template <typename Profile>
+void BasicADDOEngine<Profile>::advance(const EmotionalState& emotional_state,
+                         double sentiment,
+                         double wisdom,
+                         const MemoryGraphInfluence& memory_influence)
+{
     double previous_goal = current_state_.G;
 
     // Mode urgence : court-circuiter le calcul normal
-    if (emergency_mode_ && config_.emergency_override) {
+    if (emergency_mode_ && cfg().emergency_override) {
         current_state_.emergency_override = true;
         current_state_.emergency_goal = emergency_goal_;
         current_state_.G = 1.0;  // Priorité maximale
@@ -69,7 +98,7 @@ GoalState ADDOEngine::updateWithMemory(const EmotionalState& emotional_state,
             on_emergency_(emergency_goal_);
         }
 
-        return current_state_;
+        return;
     }
 
     current_state_.emergency_override = false;
@@ -85,7 +114,7 @@ GoalState ADDOEngine::updateWithMemory(const EmotionalState& emotional_state,
     // ─────────────────────────────────────────────────────────────────────────
 
     // Sentiments ← Ft du ConscienceEngine (surcharge le mapping si activé)
-    if (config_.use_sentiment_for_S) {
+    if (cfg().use_sentiment_for_S) {
         // Convertir sentiment [-1, +1] vers [0, 1]
         variables_.P[static_cast<size_t>(GoalVariable::SENTIMENTS)] =
             (sentiment + 1.0) / 2.0;
@@ -110,7 +139,7 @@ GoalState ADDOEngine::updateWithMemory(const EmotionalState& emotional_state,
     // 4. Adapter les poids si sagesse active
     // ─────────────────────────────────────────────────────────────────────────
 
-    if (config_.use_wisdom_modulation) {
+    if (cfg().use_wisdom_modulation) {
         adaptWeights(wisdom);
     }
 
@@ -187,32 +216,34 @@ GoalState ADDOEngine::updateWithMemory(const EmotionalState& emotional_state,
         std::string reason = "Variable dominante: " + current_state_.dominant_variable;
         on_goal_change_(previous_goal, G, reason);
     }
-
-    return current_state_;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MODIFICATION DES VARIABLES
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::setVariable(GoalVariable var, double value) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setVariable(GoalVariable var, double value) {
     std::lock_guard<std::mutex> lock(mutex_);
     variables_.setVariable(var, value);
 }
 
-void ADDOEngine::setConstraint(GoalVariable var, double constraint) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setConstraint(GoalVariable var, double constraint) {
     std::lock_guard<std::mutex> lock(mutex_);
     size_t idx = static_cast<size_t>(var);
     variables_.L[idx] = std::clamp(constraint, 0.0, 2.0);
 }
 
-void ADDOEngine::updateExternalContext(double environment, double circumstances) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::updateExternalContext(double environment, double circumstances) {
     std::lock_guard<std::mutex> lock(mutex_);
     variables_.setVariable(GoalVariable::ENVIRONNEMENT, environment);
     variables_.setVariable(GoalVariable::CIRCONSTANCES, circumstances);
 }
 
-void ADDOEngine::updateNeeds(double physiological, double safety, double belonging,
+template <typename Profile>
+void BasicADDOEngine<Profile>::updateNeeds(double physiological, double safety, double belonging,
                               double esteem, double self_actualization) {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -241,12 +272,13 @@ void ADDOEngine::updateNeeds(double physiological, double safety, double belongi
 // RÉSILIENCE ET TRAUMA
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::recordSuccess(double intensity) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::recordSuccess(double intensity) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Augmenter la résilience
-    resilience_ += config_.resilience_growth_rate * intensity;
-    resilience_ = std::min(resilience_, config_.resilience_max);
+    resilience_ += cfg().resilience_growth_rate * intensity;
+    resilience_ = std::min(resilience_, cfg().resilience_max);
 
     // Augmenter la confiance en soi
     double current = variables_.getVariable(GoalVariable::CONNAISSANCE_SOI);
@@ -259,11 +291,12 @@ void ADDOEngine::recordSuccess(double intensity) {
                            current + 0.03 * intensity);
 }
 
-void ADDOEngine::recordFailure(double intensity) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::recordFailure(double intensity) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Diminuer la résilience (mais pas trop)
-    resilience_ -= config_.resilience_decay_on_trauma * intensity * 0.5;
+    resilience_ -= cfg().resilience_decay_on_trauma * intensity * 0.5;
     resilience_ = std::max(resilience_, 0.1);  // Plancher
 
     // Augmenter les regrets
@@ -272,21 +305,23 @@ void ADDOEngine::recordFailure(double intensity) {
                            current + 0.1 * intensity);
 }
 
-void ADDOEngine::signalTrauma(const TraumaState& trauma) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::signalTrauma(const TraumaState& trauma) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Mettre à jour la variable Traumatismes
     variables_.setVariable(GoalVariable::TRAUMATISMES, trauma.intensity);
 
     // Diminuer la résilience significativement
-    resilience_ -= config_.resilience_decay_on_trauma * trauma.intensity;
+    resilience_ -= cfg().resilience_decay_on_trauma * trauma.intensity;
     resilience_ = std::max(resilience_, 0.1);
 
     // Mettre à jour l'influence mémoire
     memory_influence_.T_trauma = trauma.intensity;
 }
 
-void ADDOEngine::setMemoryInfluence(double S_positive, double S_negative, double T_trauma) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setMemoryInfluence(double S_positive, double S_negative, double T_trauma) {
     std::lock_guard<std::mutex> lock(mutex_);
     memory_influence_.S_positive = S_positive;
     memory_influence_.S_negative = S_negative;
@@ -298,23 +333,26 @@ void ADDOEngine::setMemoryInfluence(double S_positive, double S_negative, double
 // URGENCE (AMYGHALEON)
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::triggerEmergencyOverride(const std::string& emergency_goal) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::triggerEmergencyOverride(const std::string& emergency_goal) {
     std::lock_guard<std::mutex> lock(mutex_);
     emergency_mode_ = true;
     emergency_goal_ = emergency_goal;
 
-    std::cout << "[ADDO] ⚡ Mode urgence activé: " << emergency_goal << "\n";
+    MCEE_LOG_INFO("ADDO", "⚡ Mode urgence activé: ", emergency_goal);
 }
 
-void ADDOEngine::clearEmergencyOverride() {
+template <typename Profile>
+void BasicADDOEngine<Profile>::clearEmergencyOverride() {
     std::lock_guard<std::mutex> lock(mutex_);
     emergency_mode_ = false;
     emergency_goal_.clear();
 
-    std::cout << "[ADDO] Mode urgence désactivé\n";
+    MCEE_LOG_INFO("ADDO", "Mode urgence désactivé");
 }
 
-bool ADDOEngine::isInEmergencyMode() const {
+template <typename Profile>
+bool BasicADDOEngine<Profile>::isInEmergencyMode() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return emergency_mode_;
 }
@@ -323,139 +361,165 @@ bool ADDOEngine::isInEmergencyMode() const {
 // ACCESSEURS
 // ═══════════════════════════════════════════════════════════════════════════
 
-double ADDOEngine::getCurrentGoal() const {
+template <typename Profile>
+double BasicADDOEngine<Profile>::getCurrentGoal() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return current_state_.G;
 }
 
-const GoalState& ADDOEngine::getCurrentState() const {
+template <typename Profile>
+const GoalState& BasicADDOEngine<Profile>::getCurrentState() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return current_state_;
 }
 
-double ADDOEngine::getResilience() const {
+template <typename Profile>
+double BasicADDOEngine<Profile>::getResilience() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return resilience_;
 }
 
-const GoalVariables& ADDOEngine::getVariables() const {
+template <typename Profile>
+const GoalVariables& BasicADDOEngine<Profile>::getVariables() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return variables_;
 }
 
-const InteractionMatrix& ADDOEngine::getInteractionMatrix() const {
+template <typename Profile>
+const InteractionMatrix& BasicADDOEngine<Profile>::getInteractionMatrix() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return interactions_;
+    return kernels_.interactions;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // CALLBACKS
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::setUpdateCallback(GoalUpdateCallback callback) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setUpdateCallback(GoalUpdateCallback callback) {
     on_update_ = std::move(callback);
 }
 
-void ADDOEngine::setGoalChangeCallback(GoalChangeCallback callback) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setGoalChangeCallback(GoalChangeCallback callback) {
     on_goal_change_ = std::move(callback);
 }
 
-void ADDOEngine::setEmergencyCallback(EmergencyGoalCallback callback) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setEmergencyCallback(EmergencyGoalCallback callback) {
     on_emergency_ = std::move(callback);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// HISTORIQUE
+// SÉRIALISATION
 // ═══════════════════════════════════════════════════════════════════════════
 
-const std::deque<double>& ADDOEngine::getGoalHistory() const {
+template <typename Profile>
+nlohmann::json BasicADDOEngine<Profile>::toJson() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return goal_history_;
-}
 
-double ADDOEngine::getGoalTrend() const {
+    std::vector<double> history(goal_history_.values().begin(), goal_history_.values().end());
+    return {
+        {"P", variables_.P},
+        {"w", variables_.w},
+        {"L", variables_.L},
+        {"resilience", resilience_},
+        {"emergency_mode", emergency_mode_},
+        {"emergency_goal", emergency_goal_},
+        {"G", current_state_.G},
+        {"G_raw", current_state_.G_raw},
+        {"dominant_variable", current_state_.dominant_variable},
+        {"dominant_value", current_state_.dominant_value},
+        {"goal_history", std::move(history)}
+    };
+}
+
+template <typename Profile>
+void BasicADDOEngine<Profile>::fromJson(const nlohmann::json& j) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (goal_history_.size() < 10) return 0.0;
+    auto readArray = [&](const char* key, std::array<double, NUM_GOAL_VARIABLES>& out) {
+        if (j.contains(key) && j[key].size() == out.size()) {
+            out = j[key].get<std::array<double, NUM_GOAL_VARIABLES>>();
+        }
+    };
+    readArray("P", variables_.P);
+    readArray("w", variables_.w);
+    readArray("L", variables_.L);
 
-    // Comparer la moyenne récente à la moyenne ancienne
-    double recent_sum = 0.0, old_sum = 0.0;
-    size_t n = goal_history_.size();
-    size_t half = n / 2;
+    resilience_ = j.value("resilience", resilience_);
+    emergency_mode_ = j.value("emergency_mode", emergency_mode_);
+    emergency_goal_ = j.value("emergency_goal", emergency_goal_);
 
-    for (size_t i = 0; i < half; ++i) {
-        old_sum += goal_history_[i];
-    }
-    for (size_t i = half; i < n; ++i) {
-        recent_sum += goal_history_[i];
+    current_state_.variables = variables_;
+    current_state_.resilience = resilience_;
+    current_state_.G = j.value("G", current_state_.G);
+    current_state_.G_raw = j.value("G_raw", current_state_.G_raw);
+    current_state_.dominant_variable = j.value("dominant_variable", current_state_.dominant_variable);
+    current_state_.dominant_value = j.value("dominant_value", current_state_.dominant_value);
+    current_state_.emergency_override = emergency_mode_;
+    current_state_.emergency_goal = emergency_goal_;
+
+    if (j.contains("goal_history")) {
+        goal_history_.clear();
+        for (const auto& value : j["goal_history"]) {
+            goal_history_.push_back(value.get<double>());
+        }
     }
+}
 
-    double old_avg = old_sum / half;
-    double recent_avg = recent_sum / (n - half);
+// ═══════════════════════════════════════════════════════════════════════════
+// HISTORIQUE
+// ═══════════════════════════════════════════════════════════════════════════
 
-    return recent_avg - old_avg;  // Positif = croissant
+template <typename Profile>
+const RingBuffer<double>& BasicADDOEngine<Profile>::getGoalHistory() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return goal_history_.values();
 }
 
-double ADDOEngine::getGoalStability() const {
+template <typename Profile>
+double BasicADDOEngine<Profile>::getGoalTrend() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (goal_history_.size() < 5) return 1.0;
+    if (goal_history_.size() < 10) return 0.0;
 
-    // Calculer l'écart-type
-    double sum = 0.0, sum_sq = 0.0;
-    for (double g : goal_history_) {
-        sum += g;
-        sum_sq += g * g;
-    }
+    // Positif = croissant
+    return goal_history_.slope() * static_cast<double>(goal_history_.size()) / 2.0;
+}
+
+template <typename Profile>
+double BasicADDOEngine<Profile>::getGoalStability() const {
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    double n = static_cast<double>(goal_history_.size());
-    double mean = sum / n;
-    double variance = (sum_sq / n) - (mean * mean);
-    double stddev = std::sqrt(std::max(0.0, variance));
+    if (goal_history_.size() < 5) return 1.0;
 
     // Stabilité = 1 - stddev normalisé
-    return std::max(0.0, 1.0 - stddev * 2.0);
+    return std::max(0.0, 1.0 - goal_history_.stddev() * 2.0);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MÉTHODES PRIVÉES
 // ═══════════════════════════════════════════════════════════════════════════
 
-double ADDOEngine::computeWeightedSum() const {
-    double sum = 0.0;
-    for (size_t i = 0; i < NUM_GOAL_VARIABLES; ++i) {
-        sum += variables_.w[i] * variables_.P[i] * variables_.L[i];
-    }
-    return sum;
+template <typename Profile>
+double BasicADDOEngine<Profile>::computeWeightedSum() const {
+    return goal::dot3(variables_.w, variables_.P, variables_.L);
 }
 
-double ADDOEngine::computePositiveInteractions() const {
-    double sum = 0.0;
-    for (size_t i = 0; i < NUM_GOAL_VARIABLES; ++i) {
-        for (size_t j = i + 1; j < NUM_GOAL_VARIABLES; ++j) {
-            double c_ij = interactions_.positive[i][j];
-            if (c_ij > 0.0) {
-                sum += c_ij * variables_.P[i] * variables_.P[j];
-            }
-        }
-    }
-    return sum * config_.interaction_positive_scale;
+template <typename Profile>
+double BasicADDOEngine<Profile>::computePositiveInteractions() const {
+    // Triangle supérieur creux : seules les synergies non nulles sont parcourues
+    return kernels_.positive.quadratic(variables_.P) * cfg().interaction_positive_scale;
 }
 
-double ADDOEngine::computeNegativeInteractions() const {
-    double sum = 0.0;
-    for (size_t i = 0; i < NUM_GOAL_VARIABLES; ++i) {
-        for (size_t k = i + 1; k < NUM_GOAL_VARIABLES; ++k) {
-            double c_ik = interactions_.negative[i][k];
-            if (c_ik > 0.0) {
-                sum += c_ik * variables_.P[i] * variables_.P[k];
-            }
-        }
-    }
-    return sum * config_.interaction_negative_scale;
+template <typename Profile>
+double BasicADDOEngine<Profile>::computeNegativeInteractions() const {
+    return kernels_.negative.quadratic(variables_.P) * cfg().interaction_negative_scale;
 }
 
-double ADDOEngine::computeResilienceTerm() const {
+template <typename Profile>
+double BasicADDOEngine<Profile>::computeResilienceTerm() const {
     // Rs(t) × Σ P_ℓ (pour les variables négatives : regrets, traumas)
     double negative_vars_sum = 0.0;
     negative_vars_sum += variables_.P[static_cast<size_t>(GoalVariable::REGRETS)];
@@ -465,22 +529,29 @@ double ADDOEngine::computeResilienceTerm() const {
     return resilience_ * (1.0 - negative_vars_sum) * 0.1;
 }
 
-double ADDOEngine::generateStochasticity() {
-    return noise_dist_(rng_);
+template <typename Profile>
+double BasicADDOEngine<Profile>::generateStochasticity() {
+    // Amplitude nulle : S(t) = biais, sans tirage (branche repliée en profil statique)
+    if (cfg().stochasticity_amplitude == 0.0) {
+        return cfg().stochasticity_bias;
+    }
+    return rng_.normal(cfg().stochasticity_bias, cfg().stochasticity_amplitude);
 }
 
-double ADDOEngine::computeMemoryInfluence() const {
+template <typename Profile>
+double BasicADDOEngine<Profile>::computeMemoryInfluence() const {
     return memory_influence_.compute(
-        config_.alpha_memory_positive,
-        config_.gamma_trauma
+        cfg().alpha_memory_positive,
+        cfg().gamma_trauma
     );
 }
 
-double ADDOEngine::applyOutputFunction(double raw_value) const {
-    if (config_.use_sigmoid_output) {
+template <typename Profile>
+double BasicADDOEngine<Profile>::applyOutputFunction(double raw_value) const {
+    if (cfg().use_sigmoid_output) {
         // Sigmoïde : 1 / (1 + e^(-k*x))
         // Centrée sur 0.5 pour un raw_value autour de 0.5
-        double centered = (raw_value - 0.5) * config_.sigmoid_steepness;
+        double centered = (raw_value - 0.5) * cfg().sigmoid_steepness;
         return 1.0 / (1.0 + std::exp(-centered));
     }
 
@@ -488,31 +559,34 @@ double ADDOEngine::applyOutputFunction(double raw_value) const {
     return std::clamp(raw_value, 0.0, 1.0);
 }
 
-void ADDOEngine::adaptWeights(double wisdom) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::adaptWeights(double wisdom) {
     if (wisdom <= 0.0) return;
 
     // La sagesse modère les extrêmes
     for (size_t i = 0; i < NUM_GOAL_VARIABLES; ++i) {
-        double base_weight = config_.initial_weights[i];
+        double base_weight = cfg().initial_weights[i];
         double current_weight = variables_.w[i];
 
         // Tirer les poids vers les valeurs de base avec la sagesse
         double target = base_weight * wisdom;
-        double adaptation = config_.weight_adaptation_rate * (target - current_weight);
+        double adaptation = cfg().weight_adaptation_rate * (target - current_weight);
 
         variables_.w[i] = std::clamp(current_weight + adaptation, 0.01, 0.5);
     }
 
     // Renormaliser pour que Σ w_i = 1
-    double sum = std::accumulate(variables_.w.begin(), variables_.w.end(), 0.0);
+    const double sum = goal::sum(variables_.w);
     if (sum > 0.0) {
+        const double inv = 1.0 / sum;
         for (auto& w : variables_.w) {
-            w /= sum;
+            w *= inv;
         }
     }
 }
 
-void ADDOEngine::findDominantVariable() {
+template <typename Profile>
+void BasicADDOEngine<Profile>::findDominantVariable() {
     size_t max_idx = 0;
     double max_val = 0.0;
 
@@ -528,63 +602,40 @@ void ADDOEngine::findDominantVariable() {
     current_state_.dominant_value = max_val;
 }
 
-void ADDOEngine::updateHistory(double goal) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::updateHistory(double goal) {
     goal_history_.push_back(goal);
-    while (goal_history_.size() > MAX_HISTORY_SIZE) {
-        goal_history_.pop_front();
-    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // INTÉGRATION MCTGraph
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::setMCTGraph(std::shared_ptr<MCTGraph> mct_graph) {
+template <typename Profile>
+void BasicADDOEngine<Profile>::setMCTGraph(std::shared_ptr<MCTGraph> mct_graph) {
     std::lock_guard<std::mutex> lock(mutex_);
     mct_graph_ = std::move(mct_graph);
-    std::cout << "[ADDO] MCTGraph connecté pour enrichissement M_graph(t)\n";
+    MCEE_LOG_INFO("ADDO", "MCTGraph connecté pour enrichissement M_graph(t)");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MAPPING ÉMOTIONS → VARIABLES
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ADDOEngine::applyEmotionMapping(const EmotionalState& emotional_state) {
-    // Accéder directement au vecteur des 24 émotions
-    const auto& emo_values = emotional_state.emotions;
-
-    // Pour chaque émotion active, appliquer son influence sur les variables
-    for (size_t emo_idx = 0; emo_idx < EmotionVariableMapping::NUM_EMOTIONS; ++emo_idx) {
-        double emotion_intensity = emo_values[emo_idx];
-
-        // Ignorer les émotions inactives (seuil minimal)
-        if (emotion_intensity < 0.05) continue;
-
-        // Appliquer l'influence sur chaque variable
-        for (size_t var_idx = 0; var_idx < NUM_GOAL_VARIABLES; ++var_idx) {
-            double weight = emotion_mapping_.weights[emo_idx][var_idx];
-
-            if (std::abs(weight) < 0.01) continue;  // Ignorer les poids négligeables
-
-            // Calculer l'influence: intensité_émotion × poids_mapping
-            double influence = emotion_intensity * weight;
-
-            // Modifier la variable avec atténuation (éviter les changements brusques)
-            double current_val = variables_.P[var_idx];
-            double delta = influence * 0.3;  // Facteur d'atténuation
-
-            // Appliquer le changement (positif ou négatif selon le poids)
-            double new_val = std::clamp(current_val + delta, 0.0, 1.0);
-            variables_.P[var_idx] = new_val;
-        }
-    }
+template <typename Profile>
+void BasicADDOEngine<Profile>::applyEmotionMapping(const EmotionalState& emotional_state) {
+    // Lignes creuses (émotion → variables non négligeables), atténuation 0.3 incluse
+    kernels_.emotions.apply(emotional_state.emotions, variables_.P);
 }
 
-void ADDOEngine::updateFromMCTGraph() {
+template <typename Profile>
+void BasicADDOEngine<Profile>::updateFromMCTGraph() {
     if (!mct_graph_) return;
 
-    // Analyser les associations causales du graphe
-    auto causal_analysis = mct_graph_->analyzeCausality();
+    // Analyser les associations causales du graphe : les sources les plus
+    // fortes dominent la moyenne pondérée, les suivantes ne sont pas lues
+    constexpr size_t MAX_CAUSAL_SOURCES = 32;
+    auto causal_analysis = mct_graph_->analyzeCausality(MAX_CAUSAL_SOURCES);
 
     double S_positive = 0.0;
     double S_negative = 0.0;
@@ -636,4 +687,11 @@ void ADDOEngine::updateFromMCTGraph() {
     memory_influence_.timestamp = std::chrono::steady_clock::now();
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// INSTANCIATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+template class BasicADDOEngine<RuntimeProfile<ADDOConfig>>;
+template class BasicADDOEngine<ProductionADDOProfile>;
+
 } // namespace mcee
@@ -6,28 +6,28 @@
  */
 
 #include "Amyghaleon.hpp"
-#include <iostream>
+#include "Logger.hpp"
 #include <iomanip>
 #include <algorithm>
 
 namespace mcee {
 
 Amyghaleon::Amyghaleon() {
-    std::cout << "[Amyghaleon] Système d'urgence initialisé\n";
+    MCEE_LOG_INFO("Amyghaleon", "Système d'urgence initialisé");
 }
 
 bool Amyghaleon::checkEmergency(
     const EmotionalState& state,
-    const std::vector<Memory>& active_memories,
+    std::span<const MemoryRef> active_memories,
     double phase_threshold) const 
 {
     // 1. Vérifier les émotions critiques
     auto [max_emotion, max_value] = findMaxCriticalEmotion(state);
     
     if (max_value > phase_threshold) {
-        std::cout << "[Amyghaleon] ⚠ Émotion critique détectée: " 
-                  << max_emotion << " = " << std::fixed << std::setprecision(3) 
-                  << max_value << " > seuil " << phase_threshold << "\n";
+        MCEE_LOG_WARN("Amyghaleon",
+            "Émotion critique détectée: ", max_emotion, " = ", std::fixed, std::setprecision(3),
+            max_value, " > seuil ", phase_threshold);
         return true;
     }
 
@@ -35,9 +35,9 @@ bool Amyghaleon::checkEmergency(
     double trauma_threshold = phase_threshold - 0.2;
     for (const auto& mem : active_memories) {
         if (isTraumaActivated(mem, trauma_threshold)) {
-            std::cout << "[Amyghaleon] ⚠ Trauma activé: " << mem.name 
-                      << " (activation=" << std::fixed << std::setprecision(3) 
-                      << mem.activation << ")\n";
+            MCEE_LOG_WARN("Amyghaleon",
+                "Trauma activé: ", mem->name, " (activation=", std::fixed, std::setprecision(3),
+                mem.activation, ")");
             return true;
         }
     }
@@ -45,8 +45,8 @@ bool Amyghaleon::checkEmergency(
     // 3. Vérifier combinaison émotion critique + trauma
     if (max_value > (phase_threshold + 0.2)) {
         for (const auto& mem : active_memories) {
-            if (mem.is_trauma && mem.activation > 0.6) {
-                std::cout << "[Amyghaleon] ⚠ Combinaison critique + trauma détectée\n";
+            if (mem->is_trauma && mem.activation > 0.6) {
+                MCEE_LOG_WARN("Amyghaleon", "Combinaison critique + trauma détectée");
                 return true;
             }
         }
@@ -71,15 +71,11 @@ EmergencyResponse Amyghaleon::triggerEmergencyResponse(
     response.trigger_emotion = max_emotion;
     response.emotion_value = max_value;
 
-    std::cout << "\n[Amyghaleon] ═══════════════════════════════════════\n"
-              << "[Amyghaleon] ⚡ RÉPONSE D'URGENCE DÉCLENCHÉE #" << emergency_count_ << "\n"
-              << "[Amyghaleon] ═══════════════════════════════════════\n"
-              << "[Amyghaleon] Action    : " << response.action << "\n"
-              << "[Amyghaleon] Priorité  : " << response.priority << "\n"
-              << "[Amyghaleon] Phase     : " << phaseToString(phase) << "\n"
-              << "[Amyghaleon] Émotion   : " << max_emotion << " = " 
-              << std::fixed << std::setprecision(3) << max_value << "\n"
-              << "[Amyghaleon] ═══════════════════════════════════════\n\n";
+    MCEE_LOG_WARN("Amyghaleon",
+        "⚡ RÉPONSE D'URGENCE DÉCLENCHÉE #", emergency_count_,
+        " action=", response.action, " priorité=", response.priority,
+        " phase=", phaseToString(phase), " émotion=", max_emotion, " = ",
+        std::fixed, std::setprecision(3), max_value);
 
     // Appeler le callback si défini
     if (on_emergency_) {
@@ -93,8 +89,8 @@ void Amyghaleon::setEmergencyCallback(EmergencyCallback callback) {
     on_emergency_ = std::move(callback);
 }
 
-bool Amyghaleon::isTraumaActivated(const Memory& memory, double threshold) const {
-    return memory.is_trauma && memory.activation > threshold;
+bool Amyghaleon::isTraumaActivated(const MemoryRef& memory, double threshold) const {
+    return memory->is_trauma && memory.activation > threshold;
 }
 
 std::pair<std::string, double> Amyghaleon::findMaxCriticalEmotion(
@@ -103,11 +99,11 @@ std::pair<std::string, double> Amyghaleon::findMaxCriticalEmotion(
     std::string max_name;
     double max_value = -1.0;
 
-    for (const auto& emo_name : CRITICAL_EMOTIONS) {
-        double value = state.getEmotion(emo_name);
+    for (size_t index : CRITICAL_EMOTION_INDICES) {
+        double value = state.emotions[index];
         if (value > max_value) {
             max_value = value;
-            max_name = emo_name;
+            max_name = EMOTION_NAMES[index];
         }
     }
 
@@ -115,17 +111,23 @@ std::pair<std::string, double> Amyghaleon::findMaxCriticalEmotion(
 }
 
 std::string Amyghaleon::determineAction(const std::string& emotion_name) const {
-    if (emotion_name == "Peur") {
-        return "FUITE";
-    } else if (emotion_name == "Horreur") {
-        return "BLOCAGE";
-    } else if (emotion_name == "Anxiété") {
-        return "ALERTE";
-    }
-    return "SURVEILLANCE";
+    return actionFor(emotionIndex(emotion_name));
 }
 
 std::string Amyghaleon::determinePriority(double emotion_value) const {
+    return priorityFor(emotion_value);
+}
+
+const char* Amyghaleon::actionFor(size_t emotion_index) {
+    switch (emotion_index) {
+        case EMO_PEUR:    return "FUITE";
+        case EMO_HORREUR: return "BLOCAGE";
+        case EMO_ANXIETE: return "ALERTE";
+        default:          return "SURVEILLANCE";
+    }
+}
+
+const char* Amyghaleon::priorityFor(double emotion_value) {
     if (emotion_value > 0.85) {
         return "CRITIQUE";
     } else if (emotion_value > 0.70) {
@@ -0,0 +1,672 @@
+/**
+ * @file BoltClient.cpp
+ * @brief Implémentation du transport Bolt natif
+ */
+
+#include "BoltClient.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace mcee::bolt {
+
+namespace {
+
+// Signatures des messages Bolt
+constexpr uint8_t MSG_HELLO = 0x01;
+constexpr uint8_t MSG_GOODBYE = 0x02;
+constexpr uint8_t MSG_RESET = 0x0F;
+constexpr uint8_t MSG_RUN = 0x10;
+constexpr uint8_t MSG_PULL = 0x3F;
+constexpr uint8_t MSG_SUCCESS = 0x70;
+constexpr uint8_t MSG_RECORD = 0x71;
+constexpr uint8_t MSG_IGNORED = 0x7E;
+constexpr uint8_t MSG_FAILURE = 0x7F;
+
+// Structures PackStream réduites à leurs propriétés
+constexpr uint8_t STRUCT_NODE = 0x4E;
+constexpr uint8_t STRUCT_RELATIONSHIP = 0x52;
+
+constexpr size_t MAX_CHUNK = 0xFFFF;
+
+void appendBigEndian(std::string& out, uint64_t value, size_t bytes) {
+    for (size_t i = bytes; i-- > 0;) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+/// En-tête de taille : forme courte (marker | n) sous 16, sinon 8/16/32 bits
+void packSize(std::string& out, size_t size, uint8_t tiny, uint8_t base) {
+    if (tiny != 0 && size < 16) {
+        out.push_back(static_cast<char>(tiny | size));
+    } else if (size <= 0xFF) {
+        out.push_back(static_cast<char>(base));
+        appendBigEndian(out, size, 1);
+    } else if (size <= 0xFFFF) {
+        out.push_back(static_cast<char>(base + 1));
+        appendBigEndian(out, size, 2);
+    } else {
+        out.push_back(static_cast<char>(base + 2));
+        appendBigEndian(out, size, 4);
+    }
+}
+
+void packInt(std::string& out, int64_t v) {
+    if (v >= -16 && v <= 127) {
+        out.push_back(static_cast<char>(static_cast<int8_t>(v)));
+    } else if (v >= std::numeric_limits<int8_t>::min() && v <= std::numeric_limits<int8_t>::max()) {
+        out.push_back(static_cast<char>(0xC8));
+        appendBigEndian(out, static_cast<uint8_t>(v), 1);
+    } else if (v >= std::numeric_limits<int16_t>::min() && v <= std::numeric_limits<int16_t>::max()) {
+        out.push_back(static_cast<char>(0xC9));
+        appendBigEndian(out, static_cast<uint16_t>(v), 2);
+    } else if (v >= std::numeric_limits<int32_t>::min() && v <= std::numeric_limits<int32_t>::max()) {
+        out.push_back(static_cast<char>(0xCA));
+        appendBigEndian(out, static_cast<uint32_t>(v), 4);
+    } else {
+        out.push_back(static_cast<char>(0xCB));
+        appendBigEndian(out, static_cast<uint64_t>(v), 8);
+    }
+}
+
+void structHeaderTo(std::string& out, size_t fields, uint8_t tag) {
+    out.push_back(static_cast<char>(0xB0 | fields));
+    out.push_back(static_cast<char>(tag));
+}
+
+std::string errnoMessage(const char* what) {
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PACKSTREAM
+// ═══════════════════════════════════════════════════════════════════════════
+
+void packString(std::string& out, std::string_view s) {
+    packSize(out, s.size(), 0x80, 0xD0);
+    out.append(s);
+}
+
+void pack(std::string& out, const json& value) {
+    switch (value.type()) {
+        case json::value_t::null:
+        case json::value_t::discarded:
+            out.push_back(static_cast<char>(0xC0));
+            break;
+        case json::value_t::boolean:
+            out.push_back(static_cast<char>(value.get<bool>() ? 0xC3 : 0xC2));
+            break;
+        case json::value_t::number_integer:
+            packInt(out, value.get<int64_t>());
+            break;
+        case json::value_t::number_unsigned: {
+            const uint64_t u = value.get<uint64_t>();
+            if (u > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                throw BoltError("entier hors de l'intervalle PackStream");
+            }
+            packInt(out, static_cast<int64_t>(u));
+            break;
+        }
+        case json::value_t::number_float:
+            out.push_back(static_cast<char>(0xC1));
+            appendBigEndian(out, std::bit_cast<uint64_t>(value.get<double>()), 8);
+            break;
+        case json::value_t::string:
+            packString(out, value.get_ref<const std::string&>());
+            break;
+        case json::value_t::array:
+            packSize(out, value.size(), 0x90, 0xD4);
+            for (const auto& item : value) pack(out, item);
+            break;
+        case json::value_t::object:
+            packSize(out, value.size(), 0xA0, 0xD8);
+            for (const auto& [key, item] : value.items()) {
+                packString(out, key);
+                pack(out, item);
+            }
+            break;
+        case json::value_t::binary: {
+            const auto& bytes = value.get_binary();
+            packSize(out, bytes.size(), 0, 0xCC);
+            out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+            break;
+        }
+    }
+}
+
+uint8_t Unpacker::byte() {
+    if (p_ == end_) throw BoltError("message PackStream tronqué");
+    return *p_++;
+}
+
+uint64_t Unpacker::bigEndian(size_t bytes) {
+    if (static_cast<size_t>(end_ - p_) < bytes) throw BoltError("message PackStream tronqué");
+    uint64_t v = 0;
+    for (size_t i = 0; i < bytes; ++i) v = (v << 8) | *p_++;
+    return v;
+}
+
+std::string Unpacker::string(size_t size) {
+    if (static_cast<size_t>(end_ - p_) < size) throw BoltError("message PackStream tronqué");
+    std::string s(reinterpret_cast<const char*>(p_), size);
+    p_ += size;
+    return s;
+}
+
+void Unpacker::structHeader(size_t& fields, uint8_t& tag) {
+    const uint8_t marker = byte();
+    if ((marker & 0xF0) != 0xB0) throw BoltError("structure PackStream attendue");
+    fields = marker & 0x0F;
+    tag = byte();
+}
+
+size_t Unpacker::listHeader() {
+    const uint8_t marker = byte();
+    if ((marker & 0xF0) == 0x90) return marker & 0x0F;
+    switch (marker) {
+        case 0xD4: return bigEndian(1);
+        case 0xD5: return bigEndian(2);
+        case 0xD6: return bigEndian(4);
+        default: throw BoltError("liste PackStream attendue");
+    }
+}
+
+json Unpacker::value() {
+    const uint8_t marker = byte();
+
+    // Entiers courts : -16..127 sur un octet
+    if (marker < 0x80) return static_cast<int64_t>(marker);
+    if (marker >= 0xF0) return static_cast<int64_t>(static_cast<int8_t>(marker));
+
+    switch (marker & 0xF0) {
+        case 0x80: return string(marker & 0x0F);
+        case 0x90: return list(marker & 0x0F);
+        case 0xA0: return map(marker & 0x0F);
+        case 0xB0: return structure(marker & 0x0F);
+        default: break;
+    }
+
+    switch (marker) {
+        case 0xC0: return nullptr;
+        case 0xC1: return std::bit_cast<double>(bigEndian(8));
+        case 0xC2: return false;
+        case 0xC3: return true;
+        case 0xC8: return static_cast<int64_t>(static_cast<int8_t>(bigEndian(1)));
+        case 0xC9: return static_cast<int64_t>(static_cast<int16_t>(bigEndian(2)));
+        case 0xCA: return static_cast<int64_t>(static_cast<int32_t>(bigEndian(4)));
+        case 0xCB: return static_cast<int64_t>(bigEndian(8));
+        case 0xCC: case 0xCD: case 0xCE: {
+            const std::string raw = string(bigEndian(size_t{1} << (marker - 0xCC)));
+            return json::binary(std::vector<uint8_t>(raw.begin(), raw.end()));
+        }
+        case 0xD0: case 0xD1: case 0xD2: return string(bigEndian(size_t{1} << (marker - 0xD0)));
+        case 0xD4: case 0xD5: case 0xD6: return list(bigEndian(size_t{1} << (marker - 0xD4)));
+        case 0xD8: case 0xD9: case 0xDA: return map(bigEndian(size_t{1} << (marker - 0xD8)));
+        default: throw BoltError("marqueur PackStream inconnu");
+    }
+}
+
+json Unpacker::list(size_t size) {
+    json out = json::array();
+    for (size_t i = 0; i < size; ++i) out.push_back(value());
+    return out;
+}
+
+json Unpacker::map(size_t size) {
+    json out = json::object();
+    for (size_t i = 0; i < size; ++i) {
+        json key = value();
+        if (!key.is_string()) throw BoltError("clé de map PackStream non textuelle");
+        out[key.get<std::string>()] = value();
+    }
+    return out;
+}
+
+json Unpacker::structure(size_t size) {
+    const uint8_t tag = byte();
+    json fields = list(size);
+    // Node (id, labels, props[, element_id]), Relationship (id, start, end, type, props[, ...])
+    if (tag == STRUCT_NODE && fields.size() >= 3) return std::move(fields[2]);
+    if (tag == STRUCT_RELATIONSHIP && fields.size() >= 5) return std::move(fields[4]);
+    return json{{"tag", tag}, {"fields", std::move(fields)}};
+}
+
+Statement::Statement(std::string cypher) : cypher_(std::move(cypher)) {
+    packString(packed_, cypher_);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONNEXION
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::unique_ptr<Connection> Connection::open(const BoltConfig& config) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    const std::string port = std::to_string(config.port);
+    if (const int rc = ::getaddrinfo(config.host.c_str(), port.c_str(), &hints, &addresses); rc != 0) {
+        throw BoltError("résolution de " + config.host + ": " + ::gai_strerror(rc));
+    }
+
+    int fd = -1;
+    std::string last_error = "aucune adresse";
+    for (addrinfo* a = addresses; a != nullptr && fd < 0; a = a->ai_next) {
+        fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) {
+            last_error = errnoMessage("socket");
+            continue;
+        }
+
+        // Connexion non bloquante bornée par connect_timeout_ms
+        const int flags = ::fcntl(fd, F_GETFL, 0);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int rc = ::connect(fd, a->ai_addr, a->ai_addrlen);
+        if (rc < 0 && errno == EINPROGRESS) {
+            pollfd pfd{fd, POLLOUT, 0};
+            rc = ::poll(&pfd, 1, config.connect_timeout_ms);
+            if (rc == 0) {
+                errno = ETIMEDOUT;
+                rc = -1;
+            } else if (rc > 0) {
+                int so_error = 0;
+                socklen_t len = sizeof(so_error);
+                ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len);
+                errno = so_error;
+                rc = so_error == 0 ? 0 : -1;
+            }
+        }
+        if (rc < 0) {
+            last_error = errnoMessage("connect");
+            ::close(fd);
+            fd = -1;
+            continue;
+        }
+        ::fcntl(fd, F_SETFL, flags);
+    }
+    ::freeaddrinfo(addresses);
+
+    if (fd < 0) {
+        throw BoltError(config.host + ":" + port + " injoignable (" + last_error + ")");
+    }
+
+    timeval tv{};
+    tv.tv_sec = config.io_timeout_ms / 1000;
+    tv.tv_usec = (config.io_timeout_ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    const int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    std::unique_ptr<Connection> connection(new Connection(fd, config));
+    connection->handshake();
+    connection->hello();
+    return connection;
+}
+
+Connection::Connection(int fd, const BoltConfig& config)
+    : fd_(fd), config_(config), in_(64 * 1024)
+{
+    json extra = json::object();
+    if (!config_.database.empty()) extra["db"] = config_.database;
+    pack(db_extra_, extra);
+}
+
+Connection::~Connection() {
+    if (healthy()) {
+        try {
+            std::string out;
+            std::string goodbye;
+            structHeaderTo(goodbye, 0, MSG_GOODBYE);
+            appendMessage(out, goodbye);
+            writeAll(out);
+        } catch (...) {}
+    }
+    close();
+}
+
+void Connection::close() noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void Connection::handshake() {
+    // Préambule puis quatre propositions [réservé, plage, mineure, majeure] :
+    // 5.0, puis 4.4 à 4.2
+    static constexpr std::array<uint8_t, 20> request = {
+        0x60, 0x60, 0xB0, 0x17,
+        0x00, 0x00, 0x00, 0x05,
+        0x00, 0x02, 0x04, 0x04,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00
+    };
+    writeAll(std::string(reinterpret_cast<const char*>(request.data()), request.size()));
+
+    std::array<uint8_t, 4> agreed{};
+    readExact(agreed.data(), agreed.size());
+    major_ = agreed[3];
+    minor_ = agreed[2];
+    if (major_ == 0) {
+        broken_ = true;
+        throw BoltError("aucune version Bolt commune avec le serveur");
+    }
+}
+
+void Connection::hello() {
+    json extra = {{"user_agent", config_.user_agent}};
+    if (config_.password.empty()) {
+        extra["scheme"] = "none";
+    } else {
+        extra["scheme"] = "basic";
+        extra["principal"] = config_.user;
+        extra["credentials"] = config_.password;
+    }
+
+    std::string message;
+    structHeaderTo(message, 1, MSG_HELLO);
+    pack(message, extra);
+    std::string out;
+    appendMessage(out, message);
+    writeAll(out);
+
+    Unpacker body(nullptr, 0);
+    const uint8_t signature = readMessage(body);
+    if (signature != MSG_SUCCESS) {
+        const json metadata = body.value();
+        broken_ = true;
+        throw BoltError("authentification refusée: " + metadata.value("message", std::string("?")));
+    }
+}
+
+void Connection::appendRun(std::string& out, const Query& query) const {
+    std::string message;
+    structHeaderTo(message, 3, MSG_RUN);
+    if (query.statement) {
+        message.append(query.statement->packed());
+    } else {
+        packString(message, query.cypher);
+    }
+    pack(message, query.params.is_null() ? json::object() : query.params);
+    message.append(db_extra_);
+    appendMessage(out, message);
+}
+
+void Connection::appendPull(std::string& out) {
+    static const std::string message = [] {
+        std::string m;
+        structHeaderTo(m, 1, MSG_PULL);
+        pack(m, json{{"n", -1}});
+        return m;
+    }();
+    appendMessage(out, message);
+}
+
+void Connection::appendMessage(std::string& out, const std::string& message) {
+    for (size_t begin = 0; begin < message.size(); begin += MAX_CHUNK) {
+        const size_t size = std::min(MAX_CHUNK, message.size() - begin);
+        appendBigEndian(out, size, 2);
+        out.append(message, begin, size);
+    }
+    out.append("\0\0", 2);
+}
+
+void Connection::writeAll(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            broken_ = true;
+            throw BoltError(errnoMessage("envoi Bolt"));
+        }
+        sent += static_cast<size_t>(n);
+    }
+}
+
+void Connection::readExact(uint8_t* dst, size_t size) {
+    while (size > 0) {
+        if (in_begin_ == in_end_) {
+            const ssize_t n = ::recv(fd_, in_.data(), in_.size(), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                broken_ = true;
+                throw BoltError(n == 0 ? std::string("connexion Bolt fermée par le serveur")
+                                       : errnoMessage("réception Bolt"));
+            }
+            in_begin_ = 0;
+            in_end_ = static_cast<size_t>(n);
+        }
+        const size_t take = std::min(size, in_end_ - in_begin_);
+        std::memcpy(dst, in_.data() + in_begin_, take);
+        in_begin_ += take;
+        dst += take;
+        size -= take;
+    }
+}
+
+uint8_t Connection::readMessage(Unpacker& body) {
+    message_.clear();
+    for (;;) {
+        uint8_t header[2];
+        readExact(header, 2);
+        const size_t size = (size_t{header[0]} << 8) | header[1];
+        if (size == 0) {
+            if (message_.empty()) continue;   // NOOP de maintien de connexion
+            break;
+        }
+        const size_t offset = message_.size();
+        message_.resize(offset + size);
+        readExact(reinterpret_cast<uint8_t*>(message_.data() + offset), size);
+    }
+
+    body = Unpacker(reinterpret_cast<const uint8_t*>(message_.data()), message_.size());
+    size_t fields = 0;
+    uint8_t signature = 0;
+    body.structHeader(fields, signature);
+    return signature;
+}
+
+bool Connection::readSummary(QueryResult& result, json* metadata) {
+    Unpacker body(nullptr, 0);
+    const uint8_t signature = readMessage(body);
+    switch (signature) {
+        case MSG_SUCCESS:
+            if (metadata) *metadata = body.value();
+            return true;
+        case MSG_FAILURE: {
+            const json failure = body.value();
+            result.code = failure.value("code", std::string());
+            result.error = failure.value("message", std::string("échec Cypher"));
+            return false;
+        }
+        case MSG_IGNORED:
+            result.ignored = true;
+            return false;
+        default:
+            broken_ = true;
+            throw BoltError("réponse Bolt inattendue");
+    }
+}
+
+std::vector<QueryResult> Connection::pipeline(std::span<const Query> queries) {
+    std::vector<QueryResult> results(queries.size());
+    if (queries.empty()) return results;
+
+    std::string out;
+    for (const auto& query : queries) {
+        appendRun(out, query);
+        appendPull(out);
+    }
+    writeAll(out);
+
+    bool failed = false;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        QueryResult& result = results[i];
+
+        // Réponse au RUN : noms des colonnes
+        json header;
+        const bool run_ok = readSummary(result, &header);
+        fields_.clear();
+        if (run_ok && header.contains("fields")) {
+            for (const auto& field : header["fields"]) fields_.push_back(field.get<std::string>());
+        }
+
+        // Réponse au PULL : enregistrements puis résumé
+        for (;;) {
+            Unpacker body(nullptr, 0);
+            const uint8_t signature = readMessage(body);
+            if (signature == MSG_RECORD) {
+                const size_t n = body.listHeader();
+                values_.resize(n);
+                for (size_t k = 0; k < n; ++k) values_[k] = body.value();
+                ++result.records;
+                if (queries[i].on_record) queries[i].on_record(fields_, values_);
+                continue;
+            }
+            if (signature == MSG_SUCCESS) {
+                result.summary = body.value();
+                result.success = run_ok;
+            } else if (signature == MSG_FAILURE) {
+                const json failure = body.value();
+                result.code = failure.value("code", std::string());
+                result.error = failure.value("message", std::string("échec Cypher"));
+            } else if (signature == MSG_IGNORED) {
+                result.ignored = result.ignored || result.error.empty();
+            } else {
+                broken_ = true;
+                throw BoltError("réponse Bolt inattendue");
+            }
+            break;
+        }
+        failed = failed || !result.success;
+    }
+
+    // Un échec laisse la session en état FAILED : RESET avant réutilisation
+    if (failed) {
+        std::string reset_message;
+        structHeaderTo(reset_message, 0, MSG_RESET);
+        std::string reset;
+        appendMessage(reset, reset_message);
+        writeAll(reset);
+        QueryResult ignored;
+        if (!readSummary(ignored, nullptr)) {
+            broken_ = true;
+            throw BoltError("RESET refusé");
+        }
+    }
+    return results;
+}
+
+QueryResult Connection::run(const Query& query) {
+    return std::move(pipeline(std::span<const Query>(&query, 1)).front());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// POOL
+// ═══════════════════════════════════════════════════════════════════════════
+
+Pool::Pool(BoltConfig config) : config_(std::move(config)) {
+    config_.pool_size = std::max<size_t>(1, config_.pool_size);
+}
+
+Pool::~Pool() {
+    close();
+}
+
+Pool::Lease& Pool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        connection_ = std::move(other.connection_);
+    }
+    return *this;
+}
+
+Pool::Lease::~Lease() {
+    release();
+}
+
+void Pool::Lease::release() noexcept {
+    if (pool_ && connection_) {
+        pool_->giveBack(std::move(connection_));
+    }
+    pool_ = nullptr;
+}
+
+Pool::Lease Pool::acquire(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        if (closed_) throw BoltError("pool Bolt fermé");
+        if (!idle_.empty()) {
+            auto connection = std::move(idle_.back());
+            idle_.pop_back();
+            return Lease(this, std::move(connection));
+        }
+        if (open_ < config_.pool_size) break;
+        if (available_.wait_until(lock, deadline) == std::cv_status::timeout && idle_.empty()) {
+            throw BoltError("aucune connexion Bolt libre");
+        }
+    }
+
+    // Ouverture hors verrou : la négociation prend un aller-retour réseau
+    ++open_;
+    lock.unlock();
+    try {
+        return Lease(this, Connection::open(config_));
+    } catch (...) {
+        lock.lock();
+        --open_;
+        available_.notify_one();
+        throw;
+    }
+}
+
+void Pool::giveBack(std::unique_ptr<Connection> connection) noexcept {
+    std::unique_ptr<Connection> discarded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_ || !connection->healthy()) {
+            discarded = std::move(connection);
+            --open_;
+        } else {
+            idle_.push_back(std::move(connection));
+        }
+    }
+    available_.notify_one();
+    // discarded : GOODBYE et fermeture hors verrou
+}
+
+void Pool::close() {
+    std::vector<std::unique_ptr<Connection>> idle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        idle.swap(idle_);
+        open_ -= idle.size();
+    }
+    available_.notify_all();
+}
+
+size_t Pool::openConnections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+} // namespace mcee::bolt
@@ -9,9 +9,13 @@ namespace mcee {
 // CONSTRUCTEUR
 // ═══════════════════════════════════════════════════════════════════════════
 
-ConscienceEngine::ConscienceEngine(const ConscienceConfig& config)
-    : config_(config)
-    , wisdom_(config.wisdom_base)
+template <typename Profile>
+BasicConscienceEngine<Profile>::BasicConscienceEngine(Profile profile)
+    : profile_(std::move(profile))
+    , alpha_emotions_(cfg().alpha_emotions)
+    , sentiment_history_(static_cast<size_t>(cfg().sentiment_window_seconds),
+                         cfg().sentiment_smoothing)
+    , wisdom_(cfg().wisdom_base)
 {
     current_state_.timestamp = std::chrono::steady_clock::now();
     current_state_.wisdom = wisdom_;
@@ -21,7 +25,8 @@ ConscienceEngine::ConscienceEngine(const ConscienceConfig& config)
 // MISE À JOUR PRINCIPALE
 // ═══════════════════════════════════════════════════════════════════════════
 
-ConscienceSentimentState ConscienceEngine::update(
+template <typename Profile>
+ConscienceSentimentState BasicConscienceEngine<Profile>::update(
     const EmotionalState& emotions,
     const std::vector<MemoryActivation>& memories,
     const FeedbackState& feedback,
@@ -66,7 +71,7 @@ ConscienceSentimentState ConscienceEngine::update(
     current_state_.feedback_contribution = feedback_contrib;
     current_state_.environment_contribution = environment_contrib;
 
-    current_state_.sentiment_moving_average = sentiment_ema_;
+    current_state_.sentiment_moving_average = sentiment_history_.ema();
     current_state_.dominant_state = determineDominantState(consciousness, sentiment);
     current_state_.timestamp = std::chrono::steady_clock::now();
 
@@ -78,7 +83,8 @@ ConscienceSentimentState ConscienceEngine::update(
     return current_state_;
 }
 
-ConscienceSentimentState ConscienceEngine::updateSimple(const EmotionalState& emotions) {
+template <typename Profile>
+ConscienceSentimentState BasicConscienceEngine<Profile>::updateSimple(const EmotionalState& emotions) {
     return update(
         emotions,
         {},                     // Pas de mémoires
@@ -91,7 +97,8 @@ ConscienceSentimentState ConscienceEngine::updateSimple(const EmotionalState& em
 // GESTION DES TRAUMAS
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ConscienceEngine::activateTrauma(const TraumaState& trauma) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::activateTrauma(const TraumaState& trauma) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Vérifier si le trauma existe déjà
@@ -107,12 +114,13 @@ void ConscienceEngine::activateTrauma(const TraumaState& trauma) {
     }
 
     // Alerter si le trauma dépasse le seuil
-    if (trauma.intensity >= config_.trauma_alert_threshold && trauma_callback_) {
+    if (trauma.intensity >= cfg().trauma_alert_threshold && trauma_callback_) {
         trauma_callback_(trauma);
     }
 }
 
-void ConscienceEngine::deactivateTrauma(const std::string& trauma_id) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::deactivateTrauma(const std::string& trauma_id) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     active_traumas_.erase(
@@ -122,7 +130,8 @@ void ConscienceEngine::deactivateTrauma(const std::string& trauma_id) {
     );
 }
 
-std::optional<TraumaState> ConscienceEngine::getDominantTrauma() const {
+template <typename Profile>
+std::optional<TraumaState> BasicConscienceEngine<Profile>::getDominantTrauma() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
     if (active_traumas_.empty()) {
@@ -142,68 +151,74 @@ std::optional<TraumaState> ConscienceEngine::getDominantTrauma() const {
 // MODULATION MLT
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ConscienceEngine::modulateEmotionCoefficients(const std::array<double, 24>& new_alphas) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::modulateEmotionCoefficients(const std::array<double, 24>& new_alphas) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Normaliser les coefficients pour que leur somme = 1
     double sum = std::accumulate(new_alphas.begin(), new_alphas.end(), 0.0);
     if (sum > 0.0) {
         for (size_t i = 0; i < 24; ++i) {
-            config_.alpha_emotions[i] = new_alphas[i] / sum;
+            alpha_emotions_[i] = new_alphas[i] / sum;
         }
     }
 
     // Notifier MLT de la modulation
     if (mlt_callback_) {
-        mlt_callback_(config_.alpha_emotions);
+        mlt_callback_(alpha_emotions_);
     }
 }
 
-const std::array<double, 24>& ConscienceEngine::getEmotionCoefficients() const {
-    return config_.alpha_emotions;
+template <typename Profile>
+const std::array<double, 24>& BasicConscienceEngine<Profile>::getEmotionCoefficients() const {
+    return alpha_emotions_;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // SAGESSE (Wt)
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ConscienceEngine::addExperience(double amount) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::addExperience(double amount) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     experience_ += amount;
 
     // Wt = wisdom_base + wisdom_growth_rate * log(1 + experience)
-    wisdom_ = config_.wisdom_base +
-              config_.wisdom_growth_rate * std::log1p(experience_);
+    wisdom_ = cfg().wisdom_base +
+              cfg().wisdom_growth_rate * std::log1p(experience_);
 
     // Appliquer le plafond
-    wisdom_ = std::min(wisdom_, config_.wisdom_max);
+    wisdom_ = std::min(wisdom_, cfg().wisdom_max);
 }
 
-void ConscienceEngine::applyWisdomDecay() {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::applyWisdomDecay() {
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Décroissance lente de l'expérience pour éviter accumulation infinie
-    experience_ *= config_.experience_decay_rate;
+    experience_ *= cfg().experience_decay_rate;
 
     // Décroissance lente de la sagesse vers le plancher
-    if (wisdom_ > config_.wisdom_floor) {
-        wisdom_ *= config_.wisdom_decay_rate;
-        wisdom_ = std::max(wisdom_, config_.wisdom_floor);
+    if (wisdom_ > cfg().wisdom_floor) {
+        wisdom_ *= cfg().wisdom_decay_rate;
+        wisdom_ = std::max(wisdom_, cfg().wisdom_floor);
     }
 
     // Recalculer en fonction de l'expérience décroissante
-    double calculated = config_.wisdom_base +
-                       config_.wisdom_growth_rate * std::log1p(experience_);
-    wisdom_ = std::min(wisdom_, std::min(calculated, config_.wisdom_max));
+    double calculated = cfg().wisdom_base +
+                       cfg().wisdom_growth_rate * std::log1p(experience_);
+    wisdom_ = std::min(wisdom_, std::min(calculated, cfg().wisdom_max));
 }
 
-double ConscienceEngine::getWisdom() const {
+template <typename Profile>
+double BasicConscienceEngine<Profile>::getWisdom() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return wisdom_;
 }
 
-double ConscienceEngine::getExperience() const {
+template <typename Profile>
+double BasicConscienceEngine<Profile>::getExperience() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return experience_;
 }
@@ -212,31 +227,113 @@ double ConscienceEngine::getExperience() const {
 // ACCÈS À L'ÉTAT
 // ═══════════════════════════════════════════════════════════════════════════
 
-ConscienceSentimentState ConscienceEngine::getCurrentState() const {
+template <typename Profile>
+ConscienceSentimentState BasicConscienceEngine<Profile>::getCurrentState() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return current_state_;
 }
 
-double ConscienceEngine::getSentimentMovingAverage() const {
+template <typename Profile>
+double BasicConscienceEngine<Profile>::getSentimentMovingAverage() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return sentiment_ema_;
+    return sentiment_history_.ema();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SÉRIALISATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+template <typename Profile>
+nlohmann::json BasicConscienceEngine<Profile>::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    nlohmann::json traumas = nlohmann::json::array();
+    for (const auto& trauma : active_traumas_) {
+        traumas.push_back({
+            {"id", trauma.id},
+            {"type", static_cast<int>(trauma.type)},
+            {"intensity", trauma.intensity},
+            {"activation_time", trauma.activation_time},
+            {"trigger_context", trauma.trigger_context},
+            {"source", trauma.source},
+            {"source_memory_id", trauma.source_memory_id},
+            {"is_active", trauma.is_active}
+        });
+    }
+
+    std::vector<double> sentiments(sentiment_history_.values().begin(), sentiment_history_.values().end());
+
+    return {
+        {"experience", experience_},
+        {"wisdom", wisdom_},
+        {"consciousness_level", current_state_.consciousness_level},
+        {"sentiment", current_state_.sentiment},
+        {"dominant_state", current_state_.dominant_state},
+        {"alpha_emotions", alpha_emotions_},
+        {"traumas", std::move(traumas)},
+        {"sentiment_history", std::move(sentiments)}
+    };
+}
+
+template <typename Profile>
+void BasicConscienceEngine<Profile>::fromJson(const nlohmann::json& j) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    experience_ = j.value("experience", experience_);
+    wisdom_ = j.value("wisdom", wisdom_);
+    current_state_.consciousness_level = j.value("consciousness_level", current_state_.consciousness_level);
+    current_state_.sentiment = j.value("sentiment", current_state_.sentiment);
+    current_state_.dominant_state = j.value("dominant_state", current_state_.dominant_state);
+    current_state_.wisdom = wisdom_;
+
+    if (j.contains("alpha_emotions") && j["alpha_emotions"].size() == alpha_emotions_.size()) {
+        alpha_emotions_ = j["alpha_emotions"].get<std::array<double, 24>>();
+    }
+
+    if (j.contains("traumas")) {
+        active_traumas_.clear();
+        for (const auto& t : j["traumas"]) {
+            TraumaState trauma;
+            trauma.id = t.value("id", std::string());
+            trauma.type = static_cast<TraumaType>(t.value("type", 0));
+            trauma.intensity = t.value("intensity", 0.0);
+            trauma.activation_time = t.value("activation_time", 0.0);
+            trauma.trigger_context = t.value("trigger_context", std::string());
+            trauma.source = t.value("source", std::string());
+            trauma.source_memory_id = t.value("source_memory_id", uint64_t{0});
+            trauma.is_active = t.value("is_active", false);
+            active_traumas_.push_back(std::move(trauma));
+        }
+    }
+
+    // Fenêtre reconstruite par poussées successives (statistiques et EMA recalculées)
+    if (j.contains("sentiment_history")) {
+        sentiment_history_.clear();
+        for (const auto& value : j["sentiment_history"]) {
+            sentiment_history_.push_back(value.get<double>());
+        }
+        current_state_.sentiment_moving_average = sentiment_history_.ema();
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // CALLBACKS
 // ═══════════════════════════════════════════════════════════════════════════
 
-void ConscienceEngine::setUpdateCallback(ConscienceUpdateCallback callback) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::setUpdateCallback(ConscienceUpdateCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
     update_callback_ = std::move(callback);
 }
 
-void ConscienceEngine::setTraumaAlertCallback(TraumaAlertCallback callback) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::setTraumaAlertCallback(TraumaAlertCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
     trauma_callback_ = std::move(callback);
 }
 
-void ConscienceEngine::setMLTModulationCallback(MLTModulationCallback callback) {
+template <typename Profile>
+void BasicConscienceEngine<Profile>::setMLTModulationCallback(MLTModulationCallback callback) {
     std::lock_guard<std::mutex> lock(mutex_);
     mlt_callback_ = std::move(callback);
 }
@@ -245,16 +342,18 @@ void ConscienceEngine::setMLTModulationCallback(MLTModulationCallback callback)
 // CALCULS INTERNES
 // ═══════════════════════════════════════════════════════════════════════════
 
-double ConscienceEngine::computeEmotionalContribution(const EmotionalState& emotions) const {
+template <typename Profile>
+double BasicConscienceEngine<Profile>::computeEmotionalContribution(const EmotionalState& emotions) const {
     // Σ αi·Ei(t)
     double sum = 0.0;
     for (size_t i = 0; i < 24; ++i) {
-        sum += config_.alpha_emotions[i] * emotions.emotions[i];
+        sum += alpha_emotions_[i] * emotions.emotions[i];
     }
     return sum;
 }
 
-double ConscienceEngine::computeMemoryContribution(
+template <typename Profile>
+double BasicConscienceEngine<Profile>::computeMemoryContribution(
     const std::vector<MemoryActivation>& memories) const {
 
     if (memories.empty()) {
@@ -271,7 +370,8 @@ double ConscienceEngine::computeMemoryContribution(
     return std::min(total / std::max(memories.size(), (size_t)1), 1.0);
 }
 
-double ConscienceEngine::computeTraumaContribution() const {
+template <typename Profile>
+double BasicConscienceEngine<Profile>::computeTraumaContribution() const {
     if (active_traumas_.empty()) {
         return 0.0;
     }
@@ -285,10 +385,11 @@ double ConscienceEngine::computeTraumaContribution() const {
     }
 
     // Pondérer par omega_trauma (priorité absolue)
-    return config_.omega_trauma * max_intensity;
+    return cfg().omega_trauma * max_intensity;
 }
 
-double ConscienceEngine::computeConsciousness(
+template <typename Profile>
+double BasicConscienceEngine<Profile>::computeConsciousness(
     double emotional_contrib,
     double memory_contrib,
     double trauma_contrib,
@@ -301,8 +402,8 @@ double ConscienceEngine::computeConsciousness(
         emotional_contrib +
         memory_contrib +
         trauma_contrib +
-        config_.beta_memory * feedback_contrib +
-        config_.delta_environment * environment_contrib;
+        cfg().beta_memory * feedback_contrib +
+        cfg().delta_environment * environment_contrib;
 
     // Appliquer la sagesse comme multiplicateur
     double consciousness = raw_consciousness * wisdom_;
@@ -311,7 +412,8 @@ double ConscienceEngine::computeConsciousness(
     return std::tanh(consciousness);
 }
 
-double ConscienceEngine::computeSentiment(
+template <typename Profile>
+double BasicConscienceEngine<Profile>::computeSentiment(
     double emotional_contrib,
     double memory_contrib,
     double feedback_value) const
@@ -322,35 +424,26 @@ double ConscienceEngine::computeSentiment(
     double raw_sentiment =
         emotional_contrib * 0.5 +      // γ_emotion
         memory_contrib * 0.3 +          // γ_memory
-        config_.lambda_feedback * feedback_value;
+        cfg().lambda_feedback * feedback_value;
 
     return std::tanh(raw_sentiment);
 }
 
-void ConscienceEngine::updateSentimentEMA(double new_sentiment) {
-    // Moyenne mobile exponentielle
-    // EMA_t = α × value_t + (1 - α) × EMA_{t-1}
-
-    sentiment_ema_ = config_.sentiment_smoothing * new_sentiment +
-                     (1.0 - config_.sentiment_smoothing) * sentiment_ema_;
-
-    // Garder aussi un historique pour analyse
+template <typename Profile>
+void BasicConscienceEngine<Profile>::updateSentimentEMA(double new_sentiment) {
+    // Moyenne mobile exponentielle EMA_t = α × value_t + (1 - α) × EMA_{t-1}
+    // et historique borné (5 minutes à 1Hz = 300 samples), tenus par la fenêtre
     sentiment_history_.push_back(new_sentiment);
-
-    // Limiter la taille de l'historique (5 minutes à 1Hz = 300 samples)
-    const size_t max_history = static_cast<size_t>(config_.sentiment_window_seconds);
-    while (sentiment_history_.size() > max_history) {
-        sentiment_history_.pop_front();
-    }
 }
 
-std::string ConscienceEngine::determineDominantState(
+template <typename Profile>
+std::string BasicConscienceEngine<Profile>::determineDominantState(
     double consciousness,
     double sentiment) const
 {
     // Combinaison de conscience et sentiment pour déterminer l'état
 
-    if (consciousness < config_.min_consciousness_threshold) {
+    if (consciousness < cfg().min_consciousness_threshold) {
         return "dormant";  // Conscience trop basse
     }
 
@@ -363,4 +456,11 @@ std::string ConscienceEngine::determineDominantState(
     }
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// INSTANCIATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+template class BasicConscienceEngine<RuntimeProfile<ConscienceConfig>>;
+template class BasicConscienceEngine<ProductionConscienceProfile>;
+
 } // namespace mcee
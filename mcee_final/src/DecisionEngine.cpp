@@ -6,12 +6,14 @@
  */
 
 #include "DecisionEngine.hpp"
+#include "Logger.hpp"
+#include "Executor.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
-#include <iostream>
 #include <iomanip>
 #include <map>
+#include <exception>
 
 namespace mcee {
 
@@ -19,28 +21,30 @@ namespace mcee {
 // CONSTRUCTEUR
 // ═══════════════════════════════════════════════════════════════════════════
 
-DecisionEngine::DecisionEngine(const DecisionConfig& config)
-    : config_(config)
+template <typename Profile>
+BasicDecisionEngine<Profile>::BasicDecisionEngine(Profile profile)
+    : profile_(std::move(profile))
     , rng_(std::random_device{}())
 {
-    std::cout << "[Decision] Moteur initialisé\n";
-    std::cout << "[Decision] τ_max=" << config_.tau_max_ms << "ms, "
-              << "θ_veto=" << config_.theta_veto << ", "
-              << "θ_meta=" << config_.theta_meta << "\n";
+    MCEE_LOG_INFO("Decision", "Moteur initialisé");
+    MCEE_LOG_INFO("Decision",
+        "τ_max=", cfg().tau_max_ms, "ms, ", "θ_veto=", cfg().theta_veto, ", ", "θ_meta=",
+        cfg().theta_meta);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // DÉCISION PRINCIPALE
 // ═══════════════════════════════════════════════════════════════════════════
 
-DecisionResult DecisionEngine::decide(
+template <typename Profile>
+DecisionResult BasicDecisionEngine<Profile>::decide(
     const EmotionalState& emotional_state,
     const ConscienceSentimentState& conscience_state,
     const GoalState& goal_state,
     const std::string& context_type,
     const std::vector<ActionOption>& available_actions)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     auto start_time = std::chrono::steady_clock::now();
 
     total_decisions_++;
@@ -55,8 +59,8 @@ DecisionResult DecisionEngine::decide(
 
     std::vector<AmyghaleonAlert> alerts;
     // Générer alertes à partir de l'état émotionnel
-    if (emotional_state.getEmotion("Peur") > 0.6) {
-        alerts.push_back({"danger", emotional_state.getEmotion("Peur"), "emotion"});
+    if (emotional_state.emotions[EMO_PEUR] > 0.6) {
+        alerts.push_back({"danger", emotional_state.emotions[EMO_PEUR], "emotion"});
     }
     if (emotional_state.getEmotion("Colère") > 0.7) {
         alerts.push_back({"escalation", emotional_state.getEmotion("Colère"), "emotion"});
@@ -66,13 +70,13 @@ DecisionResult DecisionEngine::decide(
         emotional_state, conscience_state, context_type, alerts
     );
 
-    std::cout << "[Decision] Phase 1: Σ(t) construit, U(t)="
-              << std::fixed << std::setprecision(2) << frame.urgency
-              << ", τ_delib=" << frame.tau_delib_ms << "ms\n";
+    MCEE_LOG_DEBUG("Decision",
+        "Phase 1: Σ(t) construit, U(t)=", std::fixed, std::setprecision(2), frame.urgency,
+        ", τ_delib=", frame.tau_delib_ms, "ms");
 
     // Mode réflexe si urgence maximale
     if (frame.isReflexMode()) {
-        std::cout << "[Decision] ⚡ Mode réflexe activé\n";
+        MCEE_LOG_INFO("Decision", "⚡ Mode réflexe activé");
         reflex_decisions_++;
         return decideReflex(frame);
     }
@@ -83,9 +87,18 @@ DecisionResult DecisionEngine::decide(
 
     MemoryContext memory = buildMemoryContext(frame);
 
-    std::cout << "[Decision] Phase 2: M(t) construit, "
-              << memory.episodes.size() << " épisodes, "
-              << memory.procedures.size() << " procédures\n";
+    MCEE_LOG_DEBUG("Decision",
+        "Phase 2: M(t) construit, ", memory.episodes.size(), " épisodes, ",
+        memory.procedures.size(), " procédures");
+
+    // M(t) est une copie : les phases 3-4 ne lisent plus les mémoires
+    // partagées et s'exécutent sans le mutex (réflexes et apprentissage
+    // ne sont pas bloqués par une délibération en cours)
+    lock.unlock();
+
+    // Budget anytime : la simulation n'est plus approfondie après τ_delib
+    auto deadline = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(frame.tau_delib_ms));
 
     // ═══════════════════════════════════════════════════════════════════════
     // PHASE 3 : GÉNÉRATION & SIMULATION → A(t)
@@ -98,12 +111,12 @@ DecisionResult DecisionEngine::decide(
         options = available_actions;
     }
 
-    // Projeter chaque option
-    for (auto& option : options) {
-        option.projection = projectAction(option, frame, memory, goal_state);
-    }
+    // Projeter chaque option (projections indépendantes, réparties sur les tâches)
+    forEachOption(options, [&](ActionOption& option) {
+        option.projection = projectAction(option, frame, memory, goal_state, deadline);
+    });
 
-    std::cout << "[Decision] Phase 3: " << options.size() << " options générées\n";
+    MCEE_LOG_DEBUG("Decision", "Phase 3: ", options.size(), " options générées");
 
     // ═══════════════════════════════════════════════════════════════════════
     // PHASE 4 : ARBITRAGE & SÉLECTION → D(t), κ(t)
@@ -112,21 +125,20 @@ DecisionResult DecisionEngine::decide(
     // 4.1 Veto Amyghaleon
     size_t vetoed = applyVeto(options, frame.alerts);
     if (vetoed > 0) {
-        std::cout << "[Decision] " << vetoed << " options retirées par veto\n";
+        MCEE_LOG_DEBUG("Decision", vetoed, " options retirées par veto");
     }
 
     // 4.2 Scorer les options restantes
-    for (auto& option : options) {
+    forEachOption(options, [&](ActionOption& option) {
         if (!option.vetoed) {
             option.score = computeScore(option, frame.Ft);
         }
-    }
+    });
 
     // 4.3 Détecter conflits
     auto conflicts = detectConflicts(options, goal_state);
     for (const auto& conflict : conflicts) {
-        std::cout << "[Decision] Conflit: " << conflict.goal1_name
-                  << " vs " << conflict.goal2_name << "\n";
+        MCEE_LOG_INFO("Decision", "Conflit: ", conflict.goal1_name, " vs ", conflict.goal2_name);
         if (on_conflict_) {
             on_conflict_(conflict);
         }
@@ -160,22 +172,86 @@ DecisionResult DecisionEngine::decide(
         end_time - start_time
     ).count();
 
-    std::cout << "[Decision] Phase 4: D(t)=" << result.action_name
-              << ", κ=" << std::fixed << std::setprecision(2) << result.confidence
-              << ", temps=" << result.deliberation_time_ms << "ms\n";
+    MCEE_LOG_DEBUG("Decision",
+        "Phase 4: D(t)=", result.action_name, ", κ=", std::fixed, std::setprecision(2),
+        result.confidence, ", temps=", result.deliberation_time_ms, "ms");
+
+    // Historique
+    lock.lock();
+    updateHistory(result);
+    lock.unlock();
 
     // Callback
     if (on_decision_) {
         on_decision_(result);
     }
 
-    // Historique
-    updateHistory(result);
-
     return result;
 }
 
-DecisionResult DecisionEngine::decideReflex(const SituationFrame& frame) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::forEachOption(
+    std::vector<ActionOption>& options,
+    const std::function<void(ActionOption&)>& fn) const
+{
+    size_t tasks = std::min(cfg().projection_threads, options.size());
+    if (tasks <= 1 || options.size() < cfg().parallel_min_options) {
+        for (auto& option : options) {
+            fn(option);
+        }
+        return;
+    }
+
+    // Tranches contiguës sur l'Executor partagé ; la tranche 0 est traitée
+    // par le thread appelant
+    auto executor = Executor::shared();
+    size_t chunk = (options.size() + tasks - 1) / tasks;
+    std::vector<TaskFuture<void>> futures;
+    futures.reserve(tasks - 1);
+    for (size_t begin = chunk; begin < options.size(); begin += chunk) {
+        size_t end = std::min(options.size(), begin + chunk);
+        futures.push_back(executor->submit(TaskClass::PIPELINE, [&options, &fn, begin, end]() {
+            for (size_t i = begin; i < end; ++i) {
+                fn(options[i]);
+            }
+        }));
+    }
+
+    std::exception_ptr error;
+    try {
+        for (size_t i = 0; i < std::min(chunk, options.size()); ++i) {
+            fn(options[i]);
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Les tranches référencent options et fn : toutes attendues avant de
+    // propager une erreur. Une tranche rejetée (file pleine) est traitée ici.
+    for (size_t t = 0; t < futures.size(); ++t) {
+        try {
+            futures[t].get();
+        } catch (const TaskRejected&) {
+            size_t begin = (t + 1) * chunk;
+            size_t end = std::min(options.size(), begin + chunk);
+            try {
+                for (size_t i = begin; i < end; ++i) {
+                    fn(options[i]);
+                }
+            } catch (...) {
+                if (!error) error = std::current_exception();
+            }
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+template <typename Profile>
+DecisionResult BasicDecisionEngine<Profile>::decideReflex(const SituationFrame& frame) {
     DecisionResult result;
     result.reflex_mode = true;
     result.confidence = 0.9;  // Haute confiance pour les réflexes
@@ -187,12 +263,12 @@ DecisionResult DecisionEngine::decideReflex(const SituationFrame& frame) {
     if (best_reflex) {
         result.action_id = best_reflex->id;
         result.action_name = best_reflex->name;
-        std::cout << "[Decision] Réflexe: " << result.action_name << "\n";
+        MCEE_LOG_INFO("Decision", "Réflexe: ", result.action_name);
     } else {
         // Réflexe par défaut : protection
         result.action_id = "reflex_protect";
         result.action_name = "Protection/Retrait";
-        std::cout << "[Decision] Réflexe par défaut: Protection\n";
+        MCEE_LOG_INFO("Decision", "Réflexe par défaut: Protection");
     }
 
     if (on_decision_) {
@@ -207,7 +283,8 @@ DecisionResult DecisionEngine::decideReflex(const SituationFrame& frame) {
 // PHASE 1 : PERCEPTION
 // ═══════════════════════════════════════════════════════════════════════════
 
-SituationFrame DecisionEngine::buildSituationFrame(
+template <typename Profile>
+SituationFrame BasicDecisionEngine<Profile>::buildSituationFrame(
     const EmotionalState& emotional_state,
     const ConscienceSentimentState& conscience_state,
     const std::string& context_type,
@@ -220,22 +297,23 @@ SituationFrame DecisionEngine::buildSituationFrame(
     frame.context_type = context_type;
     frame.alerts = alerts;
     frame.urgency = computeUrgency(emotional_state, alerts);
-    frame.computeDeliberationTime(config_.tau_max_ms);
+    frame.computeDeliberationTime(cfg().tau_max_ms);
     frame.timestamp = std::chrono::steady_clock::now();
 
     return frame;
 }
 
-double DecisionEngine::computeUrgency(
+template <typename Profile>
+double BasicDecisionEngine<Profile>::computeUrgency(
     const EmotionalState& emotional_state,
     const std::vector<AmyghaleonAlert>& alerts)
 {
     double urgency = 0.0;
 
     // Contribution des émotions critiques
-    urgency += emotional_state.getEmotion("Peur") * 0.4;
+    urgency += emotional_state.emotions[EMO_PEUR] * 0.4;
     urgency += emotional_state.getEmotion("Colère") * 0.2;
-    urgency += emotional_state.getEmotion("Anxiété") * 0.2;
+    urgency += emotional_state.emotions[EMO_ANXIETE] * 0.2;
 
     // Contribution des alertes
     for (const auto& alert : alerts) {
@@ -249,30 +327,34 @@ double DecisionEngine::computeUrgency(
 // PHASE 2 : ACTIVATION MÉMORIELLE
 // ═══════════════════════════════════════════════════════════════════════════
 
-MemoryContext DecisionEngine::buildMemoryContext(const SituationFrame& frame) {
+template <typename Profile>
+MemoryContext BasicDecisionEngine<Profile>::buildMemoryContext(const SituationFrame& frame) {
     MemoryContext context;
 
-    // Récupérer les épisodes similaires (top-5)
-    std::vector<std::pair<double, const MemoryEpisode*>> scored_episodes;
-    for (const auto& episode : episodes_) {
-        double sim = computeEpisodeSimilarity(episode, frame);
-        scored_episodes.push_back({sim, &episode});
-    }
-    std::sort(scored_episodes.begin(), scored_episodes.end(),
-              [](const auto& a, const auto& b) { return a.first > b.first; });
-
-    size_t count = std::min(size_t(5), scored_episodes.size());
-    for (size_t i = 0; i < count; ++i) {
-        MemoryEpisode ep = *scored_episodes[i].second;
-        ep.similarity = scored_episodes[i].first;
-        context.episodes.push_back(ep);
+    // Récupérer les épisodes similaires (top-k de l'index, Éq. 2)
+    episode_index_.topK(frame, cfg(), cfg().episode_top_k,
+                        std::chrono::steady_clock::now(), recall_buffer_);
+    for (const auto& [sim, row] : recall_buffer_) {
+        MemoryEpisode ep = episodes_[row];
+        ep.similarity = sim;
+        context.episodes.push_back(std::move(ep));
     }
 
-    // Récupérer les procédures applicables
-    for (const auto& proc : procedures_) {
-        if (proc.trigger_context == frame.context_type || proc.trigger_context == "*") {
-            context.procedures.push_back(proc);
-        }
+    // Récupérer les procédures applicables (contexte exact + génériques "*"),
+    // dans leur ordre d'enregistrement
+    static const std::vector<size_t> no_procedures;
+    auto lookup = [this](const std::string& key) -> const std::vector<size_t>& {
+        auto it = procedures_by_context_.find(key);
+        return it != procedures_by_context_.end() ? it->second : no_procedures;
+    };
+    const auto& exact = lookup(frame.context_type);
+    const auto& generic = frame.context_type == "*" ? no_procedures : lookup("*");
+    std::vector<size_t> applicable;
+    applicable.reserve(exact.size() + generic.size());
+    std::merge(exact.begin(), exact.end(), generic.begin(), generic.end(),
+               std::back_inserter(applicable));
+    for (size_t idx : applicable) {
+        context.procedures.push_back(procedures_[idx]);
     }
 
     // Récupérer les concepts pertinents
@@ -289,26 +371,95 @@ MemoryContext DecisionEngine::buildMemoryContext(const SituationFrame& frame) {
     return context;
 }
 
-void DecisionEngine::addEpisode(const MemoryEpisode& episode) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::addEpisode(const MemoryEpisode& episode) {
     std::lock_guard<std::mutex> lock(mutex_);
-    episodes_.push_back(episode);
+    storeEpisode(episode);
 }
 
-void DecisionEngine::addProcedure(const MemoryProcedure& procedure) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::addProcedure(const MemoryProcedure& procedure) {
     std::lock_guard<std::mutex> lock(mutex_);
-    procedures_.push_back(procedure);
+    storeProcedure(procedure);
 }
 
-void DecisionEngine::addConcept(const SemanticConcept& semantic_concept) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::addConcept(const SemanticConcept& semantic_concept) {
     std::lock_guard<std::mutex> lock(mutex_);
     concepts_.push_back(semantic_concept);
 }
 
+template <typename Profile>
+void BasicDecisionEngine<Profile>::storeEpisode(const MemoryEpisode& episode) {
+    size_t row = episodes_.size();
+    episodes_.push_back(episode);
+    episode_index_.add(row, episode);
+    episodes_by_action_[episode.action_taken].push_back(row);
+    ++next_episode_seq_;
+    enforceEpisodeCapacity();
+}
+
+template <typename Profile>
+void BasicDecisionEngine<Profile>::storeProcedure(const MemoryProcedure& procedure) {
+    size_t idx = procedures_.size();
+    procedures_.push_back(procedure);
+    procedures_by_context_[procedure.trigger_context].push_back(idx);
+    procedure_by_key_.emplace(procedure.id, idx);
+    procedure_by_key_.emplace(procedure.name, idx);
+}
+
+template <typename Profile>
+void BasicDecisionEngine<Profile>::enforceEpisodeCapacity() {
+    const size_t capacity = cfg().max_episodes;
+    if (capacity == 0 || episodes_.size() <= capacity) {
+        return;
+    }
+
+    // Éviction par lot (1/8 de la capacité en plus) : la réindexation
+    // complète reste amortie sur de nombreux ajouts
+    size_t evict = std::min(episodes_.size(), episodes_.size() - capacity + capacity / 8);
+
+    std::vector<size_t> order(episodes_.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::nth_element(order.begin(), order.begin() + (evict - 1), order.end(),
+                     [this](size_t a, size_t b) {
+                         if (episodes_[a].timestamp != episodes_[b].timestamp) {
+                             return episodes_[a].timestamp < episodes_[b].timestamp;
+                         }
+                         return a < b;
+                     });
+
+    std::vector<uint8_t> evicted(episodes_.size(), 0);
+    for (size_t i = 0; i < evict; ++i) {
+        evicted[order[i]] = 1;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < episodes_.size(); ++i) {
+        if (!evicted[i]) {
+            if (kept != i) {
+                episodes_[kept] = std::move(episodes_[i]);
+            }
+            ++kept;
+        }
+    }
+    episodes_.resize(kept);
+
+    episode_index_.rebuild(episodes_);
+    episodes_by_action_.clear();
+    for (size_t row = 0; row < episodes_.size(); ++row) {
+        episodes_by_action_[episodes_[row].action_taken].push_back(row);
+    }
+
+    MCEE_LOG_INFO("Decision", "ME: ", evict, " épisodes anciens évincés (capacité ", capacity, ")");
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // PHASE 3 : GÉNÉRATION & SIMULATION (Two-Pass)
 // ═══════════════════════════════════════════════════════════════════════════
 
-std::vector<ActionOption> DecisionEngine::generateOptions(
+template <typename Profile>
+std::vector<ActionOption> BasicDecisionEngine<Profile>::generateOptions(
     const SituationFrame& frame,
     const MemoryContext& memory,
     const GoalState& goals)
@@ -324,23 +475,21 @@ std::vector<ActionOption> DecisionEngine::generateOptions(
     // ─────────────────────────────────────────────────────────────────────────
     std::vector<std::string> macro_options = generateMacroOptions(frame, memory);
 
-    std::cout << "[Decision] Passe 1: " << macro_options.size()
-              << " macro-options générées\n";
+    MCEE_LOG_DEBUG("Decision", "Passe 1: ", macro_options.size(), " macro-options générées");
 
     // ─────────────────────────────────────────────────────────────────────────
     // Passe 2 : Raffiner les top-k macro-options
     // ─────────────────────────────────────────────────────────────────────────
     std::vector<ActionOption> options = refineMacroOptions(
-        macro_options, frame, goals, config_.top_k_refinement
+        macro_options, frame, goals, cfg().top_k_refinement
     );
 
-    std::cout << "[Decision] Passe 2: " << options.size()
-              << " options raffinées\n";
+    MCEE_LOG_DEBUG("Decision", "Passe 2: ", options.size(), " options raffinées");
 
     // ─────────────────────────────────────────────────────────────────────────
     // Ajouter méta-actions si activées
     // ─────────────────────────────────────────────────────────────────────────
-    if (config_.enable_meta_actions) {
+    if (cfg().enable_meta_actions) {
         ActionOption info_request;
         info_request.id = "meta_info_request";
         info_request.name = "Demander plus d'informations";
@@ -367,7 +516,8 @@ std::vector<ActionOption> DecisionEngine::generateOptions(
     return options;
 }
 
-std::vector<std::string> DecisionEngine::generateMacroOptions(
+template <typename Profile>
+std::vector<std::string> BasicDecisionEngine<Profile>::generateMacroOptions(
     const SituationFrame& frame,
     const MemoryContext& memory)
 {
@@ -405,21 +555,22 @@ std::vector<std::string> DecisionEngine::generateMacroOptions(
                     break;
                 }
             }
-            if (!already_present && macros.size() < config_.max_macro_options) {
+            if (!already_present && macros.size() < cfg().max_macro_options) {
                 macros.push_back(proc.name);
             }
         }
     }
 
     // Limiter au max configuré
-    if (macros.size() > config_.max_macro_options) {
-        macros.resize(config_.max_macro_options);
+    if (macros.size() > cfg().max_macro_options) {
+        macros.resize(cfg().max_macro_options);
     }
 
     return macros;
 }
 
-std::vector<ActionOption> DecisionEngine::refineMacroOptions(
+template <typename Profile>
+std::vector<ActionOption> BasicDecisionEngine<Profile>::refineMacroOptions(
     const std::vector<std::string>& macro_options,
     const SituationFrame& frame,
     const GoalState& goals,
@@ -531,11 +682,13 @@ std::vector<ActionOption> DecisionEngine::refineMacroOptions(
     return refined;
 }
 
-ActionProjection DecisionEngine::projectAction(
+template <typename Profile>
+ActionProjection BasicDecisionEngine<Profile>::projectAction(
     const ActionOption& action,
     const SituationFrame& frame,
     const MemoryContext& memory,
-    const GoalState& goals)
+    const GoalState& goals,
+    std::chrono::steady_clock::time_point deadline)
 {
     ActionProjection proj;
 
@@ -551,7 +704,7 @@ ActionProjection DecisionEngine::projectAction(
     }
 
     // Profondeur de simulation
-    proj.simulation_depth = computeSimulationDepth(proj.uncertainty);
+    proj.simulation_depth = computeSimulationDepth(proj.uncertainty, deadline);
 
     // Prédiction émotionnelle
     // Positive si action constructive, négative si risquée
@@ -578,7 +731,8 @@ ActionProjection DecisionEngine::projectAction(
     return proj;
 }
 
-ActionOption DecisionEngine::createInfoRequest(
+template <typename Profile>
+ActionOption BasicDecisionEngine<Profile>::createInfoRequest(
     const std::string& target,
     const std::string& question_type)
 {
@@ -601,7 +755,8 @@ ActionOption DecisionEngine::createInfoRequest(
 // PHASE 4 : ARBITRAGE & SÉLECTION
 // ═══════════════════════════════════════════════════════════════════════════
 
-size_t DecisionEngine::applyVeto(
+template <typename Profile>
+size_t BasicDecisionEngine<Profile>::applyVeto(
     std::vector<ActionOption>& options,
     const std::vector<AmyghaleonAlert>& alerts)
 {
@@ -620,7 +775,7 @@ size_t DecisionEngine::applyVeto(
             }
         }
 
-        if (risk > config_.theta_veto) {
+        if (risk > cfg().theta_veto) {
             option.vetoed = true;
             option.veto_reason = "Risque " + std::to_string(risk) + " > θ_veto";
             vetoed_count++;
@@ -635,12 +790,13 @@ size_t DecisionEngine::applyVeto(
     return vetoed_count;
 }
 
-double DecisionEngine::computeScore(const ActionOption& option, double Ft) {
-    double w1 = config_.w1_goal_align;
-    double w2 = config_.w2_emo_forecast;
-    double w3 = config_.w3_confidence;
-    double w4 = config_.w4_uncertainty;
-    double w5 = config_.w5_risk;
+template <typename Profile>
+double BasicDecisionEngine<Profile>::computeScore(const ActionOption& option, double Ft) {
+    double w1 = cfg().w1_goal_align;
+    double w2 = cfg().w2_emo_forecast;
+    double w3 = cfg().w3_confidence;
+    double w4 = cfg().w4_uncertainty;
+    double w5 = cfg().w5_risk;
 
     // Moduler selon Ft
     modulateWeights(Ft, w1, w2, w3, w4, w5);
@@ -658,7 +814,8 @@ double DecisionEngine::computeScore(const ActionOption& option, double Ft) {
     return score;
 }
 
-std::vector<GoalConflict> DecisionEngine::detectConflicts(
+template <typename Profile>
+std::vector<GoalConflict> BasicDecisionEngine<Profile>::detectConflicts(
     const std::vector<ActionOption>& options,
     const GoalState& goals)
 {
@@ -679,7 +836,8 @@ std::vector<GoalConflict> DecisionEngine::detectConflicts(
     return conflicts;
 }
 
-MetaState DecisionEngine::buildMetaState(
+template <typename Profile>
+MetaState BasicDecisionEngine<Profile>::buildMetaState(
     const std::vector<ActionOption>& options,
     double winning_score,
     double second_score)
@@ -701,13 +859,14 @@ MetaState DecisionEngine::buildMetaState(
     state.uncertainty_global = count > 0 ? total_uncertainty / count : 0.0;
 
     // "Je sais que je ne sais pas"
-    state.know_unknown = state.uncertainty_global > config_.theta_meta;
+    state.know_unknown = state.uncertainty_global > cfg().theta_meta;
 
     state.timestamp = std::chrono::steady_clock::now();
     return state;
 }
 
-DecisionResult DecisionEngine::selectBestAction(
+template <typename Profile>
+DecisionResult BasicDecisionEngine<Profile>::selectBestAction(
     std::vector<ActionOption>& options,
     const MetaState& meta_state,
     const SituationFrame& frame)
@@ -739,16 +898,16 @@ DecisionResult DecisionEngine::selectBestAction(
     ActionOption* best = valid_options[0];
 
     // Vérifier si méta-action nécessaire
-    if (config_.enable_meta_actions &&
-        meta_state.uncertainty_global > config_.theta_info &&
-        meta_state.confidence < config_.theta_confidence) {
+    if (cfg().enable_meta_actions &&
+        meta_state.uncertainty_global > cfg().theta_info &&
+        meta_state.confidence < cfg().theta_confidence) {
 
         // Chercher une méta-action dans les options
         for (auto* opt : valid_options) {
             if (opt->isMetaAction()) {
                 best = opt;
                 meta_action_decisions_++;
-                std::cout << "[Decision] Méta-action déclenchée: " << opt->name << "\n";
+                MCEE_LOG_INFO("Decision", "Méta-action déclenchée: ", opt->name);
 
                 if (on_meta_action_) {
                     on_meta_action_(opt->meta_type, opt->meta_target);
@@ -772,7 +931,8 @@ DecisionResult DecisionEngine::selectBestAction(
 // APPRENTISSAGE POST-DÉCISION (Table 3 du PDF)
 // ═══════════════════════════════════════════════════════════════════════════
 
-void DecisionEngine::recordOutcome(const DecisionOutcome& outcome) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::recordOutcome(const DecisionOutcome& outcome) {
     std::lock_guard<std::mutex> lock(mutex_);
 
     double prediction_error = outcome.actual_outcome - outcome.expected_outcome;
@@ -796,7 +956,7 @@ void DecisionEngine::recordOutcome(const DecisionOutcome& outcome) {
     // 4. Mise à jour ME : Création d'épisode enrichi
     // ─────────────────────────────────────────────────────────────────────────
     MemoryEpisode episode;
-    episode.id = "ep_" + std::to_string(episodes_.size());
+    episode.id = "ep_" + std::to_string(next_episode_seq_);
     episode.description = "Décision: " + outcome.decision_id;
     episode.outcome_valence = outcome.actual_outcome;
     episode.action_taken = outcome.decision_id;
@@ -811,14 +971,15 @@ void DecisionEngine::recordOutcome(const DecisionOutcome& outcome) {
         episode.failure_count = 1;
     }
 
-    episodes_.push_back(episode);
+    storeEpisode(episode);
 
-    std::cout << "[Decision] Apprentissage post-décision: " << outcome.decision_id
-              << " (success=" << outcome.success
-              << ", δ=" << std::fixed << std::setprecision(2) << prediction_error << ")\n";
+    MCEE_LOG_INFO("Decision",
+        "Apprentissage post-décision: ", outcome.decision_id, " (success=", outcome.success,
+        ", δ=", std::fixed, std::setprecision(2), prediction_error, ")");
 }
 
-void DecisionEngine::updateMLTPatterns(
+template <typename Profile>
+void BasicDecisionEngine<Profile>::updateMLTPatterns(
     const DecisionOutcome& outcome,
     double prediction_error)
 {
@@ -831,10 +992,12 @@ void DecisionEngine::updateMLTPatterns(
 
     // Chercher si pattern existe déjà
     bool found = false;
-    for (auto& ep : episodes_) {
-        if (ep.action_taken == outcome.decision_id) {
+    auto by_action = episodes_by_action_.find(outcome.decision_id);
+    if (by_action != episodes_by_action_.end()) {
+        for (size_t row : by_action->second) {
+            auto& ep = episodes_[row];
             // Renforcer le pattern existant
-            double lr = config_.learning_rate_mlt;
+            double lr = cfg().learning_rate_mlt;
             if (outcome.success) {
                 ep.success_count++;
                 ep.outcome_valence = ep.outcome_valence * (1.0 - lr) +
@@ -849,42 +1012,41 @@ void DecisionEngine::updateMLTPatterns(
     }
 
     if (!found) {
-        std::cout << "[Decision] MLT: Nouveau pattern créé pour '"
-                  << outcome.decision_id << "'\n";
+        MCEE_LOG_INFO("Decision", "MLT: Nouveau pattern créé pour '", outcome.decision_id, "'");
     }
 }
 
-void DecisionEngine::updateMPProcedures(const DecisionOutcome& outcome) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::updateMPProcedures(const DecisionOutcome& outcome) {
     // Table 3 - MP : Mise à jour des procédures + promotion en réflexe
 
-    for (auto& proc : procedures_) {
-        if (proc.name == outcome.decision_id || proc.id == outcome.decision_id) {
-            proc.activation_count++;
-
-            // Mise à jour du taux de succès avec lissage
-            double lr = config_.learning_rate_mp;
-            if (outcome.success) {
-                proc.success_rate = proc.success_rate * (1.0 - lr) + 1.0 * lr;
-
-                // Vérifier promotion en réflexe
-                // Condition : θ_automate succès consécutifs ET taux > 80%
-                if (proc.activation_count >= static_cast<size_t>(config_.theta_automate) &&
-                    proc.success_rate > 0.80 &&
-                    !proc.is_reflex) {
-                    promoteToReflex(proc.id);
-                }
-            } else {
-                proc.success_rate = proc.success_rate * (1.0 - lr);
+    auto by_key = procedure_by_key_.find(outcome.decision_id);
+    if (by_key != procedure_by_key_.end()) {
+        auto& proc = procedures_[by_key->second];
+        proc.activation_count++;
+
+        // Mise à jour du taux de succès avec lissage
+        double lr = cfg().learning_rate_mp;
+        if (outcome.success) {
+            proc.success_rate = proc.success_rate * (1.0 - lr) + 1.0 * lr;
+
+            // Vérifier promotion en réflexe
+            // Condition : θ_automate succès consécutifs ET taux > 80%
+            if (proc.activation_count >= static_cast<size_t>(cfg().theta_automate) &&
+                proc.success_rate > 0.80 &&
+                !proc.is_reflex) {
+                promoteToReflex(proc.id);
+            }
+        } else {
+            proc.success_rate = proc.success_rate * (1.0 - lr);
 
-                // Rétrograder si taux chute trop
-                if (proc.is_reflex && proc.success_rate < 0.50) {
-                    proc.is_reflex = false;
-                    std::cout << "[Decision] MP: Procédure rétrogradée de réflexe: "
-                              << proc.name << "\n";
-                }
+            // Rétrograder si taux chute trop
+            if (proc.is_reflex && proc.success_rate < 0.50) {
+                proc.is_reflex = false;
+                MCEE_LOG_INFO("Decision", "MP: Procédure rétrogradée de réflexe: ", proc.name);
             }
-            return;
         }
+        return;
     }
 
     // Créer nouvelle procédure si inexistante
@@ -895,13 +1057,13 @@ void DecisionEngine::updateMPProcedures(const DecisionOutcome& outcome) {
     new_proc.success_rate = outcome.success ? 1.0 : 0.0;
     new_proc.activation_count = 1;
     new_proc.is_reflex = false;
-    procedures_.push_back(new_proc);
+    storeProcedure(new_proc);
 
-    std::cout << "[Decision] MP: Nouvelle procédure créée pour '"
-              << outcome.decision_id << "'\n";
+    MCEE_LOG_INFO("Decision", "MP: Nouvelle procédure créée pour '", outcome.decision_id, "'");
 }
 
-void DecisionEngine::updateMAIdentity(const DecisionOutcome& outcome) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::updateMAIdentity(const DecisionOutcome& outcome) {
     // Table 3 - MA : Consolidation des valeurs identitaires
     // Impact sur la mémoire autobiographique si décision significative
 
@@ -909,7 +1071,7 @@ void DecisionEngine::updateMAIdentity(const DecisionOutcome& outcome) {
         return;  // Pas d'impact identitaire signalé
     }
 
-    double lr = config_.learning_rate_ma;
+    double lr = cfg().learning_rate_ma;
 
     // Traiter l'impact sur les valeurs
     // Format attendu : "valeur:+/-delta" (ex: "intégrité:+0.1")
@@ -926,12 +1088,12 @@ void DecisionEngine::updateMAIdentity(const DecisionOutcome& outcome) {
             // Renforcer ou affaiblir la valeur correspondante
             if (outcome.success) {
                 // Succès → consolider la valeur
-                std::cout << "[Decision] MA: Consolidation valeur '"
-                          << value_name << "' +" << (lr * std::abs(delta)) << "\n";
+                MCEE_LOG_INFO("Decision",
+                    "MA: Consolidation valeur '", value_name, "' +", (lr * std::abs(delta)));
             } else {
                 // Échec → remettre en question
-                std::cout << "[Decision] MA: Remise en question valeur '"
-                          << value_name << "' -" << (lr * std::abs(delta)) << "\n";
+                MCEE_LOG_INFO("Decision",
+                    "MA: Remise en question valeur '", value_name, "' -", (lr * std::abs(delta)));
             }
         } catch (...) {
             // Format invalide, ignorer
@@ -939,7 +1101,8 @@ void DecisionEngine::updateMAIdentity(const DecisionOutcome& outcome) {
     }
 }
 
-std::string DecisionEngine::generateLesson(
+template <typename Profile>
+std::string BasicDecisionEngine<Profile>::generateLesson(
     const DecisionOutcome& outcome,
     double prediction_error) const
 {
@@ -1019,11 +1182,12 @@ std::string DecisionEngine::generateLesson(
     return lesson;
 }
 
-void DecisionEngine::promoteToReflex(const std::string& procedure_id) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::promoteToReflex(const std::string& procedure_id) {
     for (auto& proc : procedures_) {
         if (proc.id == procedure_id) {
             proc.is_reflex = true;
-            std::cout << "[Decision] Procédure promue en réflexe: " << proc.name << "\n";
+            MCEE_LOG_INFO("Decision", "Procédure promue en réflexe: ", proc.name);
             break;
         }
     }
@@ -1033,44 +1197,53 @@ void DecisionEngine::promoteToReflex(const std::string& procedure_id) {
 // CONFIGURATION & ACCESSEURS
 // ═══════════════════════════════════════════════════════════════════════════
 
-void DecisionEngine::setVetoThreshold(double theta) {
-    config_.theta_veto = std::clamp(theta, 0.0, 1.0);
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setVetoThreshold(double theta) requires (!Profile::is_static) {
+    profile_.mutableConfig().theta_veto = std::clamp(theta, 0.0, 1.0);
 }
 
-void DecisionEngine::enableMetaActions(bool enable) {
-    config_.enable_meta_actions = enable;
+template <typename Profile>
+void BasicDecisionEngine<Profile>::enableMetaActions(bool enable) requires (!Profile::is_static) {
+    profile_.mutableConfig().enable_meta_actions = enable;
 }
 
-const std::deque<DecisionResult>& DecisionEngine::getDecisionHistory() const {
+template <typename Profile>
+const RingBuffer<DecisionResult>& BasicDecisionEngine<Profile>::getDecisionHistory() const {
     return decision_history_;
 }
 
-void DecisionEngine::setDecisionCallback(DecisionCallback callback) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setDecisionCallback(DecisionCallback callback) {
     on_decision_ = std::move(callback);
 }
 
-void DecisionEngine::setVetoCallback(VetoCallback callback) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setVetoCallback(VetoCallback callback) {
     on_veto_ = std::move(callback);
 }
 
-void DecisionEngine::setMetaActionCallback(MetaActionCallback callback) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setMetaActionCallback(MetaActionCallback callback) {
     on_meta_action_ = std::move(callback);
 }
 
-void DecisionEngine::setConflictCallback(ConflictCallback callback) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setConflictCallback(ConflictCallback callback) {
     on_conflict_ = std::move(callback);
 }
 
-void DecisionEngine::setMCTGraph(std::shared_ptr<MCTGraph> mct_graph) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::setMCTGraph(std::shared_ptr<MCTGraph> mct_graph) {
     mct_graph_ = std::move(mct_graph);
-    std::cout << "[Decision] MCTGraph connecté pour enrichissement mémoriel\n";
+    MCEE_LOG_INFO("Decision", "MCTGraph connecté pour enrichissement mémoriel");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // ENRICHISSEMENT MCTGraph → MemoryContext
 // ═══════════════════════════════════════════════════════════════════════════
 
-void DecisionEngine::enrichWithMCTGraph(MemoryContext& context, const SituationFrame& frame) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::enrichWithMCTGraph(MemoryContext& context, const SituationFrame& frame) {
     if (!mct_graph_) {
         return;  // Pas de MCTGraph connecté
     }
@@ -1078,7 +1251,10 @@ void DecisionEngine::enrichWithMCTGraph(MemoryContext& context, const SituationF
     // ─────────────────────────────────────────────────────────────────────────
     // 1. Récupérer les associations causales récentes (mots → émotions)
     // ─────────────────────────────────────────────────────────────────────────
-    auto causal_analyses = mct_graph_->analyzeCausality();
+    // Seules les associations de force > MIN_TRIGGER_STRENGTH sont exploitées :
+    // le graphe arrête son parcours en deçà
+    constexpr double MIN_TRIGGER_STRENGTH = 0.3;
+    auto causal_analyses = mct_graph_->analyzeCausality(SIZE_MAX, MIN_TRIGGER_STRENGTH);
 
     for (const auto& analysis : causal_analyses) {
         // Créer un pattern MLT à partir des associations MCTGraph
@@ -1111,7 +1287,7 @@ void DecisionEngine::enrichWithMCTGraph(MemoryContext& context, const SituationF
     if (max_intensity > 0.4) {
         // Parcourir les analyses causales pour trouver les mots liés
         for (const auto& analysis : causal_analyses) {
-            if (analysis.causal_strength > 0.3) {
+            if (analysis.causal_strength > MIN_TRIGGER_STRENGTH) {
                 // Créer un concept sémantique à partir du mot déclencheur
                 SemanticConcept trigger_concept;
                 trigger_concept.name = "trigger:" + analysis.word_lemma;
@@ -1139,16 +1315,17 @@ void DecisionEngine::enrichWithMCTGraph(MemoryContext& context, const SituationF
         context.patterns.push_back(graph_pattern);
     }
 
-    std::cout << "[Decision] MCTGraph: " << causal_analyses.size()
-              << " associations causales, " << context.patterns.size()
-              << " patterns ajoutés\n";
+    MCEE_LOG_DEBUG("Decision",
+        "MCTGraph: ", causal_analyses.size(), " associations causales, ", context.patterns.size(),
+        " patterns ajoutés");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // MÉTHODES PRIVÉES
 // ═══════════════════════════════════════════════════════════════════════════
 
-double DecisionEngine::computeEpisodeSimilarity(
+template <typename Profile>
+double BasicDecisionEngine<Profile>::computeEpisodeSimilarity(
     const MemoryEpisode& episode,
     const SituationFrame& frame) const
 {
@@ -1161,18 +1338,7 @@ double DecisionEngine::computeEpisodeSimilarity(
     // sim_ctx : Similarité contextuelle
     // Compare le type de contexte et les caractéristiques
     // ─────────────────────────────────────────────────────────────────────────
-    double sim_ctx = 0.0;
-    if (episode.context_type == frame.context_type) {
-        sim_ctx = 1.0;  // Contexte identique
-    } else if ((episode.context_type == "reunion" && frame.context_type == "professionnel") ||
-               (episode.context_type == "professionnel" && frame.context_type == "reunion")) {
-        sim_ctx = 0.7;  // Contextes proches
-    } else if ((episode.context_type == "projet" && frame.context_type == "strategique") ||
-               (episode.context_type == "strategique" && frame.context_type == "projet")) {
-        sim_ctx = 0.6;  // Contextes liés
-    } else {
-        sim_ctx = 0.2;  // Contextes différents
-    }
+    double sim_ctx = EpisodeIndex::contextSimilarity(episode.context_type, frame.context_type);
 
     // ─────────────────────────────────────────────────────────────────────────
     // sim_emo : Similarité émotionnelle
@@ -1213,14 +1379,18 @@ double DecisionEngine::computeEpisodeSimilarity(
     // ─────────────────────────────────────────────────────────────────────────
     // Combinaison pondérée
     // ─────────────────────────────────────────────────────────────────────────
-    double similarity = config_.alpha_ctx * sim_ctx +
-                       config_.beta_emo * sim_emo +
-                       config_.gamma_temp * sim_temp;
+    double similarity = cfg().alpha_ctx * sim_ctx +
+                       cfg().beta_emo * sim_emo +
+                       cfg().gamma_temp * sim_temp;
 
     return std::clamp(similarity, 0.0, 1.0);
 }
 
-size_t DecisionEngine::computeSimulationDepth(double uncertainty) const {
+template <typename Profile>
+size_t BasicDecisionEngine<Profile>::computeSimulationDepth(
+    double uncertainty,
+    std::chrono::steady_clock::time_point deadline) const
+{
     // ═══════════════════════════════════════════════════════════════════════
     // Équation 3 du PDF :
     // depth = 1 + ⌊κ_threshold / uncertainty(a_i)⌋
@@ -1233,24 +1403,33 @@ size_t DecisionEngine::computeSimulationDepth(double uncertainty) const {
 
     // Calcul selon équation 3
     size_t depth = 1 + static_cast<size_t>(std::floor(
-        config_.kappa_threshold / uncertainty
+        cfg().kappa_threshold / uncertainty
     ));
 
     // Borner à la profondeur max configurée
-    return std::min(depth, config_.max_simulation_depth);
+    depth = std::min(depth, cfg().max_simulation_depth);
+
+    // Approfondissement anytime : chaque niveau au-delà du premier n'est
+    // accordé que tant que le budget de délibération n'est pas épuisé
+    size_t granted = std::min<size_t>(depth, 1);
+    while (granted < depth && std::chrono::steady_clock::now() < deadline) {
+        ++granted;
+    }
+    return granted;
 }
 
-void DecisionEngine::modulateWeights(
+template <typename Profile>
+void BasicDecisionEngine<Profile>::modulateWeights(
     double Ft,
     double& w1, double& w2, double& w3, double& w4, double& w5) const
 {
     if (Ft > 0) {
         // Fond affectif positif : favorise exploration
-        w4 -= config_.Ft_positive_exploration_boost * Ft;
-        w3 += config_.Ft_positive_exploration_boost * Ft;
+        w4 -= cfg().Ft_positive_exploration_boost * Ft;
+        w3 += cfg().Ft_positive_exploration_boost * Ft;
     } else {
         // Fond affectif négatif : favorise prudence
-        w5 += config_.Ft_negative_prudence_boost * std::abs(Ft);
+        w5 += cfg().Ft_negative_prudence_boost * std::abs(Ft);
     }
 
     // Renormaliser
@@ -1260,7 +1439,8 @@ void DecisionEngine::modulateWeights(
     }
 }
 
-std::vector<ActionOption> DecisionEngine::generateDefaultOptions(
+template <typename Profile>
+std::vector<ActionOption> BasicDecisionEngine<Profile>::generateDefaultOptions(
     const std::string& context_type)
 {
     std::vector<ActionOption> options;
@@ -1284,11 +1464,16 @@ std::vector<ActionOption> DecisionEngine::generateDefaultOptions(
     return options;
 }
 
-void DecisionEngine::updateHistory(const DecisionResult& result) {
+template <typename Profile>
+void BasicDecisionEngine<Profile>::updateHistory(const DecisionResult& result) {
     decision_history_.push_back(result);
-    while (decision_history_.size() > MAX_HISTORY_SIZE) {
-        decision_history_.pop_front();
-    }
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// INSTANCIATIONS
+// ═══════════════════════════════════════════════════════════════════════════
+
+template class BasicDecisionEngine<RuntimeProfile<DecisionConfig>>;
+template class BasicDecisionEngine<ProductionDecisionProfile>;
+
 } // namespace mcee
@@ -0,0 +1,65 @@
+/**
+ * @file EmergencyLane.cpp
+ * @brief Implémentation de la voie rapide Amyghaleon
+ */
+
+#include "EmergencyLane.hpp"
+#include "Amyghaleon.hpp"
+
+namespace mcee {
+
+EmergencyLane::EmergencyLane(size_t capacity)
+    : queue_(capacity)
+{
+}
+
+bool EmergencyLane::evaluate(
+    const std::array<double, NUM_EMOTIONS>& emotions,
+    std::chrono::steady_clock::time_point ingest_time,
+    EmergencyLaneEvent& event) noexcept
+{
+    // Même parcours que Amyghaleon::findMaxCriticalEmotion (premier maximum strict)
+    size_t max_index = CRITICAL_EMOTION_INDICES[0];
+    double max_value = -1.0;
+    for (size_t index : CRITICAL_EMOTION_INDICES) {
+        if (emotions[index] > max_value) {
+            max_value = emotions[index];
+            max_index = index;
+        }
+    }
+
+    const double threshold = threshold_.load(std::memory_order_relaxed);
+    if (max_value <= threshold) {
+        return false;
+    }
+
+    event.emotion_index = max_index;
+    event.value = max_value;
+    event.threshold = threshold;
+    event.phase = phase_.load(std::memory_order_relaxed);
+    event.ingest_time = ingest_time;
+    triggered_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool EmergencyLane::post(const EmergencyLaneEvent& event) noexcept {
+    EmergencyLaneEvent copy = event;
+    if (queue_.tryPush(std::move(copy))) {
+        return true;
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+EmergencyResponse EmergencyLane::toResponse(const EmergencyLaneEvent& event) {
+    EmergencyResponse response;
+    response.triggered = true;
+    response.action = Amyghaleon::actionFor(event.emotion_index);
+    response.priority = Amyghaleon::priorityFor(event.value);
+    response.phase_at_trigger = event.phase;
+    response.trigger_emotion = EMOTION_NAMES[event.emotion_index];
+    response.emotion_value = event.value;
+    return response;
+}
+
+} // namespace mcee
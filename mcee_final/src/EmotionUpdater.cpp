@@ -6,10 +6,10 @@
  */
 
 #include "EmotionUpdater.hpp"
+#include "Logger.hpp"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
-#include <iostream>
 #include <iomanip>
 
 namespace mcee {
@@ -21,18 +21,21 @@ EmotionUpdater::EmotionUpdater() {
 }
 
 void EmotionUpdater::setCoefficientsFromPhase(const PhaseConfig& config) {
+    // Appelé à chaque trame par le pipeline : ne journaliser que les changements
+    bool changed = alpha_ != config.alpha || beta_ != config.beta || gamma_ != config.gamma
+                || delta_ != config.delta || theta_ != config.theta;
+
     alpha_ = config.alpha;
     beta_ = config.beta;
     gamma_ = config.gamma;
     delta_ = config.delta;
     theta_ = config.theta;
 
-    std::cout << "[EmotionUpdater] Coefficients mis à jour:\n"
-              << "  α=" << std::fixed << std::setprecision(2) << alpha_
-              << ", β=" << beta_
-              << ", γ=" << gamma_
-              << ", δ=" << delta_
-              << ", θ=" << theta_ << "\n";
+    if (changed) {
+        MCEE_LOG_DEBUG("EmotionUpdater",
+            "Coefficients mis à jour: α=", std::fixed, std::setprecision(2), alpha_,
+            ", β=", beta_, ", γ=", gamma_, ", δ=", delta_, ", θ=", theta_);
+    }
 }
 
 double EmotionUpdater::updateEmotion(
@@ -64,19 +67,88 @@ void EmotionUpdater::updateAllEmotions(
     const std::array<double, NUM_EMOTIONS>& memory_influences,
     double wisdom) 
 {
-    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-        state.emotions[i] = updateEmotion(
-            state.emotions[i],
-            feedback.external,
-            feedback.internal,
-            delta_t,
-            memory_influences[i],
-            wisdom
-        );
-    }
+    alignas(32) std::array<double, NUM_EMOTIONS> next;
+    (void)updateKernel(state.emotions, commonTerm(feedback, delta_t, wisdom), memory_influences, next);
+    state.emotions = next;
 
     // Mettre à jour le timestamp
-    state.timestamp = std::chrono::steady_clock::now();
+    state.timestamp = SessionClock::now();
+}
+
+EmotionSummary EmotionUpdater::updateState(
+    EmotionalState& state,
+    const Feedback& feedback,
+    double delta_t,
+    const std::array<double, NUM_EMOTIONS>& memory_influences,
+    double wisdom,
+    std::span<const MemoryRef> memories,
+    double E_global_prev) const
+{
+    alignas(32) std::array<double, NUM_EMOTIONS> next;
+    const EmotionSummary summary = updateKernel(
+        state.emotions, commonTerm(feedback, delta_t, wisdom), memory_influences, next);
+
+    state.emotions = next;
+    state.variance_global = memoryVariance(next, memories);
+    state.E_global = eGlobal(summary.sum, E_global_prev, state.variance_global);
+    state.timestamp = SessionClock::now();
+    return summary;
+}
+
+EmotionSummary EmotionUpdater::updateKernel(
+    const std::array<double, NUM_EMOTIONS>& current,
+    double common_term,
+    const std::array<double, NUM_EMOTIONS>& memory_influences,
+    std::array<double, NUM_EMOTIONS>& next) const
+{
+    // E_i(t+1) = clamp(E_i(t) + [α·Fb_ext + β·Fb_int − γ·Δt + θ·Wt] + δ·IS_i, 0, 1)
+    EmotionSummary::Lanes lanes;
+    for (size_t base = 0; base < NUM_EMOTIONS; base += EMOTION_LANES) {
+        for (size_t l = 0; l < EMOTION_LANES; ++l) {
+            const size_t i = base + l;
+            const double e = current[i] + common_term + delta_ * memory_influences[i];
+            next[i] = std::min(std::max(e, 0.0), 1.0);
+        }
+        lanes.add(next.data() + base, base);
+    }
+    return lanes.reduce();
+}
+
+double EmotionUpdater::memoryVariance(
+    const std::array<double, NUM_EMOTIONS>& emotions,
+    std::span<const MemoryRef> memories)
+{
+    if (memories.empty()) {
+        return 0.0;
+    }
+
+    // Σ_j (E_i − S_i,j)² par émotion : 24 accumulateurs indépendants
+    alignas(32) std::array<double, NUM_EMOTIONS> sum_sq{};
+    for (const auto& mem : memories) {
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            const double diff = emotions[i] - mem->emotions[i];
+            sum_sq[i] += diff * diff;
+        }
+    }
+
+    double lanes[EMOTION_LANES] = {};
+    for (size_t base = 0; base < NUM_EMOTIONS; base += EMOTION_LANES) {
+        for (size_t l = 0; l < EMOTION_LANES; ++l) {
+            lanes[l] += sum_sq[base + l];
+        }
+    }
+    double total = 0.0;
+    for (double lane : lanes) total += lane;
+
+    // Moyenne sur les souvenirs puis sur les émotions
+    return total / static_cast<double>(memories.size()) / static_cast<double>(NUM_EMOTIONS);
+}
+
+double EmotionUpdater::eGlobal(double sum, double E_global_prev, double variance_global) {
+    // Formule: E_global(t+1) = tanh(E_global(t) + Σ[E_i(t+1) × (1 - Var_global)])
+    // normalisée par le nombre d'émotions pour éviter l'explosion
+    const double weight = 1.0 - std::clamp(variance_global, 0.0, 1.0);
+    return std::tanh(E_global_prev + sum * weight / static_cast<double>(NUM_EMOTIONS));
 }
 
 double EmotionUpdater::computeVariance(
@@ -99,28 +171,9 @@ double EmotionUpdater::computeVariance(
 
 double EmotionUpdater::computeGlobalVariance(
     const EmotionalState& state,
-    const std::vector<Memory>& memories) const 
+    std::span<const MemoryRef> memories) const 
 {
-    if (memories.empty()) {
-        return 0.0;
-    }
-
-    double total_variance = 0.0;
-
-    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-        // Collecter les valeurs de cette émotion dans tous les souvenirs
-        std::vector<double> memory_values;
-        memory_values.reserve(memories.size());
-        
-        for (const auto& mem : memories) {
-            memory_values.push_back(mem.emotions[i]);
-        }
-
-        total_variance += computeVariance(state.emotions[i], memory_values);
-    }
-
-    // Variance moyenne sur toutes les émotions
-    return total_variance / static_cast<double>(NUM_EMOTIONS);
+    return memoryVariance(state.emotions, memories);
 }
 
 double EmotionUpdater::computeEGlobal(
@@ -128,19 +181,7 @@ double EmotionUpdater::computeEGlobal(
     double E_global_prev,
     double variance_global) const 
 {
-    // Formule: E_global(t+1) = tanh(E_global(t) + Σ[E_i(t+1) × (1 - Var_global)])
-    
-    double sum_weighted = 0.0;
-    double weight = 1.0 - std::clamp(variance_global, 0.0, 1.0);
-
-    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-        sum_weighted += state.emotions[i] * weight;
-    }
-
-    // Normaliser par le nombre d'émotions pour éviter explosion
-    sum_weighted /= static_cast<double>(NUM_EMOTIONS);
-
-    return std::tanh(E_global_prev + sum_weighted);
+    return eGlobal(state.summarize().sum, E_global_prev, variance_global);
 }
 
 } // namespace mcee
@@ -0,0 +1,169 @@
+/**
+ * @file EpisodeIndex.cpp
+ * @brief Implémentation de l'index du rappel épisodique
+ */
+
+#include "EpisodeIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace mcee {
+
+namespace {
+
+// Émotions principales comparées par sim_emo (même liste que l'équation 2)
+const std::array<std::string, EpisodeIndex::COMPARED_EMOTIONS> COMPARED_EMOTION_NAMES = {
+    "Joie", "Peur", "Colère", "Tristesse", "Surprise", "Dégoût"
+};
+
+constexpr double HALF_LIFE_HOURS = 24.0;
+
+// Ordre du top-k : similarité décroissante, puis position croissante
+bool better(const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+} // namespace
+
+EpisodeIndex::EpisodeIndex() {
+    // Une émotion absente de EMOTION_NAMES vaut 0 des deux côtés :
+    // elle ne contribue pas à la distance mais compte dans la moyenne
+    for (const auto& name : COMPARED_EMOTION_NAMES) {
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            if (EMOTION_NAMES[i] == name) {
+                emotion_slots_.push_back(i);
+                break;
+            }
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MISE À JOUR
+// ═══════════════════════════════════════════════════════════════════════════
+
+void EpisodeIndex::add(size_t row, const MemoryEpisode& episode) {
+    auto it = partition_of_.find(episode.context_type);
+    if (it == partition_of_.end()) {
+        it = partition_of_.emplace(episode.context_type,
+                                   static_cast<uint32_t>(partitions_.size())).first;
+        Partition partition;
+        partition.context_type = episode.context_type;
+        partition.emotion_cols.resize(emotion_slots_.size());
+        partitions_.push_back(std::move(partition));
+    }
+
+    Partition& partition = partitions_[it->second];
+    for (size_t d = 0; d < emotion_slots_.size(); ++d) {
+        partition.emotion_cols[d].push_back(episode.emotional_state.emotions[emotion_slots_[d]]);
+    }
+    partition.timestamps.push_back(episode.timestamp);
+    partition.rows.push_back(row);
+    ++size_;
+}
+
+void EpisodeIndex::rebuild(const std::vector<MemoryEpisode>& episodes) {
+    clear();
+    for (size_t row = 0; row < episodes.size(); ++row) {
+        add(row, episodes[row]);
+    }
+}
+
+void EpisodeIndex::clear() {
+    partitions_.clear();
+    partition_of_.clear();
+    size_ = 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RAPPEL
+// ═══════════════════════════════════════════════════════════════════════════
+
+double EpisodeIndex::contextSimilarity(const std::string& a, const std::string& b) {
+    if (a == b) {
+        return 1.0;  // Contexte identique
+    }
+    if ((a == "reunion" && b == "professionnel") || (a == "professionnel" && b == "reunion")) {
+        return 0.7;  // Contextes proches
+    }
+    if ((a == "projet" && b == "strategique") || (a == "strategique" && b == "projet")) {
+        return 0.6;  // Contextes liés
+    }
+    return 0.2;      // Contextes différents
+}
+
+void EpisodeIndex::topK(const SituationFrame& frame,
+                        const DecisionConfig& config,
+                        size_t k,
+                        std::chrono::steady_clock::time_point now,
+                        std::vector<std::pair<double, size_t>>& out) const {
+    out.clear();
+    if (k == 0 || size_ == 0) return;
+
+    // Partitions dans l'ordre de sim_ctx décroissant : les plus prometteuses
+    // remplissent le top-k en premier et resserrent la borne des suivantes
+    partition_order_.clear();
+    for (uint32_t p = 0; p < partitions_.size(); ++p) {
+        partition_order_.push_back({contextSimilarity(partitions_[p].context_type, frame.context_type), p});
+    }
+    std::stable_sort(partition_order_.begin(), partition_order_.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::array<double, NUM_EMOTIONS> query{};
+    for (size_t d = 0; d < emotion_slots_.size(); ++d) {
+        query[d] = frame.emotional_state.emotions[emotion_slots_[d]];
+    }
+    const double emo_norm = static_cast<double>(COMPARED_EMOTIONS);
+    const double best_rest = std::max(config.beta_emo, 0.0) + std::max(config.gamma_temp, 0.0);
+
+    for (const auto& [sim_ctx, p] : partition_order_) {
+        const Partition& partition = partitions_[p];
+        const size_t n = partition.rows.size();
+
+        if (out.size() == k) {
+            double bound = std::min(1.0, config.alpha_ctx * sim_ctx + best_rest);
+            if (bound + 1e-12 < out.front().first) {
+                continue;  // Aucun épisode de la partition ne peut entrer
+            }
+        }
+
+        // Distance émotionnelle au carré, colonne par colonne
+        distances_.assign(n, 0.0);
+        double* dist = distances_.data();
+        for (size_t d = 0; d < emotion_slots_.size(); ++d) {
+            const double* col = partition.emotion_cols[d].data();
+            const double q = query[d];
+            for (size_t i = 0; i < n; ++i) {
+                double diff = col[i] - q;
+                dist[i] += diff * diff;
+            }
+        }
+
+        const double ctx_term = config.alpha_ctx * sim_ctx;
+        for (size_t i = 0; i < n; ++i) {
+            double emo_distance = std::sqrt(dist[i] / emo_norm);
+            double sim_emo = 1.0 - std::clamp(emo_distance, 0.0, 1.0);
+
+            auto hours = std::chrono::duration_cast<std::chrono::hours>(
+                now - partition.timestamps[i]).count();
+            double sim_temp = std::clamp(std::exp(-0.693 * hours / HALF_LIFE_HOURS), 0.0, 1.0);
+
+            double similarity = std::clamp(
+                ctx_term + config.beta_emo * sim_emo + config.gamma_temp * sim_temp, 0.0, 1.0);
+
+            std::pair<double, size_t> candidate{similarity, partition.rows[i]};
+            if (out.size() < k) {
+                out.push_back(candidate);
+                std::push_heap(out.begin(), out.end(), better);
+            } else if (better(candidate, out.front())) {
+                std::pop_heap(out.begin(), out.end(), better);
+                out.back() = candidate;
+                std::push_heap(out.begin(), out.end(), better);
+            }
+        }
+    }
+
+    std::sort_heap(out.begin(), out.end(), better);
+}
+
+} // namespace mcee
@@ -0,0 +1,731 @@
+/**
+ * @file Executor.cpp
+ * @brief Implémentation de l'exécuteur partagé et des voies de module
+ */
+
+#include "Executor.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace mcee {
+
+namespace {
+
+struct WorkerContext {
+    Executor* owner = nullptr;
+    size_t index = 0;
+};
+
+thread_local WorkerContext t_worker;
+thread_local const TaskLane* t_lane = nullptr;   // Voie de la tâche en cours
+
+// Attente d'une future sur un worker : tranche entre deux recherches de tâche
+constexpr auto HELP_WAIT_SLICE = std::chrono::milliseconds(1);
+
+struct SharedExecutor {
+    std::mutex mutex;
+    ExecutorConfig config;
+    std::shared_ptr<Executor> instance;
+};
+
+SharedExecutor& sharedExecutor() {
+    // Logger construit avant, donc détruit après l'exécuteur partagé
+    Logger::instance();
+    static SharedExecutor shared;
+    return shared;
+}
+
+// Tas min sur (échéance, ordre d'ajout)
+struct TimerLater {
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const {
+        return a.due != b.due ? a.due > b.due : a.seq > b.seq;
+    }
+};
+
+} // namespace
+
+const char* taskClassName(TaskClass cls) noexcept {
+    switch (cls) {
+        case TaskClass::EMERGENCY: return "emergency";
+        case TaskClass::PIPELINE: return "pipeline";
+        case TaskClass::BACKGROUND: return "background";
+    }
+    return "unknown";
+}
+
+bool readExecutorConfig(const std::string& path, ExecutorConfig& config) {
+    try {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        nlohmann::json j = nlohmann::json::parse(file);
+        if (!j.contains("executor")) return false;
+
+        const auto& e = j["executor"];
+        config.threads = e.value("threads", config.threads);
+        config.reserve_emergency_worker = e.value("reserve_emergency_worker", config.reserve_emergency_worker);
+        auto& q = config.max_queued;
+        q[0] = e.value("max_queued_emergency", q[0]);
+        q[1] = e.value("max_queued_pipeline", q[1]);
+        q[2] = e.value("max_queued_background", q[2]);
+        return true;
+
+    } catch (const std::exception& ex) {
+        MCEE_LOG_ERROR("Executor", "Erreur chargement config executor: ", ex.what());
+        return false;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ANNULATION
+// ═══════════════════════════════════════════════════════════════════════════
+
+void CancellationToken::onCancel(std::function<void()> callback) const {
+    if (!state_) return;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (!state_->cancelled.load(std::memory_order_acquire)) {
+            state_->callbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+CancellationToken CancellationSource::token() const {
+    CancellationToken token;
+    token.state_ = state_;
+    return token;
+}
+
+void CancellationSource::cancel() {
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (state_->cancelled.load(std::memory_order_relaxed)) return;
+        state_->cancelled.store(true, std::memory_order_release);
+        callbacks.swap(state_->callbacks);
+    }
+    for (auto& callback : callbacks) callback();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FUTURES
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace detail {
+
+void FutureStateBase::wait() const {
+    if (ready()) return;
+
+    // Sur un worker : avancer les autres tâches plutôt que d'immobiliser le
+    // pool sur une tâche qui attend peut-être derrière celle-ci
+    if (Executor* executor = Executor::current()) {
+        while (!ready()) {
+            if (executor->runPendingTask()) continue;
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, HELP_WAIT_SLICE, [this]() { return ready(); });
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return ready(); });
+}
+
+bool FutureStateBase::waitUntil(std::chrono::steady_clock::time_point deadline) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_until(lock, deadline, [this]() { return ready(); });
+}
+
+void FutureStateBase::setError(std::exception_ptr error) {
+    resolve([&]() { error_ = std::move(error); });
+}
+
+void FutureStateBase::onReady(std::function<void()> callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ready_.load(std::memory_order_relaxed)) {
+            callbacks_.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+std::exception_ptr FutureStateBase::error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+} // namespace detail
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CYCLE DE VIE
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct Executor::Periodic {
+    std::chrono::steady_clock::duration period;
+    TaskClass cls;
+    std::function<void()> fn;
+    CancellationToken token;
+    std::shared_ptr<detail::FutureState<void>> done;
+};
+
+Executor::Executor(const ExecutorConfig& config)
+    : config_(config)
+    , timers_(std::make_shared<TimerQueue>())
+{
+    size_t threads = config_.threads > 0 ? config_.threads : std::thread::hardware_concurrency();
+    general_workers_ = std::max<size_t>(1, threads);
+    const size_t total = general_workers_ + (config_.reserve_emergency_worker ? 1 : 0);
+
+    queues_.reserve(total);
+    for (size_t i = 0; i < total; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+        queues_.back()->emergency_only = i >= general_workers_;
+    }
+
+    workers_.reserve(total);
+    for (size_t i = 0; i < total; ++i) {
+        workers_.emplace_back(&Executor::workerLoop, this, i);
+    }
+    timer_thread_ = std::thread(&Executor::timerLoop, this);
+
+    MCEE_LOG_INFO("Executor", "Démarré : ", general_workers_, " workers",
+                  config_.reserve_emergency_worker ? " + 1 réservé aux urgences" : "");
+}
+
+Executor::~Executor() {
+    shutdown();
+}
+
+std::shared_ptr<Executor> Executor::shared() {
+    auto& shared = sharedExecutor();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (!shared.instance) {
+        shared.instance = std::make_shared<Executor>(shared.config);
+    }
+    return shared.instance;
+}
+
+bool Executor::configureShared(const ExecutorConfig& config) {
+    auto& shared = sharedExecutor();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (shared.instance) return false;
+    shared.config = config;
+    return true;
+}
+
+Executor* Executor::current() noexcept {
+    return t_worker.owner;
+}
+
+void Executor::shutdown() {
+    std::call_once(shutdown_once_, [this]() {
+        // Minuterie d'abord : plus aucune tâche différée n'entre en file
+        {
+            std::lock_guard<std::mutex> lock(timers_->mutex);
+            timers_->stop = true;
+        }
+        timers_->cv.notify_all();
+        if (timer_thread_.joinable()) timer_thread_.join();
+
+        stop_.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+        }
+        wake_cv_.notify_all();
+        emergency_cv_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+
+        // Tâches restées en file : annulées (leurs futures passent en TaskCancelled)
+        std::vector<Task> remaining;
+        for (auto& queue : queues_) {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->closed = true;
+            for (auto& tasks : queue->tasks) {
+                for (auto& task : tasks) remaining.push_back(std::move(task));
+                tasks.clear();
+            }
+        }
+        for (auto& task : remaining) {
+            auto& counters = counters_[static_cast<size_t>(task.cls)];
+            counters.queued.fetch_sub(1, std::memory_order_relaxed);
+            counters.cancelled.fetch_add(1, std::memory_order_relaxed);
+            queued_total_.fetch_sub(1, std::memory_order_relaxed);
+            task.body(false);
+        }
+    });
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SOUMISSION
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool Executor::post(TaskClass cls, std::function<void()> fn, CancellationToken token) {
+    Task task;
+    task.cls = cls;
+    task.token = std::move(token);
+    task.body = [fn = std::move(fn)](bool run) {
+        if (run) fn();
+        return true;
+    };
+    return enqueue(std::move(task), true);
+}
+
+bool Executor::enqueue(Task&& task, bool bounded) {
+    const size_t cls = static_cast<size_t>(task.cls);
+    auto& counters = counters_[cls];
+
+    if (stop_.load(std::memory_order_acquire) ||
+        (bounded && counters.queued.load(std::memory_order_relaxed) >= config_.max_queued[cls])) {
+        counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // File du worker courant (localité), sinon à tour de rôle ; les urgences
+    // venues de l'extérieur vont directement au worker réservé
+    size_t target;
+    if (t_worker.owner == this &&
+        (task.cls == TaskClass::EMERGENCY || !queues_[t_worker.index]->emergency_only)) {
+        target = t_worker.index;
+    } else if (task.cls == TaskClass::EMERGENCY && config_.reserve_emergency_worker) {
+        target = general_workers_;
+    } else {
+        target = next_queue_.fetch_add(1, std::memory_order_relaxed) % general_workers_;
+    }
+
+    task.enqueued = std::chrono::steady_clock::now();
+    {
+        auto& queue = *queues_[target];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.closed) {
+            counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        queue.tasks[cls].push_back(std::move(task));
+        counters.queued.fetch_add(1, std::memory_order_release);
+        queued_total_.fetch_add(1, std::memory_order_release);
+    }
+    counters.submitted.fetch_add(1, std::memory_order_relaxed);
+
+    // Le verrou ordonne l'incrément avant le test d'un worker qui s'endort
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    if (cls == static_cast<size_t>(TaskClass::EMERGENCY)) {
+        emergency_cv_.notify_one();
+    }
+    wake_cv_.notify_one();
+    return true;
+}
+
+bool Executor::postAfter(std::chrono::steady_clock::duration delay, TaskClass cls,
+                         std::function<void()> fn, CancellationToken token) {
+    if (stop_.load(std::memory_order_acquire)) return false;
+
+    addTimer(std::chrono::steady_clock::now() + delay,
+        [this, cls, fn = std::move(fn), token](bool fire) mutable {
+            if (fire) post(cls, std::move(fn), token);
+        }, token);
+    return true;
+}
+
+TaskFuture<void> Executor::schedulePeriodic(std::chrono::steady_clock::duration period, TaskClass cls,
+                                            std::function<void()> fn, CancellationToken token) {
+    auto periodic = std::make_shared<Periodic>(Periodic{
+        period, cls, std::move(fn), token, std::make_shared<detail::FutureState<void>>(this)});
+    TaskFuture<void> done(periodic->done);
+
+    // L'annulation réveille la minuterie : l'arrêt n'attend pas une période complète
+    std::weak_ptr<TimerQueue> weak = timers_;
+    token.onCancel([weak]() {
+        if (auto timers = weak.lock()) {
+            {
+                std::lock_guard<std::mutex> lock(timers->mutex);
+                timers->sweep = true;
+            }
+            timers->cv.notify_one();
+        }
+    });
+
+    armPeriodic(periodic);
+    return done;
+}
+
+void Executor::armPeriodic(const std::shared_ptr<Periodic>& periodic) {
+    addTimer(std::chrono::steady_clock::now() + periodic->period, [this, periodic](bool fire) {
+        if (!fire || periodic->token.isCancelled()) {
+            periodic->done->setValue(detail::Unit{});
+            return;
+        }
+
+        Task task;
+        task.cls = periodic->cls;
+        task.body = [this, periodic](bool run) -> bool {
+            bool ok = true;
+            if (run && !periodic->token.isCancelled()) {
+                try {
+                    periodic->fn();
+                } catch (const std::exception& e) {
+                    MCEE_LOG_ERROR("Executor", "Exception dans une tâche périodique ",
+                                   taskClassName(periodic->cls), ": ", e.what());
+                    ok = false;
+                }
+            }
+            // Réarmée après l'exécution : jamais deux exécutions simultanées
+            if (!run || periodic->token.isCancelled() || stop_.load(std::memory_order_acquire)) {
+                periodic->done->setValue(detail::Unit{});
+            } else {
+                armPeriodic(periodic);
+            }
+            return ok;
+        };
+
+        if (!enqueue(std::move(task), false)) {
+            periodic->done->setValue(detail::Unit{});
+        }
+    }, periodic->token);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORKERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool Executor::popTask(size_t index, Task& out) {
+    const size_t classes = queues_[index]->emergency_only ? 1 : TASK_CLASS_COUNT;
+    const size_t count = queues_.size();
+
+    // Classe par classe : une tâche PIPELINE volée passe avant une BACKGROUND locale
+    for (size_t cls = 0; cls < classes; ++cls) {
+        auto& counters = counters_[cls];
+        if (counters.queued.load(std::memory_order_acquire) == 0) continue;
+
+        for (size_t k = 0; k < count; ++k) {
+            auto& queue = *queues_[(index + k) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            auto& tasks = queue.tasks[cls];
+            if (tasks.empty()) continue;
+
+            // Le propriétaire sert sa file dans l'ordre ; un voleur prend la
+            // tâche la plus récente, la plus loin d'être servie sur place
+            if (k == 0) {
+                out = std::move(tasks.front());
+                tasks.pop_front();
+            } else {
+                out = std::move(tasks.back());
+                tasks.pop_back();
+            }
+            counters.queued.fetch_sub(1, std::memory_order_relaxed);
+            queued_total_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Executor::execute(Task& task) {
+    auto& counters = counters_[static_cast<size_t>(task.cls)];
+    counters.wait.recordSince(task.enqueued);
+
+    if (task.token.isCancelled()) {
+        counters.cancelled.fetch_add(1, std::memory_order_relaxed);
+        task.body(false);
+        return;
+    }
+
+    bool ok = false;
+    try {
+        ok = task.body(true);
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("Executor", "Exception dans une tâche ", taskClassName(task.cls), ": ", e.what());
+    } catch (...) {
+        MCEE_LOG_ERROR("Executor", "Exception inconnue dans une tâche ", taskClassName(task.cls));
+    }
+    (ok ? counters.executed : counters.failed).fetch_add(1, std::memory_order_relaxed);
+}
+
+void Executor::workerLoop(size_t index) {
+    t_worker = WorkerContext{this, index};
+    const bool emergency_only = queues_[index]->emergency_only;
+    auto& cv = emergency_only ? emergency_cv_ : wake_cv_;
+
+    auto has_work = [this, emergency_only]() {
+        return emergency_only
+            ? counters_[0].queued.load(std::memory_order_acquire) > 0
+            : queued_total_.load(std::memory_order_acquire) > 0;
+    };
+
+    Task task;
+    while (true) {
+        if (popTask(index, task)) {
+            execute(task);
+            task = Task{};      // Libère tout de suite ce que la tâche capturait
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        cv.wait(lock, [&]() { return stop_.load(std::memory_order_acquire) || has_work(); });
+        if (stop_.load(std::memory_order_acquire)) break;
+    }
+    t_worker = WorkerContext{};
+}
+
+bool Executor::runPendingTask() {
+    if (t_worker.owner != this) return false;
+
+    Task task;
+    if (!popTask(t_worker.index, task)) return false;
+    execute(task);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MINUTERIE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void Executor::addTimer(std::chrono::steady_clock::time_point due, std::function<void(bool)> fire,
+                        CancellationToken token) {
+    {
+        std::lock_guard<std::mutex> lock(timers_->mutex);
+        if (!timers_->stop) {
+            auto& heap = timers_->heap;
+            heap.push_back(TimerEntry{due, timers_->next_seq++, std::move(fire), std::move(token)});
+            std::push_heap(heap.begin(), heap.end(), TimerLater{});
+            timers_->cv.notify_one();
+            return;
+        }
+    }
+    fire(false);
+}
+
+void Executor::timerLoop() {
+    auto& timers = *timers_;
+    auto& heap = timers.heap;
+    const TimerLater later;
+
+    std::unique_lock<std::mutex> lock(timers.mutex);
+    while (!timers.stop) {
+        if (timers.sweep) {
+            // Entrées annulées retirées tout de suite, sans attendre leur échéance
+            timers.sweep = false;
+            auto cancelled = std::partition(heap.begin(), heap.end(),
+                [](const TimerEntry& e) { return !e.token.isCancelled(); });
+            std::vector<TimerEntry> dropped(std::make_move_iterator(cancelled),
+                                            std::make_move_iterator(heap.end()));
+            heap.erase(cancelled, heap.end());
+            std::make_heap(heap.begin(), heap.end(), later);
+
+            lock.unlock();
+            for (auto& entry : dropped) entry.fire(false);
+            lock.lock();
+            continue;
+        }
+
+        if (heap.empty()) {
+            timers.cv.wait(lock);
+            continue;
+        }
+
+        const auto due = heap.front().due;
+        if (std::chrono::steady_clock::now() < due) {
+            timers.cv.wait_until(lock, due);
+            continue;
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), later);
+        TimerEntry entry = std::move(heap.back());
+        heap.pop_back();
+
+        lock.unlock();
+        entry.fire(!entry.token.isCancelled());
+        lock.lock();
+    }
+
+    std::vector<TimerEntry> remaining = std::move(heap);
+    heap.clear();
+    lock.unlock();
+    for (auto& entry : remaining) entry.fire(false);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MÉTRIQUES
+// ═══════════════════════════════════════════════════════════════════════════
+
+ExecutorClassStats Executor::classStats(TaskClass cls) const {
+    const auto& counters = counters_[static_cast<size_t>(cls)];
+    ExecutorClassStats stats;
+    stats.queued = counters.queued.load(std::memory_order_relaxed);
+    stats.submitted = counters.submitted.load(std::memory_order_relaxed);
+    stats.executed = counters.executed.load(std::memory_order_relaxed);
+    stats.rejected = counters.rejected.load(std::memory_order_relaxed);
+    stats.cancelled = counters.cancelled.load(std::memory_order_relaxed);
+    stats.failed = counters.failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Executor::renderMetrics(PrometheusWriter& out) const {
+    constexpr TaskClass classes[] = {TaskClass::EMERGENCY, TaskClass::PIPELINE, TaskClass::BACKGROUND};
+
+    out.family("mcee_executor_workers", "Workers de l'exécuteur partagé", "gauge");
+    out.sample("mcee_executor_workers", static_cast<double>(workerCount()));
+
+    out.family("mcee_executor_queue_depth", "Tâches en file par classe de priorité", "gauge");
+    for (TaskClass cls : classes) {
+        out.sample("mcee_executor_queue_depth", static_cast<double>(classStats(cls).queued),
+                   std::string("class=\"") + taskClassName(cls) + "\"");
+    }
+
+    out.family("mcee_executor_tasks_total", "Tâches par classe et par issue", "counter");
+    for (TaskClass cls : classes) {
+        const ExecutorClassStats stats = classStats(cls);
+        const std::string label = std::string("class=\"") + taskClassName(cls) + "\",result=";
+        out.sample("mcee_executor_tasks_total", static_cast<double>(stats.executed), label + "\"executed\"");
+        out.sample("mcee_executor_tasks_total", static_cast<double>(stats.failed), label + "\"failed\"");
+        out.sample("mcee_executor_tasks_total", static_cast<double>(stats.cancelled), label + "\"cancelled\"");
+        out.sample("mcee_executor_tasks_total", static_cast<double>(stats.rejected), label + "\"rejected\"");
+    }
+
+    out.family("mcee_executor_queue_wait_seconds", "Attente en file avant exécution", "histogram");
+    for (TaskClass cls : classes) {
+        out.histogram("mcee_executor_queue_wait_seconds", queueWait(cls).snapshot(),
+                      std::string("class=\"") + taskClassName(cls) + "\"");
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VOIES DE MODULE
+// ═══════════════════════════════════════════════════════════════════════════
+
+TaskLane::TaskLane(TaskClass cls, size_t max_concurrency, size_t max_pending,
+                   std::shared_ptr<Executor> executor)
+    : cls_(cls)
+    , max_concurrency_(std::max<size_t>(1, max_concurrency))
+    , max_pending_(max_pending)
+    , executor_(std::move(executor)) {}
+
+TaskLane::~TaskLane() {
+    close();
+}
+
+bool TaskLane::post(std::function<void()> task) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_ || queue_.size() >= max_pending_) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (!executor_) {
+        executor_ = Executor::shared();
+    }
+    queue_.push_back(std::move(task));
+    dispatch(lock);
+    return true;
+}
+
+void TaskLane::dispatch(std::unique_lock<std::mutex>& lock) {
+    std::vector<std::function<void()>> ready;
+    while (running_ < max_concurrency_ && !queue_.empty()) {
+        ready.push_back(std::move(queue_.front()));
+        queue_.pop_front();
+        ++running_;
+    }
+    if (ready.empty()) return;
+
+    auto executor = executor_;
+    lock.unlock();
+
+    size_t refused = 0;
+    for (auto& fn : ready) {
+        Executor::Task task;
+        task.cls = cls_;
+        task.body = [this, fn = std::move(fn)](bool run) -> bool {
+            bool ok = true;
+            if (run) {
+                const TaskLane* previous = t_lane;
+                t_lane = this;
+                try {
+                    fn();
+                } catch (const std::exception& e) {
+                    MCEE_LOG_ERROR("Executor", "Exception dans une tâche ", taskClassName(cls_),
+                                   ": ", e.what());
+                    ok = false;
+                }
+                t_lane = previous;
+            }
+            finish();
+            return ok;
+        };
+        // La voie borne déjà sa file : pas de seconde limite côté exécuteur
+        if (!executor->enqueue(std::move(task), false)) {
+            ++refused;
+        }
+    }
+
+    lock.lock();
+    if (refused > 0) {
+        // Exécuteur arrêté : la file ne sera plus servie
+        running_ -= refused;
+        rejected_.fetch_add(refused + queue_.size(), std::memory_order_relaxed);
+        queue_.clear();
+        idle_cv_.notify_all();
+    }
+}
+
+void TaskLane::finish() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    --running_;
+    if (!closed_) {
+        dispatch(lock);
+    }
+    idle_cv_.notify_all();
+}
+
+size_t TaskLane::close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    size_t dropped = queue_.size();
+    queue_.clear();
+
+    // Appelée depuis une de ses propres tâches : ne pas s'attendre soi-même
+    const size_t self = t_lane == this ? 1 : 0;
+    idle_cv_.wait(lock, [&]() { return running_ <= self; });
+    return dropped;
+}
+
+void TaskLane::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+}
+
+void TaskLane::waitIdle() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const size_t self = t_lane == this ? 1 : 0;
+    idle_cv_.wait(lock, [&]() { return queue_.empty() && running_ <= self; });
+}
+
+void TaskLane::setLimits(size_t max_concurrency, size_t max_pending) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    max_concurrency_ = std::max<size_t>(1, max_concurrency);
+    max_pending_ = max_pending;
+    if (!closed_ && executor_) {
+        dispatch(lock);
+    }
+}
+
+size_t TaskLane::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+size_t TaskLane::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+} // namespace mcee
@@ -0,0 +1,144 @@
+/**
+ * @file FrameArena.cpp
+ * @brief Instrumentation optionnelle des opérateurs new globaux
+ *
+ * Avec MCEE_COUNT_HEAP_ALLOCATIONS, toutes les formes remplaçables de
+ * operator new incrémentent un compteur local au thread (un entier à
+ * initialisation constante : pas de garde TLS ni d'atomique) avant de
+ * déléguer à malloc / aligned_alloc, avec la boucle new_handler standard.
+ * Option réservée à mcee_bench : le binaire de production garde les
+ * opérateurs de la bibliothèque.
+ */
+
+#include "FrameArena.hpp"
+
+#ifdef MCEE_COUNT_HEAP_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace mcee::heap {
+
+namespace {
+thread_local uint64_t thread_allocations = 0;
+}
+
+bool countingEnabled() noexcept {
+#ifdef MCEE_COUNT_HEAP_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t threadAllocations() noexcept {
+    return thread_allocations;
+}
+
+#ifdef MCEE_COUNT_HEAP_ALLOCATIONS
+namespace {
+
+void* rawAlloc(std::size_t size) noexcept {
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* rawAlignedAlloc(std::size_t size, std::align_val_t align) noexcept {
+    const auto alignment = static_cast<std::size_t>(align);
+    // aligned_alloc exige une taille multiple de l'alignement
+    const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    return std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+}
+
+/**
+ * @brief Boucle standard de operator new : tant que l'allocation échoue,
+ *        appelle le new_handler installé, ou lève bad_alloc s'il n'y en a pas
+ */
+template<typename Alloc>
+void* allocateOrThrow(Alloc&& alloc) {
+    ++thread_allocations;
+    for (;;) {
+        if (void* p = alloc()) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void* allocate(std::size_t size) {
+    return allocateOrThrow([size] { return rawAlloc(size); });
+}
+
+void* allocate(std::size_t size, std::align_val_t align) {
+    return allocateOrThrow([size, align] { return rawAlignedAlloc(size, align); });
+}
+
+} // namespace
+#endif
+
+} // namespace mcee::heap
+
+#ifdef MCEE_COUNT_HEAP_ALLOCATIONS
+
+void* operator new(std::size_t size) {
+    return mcee::heap::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return mcee::heap::allocate(size);
+}
+
+// Formes nothrow : même boucle, bad_alloc (handler absent ou levé) → nullptr
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return mcee::heap::allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return mcee::heap::allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    return mcee::heap::allocate(size, align);
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return mcee::heap::allocate(size, align);
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try {
+        return mcee::heap::allocate(size, align);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    try {
+        return mcee::heap::allocate(size, align);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+
+#endif // MCEE_COUNT_HEAP_ALLOCATIONS
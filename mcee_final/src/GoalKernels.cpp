@@ -0,0 +1,54 @@
+/**
+ * @file GoalKernels.cpp
+ * @brief Compilation des tables creuses ADDO
+ */
+
+#include "GoalKernels.hpp"
+
+namespace mcee::goal {
+
+SparsePairs SparsePairs::fromUpperTriangle(const Matrix& m) noexcept {
+    SparsePairs pairs;
+    for (size_t i = 0; i < NUM_GOAL_VARIABLES; ++i) {
+        for (size_t j = i + 1; j < NUM_GOAL_VARIABLES; ++j) {
+            if (m[i][j] > 0.0) {
+                pairs.row[pairs.size] = static_cast<uint8_t>(i);
+                pairs.col[pairs.size] = static_cast<uint8_t>(j);
+                pairs.coeff[pairs.size] = m[i][j];
+                ++pairs.size;
+            }
+        }
+    }
+    return pairs;
+}
+
+SparseEmotionRows SparseEmotionRows::fromMapping(const EmotionVariableMapping& mapping) noexcept {
+    SparseEmotionRows rows;
+    size_t n = 0;
+    for (size_t e = 0; e < NUM_EMOTIONS; ++e) {
+        rows.row_begin[e] = static_cast<uint16_t>(n);
+        for (size_t v = 0; v < NUM_GOAL_VARIABLES; ++v) {
+            const double w = mapping.weights[e][v];
+            if (std::abs(w) < MIN_WEIGHT) continue;
+            rows.var[n] = static_cast<uint8_t>(v);
+            rows.weight[n] = w * DAMPING;
+            ++n;
+        }
+    }
+    rows.row_begin[NUM_EMOTIONS] = static_cast<uint16_t>(n);
+    return rows;
+}
+
+GoalKernels::GoalKernels()
+    : positive(SparsePairs::fromUpperTriangle(interactions.positive))
+    , negative(SparsePairs::fromUpperTriangle(interactions.negative))
+    , emotions(SparseEmotionRows::fromMapping(emotion_mapping))
+{
+}
+
+const GoalKernels& GoalKernels::defaults() {
+    static const GoalKernels kernels;
+    return kernels;
+}
+
+} // namespace mcee::goal
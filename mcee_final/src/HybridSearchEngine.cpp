@@ -6,16 +6,43 @@
  */
 
 #include "HybridSearchEngine.hpp"
+#include "Logger.hpp"
+#include "LemmaTable.hpp"
+#include "LLMResponseCache.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <sstream>
-#include <iostream>
 #include <functional>
 #include <unordered_set>
+#include <string_view>
 
 namespace mcee {
 
+namespace {
+
+// Graines des clés du cache d'embeddings (question et lemmes partagent le cache)
+constexpr uint64_t EMBEDDING_TEXT_SEED = 0x51ed270b27a1c3f5ULL;
+constexpr uint64_t EMBEDDING_LEMMAS_SEED = 0x2545f4914f6cdd1dULL;
+
+// Au-delà de ce multiple de la capacité de l'index, les compteurs vieillissent
+constexpr size_t HOT_MEMORY_TRACKING_FACTOR = 4;
+
+// Embeddings demandés à Neo4j par requête d'indexation
+constexpr size_t PROMOTION_BATCH = 64;
+
+/**
+ * @brief Arrondi à 4 chiffres significatifs (précision du float16) : les
+ *        nombres JSON envoyés passent de ~20 à ~8 caractères
+ */
+double roundSignificant(double value) {
+    if (value == 0.0 || !std::isfinite(value)) return value;
+    const double scale = std::pow(10.0, 3.0 - std::floor(std::log10(std::abs(value))));
+    return std::round(value * scale) / scale;
+}
+
+} // namespace
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONSTRUCTEUR
 // ═══════════════════════════════════════════════════════════════════════════
@@ -26,7 +53,34 @@ HybridSearchEngine::HybridSearchEngine(
     const HybridSearchConfig& config)
     : neo4j_(std::move(neo4j_client))
     , conscience_(std::move(conscience_engine))
-    , config_(config) {
+    , config_(config)
+    , cache_(config.cache_max_bytes, config.cache_shards)
+    , embedding_cache_(config.embedding_cache_max_bytes, config.cache_shards)
+    , semantic_index_(config.embedding_quantization) {
+}
+
+HybridSearchEngine::~HybridSearchEngine() {
+    {
+        std::lock_guard<std::mutex> lock(stragglers_mutex_);
+        for (auto& f : stragglers_) {
+            if (f.valid()) f.wait();
+        }
+    }
+    // Après les branches : une branche terminée peut encore lancer une indexation
+    std::lock_guard<std::mutex> lock(promotion_mutex_);
+    if (promotion_.valid()) promotion_.wait();
+}
+
+void HybridSearchEngine::setConfig(const HybridSearchConfig& config) {
+    if (config.embedding_quantization != semantic_index_.mode()) {
+        std::unique_lock<std::shared_mutex> lock(semantic_mutex_);
+        semantic_index_ = SemanticIndex(config.embedding_quantization);
+        for (auto& [id, hot] : hot_memories_) hot.requested = false;
+        embedding_cache_.clear();
+    }
+    config_ = config;
+    cache_.setByteBudget(config.cache_max_bytes);
+    embedding_cache_.setByteBudget(config.embedding_cache_max_bytes);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -60,27 +114,86 @@ SearchResponse HybridSearchEngine::search(
         return oss.str();
     }());
 
-    // Vérifier le cache
-    std::string cache_key = generateCacheKey(lemmas);
-    if (config_.enable_cache && isCacheValid(cache_key)) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        auto& cached = cache_[cache_key];
-        response = cached.first;
-        log("Résultat depuis cache");
+    // Embedding fourni, sinon celui d'une question ou de lemmes déjà vus
+    const uint64_t lemmas_key = hashLemmas(lemmas);
+    const std::vector<double> query_embedding = resolveEmbedding(question, lemmas, lemmas_key, embedding);
 
-        auto end_time = std::chrono::steady_clock::now();
-        response.search_time_ms = std::chrono::duration<double, std::milli>(
-            end_time - start_time).count();
-        return response;
+    // Vérifier le cache
+    const uint64_t embedding_key = hashEmbedding(query_embedding);
+    const uint64_t cache_key = hashCombine(lemmas_key, embedding_key);
+    if (config_.enable_cache) {
+        if (auto cached = cache_.get(cache_key, std::chrono::seconds(config_.cache_ttl_seconds))) {
+            response = *cached;
+            log("Résultat depuis cache");
+
+            auto end_time = std::chrono::steady_clock::now();
+            response.search_time_ms = std::chrono::duration<double, std::milli>(
+                end_time - start_time).count();
+            return response;
+        }
     }
 
     // Déterminer le mode de recherche
-    response.mode_used = determineSearchMode(lemmas, embedding, response.Ft, response.Ct);
+    response.mode_used = determineSearchMode(lemmas, query_embedding, response.Ft, response.Ct);
 
-    // Recherche lexicale
+    reapStragglers();
+
+    const bool run_lexical = response.mode_used != SearchMode::SEMANTIC_ONLY && !lemmas.empty();
+    const bool run_semantic = response.mode_used != SearchMode::LEXICAL_ONLY && !query_embedding.empty();
+
+    // Branche sémantique servie par l'index local si possible : Neo4j ne
+    // voit que les requêtes qu'il ne couvre pas
     std::vector<SearchResult> lexical_results;
-    if (response.mode_used != SearchMode::SEMANTIC_ONLY && !lemmas.empty()) {
-        lexical_results = searchLexical(lemmas);
+    std::vector<SearchResult> semantic_results;
+    bool semantic_remote = run_semantic;
+    if (run_semantic) {
+        semantic_queries_.fetch_add(1, std::memory_order_relaxed);
+        if (auto local = searchSemanticLocal(query_embedding)) {
+            semantic_results = std::move(*local);
+            semantic_remote = false;
+            semantic_local_hits_.fetch_add(1, std::memory_order_relaxed);
+            log("Sémantique depuis l'index local");
+        } else {
+            semantic_fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Recherches identiques concurrentes : une seule requête Neo4j par branche.
+    // Les tâches copient leurs entrées : une branche abandonnée peut survivre à l'appel.
+    auto lexical_task = [this, lemmas, lemmas_key]() {
+        return lexical_flight_.run(lemmas_key, [&]() { return searchLexical(lemmas); });
+    };
+    auto semantic_task = [this, query_embedding, embedding_key]() {
+        return semantic_flight_.run(embedding_key, [&]() { return searchSemantic(query_embedding); });
+    };
+
+    if (config_.parallel_branches && run_lexical && semantic_remote) {
+        // Les deux branches sont indépendantes : exécution concurrente sur
+        // l'Executor partagé, chacune bornée par son échéance
+        auto executor = Executor::shared();
+        auto lexical_future = executor->submit(TaskClass::PIPELINE, lexical_task);
+        auto semantic_future = executor->submit(TaskClass::PIPELINE, semantic_task);
+
+        auto lexical = awaitBranch(lexical_future,
+            start_time + std::chrono::milliseconds(config_.lexical_deadline_ms), "lexicale");
+        auto semantic = awaitBranch(semantic_future,
+            start_time + std::chrono::milliseconds(config_.semantic_deadline_ms), "sémantique");
+
+        if (lexical) lexical_results = std::move(*lexical);
+        if (semantic) semantic_results = std::move(*semantic);
+
+        if (!lexical || !semantic) {
+            response.degraded = true;
+            degraded_searches_++;
+            if (!lexical && semantic) response.mode_used = SearchMode::SEMANTIC_ONLY;
+            if (lexical && !semantic) response.mode_used = SearchMode::LEXICAL_ONLY;
+        }
+    } else {
+        if (run_lexical) lexical_results = lexical_task();
+        if (semantic_remote) semantic_results = semantic_task();
+    }
+
+    if (run_lexical) {
         response.lexical_confidence = lexical_results.empty() ? 0.0 :
             std::accumulate(lexical_results.begin(), lexical_results.end(), 0.0,
                 [](double sum, const SearchResult& r) { return sum + r.lexical_score; })
@@ -90,10 +203,7 @@ SearchResponse HybridSearchEngine::search(
             + " résultats, confiance=" + std::to_string(response.lexical_confidence));
     }
 
-    // Recherche sémantique
-    std::vector<SearchResult> semantic_results;
-    if (response.mode_used != SearchMode::LEXICAL_ONLY && !embedding.empty()) {
-        semantic_results = searchSemantic(embedding);
+    if (run_semantic) {
         response.semantic_confidence = semantic_results.empty() ? 0.0 :
             std::accumulate(semantic_results.begin(), semantic_results.end(), 0.0,
                 [](double sum, const SearchResult& r) { return sum + r.semantic_score; })
@@ -143,10 +253,9 @@ SearchResponse HybridSearchEngine::search(
     // Construire le contexte LLM
     response.context = buildContext(response.results, lemmas);
 
-    // Mettre en cache
-    if (config_.enable_cache) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        cache_[cache_key] = {response, std::chrono::steady_clock::now()};
+    // Mettre en cache (pas les réponses dégradées : la suivante aura les deux branches)
+    if (config_.enable_cache && !response.degraded) {
+        cache_.put(cache_key, std::make_shared<const SearchResponse>(response), estimateBytes(response));
     }
 
     auto end_time = std::chrono::steady_clock::now();
@@ -199,6 +308,8 @@ std::vector<std::string> HybridSearchEngine::extractSignificantLemmas(
     const std::vector<ParsedToken>& tokens) const {
 
     std::vector<std::string> lemmas;
+    std::vector<LemmaId> seen;
+    auto& table = LemmaTable::instance();
 
     // POS significatifs pour la recherche
     static const std::unordered_set<std::string> significant_pos = {
@@ -216,8 +327,13 @@ std::vector<std::string> HybridSearchEngine::extractSignificantLemmas(
             continue;
         }
 
-        // Éviter les doublons
-        if (std::find(lemmas.begin(), lemmas.end(), token.lemma) == lemmas.end()) {
+        // Mots vides de la table commune (ceux que spaCy aurait laissés passer)
+        const LemmaId id = table.intern(token.lemma);
+        if (table.has(id, LemmaTable::STOP_WORD)) continue;
+
+        // Éviter les doublons (comparaison d'identifiants)
+        if (std::find(seen.begin(), seen.end(), id) == seen.end()) {
+            seen.push_back(id);
             lemmas.push_back(token.lemma);
         }
     }
@@ -321,11 +437,35 @@ std::vector<SearchResult> HybridSearchEngine::searchSemantic(
         return results;
     }
 
+    // Vecteur de requête selon la quantification : codes int8 et échelle
+    // (reconstruits par Cypher), valeurs arrondies, ou doubles complets
+    json params;
+    const char* query_vector = "$embedding";
+    switch (config_.embedding_quantization) {
+        case EmbeddingQuantization::INT8: {
+            auto q = QuantizedEmbedding::encode(embedding, EmbeddingQuantization::INT8);
+            const int8_t* codes = q.int8Codes();
+            params["embedding_codes"] = std::vector<int>(codes, codes + q.dim());
+            params["embedding_scale"] = q.scale();
+            query_vector = "[c IN $embedding_codes | c * $embedding_scale]";
+            break;
+        }
+        case EmbeddingQuantization::FLOAT16: {
+            std::vector<double> rounded(embedding.size());
+            std::transform(embedding.begin(), embedding.end(), rounded.begin(), roundSignificant);
+            params["embedding"] = std::move(rounded);
+            break;
+        }
+        case EmbeddingQuantization::NONE:
+            params["embedding"] = embedding;
+            break;
+    }
+
     // Recherche par similarité cosinus d'embedding
     // Utilise l'index vectoriel Neo4j si disponible
     std::ostringstream cypher;
     cypher << R"(
-        CALL db.index.vector.queryNodes('memory_embedding_index', $limit, $embedding)
+        CALL db.index.vector.queryNodes('memory_embedding_index', $limit, )" << query_vector << R"()
         YIELD node, score
         WHERE score >= $threshold
         RETURN node.id as memory_id,
@@ -340,8 +480,6 @@ std::vector<SearchResult> HybridSearchEngine::searchSemantic(
         ORDER BY semantic_score DESC
     )";
 
-    json params;
-    params["embedding"] = embedding;
     params["limit"] = static_cast<int>(config_.max_results * 2);
     params["threshold"] = config_.min_semantic_score;
 
@@ -375,13 +513,226 @@ std::vector<SearchResult> HybridSearchEngine::searchSemantic(
         log("Index vectoriel non disponible, fallback désactivé: " + std::string(e.what()));
     }
 
+    recordSemanticResults(results);
+    return results;
+}
+
+std::optional<std::vector<SearchResult>> HybridSearchEngine::searchSemanticLocal(
+    const std::vector<double>& embedding) {
+
+    if (config_.semantic_index_capacity == 0) {
+        return std::nullopt;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(semantic_mutex_);
+    if (semantic_index_.size() < config_.semantic_local_min_results) {
+        return std::nullopt;
+    }
+
+    auto hits = semantic_index_.topK(embedding, config_.max_results * 2, config_.min_semantic_score);
+    if (hits.empty() || hits.size() < config_.semantic_local_min_results) {
+        return std::nullopt;
+    }
+
+    std::vector<SearchResult> results;
+    results.reserve(hits.size());
+    for (const auto& hit : hits) {
+        auto it = hot_memories_.find(std::string(hit.id));
+        if (it == hot_memories_.end()) continue;
+        SearchResult& sr = results.emplace_back(it->second.result);
+        sr.semantic_score = hit.similarity;
+    }
     return results;
 }
 
+void HybridSearchEngine::recordSemanticResults(const std::vector<SearchResult>& results) {
+    if (config_.semantic_index_capacity == 0 || results.empty()) {
+        return;
+    }
+
+    bool start = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(semantic_mutex_);
+        for (const auto& r : results) {
+            if (r.memory_id.empty()) continue;
+            auto& hot = hot_memories_[r.memory_id];
+            hot.result = r;
+            hot.result.lexical_score = 0.0;
+            hot.result.semantic_score = 0.0;
+            hot.result.combined_score = 0.0;
+            ++hot.returns;
+            if (!hot.requested && hot.returns >= config_.semantic_index_promote_after) {
+                hot.requested = true;
+                promotion_queue_.push_back(r.memory_id);
+            }
+        }
+
+        // Vieillissement : les souvenirs rarement rendus sortent du suivi
+        const size_t tracked = std::max<size_t>(config_.semantic_index_capacity, 64);
+        if (hot_memories_.size() > HOT_MEMORY_TRACKING_FACTOR * tracked) {
+            for (auto it = hot_memories_.begin(); it != hot_memories_.end();) {
+                it->second.returns /= 2;
+                if (it->second.returns == 0 && !semantic_index_.contains(it->first)) {
+                    it = hot_memories_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        if (!promotion_queue_.empty() && !promoting_) {
+            promoting_ = true;
+            start = true;
+        }
+    }
+
+    if (!start) {
+        return;
+    }
+
+    auto task = Executor::shared()->submit(TaskClass::BACKGROUND, [this]() { promoteHotMemories(); });
+    if (task.ready()) {
+        try {
+            task.get();
+        } catch (const std::exception& e) {
+            // File BACKGROUND pleine : nouvel essai au prochain retour Neo4j
+            log("Indexation sémantique différée: " + std::string(e.what()));
+            std::unique_lock<std::shared_mutex> lock(semantic_mutex_);
+            promoting_ = false;
+        }
+        return;
+    }
+    std::lock_guard<std::mutex> lock(promotion_mutex_);
+    promotion_ = std::move(task);
+}
+
+void HybridSearchEngine::promoteHotMemories() {
+    for (;;) {
+        std::vector<std::string> batch;
+        {
+            std::unique_lock<std::shared_mutex> lock(semantic_mutex_);
+            if (promotion_queue_.empty()) {
+                promoting_ = false;
+                return;
+            }
+            const size_t n = std::min(promotion_queue_.size(), PROMOTION_BATCH);
+            batch.assign(std::make_move_iterator(promotion_queue_.end() - n),
+                         std::make_move_iterator(promotion_queue_.end()));
+            promotion_queue_.resize(promotion_queue_.size() - n);
+        }
+
+        // Un aller-retour par lot, hors du chemin des recherches
+        std::vector<std::pair<std::string, std::vector<double>>> embeddings;
+        if (neo4j_ && neo4j_->isConnected()) {
+            const std::string cypher = R"(
+                MATCH (m:Memory)
+                WHERE m.id IN $ids AND m.embedding IS NOT NULL
+                RETURN m.id as memory_id, m.embedding as embedding
+            )";
+            json params;
+            params["ids"] = batch;
+            try {
+                json result = neo4j_->executeCypher(cypher, params);
+                if (result.contains("records")) {
+                    for (const auto& record : result["records"]) {
+                        if (!record.contains("embedding") || !record["embedding"].is_array()) continue;
+                        embeddings.emplace_back(record.value("memory_id", ""),
+                                                record["embedding"].get<std::vector<double>>());
+                    }
+                }
+            } catch (const std::exception& e) {
+                log("Erreur indexation sémantique: " + std::string(e.what()));
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(semantic_mutex_);
+        for (const auto& [id, embedding] : embeddings) {
+            if (hot_memories_.find(id) == hot_memories_.end()) continue;
+
+            // Index plein : le souvenir indexé le moins souvent rendu cède sa place
+            if (!semantic_index_.contains(id) &&
+                semantic_index_.size() >= config_.semantic_index_capacity) {
+                auto coldest = hot_memories_.end();
+                for (auto it = hot_memories_.begin(); it != hot_memories_.end(); ++it) {
+                    if (semantic_index_.contains(it->first) &&
+                        (coldest == hot_memories_.end() || it->second.returns < coldest->second.returns)) {
+                        coldest = it;
+                    }
+                }
+                if (coldest == hot_memories_.end()) break;
+                semantic_index_.erase(coldest->first);
+                coldest->second.requested = false;
+            }
+            semantic_index_.upsert(id, embedding);
+        }
+    }
+}
+
+std::vector<double> HybridSearchEngine::resolveEmbedding(
+    const std::string& question,
+    const std::vector<std::string>& lemmas,
+    uint64_t lemmas_key,
+    const std::vector<double>& embedding) {
+
+    if (!config_.enable_embedding_cache || (question.empty() && lemmas.empty())) {
+        return embedding;
+    }
+
+    const std::string normalized = LLMResponseCache::normalizeQuestion(question);
+    const uint64_t text_key = hashCombine(EMBEDDING_TEXT_SEED, std::hash<std::string>{}(normalized));
+    const uint64_t lemma_key = hashCombine(EMBEDDING_LEMMAS_SEED, lemmas_key);
+
+    if (!embedding.empty()) {
+        auto stored = std::make_shared<const QuantizedEmbedding>(
+            QuantizedEmbedding::encode(embedding, config_.embedding_quantization));
+        if (!normalized.empty()) embedding_cache_.put(text_key, stored, stored->bytes());
+        if (!lemmas.empty()) embedding_cache_.put(lemma_key, stored, stored->bytes());
+        return embedding;
+    }
+
+    const auto ttl = std::chrono::seconds(config_.embedding_cache_ttl_seconds);
+    ShardedLRUCache<QuantizedEmbedding>::ValuePtr cached;
+    if (!normalized.empty()) cached = embedding_cache_.get(text_key, ttl);
+    if (!cached && !lemmas.empty()) cached = embedding_cache_.get(lemma_key, ttl);
+    if (!cached) {
+        return {};
+    }
+
+    log("Embedding depuis cache (" + std::string(quantizationName(cached->mode())) + ")");
+    return cached->decode();
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // FUSION DES RÉSULTATS
 // ═══════════════════════════════════════════════════════════════════════════
 
+std::optional<std::vector<SearchResult>> HybridSearchEngine::awaitBranch(
+    TaskFuture<std::vector<SearchResult>>& branch,
+    std::chrono::steady_clock::time_point deadline,
+    const char* name) {
+
+    if (branch.waitUntil(deadline)) {
+        try {
+            return branch.get();
+        } catch (const std::exception& e) {
+            log(std::string("Erreur branche ") + name + ": " + e.what());
+            return std::vector<SearchResult>{};
+        }
+    }
+
+    log(std::string("Branche ") + name + " hors délai, résultats partiels");
+    std::lock_guard<std::mutex> lock(stragglers_mutex_);
+    stragglers_.push_back(std::move(branch));
+    return std::nullopt;
+}
+
+void HybridSearchEngine::reapStragglers() {
+    std::lock_guard<std::mutex> lock(stragglers_mutex_);
+    std::erase_if(stragglers_, [](const TaskFuture<std::vector<SearchResult>>& f) {
+        return f.ready();
+    });
+}
+
 std::vector<SearchResult> HybridSearchEngine::mergeResults(
     const std::vector<SearchResult>& lexical_results,
     const std::vector<SearchResult>& semantic_results,
@@ -659,35 +1010,69 @@ LLMContext HybridSearchEngine::buildContext(
 // CACHE
 // ═══════════════════════════════════════════════════════════════════════════
 
-std::string HybridSearchEngine::generateCacheKey(
-    const std::vector<std::string>& lemmas) const {
-
-    // Hash simple des lemmas triés
-    std::vector<std::string> sorted_lemmas = lemmas;
-    std::sort(sorted_lemmas.begin(), sorted_lemmas.end());
-
-    std::ostringstream oss;
-    for (const auto& l : sorted_lemmas) {
-        oss << l << "|";
+uint64_t HybridSearchEngine::hashLemmas(const std::vector<std::string>& lemmas) const {
+    // Somme et XOR d'empreintes : commutatifs, donc indépendants de l'ordre
+    // sans copie ni tri des chaînes
+    std::hash<std::string_view> hasher;
+    uint64_t sum = 0;
+    uint64_t mix = 0;
+    for (const auto& l : lemmas) {
+        uint64_t h = hashCombine(0, hasher(l));
+        sum += h;
+        mix ^= h * 0xff51afd7ed558ccdULL;
     }
+    return hashCombine(hashCombine(sum, mix), lemmas.size());
+}
 
-    // Hash basique
-    std::hash<std::string> hasher;
-    return std::to_string(hasher(oss.str()));
+uint64_t HybridSearchEngine::hashEmbedding(const std::vector<double>& embedding) const {
+    std::hash<std::string_view> hasher;
+    std::string_view bytes(reinterpret_cast<const char*>(embedding.data()),
+                           embedding.size() * sizeof(double));
+    return hashCombine(hasher(bytes), embedding.size());
 }
 
-bool HybridSearchEngine::isCacheValid(const std::string& key) const {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
+size_t HybridSearchEngine::estimateBytes(const SearchResponse& response) {
+    size_t bytes = sizeof(SearchResponse);
 
-    auto it = cache_.find(key);
-    if (it == cache_.end()) {
-        return false;
+    for (const auto& r : response.results) {
+        bytes += sizeof(SearchResult) + r.memory_id.capacity() + r.memory_name.capacity()
+               + r.dominant_emotion.capacity() + r.last_activated.capacity();
+        for (const auto& k : r.keywords) {
+            bytes += sizeof(std::string) + k.capacity();
+        }
     }
 
-    auto age = std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::steady_clock::now() - it->second.second).count();
+    const auto& ctx = response.context;
+    bytes += ctx.emotions.size() * sizeof(EmotionScore);
+    for (const auto& e : ctx.emotions) {
+        bytes += e.name.capacity() + e.trigger.capacity();
+    }
+    for (const auto& w : ctx.context_words) {
+        bytes += sizeof(std::string) + w.capacity();
+    }
+    for (const auto& m : ctx.activated_memories) {
+        bytes += sizeof(std::string) + m.capacity();
+    }
+
+    return bytes;
+}
 
-    return age < config_.cache_ttl_seconds;
+CacheStats HybridSearchEngine::getCacheStats() const {
+    CacheStats stats = cache_.stats();
+    stats.coalesced = lexical_flight_.coalesced() + semantic_flight_.coalesced();
+    return stats;
+}
+
+MemoryIndexStats HybridSearchEngine::getSemanticIndexStats() const {
+    MemoryIndexStats stats;
+    {
+        std::shared_lock<std::shared_mutex> lock(semantic_mutex_);
+        stats.indexed = semantic_index_.size();
+    }
+    stats.queries = semantic_queries_.load(std::memory_order_relaxed);
+    stats.local_hits = semantic_local_hits_.load(std::memory_order_relaxed);
+    stats.neo4j_fallbacks = semantic_fallbacks_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -696,7 +1081,7 @@ bool HybridSearchEngine::isCacheValid(const std::string& key) const {
 
 void HybridSearchEngine::log(const std::string& message) const {
     if (config_.verbose) {
-        std::cout << "[HybridSearch] " << message << std::endl;
+        MCEE_LOG_INFO("HybridSearch", message);
     }
 }
 
@@ -0,0 +1,295 @@
+/**
+ * @file JsonScanner.cpp
+ * @brief Implémentation du lecteur JSON à la demande
+ */
+
+#include "JsonScanner.hpp"
+#include <charconv>
+#include <cstdint>
+
+namespace mcee {
+
+namespace {
+
+int hexDigit(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+bool isDelimiter(char c) noexcept {
+    return c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CURSEUR
+// ═══════════════════════════════════════════════════════════════════════════
+
+void JsonScanner::skipSpaces() noexcept {
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        ++pos_;
+    }
+}
+
+char JsonScanner::peekChar() {
+    skipSpaces();
+    if (pos_ >= text_.size()) fail("fin de document inattendue");
+    return text_[pos_];
+}
+
+void JsonScanner::expect(char c) {
+    if (peekChar() != c) fail(std::string("'") + c + "' attendu");
+    ++pos_;
+}
+
+void JsonScanner::fail(std::string_view what) const {
+    throw JsonScanError("JSON invalide (octet " + std::to_string(pos_) + "): " + std::string(what));
+}
+
+JsonType JsonScanner::peek() {
+    skipSpaces();
+    if (pos_ >= text_.size()) return JsonType::END;
+    switch (text_[pos_]) {
+        case '{': return JsonType::OBJECT;
+        case '[': return JsonType::ARRAY;
+        case '"': return JsonType::STRING;
+        case 't': case 'f': return JsonType::BOOLEAN;
+        case 'n': return JsonType::NUL;
+        default: return JsonType::NUMBER;
+    }
+}
+
+void JsonScanner::expectEnd() {
+    skipSpaces();
+    if (pos_ != text_.size()) fail("données après la fin du document");
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CONTENEURS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void JsonScanner::enter() {
+    if (++depth_ > MAX_DEPTH) fail("imbrication trop profonde");
+    first_in_container_ = true;
+}
+
+void JsonScanner::beginObject() {
+    expect('{');
+    enter();
+}
+
+bool JsonScanner::nextField(std::string_view& key) {
+    if (peekChar() == '}') {
+        ++pos_;
+        --depth_;
+        first_in_container_ = false;
+        return false;
+    }
+    if (!first_in_container_) expect(',');
+    first_in_container_ = false;
+
+    if (peekChar() != '"') fail("clé attendue");
+    key = readString(key_scratch_);
+    expect(':');
+    return true;
+}
+
+void JsonScanner::beginArray() {
+    expect('[');
+    enter();
+}
+
+bool JsonScanner::nextElement() {
+    if (peekChar() == ']') {
+        ++pos_;
+        --depth_;
+        first_in_container_ = false;
+        return false;
+    }
+    if (!first_in_container_) expect(',');
+    first_in_container_ = false;
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VALEURS
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t JsonScanner::scanString(bool& escaped) const {
+    escaped = false;
+    size_t i = pos_ + 1;
+    while (i < text_.size()) {
+        char c = text_[i];
+        if (c == '"') return i + 1;
+        if (c == '\\') {
+            escaped = true;
+            i += 2;
+            continue;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) break;
+        ++i;
+    }
+    fail("chaîne non terminée");
+}
+
+void JsonScanner::decodeString(size_t begin, size_t end, std::string& out) const {
+    out.clear();
+    out.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        char c = text_[i];
+        if (c != '\\') {
+            out.push_back(c);
+            continue;
+        }
+        char e = text_[++i];
+        switch (e) {
+            case '"': case '\\': case '/': out.push_back(e); break;
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                auto readHex = [&](size_t at) -> uint32_t {
+                    if (at + 4 > end) fail("échappement \\u tronqué");
+                    uint32_t v = 0;
+                    for (size_t k = at; k < at + 4; ++k) {
+                        int d = hexDigit(text_[k]);
+                        if (d < 0) fail("échappement \\u invalide");
+                        v = (v << 4) | static_cast<uint32_t>(d);
+                    }
+                    return v;
+                };
+                uint32_t cp = readHex(i + 1);
+                i += 4;
+                // Paire de substitution UTF-16
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < end && text_[i + 1] == '\\' && text_[i + 2] == 'u') {
+                    uint32_t low = readHex(i + 3);
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                fail("échappement invalide");
+        }
+    }
+}
+
+std::string_view JsonScanner::readString(std::string& scratch) {
+    if (peekChar() != '"') fail("chaîne attendue");
+    bool escaped = false;
+    size_t end = scanString(escaped);
+    size_t begin = pos_ + 1;
+    pos_ = end;
+    if (!escaped) {
+        return text_.substr(begin, end - 1 - begin);
+    }
+    decodeString(begin, end - 1, scratch);
+    return scratch;
+}
+
+double JsonScanner::readNumber() {
+    // from_chars accepterait aussi inf et nan
+    size_t digit = peekChar() == '-' ? pos_ + 1 : pos_;
+    if (digit >= text_.size() || text_[digit] < '0' || text_[digit] > '9') fail("nombre attendu");
+
+    double value = 0.0;
+    const char* first = text_.data() + pos_;
+    const char* last = text_.data() + text_.size();
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc() || (ptr < last && !isDelimiter(*ptr))) fail("nombre invalide");
+    pos_ += static_cast<size_t>(ptr - first);
+    return value;
+}
+
+void JsonScanner::skipLiteral(std::string_view literal) {
+    if (text_.substr(pos_, literal.size()) != literal) fail("littéral invalide");
+    pos_ += literal.size();
+    if (pos_ < text_.size() && !isDelimiter(text_[pos_])) fail("littéral invalide");
+}
+
+bool JsonScanner::readBool() {
+    char c = peekChar();
+    if (c == 't') {
+        skipLiteral("true");
+        return true;
+    }
+    if (c == 'f') {
+        skipLiteral("false");
+        return false;
+    }
+    fail("booléen attendu");
+}
+
+bool JsonScanner::readNull() {
+    if (peekChar() != 'n') return false;
+    skipLiteral("null");
+    return true;
+}
+
+void JsonScanner::skipValue() {
+    switch (peek()) {
+        case JsonType::STRING: {
+            bool escaped = false;
+            pos_ = scanString(escaped);
+            break;
+        }
+        case JsonType::NUMBER:
+            readNumber();
+            break;
+        case JsonType::BOOLEAN:
+            readBool();
+            break;
+        case JsonType::NUL:
+            readNull();
+            break;
+        case JsonType::OBJECT: {
+            beginObject();
+            std::string_view key;
+            while (nextField(key)) skipValue();
+            break;
+        }
+        case JsonType::ARRAY:
+            beginArray();
+            while (nextElement()) skipValue();
+            break;
+        case JsonType::END:
+            fail("valeur attendue");
+    }
+}
+
+std::string_view JsonScanner::captureValue() {
+    skipSpaces();
+    size_t begin = pos_;
+    skipValue();
+    return text_.substr(begin, pos_ - begin);
+}
+
+} // namespace mcee
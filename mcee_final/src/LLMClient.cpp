@@ -6,13 +6,18 @@
  */
 
 #include "LLMClient.hpp"
+#include "LLMResponseCache.hpp"
+#include "Logger.hpp"
 #include <curl/curl.h>
 #include <fstream>
-#include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <thread>
 #include <cmath>
+#include <algorithm>
+#include <string_view>
+#include <array>
+#include <cstdio>
 
 namespace mcee {
 
@@ -46,8 +51,195 @@ public:
 
 static CurlGlobalInit curlInit;
 
+/**
+ * @brief État d'un flux SSE en cours de réception
+ */
+struct StreamState {
+    LLMProvider provider = LLMProvider::OPENAI;
+    const LLMTokenCallback* on_token = nullptr;
+    std::chrono::steady_clock::time_point start;
+
+    std::string pending;        // Ligne SSE incomplète
+    std::string raw;            // Début du corps brut (diagnostic d'erreur HTTP)
+    std::string content;
+    std::string model;
+    std::string error;
+    int tokens_prompt = 0;
+    int tokens_completion = 0;
+    int tokens_total = 0;
+    double first_token_ms = 0.0;
+    bool done = false;
+};
+
+constexpr size_t MAX_RAW_BODY = 16 * 1024;
+
+void emitDelta(StreamState& st, const std::string& delta) {
+    if (delta.empty()) return;
+    if (st.content.empty()) {
+        st.first_token_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - st.start).count();
+    }
+    st.content += delta;
+    if (st.on_token && *st.on_token) {
+        (*st.on_token)(delta);
+    }
+}
+
+/**
+ * @brief Traite un événement "data:" (format OpenAI ou Anthropic)
+ */
+void handleSseEvent(StreamState& st, const json& j) {
+    if (j.contains("error")) {
+        const auto& err = j["error"];
+        st.error = err.is_object() ? err.value("message", err.dump()) : err.dump();
+        return;
+    }
+
+    if (st.provider == LLMProvider::ANTHROPIC) {
+        std::string type = j.value("type", "");
+        if (type == "content_block_delta" && j.contains("delta")) {
+            emitDelta(st, j["delta"].value("text", ""));
+        } else if (type == "message_start" && j.contains("message")) {
+            const auto& msg = j["message"];
+            st.model = msg.value("model", st.model);
+            if (msg.contains("usage")) {
+                st.tokens_prompt = msg["usage"].value("input_tokens", 0);
+            }
+        } else if (type == "message_delta" && j.contains("usage")) {
+            st.tokens_completion = j["usage"].value("output_tokens", 0);
+        } else if (type == "message_stop") {
+            st.done = true;
+        }
+        return;
+    }
+
+    // OpenAI et serveurs compatibles (Ollama, vLLM)
+    st.model = j.value("model", st.model);
+    if (j.contains("choices") && j["choices"].is_array() && !j["choices"].empty()) {
+        const auto& choice = j["choices"][0];
+        if (choice.contains("delta") && choice["delta"].contains("content") &&
+            choice["delta"]["content"].is_string()) {
+            emitDelta(st, choice["delta"]["content"].get<std::string>());
+        }
+    }
+    if (j.contains("usage") && j["usage"].is_object()) {
+        st.tokens_prompt = j["usage"].value("prompt_tokens", 0);
+        st.tokens_completion = j["usage"].value("completion_tokens", 0);
+        st.tokens_total = j["usage"].value("total_tokens", 0);
+    }
+}
+
+void handleSseLine(StreamState& st, std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    if (line.substr(0, 5) != "data:") {
+        return;  // "event:", commentaires ":" et séparateurs
+    }
+    line.remove_prefix(5);
+    while (!line.empty() && line.front() == ' ') {
+        line.remove_prefix(1);
+    }
+
+    if (line == "[DONE]") {
+        st.done = true;
+        return;
+    }
+
+    json j = json::parse(line, nullptr, false);
+    if (!j.is_discarded()) {
+        handleSseEvent(st, j);
+    }
+}
+
+/**
+ * @brief Callback CURL du mode streaming : découpe le flux en lignes SSE
+ */
+size_t curlStreamCallback(void* contents, size_t size, size_t nmemb, StreamState* st) {
+    size_t realsize = size * nmemb;
+    const char* data = static_cast<const char*>(contents);
+
+    if (st->raw.size() < MAX_RAW_BODY) {
+        st->raw.append(data, std::min(realsize, MAX_RAW_BODY - st->raw.size()));
+    }
+
+    try {
+        st->pending.append(data, realsize);
+        size_t begin = 0;
+        size_t nl;
+        while ((nl = st->pending.find('\n', begin)) != std::string::npos) {
+            handleSseLine(*st, std::string_view(st->pending).substr(begin, nl - begin));
+            begin = nl + 1;
+        }
+        st->pending.erase(0, begin);
+    } catch (const std::exception& e) {
+        st->error = std::string("Erreur callback streaming: ") + e.what();
+        return 0;  // Interrompt le transfert (CURLE_WRITE_ERROR)
+    }
+
+    return realsize;
+}
+
 } // namespace anonyme
 
+// ═══════════════════════════════════════════════════════════════════════════
+// GABARIT DU PROMPT UTILISATEUR
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+enum UserPromptSlot : size_t {
+    SLOT_QUESTION,
+    SLOT_FT,
+    SLOT_SENTIMENT,
+    SLOT_CT,
+    SLOT_DOMINANT,
+    SLOT_DOMINANT_PCT,
+    SLOT_OTHER_EMOTIONS,
+    SLOT_KEYWORDS,
+    SLOT_MEMORIES,
+    SLOT_COUNT
+};
+
+const std::vector<std::string> USER_PROMPT_SLOTS = {
+    "question", "ft", "sentiment", "ct", "dominant", "dominant_pct",
+    "other_emotions", "keywords", "memories"
+};
+
+constexpr const char* DEFAULT_USER_PROMPT =
+    "Contexte émotionnel détecté:\n"
+    "- Fond affectif (Ft): {{ft}} ({{sentiment}})\n"
+    "- Niveau de conscience (Ct): {{ct}}\n"
+    "{{#dominant}}- Émotion dominante: {{dominant}} ({{dominant_pct}}%)\n{{/dominant}}"
+    "{{#other_emotions}}- Autres émotions: {{other_emotions}}\n{{/other_emotions}}"
+    "{{#keywords}}- Mots-clés du contexte: {{keywords}}\n{{/keywords}}"
+    "{{#memories}}- Souvenirs activés: {{memories}}\n{{/memories}}"
+    "\nQuestion de l'utilisateur: {{question}}";
+
+/**
+ * @brief Tampons de rendu d'un thread (valeurs formatées, messages)
+ */
+struct PromptScratch {
+    char ft[32];
+    char ct[32];
+    char dominant_pct[16];
+    std::string other_emotions;
+    std::string keywords;
+    std::string memories;
+    std::vector<ChatMessage> messages;
+};
+
+PromptScratch& promptScratch() {
+    thread_local PromptScratch scratch;
+    return scratch;
+}
+
+void formatPercent(char* out, size_t size, double score) {
+    std::snprintf(out, size, "%d", static_cast<int>(score * 100));
+}
+
+} // namespace
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONFIGURATION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -97,10 +289,31 @@ bool LLMClientConfig::loadFromJson(const std::string& path) {
                 system_prompt = llm["system_prompt"];
             }
 
+            if (llm.contains("user_prompt_template")) {
+                user_prompt_template = llm["user_prompt_template"];
+            }
+
+            if (llm.contains("cache")) {
+                const auto& cache = llm["cache"];
+                if (cache.contains("enabled")) enable_response_cache = cache["enabled"];
+                if (cache.contains("ttl_seconds")) response_cache_ttl_seconds = cache["ttl_seconds"];
+                if (cache.contains("max_bytes")) response_cache_max_bytes = cache["max_bytes"];
+                if (cache.contains("similarity_threshold")) response_cache_similarity = cache["similarity_threshold"];
+            }
+
             if (llm.contains("verbose")) {
                 verbose = llm["verbose"];
             }
 
+            if (llm.contains("transport")) {
+                const auto& tr = llm["transport"];
+                if (tr.contains("http_pool_size")) http_pool_size = tr["http_pool_size"];
+                if (tr.contains("enable_http2")) enable_http2 = tr["enable_http2"];
+                if (tr.contains("connect_timeout_ms")) connect_timeout_ms = tr["connect_timeout_ms"];
+                if (tr.contains("worker_threads")) worker_threads = tr["worker_threads"];
+                if (tr.contains("max_pending_requests")) max_pending_requests = tr["max_pending_requests"];
+            }
+
             if (llm.contains("resilience")) {
                 const auto& res = llm["resilience"];
                 if (res.contains("max_retries")) max_retries = res["max_retries"];
@@ -112,7 +325,7 @@ bool LLMClientConfig::loadFromJson(const std::string& path) {
 
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "[LLMClient] Erreur chargement config: " << e.what() << std::endl;
+        MCEE_LOG_ERROR("LLMClient", "Erreur chargement config: ", e.what());
         return false;
     }
 }
@@ -124,6 +337,23 @@ bool LLMClientConfig::loadFromJson(const std::string& path) {
 LLMClient::LLMClient(const LLMClientConfig& config)
     : config_(config) {
     config_.loadFromEnvironment();
+    lane_.setLimits(config_.worker_threads, config_.max_pending_requests);
+
+    if (!config_.user_prompt_template.empty()) {
+        std::string error;
+        if (auto tpl = PromptTemplate::compile(config_.user_prompt_template, USER_PROMPT_SLOTS, &error)) {
+            user_template_ = std::move(*tpl);
+        } else {
+            MCEE_LOG_ERROR("LLMClient", "Gabarit de prompt invalide (", error, "), gabarit par défaut");
+        }
+    }
+    if (user_template_.empty()) {
+        user_template_ = *PromptTemplate::compile(DEFAULT_USER_PROMPT, USER_PROMPT_SLOTS);
+    }
+
+    if (config_.enable_response_cache) {
+        response_cache_ = std::make_unique<LLMResponseCache>(config_.response_cache_max_bytes);
+    }
 }
 
 LLMClient::~LLMClient() {
@@ -140,8 +370,8 @@ bool LLMClient::initialize() {
     // Validation de la clé API (mode HTTP direct)
     if (config_.mode == LLMMode::DIRECT_HTTP) {
         if (config_.api_key.empty()) {
-            std::cerr << "[LLMClient] ERREUR: Clé API manquante. "
-                      << "Définissez OPENAI_API_KEY ou config.api_key" << std::endl;
+            MCEE_LOG_ERROR("LLMClient",
+                "ERREUR: Clé API manquante. ", "Définissez OPENAI_API_KEY ou config.api_key");
             return false;
         }
         log("Mode DIRECT_HTTP configuré avec modèle: " + config_.model);
@@ -150,12 +380,14 @@ bool LLMClient::initialize() {
     // Connexion RabbitMQ (mode RabbitMQ)
     if (config_.mode == LLMMode::RABBITMQ) {
         if (!initRabbitMQ()) {
-            std::cerr << "[LLMClient] ERREUR: Connexion RabbitMQ échouée" << std::endl;
+            MCEE_LOG_ERROR("LLMClient", "ERREUR: Connexion RabbitMQ échouée");
             return false;
         }
         log("Mode RABBITMQ configuré");
     }
 
+    lane_.open();
+
     ready_.store(true);
     log("LLMClient initialisé avec succès");
     return true;
@@ -217,7 +449,7 @@ bool LLMClient::initRabbitMQ() {
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << "[LLMClient] Erreur RabbitMQ: " << e.what() << std::endl;
+        MCEE_LOG_ERROR("LLMClient", "Erreur RabbitMQ: ", e.what());
         return false;
     }
 }
@@ -225,6 +457,13 @@ bool LLMClient::initRabbitMQ() {
 void LLMClient::shutdown() {
     ready_.store(false);
 
+    // Les appels en cours se terminent ; ceux encore en file sont abandonnés
+    size_t dropped = lane_.close();
+    if (dropped > 0) {
+        log(std::to_string(dropped) + " requête(s) asynchrone(s) abandonnée(s) à l'arrêt");
+    }
+    releaseAllHandles();
+
     if (rabbitmq_connected_.load() && channel_) {
         try {
             channel_->BasicCancel(consumer_tag_);
@@ -240,7 +479,47 @@ void LLMClient::shutdown() {
 // ═══════════════════════════════════════════════════════════════════════════
 
 LLMResponse LLMClient::generate(const LLMRequest& request) {
+    return generateImpl(request, {});
+}
+
+LLMResponse LLMClient::generateStream(const LLMRequest& request, LLMTokenCallback on_token) {
+    return generateImpl(request, on_token);
+}
+
+LLMResponse LLMClient::generateImpl(const LLMRequest& request, const LLMTokenCallback& on_token) {
     auto start_time = std::chrono::steady_clock::now();
+
+    // Paramètres de génération
+    double temperature = request.temperature.value_or(config_.temperature);
+    int max_tokens = request.max_tokens.value_or(config_.max_tokens);
+
+    // Cache de réponses : un hit ne touche pas au réseau (ni au circuit breaker)
+    const bool use_cache = response_cache_ && !request.bypass_cache;
+    uint64_t cache_scope = 0;
+    uint64_t cache_key = 0;
+    if (use_cache) {
+        cache_scope = LLMResponseCache::scopeKey(request, temperature, max_tokens);
+        cache_key = LLMResponseCache::questionKey(cache_scope, request.user_question);
+        auto cached = response_cache_->find(cache_key, cache_scope, request.question_embedding,
+                                            std::chrono::seconds(config_.response_cache_ttl_seconds),
+                                            config_.response_cache_similarity);
+        if (cached) {
+            LLMResponse response = *cached;
+            response.from_cache = true;
+            response.tokens_prompt = response.tokens_completion = response.tokens_total = 0;
+            recordExchange(request.user_question, response.content);
+
+            response.generation_time_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start_time).count();
+            if (on_token) {
+                response.first_token_ms = response.generation_time_ms;
+                on_token(response.content);
+            }
+            log("Réponse servie par le cache");
+            return response;
+        }
+    }
+
     total_requests_++;
 
     // Vérifier le circuit breaker
@@ -251,12 +530,19 @@ LLMResponse LLMClient::generate(const LLMRequest& request) {
         return response;
     }
 
-    // Construire les messages
-    auto messages = buildMessages(request.user_question, request.emotional_context);
-
-    // Paramètres de génération
-    double temperature = request.temperature.value_or(config_.temperature);
-    int max_tokens = request.max_tokens.value_or(config_.max_tokens);
+    // Construire les messages (tampons du thread, réutilisés d'un appel à l'autre)
+    std::vector<ChatMessage>& messages = promptScratch().messages;
+    buildMessagesInto(request.user_question, request.emotional_context, messages);
+
+    // Relais de streaming : un flux déjà entamé n'est pas rejoué (tokens dupliqués)
+    bool emitted = false;
+    LLMTokenCallback relay;
+    if (on_token) {
+        relay = [&emitted, &on_token](const std::string& delta) {
+            emitted = true;
+            on_token(delta);
+        };
+    }
 
     // Appel avec retry
     LLMResponse response;
@@ -267,8 +553,9 @@ LLMResponse LLMClient::generate(const LLMRequest& request) {
         attempts++;
 
         try {
+            ScopedLatency call_timer(call_latency_);
             if (config_.mode == LLMMode::DIRECT_HTTP) {
-                response = callDirectHTTP(messages, temperature, max_tokens);
+                response = callDirectHTTP(messages, temperature, max_tokens, relay);
             } else {
                 response = callViaRabbitMQ(messages, temperature, max_tokens);
             }
@@ -282,6 +569,11 @@ LLMResponse LLMClient::generate(const LLMRequest& request) {
             response.error_message = e.what();
         }
 
+        if (emitted) {
+            log("Flux interrompu après le premier token, pas de nouvelle tentative");
+            break;
+        }
+
         // Retry avec exponential backoff
         if (attempts < config_.max_retries) {
             log("Tentative " + std::to_string(attempts) + " échouée, retry dans "
@@ -297,34 +589,61 @@ LLMResponse LLMClient::generate(const LLMRequest& request) {
         successful_requests_++;
         total_tokens_ += response.tokens_total;
 
-        // Ajouter à l'historique
-        ChatMessage user_msg{"user", request.user_question};
-        ChatMessage assistant_msg{"assistant", response.content};
-
-        std::lock_guard<std::mutex> lock(history_mutex_);
-        history_.push_back(user_msg);
-        history_.push_back(assistant_msg);
-
-        // Limiter l'historique
-        while (history_.size() > history_limit_ * 2) {
-            history_.erase(history_.begin());
+        if (use_cache) {
+            response_cache_->store(cache_key, cache_scope, request.question_embedding, response);
         }
+        recordExchange(request.user_question, response.content);
     }
 
     auto end_time = std::chrono::steady_clock::now();
     response.generation_time_ms = std::chrono::duration<double, std::milli>(
         end_time - start_time).count();
 
+    // RabbitMQ : pas de flux côté service, la réponse complète forme un seul fragment
+    if (on_token && response.success && !emitted) {
+        response.first_token_ms = response.generation_time_ms;
+        on_token(response.content);
+    }
+
     return response;
 }
 
 void LLMClient::generateAsync(const LLMRequest& request, LLMResponseCallback callback) {
-    std::thread([this, request, callback]() {
-        auto response = generate(request);
+    generateStreamAsync(request, {}, std::move(callback));
+}
+
+void LLMClient::generateStreamAsync(const LLMRequest& request,
+                                    LLMTokenCallback on_token,
+                                    LLMResponseCallback callback) {
+    bool queued = post([this, request, on_token, callback]() {
+        auto response = on_token ? generateStream(request, on_token) : generate(request);
         if (callback) {
             callback(response);
         }
-    }).detach();
+    });
+
+    if (!queued && callback) {
+        LLMResponse response;
+        response.success = false;
+        response.error_message = "File d'attente LLM pleine ou client arrêté";
+        callback(response);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// EXÉCUTION ASYNCHRONE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool LLMClient::post(std::function<void()> task) {
+    if (lane_.post(std::move(task))) {
+        return true;
+    }
+    rejected_requests_++;
+    return false;
+}
+
+size_t LLMClient::getPendingRequests() const {
+    return lane_.pending();
 }
 
 std::string LLMClient::reformulate(const std::string& question, const LLMContext& context) {
@@ -347,91 +666,150 @@ std::string LLMClient::reformulate(const std::string& question, const LLMContext
 // ═══════════════════════════════════════════════════════════════════════════
 
 std::string LLMClient::buildUserPrompt(const std::string& question, const LLMContext& context) const {
-    std::ostringstream oss;
+    std::string prompt;
+    renderUserPrompt(question, context, prompt);
+    return prompt;
+}
 
-    oss << "Contexte émotionnel détecté:\n";
+void LLMClient::renderUserPrompt(const std::string& question, const LLMContext& context,
+                                 std::string& out) const {
+    PromptScratch& scratch = promptScratch();
+    std::array<std::string_view, SLOT_COUNT> values{};
 
-    // Sentiment global (Ft)
-    oss << "- Fond affectif (Ft): " << std::fixed << std::setprecision(2)
-        << context.Ft << " (" << context.sentiment_label << ")\n";
+    auto join = [](std::string& buffer, const auto& items, size_t first, size_t limit, auto&& append) {
+        buffer.clear();
+        for (size_t i = first; i < std::min(items.size(), limit); ++i) {
+            if (i > first) buffer += ", ";
+            append(buffer, items[i]);
+        }
+        return std::string_view(buffer);
+    };
+
+    std::snprintf(scratch.ft, sizeof(scratch.ft), "%.2f", context.Ft);
+    std::snprintf(scratch.ct, sizeof(scratch.ct), "%.2f", context.Ct);
+    formatPercent(scratch.dominant_pct, sizeof(scratch.dominant_pct), context.dominant_score);
+
+    values[SLOT_QUESTION] = question;
+    values[SLOT_FT] = scratch.ft;
+    values[SLOT_SENTIMENT] = context.sentiment_label;
+    values[SLOT_CT] = scratch.ct;
+    values[SLOT_DOMINANT] = context.dominant_emotion;
+    values[SLOT_DOMINANT_PCT] = scratch.dominant_pct;
+
+    // Émotions secondaires : 2e et 3e du contexte
+    values[SLOT_OTHER_EMOTIONS] = join(scratch.other_emotions, context.emotions, 1, 3,
+        [](std::string& buffer, const EmotionScore& e) {
+            char pct[16];
+            formatPercent(pct, sizeof(pct), e.score);
+            buffer.append(e.name).append(" (").append(pct).append("%)");
+        });
+    values[SLOT_KEYWORDS] = join(scratch.keywords, context.context_words, 0, 5,
+        [](std::string& buffer, const std::string& w) { buffer += w; });
+    values[SLOT_MEMORIES] = join(scratch.memories, context.activated_memories, 0, 3,
+        [](std::string& buffer, const std::string& m) { buffer += m; });
+
+    user_template_.render(values, out);
+}
 
-    // Niveau de conscience (Ct)
-    oss << "- Niveau de conscience (Ct): " << std::fixed << std::setprecision(2)
-        << context.Ct << "\n";
+std::vector<ChatMessage> LLMClient::buildMessages(const std::string& question, const LLMContext& context) const {
+    std::vector<ChatMessage> messages;
+    buildMessagesInto(question, context, messages);
+    return messages;
+}
 
-    // Émotion dominante
-    if (!context.dominant_emotion.empty()) {
-        oss << "- Émotion dominante: " << context.dominant_emotion
-            << " (" << static_cast<int>(context.dominant_score * 100) << "%)\n";
-    }
+void LLMClient::buildMessagesInto(const std::string& question, const LLMContext& context,
+                                  std::vector<ChatMessage>& out) const {
+    // Affectations élément par élément : les chaînes gardent leur capacité
+    {
+        std::lock_guard<std::mutex> lock(history_mutex_);
+        out.resize(history_.size() + 2);
+
+        // Message système
+        out[0].role = "system";
+        out[0].content = config_.system_prompt;
 
-    // Autres émotions significatives
-    if (context.emotions.size() > 1) {
-        oss << "- Autres émotions: ";
-        for (size_t i = 1; i < std::min(context.emotions.size(), size_t(3)); ++i) {
-            if (i > 1) oss << ", ";
-            oss << context.emotions[i].name
-                << " (" << static_cast<int>(context.emotions[i].score * 100) << "%)";
+        // Historique (si présent)
+        for (size_t i = 0; i < history_.size(); ++i) {
+            out[i + 1].role = history_[i].role;
+            out[i + 1].content = history_[i].content;
         }
-        oss << "\n";
     }
 
-    // Mots-clés contextuels
-    if (!context.context_words.empty()) {
-        oss << "- Mots-clés du contexte: ";
-        for (size_t i = 0; i < std::min(context.context_words.size(), size_t(5)); ++i) {
-            if (i > 0) oss << ", ";
-            oss << context.context_words[i];
-        }
-        oss << "\n";
+    // Message utilisateur avec contexte
+    out.back().role = "user";
+    renderUserPrompt(question, context, out.back().content);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// APPELS API
+// ═══════════════════════════════════════════════════════════════════════════
+
+json LLMClient::buildRequestBody(const std::vector<ChatMessage>& messages,
+                                double temperature, int max_tokens, bool stream) const {
+    json request_body;
+    request_body["model"] = config_.model;
+    request_body["temperature"] = temperature;
+    request_body["max_tokens"] = max_tokens;
+
+    request_body["messages"] = json::array();
+    for (const auto& msg : messages) {
+        request_body["messages"].push_back(msg.toJson());
     }
 
-    // Souvenirs activés
-    if (!context.activated_memories.empty()) {
-        oss << "- Souvenirs activés: ";
-        for (size_t i = 0; i < std::min(context.activated_memories.size(), size_t(3)); ++i) {
-            if (i > 0) oss << ", ";
-            oss << context.activated_memories[i];
+    if (stream) {
+        request_body["stream"] = true;
+        if (config_.provider == LLMProvider::OPENAI) {
+            // Usage transmis dans le dernier chunk du flux
+            request_body["stream_options"] = {{"include_usage", true}};
         }
-        oss << "\n";
     }
 
-    oss << "\nQuestion de l'utilisateur: " << question;
-
-    return oss.str();
+    return request_body;
 }
 
-std::vector<ChatMessage> LLMClient::buildMessages(const std::string& question, const LLMContext& context) const {
-    std::vector<ChatMessage> messages;
-
-    // Message système
-    messages.push_back({"system", config_.system_prompt});
-
-    // Historique (si présent)
+void* LLMClient::acquireHandle() {
     {
-        std::lock_guard<std::mutex> lock(history_mutex_);
-        for (const auto& msg : history_) {
-            messages.push_back(msg);
+        std::lock_guard<std::mutex> lock(handles_mutex_);
+        if (!idle_handles_.empty()) {
+            void* handle = idle_handles_.back();
+            idle_handles_.pop_back();
+            return handle;
         }
     }
+    return curl_easy_init();
+}
 
-    // Message utilisateur avec contexte
-    std::string user_prompt = buildUserPrompt(question, context);
-    messages.push_back({"user", user_prompt});
+void LLMClient::releaseHandle(void* handle) {
+    if (!handle) return;
 
-    return messages;
+    // reset conserve le cache de connexions et les sessions TLS du handle
+    curl_easy_reset(handle);
+
+    std::lock_guard<std::mutex> lock(handles_mutex_);
+    if (idle_handles_.size() < config_.http_pool_size) {
+        idle_handles_.push_back(handle);
+    } else {
+        curl_easy_cleanup(handle);
+    }
 }
 
-// ═══════════════════════════════════════════════════════════════════════════
-// APPELS API
-// ═══════════════════════════════════════════════════════════════════════════
+void LLMClient::releaseAllHandles() {
+    std::lock_guard<std::mutex> lock(handles_mutex_);
+    for (void* handle : idle_handles_) {
+        curl_easy_cleanup(handle);
+    }
+    idle_handles_.clear();
+}
 
 LLMResponse LLMClient::callDirectHTTP(const std::vector<ChatMessage>& messages,
-                                       double temperature, int max_tokens) {
+                                       double temperature, int max_tokens,
+                                       const LLMTokenCallback& on_token) {
     LLMResponse response;
     response.model_used = config_.model;
 
-    CURL* curl = curl_easy_init();
+    const bool streaming = static_cast<bool>(on_token);
+
+    CURL* curl = acquireHandle();
     if (!curl) {
         response.success = false;
         response.error_message = "Échec initialisation CURL";
@@ -439,36 +817,48 @@ LLMResponse LLMClient::callDirectHTTP(const std::vector<ChatMessage>& messages,
     }
 
     // Construire le body JSON
-    json request_body;
-    request_body["model"] = config_.model;
-    request_body["temperature"] = temperature;
-    request_body["max_tokens"] = max_tokens;
-
-    request_body["messages"] = json::array();
-    for (const auto& msg : messages) {
-        request_body["messages"].push_back(msg.toJson());
-    }
-
-    std::string body_str = request_body.dump();
+    std::string body_str = buildRequestBody(messages, temperature, max_tokens, streaming).dump();
     std::string response_str;
 
+    StreamState stream_state;
+    stream_state.provider = config_.provider;
+    stream_state.on_token = &on_token;
+    stream_state.model = config_.model;
+    stream_state.start = std::chrono::steady_clock::now();
+
     // Headers
     struct curl_slist* headers = nullptr;
     headers = curl_slist_append(headers, "Content-Type: application/json");
     std::string auth_header = "Authorization: Bearer " + config_.api_key;
     headers = curl_slist_append(headers, auth_header.c_str());
+    if (streaming) {
+        headers = curl_slist_append(headers, "Accept: text/event-stream");
+    }
 
-    // Configuration CURL
+    // Configuration CURL (le handle est réinitialisé à chaque emprunt)
     curl_easy_setopt(curl, CURLOPT_URL, config_.api_url.c_str());
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body_str.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_str);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, config_.timeout_seconds);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(body_str.size()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(config_.timeout_seconds));
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(config_.connect_timeout_ms));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    if (config_.enable_http2) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+    }
+
+    if (streaming) {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlStreamCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &stream_state);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlWriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_str);
+    }
 
     // Log requête (mode verbose)
     if (config_.verbose) {
-        log("Appel API " + config_.model + "...");
+        log(std::string(streaming ? "Appel API (stream) " : "Appel API ") + config_.model + "...");
     }
 
     // Exécuter la requête
@@ -478,17 +868,39 @@ LLMResponse LLMClient::callDirectHTTP(const std::vector<ChatMessage>& messages,
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
 
     curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    releaseHandle(curl);
 
     if (res != CURLE_OK) {
         response.success = false;
-        response.error_message = std::string("CURL error: ") + curl_easy_strerror(res);
+        response.error_message = !stream_state.error.empty()
+            ? stream_state.error
+            : std::string("CURL error: ") + curl_easy_strerror(res);
         return response;
     }
 
     if (http_code != 200) {
         response.success = false;
-        response.error_message = "HTTP " + std::to_string(http_code) + ": " + response_str;
+        response.error_message = "HTTP " + std::to_string(http_code) + ": "
+            + (streaming ? stream_state.raw : response_str);
+        return response;
+    }
+
+    if (streaming) {
+        // Dernière ligne sans saut de ligne final
+        if (!stream_state.pending.empty()) {
+            handleSseLine(stream_state, stream_state.pending);
+        }
+
+        response.success = stream_state.error.empty();
+        response.error_message = stream_state.error;
+        response.content = std::move(stream_state.content);
+        response.model_used = stream_state.model;
+        response.tokens_prompt = stream_state.tokens_prompt;
+        response.tokens_completion = stream_state.tokens_completion;
+        response.tokens_total = stream_state.tokens_total > 0
+            ? stream_state.tokens_total
+            : stream_state.tokens_prompt + stream_state.tokens_completion;
+        response.first_token_ms = stream_state.first_token_ms;
         return response;
     }
 
@@ -510,6 +922,9 @@ LLMResponse LLMClient::callViaRabbitMQ(const std::vector<ChatMessage>& messages,
         return response;
     }
 
+    // Le canal et la queue de réponses sont partagés par les workers
+    std::lock_guard<std::mutex> lock(rabbitmq_mutex_);
+
     try {
         // Construire la requête
         json request;
@@ -670,6 +1085,33 @@ void LLMClient::clearHistory() {
     history_.clear();
 }
 
+void LLMClient::recordExchange(const std::string& question, const std::string& answer) {
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    history_.push_back({"user", question});
+    history_.push_back({"assistant", answer});
+
+    // Limiter l'historique
+    while (history_.size() > history_limit_ * 2) {
+        history_.erase(history_.begin());
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CACHE DE RÉPONSES
+// ═══════════════════════════════════════════════════════════════════════════
+
+CacheStats LLMClient::getResponseCacheStats() const {
+    return response_cache_ ? response_cache_->stats() : CacheStats{};
+}
+
+uint64_t LLMClient::getResponseCacheNearHits() const {
+    return response_cache_ ? response_cache_->nearHits() : 0;
+}
+
+void LLMClient::clearResponseCache() {
+    if (response_cache_) response_cache_->clear();
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CIRCUIT BREAKER
 // ═══════════════════════════════════════════════════════════════════════════
@@ -724,7 +1166,7 @@ bool LLMClient::shouldAttemptRequest() {
 
 void LLMClient::log(const std::string& message) const {
     if (config_.verbose) {
-        std::cout << "[LLMClient] " << message << std::endl;
+        MCEE_LOG_INFO("LLMClient", message);
     }
 }
 
@@ -743,6 +1185,14 @@ PipelineResult EmotionalResponsePipeline::process(
     const std::string& question,
     const std::vector<std::string>& lemmas,
     const std::vector<double>& embedding) {
+    return processStream(question, lemmas, embedding, {});
+}
+
+PipelineResult EmotionalResponsePipeline::processStream(
+    const std::string& question,
+    const std::vector<std::string>& lemmas,
+    const std::vector<double>& embedding,
+    LLMTokenCallback on_token) {
 
     PipelineResult result;
     auto start_time = std::chrono::steady_clock::now();
@@ -756,6 +1206,11 @@ PipelineResult EmotionalResponsePipeline::process(
         // L'implémentation complète viendra avec HybridSearchEngine
     }
 
+    // Les lemmes de la question alimentent l'emplacement {{keywords}} du prompt
+    if (result.context.context_words.empty()) {
+        result.context.context_words = lemmas;
+    }
+
     auto search_end = std::chrono::steady_clock::now();
     result.search_time_ms = std::chrono::duration<double, std::milli>(
         search_end - search_start).count();
@@ -766,8 +1221,11 @@ PipelineResult EmotionalResponsePipeline::process(
     LLMRequest request;
     request.user_question = question;
     request.emotional_context = result.context;
+    request.question_embedding = embedding;
 
-    auto llm_response = llm_client_->generate(request);
+    auto llm_response = on_token
+        ? llm_client_->generateStream(request, on_token)
+        : llm_client_->generate(request);
 
     auto llm_end = std::chrono::steady_clock::now();
     result.llm_time_ms = std::chrono::duration<double, std::milli>(
@@ -775,6 +1233,7 @@ PipelineResult EmotionalResponsePipeline::process(
 
     result.success = llm_response.success;
     result.response = llm_response.content;
+    result.from_cache = llm_response.from_cache;
 
     if (!llm_response.success) {
         result.error = llm_response.error_message;
@@ -793,12 +1252,19 @@ void EmotionalResponsePipeline::processAsync(
     const std::vector<double>& embedding,
     std::function<void(const PipelineResult&)> callback) {
 
-    std::thread([this, question, lemmas, embedding, callback]() {
+    bool queued = llm_client_->post([this, question, lemmas, embedding, callback]() {
         auto result = process(question, lemmas, embedding);
         if (callback) {
             callback(result);
         }
-    }).detach();
+    });
+
+    if (!queued && callback) {
+        PipelineResult result;
+        result.success = false;
+        result.error = "File d'attente LLM pleine ou client arrêté";
+        callback(result);
+    }
 }
 
 } // namespace mcee
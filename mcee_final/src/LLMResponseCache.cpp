@@ -0,0 +1,190 @@
+/**
+ * @file LLMResponseCache.cpp
+ * @brief Implémentation du cache de réponses LLM
+ */
+
+#include "LLMResponseCache.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <cstring>
+
+namespace mcee {
+
+namespace {
+
+uint64_t hashText(std::string_view text) {
+    return std::hash<std::string_view>{}(text);
+}
+
+size_t estimateBytes(const LLMResponse& response) {
+    return sizeof(LLMResponse) + response.content.capacity() + response.model_used.capacity();
+}
+
+} // namespace
+
+LLMResponseCache::LLMResponseCache(size_t max_bytes, size_t shards)
+    : entries_(max_bytes, shards) {}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CLÉS
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::string LLMResponseCache::normalizeQuestion(std::string_view question) {
+    std::string out;
+    out.reserve(question.size());
+
+    bool pending_space = false;
+    for (char c : question) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (u == ' ' || u == '\t' || u == '\n' || u == '\r') {
+            pending_space = !out.empty();
+            continue;
+        }
+        if (pending_space) {
+            out.push_back(' ');
+            pending_space = false;
+        }
+        // Octets UTF-8 multi-octets conservés tels quels
+        out.push_back(u < 0x80 ? static_cast<char>(std::tolower(u)) : c);
+    }
+
+    while (!out.empty() && (out.back() == '?' || out.back() == '!' ||
+                            out.back() == '.' || out.back() == ' ')) {
+        out.pop_back();
+    }
+    return out;
+}
+
+uint64_t LLMResponseCache::contextFingerprint(const LLMContext& context) {
+    // Mêmes bornes que le prompt : 3 émotions, 5 mots-clés, 3 souvenirs
+    uint64_t h = hashText(context.sentiment_label);
+    h = hashCombine(h, hashText(context.dominant_emotion));
+    for (size_t i = 0; i < std::min(context.emotions.size(), size_t(3)); ++i) {
+        h = hashCombine(h, hashText(context.emotions[i].name));
+    }
+    for (size_t i = 0; i < std::min(context.context_words.size(), size_t(5)); ++i) {
+        h = hashCombine(h, hashText(context.context_words[i]));
+    }
+    for (size_t i = 0; i < std::min(context.activated_memories.size(), size_t(3)); ++i) {
+        h = hashCombine(h, hashText(context.activated_memories[i]));
+    }
+    return h;
+}
+
+uint64_t LLMResponseCache::scopeKey(const LLMRequest& request, double temperature, int max_tokens) {
+    uint64_t temperature_bits = 0;
+    std::memcpy(&temperature_bits, &temperature, sizeof(temperature_bits));
+
+    uint64_t h = hashText(request.cache_scope);
+    h = hashCombine(h, contextFingerprint(request.emotional_context));
+    h = hashCombine(h, hashText(request.custom_instruction));
+    h = hashCombine(h, temperature_bits);
+    return hashCombine(h, static_cast<uint64_t>(max_tokens));
+}
+
+uint64_t LLMResponseCache::questionKey(uint64_t scope, std::string_view question) {
+    return hashCombine(scope, hashText(normalizeQuestion(question)));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// RECHERCHE / INSERTION
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool LLMResponseCache::normalize(const std::vector<double>& embedding, std::vector<float>& out) {
+    double norm = 0.0;
+    for (double v : embedding) norm += v * v;
+    if (norm < 1e-12) return false;
+
+    double inv = 1.0 / std::sqrt(norm);
+    out.resize(embedding.size());
+    for (size_t i = 0; i < embedding.size(); ++i) {
+        out[i] = static_cast<float>(embedding[i] * inv);
+    }
+    return true;
+}
+
+std::shared_ptr<const LLMResponse> LLMResponseCache::find(uint64_t key, uint64_t scope,
+                                                          const std::vector<double>& embedding,
+                                                          std::chrono::steady_clock::duration ttl,
+                                                          double min_similarity,
+                                                          bool* near) {
+    if (near) *near = false;
+    if (auto hit = entries_.get(key, ttl)) {
+        return hit;
+    }
+    if (min_similarity <= 0.0 || embedding.empty()) {
+        return nullptr;
+    }
+
+    std::vector<float> query;
+    if (!normalize(embedding, query)) return nullptr;
+
+    // Meilleure question voisine de la même portée
+    uint64_t best_key = 0;
+    double best_similarity = min_similarity;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(near_mutex_);
+        auto it = near_.find(scope);
+        if (it == near_.end()) return nullptr;
+
+        for (const auto& entry : it->second) {
+            if (entry.unit.size() != query.size()) continue;
+            double dot = 0.0;
+            for (size_t i = 0; i < query.size(); ++i) {
+                dot += static_cast<double>(query[i]) * entry.unit[i];
+            }
+            if (dot >= best_similarity) {
+                best_similarity = dot;
+                best_key = entry.key;
+                found = true;
+            }
+        }
+    }
+    if (!found) return nullptr;
+
+    // L'entrée a pu expirer ou être évincée depuis
+    auto hit = entries_.get(best_key, ttl);
+    if (hit) {
+        near_hits_.fetch_add(1, std::memory_order_relaxed);
+        if (near) *near = true;
+    }
+    return hit;
+}
+
+void LLMResponseCache::store(uint64_t key, uint64_t scope, const std::vector<double>& embedding,
+                             const LLMResponse& response) {
+    auto value = std::make_shared<const LLMResponse>(response);
+    entries_.put(key, value, estimateBytes(*value));
+
+    std::vector<float> unit;
+    if (embedding.empty() || !normalize(embedding, unit)) return;
+
+    std::lock_guard<std::mutex> lock(near_mutex_);
+    if (near_.size() >= MAX_NEAR_SCOPES && near_.find(scope) == near_.end()) {
+        near_.clear();
+    }
+    auto& entries = near_[scope];
+    auto same = std::find_if(entries.begin(), entries.end(),
+                             [key](const NearEntry& e) { return e.key == key; });
+    if (same != entries.end()) entries.erase(same);
+
+    entries.push_front(NearEntry{key, std::move(unit)});
+    if (entries.size() > NEAR_ENTRIES_PER_SCOPE) entries.pop_back();
+}
+
+CacheStats LLMResponseCache::stats() const {
+    CacheStats s = entries_.stats();
+    uint64_t near = nearHits();
+    s.misses = s.misses > near ? s.misses - near : 0;
+    return s;
+}
+
+void LLMResponseCache::clear() {
+    entries_.clear();
+    std::lock_guard<std::mutex> lock(near_mutex_);
+    near_.clear();
+}
+
+} // namespace mcee
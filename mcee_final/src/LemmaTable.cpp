@@ -0,0 +1,193 @@
+/**
+ * @file LemmaTable.cpp
+ * @brief Implémentation de la table d'internement du vocabulaire
+ * @version 3.0
+ * @date 2024
+ */
+
+#include "LemmaTable.hpp"
+
+#include <cctype>
+#include <stdexcept>
+
+namespace mcee {
+
+namespace {
+
+// Négations et intensificateurs (modulent le poids causal d'un mot)
+constexpr std::string_view NEGATIONS[] = {
+    "ne", "pas", "jamais", "rien", "aucun", "personne", "non"
+};
+
+constexpr std::string_view INTENSIFIERS[] = {
+    "très", "vraiment", "extrêmement", "tellement", "super", "trop"
+};
+
+// Mots à ignorer (stop words français)
+constexpr std::string_view STOP_WORDS[] = {
+    "le", "la", "les", "un", "une", "des", "du", "de", "et", "ou",
+    "je", "tu", "il", "elle", "nous", "vous", "ils", "elles",
+    "ce", "cette", "ces", "mon", "ma", "mes", "ton", "ta", "tes",
+    "son", "sa", "ses", "notre", "votre", "leur", "leurs",
+    "qui", "que", "quoi", "dont", "où", "est", "sont", "suis",
+    "ai", "as", "avons", "avez", "ont", "être", "avoir",
+    "pour", "avec", "sans", "dans", "sur", "sous", "par",
+    "ne", "pas", "plus", "moins", "très", "trop", "aussi"
+};
+
+// Mots d'urgence spécifiques (comptés parmi les mots-clés)
+constexpr std::string_view URGENCY_WORDS[] = {
+    "urgence", "urgent", "vite", "maintenant", "immédiatement",
+    "aide", "secours", "sos", "danger", "alerte", "attention"
+};
+
+struct LexicalClass {
+    uint16_t flags = 0;
+    double score = 0.0;
+};
+
+/**
+ * @brief Classes lexicales par forme en minuscules, construites une fois
+ */
+const std::unordered_map<std::string_view, LexicalClass>& lexicalClasses() {
+    static const auto classes = [] {
+        std::unordered_map<std::string_view, LexicalClass> map;
+        auto mark = [&map](const auto& words, uint16_t flag) {
+            for (std::string_view w : words) map[w].flags |= flag;
+        };
+        mark(NEGATIONS, LemmaTable::NEGATION);
+        mark(INTENSIFIERS, LemmaTable::INTENSIFIER);
+        mark(STOP_WORDS, LemmaTable::STOP_WORD);
+        mark(URGENCY_WORDS, LemmaTable::URGENCY);
+        for (const auto& [word, score] : LemmaTable::defaultEmotionScores()) {
+            auto& cls = map[word];
+            cls.flags |= LemmaTable::SCORED;
+            cls.score = score;
+        }
+        return map;
+    }();
+    return classes;
+}
+
+} // namespace
+
+const std::vector<std::pair<std::string_view, double>>& LemmaTable::defaultEmotionScores() {
+    // Scores émotionnels par mot (valence)
+    static const std::vector<std::pair<std::string_view, double>> scores = {
+        // Très positif (+0.8 à +1.0)
+        {"adore", 0.9}, {"aime", 0.8}, {"bonheur", 0.95}, {"joie", 0.9},
+        {"merveilleux", 0.85}, {"fantastique", 0.85}, {"excellent", 0.8},
+
+        // Positif (+0.4 à +0.7)
+        {"bien", 0.5}, {"bon", 0.5}, {"content", 0.6}, {"heureux", 0.7},
+        {"satisfait", 0.6}, {"agréable", 0.5}, {"plaisant", 0.5},
+
+        // Légèrement positif (+0.1 à +0.3)
+        {"ok", 0.2}, {"correct", 0.2}, {"acceptable", 0.1},
+
+        // Neutre (0)
+        {"peut-être", 0.0}, {"normal", 0.0}, {"ordinaire", 0.0},
+
+        // Légèrement négatif (-0.1 à -0.3)
+        {"bof", -0.2}, {"moyen", -0.1}, {"passable", -0.2},
+
+        // Négatif (-0.4 à -0.7)
+        {"mal", -0.5}, {"mauvais", -0.5}, {"triste", -0.6}, {"déçu", -0.5},
+        {"ennuyé", -0.4}, {"fatigué", -0.4}, {"stressé", -0.5},
+
+        // Très négatif (-0.8 à -1.0)
+        {"déteste", -0.9}, {"horrible", -0.85}, {"terrible", -0.8},
+        {"catastrophe", -0.9}, {"mort", -0.95}, {"peur", -0.7},
+        {"terreur", -0.9}, {"horreur", -0.9}, {"panique", -0.8}
+    };
+    return scores;
+}
+
+LemmaTable& LemmaTable::instance() {
+    static LemmaTable table;
+    return table;
+}
+
+LemmaTable::LemmaTable()
+    : chunks_(std::make_unique<std::atomic<Entry*>[]>(MAX_CHUNKS))
+{
+    // Listes internées d'avance : find() les reconnaît sans internement préalable
+    for (const auto& [word, cls] : lexicalClasses()) {
+        intern(word);
+    }
+}
+
+LemmaId LemmaTable::find(std::string_view text) const {
+    const size_t hash = std::hash<std::string_view>{}(text);
+    const auto& shard = shardFor(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(text);
+    return it != shard.index.end() ? it->second : NO_LEMMA;
+}
+
+LemmaId LemmaTable::intern(std::string_view text) {
+    const size_t hash = std::hash<std::string_view>{}(text);
+    auto& shard = shardFor(hash);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(text);
+        if (it != shard.index.end()) return it->second;
+    }
+
+    // Propriétés calculées hors verrou, une fois par chaîne nouvelle
+    std::string lower(text);
+    for (auto& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    LexicalClass cls;
+    const auto& classes = lexicalClasses();
+    if (auto it = classes.find(lower); it != classes.end()) {
+        cls = it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(text);
+    if (it != shard.index.end()) return it->second;   // Internée entre-temps
+
+    LemmaId id;
+    Entry* slot;
+    {
+        std::lock_guard<std::mutex> growth(growth_mutex_);
+        const size_t next = size_.load(std::memory_order_relaxed);
+        if ((next >> CHUNK_BITS) >= MAX_CHUNKS) {
+            throw std::length_error("LemmaTable: capacité épuisée");
+        }
+        if ((next & (CHUNK_SIZE - 1)) == 0) {
+            owned_chunks_.push_back(std::make_unique<Entry[]>(CHUNK_SIZE));
+            chunks_[next >> CHUNK_BITS].store(owned_chunks_.back().get(), std::memory_order_release);
+        }
+        id = static_cast<LemmaId>(next);
+        slot = &chunks_[next >> CHUNK_BITS].load(std::memory_order_relaxed)[next & (CHUNK_SIZE - 1)];
+        slot->text.assign(text);
+        slot->flags = cls.flags;
+        slot->score = cls.score;
+        size_.store(next + 1, std::memory_order_release);
+    }
+
+    shard.index.emplace(std::string_view(slot->text), id);
+    return id;
+}
+
+size_t LemmaTable::memoryUsage() const {
+    // Nœud de table de hachage ≈ valeur + chaînage
+    constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+    size_t bytes = sizeof(*this) + MAX_CHUNKS * sizeof(std::atomic<Entry*>);
+    const size_t count = size();
+    bytes += ((count + CHUNK_SIZE - 1) >> CHUNK_BITS) * CHUNK_SIZE * sizeof(Entry);
+    for (size_t id = 0; id < count; ++id) {
+        const auto& text = entry(static_cast<LemmaId>(id)).text;
+        if (text.capacity() > std::string().capacity()) bytes += text.capacity() + 1;
+    }
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        bytes += shard.index.bucket_count() * sizeof(void*);
+        bytes += shard.index.size() * (sizeof(std::string_view) + sizeof(LemmaId) + HASH_NODE_OVERHEAD);
+    }
+    return bytes;
+}
+
+} // namespace mcee
@@ -8,29 +8,78 @@
  */
 
 #include "MCEEEngine.hpp"
-#include <iostream>
+#include "Logger.hpp"
+#include "JsonScanner.hpp"
+#include "JsonWriter.hpp"
+#include "MappedFile.hpp"
 #include <iomanip>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 
 namespace mcee {
 
-MCEEEngine::MCEEEngine(const RabbitMQConfig& rabbitmq_config)
+MCEEEngine::MCEEEngine(const RabbitMQConfig& rabbitmq_config, const PipelineConfig& pipeline_config)
     : rabbitmq_config_(rabbitmq_config)
+    , pipeline_config_(pipeline_config)
     , phase_detector_(DEFAULT_HYSTERESIS_MARGIN, DEFAULT_MIN_PHASE_DURATION)
-    , last_update_time_(std::chrono::steady_clock::now())
-    , pattern_start_time_(std::chrono::steady_clock::now())
+    , match_queue_(pipeline_config.match_queue_capacity)
+    , update_queue_(pipeline_config.update_queue_capacity)
+    , persist_queue_(pipeline_config.persist_queue_capacity)
+    , update_arena_(pipeline_config.frame_arena_bytes)
+    , persist_arena_(pipeline_config.frame_arena_bytes)
+    , last_update_time_(SessionClock::now())
+    , pattern_start_time_(SessionClock::now())
 {
-    std::cout << "\n";
-    std::cout << "╔══════════════════════════════════════════════════════════════╗\n";
-    std::cout << "║           MCEE - Modèle Complet d'Évaluation des États       ║\n";
-    std::cout << "║                        Version 3.0                            ║\n";
-    std::cout << "║              Architecture MCT/MLT - Patterns Dynamiques       ║\n";
-    std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
-    std::cout << "\n";
+    MCEE_LOG_INFO("MCEEEngine", "MCEE v3.0 - Modèle Complet d'Évaluation des États (MCT/MLT, patterns dynamiques)");
 
+    initialize(nullptr);
+
+    MCEE_LOG_INFO("MCEEEngine", "Moteur v3.0 initialisé avec MCT/MLT + Parole");
+}
+
+MCEEEngine::MCEEEngine(std::string session_id, const SharedEngineResources& shared,
+                       const RabbitMQConfig& rabbitmq_config)
+    : rabbitmq_config_(rabbitmq_config)
+    , pipeline_config_(hostedPipelineConfig())
+    , session_id_(std::move(session_id))
+    , phase_detector_(DEFAULT_HYSTERESIS_MARGIN, DEFAULT_MIN_PHASE_DURATION)
+    , speech_input_(shared.lexicon ? shared.lexicon : SpeechLexicon::createDefault())
+    , match_queue_(pipeline_config_.match_queue_capacity)
+    , update_queue_(pipeline_config_.update_queue_capacity)
+    , persist_queue_(pipeline_config_.persist_queue_capacity)
+    , update_arena_(pipeline_config_.frame_arena_bytes)
+    , persist_arena_(pipeline_config_.frame_arena_bytes)
+    , last_update_time_(SessionClock::now())
+    , pattern_start_time_(SessionClock::now())
+{
+    initialize(&shared);
+
+    MCEE_LOG_DEBUG("MCEEEngine", "Session ", session_id_, " initialisée");
+}
+
+PipelineConfig MCEEEngine::hostedPipelineConfig() {
+    PipelineConfig config;
+    config.enabled = false;
+    config.match_queue_capacity = 2;
+    config.update_queue_capacity = 2;
+    config.persist_queue_capacity = 2;
+    config.state_log_interval = 0;
+    config.frame_arena_bytes = 16 * 1024;
+    return config;
+}
+
+SharedEngineResources MCEEEngine::createSharedResources() {
+    SharedEngineResources shared;
+    shared.mlt = createMLT();
+    shared.lexicon = SpeechLexicon::createDefault();
+    shared.llm_client = createLLMClient();
+    return shared;
+}
+
+void MCEEEngine::initialize(const SharedEngineResources* shared) {
     // Initialiser le système MCT/MLT
-    initMemorySystem();
+    initMemorySystem(shared);
 
     // Configurer les callbacks legacy (PhaseDetector)
     phase_detector_.setTransitionCallback(
@@ -55,19 +104,22 @@ MCEEEngine::MCEEEngine(const RabbitMQConfig& rabbitmq_config)
     // Configurer le callback d'urgence du module parole
     speech_input_.setUrgencyCallback(
         [this](const std::string& text, double urgency) {
-            std::cout << "[MCEEEngine] ⚠ Urgence détectée dans le texte (score=" 
-                      << std::fixed << std::setprecision(2) << urgency << ")\n";
-            current_feedback_.internal = std::max(current_feedback_.internal, urgency * 0.5);
+            MCEE_LOG_WARN("MCEEEngine",
+                "Urgence détectée dans le texte (score=", std::fixed, std::setprecision(2),
+                urgency, ")");
+            // Le feedback appartient à l'étage [update] : passer par le pipeline
+            PipelineFrame frame;
+            frame.kind = PipelineFrame::Kind::URGENCY;
+            frame.feedback.internal = urgency * 0.5;
+            submitFrame(std::move(frame));
         }
     );
 
     // Configurer les callbacks MCT/MLT
     setupCallbacks();
-
-    std::cout << "[MCEEEngine] Moteur v3.0 initialisé avec MCT/MLT + Parole\n";
 }
 
-void MCEEEngine::initMemorySystem() {
+void MCEEEngine::initMemorySystem(const SharedEngineResources* shared) {
     // Créer la MCT
     MCTConfig mct_config;
     mct_config.max_size = 60;
@@ -93,19 +145,15 @@ void MCEEEngine::initMemorySystem() {
     // Configurer le callback de détection causale
     mct_graph_->setCausalDetectionCallback(
         [](const std::string& word_id, const std::string& emotion_id, double strength) {
-            std::cout << "[MCTGraph] Causalité détectée: " << word_id
-                      << " → " << emotion_id << " (force="
-                      << std::fixed << std::setprecision(2) << strength << ")\n";
+            MCEE_LOG_DEBUG("MCTGraph",
+                "Causalité détectée: ", word_id, " → ", emotion_id, " (force=", std::fixed,
+                std::setprecision(2), strength, ")");
         }
     );
 
-    // Créer la MLT avec les patterns de base
-    MLTConfig mlt_config;
-    mlt_config.min_similarity_threshold = 0.6;
-    mlt_config.high_similarity_threshold = 0.85;
-    mlt_config.learning_rate = 0.1;
-    mlt_config.max_patterns = 100;
-    mlt_ = std::make_shared<MLT>(mlt_config);
+    // MLT avec les patterns de base ; hébergée, couche de session au-dessus
+    // de la base commune (l'apprentissage d'une session reste dans la sienne)
+    mlt_ = shared && shared->mlt ? std::make_shared<MLT>(shared->mlt) : createMLT();
 
     // Créer le PatternMatcher
     PatternMatcherConfig pm_config;
@@ -117,25 +165,18 @@ void MCEEEngine::initMemorySystem() {
     pm_config.verbose_logging = true;
     pattern_matcher_ = std::make_shared<PatternMatcher>(mct_, mlt_, pm_config);
 
-    // Créer le ConscienceEngine (module Conscience & Sentiments)
-    ConscienceConfig conscience_config;
-    conscience_config.beta_memory = 0.15;
-    conscience_config.delta_environment = 0.1;
-    conscience_config.omega_trauma = 5.0;
-    conscience_config.lambda_feedback = 0.2;
-    conscience_config.sentiment_smoothing = 0.1;
-    conscience_engine_ = std::make_shared<ConscienceEngine>(conscience_config);
+    // Créer le ConscienceEngine (module Conscience & Sentiments, profil de production)
+    conscience_engine_ = std::make_shared<ConscienceEngine>(PRODUCTION_CONSCIENCE_CONFIG);
 
     // Configurer les callbacks du ConscienceEngine
     conscience_engine_->setUpdateCallback([this](const ConscienceSentimentState& state) {
-        std::cout << "[Conscience] Ct=" << std::fixed << std::setprecision(2)
-                  << state.consciousness_level << " Ft=" << state.sentiment
-                  << " (" << state.dominant_state << ")\n";
+        MCEE_LOG_DEBUG("Conscience",
+            "Ct=", std::fixed, std::setprecision(2), state.consciousness_level, " Ft=",
+            state.sentiment, " (", state.dominant_state, ")");
     });
 
     conscience_engine_->setTraumaAlertCallback([this](const TraumaState& trauma) {
-        std::cout << "[Conscience] ⚠ Trauma actif: " << trauma.source
-                  << " (intensité=" << trauma.intensity << ")\n";
+        MCEE_LOG_WARN("Conscience", "Trauma actif: ", trauma.source, " (intensité=", trauma.intensity, ")");
         // Relier au système Amyghaleon si nécessaire
         if (trauma.intensity >= 0.8) {
             Phase current_phase = phase_detector_.getCurrentPhase();
@@ -147,38 +188,31 @@ void MCEEEngine::initMemorySystem() {
     });
 
     // Créer le module ADDO (Détermination des Objectifs)
-    ADDOConfig addo_config;
-    addo_config.use_wisdom_modulation = true;
-    addo_config.use_sentiment_for_S = true;
-    addo_config.emergency_override = true;
-    addo_engine_ = std::make_shared<ADDOEngine>(addo_config);
+    addo_engine_ = std::make_shared<ADDOEngine>(PRODUCTION_ADDO_CONFIG);
 
     // Configurer les callbacks ADDO
     addo_engine_->setUpdateCallback([](const GoalState& state) {
-        std::cout << "[ADDO] G(t)=" << std::fixed << std::setprecision(2)
-                  << state.G << " (dominant: " << state.dominant_variable << ")\n";
+        MCEE_LOG_DEBUG("ADDO",
+            "G(t)=", std::fixed, std::setprecision(2), state.G, " (dominant: ",
+            state.dominant_variable, ")");
     });
 
     addo_engine_->setEmergencyCallback([this](const std::string& emergency_goal) {
-        std::cout << "[ADDO] ⚡ Objectif d'urgence: " << emergency_goal << "\n";
+        MCEE_LOG_INFO("ADDO", "⚡ Objectif d'urgence: ", emergency_goal);
     });
 
     // Créer le module de Prise de Décision Réfléchie
-    DecisionConfig decision_config;
-    decision_config.tau_max_ms = 5000.0;
-    decision_config.theta_veto = 0.80;
-    decision_config.enable_meta_actions = true;
-    decision_engine_ = std::make_shared<DecisionEngine>(decision_config);
+    decision_engine_ = std::make_shared<DecisionEngine>(PRODUCTION_DECISION_CONFIG);
 
     // Configurer les callbacks Decision
     decision_engine_->setDecisionCallback([](const DecisionResult& result) {
-        std::cout << "[Decision] D(t)=" << result.action_name
-                  << " κ=" << std::fixed << std::setprecision(2) << result.confidence
-                  << (result.is_meta_action ? " [META]" : "") << "\n";
+        MCEE_LOG_DEBUG("Decision",
+            "D(t)=", result.action_name, " κ=", std::fixed, std::setprecision(2),
+            result.confidence, (result.is_meta_action ? " [META]" : ""));
     });
 
     decision_engine_->setVetoCallback([](const ActionOption& option, const std::string& reason) {
-        std::cout << "[Decision] ⛔ Veto: " << option.name << " (" << reason << ")\n";
+        MCEE_LOG_INFO("Decision", "⛔ Veto: ", option.name, " (", reason, ")");
     });
 
     // Créer le HybridSearchEngine (recherche mémoire hybride)
@@ -192,6 +226,11 @@ void MCEEEngine::initMemorySystem() {
         memory_manager_.getNeo4jClient(),
         [](Neo4jClient*) {}  // Deleter vide: MemoryManager gère la durée de vie
     );
+    if (shared && shared->neo4j_client) {
+        // Connexion de l'hôte : une session Neo4j par session MCEE
+        memory_manager_.attachNeo4jClient(shared->neo4j_client);
+        neo4j_shared = shared->neo4j_client;
+    }
 
     hybrid_search_ = std::make_shared<HybridSearchEngine>(
         neo4j_shared,
@@ -199,7 +238,34 @@ void MCEEEngine::initMemorySystem() {
         hs_config
     );
 
-    // Créer le LLMClient (reformulation émotionnelle)
+    // Préchargement des successeurs probables du pattern courant
+    prefetcher_ = std::make_unique<PatternPrefetcher>(mlt_, memory_manager_);
+    prefetcher_->setHybridSearch(hybrid_search_);
+
+    // LLMClient (reformulation émotionnelle), transport partagé par l'hôte
+    llm_client_ = shared && shared->llm_client ? shared->llm_client : createLLMClient();
+
+    if (shared) return;  // Session hébergée : le résumé ci-dessous ne concerne que l'hôte
+
+    MCEE_LOG_INFO("MCEEEngine", "Système MCT/MLT initialisé");
+    MCEE_LOG_INFO("MCEEEngine", "MCTGraph: fenêtre=", graph_config.time_window_seconds, "s");
+    MCEE_LOG_INFO("MCEEEngine", "MLT: ", mlt_->patternCount(), " patterns de base");
+    MCEE_LOG_INFO("MCEEEngine", "ConscienceEngine initialisé (Wt=", conscience_engine_->getWisdom(), ")");
+    MCEE_LOG_INFO("MCEEEngine", "ADDOEngine initialisé (Rs=", addo_engine_->getResilience(), ")");
+    MCEE_LOG_INFO("MCEEEngine", "DecisionEngine initialisé (τ_max=", decision_engine_->getConfig().tau_max_ms, "ms)");
+    MCEE_LOG_INFO("MCEEEngine", "HybridSearchEngine initialisé");
+}
+
+std::shared_ptr<MLT> MCEEEngine::createMLT() {
+    MLTConfig mlt_config;
+    mlt_config.min_similarity_threshold = 0.6;
+    mlt_config.high_similarity_threshold = 0.85;
+    mlt_config.learning_rate = 0.1;
+    mlt_config.max_patterns = 100;
+    return std::make_shared<MLT>(mlt_config);
+}
+
+std::shared_ptr<LLMClient> MCEEEngine::createLLMClient() {
     LLMClientConfig llm_config;
     llm_config.mode = LLMMode::DIRECT_HTTP;  // Mode HTTP direct par défaut
     llm_config.model = "gpt-4o-mini";
@@ -208,26 +274,19 @@ void MCEEEngine::initMemorySystem() {
     llm_config.verbose = false;
     llm_config.loadFromEnvironment();  // Charge OPENAI_API_KEY
 
-    llm_client_ = std::make_shared<LLMClient>(llm_config);
+    auto llm_client = std::make_shared<LLMClient>(llm_config);
 
     // Initialiser le LLMClient si la clé API est disponible
     if (!llm_config.api_key.empty()) {
-        if (llm_client_->initialize()) {
-            std::cout << "[MCEEEngine] LLMClient initialisé (modèle=" << llm_config.model << ")\n";
+        if (llm_client->initialize()) {
+            MCEE_LOG_INFO("MCEEEngine", "LLMClient initialisé (modèle=", llm_config.model, ")");
         } else {
-            std::cout << "[MCEEEngine] ⚠ LLMClient: échec initialisation\n";
+            MCEE_LOG_WARN("MCEEEngine", "LLMClient: échec initialisation");
         }
     } else {
-        std::cout << "[MCEEEngine] LLMClient: OPENAI_API_KEY non défini (mode désactivé)\n";
+        MCEE_LOG_INFO("MCEEEngine", "LLMClient: OPENAI_API_KEY non défini (mode désactivé)");
     }
-
-    std::cout << "[MCEEEngine] Système MCT/MLT initialisé\n";
-    std::cout << "[MCEEEngine] MCTGraph: fenêtre=" << graph_config.time_window_seconds << "s\n";
-    std::cout << "[MCEEEngine] MLT: " << mlt_->patternCount() << " patterns de base\n";
-    std::cout << "[MCEEEngine] ConscienceEngine initialisé (Wt=" << conscience_engine_->getWisdom() << ")\n";
-    std::cout << "[MCEEEngine] ADDOEngine initialisé (Rs=" << addo_engine_->getResilience() << ")\n";
-    std::cout << "[MCEEEngine] DecisionEngine initialisé (τ_max=" << decision_config.tau_max_ms << "ms)\n";
-    std::cout << "[MCEEEngine] HybridSearchEngine initialisé\n";
+    return llm_client;
 }
 
 void MCEEEngine::setupCallbacks() {
@@ -236,17 +295,16 @@ void MCEEEngine::setupCallbacks() {
     // Callback sur changement de pattern
     pattern_matcher_->setMatchCallback([this](const MatchResult& match) {
         if (match.is_transition) {
-            std::cout << "\n[MCEEEngine] ═══ Transition de pattern: " 
-                      << current_match_.pattern_name << " → " 
-                      << match.pattern_name << " ═══\n";
-            std::cout << "[MCEEEngine] Similarité: " << std::fixed << std::setprecision(3) 
-                      << match.similarity << ", Confiance: " << match.confidence << "\n\n";
+            MCEE_LOG_INFO("MCEEEngine",
+                "═══ Transition de pattern: ", current_match_.pattern_name, " → ",
+                match.pattern_name, " ═══ (similarité: ", std::fixed, std::setprecision(3),
+                match.similarity, ", confiance: ", match.confidence, ")");
         }
     });
     
     // Callback sur création de pattern
     pattern_matcher_->setNewPatternCallback([this](const std::string& id, const std::string& name) {
-        std::cout << "[MCEEEngine] ★ Nouveau pattern créé: " << name << " (id: " << id << ")\n";
+        MCEE_LOG_INFO("MCEEEngine", "★ Nouveau pattern créé: ", name, " (id: ", id, ")");
     });
     
     // Callback sur transition
@@ -254,7 +312,7 @@ void MCEEEngine::setupCallbacks() {
         stats_.phase_transitions++;
 
         // Enregistrer la durée du pattern précédent
-        auto now = std::chrono::steady_clock::now();
+        auto now = SessionClock::now();
         double duration = std::chrono::duration<double>(now - pattern_start_time_).count();
         mlt_->recordActivation(from, duration);
 
@@ -264,8 +322,9 @@ void MCEEEngine::setupCallbacks() {
         pattern_start_time_ = now;
     });
     
-    // Callback MLT sur événements pattern
-    if (mlt_) {
+    // Callback MLT sur événements pattern (pas pour une session hébergée :
+    // un événement par pattern de chaque session noierait le journal)
+    if (mlt_ && session_id_.empty()) {
         mlt_->setEventCallback([](const PatternEvent& event) {
             std::string type_str;
             switch (event.type) {
@@ -276,50 +335,61 @@ void MCEEEngine::setupCallbacks() {
                 case PatternEvent::Type::ACTIVATED: type_str = "ACTIVATED"; break;
                 case PatternEvent::Type::DEACTIVATED: type_str = "DEACTIVATED"; break;
             }
-            std::cout << "[MLT Event] " << type_str << ": " << event.pattern_name;
-            if (!event.details.empty()) {
-                std::cout << " - " << event.details;
-            }
-            std::cout << "\n";
+            MCEE_LOG_DEBUG("MLT Event", type_str, ": ", event.pattern_name,
+                event.details.empty() ? "" : " - ", event.details);
         });
     }
 }
 
 MCEEEngine::~MCEEEngine() {
     stop();
+
+    // Les réponses encore en file ou en cours utilisent les modules du moteur
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    async_cv_.wait(lock, [this]() { return async_responses_ == 0; });
 }
 
 bool MCEEEngine::start() {
     if (running_.load()) {
-        std::cout << "[MCEEEngine] Déjà en cours d'exécution" << std::endl;
+        MCEE_LOG_INFO("MCEEEngine", "Déjà en cours d'exécution");
         return true;
     }
 
-    std::cout << "[MCEEEngine] Démarrage en cours..." << std::endl;
+    MCEE_LOG_INFO("MCEEEngine", "Démarrage en cours...");
 
     // Initialiser RabbitMQ
     if (!initRabbitMQ()) {
-        std::cerr << "[MCEEEngine] Échec initialisation RabbitMQ" << std::endl;
+        MCEE_LOG_ERROR("MCEEEngine", "Échec initialisation RabbitMQ");
         return false;
     }
 
     running_.store(true);
 
+    // Démarrer les étages du pipeline avant les consommateurs
+    if (pipeline_config_.enabled) {
+        startPipeline();
+    }
+
+    // Voie rapide d'urgence : ouverte avant les consommateurs qui l'alimentent
+    executor_ = Executor::shared();
+    emergency_lane_running_.store(true);
+
     // Démarrer les threads de consommation
     emotions_consumer_thread_ = std::thread(&MCEEEngine::emotionsConsumeLoop, this);
     speech_consumer_thread_ = std::thread(&MCEEEngine::speechConsumeLoop, this);
     tokens_consumer_thread_ = std::thread(&MCEEEngine::tokensConsumeLoop, this);
-    snapshot_timer_thread_ = std::thread(&MCEEEngine::snapshotTimerLoop, this);
-
-    std::cout << "[MCEEEngine] ✓ Démarré et en attente de messages RabbitMQ" << std::endl;
-    std::cout << "[MCEEEngine] Émotions: " << rabbitmq_config_.emotions_exchange
-              << " / " << rabbitmq_config_.emotions_routing_key << std::endl;
-    std::cout << "[MCEEEngine] Parole: " << rabbitmq_config_.speech_exchange
-              << " / " << rabbitmq_config_.speech_routing_key << std::endl;
-    std::cout << "[MCEEEngine] Tokens: " << rabbitmq_config_.tokens_exchange
-              << " / " << rabbitmq_config_.tokens_routing_key << std::endl;
-    std::cout << "[MCEEEngine] MCTGraph snapshot interval: "
-              << mct_graph_->getConfig().snapshot_interval_seconds << "s" << std::endl;
+    startTimers();
+
+    MCEE_LOG_INFO("MCEEEngine", "✓ Démarré et en attente de messages RabbitMQ");
+    MCEE_LOG_INFO("MCEEEngine",
+        "Émotions: ", rabbitmq_config_.emotions_exchange, " / ",
+        rabbitmq_config_.emotions_routing_key);
+    MCEE_LOG_INFO("MCEEEngine",
+        "Parole: ", rabbitmq_config_.speech_exchange, " / ", rabbitmq_config_.speech_routing_key);
+    MCEE_LOG_INFO("MCEEEngine",
+        "Tokens: ", rabbitmq_config_.tokens_exchange, " / ", rabbitmq_config_.tokens_routing_key);
+    MCEE_LOG_INFO("MCEEEngine",
+        "MCTGraph snapshot interval: ", mct_graph_->getConfig().snapshot_interval_seconds, "s");
 
     return true;
 }
@@ -343,26 +413,63 @@ void MCEEEngine::stop() {
         tokens_consumer_thread_.join();
     }
 
-    if (snapshot_timer_thread_.joinable()) {
-        snapshot_timer_thread_.join();
+    // Minuteries annulées : attendre une exécution éventuellement en cours
+    timer_source_.cancel();
+    if (snapshot_timer_.valid()) snapshot_timer_.wait();
+    if (metrics_timer_.valid()) metrics_timer_.wait();
+    if (publish_timer_.valid()) publish_timer_.wait();
+
+    // Plus aucun producteur RabbitMQ : vider la file d'urgence, puis les étages.
+    // La vidange finale se fait ici, après celle éventuellement programmée.
+    emergency_lane_running_.store(false);
+    while (emergency_drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        std::this_thread::yield();
+    }
+    EmergencyLaneEvent event;
+    while (emergency_lane_.tryNext(event)) {
+        publishEmergencyLane(emergency_lane_channel_, event);
     }
+    emergency_drain_scheduled_.store(false, std::memory_order_release);
 
-    std::cout << "[MCEEEngine] Arrêté\n";
-    std::cout << "[MCEEEngine] Statistiques finales:\n";
-    std::cout << "  - Transitions de phase: " << stats_.phase_transitions << "\n";
-    std::cout << "  - Urgences déclenchées: " << stats_.emergency_triggers << "\n";
-    std::cout << "  - Souvenirs créés: " << memory_manager_.getMemoryCount() << "\n";
-    std::cout << "  - Traumas: " << memory_manager_.getTraumaCount() << "\n";
-    std::cout << "  - Textes traités: " << speech_input_.getProcessedCount() << "\n";
-    std::cout << "  - Sentiment moyen: " << std::fixed << std::setprecision(2)
-              << speech_input_.getAverageSentiment() << "\n";
+    stopPipeline();
+    if (prefetcher_) {
+        prefetcher_->stop();
+    }
+
+    // Dernier état retenu par la politique de publication
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        flushPublishPolicy(true);
+    }
+
+    // Checkpoint final : la prochaine reprise n'a rien à rejouer
+    if (journal_ && journal_->isOpen()) {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        PipelineFrame frame;
+        if (beginCheckpoint(frame, true)) {
+            processPipeline(frame);
+        }
+        journal_->close();
+    }
+
+    MCEE_LOG_INFO("MCEEEngine", "Arrêté");
+    MCEE_LOG_INFO("MCEEEngine",
+        "Statistiques finales: transitions de phase=", stats_.phase_transitions,
+        ", urgences=", stats_.emergency_triggers,
+        ", souvenirs=", memory_manager_.getMemoryCount(),
+        ", traumas=", memory_manager_.getTraumaCount(),
+        ", textes=", speech_input_.getProcessedCount(),
+        ", sentiment moyen=", std::fixed, std::setprecision(2), speech_input_.getAverageSentiment());
 
     // Statistiques MCTGraph
     if (mct_graph_) {
-        std::cout << "  - MCTGraph mots: " << mct_graph_->getWordCount() << "\n";
-        std::cout << "  - MCTGraph émotions: " << mct_graph_->getEmotionCount() << "\n";
-        std::cout << "  - MCTGraph arêtes causales: " << mct_graph_->getCausalEdgeCount() << "\n";
+        MCEE_LOG_INFO("MCEEEngine",
+            "MCTGraph final: ", mct_graph_->getWordCount(), " mots, ",
+            mct_graph_->getEmotionCount(), " émotions, ",
+            mct_graph_->getCausalEdgeCount(), " arêtes causales");
     }
+
+    Logger::instance().flush();
 }
 
 bool MCEEEngine::initRabbitMQ() {
@@ -375,12 +482,17 @@ bool MCEEEngine::initRabbitMQ() {
             rabbitmq_config_.password
         };
 
-        // === Créer 4 channels séparés (thread-safety) ===
+        // === Créer 5 channels séparés (thread-safety) ===
         // AmqpClient::Channel n'est PAS thread-safe, chaque thread doit avoir son propre channel
         emotions_channel_ = AmqpClient::Channel::Open(opts);
         speech_channel_ = AmqpClient::Channel::Open(opts);
         tokens_channel_ = AmqpClient::Channel::Open(opts);
         publish_channel_ = AmqpClient::Channel::Open(opts);
+        emergency_channel_ = AmqpClient::Channel::Open(opts);  // Étage [update] uniquement
+        emergency_lane_channel_ = AmqpClient::Channel::Open(opts);  // Voie rapide d'urgence uniquement
+        if (rabbitmq_config_.metrics_interval_seconds > 0.0) {
+            metrics_channel_ = AmqpClient::Channel::Open(opts);  // Timer métriques uniquement
+        }
 
         // === Déclarer les exchanges sur le channel de publication ===
 
@@ -419,6 +531,15 @@ bool MCEEEngine::initRabbitMQ() {
             false, true, false
         );
 
+        // Exchange pour les métriques (texte Prometheus)
+        if (metrics_channel_) {
+            metrics_channel_->DeclareExchange(
+                rabbitmq_config_.metrics_exchange,
+                AmqpClient::Channel::EXCHANGE_TYPE_TOPIC,
+                false, true, false
+            );
+        }
+
         // === Configurer le channel émotions ===
         std::string emotions_queue = emotions_channel_->DeclareQueue(
             "mcee_emotions_queue", false, true, false, false
@@ -429,7 +550,7 @@ bool MCEEEngine::initRabbitMQ() {
             rabbitmq_config_.emotions_routing_key
         );
         emotions_consumer_tag_ = emotions_channel_->BasicConsume(
-            emotions_queue, "", true, false, false, 1
+            emotions_queue, "", true, false, false, rabbitmq_config_.consumer_prefetch
         );
 
         // === Configurer le channel parole ===
@@ -442,7 +563,7 @@ bool MCEEEngine::initRabbitMQ() {
             rabbitmq_config_.speech_routing_key
         );
         speech_consumer_tag_ = speech_channel_->BasicConsume(
-            speech_queue, "", true, false, false, 1
+            speech_queue, "", true, false, false, rabbitmq_config_.consumer_prefetch
         );
 
         // === Configurer le channel tokens ===
@@ -455,99 +576,202 @@ bool MCEEEngine::initRabbitMQ() {
             rabbitmq_config_.tokens_routing_key
         );
         tokens_consumer_tag_ = tokens_channel_->BasicConsume(
-            tokens_queue, "", true, false, false, 1
+            tokens_queue, "", true, false, false, rabbitmq_config_.consumer_prefetch
+        );
+
+        // === File prioritaire des urgences (voie rapide) ===
+        AmqpClient::Table priority_args;
+        priority_args["x-max-priority"] = AmqpClient::TableValue(static_cast<int32_t>(10));
+        std::string emergency_queue = publish_channel_->DeclareQueue(
+            rabbitmq_config_.emergency_queue, false, true, false, false, priority_args
+        );
+        publish_channel_->BindQueue(
+            emergency_queue,
+            rabbitmq_config_.output_exchange,
+            rabbitmq_config_.emergency_routing_key
         );
 
-        std::cout << "[MCEEEngine] Connexion RabbitMQ établie (4 channels)" << std::endl;
-        std::cout << "[MCEEEngine] Queues créées: emotions + speech + tokens" << std::endl;
-        std::cout << "[MCEEEngine] Exchange snapshot: " << rabbitmq_config_.snapshot_exchange << std::endl;
+        MCEE_LOG_INFO("MCEEEngine", "Connexion RabbitMQ établie (5 channels)");
+        MCEE_LOG_INFO("MCEEEngine", "Queues créées: emotions + speech + tokens");
+        MCEE_LOG_INFO("MCEEEngine", "Exchange snapshot: ", rabbitmq_config_.snapshot_exchange);
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur RabbitMQ: " << e.what() << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur RabbitMQ: ", e.what());
         return false;
     }
 }
 
-void MCEEEngine::emotionsConsumeLoop() {
-    std::cout << "[MCEEEngine] Boucle de consommation des émotions démarrée" << std::endl;
+void MCEEEngine::consumeBatchLoop(const AmqpClient::Channel::ptr_t& channel,
+                                  const std::string& consumer_tag,
+                                  const std::string& label,
+                                  const std::function<void(const std::vector<AmqpClient::BasicMessage::ptr_t>&)>& handler) {
+    const size_t batch_max = std::max<size_t>(1, std::min<size_t>(
+        rabbitmq_config_.consumer_batch_max, std::max<uint16_t>(1, rabbitmq_config_.consumer_prefetch)));
+
+    std::vector<AmqpClient::BasicMessage::ptr_t> messages;
+    std::vector<AmqpClient::Envelope::ptr_t> envelopes;
+    messages.reserve(batch_max);
+    envelopes.reserve(batch_max);
 
     while (running_.load()) {
         try {
+            messages.clear();
+            envelopes.clear();
+
             AmqpClient::Envelope::ptr_t envelope;
-            bool received = emotions_channel_->BasicConsumeMessage(emotions_consumer_tag_, envelope, 500);
+            bool received = channel->BasicConsumeMessage(consumer_tag, envelope,
+                                                         rabbitmq_config_.consumer_poll_timeout_ms);
+            if (!received || !envelope) {
+                continue;
+            }
+
+            // Drainer sans attendre les messages déjà livrés (dans la limite du prefetch)
+            do {
+                messages.push_back(envelope->Message());
+                envelopes.push_back(std::move(envelope));
+            } while (messages.size() < batch_max &&
+                     channel->BasicConsumeMessage(consumer_tag, envelope, 0) && envelope);
 
-            if (received && envelope) {
-                std::string body(envelope->Message()->Body().begin(),
-                                envelope->Message()->Body().end());
+            handler(messages);
 
-                handleEmotionMessage(body);
-                emotions_channel_->BasicAck(envelope);
+            if (rabbitmq_config_.consumer_multi_ack) {
+                // Acquitte tout le lot (delivery tags croissants sur ce channel)
+                channel->BasicAck(envelopes.back()->GetDeliveryInfo(), true);
+            } else {
+                for (const auto& env : envelopes) {
+                    channel->BasicAck(env);
+                }
             }
 
         } catch (const std::exception& e) {
-            std::cerr << "[MCEEEngine] Erreur consommation émotions: " << e.what() << "\n";
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            MCEE_LOG_ERROR("MCEEEngine", "Erreur consommation ", label, ": ", e.what());
+            std::this_thread::sleep_for(std::chrono::milliseconds(rabbitmq_config_.consumer_error_backoff_ms));
         }
     }
 }
 
-void MCEEEngine::speechConsumeLoop() {
-    std::cout << "[MCEEEngine] Boucle de consommation de la parole démarrée" << std::endl;
+void MCEEEngine::emotionsConsumeLoop() {
+    MCEE_LOG_INFO("MCEEEngine", "Boucle de consommation des émotions démarrée");
 
-    while (running_.load()) {
-        try {
-            AmqpClient::Envelope::ptr_t envelope;
-            bool received = speech_channel_->BasicConsumeMessage(speech_consumer_tag_, envelope, 500);
+    consumeBatchLoop(emotions_channel_, emotions_consumer_tag_, "émotions",
+        [this](const std::vector<AmqpClient::BasicMessage::ptr_t>& messages) {
+            for (const auto& message : messages) {
+                handleEmotionMessage(message->Body(), message->ContentTypeIsSet() ? message->ContentType() : std::string(),
+                                     traceStamp(message, rabbitmq_config_.trace_header));
+            }
+        });
+}
 
-            if (received && envelope) {
-                std::string body(envelope->Message()->Body().begin(),
-                                envelope->Message()->Body().end());
+void MCEEEngine::speechConsumeLoop() {
+    MCEE_LOG_INFO("MCEEEngine", "Boucle de consommation de la parole démarrée");
 
-                handleSpeechMessage(body);
-                speech_channel_->BasicAck(envelope);
+    consumeBatchLoop(speech_channel_, speech_consumer_tag_, "parole",
+        [this](const std::vector<AmqpClient::BasicMessage::ptr_t>& messages) {
+            for (const auto& message : messages) {
+                handleSpeechMessage(message->Body());
             }
+        });
+}
 
-        } catch (const std::exception& e) {
-            std::cerr << "[MCEEEngine] Erreur consommation parole: " << e.what() << "\n";
-            std::this_thread::sleep_for(std::chrono::seconds(1));
-        }
+void MCEEEngine::handleInput(MCEEInput input, const std::string& body, const std::string& content_type,
+                             int64_t trace) {
+    switch (input) {
+        case MCEEInput::EMOTIONS:
+            handleEmotionMessage(body, content_type, trace);
+            break;
+        case MCEEInput::SPEECH:
+            handleSpeechMessage(body);
+            break;
+        case MCEEInput::TOKENS:
+            handleTokensMessage(body);
+            break;
     }
 }
 
-void MCEEEngine::handleEmotionMessage(const std::string& body) {
+void MCEEEngine::setTraceWriter(std::shared_ptr<TraceWriter> writer) {
+    trace_writer_ = std::move(writer);
+}
+
+int64_t MCEEEngine::traceStamp(const AmqpClient::BasicMessage::ptr_t& message, const std::string& header) {
+    if (header.empty() || !message->HeaderTableIsSet()) return 0;
+    const auto& headers = message->HeaderTable();
+    auto it = headers.find(header);
+    if (it == headers.end()) return 0;
     try {
-        json input = json::parse(body);
+        return it->second.GetInteger();
+    } catch (const std::exception&) {
+        return 0;   // Pas un entier : ignorée
+    }
+}
 
-        std::cout << "[MCEEEngine] Message émotion reçu (" << body.size() << " bytes)\n";
+void MCEEEngine::handleEmotionMessage(const std::string& body, const std::string& content_type,
+                                      int64_t trace) {
+    if (trace_writer_) {
+        trace_writer_->record(session_id_, MCEEInput::EMOTIONS, body, content_type);
+    }
 
-        std::unordered_map<std::string, double> raw_emotions;
+    try {
+        if (isEmotionFrameContentType(content_type)) {
+            EmotionFrame frame;
+            if (!decodeEmotionFrame(body, frame)) {
+                MCEE_LOG_ERROR("MCEEEngine", "Trame émotion invalide (", body.size(), " bytes)");
+                return;
+            }
+
+            processEmotions(frame.emotions, trace);
+            return;
+        }
+
+        MCEE_LOG_DEBUG("MCEEEngine", "Message émotion reçu (", body.size(), " bytes)");
+
+        // Lecture directe du corps : clé → indice par hachage parfait, les
+        // autres champs (timestamp…) sont sautés
+        std::array<double, NUM_EMOTIONS> raw_emotions{};
         size_t found_count = 0;
-        for (const auto& name : EMOTION_NAMES) {
-            if (input.contains(name)) {
-                raw_emotions[name] = input[name].get<double>();
+        JsonScanner scan(body);
+        scan.beginObject();
+        std::string_view key;
+        while (scan.nextField(key)) {
+            size_t index = emotionIndex(key);
+            if (index < NUM_EMOTIONS) {
+                raw_emotions[index] = scan.readNumber();
                 found_count++;
             } else {
-                raw_emotions[name] = 0.0;
+                scan.skipValue();
             }
         }
+        scan.expectEnd();
 
-        std::cout << "[MCEEEngine] Émotions trouvées: " << found_count << "/24\n";
+        MCEE_LOG_DEBUG("MCEEEngine", "Émotions trouvées: ", found_count, "/24");
 
-        processEmotions(raw_emotions);
+        processEmotions(raw_emotions, trace);
 
     } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur parsing JSON émotions: " << e.what() << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur parsing JSON émotions: ", e.what());
     }
 }
 
 void MCEEEngine::handleSpeechMessage(const std::string& body) {
+    if (trace_writer_) {
+        trace_writer_->record(session_id_, MCEEInput::SPEECH, body);
+    }
+
     try {
-        json input = json::parse(body);
-        
-        std::string text = input.value("text", "");
-        std::string source = input.value("source", "user");
-        double confidence = input.value("confidence", 1.0);
+        std::string_view text, source = "user";
+        std::string text_scratch, source_scratch;
+        double confidence = 1.0;
+
+        JsonScanner scan(body);
+        scan.beginObject();
+        std::string_view key;
+        while (scan.nextField(key)) {
+            if (key == "text") text = scan.readString(text_scratch);
+            else if (key == "source") source = scan.readString(source_scratch);
+            else if (key == "confidence") confidence = scan.readNumber();
+            else scan.skipValue();
+        }
+        scan.expectEnd();
 
         if (!text.empty()) {
             TextInput text_input;
@@ -555,121 +779,642 @@ void MCEEEngine::handleSpeechMessage(const std::string& body) {
             text_input.source = source;
             text_input.confidence = confidence;
             
-            // Traiter le texte
-            last_speech_analysis_ = speech_input_.processText(text_input);
-            
-            // Mettre à jour le feedback externe basé sur le texte
-            double fb_ext = speech_input_.computeFeedbackExternal(last_speech_analysis_);
+            // Traiter le texte (hors pipeline : l'analyse ne touche pas l'état)
+            auto analysis = std::make_shared<SpeechAnalysis>(speech_input_.processText(text_input));
             
-            {
-                std::lock_guard<std::mutex> lock(state_mutex_);
-                // Combiner avec le feedback existant (moyenne pondérée)
-                current_feedback_.external = current_feedback_.external * 0.3 + fb_ext * 0.7;
-            }
+            // Feedback externe basé sur le texte, fusionné par l'étage [update]
+            double fb_ext = speech_input_.computeFeedbackExternal(*analysis);
+
+            PipelineFrame frame;
+            frame.kind = PipelineFrame::Kind::SPEECH;
+            frame.feedback.external = fb_ext;
+            frame.speech = std::move(analysis);
+            submitFrame(std::move(frame));
 
-            std::cout << "[MCEEEngine] Texte traité, feedback externe ajusté: " 
-                      << std::fixed << std::setprecision(2) << current_feedback_.external << "\n";
+            MCEE_LOG_DEBUG("MCEEEngine",
+                "Texte traité, feedback externe cible: ", std::fixed, std::setprecision(2), fb_ext);
         }
 
     } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur parsing JSON parole: " << e.what() << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur parsing JSON parole: ", e.what());
     }
 }
 
 void MCEEEngine::processEmotions(const std::unordered_map<std::string, double>& raw_emotions) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-
-    // Sauvegarder l'état précédent
-    previous_state_ = current_state_;
+    std::array<double, NUM_EMOTIONS> values{};
+    for (const auto& [name, value] : raw_emotions) {
+        size_t index = emotionIndex(name);
+        if (index < NUM_EMOTIONS) values[index] = value;
+    }
+    processEmotions(values);
+}
 
-    // Convertir en EmotionalState
-    current_state_ = rawToState(raw_emotions);
+void MCEEEngine::processEmotions(const std::array<double, NUM_EMOTIONS>& raw_emotions, int64_t trace) {
+    PipelineFrame frame;
+    frame.kind = PipelineFrame::Kind::EMOTIONS;
+    frame.state = rawToState(raw_emotions);
+    frame.trace = trace;
+
+    // Voie rapide Amyghaleon : décidée dans ce thread, publiée avant tout le pipeline
+    EmergencyLaneEvent event;
+    if (emergency_lane_.evaluate(frame.state.emotions, std::chrono::steady_clock::now(), event)) {
+        frame.reflex = true;
+        if (emergency_lane_running_.load(std::memory_order_acquire)) {
+            if (emergency_lane_.post(event)) {
+                scheduleEmergencyDrain();
+            }
+        } else {
+            // Session hébergée ou rejeu : le thread appelant possède le channel d'urgence
+            publishEmergencyLane(emergency_channel_, event);
+        }
+    }
 
-    // Exécuter le pipeline complet
-    processPipeline(raw_emotions);
+    submitFrame(std::move(frame));
 }
 
 void MCEEEngine::processSpeechText(const std::string& text, const std::string& source) {
     // Traiter le texte via SpeechInput
-    last_speech_analysis_ = speech_input_.processText(text, source);
+    auto analysis = std::make_shared<SpeechAnalysis>(speech_input_.processText(text, source));
     
-    // Mettre à jour le feedback externe
-    double fb_ext = speech_input_.computeFeedbackExternal(last_speech_analysis_);
-    
-    {
-        std::lock_guard<std::mutex> lock(state_mutex_);
-        current_feedback_.external = current_feedback_.external * 0.3 + fb_ext * 0.7;
-    }
+    // Feedback externe
+    double fb_ext = speech_input_.computeFeedbackExternal(*analysis);
     
+    PipelineFrame frame;
+    frame.kind = PipelineFrame::Kind::SPEECH;
+    frame.feedback.external = fb_ext;
+
     // Créer un contexte pour le souvenir si le texte est significatif
-    if (std::abs(last_speech_analysis_.sentiment_score) > 0.3 || 
-        last_speech_analysis_.urgency_score > 0.5) {
-        std::string context = speech_input_.generateMemoryContext(last_speech_analysis_);
-        memory_manager_.recordMemory(current_state_, phase_detector_.getCurrentPhase(), context);
+    if (std::abs(analysis->sentiment_score) > 0.3 || analysis->urgency_score > 0.5) {
+        frame.memory_context = speech_input_.generateMemoryContext(*analysis);
+    }
+
+    MCEE_LOG_DEBUG("MCEEEngine",
+        "Texte traité: sentiment=", std::fixed, std::setprecision(2), analysis->sentiment_score,
+        ", fb_ext=", fb_ext);
+
+    frame.speech = std::move(analysis);
+    submitFrame(std::move(frame));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PIPELINE PAR ÉTAGES
+// ═══════════════════════════════════════════════════════════════════════════
+
+void MCEEEngine::submitFrame(PipelineFrame&& frame) {
+    frame.ingest_time = std::chrono::steady_clock::now();
+
+    if (pipeline_active_.load(std::memory_order_acquire)) {
+        match_queue_.push(std::move(frame), match_stage_running_);
+        return;
+    }
+
+    // Pipeline non démarré (démo, entrée directe) : exécution synchrone
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    processPipeline(frame);
+
+    PipelineFrame checkpoint;
+    if (beginCheckpoint(checkpoint)) {
+        processPipeline(checkpoint);
     }
+}
 
-    std::cout << "[MCEEEngine] Texte traité: sentiment=" 
-              << std::fixed << std::setprecision(2) << last_speech_analysis_.sentiment_score
-              << ", fb_ext=" << current_feedback_.external << "\n";
+void MCEEEngine::processPipeline(PipelineFrame& frame) {
+    if (runMatchStage(frame) && runUpdateStage(frame)) {
+        runPersistStage(frame);
+    }
 }
 
-void MCEEEngine::processPipeline(const std::unordered_map<std::string, double>& raw_emotions) {
+void MCEEEngine::startPipeline() {
+    match_stage_running_.store(true);
+    update_stage_running_.store(true);
+    persist_stage_running_.store(true);
+
+    persist_stage_thread_ = std::thread(&MCEEEngine::persistStageLoop, this);
+    update_stage_thread_ = std::thread(&MCEEEngine::updateStageLoop, this);
+    match_stage_thread_ = std::thread(&MCEEEngine::matchStageLoop, this);
+
+    pipeline_active_.store(true, std::memory_order_release);
+
+    MCEE_LOG_INFO("MCEEEngine",
+        "Pipeline par étages démarré (files: ", match_queue_.capacity(), "/",
+        update_queue_.capacity(), "/", persist_queue_.capacity(), ")");
+}
+
+void MCEEEngine::stopPipeline() {
+    if (!pipeline_active_.load()) return;
+
+    // Les soumissions tardives passent en synchrone, après la vidange
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    pipeline_active_.store(false, std::memory_order_release);
+
+    // Arrêt amont → aval : chaque étage vide sa file avant de s'arrêter
+    match_stage_running_.store(false);
+    match_queue_.wake();
+    if (match_stage_thread_.joinable()) match_stage_thread_.join();
+
+    update_stage_running_.store(false);
+    update_queue_.wake();
+    if (update_stage_thread_.joinable()) update_stage_thread_.join();
+
+    persist_stage_running_.store(false);
+    persist_queue_.wake();
+    if (persist_stage_thread_.joinable()) persist_stage_thread_.join();
+}
+
+void MCEEEngine::matchStageLoop() {
+    PipelineFrame frame;
+    PendingFrame pending;      // Lue au-delà d'une fusion, traitée au tour suivant
+    while (takeMatchFrame(frame, pending, match_queue_, rabbitmq_config_, match_stage_running_)) {
+        try {
+            // Surcharge : fraîcheur plutôt qu'exhaustivité
+            if (frame.coalesced > 1) {
+                ingest_coalesced_.fetch_add(frame.coalesced - 1, std::memory_order_relaxed);
+            }
+            if (frame.shed) {
+                ingest_shed_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (runMatchStage(frame)) {
+                update_queue_.push(std::move(frame), update_stage_running_);
+            }
+
+            // Checkpoint entre deux trames : tout ce qui précède est appliqué par [match]
+            PipelineFrame checkpoint;
+            if (beginCheckpoint(checkpoint)) {
+                update_queue_.push(std::move(checkpoint), update_stage_running_);
+            }
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEEngine", "Erreur étage match: ", e.what());
+        }
+    }
+}
+
+bool MCEEEngine::takeMatchFrame(PipelineFrame& frame, PendingFrame& pending,
+                                BoundedMPSCQueue<PipelineFrame>& queue, const RabbitMQConfig& config,
+                                const std::atomic<bool>& running) {
+    if (pending.present) {
+        frame = std::move(pending.frame);
+        pending.present = false;
+    } else if (!queue.waitPop(frame, running)) {
+        return false;
+    }
+
+    if (frame.kind == PipelineFrame::Kind::EMOTIONS && !frame.reflex) {
+        const auto now = std::chrono::steady_clock::now();
+        if (ingestOverloaded(frame, queue.size(), config, now)) {
+            pending.present = coalesceBacklog(frame, pending.frame, queue, config, now);
+            frame.shed = config.ingest_shed;
+        }
+    }
+    return true;
+}
+
+bool MCEEEngine::ingestOverloaded(const PipelineFrame& frame, size_t queue_depth,
+                                  const RabbitMQConfig& config,
+                                  std::chrono::steady_clock::time_point now) {
+    if (config.ingest_coalesce_depth > 0 && queue_depth >= config.ingest_coalesce_depth) {
+        return true;
+    }
+    return config.ingest_coalesce_age_ms > 0 &&
+           now - frame.ingest_time >= std::chrono::milliseconds(config.ingest_coalesce_age_ms);
+}
+
+bool MCEEEngine::coalesceBacklog(PipelineFrame& frame, PipelineFrame& next,
+                                 BoundedMPSCQueue<PipelineFrame>& queue, const RabbitMQConfig& config,
+                                 std::chrono::steady_clock::time_point now) {
+    const size_t max_frames = std::max<size_t>(1, config.ingest_coalesce_max);
+    const bool weighted = config.ingest_coalesce_mode == CoalesceMode::TIME_WEIGHTED;
+
+    // Moyenne pondérée : chaque trame vaut de son arrivée à celle de la suivante
+    std::array<double, NUM_EMOTIONS> weighted_sum{};
+    double total_weight = 0.0;
+    auto valid_since = frame.ingest_time;
+    auto accumulate = [&](std::chrono::steady_clock::time_point until) {
+        const double weight = std::max(1e-6, std::chrono::duration<double>(until - valid_since).count());
+        for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+            weighted_sum[i] += frame.state.emotions[i] * weight;
+        }
+        total_weight += weight;
+    };
+
+    bool has_next = false;
+    while (frame.coalesced < max_frames && queue.tryPop(next)) {
+        if (next.kind != PipelineFrame::Kind::EMOTIONS || next.reflex) {
+            has_next = true;  // Parole, feedback ou urgence : traitée telle quelle, après
+            break;
+        }
+        if (weighted) {
+            accumulate(next.ingest_time);
+            valid_since = next.ingest_time;
+        }
+        // ingest_time (et trace) restent ceux de la plus ancienne : end_to_end mesure le retard réel
+        if (frame.trace == 0) frame.trace = next.trace;
+        frame.state = next.state;
+        frame.coalesced++;
+    }
+
+    if (frame.coalesced > 1 && weighted) {
+        accumulate(now);
+        const auto timestamp = frame.state.timestamp;
+        for (double& value : weighted_sum) value /= total_weight;
+        frame.state = rawToState(weighted_sum);
+        frame.state.timestamp = timestamp;
+    }
+    return has_next;
+}
+
+bool MCEEEngine::publishIsStale(const PipelineFrame& frame, size_t persist_backlog) {
+    return frame.shed && persist_backlog > 0;
+}
+
+void MCEEEngine::updateStageLoop() {
+    PipelineFrame frame;
+    while (update_queue_.waitPop(frame, update_stage_running_)) {
+        try {
+            if (runUpdateStage(frame)) {
+                const bool counted = frame.kind == PipelineFrame::Kind::EMOTIONS;
+                if (persist_queue_.push(std::move(frame), persist_stage_running_) && counted) {
+                    persist_forwarded_.fetch_add(1, std::memory_order_release);
+                }
+            }
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEEngine", "Erreur étage update: ", e.what());
+        }
+    }
+}
+
+void MCEEEngine::persistStageLoop() {
+    PipelineFrame frame;
+    while (persist_queue_.waitPop(frame, persist_stage_running_)) {
+        const bool counted = frame.kind == PipelineFrame::Kind::EMOTIONS;
+        try {
+            runPersistStage(frame);
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEEngine", "Erreur étage persist: ", e.what());
+        }
+        if (counted) persist_completed_.fetch_add(1, std::memory_order_release);
+    }
+}
+
+MCEEStats MCEEEngine::getStats() const {
+    MCEEStats stats = stats_;
+    stats.match_queue_depth = match_queue_.size();
+    stats.update_queue_depth = update_queue_.size();
+    stats.persist_queue_depth = persist_queue_.size();
+    stats.pipeline_stalls = match_queue_.stallCount() + update_queue_.stallCount()
+                          + persist_queue_.stallCount();
+    stats.frames_processed = frames_processed_.load(std::memory_order_relaxed);
+    stats.ingest_coalesced = ingest_coalesced_.load(std::memory_order_relaxed);
+    stats.ingest_shed = ingest_shed_.load(std::memory_order_relaxed);
+    stats.ingest_publish_skipped = ingest_publish_skipped_.load(std::memory_order_relaxed);
+    stats.frame_heap_counting = heap::countingEnabled();
+    if (stats.frames_processed > 0) {
+        stats.frame_heap_allocations =
+            static_cast<double>(frame_heap_allocations_.load(std::memory_order_relaxed)) /
+            static_cast<double>(stats.frames_processed);
+    }
+    stats.frame_arena_spills = update_arena_.spills() + persist_arena_.spills();
+
+    MemoryIndexStats index_stats = memory_manager_.getIndexStats();
+    stats.memory_index_size = index_stats.indexed;
+    stats.memory_index_hit_ratio = index_stats.hitRatio();
+
+    MemoryTierStats tier_stats = memory_manager_.getTierStats();
+    stats.memory_warm_size = tier_stats.warm;
+    stats.memory_coalesced = tier_stats.coalesced;
+
+    if (pattern_matcher_) {
+        stats.pattern_match_skip_rate = pattern_matcher_->getSkipRate();
+        stats.pattern_match_early_exit_rate = pattern_matcher_->getEarlyExitRate();
+    }
+
+    LatencySnapshot lane = metrics_.emergency_lane.snapshot();
+    stats.emergency_lane_triggers = emergency_lane_.triggerCount();
+    stats.emergency_lane_dropped = emergency_lane_.droppedCount();
+    stats.emergency_lane_p99_ms = static_cast<double>(lane.percentileNs(0.99)) / 1e6;
+    stats.emergency_lane_max_ms = static_cast<double>(lane.max_ns) / 1e6;
+
+    LatencySnapshot end_to_end = metrics_.end_to_end.snapshot();
+    stats.end_to_end_p50_ms = static_cast<double>(end_to_end.percentileNs(0.50)) / 1e6;
+    stats.end_to_end_p99_ms = static_cast<double>(end_to_end.percentileNs(0.99)) / 1e6;
+    return stats;
+}
+
+std::string MCEEEngine::renderMetrics() const {
+    PrometheusWriter out;
+
+    const std::pair<const char*, const LatencyHistogram*> stages[] = {
+        {"mct_push", &metrics_.mct_push},
+        {"graph_insert", &metrics_.graph_insert},
+        {"graph_causality", &metrics_.graph_causality},
+        {"pattern_match", &metrics_.pattern_match},
+        {"memory_query", &metrics_.memory_query},
+        {"amyghaleon", &metrics_.amyghaleon},
+        {"emotion_update", &metrics_.emotion_update},
+        {"mlt_consolidation", &metrics_.mlt_consolidation},
+        {"publish_state", &metrics_.publish_state},
+    };
+    out.family("mcee_stage_latency_seconds", "Durée de chaque étape du pipeline MCEE", "histogram");
+    for (const auto& [stage, histogram] : stages) {
+        out.histogram("mcee_stage_latency_seconds", histogram->snapshot(),
+                      std::string("stage=\"") + stage + "\"");
+    }
+
+    out.family("mcee_end_to_end_latency_seconds",
+               "Consommation RabbitMQ → publication de l'état", "histogram");
+    out.histogram("mcee_end_to_end_latency_seconds", metrics_.end_to_end.snapshot());
+
+    out.family("mcee_emergency_lane_latency_seconds",
+               "Réception → publication de la voie rapide d'urgence", "histogram");
+    out.histogram("mcee_emergency_lane_latency_seconds", metrics_.emergency_lane.snapshot());
+    out.family("mcee_emergency_lane_total", "Déclenchements de la voie rapide d'urgence", "counter");
+    out.sample("mcee_emergency_lane_total", static_cast<double>(emergency_lane_.triggerCount()),
+               "result=\"triggered\"");
+    out.sample("mcee_emergency_lane_total", static_cast<double>(emergency_lane_.droppedCount()),
+               "result=\"dropped\"");
+
+    if (executor_) {
+        executor_->renderMetrics(out);
+    }
+
+    if (pattern_matcher_) {
+        out.family("mcee_pattern_match_total", "Matchings par chemin (réutilisé, successeurs, scan complet)",
+                   "counter");
+        out.sample("mcee_pattern_match_total", static_cast<double>(pattern_matcher_->getSkippedMatches()),
+                   "path=\"skipped\"");
+        out.sample("mcee_pattern_match_total", static_cast<double>(pattern_matcher_->getEarlyExits()),
+                   "path=\"early_exit\"");
+        out.sample("mcee_pattern_match_total", static_cast<double>(pattern_matcher_->getFullScans()),
+                   "path=\"full_scan\"");
+    }
+
+    if (const Neo4jClient* neo4j = memory_manager_.getNeo4jClient()) {
+        out.family("mcee_neo4j_roundtrip_seconds", "Aller-retour des requêtes Neo4j", "histogram");
+        out.histogram("mcee_neo4j_roundtrip_seconds", neo4j->getRoundTripLatency().snapshot());
+        out.family("mcee_neo4j_in_flight", "Requêtes Neo4j en attente de réponse", "gauge");
+        out.sample("mcee_neo4j_in_flight", static_cast<double>(neo4j->inFlightRequests()));
+    }
+
+    if (llm_client_) {
+        out.family("mcee_llm_call_latency_seconds", "Tentatives d'appel au fournisseur LLM", "histogram");
+        out.histogram("mcee_llm_call_latency_seconds", llm_client_->getCallLatency().snapshot());
+        out.family("mcee_llm_requests_total", "Requêtes LLM par issue", "counter");
+        out.sample("mcee_llm_requests_total", static_cast<double>(llm_client_->getSuccessfulRequests()),
+                   "outcome=\"success\"");
+        out.sample("mcee_llm_requests_total",
+                   static_cast<double>(llm_client_->getTotalRequests() - llm_client_->getSuccessfulRequests()),
+                   "outcome=\"failure\"");
+
+        CacheStats responses = llm_client_->getResponseCacheStats();
+        uint64_t near = llm_client_->getResponseCacheNearHits();
+        out.family("mcee_llm_cache_requests_total", "Consultations du cache de réponses LLM", "counter");
+        out.sample("mcee_llm_cache_requests_total", static_cast<double>(responses.hits - near),
+                   "result=\"hit\"");
+        out.sample("mcee_llm_cache_requests_total", static_cast<double>(near), "result=\"near_hit\"");
+        out.sample("mcee_llm_cache_requests_total", static_cast<double>(responses.misses),
+                   "result=\"miss\"");
+    }
+
+    if (prefetcher_) {
+        PrefetchStats prefetch = prefetcher_->getStats();
+        out.family("mcee_prefetch_transitions_total",
+                   "Transitions de pattern selon le préchargement de la cible", "counter");
+        out.sample("mcee_prefetch_transitions_total", static_cast<double>(prefetch.hits), "result=\"hit\"");
+        out.sample("mcee_prefetch_transitions_total", static_cast<double>(prefetch.late), "result=\"late\"");
+        out.sample("mcee_prefetch_transitions_total", static_cast<double>(prefetch.misses), "result=\"miss\"");
+        out.family("mcee_prefetch_targets_total", "Cibles de préchargement par issue", "counter");
+        out.sample("mcee_prefetch_targets_total", static_cast<double>(prefetch.warmed), "result=\"warmed\"");
+        out.sample("mcee_prefetch_targets_total", static_cast<double>(prefetch.cancelled),
+                   "result=\"cancelled\"");
+        out.family("mcee_prefetch_hit_ratio", "Part des transitions vers une cible préchargée", "gauge");
+        out.sample("mcee_prefetch_hit_ratio", prefetch.hitRate());
+    }
+
+    PublishStats publish = publish_policy_.getStats();
+    out.family("mcee_publish_states_total", "États proposés à la publication par issue", "counter");
+    out.sample("mcee_publish_states_total", static_cast<double>(publish.published), "result=\"published\"");
+    out.sample("mcee_publish_states_total", static_cast<double>(publish.suppressed), "result=\"suppressed\"");
+    out.sample("mcee_publish_states_total", static_cast<double>(publish.coalesced), "result=\"coalesced\"");
+    out.family("mcee_publish_immediate_total", "États publiés sans attendre (changement de pattern)", "counter");
+    out.sample("mcee_publish_immediate_total", static_cast<double>(publish.immediate));
+    out.family("mcee_publish_messages_total", "Messages d'état émis (un lot compte pour un)", "counter");
+    out.sample("mcee_publish_messages_total", static_cast<double>(publish.messages));
+
+    if (journal_) {
+        JournalStats journal = getJournalStats();
+        out.family("mcee_journal_records_total", "Enregistrements ajoutés au journal d'état", "counter");
+        out.sample("mcee_journal_records_total", static_cast<double>(journal.appended));
+        out.family("mcee_journal_commits_total", "Lots du journal écrits et synchronisés", "counter");
+        out.sample("mcee_journal_commits_total", static_cast<double>(journal.commits));
+        out.family("mcee_journal_bytes_total", "Octets écrits dans les segments du journal", "counter");
+        out.sample("mcee_journal_bytes_total", static_cast<double>(journal.bytes_written));
+        out.family("mcee_journal_checkpoints_total", "Checkpoints de l'état par issue", "counter");
+        out.sample("mcee_journal_checkpoints_total", static_cast<double>(journal.checkpoints),
+                   "result=\"written\"");
+        out.sample("mcee_journal_checkpoints_total", static_cast<double>(journal.checkpoint_failures),
+                   "result=\"failed\"");
+        out.family("mcee_journal_recovery_seconds", "Durée de la dernière reprise", "gauge");
+        out.sample("mcee_journal_recovery_seconds", journal.recovery_ms / 1000.0);
+        out.family("mcee_journal_recovered_records", "Enregistrements rejoués à la dernière reprise", "gauge");
+        out.sample("mcee_journal_recovered_records", static_cast<double>(journal.recovered_records));
+    }
+
+    if (hybrid_search_) {
+        CacheStats cache = hybrid_search_->getCacheStats();
+        out.family("mcee_hybrid_cache_requests_total", "Consultations du cache HybridSearch", "counter");
+        out.sample("mcee_hybrid_cache_requests_total", static_cast<double>(cache.hits), "result=\"hit\"");
+        out.sample("mcee_hybrid_cache_requests_total", static_cast<double>(cache.misses), "result=\"miss\"");
+        out.family("mcee_hybrid_cache_hit_ratio", "Taux de succès du cache HybridSearch", "gauge");
+        out.sample("mcee_hybrid_cache_hit_ratio", cache.hitRatio());
+
+        CacheStats embeddings = hybrid_search_->getEmbeddingCacheStats();
+        out.family("mcee_hybrid_embedding_cache_requests_total", "Embeddings repris d'une question ou de lemmes déjà vus", "counter");
+        out.sample("mcee_hybrid_embedding_cache_requests_total", static_cast<double>(embeddings.hits), "result=\"hit\"");
+        out.sample("mcee_hybrid_embedding_cache_requests_total", static_cast<double>(embeddings.misses), "result=\"miss\"");
+
+        MemoryIndexStats semantic = hybrid_search_->getSemanticIndexStats();
+        out.family("mcee_hybrid_semantic_searches_total", "Recherches sémantiques par source", "counter");
+        out.sample("mcee_hybrid_semantic_searches_total", static_cast<double>(semantic.local_hits), "source=\"local\"");
+        out.sample("mcee_hybrid_semantic_searches_total", static_cast<double>(semantic.neo4j_fallbacks), "source=\"neo4j\"");
+        out.family("mcee_hybrid_semantic_index_size", "Souvenirs de l'index sémantique local", "gauge");
+        out.sample("mcee_hybrid_semantic_index_size", static_cast<double>(semantic.indexed));
+    }
+
+    out.family("mcee_pipeline_queue_depth", "Trames en attente par étage", "gauge");
+    out.sample("mcee_pipeline_queue_depth", static_cast<double>(match_queue_.size()), "stage=\"match\"");
+    out.sample("mcee_pipeline_queue_depth", static_cast<double>(update_queue_.size()), "stage=\"update\"");
+    out.sample("mcee_pipeline_queue_depth", static_cast<double>(persist_queue_.size()), "stage=\"persist\"");
+
+    out.family("mcee_pipeline_stalls_total", "Poussées retardées par une file pleine", "counter");
+    out.sample("mcee_pipeline_stalls_total", static_cast<double>(
+        match_queue_.stallCount() + update_queue_.stallCount() + persist_queue_.stallCount()));
+
+    out.family("mcee_ingest_coalesced_frames_total", "Trames émotions absorbées par une fusion sous surcharge", "counter");
+    out.sample("mcee_ingest_coalesced_frames_total",
+               static_cast<double>(ingest_coalesced_.load(std::memory_order_relaxed)));
+    out.family("mcee_ingest_shed_frames_total", "Trames traitées sans le travail secondaire", "counter");
+    out.sample("mcee_ingest_shed_frames_total",
+               static_cast<double>(ingest_shed_.load(std::memory_order_relaxed)));
+    out.family("mcee_ingest_publish_skipped_total", "États périmés non publiés (plus récent en file)", "counter");
+    out.sample("mcee_ingest_publish_skipped_total",
+               static_cast<double>(ingest_publish_skipped_.load(std::memory_order_relaxed)));
+
+    out.family("mcee_frames_processed_total", "Trames ayant traversé tout le pipeline", "counter");
+    out.sample("mcee_frames_processed_total",
+               static_cast<double>(frames_processed_.load(std::memory_order_relaxed)));
+
+    if (heap::countingEnabled()) {
+        out.family("mcee_frame_heap_allocations_total", "Allocations du tas global dans les étages", "counter");
+        out.sample("mcee_frame_heap_allocations_total",
+                   static_cast<double>(frame_heap_allocations_.load(std::memory_order_relaxed)));
+    }
+    out.family("mcee_frame_arena_spills_total", "Blocs demandés au tas par une arène de trame pleine", "counter");
+    out.sample("mcee_frame_arena_spills_total", static_cast<double>(update_arena_.spills()), "stage=\"update\"");
+    out.sample("mcee_frame_arena_spills_total", static_cast<double>(persist_arena_.spills()), "stage=\"persist\"");
+
+    return out.str();
+}
+
+bool MCEEEngine::runMatchStage(PipelineFrame& frame) {
+    if (journal_ && frame.kind != PipelineFrame::Kind::CHECKPOINT) {
+        journalFrame(frame);
+    }
+
+    if (frame.kind == PipelineFrame::Kind::SPEECH) {
+        // Les trames émotionnelles suivantes porteront cette analyse
+        last_speech_analysis_ = frame.speech;
+        return true;
+    }
+    if (frame.kind != PipelineFrame::Kind::EMOTIONS) {
+        return true;  // Feedback, checkpoint : traités par [update]
+    }
+
+    HeapAllocationScope heap_allocations(frame.heap_allocations);
+    frame.speech = last_speech_analysis_;
+    const EmotionalState& state = frame.state;
+
     // ═══════════════════════════════════════════════════════════════════════
     // PIPELINE V3.0 : MCT → PatternMatcher → MLT → MCTGraph
     // ═══════════════════════════════════════════════════════════════════════
 
     // 1. AJOUTER L'ÉTAT À LA MCT
-    pushToMCT(current_state_);
+    {
+        ScopedLatency timer(metrics_.mct_push);
+        pushToMCT(state, frame.speech.get());
+    }
 
     // 1b. AJOUTER L'ÉTAT AU MCTGRAPH (graphe relationnel)
     if (mct_graph_) {
         // Calculer la persistance estimée (basée sur l'intensité)
-        double persistence = current_state_.getMeanIntensity() * 5.0;  // 0-5 secondes
+        const auto summary = state.summarize();
+        double persistence = summary.meanIntensity() * 5.0;  // 0-5 secondes
         if (persistence >= mct_graph_->getConfig().emotion_persistence_threshold_seconds) {
-            last_emotion_node_id_ = mct_graph_->addEmotionWithContext(
-                current_state_,
-                persistence,
-                current_state_.getValence(),
-                current_state_.getMeanIntensity()
-            );
+            {
+                ScopedLatency timer(metrics_.graph_insert);
+                last_emotion_node_id_ = mct_graph_->addEmotionWithContext(
+                    state,
+                    persistence,
+                    summary.valence(),
+                    summary.meanIntensity()
+                );
+            }
 
             // Détecter automatiquement les liens causaux avec les mots récents
-            if (!last_emotion_node_id_.empty()) {
+            // (co-occurrences temporelles : délestées sous surcharge)
+            if (!last_emotion_node_id_.empty() && !frame.shed) {
+                ScopedLatency timer(metrics_.graph_causality);
                 mct_graph_->detectCausality(last_emotion_node_id_);
             }
         }
     }
 
     // 2. IDENTIFIER LE PATTERN VIA PatternMatcher
-    MatchResult match = identifyPattern();
+    auto match_start = std::chrono::steady_clock::now();
+    std::shared_ptr<const MatchResult> shared_match = identifyPattern();
+    metrics_.pattern_match.recordSince(match_start);
+    const MatchResult& match = *shared_match;
     
-    // Stocker le match courant
-    MatchResult previous_match = current_match_;
+    // Stocker le match courant (copie dans les capacités existantes)
+    const bool pattern_changed = match.is_transition || match.pattern_id != current_match_.pattern_id;
     current_match_ = match;
+    emergency_lane_.setThreshold(match.emergency_threshold);
     
-    // Log si transition de pattern
-    if (match.is_transition || match.pattern_id != previous_match.pattern_id) {
-        std::cout << "[MCEEEngine] Pattern actif: " << match.pattern_name
-                  << " (sim=" << std::fixed << std::setprecision(3) << match.similarity
-                  << ", conf=" << match.confidence << ")\n";
+    // Log si transition de pattern, puis préchargement de ses successeurs probables
+    if (pattern_changed) {
+        MCEE_LOG_INFO("MCEEEngine",
+            "Pattern actif: ", match.pattern_name, " (sim=", std::fixed, std::setprecision(3),
+            match.similarity, ", conf=", match.confidence, ")");
+        if (prefetcher_) {
+            prefetcher_->onPattern(match.pattern_id);
+        }
     }
 
     // 3. APPLIQUER LES COEFFICIENTS DU PATTERN
-    EmotionalState processed_state = applyPatternCoefficients(current_state_, match);
+    EmotionalState processed_state = applyPatternCoefficients(state, match);
+    (void)processed_state;
+
+    frame.match = std::move(shared_match);
+    return true;
+}
+
+bool MCEEEngine::runUpdateStage(PipelineFrame& frame) {
+    switch (frame.kind) {
+        case PipelineFrame::Kind::SPEECH:
+            // Combiner avec le feedback existant (moyenne pondérée)
+            current_feedback_.external = current_feedback_.external * 0.3 + frame.feedback.external * 0.7;
+            if (!frame.memory_context.empty()) {
+                memory_manager_.recordMemory(current_state_, phase_detector_.getCurrentPhase(),
+                                             frame.memory_context);
+            }
+            return false;
+
+        case PipelineFrame::Kind::FEEDBACK:
+            current_feedback_ = frame.feedback;
+            return false;
+
+        case PipelineFrame::Kind::URGENCY:
+            current_feedback_.internal = std::max(current_feedback_.internal, frame.feedback.internal);
+            return false;
+
+        case PipelineFrame::Kind::CHECKPOINT:
+            completeCheckpoint(frame);
+            return false;
+
+        case PipelineFrame::Kind::PUBLISH:
+            return true;
+
+        case PipelineFrame::Kind::EMOTIONS:
+            break;
+    }
+
+    HeapAllocationScope heap_allocations(frame.heap_allocations);
+    FrameArena::Scope arena_scope(update_arena_);
+    const MatchResult& match = *frame.match;
+    const SpeechAnalysis* speech = frame.speech.get();
+
+    // Sauvegarder l'état précédent
+    previous_state_ = current_state_;
+    current_state_ = frame.state;
 
     // 4. RÉCUPÉRER LES SOUVENIRS PERTINENTS (legacy)
     Phase current_phase = phase_detector_.getCurrentPhase();
-    auto memories = memory_manager_.queryRelevantMemories(current_phase, current_state_, 10);
+    auto query_start = std::chrono::steady_clock::now();
+    std::pmr::vector<MemoryRef> memories(update_arena_.resource());
+    memory_manager_.queryRelevantMemories(current_phase, current_state_, 10, memories);
+    metrics_.memory_query.recordSince(query_start);
 
     for (auto& mem : memories) {
         memory_manager_.updateActivation(mem, current_state_);
     }
 
-    // 5. VÉRIFIER AMYGHALEON (court-circuit d'urgence)
-    handleEmergency(match);
+    // 5. VÉRIFIER AMYGHALEON (court-circuit d'urgence, publié depuis cet étage)
+    {
+        ScopedLatency timer(metrics_.amyghaleon);
+        handleEmergency(match, frame.reflex, update_arena_.resource());
+    }
     
     // 6. CALCULER LE DELTA TEMPS
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     double delta_t = std::chrono::duration<double>(now - last_update_time_).count();
     last_update_time_ = now;
     
@@ -693,183 +1438,402 @@ void MCEEEngine::processPipeline(const std::unordered_map<std::string, double>&
         memories, match.delta
     );
     
-    // 10. METTRE À JOUR LES ÉMOTIONS
-    emotion_updater_.updateAllEmotions(
-        current_state_,
-        current_feedback_,
-        delta_t,
-        memory_influences,
-        wisdom_
-    );
-    
-    // 11. CALCULER LA VARIANCE GLOBALE
-    current_state_.variance_global = emotion_updater_.computeGlobalVariance(
-        current_state_, memories
-    );
-    
-    // 12. CALCULER E_GLOBAL
-    current_state_.E_global = emotion_updater_.computeEGlobal(
-        current_state_,
-        previous_state_.E_global,
-        current_state_.variance_global
-    );
+    // 10-12. METTRE À JOUR LES ÉMOTIONS, LA VARIANCE GLOBALE ET E_GLOBAL (une passe)
+    {
+        ScopedLatency timer(metrics_.emotion_update);
+        frame.summary = emotion_updater_.updateState(
+            current_state_,
+            current_feedback_,
+            delta_t,
+            memory_influences,
+            wisdom_,
+            memories,
+            previous_state_.E_global
+        );
+    }
     
     // 13. REPOUSSER L'ÉTAT TRAITÉ DANS LA MCT (feedback loop)
     if (mct_) {
-        if (!last_speech_analysis_.raw_text.empty()) {
+        if (speech && !speech->raw_text.empty()) {
             mct_->pushWithSpeech(current_state_, 
-                                 last_speech_analysis_.sentiment_score,
-                                 last_speech_analysis_.arousal_score,
-                                 last_speech_analysis_.raw_text);
+                                 speech->sentiment_score,
+                                 speech->arousal_score,
+                                 speech->raw_text);
         } else {
             mct_->push(current_state_);
         }
     }
-    
-    // 14. CONSOLIDER EN MLT SI SIGNIFICATIF
-    consolidateToMLT();
+
+    frame.state = current_state_;
+    frame.phase = current_phase;
+    emergency_lane_.setPhase(current_phase);
+    return true;
+}
+
+void MCEEEngine::runPersistStage(PipelineFrame& frame) {
+    if (frame.kind == PipelineFrame::Kind::PUBLISH) {
+        publish_flush_queued_.store(false, std::memory_order_release);
+        flushPublishPolicy(false);
+        return;
+    }
+
+    const uint64_t heap_start = heap::threadAllocations();
+    FrameArena::Scope arena_scope(persist_arena_);
+    const EmotionalState& state = frame.state;
+    const MatchResult& match = *frame.match;
+
+    // 14. CONSOLIDER EN MLT SI SIGNIFICATIF (délestée sous surcharge)
+    if (!frame.shed) {
+        ScopedLatency timer(metrics_.mlt_consolidation);
+        consolidateToMLT(frame);
+    }
 
     // 15. ENREGISTRER UN SOUVENIR SI SIGNIFICATIF
-    if (current_state_.getMeanIntensity() > match.memory_trigger_threshold) {
-        auto [dominant, value] = current_state_.getDominant();
-        std::string context = "Pattern:" + match.pattern_name + "_" + dominant;
-        memory_manager_.recordMemory(current_state_, current_phase, context);
+    if (frame.summary.meanIntensity() > match.memory_trigger_threshold) {
+        std::pmr::string context("Pattern:", persist_arena_.resource());
+        context.append(match.pattern_name).append("_").append(frame.summary.dominantName());
+        memory_manager_.recordMemory(state, frame.phase, context);
     }
 
-    // 16. PUBLIER L'ÉTAT
-    publishState();
+    // 16. PUBLIER L'ÉTAT (sous surcharge : seulement si aucun état plus récent n'attend),
+    //     selon la politique : changement significatif, débit borné, lots
+    if (publishIsStale(frame, persist_queue_.size())) {
+        ingest_publish_skipped_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        ScopedLatency timer(metrics_.publish_state);
+        publish_items_.clear();
+        publish_policy_.offer(state, frame.summary.dominant, frame.match, std::chrono::steady_clock::now(),
+                              publish_items_, frame.trace);
+        publishItems(publish_items_);
+    }
+    metrics_.end_to_end.recordSince(frame.ingest_time);
     
     // 17. CALLBACK
     if (on_state_change_) {
-        on_state_change_(current_state_, match.pattern_name);
+        on_state_change_(state, match.pattern_name);
     }
     
-    // Afficher l'état
-    printState();
+    // Afficher l'état (échantillonné : une trame sur state_log_interval)
+    size_t frame_number = frames_processed_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!frame.shed && pipeline_config_.state_log_interval > 0 &&
+        frame_number % pipeline_config_.state_log_interval == 0) {
+        printState(state, match);
+    }
+
+    frame_heap_allocations_.fetch_add(frame.heap_allocations + heap::threadAllocations() - heap_start,
+                                      std::memory_order_relaxed);
 }
 
-void MCEEEngine::printState() const {
-    auto [dominant, value] = current_state_.getDominant();
-    
-    std::cout << "\n[MCEEEngine] État émotionnel mis à jour:\n";
-    std::cout << "  Pattern   : " << current_match_.pattern_name 
-              << " (sim=" << std::fixed << std::setprecision(2) << current_match_.similarity 
-              << ", conf=" << current_match_.confidence << ")\n";
-    std::cout << "  Dominant  : " << dominant << " = " 
-              << std::fixed << std::setprecision(3) << value << "\n";
-    std::cout << "  E_global  : " << std::fixed << std::setprecision(3) 
-              << current_state_.E_global << "\n";
-    std::cout << "  Variance  : " << std::fixed << std::setprecision(3) 
-              << current_state_.variance_global << "\n";
-    std::cout << "  Valence   : " << std::fixed << std::setprecision(3) 
-              << current_state_.getValence() << "\n";
-    std::cout << "  Intensité : " << std::fixed << std::setprecision(3) 
-              << current_state_.getMeanIntensity() << "\n";
-    
-    // Afficher métriques MCT si disponible
+void MCEEEngine::printState(const EmotionalState& state, const MatchResult& match) const {
+    if (!Logger::instance().shouldLog(LogLevel::INFO)) return;
+
+    const auto summary = state.summarize();
+
+    MCEE_LOG_INFO("MCEEEngine",
+        "État: pattern=", match.pattern_name, std::fixed, std::setprecision(2),
+        " sim=", match.similarity, " conf=", match.confidence, std::setprecision(3),
+        " dominant=", summary.dominantName(), ":", summary.dominant_value, " E_global=", state.E_global,
+        " variance=", state.variance_global, " valence=", summary.valence(),
+        " intensité=", summary.meanIntensity());
+
+    // Métriques MCT si disponible
     if (mct_ && !mct_->empty()) {
-        std::cout << "  MCT       : size=" << mct_->size()
-                  << ", stability=" << std::fixed << std::setprecision(2) << mct_->getStability()
-                  << ", trend=" << mct_->getTrend() << "\n";
+        MCEE_LOG_INFO("MCEEEngine",
+            "MCT: size=", mct_->size(), std::fixed, std::setprecision(2),
+            " stability=", mct_->getStability(), " trend=", mct_->getTrend());
     }
 
-    // Afficher métriques MCTGraph si disponible
+    // Métriques MCTGraph si disponible
     if (mct_graph_ && (mct_graph_->getWordCount() > 0 || mct_graph_->getEmotionCount() > 0)) {
-        std::cout << "  MCTGraph  : " << mct_graph_->getWordCount() << " mots, "
-                  << mct_graph_->getEmotionCount() << " émotions, "
-                  << mct_graph_->getCausalEdgeCount() << " liens causaux\n";
+        MCEE_LOG_INFO("MCEEEngine",
+            "MCTGraph: ", mct_graph_->getWordCount(), " mots, ",
+            mct_graph_->getEmotionCount(), " émotions, ",
+            mct_graph_->getCausalEdgeCount(), " liens causaux");
     }
-    std::cout << "\n";
 }
 
-void MCEEEngine::publishState() {
-    if (!publish_channel_) return;
+void MCEEEngine::publishState(const EmotionalState& state, const MatchResult& match,
+                              std::pmr::memory_resource* scratch, bool emergency, int64_t trace) {
+    // Les urgences ont leur propre channel : jamais en attente derrière [persist]
+    const auto& channel = (emergency && emergency_channel_) ? emergency_channel_ : publish_channel_;
+    if (!channel) return;
 
     try {
-        json output;
-        
+        if (rabbitmq_config_.binary_state_output) {
+            // Trame compacte : émotions + E_global + pattern (le JSON reste le format de débogage)
+            EmotionFrame frame;
+            frame.timestamp_ms = wireNowMs();
+            frame.e_global = state.E_global;
+            frame.pattern_id = match.pattern_id;
+            for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+                frame.emotions[i] = state.emotions[i];
+            }
+
+            auto message = AmqpClient::BasicMessage::Create(
+                encodeEmotionFrame(frame, rabbitmq_config_.wire_precision));
+            message->ContentType(WIRE_CONTENT_TYPE_FRAME);
+            tagSession(message, trace);
+            channel->BasicPublish(
+                rabbitmq_config_.output_exchange,
+                rabbitmq_config_.output_routing_key,
+                message,
+                false, false
+            );
+            return;
+        }
+
+        // Texte écrit directement dans l'arène de l'étage (pas de DOM nlohmann)
+        std::pmr::string body(scratch);
+        body.reserve(2048);
+        JsonWriter out(body);
+        out.beginObject();
+
         // Émotions
+        out.key("emotions");
+        out.beginObject();
         for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-            output["emotions"][EMOTION_NAMES[i]] = current_state_.emotions[i];
+            out.field(EMOTION_NAMES[i], state.emotions[i]);
         }
+        out.endObject();
 
         // Méta-données
-        output["E_global"] = current_state_.E_global;
-        output["variance_global"] = current_state_.variance_global;
-        output["valence"] = current_state_.getValence();
-        output["intensity"] = current_state_.getMeanIntensity();
-        
-        auto [dominant, value] = current_state_.getDominant();
-        output["dominant"] = dominant;
-        output["dominant_value"] = value;
+        out.field("E_global", state.E_global);
+        out.field("variance_global", state.variance_global);
+        const auto summary = state.summarize();
+        out.field("valence", summary.valence());
+        out.field("intensity", summary.meanIntensity());
+        out.field("dominant", summary.dominantName());
+        out.field("dominant_value", summary.dominant_value);
+        out.field("emergency", emergency);
 
         // Pattern actif (v3.0)
-        output["pattern"]["id"] = current_match_.pattern_id;
-        output["pattern"]["name"] = current_match_.pattern_name;
-        output["pattern"]["similarity"] = current_match_.similarity;
-        output["pattern"]["confidence"] = current_match_.confidence;
-        output["pattern"]["is_new"] = current_match_.is_new_pattern;
-        output["pattern"]["is_transition"] = current_match_.is_transition;
+        out.key("pattern");
+        out.beginObject();
+        out.field("id", match.pattern_id);
+        out.field("name", match.pattern_name);
+        out.field("similarity", match.similarity);
+        out.field("confidence", match.confidence);
+        out.field("is_new", match.is_new_pattern);
+        out.field("is_transition", match.is_transition);
+        out.endObject();
 
         // Coefficients actifs (du pattern)
-        output["coefficients"]["alpha"] = current_match_.alpha;
-        output["coefficients"]["beta"] = current_match_.beta;
-        output["coefficients"]["gamma"] = current_match_.gamma;
-        output["coefficients"]["delta"] = current_match_.delta;
-        output["coefficients"]["theta"] = current_match_.theta;
-        output["coefficients"]["emergency_threshold"] = current_match_.emergency_threshold;
+        out.key("coefficients");
+        out.beginObject();
+        out.field("alpha", match.alpha);
+        out.field("beta", match.beta);
+        out.field("gamma", match.gamma);
+        out.field("delta", match.delta);
+        out.field("theta", match.theta);
+        out.field("emergency_threshold", match.emergency_threshold);
+        out.endObject();
 
         // Phase legacy (pour compatibilité)
-        output["phase"] = phaseToString(phase_detector_.getCurrentPhase());
-        output["phase_duration"] = phase_detector_.getPhaseDuration();
+        out.field("phase", phaseToString(phase_detector_.getCurrentPhase()));
+        out.field("phase_duration", phase_detector_.getPhaseDuration());
 
         // Métriques MCT
         if (mct_) {
-            output["mct"]["size"] = mct_->size();
-            output["mct"]["stability"] = mct_->getStability();
-            output["mct"]["volatility"] = mct_->getVolatility();
-            output["mct"]["trend"] = mct_->getTrend();
+            out.key("mct");
+            out.beginObject();
+            out.field("size", mct_->size());
+            out.field("stability", mct_->getStability());
+            out.field("volatility", mct_->getVolatility());
+            out.field("trend", mct_->getTrend());
+            out.endObject();
+        }
+
+        // Métriques MCTGraph (graphe relationnel)
+        if (mct_graph_) {
+            out.key("mct_graph");
+            out.beginObject();
+            out.field("word_count", mct_graph_->getWordCount());
+            out.field("emotion_count", mct_graph_->getEmotionCount());
+            out.field("edge_count", mct_graph_->getEdgeCount());
+            out.field("causal_edge_count", mct_graph_->getCausalEdgeCount());
+            out.field("density", mct_graph_->getGraphDensity());
+            out.endObject();
         }
 
-        // Métriques MCTGraph (graphe relationnel)
-        if (mct_graph_) {
-            output["mct_graph"]["word_count"] = mct_graph_->getWordCount();
-            output["mct_graph"]["emotion_count"] = mct_graph_->getEmotionCount();
-            output["mct_graph"]["edge_count"] = mct_graph_->getEdgeCount();
-            output["mct_graph"]["causal_edge_count"] = mct_graph_->getCausalEdgeCount();
-            output["mct_graph"]["density"] = mct_graph_->getGraphDensity();
+        // Statistiques
+        out.key("stats");
+        out.beginObject();
+        out.field("pattern_transitions", stats_.phase_transitions);
+        out.field("emergency_triggers", stats_.emergency_triggers);
+        out.field("wisdom", wisdom_);
+        if (mlt_) {
+            out.field("total_patterns", mlt_->patternCount());
+        }
+        if (pattern_matcher_) {
+            out.field("total_matches", pattern_matcher_->getTotalMatches());
+            out.field("patterns_created", pattern_matcher_->getPatternsCreated());
+        }
+        out.endObject();
+
+        out.endObject();
+
+        auto message = AmqpClient::BasicMessage::Create(std::string(body));
+        message->ContentType(WIRE_CONTENT_TYPE_JSON);
+        tagSession(message, trace);
+        channel->BasicPublish(
+            rabbitmq_config_.output_exchange,
+            rabbitmq_config_.output_routing_key,
+            message,
+            false, false
+        );
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur publication: ", e.what());
+    }
+}
+
+void MCEEEngine::publishItems(std::vector<PublishItem>& items) {
+    if (items.empty()) return;
+
+    if (items.size() == 1 || !rabbitmq_config_.binary_state_output) {
+        for (const auto& item : items) {
+            publishState(item.state, *item.match, persist_arena_.resource(), false, item.trace);
+            publish_policy_.recordMessage();
+        }
+        items.clear();
+        return;
+    }
+
+    // Lot binaire : un seul message pour les états retenus, du plus ancien au plus récent
+    if (!publish_channel_) return;
+    try {
+        std::vector<EmotionFrame> frames(items.size());
+        const int64_t timestamp_ms = wireNowMs();
+        int64_t trace = 0;      // Celle du plus ancien état du lot
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (trace == 0) trace = items[i].trace;
+            frames[i].timestamp_ms = timestamp_ms;
+            frames[i].e_global = items[i].state.E_global;
+            frames[i].pattern_id = items[i].match->pattern_id;
+            for (size_t e = 0; e < NUM_EMOTIONS; ++e) {
+                frames[i].emotions[e] = items[i].state.emotions[e];
+            }
+        }
+
+        auto message = AmqpClient::BasicMessage::Create(
+            encodeEmotionBatch(frames, rabbitmq_config_.wire_precision));
+        message->ContentType(WIRE_CONTENT_TYPE_BATCH);
+        tagSession(message, trace);
+        publish_channel_->BasicPublish(
+            rabbitmq_config_.output_exchange,
+            rabbitmq_config_.output_routing_key,
+            message,
+            false, false
+        );
+        publish_policy_.recordMessage();
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur publication du lot: ", e.what());
+    }
+    items.clear();
+}
+
+void MCEEEngine::flushPublishPolicy(bool force) {
+    FrameArena::Scope arena_scope(persist_arena_);
+    publish_items_.clear();
+    publish_policy_.flush(std::chrono::steady_clock::now(), publish_items_, force);
+    publishItems(publish_items_);
+}
+
+void MCEEEngine::publishTick() {
+    if (!publish_policy_.hasPending()) return;
+
+    if (pipeline_active_.load(std::memory_order_acquire)) {
+        // Le channel de publication appartient à [persist] : la vidange y passe
+        if (!publish_flush_queued_.exchange(true, std::memory_order_acq_rel)) {
+            PipelineFrame frame;
+            frame.kind = PipelineFrame::Kind::PUBLISH;
+            if (!persist_queue_.tryPush(std::move(frame))) {
+                publish_flush_queued_.store(false, std::memory_order_release);  // File pleine : états en route
+            }
         }
+        return;
+    }
 
-        // Statistiques
-        output["stats"]["pattern_transitions"] = stats_.phase_transitions;
-        output["stats"]["emergency_triggers"] = stats_.emergency_triggers;
-        output["stats"]["wisdom"] = wisdom_;
-        
-        if (mlt_) {
-            output["stats"]["total_patterns"] = mlt_->patternCount();
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    flushPublishPolicy(false);
+}
+
+void MCEEEngine::scheduleEmergencyDrain() {
+    // Ordonne le dépôt dans la file avant le test du drapeau (cf. drainEmergencyLane)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (emergency_drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        return;     // Vidange déjà programmée ou en cours : elle verra ce déclenchement
+    }
+    if (!executor_->post(TaskClass::EMERGENCY, [this]() { drainEmergencyLane(); })) {
+        // File EMERGENCY pleine : le prochain déclenchement réessaiera
+        emergency_drain_scheduled_.store(false, std::memory_order_release);
+    }
+}
+
+void MCEEEngine::drainEmergencyLane() {
+    EmergencyLaneEvent event;
+    while (true) {
+        while (emergency_lane_.tryNext(event)) {
+            publishEmergencyLane(emergency_lane_channel_, event);
         }
-        if (pattern_matcher_) {
-            output["stats"]["total_matches"] = pattern_matcher_->getTotalMatches();
-            output["stats"]["patterns_created"] = pattern_matcher_->getPatternsCreated();
+        emergency_drain_scheduled_.store(false, std::memory_order_release);
+
+        // Un déclenchement déposé après le dernier tryNext mais avant la remise
+        // à zéro n'a pas programmé de vidange : le reprendre ici
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (emergency_lane_.pending() == 0 ||
+            emergency_drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+            return;
         }
+    }
+}
 
-        std::string body = output.dump();
-        publish_channel_->BasicPublish(
-            rabbitmq_config_.output_exchange,
-            rabbitmq_config_.output_routing_key,
-            AmqpClient::BasicMessage::Create(body),
-            false, false
-        );
+void MCEEEngine::publishEmergencyLane(const AmqpClient::Channel::ptr_t& channel,
+                                      const EmergencyLaneEvent& event) {
+    EmergencyResponse response = EmergencyLane::toResponse(event);
 
-    } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur publication: " << e.what() << "\n";
+    if (channel) {
+        try {
+            json output;
+            output["type"] = "emergency";
+            output["action"] = response.action;
+            output["priority"] = response.priority;
+            output["trigger_emotion"] = response.trigger_emotion;
+            output["emotion_value"] = response.emotion_value;
+            output["threshold"] = event.threshold;
+            output["phase"] = phaseToString(response.phase_at_trigger);
+            output["timestamp_ms"] = wireNowMs();
+
+            auto message = AmqpClient::BasicMessage::Create(output.dump());
+            message->ContentType(WIRE_CONTENT_TYPE_JSON);
+            message->Priority(rabbitmq_config_.emergency_priority);
+            tagSession(message);
+            channel->BasicPublish(
+                rabbitmq_config_.output_exchange,
+                rabbitmq_config_.emergency_routing_key,
+                message,
+                false, false
+            );
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEEngine", "Erreur publication urgence: ", e.what());
+        }
     }
+
+    // Mesuré avant le journal : la latence couvre décision + publication
+    metrics_.emergency_lane.recordSince(event.ingest_time);
+
+    MCEE_LOG_WARN("MCEEEngine",
+        "⚡ Voie rapide: ", response.trigger_emotion, " = ", std::fixed, std::setprecision(3),
+        response.emotion_value, " > ", event.threshold, " → ", response.action,
+        " (", response.priority, ")");
 }
 
 void MCEEEngine::setFeedback(double external, double internal) {
-    std::lock_guard<std::mutex> lock(state_mutex_);
-    current_feedback_.external = std::clamp(external, -1.0, 1.0);
-    current_feedback_.internal = std::clamp(internal, -1.0, 1.0);
+    PipelineFrame frame;
+    frame.kind = PipelineFrame::Kind::FEEDBACK;
+    frame.feedback.external = std::clamp(external, -1.0, 1.0);
+    frame.feedback.internal = std::clamp(internal, -1.0, 1.0);
+    submitFrame(std::move(frame));
 }
 
 void MCEEEngine::setStateCallback(StateCallback callback) {
@@ -893,7 +1857,7 @@ void MCEEEngine::updateWisdom() {
 }
 
 void MCEEEngine::executeEmergencyAction(const EmergencyResponse& response) {
-    std::cout << "\n[MCEEEngine] ⚡ Exécution action d'urgence: " << response.action << "\n";
+    MCEE_LOG_INFO("MCEEEngine", "⚡ Exécution action d'urgence: ", response.action);
 
     // Actions spécifiques selon le type
     if (response.action == "FUITE") {
@@ -920,55 +1884,199 @@ bool MCEEEngine::loadConfig(const std::string& config_path, bool skip_neo4j) {
         emotion_updater_.setCoefficientsFromPhase(phase_detector_.getCurrentConfig());
     }
 
+    // Capacités des niveaux de souvenirs
+    MemoryTierConfig tier_config;
+    if (readMemoryTierConfig(config_path, tier_config)) {
+        memory_manager_.setTierConfig(tier_config);
+    }
+
+    PrefetchConfig prefetch_config;
+    if (prefetcher_ && readPrefetchConfig(config_path, prefetch_config)) {
+        prefetcher_->setConfig(prefetch_config);
+    }
+
+    PublishPolicyConfig publish_config;
+    if (readPublishPolicyConfig(config_path, publish_config)) {
+        if (!rabbitmq_config_.binary_state_output) {
+            publish_config.batch_max = 1;  // Lots : format binaire uniquement
+        }
+        publish_policy_.setConfig(publish_config);
+    }
+
     // Charger la configuration Neo4j si présente et non ignorée
-    if (!skip_neo4j) {
-        try {
-            std::ifstream file(config_path);
-            if (file.is_open()) {
-                json config = json::parse(file);
-
-                if (config.contains("neo4j") && config["neo4j"].value("enabled", false)) {
-                    Neo4jClientConfig neo4j_config;
-                    auto& neo4j_json = config["neo4j"];
-
-                    neo4j_config.rabbitmq_host = neo4j_json.value("rabbitmq_host", "localhost");
-                    neo4j_config.rabbitmq_port = neo4j_json.value("rabbitmq_port", 5672);
-                    neo4j_config.rabbitmq_user = neo4j_json.value("rabbitmq_user", "virtus");
-                    neo4j_config.rabbitmq_password = neo4j_json.value("rabbitmq_password", "virtus@83");
-                    neo4j_config.request_queue = neo4j_json.value("request_queue", "neo4j.requests.queue");
-                    neo4j_config.response_exchange = neo4j_json.value("response_exchange", "neo4j.responses");
-                    neo4j_config.request_timeout_ms = neo4j_json.value("request_timeout_ms", 5000);
-                    neo4j_config.max_retries = neo4j_json.value("max_retries", 3);
-                    neo4j_config.async_mode = neo4j_json.value("async_mode", true);
-
-                    std::cout << "[MCEEEngine] Configuration Neo4j..." << std::flush;
-                    if (memory_manager_.setNeo4jConfig(neo4j_config)) {
-                        std::cout << " activé et connecté" << std::endl;
-                    } else {
-                        std::cerr << " configuré mais non connecté" << std::endl;
-                    }
-                }
-            }
-        } catch (const std::exception& e) {
-            std::cerr << "[MCEEEngine] Erreur chargement config Neo4j: " << e.what() << "\n";
+    Neo4jClientConfig neo4j_config;
+    if (!skip_neo4j && readNeo4jConfig(config_path, neo4j_config)) {
+        if (memory_manager_.setNeo4jConfig(neo4j_config)) {
+            MCEE_LOG_INFO("MCEEEngine", "Configuration Neo4j: activé et connecté");
+        } else {
+            MCEE_LOG_WARN("MCEEEngine", "Configuration Neo4j: configuré mais non connecté");
         }
     }
 
     return success;
 }
 
-EmotionalState MCEEEngine::rawToState(
-    const std::unordered_map<std::string, double>& raw) const
-{
+bool MCEEEngine::readNeo4jConfig(const std::string& config_path, Neo4jClientConfig& neo4j_config) {
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) return false;
+
+        json config = json::parse(file);
+        if (!config.contains("neo4j") || !config["neo4j"].value("enabled", false)) {
+            return false;
+        }
+
+        auto& neo4j_json = config["neo4j"];
+        neo4j_config.rabbitmq_host = neo4j_json.value("rabbitmq_host", "localhost");
+        neo4j_config.rabbitmq_port = neo4j_json.value("rabbitmq_port", 5672);
+        neo4j_config.rabbitmq_user = neo4j_json.value("rabbitmq_user", "virtus");
+        neo4j_config.rabbitmq_password = neo4j_json.value("rabbitmq_password", "virtus@83");
+        neo4j_config.request_queue = neo4j_json.value("request_queue", "neo4j.requests.queue");
+        neo4j_config.response_exchange = neo4j_json.value("response_exchange", "neo4j.responses");
+        neo4j_config.request_timeout_ms = neo4j_json.value("request_timeout_ms", 5000);
+        neo4j_config.max_retries = neo4j_json.value("max_retries", 3);
+        neo4j_config.async_mode = neo4j_json.value("async_mode", true);
+        neo4j_config.enable_write_batching = neo4j_json.value("enable_write_batching", true);
+        neo4j_config.batch_max_size = neo4j_json.value("batch_max_size", 1000);
+        neo4j_config.batch_flush_interval_ms = neo4j_json.value("batch_flush_interval_ms", 50);
+        neo4j_config.batch_timeout_ms = neo4j_json.value("batch_timeout_ms", 30000);
+
+        // Transport Bolt natif (section "bolt" facultative)
+        neo4j_config.transport = neo4j_json.value("transport", "rabbitmq") == "bolt"
+            ? Neo4jTransport::BOLT : Neo4jTransport::RABBITMQ;
+        neo4j_config.bolt_fallback_rabbitmq = neo4j_json.value("bolt_fallback_rabbitmq", true);
+        if (neo4j_json.contains("bolt")) {
+            const auto& bolt_json = neo4j_json["bolt"];
+            bolt::BoltConfig& bolt = neo4j_config.bolt;
+            bolt.host = bolt_json.value("host", bolt.host);
+            bolt.port = bolt_json.value("port", bolt.port);
+            bolt.user = bolt_json.value("user", bolt.user);
+            bolt.password = bolt_json.value("password", bolt.password);
+            bolt.database = bolt_json.value("database", bolt.database);
+            bolt.pool_size = bolt_json.value("pool_size", bolt.pool_size);
+            bolt.connect_timeout_ms = bolt_json.value("connect_timeout_ms", bolt.connect_timeout_ms);
+            bolt.io_timeout_ms = bolt_json.value("io_timeout_ms", bolt.io_timeout_ms);
+        }
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur chargement config Neo4j: ", e.what());
+        return false;
+    }
+}
+
+bool MCEEEngine::readPrefetchConfig(const std::string& config_path, PrefetchConfig& prefetch_config) {
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) return false;
+
+        json config = json::parse(file);
+        if (!config.contains("prefetch")) return false;
+
+        auto& prefetch_json = config["prefetch"];
+        PrefetchConfig defaults;
+        prefetch_config.enabled = prefetch_json.value("enabled", defaults.enabled);
+        prefetch_config.max_targets = prefetch_json.value("max_targets", defaults.max_targets);
+        prefetch_config.min_probability = prefetch_json.value("min_probability", defaults.min_probability);
+        prefetch_config.memories_per_target =
+            prefetch_json.value("memories_per_target", defaults.memories_per_target);
+        prefetch_config.memory_threshold = prefetch_json.value("memory_threshold", defaults.memory_threshold);
+        prefetch_config.max_pending = prefetch_json.value("max_pending", defaults.max_pending);
+        prefetch_config.warm_search = prefetch_json.value("warm_search", defaults.warm_search);
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur chargement config prefetch: ", e.what());
+        return false;
+    }
+}
+
+bool MCEEEngine::readPublishPolicyConfig(const std::string& config_path, PublishPolicyConfig& publish_config) {
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) return false;
+
+        json config = json::parse(file);
+        if (!config.contains("publish")) return false;
+
+        auto& publish_json = config["publish"];
+        PublishPolicyConfig defaults;
+        publish_config.enabled = publish_json.value("enabled", defaults.enabled);
+        publish_config.min_e_global_delta = publish_json.value("min_e_global_delta", defaults.min_e_global_delta);
+        publish_config.on_dominant_change = publish_json.value("on_dominant_change", defaults.on_dominant_change);
+        publish_config.max_rate_hz = publish_json.value("max_rate_hz", defaults.max_rate_hz);
+        publish_config.heartbeat_seconds = publish_json.value("heartbeat_seconds", defaults.heartbeat_seconds);
+        publish_config.batch_max = publish_json.value("batch_max", defaults.batch_max);
+        publish_config.batch_delay_ms = publish_json.value("batch_delay_ms", defaults.batch_delay_ms);
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur chargement config publish: ", e.what());
+        return false;
+    }
+}
+
+bool MCEEEngine::readJournalConfig(const std::string& config_path, JournalConfig& journal_config) {
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) return false;
+
+        json config = json::parse(file);
+        if (!config.contains("journal")) return false;
+
+        auto& journal_json = config["journal"];
+        JournalConfig defaults;
+        journal_config.enabled = journal_json.value("enabled", defaults.enabled);
+        journal_config.directory = journal_json.value("directory", defaults.directory);
+        journal_config.commit_interval_ms = journal_json.value("commit_interval_ms", defaults.commit_interval_ms);
+        journal_config.group_commit_bytes = journal_json.value("group_commit_bytes", defaults.group_commit_bytes);
+        journal_config.sync = journal_json.value("sync", defaults.sync);
+        journal_config.checkpoint_interval_seconds =
+            journal_json.value("checkpoint_interval_seconds", defaults.checkpoint_interval_seconds);
+        journal_config.checkpoint_every_records =
+            journal_json.value("checkpoint_every_records", defaults.checkpoint_every_records);
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur chargement config journal: ", e.what());
+        return false;
+    }
+}
+
+bool MCEEEngine::readMemoryTierConfig(const std::string& config_path, MemoryTierConfig& tier_config) {
+    try {
+        std::ifstream file(config_path);
+        if (!file.is_open()) return false;
+
+        json config = json::parse(file);
+        if (!config.contains("memory")) return false;
+
+        auto& memory_json = config["memory"];
+        MemoryTierConfig defaults;
+        // "max_memories" : ancien nom de la capacité chaude
+        tier_config.hot_capacity = memory_json.value("hot_capacity",
+            memory_json.value("max_memories", defaults.hot_capacity));
+        tier_config.warm_capacity = memory_json.value("warm_capacity", defaults.warm_capacity);
+        tier_config.coalesce_similarity = memory_json.value("coalesce_similarity", defaults.coalesce_similarity);
+        tier_config.reinforcement = memory_json.value("reinforcement", defaults.reinforcement);
+        tier_config.weight_half_life_hours = memory_json.value("weight_half_life_hours",
+                                                              defaults.weight_half_life_hours);
+        tier_config.min_weight = memory_json.value("min_weight", defaults.min_weight);
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur chargement config mémoire: ", e.what());
+        return false;
+    }
+}
+
+EmotionalState MCEEEngine::rawToState(const std::array<double, NUM_EMOTIONS>& raw) {
     EmotionalState state;
     double sum = 0.0;
 
     for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-        auto it = raw.find(EMOTION_NAMES[i]);
-        if (it != raw.end()) {
-            state.emotions[i] = std::clamp(it->second, 0.0, 1.0);
-            sum += state.emotions[i];
-        }
+        state.emotions[i] = std::clamp(raw[i], 0.0, 1.0);
+        sum += state.emotions[i];
     }
 
     // Calculer E_global (moyenne des 24 émotions)
@@ -989,37 +2097,37 @@ EmotionalState MCEEEngine::rawToState(
 // MÉTHODES MCT/MLT V3.0
 // ═══════════════════════════════════════════════════════════════════════════
 
-void MCEEEngine::pushToMCT(const EmotionalState& state) {
+void MCEEEngine::pushToMCT(const EmotionalState& state, const SpeechAnalysis* speech) {
     if (!mct_) return;
     
-    if (!last_speech_analysis_.raw_text.empty()) {
+    if (speech && !speech->raw_text.empty()) {
         mct_->pushWithSpeech(state, 
-                             last_speech_analysis_.sentiment_score,
-                             last_speech_analysis_.arousal_score,
-                             last_speech_analysis_.raw_text);
+                             speech->sentiment_score,
+                             speech->arousal_score,
+                             speech->raw_text);
     } else {
         mct_->push(state);
     }
 }
 
-MatchResult MCEEEngine::identifyPattern() {
+std::shared_ptr<const MatchResult> MCEEEngine::identifyPattern() {
     if (!pattern_matcher_) {
         // Fallback si pas de PatternMatcher
-        MatchResult fallback;
-        fallback.pattern_name = "DEFAULT";
-        fallback.similarity = 0.0;
-        fallback.confidence = 0.0;
-        fallback.alpha = 0.3;
-        fallback.beta = 0.2;
-        fallback.gamma = 0.15;
-        fallback.delta = 0.1;
-        fallback.theta = 0.25;
-        fallback.emergency_threshold = 0.8;
-        fallback.memory_trigger_threshold = 0.5;
+        auto fallback = std::make_shared<MatchResult>();
+        fallback->pattern_name = "DEFAULT";
+        fallback->similarity = 0.0;
+        fallback->confidence = 0.0;
+        fallback->alpha = 0.3;
+        fallback->beta = 0.2;
+        fallback->gamma = 0.15;
+        fallback->delta = 0.1;
+        fallback->theta = 0.25;
+        fallback->emergency_threshold = 0.8;
+        fallback->memory_trigger_threshold = 0.5;
         return fallback;
     }
     
-    return pattern_matcher_->match();
+    return pattern_matcher_->matchShared();
 }
 
 EmotionalState MCEEEngine::applyPatternCoefficients(const EmotionalState& raw_state, 
@@ -1039,47 +2147,58 @@ EmotionalState MCEEEngine::applyPatternCoefficients(const EmotionalState& raw_st
     return result;
 }
 
-void MCEEEngine::consolidateToMLT() {
+void MCEEEngine::consolidateToMLT(const PipelineFrame& frame) {
     if (!mct_ || !mlt_ || !pattern_matcher_) return;
     
+    const MatchResult& match = *frame.match;
+    double sentiment = frame.speech ? frame.speech->sentiment_score : 0.0;
+    double urgency = frame.speech ? frame.speech->urgency_score : 0.0;
+
     // Vérifier si l'état actuel est significatif
-    double intensity = current_state_.getMeanIntensity();
+    double intensity = frame.state.getMeanIntensity();
     double stability = mct_->getStability();
     
-    bool is_significant = (intensity > current_match_.memory_trigger_threshold) ||
-                          (std::abs(last_speech_analysis_.sentiment_score) > 0.5) ||
-                          (last_speech_analysis_.urgency_score > 0.7);
+    bool is_significant = (intensity > match.memory_trigger_threshold) ||
+                          (std::abs(sentiment) > 0.5) ||
+                          (urgency > 0.7);
     
     if (!is_significant) return;
     
     // Si stable et significatif, renforcer le pattern actuel
-    if (stability > 0.6 && !current_match_.pattern_id.empty()) {
+    if (stability > 0.6 && !match.pattern_id.empty()) {
         auto sig_opt = mct_->extractSignature();
         if (sig_opt) {
             // Mettre à jour le pattern avec la nouvelle signature
-            double feedback = (last_speech_analysis_.sentiment_score + 1.0) / 2.0; // [0,1]
-            mlt_->updatePattern(current_match_.pattern_id, *sig_opt, feedback);
+            double feedback = (sentiment + 1.0) / 2.0; // [0,1]
+            mlt_->updatePattern(match.pattern_id, *sig_opt, feedback);
         }
     }
     
-    // Déclencher une passe d'apprentissage périodiquement
+    // Déclencher une passe d'apprentissage périodiquement (thread de la MLT :
+    // le matching continue pendant la recherche des fusions)
     if (stats_.phase_transitions % 10 == 0 && stats_.phase_transitions > 0) {
-        mlt_->runLearningPass();
+        mlt_->runLearningPassAsync();
     }
 }
 
-void MCEEEngine::handleEmergency(const MatchResult& match) {
+bool MCEEEngine::handleEmergency(const MatchResult& match, bool reflex, std::pmr::memory_resource* scratch) {
     // Vérifier le seuil d'urgence du pattern
     double max_emotion = 0.0;
     for (const auto& e : current_state_.emotions) {
         max_emotion = std::max(max_emotion, e);
     }
     
-    // Récupérer les souvenirs pertinents
+    // La voie rapide a déjà décidé et publié : seuls les effets internes restent à appliquer
     Phase current_phase = phase_detector_.getCurrentPhase();
-    auto memories = memory_manager_.queryRelevantMemories(current_phase, current_state_, 5);
-    
-    if (amyghaleon_.checkEmergency(current_state_, memories, match.emergency_threshold)) {
+    bool triggered = reflex;
+    if (!triggered) {
+        // Récupérer les souvenirs pertinents (traumas activés)
+        std::pmr::vector<MemoryRef> memories(scratch);
+        memory_manager_.queryRelevantMemories(current_phase, current_state_, 5, memories);
+        triggered = amyghaleon_.checkEmergency(current_state_, memories, match.emergency_threshold);
+    }
+
+    if (triggered) {
         auto response = amyghaleon_.triggerEmergencyResponse(current_state_, current_phase);
         
         // Créer un trauma potentiel si pattern est PEUR ou similaire
@@ -1089,8 +2208,10 @@ void MCEEEngine::handleEmergency(const MatchResult& match) {
         }
         
         // Court-circuiter et publier l'état d'urgence
-        publishState();
+        publishState(current_state_, match, scratch, true);
+        return true;
     }
+    return false;
 }
 
 std::string MCEEEngine::getCurrentPatternName() const {
@@ -1131,12 +2252,12 @@ void MCEEEngine::forcePattern(const std::string& pattern_name, const std::string
         current_match_.theta = pattern->theta;
         current_match_.emergency_threshold = pattern->emergency_threshold;
         current_match_.memory_trigger_threshold = pattern->memory_trigger_threshold;
+        emergency_lane_.setThreshold(pattern->emergency_threshold);
         
         // Notifier le PatternMatcher
         pattern_matcher_->notifyPatternChange(pattern->id);
         
-        std::cout << "[MCEEEngine] Pattern forcé: " << pattern_name 
-                  << " (raison: " << reason << ")\n";
+        MCEE_LOG_INFO("MCEEEngine", "Pattern forcé: ", pattern_name, " (raison: ", reason, ")");
     }
 }
 
@@ -1154,7 +2275,7 @@ void MCEEEngine::provideFeedback(double feedback) {
 void MCEEEngine::runLearning() {
     if (!mlt_) return;
     mlt_->runLearningPass();
-    std::cout << "[MCEEEngine] Passe d'apprentissage MLT terminée\n";
+    MCEE_LOG_INFO("MCEEEngine", "Passe d'apprentissage MLT terminée");
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -1162,60 +2283,469 @@ void MCEEEngine::runLearning() {
 // ═══════════════════════════════════════════════════════════════════════════
 
 void MCEEEngine::tokensConsumeLoop() {
-    std::cout << "[MCEEEngine] Boucle de consommation des tokens démarrée" << std::endl;
+    MCEE_LOG_INFO("MCEEEngine", "Boucle de consommation des tokens démarrée");
 
-    while (running_.load()) {
-        try {
-            AmqpClient::Envelope::ptr_t envelope;
-            bool received = tokens_channel_->BasicConsumeMessage(tokens_consumer_tag_, envelope, 500);
+    consumeBatchLoop(tokens_channel_, tokens_consumer_tag_, "tokens",
+        [this](const std::vector<AmqpClient::BasicMessage::ptr_t>& messages) {
+            for (const auto& message : messages) {
+                handleTokensMessage(message->Body());
+            }
+        });
+}
+
+void MCEEEngine::startTimers() {
+    auto seconds = [](double s) {
+        return std::max<std::chrono::steady_clock::duration>(std::chrono::milliseconds(1),
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(s)));
+    };
+
+    // Plus de thread qui dort entre deux ticks : la minuterie de l'Executor
+    // soumet chaque tick en BACKGROUND, après celui d'avant
+    timer_source_ = CancellationSource();
+    snapshot_timer_ = executor_->schedulePeriodic(
+        seconds(mct_graph_->getConfig().snapshot_interval_seconds), TaskClass::BACKGROUND,
+        [this]() { graphTick(running_); }, timer_source_.token());
+
+    if (metrics_channel_) {
+        metrics_timer_ = executor_->schedulePeriodic(
+            seconds(rabbitmq_config_.metrics_interval_seconds), TaskClass::BACKGROUND,
+            [this]() { publishMetrics(); }, timer_source_.token());
+    }
+
+    // États retenus par la politique de publication : publiés même si le flux s'arrête
+    if (publish_policy_.getConfig().enabled) {
+        publish_timer_ = executor_->schedulePeriodic(
+            publish_policy_.flushInterval(), TaskClass::BACKGROUND,
+            [this]() { publishTick(); }, timer_source_.token());
+    }
+}
+
+void MCEEEngine::graphTick(const std::atomic<bool>& keep_going) {
+    if (!mct_graph_) return;
+
+    // Taille d'une tranche de maintenance : borne l'attente d'un consommateur
+    constexpr size_t MAINTENANCE_BUDGET = 256;
+
+    // Seules les modifications depuis le dernier message sont copiées
+    // sous le verrou ; keyframe complète à intervalle régulier
+    publishGraphDelta(mct_graph_->captureDelta());
+
+    // Maintenance incrémentale : le verrou est rendu entre les tranches
+    mct_graph_->applyEdgeDecay();
+    while (keep_going.load() && mct_graph_->maintenanceStep(MAINTENANCE_BUDGET)) {
+        std::this_thread::yield();
+    }
+}
+
+void MCEEEngine::attachPublishChannel(AmqpClient::Channel::ptr_t channel) {
+    publish_channel_ = channel;
+    emergency_channel_ = std::move(channel);
+}
+
+void MCEEEngine::tagSession(const AmqpClient::BasicMessage::ptr_t& message, int64_t trace) const {
+    if (session_id_.empty() && trace == 0) return;
+    AmqpClient::Table headers;
+    if (!session_id_.empty()) {
+        headers[rabbitmq_config_.session_header] = AmqpClient::TableValue(session_id_);
+    }
+    if (trace != 0) {
+        headers[rabbitmq_config_.trace_header] = AmqpClient::TableValue(trace);
+    }
+    message->HeaderTable(headers);
+}
+
+EngineFootprint MCEEEngine::memoryFootprint() const {
+    EngineFootprint footprint;
+    footprint.mct = mct_ ? mct_->memoryUsage() : 0;
+    footprint.graph = mct_graph_ ? mct_graph_->memoryUsage() : 0;
+    footprint.memories = memory_manager_.memoryUsage();
+    footprint.speech = speech_input_.memoryUsage();
+
+    // Modules sans allocation notable hors de l'objet, et cellules des files
+    footprint.engine = sizeof(*this) - sizeof(memory_manager_) - sizeof(speech_input_);
+    footprint.engine += sizeof(PatternMatcher) + sizeof(ConscienceEngine) + sizeof(ADDOEngine);
+    footprint.engine += sizeof(DecisionEngine) + sizeof(HybridSearchEngine);
+    footprint.engine += (match_queue_.capacity() + update_queue_.capacity() + persist_queue_.capacity())
+                        * sizeof(PipelineFrame);
+    return footprint;
+}
+
+namespace {
+
+nlohmann::json stateToJson(const EmotionalState& state) {
+    return {
+        {"emotions", state.emotions},
+        {"E_global", state.E_global},
+        {"variance_global", state.variance_global}
+    };
+}
+
+void stateFromJson(const nlohmann::json& j, EmotionalState& state) {
+    if (j.contains("emotions")) {
+        const auto& emotions = j["emotions"];
+        for (size_t i = 0; i < NUM_EMOTIONS && i < emotions.size(); ++i) {
+            state.emotions[i] = emotions[i];
+        }
+    }
+    state.E_global = j.value("E_global", 0.0);
+    state.variance_global = j.value("variance_global", 0.0);
+    state.timestamp = SessionClock::now();
+}
+
+} // namespace
+
+void MCEEEngine::captureMatchState(nlohmann::json& j) const {
+    j["mct"] = mct_->toJson();
+    j["pattern_matcher"] = pattern_matcher_->toJson();
+    j["graph"] = mct_graph_->toJson();
+    j["match"] = {
+        {"pattern_id", current_match_.pattern_id},
+        {"pattern_name", current_match_.pattern_name},
+        {"similarity", current_match_.similarity},
+        {"confidence", current_match_.confidence}
+    };
+}
+
+void MCEEEngine::captureUpdateState(nlohmann::json& j) const {
+    j["current_state"] = stateToJson(current_state_);
+    j["previous_state"] = stateToJson(previous_state_);
+    j["wisdom"] = wisdom_;
+}
+
+
+nlohmann::json MCEEEngine::exportSessionState() const {
+    nlohmann::json j;
+    j["session_id"] = session_id_;
+    captureMatchState(j);
+    captureUpdateState(j);
+    return j;
+}
+
+void MCEEEngine::importSessionState(const nlohmann::json& j) {
+    if (j.contains("mct")) mct_->fromJson(j["mct"]);
+    if (j.contains("pattern_matcher")) pattern_matcher_->fromJson(j["pattern_matcher"]);
+    if (j.contains("graph")) mct_graph_->loadFromJson(j["graph"]);
+    if (j.contains("current_state")) stateFromJson(j["current_state"], current_state_);
+    if (j.contains("previous_state")) stateFromJson(j["previous_state"], previous_state_);
+    if (j.contains("match")) {
+        const auto& m = j["match"];
+        current_match_.pattern_id = m.value("pattern_id", std::string());
+        current_match_.pattern_name = m.value("pattern_name", std::string());
+        current_match_.similarity = m.value("similarity", 0.0);
+        current_match_.confidence = m.value("confidence", 0.0);
+    }
+    wisdom_ = j.value("wisdom", wisdom_);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// JOURNAL D'ÉTAT
+// ═══════════════════════════════════════════════════════════════════════════
+
+void MCEEEngine::journalFrame(const PipelineFrame& frame) {
+    JournalPayloadWriter out(journal_scratch_);
+    JournalRecordType type = JournalRecordType::EMOTIONS;
+
+    switch (frame.kind) {
+        case PipelineFrame::Kind::EMOTIONS:
+            // État après fusion éventuelle : c'est lui que [match] applique
+            for (double value : frame.state.emotions) out.put(value);
+            out.put(static_cast<uint8_t>(frame.reflex));
+            break;
+
+        case PipelineFrame::Kind::SPEECH: {
+            type = JournalRecordType::SPEECH;
+            const SpeechAnalysis empty;
+            const SpeechAnalysis& speech = frame.speech ? *frame.speech : empty;
+            out.put(frame.feedback.external);
+            out.put(speech.sentiment_score);
+            out.put(speech.arousal_score);
+            out.put(speech.urgency_score);
+            out.putString(speech.raw_text);
+            out.putString(frame.memory_context);
+            break;
+        }
+
+        case PipelineFrame::Kind::FEEDBACK:
+            type = JournalRecordType::FEEDBACK;
+            out.put(frame.feedback.external);
+            out.put(frame.feedback.internal);
+            break;
+
+        case PipelineFrame::Kind::URGENCY:
+            type = JournalRecordType::URGENCY;
+            out.put(frame.feedback.internal);
+            break;
+
+        case PipelineFrame::Kind::CHECKPOINT:
+        case PipelineFrame::Kind::PUBLISH:
+            return;
+    }
+
+    journal_->append(type, journal_scratch_);
+}
+
+bool MCEEEngine::beginCheckpoint(PipelineFrame& frame, bool force) {
+    if (!journal_ || !journal_->checkpointDue(force)) {
+        return false;
+    }
 
-            if (received && envelope) {
-                std::string body(envelope->Message()->Body().begin(),
-                                envelope->Message()->Body().end());
+    // Aucun message tokens entre la lecture du numéro et la capture du graphe ;
+    // réservé sous le verrou pour qu'une seule trame CHECKPOINT soit en route
+    std::lock_guard<std::mutex> lock(journal_tokens_mutex_);
+    if (!journal_->beginCheckpoint(force)) {
+        return false;
+    }
+    try {
+        frame.kind = PipelineFrame::Kind::CHECKPOINT;
+        frame.checkpoint_seq = journal_->lastSeq();
+        frame.checkpoint = std::make_shared<nlohmann::json>();
+        captureMatchState(*frame.checkpoint);
+    } catch (...) {
+        journal_->abandonCheckpoint();
+        throw;
+    }
+    return true;
+}
 
-                handleTokensMessage(body);
-                tokens_channel_->BasicAck(envelope);
+void MCEEEngine::completeCheckpoint(PipelineFrame& frame) {
+    try {
+        // Trames ≤ checkpoint_seq encore en aval : leurs souvenirs et leur consolidation MLT
+        // font partie de l'état ; les suivantes attendent derrière cette trame
+        const uint64_t target = persist_forwarded_.load(std::memory_order_acquire);
+        size_t spins = 0;
+        while (persist_completed_.load(std::memory_order_acquire) < target &&
+               persist_stage_running_.load(std::memory_order_acquire)) {
+            if (spins++ < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
             }
+        }
 
-        } catch (const std::exception& e) {
-            std::cerr << "[MCEEEngine] Erreur consommation tokens: " << e.what() << "\n";
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+        // Parts propres à la reprise locale (le transfert de session ne les porte pas)
+        nlohmann::json& state = *frame.checkpoint;
+        captureUpdateState(state);
+        state["feedback"] = {
+            {"external", current_feedback_.external}, {"internal", current_feedback_.internal}
+        };
+        if (conscience_engine_) state["conscience"] = conscience_engine_->toJson();
+        if (addo_engine_) state["addo"] = addo_engine_->toJson();
+
+        nlohmann::json memories = nlohmann::json::array();
+        for (const auto& memory : memory_manager_.getAllMemories()) {
+            memories.push_back({
+                {"name", memory.name},
+                {"emotions", memory.emotions},
+                {"dominant", memory.dominant},
+                {"valence", memory.valence},
+                {"intensity", memory.intensity},
+                {"weight", memory.weight},
+                {"activation", memory.activation},
+                {"is_trauma", memory.is_trauma},
+                {"phase", static_cast<int>(memory.phase_at_creation)},
+                {"activation_count", memory.activation_count}
+            });
+        }
+        state["memories"] = std::move(memories);
+
+        PatternSnapshotWriter write_patterns;
+        if (mlt_) {
+            write_patterns = [data = std::make_shared<const std::string>(mlt_->encodeSnapshot())](
+                                 const std::string& path) {
+                std::string error;
+                if (!writeFileAtomic(path, *data, &error)) {
+                    MCEE_LOG_WARN("MCEEEngine", "Snapshot MLT non écrit (", path, "): ", error);
+                    return false;
+                }
+                return true;
+            };
         }
+        journal_->checkpoint(frame.checkpoint_seq, std::move(state), std::move(write_patterns));
+    } catch (...) {
+        journal_->abandonCheckpoint();
+        throw;
     }
 }
 
-void MCEEEngine::snapshotTimerLoop() {
-    std::cout << "[MCEEEngine] Timer snapshot MCTGraph démarré" << std::endl;
+void MCEEEngine::applyJournalRecord(const JournalRecord& record) {
+    JournalPayloadReader in(record.payload);
+    PipelineFrame frame;
+    bool valid = true;
+
+    switch (record.type) {
+        case JournalRecordType::EMOTIONS: {
+            std::array<double, NUM_EMOTIONS> values{};
+            for (double& value : values) valid = valid && in.get(value);
+            uint8_t reflex = 0;
+            valid = valid && in.get(reflex);
+            frame.kind = PipelineFrame::Kind::EMOTIONS;
+            frame.state = rawToState(values);
+            frame.reflex = reflex != 0;  // Urgence déjà publiée avant l'arrêt
+            break;
+        }
 
-    // Utiliser l'intervalle de snapshot configuré au lieu de polling toutes les 500ms
-    const auto snapshot_interval = std::chrono::milliseconds(
-        static_cast<int>(mct_graph_->getConfig().snapshot_interval_seconds * 1000)
-    );
+        case JournalRecordType::SPEECH: {
+            auto speech = std::make_shared<SpeechAnalysis>();
+            std::string_view text, context;
+            valid = in.get(frame.feedback.external) && in.get(speech->sentiment_score) &&
+                    in.get(speech->arousal_score) && in.get(speech->urgency_score) &&
+                    in.getString(text) && in.getString(context);
+            speech->raw_text = text;
+            frame.kind = PipelineFrame::Kind::SPEECH;
+            frame.memory_context = context;
+            frame.speech = std::move(speech);
+            break;
+        }
 
-    while (running_.load()) {
-        // Attendre l'intervalle de snapshot complet
-        std::this_thread::sleep_for(snapshot_interval);
+        case JournalRecordType::FEEDBACK:
+            frame.kind = PipelineFrame::Kind::FEEDBACK;
+            valid = in.get(frame.feedback.external) && in.get(frame.feedback.internal);
+            break;
 
-        if (!running_.load()) break;
+        case JournalRecordType::URGENCY:
+            frame.kind = PipelineFrame::Kind::URGENCY;
+            valid = in.get(frame.feedback.internal);
+            break;
 
-        if (mct_graph_) {
-            // Créer et publier le snapshot directement
-            auto snapshot = mct_graph_->createSnapshot();
-            publishSnapshot(snapshot);
+        case JournalRecordType::TOKENS:
+            handleTokensMessage(std::string(record.payload));
+            return;
+
+        default:
+            valid = false;
+            break;
+    }
 
-            // Maintenance périodique du graphe
-            mct_graph_->pruneExpiredNodes();
-            mct_graph_->applyEdgeDecay();
+    if (!valid) {
+        MCEE_LOG_WARN("MCEEEngine", "Enregistrement #", record.seq, " du journal ignoré (charge invalide)");
+        return;
+    }
+    frame.ingest_time = std::chrono::steady_clock::now();
+    processPipeline(frame);
+}
+
+bool MCEEEngine::enableJournal(const JournalConfig& config) {
+    if (!session_id_.empty()) {
+        MCEE_LOG_WARN("MCEEEngine", "Journal ignoré pour la session hébergée ", session_id_);
+        return false;
+    }
+    if (running_.load()) {
+        MCEE_LOG_ERROR("MCEEEngine", "Journal à activer avant start()");
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    JournalRecovery recovery;
+    std::string error;
+    if (!StateJournal::readCheckpoint(config.directory, recovery, &error)) {
+        MCEE_LOG_ERROR("MCEEEngine", "Checkpoint illisible: ", error);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+
+    // 1. Dernier checkpoint
+    if (recovery.has_checkpoint) {
+        const nlohmann::json& state = recovery.state;
+        importSessionState(state);
+        if (state.contains("feedback")) {
+            current_feedback_.external = state["feedback"].value("external", 0.0);
+            current_feedback_.internal = state["feedback"].value("internal", 0.0);
+        }
+        if (conscience_engine_ && state.contains("conscience")) {
+            conscience_engine_->fromJson(state["conscience"]);
         }
+        if (addo_engine_ && state.contains("addo")) {
+            addo_engine_->fromJson(state["addo"]);
+        }
+        if (state.contains("memories")) {
+            std::vector<Memory> memories;
+            memories.reserve(state["memories"].size());
+            for (const auto& m : state["memories"]) {
+                Memory memory;
+                memory.name = m.value("name", std::string());
+                const auto& emotions = m["emotions"];
+                for (size_t i = 0; i < NUM_EMOTIONS && i < emotions.size(); ++i) {
+                    memory.emotions[i] = emotions[i];
+                }
+                memory.dominant = m.value("dominant", std::string());
+                memory.valence = m.value("valence", 0.0);
+                memory.intensity = m.value("intensity", 0.0);
+                memory.weight = m.value("weight", 0.5);
+                memory.activation = m.value("activation", 0.0);
+                memory.is_trauma = m.value("is_trauma", false);
+                memory.phase_at_creation = static_cast<Phase>(m.value("phase", 0));
+                memory.activation_count = m.value("activation_count", 0);
+                memory.last_activated = std::chrono::system_clock::now();
+                memories.push_back(std::move(memory));
+            }
+            memory_manager_.importMemories(memories);
+        }
+        if (mlt_ && !recovery.patterns_path.empty() && !mlt_->loadSnapshot(recovery.patterns_path)) {
+            MCEE_LOG_WARN("MCEEEngine", "Snapshot MLT du checkpoint illisible: ", recovery.patterns_path);
+        }
+    }
+
+    // 2. Enregistrements postérieurs, rejoués en synchrone (journal_ encore nul : rien n'est rejournalisé)
+    StateJournal::replay(config.directory, recovery,
+                         [this](const JournalRecord& record) { applyJournalRecord(record); });
+
+    auto journal = std::make_unique<StateJournal>();
+    if (!journal->open(config, recovery.last_seq)) {
+        return false;
+    }
+    journal_ = std::move(journal);
+    journal_recovered_ = recovery.replayed;
+    journal_recovery_ms_ = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    MCEE_LOG_INFO("MCEEEngine",
+        "Reprise du journal: checkpoint #", recovery.checkpoint_seq,
+        recovery.has_checkpoint ? "" : " (aucun)", ", ", recovery.replayed,
+        " enregistrements rejoués en ", std::fixed, std::setprecision(1), journal_recovery_ms_, " ms",
+        recovery.truncated_segments > 0 ? " (fin de segment invalide ignorée)" : "");
+    return true;
+}
+
+JournalStats MCEEEngine::getJournalStats() const {
+    if (!journal_) return JournalStats{};
+    JournalStats stats = journal_->getStats();
+    stats.recovered_records = journal_recovered_;
+    stats.recovery_ms = journal_recovery_ms_;
+    return stats;
+}
+
+void MCEEEngine::publishMetrics() {
+    if (!metrics_channel_) return;
+
+    try {
+        auto message = AmqpClient::BasicMessage::Create(renderMetrics());
+        message->ContentType(PROMETHEUS_CONTENT_TYPE);
+        metrics_channel_->BasicPublish(
+            rabbitmq_config_.metrics_exchange,
+            rabbitmq_config_.metrics_routing_key,
+            message,
+            false, false
+        );
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur publication métriques: ", e.what());
     }
 }
 
 void MCEEEngine::handleTokensMessage(const std::string& body) {
+    if (trace_writer_) {
+        trace_writer_->record(session_id_, MCEEInput::TOKENS, body);
+    }
     if (!mct_graph_) return;
 
-    try {
-        json input = json::parse(body);
+    // Journalisé puis appliqué sans checkpoint intercalé
+    std::unique_lock<std::mutex> journal_lock;
+    if (journal_) {
+        journal_lock = std::unique_lock<std::mutex>(journal_tokens_mutex_);
+        journal_->append(JournalRecordType::TOKENS, body);
+    }
 
+    try {
         // Format attendu :
         // {
         //   "sentence_id": "...",
@@ -1228,19 +2758,67 @@ void MCEEEngine::handleTokensMessage(const std::string& body) {
         //     ...
         //   ]
         // }
+        //
+        // Sans DOM : sentence_id peut suivre les tableaux, qui sont capturés
+        // tels quels puis relus une fois l'enveloppe parcourue
+        std::string_view sentence_id, tokens_json, relations_json;
+        std::string sentence_scratch;
+
+        JsonScanner scan(body);
+        scan.beginObject();
+        std::string_view key;
+        while (scan.nextField(key)) {
+            if (key == "sentence_id") {
+                sentence_id = scan.readString(sentence_scratch);
+            } else if (key == "tokens" && scan.peek() == JsonType::ARRAY) {
+                tokens_json = scan.captureValue();
+            } else if (key == "relations" && scan.peek() == JsonType::ARRAY) {
+                relations_json = scan.captureValue();
+            } else {
+                scan.skipValue();
+            }
+        }
+        scan.expectEnd();
 
-        std::string sentence_id = input.value("sentence_id", "");
         std::vector<std::string> word_ids;
 
-        // Ajouter les tokens au graphe
-        if (input.contains("tokens") && input["tokens"].is_array()) {
-            for (const auto& token : input["tokens"]) {
-                std::string lemma = token.value("lemma", token.value("text", ""));
-                std::string pos = token.value("pos", "UNKNOWN");
-                std::string original = token.value("text", lemma);
+        // Sous surcharge, les mots sont ajoutés sans détection de liens
+        const bool shed = rabbitmq_config_.ingest_shed && pipeline_active_.load(std::memory_order_acquire) &&
+                          rabbitmq_config_.ingest_coalesce_depth > 0 &&
+                          match_queue_.size() >= rabbitmq_config_.ingest_coalesce_depth;
+        if (shed) {
+            ingest_shed_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Ajouter les tokens au graphe (nœuds construits depuis les vues)
+        if (!tokens_json.empty()) {
+            std::string text_scratch, lemma_scratch, pos_scratch;
+            JsonScanner tokens(tokens_json);
+            tokens.beginArray();
+            while (tokens.nextElement()) {
+                std::string_view text, lemma, pos = "UNKNOWN";
+                bool has_text = false, has_lemma = false;
+
+                tokens.beginObject();
+                while (tokens.nextField(key)) {
+                    if (key == "text") {
+                        text = tokens.readString(text_scratch);
+                        has_text = true;
+                    } else if (key == "lemma") {
+                        lemma = tokens.readString(lemma_scratch);
+                        has_lemma = true;
+                    } else if (key == "pos") {
+                        pos = tokens.readString(pos_scratch);
+                    } else {
+                        tokens.skipValue();
+                    }
+                }
+                if (!has_lemma) lemma = text;
+                std::string_view original = has_text ? text : lemma;
 
                 std::string word_id = mct_graph_->addWord(lemma, pos, sentence_id, original);
                 word_ids.push_back(word_id);
+                if (shed) continue;
 
                 // Détecter les co-occurrences temporelles
                 mct_graph_->detectTemporalCooccurrences(word_id);
@@ -1253,27 +2831,38 @@ void MCEEEngine::handleTokensMessage(const std::string& body) {
         }
 
         // Ajouter les relations sémantiques
-        if (input.contains("relations") && input["relations"].is_array()) {
-            for (const auto& rel : input["relations"]) {
-                size_t source_idx = rel.value("source", size_t(0));
-                size_t target_idx = rel.value("target", size_t(0));
-                std::string rel_type = rel.value("type", "related");
+        if (!relations_json.empty()) {
+            std::string type_scratch;
+            JsonScanner relations(relations_json);
+            relations.beginArray();
+            while (relations.nextElement()) {
+                double source_idx = 0.0, target_idx = 0.0;
+                std::string_view rel_type = "related";
+
+                relations.beginObject();
+                while (relations.nextField(key)) {
+                    if (key == "source") source_idx = relations.readNumber();
+                    else if (key == "target") target_idx = relations.readNumber();
+                    else if (key == "type") rel_type = relations.readString(type_scratch);
+                    else relations.skipValue();
+                }
 
-                if (source_idx < word_ids.size() && target_idx < word_ids.size()) {
+                if (source_idx >= 0.0 && target_idx >= 0.0 &&
+                    source_idx < static_cast<double>(word_ids.size()) &&
+                    target_idx < static_cast<double>(word_ids.size())) {
                     mct_graph_->addSemanticEdge(
-                        word_ids[source_idx],
-                        word_ids[target_idx],
-                        rel_type
+                        word_ids[static_cast<size_t>(source_idx)],
+                        word_ids[static_cast<size_t>(target_idx)],
+                        std::string(rel_type)
                     );
                 }
             }
         }
 
-        std::cout << "[MCEEEngine] Tokens traités: " << word_ids.size()
-                  << " mots ajoutés au MCTGraph\n";
+        MCEE_LOG_INFO("MCEEEngine", "Tokens traités: ", word_ids.size(), " mots ajoutés au MCTGraph");
 
     } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur parsing JSON tokens: " << e.what() << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur parsing JSON tokens: ", e.what());
     }
 }
 
@@ -1288,21 +2877,59 @@ void MCEEEngine::publishSnapshot(const MCTGraphSnapshot& snapshot) {
         output["pattern"] = current_match_.pattern_name;
         output["pattern_confidence"] = current_match_.confidence;
 
+        auto message = AmqpClient::BasicMessage::Create(output.dump());
+        tagSession(message);
+        publish_channel_->BasicPublish(
+            rabbitmq_config_.snapshot_exchange,
+            rabbitmq_config_.snapshot_routing_key,
+            message,
+            false, false
+        );
+
+        MCEE_LOG_INFO("MCEEEngine",
+            "Snapshot MCTGraph publié: ", snapshot.stats.total_words, " mots, ",
+            snapshot.stats.total_emotions, " émotions, ", snapshot.stats.causal_edges,
+            " liens causaux");
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur publication snapshot: ", e.what());
+    }
+}
+
+void MCEEEngine::publishGraphDelta(const MCTGraphDelta& delta) {
+    if (!publish_channel_) return;
+
+    try {
+        json output = delta.toJson();
+
+        // Ajouter des métadonnées
+        output["source"] = "mcee";
+        output["pattern"] = current_match_.pattern_name;
+        output["pattern_confidence"] = current_match_.confidence;
+
         std::string body = output.dump();
+        auto message = AmqpClient::BasicMessage::Create(body);
+        tagSession(message);
         publish_channel_->BasicPublish(
             rabbitmq_config_.snapshot_exchange,
             rabbitmq_config_.snapshot_routing_key,
-            AmqpClient::BasicMessage::Create(body),
+            message,
             false, false
         );
 
-        std::cout << "[MCEEEngine] Snapshot MCTGraph publié: "
-                  << snapshot.stats.total_words << " mots, "
-                  << snapshot.stats.total_emotions << " émotions, "
-                  << snapshot.stats.causal_edges << " liens causaux\n";
+        if (delta.keyframe) {
+            MCEE_LOG_INFO("MCEEEngine",
+                "Keyframe MCTGraph publiée (seq ", delta.sequence, "): ", delta.stats.total_words,
+                " mots, ", delta.stats.total_emotions, " émotions, ", delta.stats.causal_edges,
+                " liens causaux");
+        } else {
+            MCEE_LOG_DEBUG("MCEEEngine",
+                "Delta MCTGraph publié (seq ", delta.sequence, "): ", delta.changeCount(),
+                " changement(s), ", body.size(), " octets");
+        }
 
     } catch (const std::exception& e) {
-        std::cerr << "[MCEEEngine] Erreur publication snapshot: " << e.what() << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur publication delta MCTGraph: ", e.what());
     }
 }
 
@@ -1353,8 +2980,7 @@ std::string MCEEEngine::generateEmotionalResponse(
 {
     // Vérifier que le LLMClient est prêt
     if (!llm_client_ || !llm_client_->isReady()) {
-        std::cerr << "[MCEEEngine] LLMClient non disponible. "
-                  << "Définissez OPENAI_API_KEY pour activer.\n";
+        MCEE_LOG_ERROR("MCEEEngine", "LLMClient non disponible. ", "Définissez OPENAI_API_KEY pour activer.");
         return "";
     }
 
@@ -1376,10 +3002,9 @@ std::string MCEEEngine::generateEmotionalResponse(
         auto search_result = hybrid_search_->search(question, tokens, embedding);
         context = search_result.context;
 
-        std::cout << "[MCEEEngine] Recherche mémoire: "
-                  << search_result.results.size() << " résultats, "
-                  << "confiance=" << std::fixed << std::setprecision(2)
-                  << search_result.overall_confidence << "\n";
+        MCEE_LOG_INFO("MCEEEngine",
+            "Recherche mémoire: ", search_result.results.size(), " résultats, ", "confiance=",
+            std::fixed, std::setprecision(2), search_result.overall_confidence);
     } else {
         // Fallback: construire un contexte basique depuis l'état actuel
         if (conscience_engine_) {
@@ -1402,16 +3027,18 @@ std::string MCEEEngine::generateEmotionalResponse(
     LLMRequest request;
     request.user_question = question;
     request.emotional_context = context;
+    request.cache_scope = getCurrentPatternName();
+    request.question_embedding = embedding;
 
     auto response = llm_client_->generate(request);
 
     if (response.success) {
-        std::cout << "[MCEEEngine] Réponse LLM générée: "
-                  << response.tokens_total << " tokens, "
-                  << response.generation_time_ms << "ms\n";
+        MCEE_LOG_INFO("MCEEEngine",
+            "Réponse LLM ", response.from_cache ? "(cache)" : "générée", ": ", response.tokens_total,
+            " tokens, ", response.generation_time_ms, "ms");
         return response.content;
     } else {
-        std::cerr << "[MCEEEngine] Erreur LLM: " << response.error_message << "\n";
+        MCEE_LOG_ERROR("MCEEEngine", "Erreur LLM: ", response.error_message);
         return "";
     }
 }
@@ -1431,8 +3058,19 @@ void MCEEEngine::generateEmotionalResponseAsync(
         return;
     }
 
-    // Lancer dans un thread séparé
-    std::thread([this, question, lemmas, embedding, callback]() {
+    // Voie bornée du LLMClient : plus de thread créé par requête. La garde
+    // (détruite avec la tâche, exécutée ou abandonnée) libère le destructeur.
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        ++async_responses_;
+    }
+    std::shared_ptr<void> in_flight(static_cast<void*>(this), [this](void*) {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        --async_responses_;
+        async_cv_.notify_all();
+    });
+
+    bool queued = llm_client_->post([this, in_flight, question, lemmas, embedding, callback]() {
         PipelineResult result;
         auto start_time = std::chrono::steady_clock::now();
 
@@ -1471,6 +3109,8 @@ void MCEEEngine::generateEmotionalResponseAsync(
         LLMRequest request;
         request.user_question = question;
         request.emotional_context = context;
+        request.cache_scope = getCurrentPatternName();
+        request.question_embedding = embedding;
 
         auto response = llm_client_->generate(request);
 
@@ -1479,6 +3119,7 @@ void MCEEEngine::generateEmotionalResponseAsync(
 
         result.success = response.success;
         result.response = response.content;
+        result.from_cache = response.from_cache;
         if (!response.success) {
             result.error = response.error_message;
         }
@@ -1489,7 +3130,14 @@ void MCEEEngine::generateEmotionalResponseAsync(
         if (callback) {
             callback(result);
         }
-    }).detach();
+    });
+
+    if (!queued && callback) {
+        PipelineResult result;
+        result.success = false;
+        result.error = "File d'attente LLM pleine ou client arrêté";
+        callback(result);
+    }
 }
 
 } // namespace mcee
@@ -0,0 +1,891 @@
+/**
+ * @file MCEEHost.cpp
+ * @brief Implémentation de l'hôte multi-session MCEE
+ * @version 3.0
+ * @date 2024
+ */
+
+#include "MCEEHost.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <unistd.h>
+
+namespace mcee {
+
+namespace {
+
+std::chrono::steady_clock::duration secondsToDuration(double seconds) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+}
+
+/// Valeur d'étiquette Prometheus (\, " et saut de ligne échappés)
+std::string escapeLabel(const std::string& value) {
+    std::string out;
+    out.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+constexpr const char* INPUT_HEADER = "mcee_input";
+constexpr const char* HOPS_HEADER = "mcee_hops";
+constexpr const char* HANDOFF_KIND = "handoff";
+
+std::string headerString(const AmqpClient::BasicMessage::ptr_t& message, const std::string& name) {
+    if (!message->HeaderTableIsSet()) return {};
+    const auto& headers = message->HeaderTable();
+    auto it = headers.find(name);
+    if (it == headers.end() || it->second.GetType() != AmqpClient::TableValue::VT_string) return {};
+    return it->second.GetString();
+}
+
+std::string defaultNodeId() {
+    char host[256] = {};
+    if (gethostname(host, sizeof(host) - 1) != 0 || host[0] == '\0') {
+        std::snprintf(host, sizeof(host), "mcee");
+    }
+    return std::string(host) + "-" + std::to_string(getpid());
+}
+
+} // namespace
+
+MCEEHost::MCEEHost(const RabbitMQConfig& rabbitmq_config, const MCEEHostConfig& host_config)
+    : rabbitmq_config_(rabbitmq_config)
+    , host_config_(host_config)
+    , shared_(MCEEEngine::createSharedResources())
+    , node_id_(host_config.cluster.node_id.empty() ? defaultNodeId() : host_config.cluster.node_id)
+    , ring_(std::make_shared<const HashRing>(
+          std::vector<HashRing::Member>{{node_id_, host_config.cluster.weight}},
+          host_config.cluster.virtual_nodes))
+{
+    const size_t worker_count = std::max<size_t>(1, host_config_.worker_count);
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>(host_config_.worker_queue_capacity));
+    }
+
+    if (!host_config_.record_trace_path.empty()) {
+        auto writer = std::make_shared<TraceWriter>();
+        if (writer->open(host_config_.record_trace_path)) {
+            trace_writer_ = std::move(writer);
+        }
+    }
+
+    MCEE_LOG_INFO("MCEEHost",
+        "Hôte multi-session initialisé (", worker_count, " workers, ",
+        shared_.mlt->patternCount(), " patterns partagés)");
+}
+
+MCEEHost::~MCEEHost() {
+    stop();
+}
+
+bool MCEEHost::start() {
+    if (running_.load()) {
+        return true;
+    }
+
+    // Neo4j avant les consommateurs : chaque session s'attache à la connexion
+    // commune dès sa création
+    Neo4jClientConfig neo4j_config;
+    if (!host_config_.config_path.empty() &&
+        MCEEEngine::readNeo4jConfig(host_config_.config_path, neo4j_config)) {
+        auto client = std::make_shared<Neo4jClient>(neo4j_config);
+        if (client->connect()) {
+            shared_.neo4j_client = std::move(client);
+            MCEE_LOG_INFO("MCEEHost", "Neo4j connecté (connexion partagée par les sessions)");
+        } else {
+            MCEE_LOG_WARN("MCEEHost", "Neo4j configuré mais non connecté : sessions en mode local");
+        }
+    }
+
+    if (!initRabbitMQ()) {
+        MCEE_LOG_ERROR("MCEEHost", "Échec initialisation RabbitMQ");
+        return false;
+    }
+
+    workers_running_.store(true);
+    for (auto& worker : workers_) {
+        worker->next_footprint = std::chrono::steady_clock::now();
+        worker->thread = std::thread(&MCEEHost::workerLoop, this, std::ref(*worker));
+    }
+
+    // En grappe, les queues d'entrée attendent que l'anneau ait vu les autres nœuds
+    ingress_ready_.store(!host_config_.cluster.enabled);
+    running_.store(true);
+    if (host_config_.cluster.enabled) {
+        cluster_thread_ = std::thread(&MCEEHost::clusterLoop, this);
+        node_consumer_thread_ = std::thread(&MCEEHost::consumeLoop, this,
+            std::cref(node_channel_), std::cref(node_consumer_tag_), std::nullopt, "nœud");
+    }
+    emotions_consumer_thread_ = std::thread(&MCEEHost::consumeLoop, this,
+        std::cref(emotions_channel_), std::cref(emotions_consumer_tag_), MCEEInput::EMOTIONS, "émotions");
+    speech_consumer_thread_ = std::thread(&MCEEHost::consumeLoop, this,
+        std::cref(speech_channel_), std::cref(speech_consumer_tag_), MCEEInput::SPEECH, "parole");
+    tokens_consumer_thread_ = std::thread(&MCEEHost::consumeLoop, this,
+        std::cref(tokens_channel_), std::cref(tokens_consumer_tag_), MCEEInput::TOKENS, "tokens");
+    timer_thread_ = std::thread(&MCEEHost::timerLoop, this);
+
+    MCEE_LOG_INFO("MCEEHost",
+        "✓ Démarré : sessions routées par l'en-tête '", rabbitmq_config_.session_header, "'",
+        host_config_.cluster.enabled ? " (grappe, nœud " + node_id_ + ")" : std::string());
+    return true;
+}
+
+void MCEEHost::stop() {
+    if (!workers_running_.load()) {
+        return;
+    }
+
+    // Plus de producteurs, puis vidange des files des workers
+    running_.store(false);
+    for (auto* thread : {&emotions_consumer_thread_, &speech_consumer_thread_,
+                         &tokens_consumer_thread_, &timer_thread_,
+                         &cluster_thread_, &node_consumer_thread_}) {
+        if (thread->joinable()) thread->join();
+    }
+
+    workers_running_.store(false);
+    for (auto& worker : workers_) {
+        worker->queue.wake();
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+
+    // Départ annoncé, puis sessions confiées aux nœuds restants (workers arrêtés :
+    // leurs sessions et channels sont libres)
+    if (host_config_.cluster.enabled && cluster_channel_) {
+        try {
+            publishHeartbeat(true);
+            std::vector<HashRing::Member> remaining;
+            for (const auto& [id, member] : members_) {
+                remaining.push_back({id, member.first.weight});
+            }
+            if (!remaining.empty()) {
+                const HashRing ring(std::move(remaining), host_config_.cluster.virtual_nodes);
+                for (auto& worker : workers_) {
+                    handOffSessions(*worker, ring);
+                }
+            }
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEHost", "Erreur départ de la grappe: ", e.what());
+        }
+    }
+
+    const auto stats = getStats();
+    for (auto& worker : workers_) {
+        worker->sessions.clear();
+    }
+    session_count_.store(0);
+    if (trace_writer_) {
+        trace_writer_->flush();
+    }
+
+    MCEE_LOG_INFO("MCEEHost",
+        "Arrêté : ", stats.sessions_created, " sessions créées, ", stats.sessions_evicted,
+        " libérées, ", stats.messages_routed, " messages routés");
+    Logger::instance().flush();
+}
+
+bool MCEEHost::initRabbitMQ() {
+    try {
+        AmqpClient::Channel::OpenOpts opts;
+        opts.host = rabbitmq_config_.host;
+        opts.port = rabbitmq_config_.port;
+        opts.auth = AmqpClient::Channel::OpenOpts::BasicAuth{
+            rabbitmq_config_.user,
+            rabbitmq_config_.password
+        };
+
+        // AmqpClient::Channel n'est PAS thread-safe : un channel par consommateur et par worker
+        emotions_channel_ = AmqpClient::Channel::Open(opts);
+        speech_channel_ = AmqpClient::Channel::Open(opts);
+        tokens_channel_ = AmqpClient::Channel::Open(opts);
+        if (rabbitmq_config_.metrics_interval_seconds > 0.0) {
+            metrics_channel_ = AmqpClient::Channel::Open(opts);
+        }
+        for (auto& worker : workers_) {
+            worker->publish_channel = AmqpClient::Channel::Open(opts);
+        }
+
+        const auto& declarer = workers_.front()->publish_channel;
+        for (const auto* exchange : {&rabbitmq_config_.emotions_exchange, &rabbitmq_config_.speech_exchange,
+                                     &rabbitmq_config_.output_exchange, &rabbitmq_config_.snapshot_exchange,
+                                     &rabbitmq_config_.tokens_exchange}) {
+            declarer->DeclareExchange(*exchange, AmqpClient::Channel::EXCHANGE_TYPE_TOPIC, false, true, false);
+        }
+        if (metrics_channel_) {
+            metrics_channel_->DeclareExchange(
+                rabbitmq_config_.metrics_exchange,
+                AmqpClient::Channel::EXCHANGE_TYPE_TOPIC,
+                false, true, false
+            );
+        }
+
+        // Mêmes queues qu'un moteur autonome : l'hôte le remplace
+        auto consume = [this](const AmqpClient::Channel::ptr_t& channel, const char* queue_name,
+                              const std::string& exchange, const std::string& routing_key) {
+            std::string queue = channel->DeclareQueue(queue_name, false, true, false, false);
+            channel->BindQueue(queue, exchange, routing_key);
+            return channel->BasicConsume(queue, "", true, false, false, rabbitmq_config_.consumer_prefetch);
+        };
+        emotions_consumer_tag_ = consume(emotions_channel_, "mcee_emotions_queue",
+            rabbitmq_config_.emotions_exchange, rabbitmq_config_.emotions_routing_key);
+        speech_consumer_tag_ = consume(speech_channel_, "mcee_speech_queue",
+            rabbitmq_config_.speech_exchange, rabbitmq_config_.speech_routing_key);
+        tokens_consumer_tag_ = consume(tokens_channel_, "mcee_tokens_queue",
+            rabbitmq_config_.tokens_exchange, rabbitmq_config_.tokens_routing_key);
+
+        if (host_config_.cluster.enabled && !initCluster(opts)) {
+            return false;
+        }
+
+        MCEE_LOG_INFO("MCEEHost", "Connexion RabbitMQ établie (", 3 + workers_.size(), " channels)");
+        return true;
+
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MCEEHost", "Erreur RabbitMQ: ", e.what());
+        return false;
+    }
+}
+
+bool MCEEHost::initCluster(const AmqpClient::Channel::OpenOpts& opts) {
+    const auto& cluster = host_config_.cluster;
+
+    // Battements (publiés et reçus par le thread de grappe) ; queue de nœud
+    // (messages réexpédiés et transferts de session)
+    cluster_channel_ = AmqpClient::Channel::Open(opts);
+    node_channel_ = AmqpClient::Channel::Open(opts);
+
+    cluster_channel_->DeclareExchange(cluster.heartbeat_exchange,
+        AmqpClient::Channel::EXCHANGE_TYPE_FANOUT, false, true, false);
+    cluster_channel_->DeclareExchange(cluster.route_exchange,
+        AmqpClient::Channel::EXCHANGE_TYPE_DIRECT, false, true, false);
+
+    std::string heartbeats = cluster_channel_->DeclareQueue("", false, false, true, true);
+    cluster_channel_->BindQueue(heartbeats, cluster.heartbeat_exchange, "");
+    heartbeat_consumer_tag_ = cluster_channel_->BasicConsume(heartbeats, "", true, true, true, 16);
+
+    std::string node_queue = node_channel_->DeclareQueue("mcee.node." + node_id_, false, false, false, true);
+    node_channel_->BindQueue(node_queue, cluster.route_exchange, node_id_);
+    node_consumer_tag_ = node_channel_->BasicConsume(node_queue, "", true, false, false,
+                                                     rabbitmq_config_.consumer_prefetch);
+
+    MCEE_LOG_INFO("MCEEHost", "Grappe : nœud ", node_id_, " (poids ", cluster.weight,
+                  "), queue ", node_queue);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ROUTAGE
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::string MCEEHost::sessionKey(const AmqpClient::BasicMessage::ptr_t& message) const {
+    if (message->HeaderTableIsSet()) {
+        const auto& headers = message->HeaderTable();
+        auto it = headers.find(rabbitmq_config_.session_header);
+        if (it != headers.end() && it->second.GetType() == AmqpClient::TableValue::VT_string) {
+            std::string key = it->second.GetString();
+            if (!key.empty()) return key;
+        }
+    }
+    return host_config_.default_session;
+}
+
+MCEEHost::Worker& MCEEHost::workerFor(const std::string& session_id) {
+    return *workers_[std::hash<std::string>{}(session_id) % workers_.size()];
+}
+
+bool MCEEHost::route(const std::string& session_id, MCEEInput input,
+                     std::string body, std::string content_type, int64_t trace) {
+    if (!workers_running_.load()) return false;
+
+    HostTask task;
+    task.input = input;
+    task.session_id = session_id;
+    task.body = std::move(body);
+    task.content_type = std::move(content_type);
+    task.trace = trace;
+
+    // File pleine : le consommateur attend (contre-pression jusqu'au prefetch)
+    if (!workerFor(session_id).queue.push(std::move(task), workers_running_)) {
+        return false;
+    }
+    messages_routed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MCEEHost::consumeLoop(const AmqpClient::Channel::ptr_t& channel, const std::string& consumer_tag,
+                           std::optional<MCEEInput> input, const std::string& label) {
+    MCEE_LOG_INFO("MCEEHost", "Boucle de consommation ", label, " démarrée");
+
+    const size_t batch_max = std::max<size_t>(1, std::min<size_t>(
+        rabbitmq_config_.consumer_batch_max, std::max<uint16_t>(1, rabbitmq_config_.consumer_prefetch)));
+
+    std::vector<AmqpClient::Envelope::ptr_t> envelopes;
+    envelopes.reserve(batch_max);
+
+    while (running_.load()) {
+        if (input && !ingress_ready_.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            continue;
+        }
+
+        try {
+            envelopes.clear();
+
+            AmqpClient::Envelope::ptr_t envelope;
+            bool received = channel->BasicConsumeMessage(consumer_tag, envelope,
+                                                         rabbitmq_config_.consumer_poll_timeout_ms);
+            if (!received || !envelope) {
+                continue;
+            }
+
+            do {
+                envelopes.push_back(std::move(envelope));
+            } while (envelopes.size() < batch_max &&
+                     channel->BasicConsumeMessage(consumer_tag, envelope, 0) && envelope);
+
+            for (const auto& env : envelopes) {
+                dispatch(channel, env->Message(), input);
+            }
+
+            // Acquitté une fois confié au worker ou réexpédié (la file est vidée avant l'arrêt)
+            if (rabbitmq_config_.consumer_multi_ack) {
+                channel->BasicAck(envelopes.back()->GetDeliveryInfo(), true);
+            } else {
+                for (const auto& env : envelopes) {
+                    channel->BasicAck(env);
+                }
+            }
+
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEHost", "Erreur consommation ", label, ": ", e.what());
+            std::this_thread::sleep_for(std::chrono::milliseconds(rabbitmq_config_.consumer_error_backoff_ms));
+        }
+    }
+}
+
+void MCEEHost::dispatch(const AmqpClient::Channel::ptr_t& channel, const AmqpClient::BasicMessage::ptr_t& message,
+                        std::optional<MCEEInput> input) {
+    const std::string session_id = sessionKey(message);
+    std::string content_type = message->ContentTypeIsSet() ? message->ContentType() : std::string();
+    const int64_t trace = MCEEEngine::traceStamp(message, rabbitmq_config_.trace_header);
+    int hops = 0;
+
+    if (!input) {
+        // Queue de nœud : flux et nombre de sauts posés par forward()
+        const std::string kind = headerString(message, INPUT_HEADER);
+        if (kind == HANDOFF_KIND) {
+            HostTask task;
+            task.kind = HostTask::Kind::HANDOFF;
+            task.session_id = session_id;
+            task.body = message->Body();
+            (void)workerFor(session_id).queue.push(std::move(task), workers_running_);
+            return;
+        }
+        input = parseMCEEInput(kind);
+        if (!input) {
+            MCEE_LOG_WARN("MCEEHost", "Message de grappe sans flux reconnu ('", kind, "') ignoré");
+            return;
+        }
+        const std::string hops_header = headerString(message, HOPS_HEADER);
+        hops = hops_header.empty() ? 0 : std::atoi(hops_header.c_str());
+    }
+
+    // Au-delà de max_hops (anneaux momentanément divergents) : traité ici
+    if (host_config_.cluster.enabled && hops < host_config_.cluster.max_hops) {
+        const auto ring = currentRing();
+        const std::string& owner = ring->owner(session_id);
+        if (!owner.empty() && owner != node_id_) {
+            forward(channel, owner, session_id, mceeInputName(*input), message->Body(), content_type, hops + 1,
+                    trace);
+            messages_forwarded_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    route(session_id, *input, message->Body(), std::move(content_type), trace);
+}
+
+void MCEEHost::forward(const AmqpClient::Channel::ptr_t& channel, const std::string& node_id,
+                       const std::string& session_id, const std::string& kind, std::string body,
+                       const std::string& content_type, int hops, int64_t trace) {
+    auto message = AmqpClient::BasicMessage::Create(std::move(body));
+    if (!content_type.empty()) {
+        message->ContentType(content_type);
+    }
+
+    AmqpClient::Table headers;
+    headers[rabbitmq_config_.session_header] = AmqpClient::TableValue(session_id);
+    headers[INPUT_HEADER] = AmqpClient::TableValue(kind);
+    headers[HOPS_HEADER] = AmqpClient::TableValue(std::to_string(hops));
+    if (trace != 0) {
+        headers[rabbitmq_config_.trace_header] = AmqpClient::TableValue(trace);
+    }
+    message->HeaderTable(headers);
+
+    channel->BasicPublish(host_config_.cluster.route_exchange, node_id, message, false, false);
+}
+
+std::shared_ptr<const HashRing> MCEEHost::currentRing() const {
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    return ring_;
+}
+
+bool MCEEHost::ownsSession(const HashRing* ring, const std::string& session_id) const {
+    if (!host_config_.cluster.enabled || !ring) return true;
+    const std::string& owner = ring->owner(session_id);
+    return owner.empty() || owner == node_id_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GRAPPE
+// ═══════════════════════════════════════════════════════════════════════════
+
+void MCEEHost::publishHeartbeat(bool leaving) {
+    size_t queue_depth = 0;
+    for (const auto& worker : workers_) {
+        queue_depth += worker->queue.size();
+    }
+
+    nlohmann::json load = {
+        {"node_id", node_id_},
+        {"weight", host_config_.cluster.weight},
+        {"sessions", session_count_.load()},
+        {"queue_depth", queue_depth},
+        {"messages_routed", messages_routed_.load(std::memory_order_relaxed)},
+        {"leaving", leaving}
+    };
+
+    auto message = AmqpClient::BasicMessage::Create(load.dump());
+    message->ContentType("application/json");
+    cluster_channel_->BasicPublish(host_config_.cluster.heartbeat_exchange, "", message, false, false);
+}
+
+void MCEEHost::rebuildRing() {
+    std::vector<HashRing::Member> members{{node_id_, host_config_.cluster.weight}};
+    std::vector<ClusterNodeLoad> view;
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto& [id, member] : members_) {
+        members.push_back({id, member.first.weight});
+        ClusterNodeLoad load = member.first;
+        load.last_seen_seconds = std::chrono::duration<double>(now - member.second).count();
+        view.push_back(std::move(load));
+    }
+
+    // Anneau reconstruit seulement si les membres ou leurs poids changent
+    const auto current = currentRing();
+    std::shared_ptr<const HashRing> ring;
+    if (!current->sameMembers(members)) {
+        ring = std::make_shared<const HashRing>(std::move(members), host_config_.cluster.virtual_nodes);
+    }
+
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    members_view_.swap(view);
+    if (ring) {
+        ring_ = std::move(ring);
+        MCEE_LOG_INFO("MCEEHost", "Anneau de grappe : ", ring_->members().size(), " nœud(s)");
+    }
+}
+
+void MCEEHost::clusterLoop() {
+    const auto& cluster = host_config_.cluster;
+    const auto heartbeat_interval = secondsToDuration(std::max(0.1, cluster.heartbeat_interval_seconds));
+    const auto node_timeout = secondsToDuration(cluster.node_timeout_seconds);
+
+    auto next_heartbeat = std::chrono::steady_clock::now();
+    const auto ready_at = next_heartbeat + 2 * heartbeat_interval;
+
+    while (running_.load()) {
+        try {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= next_heartbeat) {
+                publishHeartbeat(false);
+                next_heartbeat = now + heartbeat_interval;
+            }
+
+            // Réception par tranches de 100 ms : stop() n'attend pas un battement complet
+            AmqpClient::Envelope::ptr_t envelope;
+            if (cluster_channel_->BasicConsumeMessage(heartbeat_consumer_tag_, envelope, 100) && envelope) {
+                const auto load = nlohmann::json::parse(envelope->Message()->Body());
+                const std::string id = load.value("node_id", std::string());
+                if (!id.empty() && id != node_id_) {
+                    if (load.value("leaving", false)) {
+                        members_.erase(id);
+                        MCEE_LOG_INFO("MCEEHost", "Nœud parti : ", id);
+                    } else {
+                        auto& member = members_[id];
+                        if (member.first.node_id.empty()) {
+                            MCEE_LOG_INFO("MCEEHost", "Nœud rejoint : ", id);
+                        }
+                        member.first.node_id = id;
+                        member.first.weight = load.value("weight", 1u);
+                        member.first.sessions = load.value("sessions", size_t{0});
+                        member.first.queue_depth = load.value("queue_depth", size_t{0});
+                        member.first.messages_routed = load.value("messages_routed", size_t{0});
+                        member.second = std::chrono::steady_clock::now();
+                    }
+                }
+            }
+
+            now = std::chrono::steady_clock::now();
+            for (auto it = members_.begin(); it != members_.end();) {
+                if (now - it->second.second > node_timeout) {
+                    MCEE_LOG_WARN("MCEEHost", "Nœud sans battement retiré de l'anneau : ", it->first);
+                    it = members_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            rebuildRing();
+
+            if (!ingress_ready_.load() && now >= ready_at) {
+                ingress_ready_.store(true);
+                MCEE_LOG_INFO("MCEEHost", "Queues d'entrée ouvertes (", currentRing()->members().size(),
+                              " nœud(s) dans l'anneau)");
+            }
+
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEHost", "Erreur grappe: ", e.what());
+            std::this_thread::sleep_for(std::chrono::milliseconds(rabbitmq_config_.consumer_error_backoff_ms));
+        }
+    }
+}
+
+void MCEEHost::handOffSessions(Worker& worker, const HashRing& ring) {
+    for (auto it = worker.sessions.begin(); it != worker.sessions.end();) {
+        if (ownsSession(&ring, it->first)) {
+            ++it;
+            continue;
+        }
+
+        const std::string& owner = ring.owner(it->first);
+        try {
+            forward(worker.publish_channel, owner, it->first, HANDOFF_KIND,
+                    it->second.engine->exportSessionState().dump(), "application/json", 0);
+        } catch (const std::exception& e) {
+            // Session conservée : nouvel essai au tick suivant
+            MCEE_LOG_ERROR("MCEEHost", "Transfert de ", it->first, " vers ", owner, " échoué: ", e.what());
+            ++it;
+            continue;
+        }
+
+        MCEE_LOG_INFO("MCEEHost", "Session transférée: ", it->first, " → ", owner);
+        it = worker.sessions.erase(it);
+        session_count_.fetch_sub(1);
+        sessions_handed_off_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WORKERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void MCEEHost::workerLoop(Worker& worker) {
+    HostTask task;
+    while (worker.queue.waitPop(task, workers_running_)) {
+        try {
+            if (task.kind == HostTask::Kind::TICK) {
+                tick(worker);
+                continue;
+            }
+
+            if (task.kind == HostTask::Kind::HANDOFF) {
+                // Remplace l'état d'une session déjà ouverte par des messages en avance
+                Session* session = acquireSession(worker, task.session_id);
+                if (!session) {
+                    messages_rejected_.fetch_add(1, std::memory_order_relaxed);
+                    MCEE_LOG_WARN("MCEEHost", "max_sessions atteint : transfert refusé pour ", task.session_id);
+                    continue;
+                }
+                session->engine->importSessionState(nlohmann::json::parse(task.body));
+                session->last_activity = std::chrono::steady_clock::now();
+                sessions_received_.fetch_add(1, std::memory_order_relaxed);
+                MCEE_LOG_INFO("MCEEHost", "Session reçue: ", task.session_id);
+                continue;
+            }
+
+            Session* session = acquireSession(worker, task.session_id);
+            if (!session) {
+                // Journal une fois par millier de refus pour ne pas saturer le logger
+                if (messages_rejected_.fetch_add(1, std::memory_order_relaxed) % 1000 == 0) {
+                    MCEE_LOG_WARN("MCEEHost",
+                        "max_sessions atteint (", host_config_.max_sessions,
+                        ") : message refusé pour la session ", task.session_id);
+                }
+                continue;
+            }
+            deliver(*session, task);
+
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MCEEHost", "Erreur session ", task.session_id, ": ", e.what());
+        }
+    }
+}
+
+MCEEHost::Session* MCEEHost::acquireSession(Worker& worker, const std::string& session_id) {
+    auto it = worker.sessions.find(session_id);
+    if (it != worker.sessions.end()) {
+        return &it->second;
+    }
+
+    if (session_count_.load() >= host_config_.max_sessions) {
+        return nullptr;
+    }
+
+    Session session;
+    session.engine = std::make_unique<MCEEEngine>(session_id, shared_, rabbitmq_config_);
+    if (!host_config_.config_path.empty()) {
+        session.engine->loadConfig(host_config_.config_path, true);  // Neo4j : connexion de l'hôte
+    }
+    session.engine->attachPublishChannel(worker.publish_channel);
+    if (trace_writer_) {
+        session.engine->setTraceWriter(trace_writer_);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    session.last_activity = now;
+    session.next_graph_tick = now + secondsToDuration(
+        session.engine->getMCTGraph()->getConfig().snapshot_interval_seconds);
+
+    const size_t active = session_count_.fetch_add(1) + 1;
+    sessions_created_.fetch_add(1, std::memory_order_relaxed);
+    MCEE_LOG_INFO("MCEEHost", "Session créée: ", session_id, " (", active, " actives)");
+
+    return &worker.sessions.emplace(session_id, std::move(session)).first->second;
+}
+
+void MCEEHost::deliver(Session& session, const HostTask& task) {
+    session.engine->handleInput(task.input, task.body, task.content_type, task.trace);
+    session.last_activity = std::chrono::steady_clock::now();
+    session.messages++;
+}
+
+void MCEEHost::tick(Worker& worker) {
+    if (host_config_.cluster.enabled) {
+        handOffSessions(worker, *currentRing());
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto idle_limit = secondsToDuration(host_config_.session_idle_timeout_seconds);
+
+    for (auto it = worker.sessions.begin(); it != worker.sessions.end();) {
+        Session& session = it->second;
+
+        if (host_config_.session_idle_timeout_seconds > 0.0 && now - session.last_activity > idle_limit) {
+            MCEE_LOG_INFO("MCEEHost", "Session libérée (inactive): ", it->first);
+            it = worker.sessions.erase(it);
+            session_count_.fetch_sub(1);
+            sessions_evicted_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Delta MCTGraph et maintenance, à l'intervalle de snapshot de la session
+        if (now >= session.next_graph_tick) {
+            auto graph = session.engine->getMCTGraph();
+            session.engine->graphTick(workers_running_);
+            session.next_graph_tick = now + secondsToDuration(graph->getConfig().snapshot_interval_seconds);
+        }
+        ++it;
+    }
+
+    if (now < worker.next_footprint) return;
+    worker.next_footprint = now + secondsToDuration(host_config_.footprint_interval_seconds);
+
+    std::vector<SessionFootprint> footprints;
+    footprints.reserve(worker.sessions.size());
+    for (const auto& [session_id, session] : worker.sessions) {
+        SessionFootprint entry;
+        entry.session_id = session_id;
+        entry.footprint = session.engine->memoryFootprint();
+        entry.messages = session.messages;
+        entry.idle_seconds = std::chrono::duration<double>(now - session.last_activity).count();
+        footprints.push_back(std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(worker.footprint_mutex);
+    worker.footprints.swap(footprints);
+}
+
+void MCEEHost::timerLoop() {
+    const auto tick_interval = secondsToDuration(std::max(0.05, host_config_.tick_interval_seconds));
+    const auto metrics_interval = secondsToDuration(rabbitmq_config_.metrics_interval_seconds);
+    const auto slice = std::chrono::milliseconds(50);
+
+    auto next_tick = std::chrono::steady_clock::now() + tick_interval;
+    auto next_metrics = std::chrono::steady_clock::now() + metrics_interval;
+
+    while (running_.load()) {
+        // Attente par tranches : stop() n'attend pas un intervalle complet
+        std::this_thread::sleep_for(slice);
+        const auto now = std::chrono::steady_clock::now();
+
+        if (now >= next_tick) {
+            for (auto& worker : workers_) {
+                // Sans attente : un worker chargé recevra le tick suivant
+                HostTask task;
+                task.kind = HostTask::Kind::TICK;
+                (void)worker->queue.tryPush(std::move(task));
+            }
+            next_tick = now + tick_interval;
+        }
+
+        if (metrics_channel_ && now >= next_metrics) {
+            try {
+                auto message = AmqpClient::BasicMessage::Create(renderMetrics());
+                message->ContentType(PROMETHEUS_CONTENT_TYPE);
+                metrics_channel_->BasicPublish(
+                    rabbitmq_config_.metrics_exchange,
+                    rabbitmq_config_.metrics_routing_key,
+                    message,
+                    false, false
+                );
+            } catch (const std::exception& e) {
+                MCEE_LOG_ERROR("MCEEHost", "Erreur publication métriques: ", e.what());
+            }
+            next_metrics = now + metrics_interval;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PATTERNS, STATISTIQUES ET MÉTRIQUES
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool MCEEHost::loadPatterns(const std::string& path) {
+    if (!shared_.mlt) return false;
+
+    // La base partagée est figée : nouvelle base, adoptée par les sessions ouvertes ensuite
+    auto mlt = std::make_shared<MLT>(shared_.mlt->getConfig());
+    if (!mlt->loadFromFile(path)) return false;
+    shared_.mlt = std::move(mlt);
+    return true;
+}
+
+bool MCEEHost::savePatterns(const std::string& path) const {
+    return shared_.mlt && shared_.mlt->saveToFile(path);
+}
+
+std::vector<SessionFootprint> MCEEHost::getSessionFootprints() const {
+    std::vector<SessionFootprint> all;
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->footprint_mutex);
+        all.insert(all.end(), worker->footprints.begin(), worker->footprints.end());
+    }
+    return all;
+}
+
+MCEEHostStats MCEEHost::getStats() const {
+    MCEEHostStats stats;
+    stats.sessions = session_count_.load();
+    stats.sessions_created = sessions_created_.load(std::memory_order_relaxed);
+    stats.sessions_evicted = sessions_evicted_.load(std::memory_order_relaxed);
+    stats.messages_routed = messages_routed_.load(std::memory_order_relaxed);
+    stats.messages_rejected = messages_rejected_.load(std::memory_order_relaxed);
+    stats.messages_forwarded = messages_forwarded_.load(std::memory_order_relaxed);
+    stats.sessions_handed_off = sessions_handed_off_.load(std::memory_order_relaxed);
+    stats.sessions_received = sessions_received_.load(std::memory_order_relaxed);
+    for (const auto& worker : workers_) {
+        std::lock_guard<std::mutex> lock(worker->footprint_mutex);
+        for (const auto& entry : worker->footprints) {
+            stats.session_bytes += entry.footprint.total();
+        }
+    }
+    stats.shared_bytes = shared_.lexicon ? shared_.lexicon->memoryUsage() : 0;
+    return stats;
+}
+
+std::vector<ClusterNodeLoad> MCEEHost::getClusterNodes() const {
+    ClusterNodeLoad self;
+    self.node_id = node_id_;
+    self.weight = host_config_.cluster.weight;
+    self.sessions = session_count_.load();
+    for (const auto& worker : workers_) {
+        self.queue_depth += worker->queue.size();
+    }
+    self.messages_routed = messages_routed_.load(std::memory_order_relaxed);
+
+    std::vector<ClusterNodeLoad> nodes{self};
+    std::lock_guard<std::mutex> lock(ring_mutex_);
+    nodes.insert(nodes.end(), members_view_.begin(), members_view_.end());
+    return nodes;
+}
+
+std::string MCEEHost::renderMetrics() const {
+    PrometheusWriter out;
+    const auto stats = getStats();
+
+    out.family("mcee_host_sessions", "Sessions actives", "gauge");
+    out.sample("mcee_host_sessions", static_cast<double>(stats.sessions));
+    out.family("mcee_host_sessions_total", "Sessions par événement", "counter");
+    out.sample("mcee_host_sessions_total", static_cast<double>(stats.sessions_created), "event=\"created\"");
+    out.sample("mcee_host_sessions_total", static_cast<double>(stats.sessions_evicted), "event=\"evicted\"");
+    out.family("mcee_host_messages_total", "Messages par issue du routage", "counter");
+    out.sample("mcee_host_messages_total", static_cast<double>(stats.messages_routed), "outcome=\"routed\"");
+    out.sample("mcee_host_messages_total", static_cast<double>(stats.messages_rejected), "outcome=\"rejected\"");
+
+    out.family("mcee_host_worker_queue_depth", "Messages en attente par worker", "gauge");
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        out.sample("mcee_host_worker_queue_depth", static_cast<double>(workers_[i]->queue.size()),
+                   "worker=\"" + std::to_string(i) + "\"");
+    }
+
+    out.family("mcee_host_shared_patterns", "Patterns de la MLT partagée", "gauge");
+    out.sample("mcee_host_shared_patterns", static_cast<double>(shared_.mlt ? shared_.mlt->patternCount() : 0));
+    out.family("mcee_host_shared_bytes", "Mémoire des ressources partagées (approx.)", "gauge");
+    out.sample("mcee_host_shared_bytes", static_cast<double>(stats.shared_bytes), "resource=\"lexicon\"");
+
+    Executor::shared()->renderMetrics(out);
+
+    if (host_config_.cluster.enabled) {
+        const auto nodes = getClusterNodes();
+        out.family("mcee_cluster_nodes", "Nœuds dans l'anneau", "gauge");
+        out.sample("mcee_cluster_nodes", static_cast<double>(nodes.size()));
+        out.family("mcee_cluster_node_sessions", "Sessions par nœud (dernier battement)", "gauge");
+        for (const auto& node : nodes) {
+            out.sample("mcee_cluster_node_sessions", static_cast<double>(node.sessions),
+                       "node=\"" + escapeLabel(node.node_id) + "\"");
+        }
+        out.family("mcee_cluster_node_queue_depth", "Messages en attente par nœud", "gauge");
+        for (const auto& node : nodes) {
+            out.sample("mcee_cluster_node_queue_depth", static_cast<double>(node.queue_depth),
+                       "node=\"" + escapeLabel(node.node_id) + "\"");
+        }
+        out.family("mcee_cluster_node_messages_total", "Messages routés par nœud", "counter");
+        for (const auto& node : nodes) {
+            out.sample("mcee_cluster_node_messages_total", static_cast<double>(node.messages_routed),
+                       "node=\"" + escapeLabel(node.node_id) + "\"");
+        }
+        out.family("mcee_cluster_messages_forwarded_total", "Messages réexpédiés au nœud propriétaire", "counter");
+        out.sample("mcee_cluster_messages_forwarded_total", static_cast<double>(stats.messages_forwarded));
+        out.family("mcee_cluster_handoffs_total", "Transferts de session", "counter");
+        out.sample("mcee_cluster_handoffs_total", static_cast<double>(stats.sessions_handed_off), "direction=\"sent\"");
+        out.sample("mcee_cluster_handoffs_total", static_cast<double>(stats.sessions_received), "direction=\"received\"");
+    }
+
+    out.family("mcee_session_memory_bytes", "Empreinte mémoire par session et composant (approx.)", "gauge");
+    for (const auto& entry : getSessionFootprints()) {
+        const std::string session = "session=\"" + escapeLabel(entry.session_id) + "\",component=";
+        const auto& f = entry.footprint;
+        out.sample("mcee_session_memory_bytes", static_cast<double>(f.mct), session + "\"mct\"");
+        out.sample("mcee_session_memory_bytes", static_cast<double>(f.graph), session + "\"graph\"");
+        out.sample("mcee_session_memory_bytes", static_cast<double>(f.memories), session + "\"memories\"");
+        out.sample("mcee_session_memory_bytes", static_cast<double>(f.speech), session + "\"speech\"");
+        out.sample("mcee_session_memory_bytes", static_cast<double>(f.engine), session + "\"engine\"");
+    }
+    return out.str();
+}
+
+} // namespace mcee
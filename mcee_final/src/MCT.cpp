@@ -4,12 +4,12 @@
  */
 
 #include "MCT.hpp"
+#include "Logger.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
-#include <iostream>
 
 namespace mcee {
 
@@ -17,9 +17,21 @@ namespace mcee {
 // CONSTRUCTEURS
 // ═══════════════════════════════════════════════════════════════════════════
 
-MCT::MCT() : config_() {}
+MCT::MCT() : config_() {
+    applyCapacityLocked();
+}
+
+MCT::MCT(const MCTConfig& config) : config_(config) {
+    applyCapacityLocked();
+}
 
-MCT::MCT(const MCTConfig& config) : config_(config) {}
+void MCT::setConfig(const MCTConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    applyCapacityLocked();
+    resyncLocked();
+    invalidateCache();
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
 // GESTION DU BUFFER
@@ -37,8 +49,8 @@ bool MCT::push(const EmotionalState& state) {
             }
 
             if (config_.log_validation_errors) {
-                std::cerr << "[MCT] Validation error: " << validation.error_code
-                          << " - " << validation.error_message << "\n";
+                MCEE_LOG_ERROR("MCT",
+                    "Validation error: ", validation.error_code, " - ", validation.error_message);
             }
 
             if (config_.reject_on_validation_failure) {
@@ -48,26 +60,24 @@ bool MCT::push(const EmotionalState& state) {
         }
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::optional<MCTIntegration> notify;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
 
-    // Sanitize l'état si la validation est active (même si valide, clamp les valeurs)
-    EmotionalState safe_state = config_.enable_input_validation ? sanitize(state) : state;
+        // Sanitize l'état si la validation est active (même si valide, clamp les valeurs)
+        EmotionalState safe_state = config_.enable_input_validation ? sanitize(state) : state;
 
-    TimestampedState ts(safe_state);
-    buffer_.push_back(ts);
+        appendLocked(TimestampedState(safe_state));
+        invalidateCache();
 
-    // Limite de taille
-    while (buffer_.size() > config_.max_size) {
-        buffer_.pop_front();
+        if (stability_callback_ && buffer_.size() >= 2) {
+            notify = integrateLocked();
+        }
     }
 
-    invalidateCache();
-
-    // Callbacks
-    if (stability_callback_ && buffer_.size() >= 2) {
-        auto stability = getStability();
-        auto volatility = getVolatility();
-        stability_callback_(stability, volatility);
+    // Callbacks (hors verrou : ils peuvent rappeler la MCT)
+    if (notify) {
+        stability_callback_(notify->stability, notify->volatility);
     }
 
     return true;
@@ -84,41 +94,209 @@ void MCT::pushWithSpeech(const EmotionalState& state,
     ts.speech_arousal = arousal;
     ts.context = context;
     
-    buffer_.push_back(ts);
-    
-    while (buffer_.size() > config_.max_size) {
-        buffer_.pop_front();
-    }
-    
+    appendLocked(std::move(ts));
     invalidateCache();
 }
 
 void MCT::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     buffer_.clear();
+    entry_stats_.clear();
+    for (auto& window : peak_windows_) {
+        window.clear();
+    }
+    stats_ = RunningStats{};
     invalidateCache();
 }
 
 void MCT::pruneOld() {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     auto cutoff = now - std::chrono::duration<double>(config_.time_window_seconds);
     
     while (!buffer_.empty() && buffer_.front().timestamp < cutoff) {
-        buffer_.pop_front();
+        popFrontLocked();
     }
     
     invalidateCache();
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// ACCUMULATEURS INCRÉMENTAUX
+// ═══════════════════════════════════════════════════════════════════════════
+
+double MCT::halfLife() const {
+    return std::max(1e-6, config_.time_window_seconds / 3.0);
+}
+
+void MCT::applyCapacityLocked() {
+    size_t capacity = std::max<size_t>(1, config_.max_size);
+    while (buffer_.size() > capacity) {
+        popFrontLocked();
+    }
+    buffer_.setCapacity(capacity);
+    entry_stats_.setCapacity(capacity);
+    for (auto& window : peak_windows_) {
+        window.setCapacity(capacity);
+    }
+}
+
+void MCT::appendLocked(TimestampedState ts) {
+    while (buffer_.size() >= std::max<size_t>(1, config_.max_size)) {
+        popFrontLocked();
+    }
+
+    if (buffer_.empty() && !resyncing_) {
+        stats_.ref_time = ts.timestamp;
+        stats_.seq_base = stats_.front_seq;
+    }
+
+    const size_t n = buffer_.size();
+    const uint64_t seq = stats_.front_seq + n;
+    const auto& x = ts.state.emotions;
+
+    EntryStats es;
+
+    // Facteur de pondération temporelle relatif à ref_time (le "now" se simplifie
+    // dans la moyenne pondérée : Σ x·e^{-(now-t)/h} / Σ e^{-(now-t)/h})
+    double exponent = std::chrono::duration<double>(ts.timestamp - stats_.ref_time).count() / halfLife();
+    es.weight_factor = config_.use_exponential_weighting ? std::exp(exponent) : 1.0;
+
+    const auto& prev_cumulative = n > 0 ? entry_stats_.back().cumulative : stats_.prefix_base;
+
+    for (size_t i = 0; i < 24; ++i) {
+        es.cumulative[i] = prev_cumulative[i] + x[i];
+        stats_.sum[i] += x[i];
+        stats_.sum_sq[i] += x[i] * x[i];
+        stats_.weighted_sum[i] += x[i] * es.weight_factor;
+
+        // Changement de direction (même critère que le calcul complet)
+        if (n >= 2) {
+            double d_prev = buffer_[n - 1].state.emotions[i] - buffer_[n - 2].state.emotions[i];
+            double d = x[i] - buffer_[n - 1].state.emotions[i];
+            if (d_prev * d < 0 && std::abs(d) > 0.01) {
+                es.oscillation_mask |= (1u << i);
+                stats_.oscillations[i]++;
+            }
+        }
+
+        // Maximum glissant : conserve la première occurrence du maximum
+        auto& window = peak_windows_[i];
+        while (!window.empty() &&
+               buffer_[window.back() - stats_.front_seq].state.emotions[i] < x[i]) {
+            window.pop_back();
+        }
+        window.push_back(seq);
+    }
+
+    if (n >= 2) {
+        double d_prev = buffer_[n - 1].state.E_global - buffer_[n - 2].state.E_global;
+        double d = ts.state.E_global - buffer_[n - 1].state.E_global;
+        if (d_prev * d < 0 && std::abs(d) > 0.02) {
+            es.oscillation_mask |= (1u << 24);
+            stats_.global_oscillations++;
+        }
+    }
+
+    stats_.weight_total += es.weight_factor;
+    stats_.sum_e += ts.state.E_global;
+    stats_.sum_seq_e += static_cast<double>(seq - stats_.seq_base) * ts.state.E_global;
+
+    buffer_.push_back(std::move(ts));
+    entry_stats_.push_back(es);
+
+    if (!resyncing_ && (++stats_.pushes_since_resync >= 1024 || exponent > 100.0)) {
+        resyncLocked();
+    }
+}
+
+void MCT::popFrontLocked() {
+    if (buffer_.empty()) return;
+
+    const auto& ts = buffer_.front();
+    const auto& es = entry_stats_.front();
+    const auto& x = ts.state.emotions;
+
+    for (size_t i = 0; i < 24; ++i) {
+        stats_.sum[i] -= x[i];
+        stats_.sum_sq[i] -= x[i] * x[i];
+        stats_.weighted_sum[i] -= x[i] * es.weight_factor;
+    }
+    stats_.weight_total -= es.weight_factor;
+    stats_.sum_e -= ts.state.E_global;
+    stats_.sum_seq_e -= static_cast<double>(stats_.front_seq - stats_.seq_base) * ts.state.E_global;
+    stats_.prefix_base = es.cumulative;
+
+    // L'entrée en position 2 passe en position 1 : ses oscillations ne comptent plus
+    if (buffer_.size() >= 3) {
+        uint32_t mask = entry_stats_[2].oscillation_mask;
+        for (size_t i = 0; i < 24; ++i) {
+            if (mask & (1u << i)) stats_.oscillations[i]--;
+        }
+        if (mask & (1u << 24)) stats_.global_oscillations--;
+    }
+
+    for (auto& window : peak_windows_) {
+        if (!window.empty() && window.front() == stats_.front_seq) {
+            window.pop_front();
+        }
+    }
+
+    buffer_.pop_front();
+    entry_stats_.pop_front();
+    stats_.front_seq++;
+
+    if (buffer_.empty()) {
+        // Repartir de zéro : annule toute dérive résiduelle
+        uint64_t front_seq = stats_.front_seq;
+        stats_ = RunningStats{};
+        stats_.front_seq = front_seq;
+        stats_.seq_base = front_seq;
+    }
+}
+
+void MCT::resyncLocked() {
+    std::vector<TimestampedState> entries(buffer_.begin(), buffer_.end());
+    uint64_t front_seq = stats_.front_seq;
+
+    buffer_.clear();
+    entry_stats_.clear();
+    for (auto& window : peak_windows_) {
+        window.clear();
+    }
+
+    stats_ = RunningStats{};
+    stats_.front_seq = front_seq;
+    stats_.seq_base = front_seq;
+    // Référence sur l'entrée la plus récente : tous les facteurs restent ≤ 1
+    stats_.ref_time = entries.empty() ? SessionClock::now() : entries.back().timestamp;
+
+    resyncing_ = true;
+    for (auto& ts : entries) {
+        appendLocked(std::move(ts));
+    }
+    resyncing_ = false;
+}
+
+double MCT::segmentMean(size_t emotion, size_t begin, size_t end) const {
+    if (end <= begin) return 0.0;
+    double upper = entry_stats_[end - 1].cumulative[emotion];
+    double lower = begin == 0 ? stats_.prefix_base[emotion]
+                              : entry_stats_[begin - 1].cumulative[emotion];
+    return (upper - lower) / static_cast<double>(end - begin);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // INTÉGRATION ET ANALYSE
 // ═══════════════════════════════════════════════════════════════════════════
 
 MCTIntegration MCT::integrate() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    
+    return integrateLocked();
+}
+
+MCTIntegration MCT::integrateLocked() const {
     // Retourne le cache si valide
     if (cache_valid_ && cached_integration_) {
         return *cached_integration_;
@@ -135,27 +313,17 @@ MCTIntegration MCT::integrate() const {
         return result;
     }
     
+    const double n = static_cast<double>(buffer_.size());
+
     // Calcul de la fenêtre temporelle
     auto first_time = buffer_.front().timestamp;
     auto last_time = buffer_.back().timestamp;
     result.time_span_seconds = std::chrono::duration<double>(last_time - first_time).count();
     
-    // Moyenne pondérée des émotions
-    std::array<double, 24> weighted_sum{};
-    double total_weight = 0.0;
-    
-    for (const auto& ts : buffer_) {
-        double weight = computeWeight(ts.timestamp);
-        total_weight += weight;
-        
+    // Moyenne pondérée des émotions (accumulateurs pondérés)
+    if (stats_.weight_total > 0.0) {
         for (size_t i = 0; i < 24; ++i) {
-            weighted_sum[i] += ts.state.emotions[i] * weight;
-        }
-    }
-    
-    if (total_weight > 0.0) {
-        for (size_t i = 0; i < 24; ++i) {
-            result.integrated_state.emotions[i] = weighted_sum[i] / total_weight;
+            result.integrated_state.emotions[i] = stats_.weighted_sum[i] / stats_.weight_total;
         }
     }
     
@@ -164,18 +332,14 @@ MCTIntegration MCT::integrate() const {
                                     result.integrated_state.emotions.end(), 0.0);
     result.integrated_state.E_global = sum_e / 24.0;
     
-    // Calcul de la stabilité (inverse de l'écart-type moyen)
+    // Calcul de la stabilité (inverse de l'écart-type moyen autour de la moyenne pondérée)
+    // Σ(x - m)² / n = Σx²/n - 2m·Σx/n + m²
     if (buffer_.size() >= 2) {
         double sum_variance = 0.0;
         for (size_t i = 0; i < 24; ++i) {
             double mean = result.integrated_state.emotions[i];
-            double var = 0.0;
-            for (const auto& ts : buffer_) {
-                double diff = ts.state.emotions[i] - mean;
-                var += diff * diff;
-            }
-            var /= buffer_.size();
-            sum_variance += var;
+            double var = stats_.sum_sq[i] / n - 2.0 * mean * stats_.sum[i] / n + mean * mean;
+            sum_variance += std::max(0.0, var);
         }
         double avg_std = std::sqrt(sum_variance / 24.0);
         result.stability = std::max(0.0, 1.0 - avg_std * 2.0);  // Normalisation
@@ -186,19 +350,13 @@ MCTIntegration MCT::integrate() const {
     // Calcul de la volatilité (changements frame à frame)
     result.volatility = 1.0 - result.stability;
     
-    // Calcul de la tendance (régression linéaire simplifiée sur E_global)
+    // Calcul de la tendance (régression linéaire sur E_global, x = 0..n-1)
     if (buffer_.size() >= 3) {
-        double sum_x = 0.0, sum_y = 0.0, sum_xy = 0.0, sum_xx = 0.0;
-        double n = buffer_.size();
-        
-        for (size_t i = 0; i < buffer_.size(); ++i) {
-            double x = static_cast<double>(i);
-            double y = buffer_[i].state.E_global;
-            sum_x += x;
-            sum_y += y;
-            sum_xy += x * y;
-            sum_xx += x * x;
-        }
+        double sum_x = n * (n - 1.0) / 2.0;
+        double sum_xx = (n - 1.0) * n * (2.0 * n - 1.0) / 6.0;
+        double sum_y = stats_.sum_e;
+        double offset = static_cast<double>(stats_.front_seq - stats_.seq_base);
+        double sum_xy = stats_.sum_seq_e - offset * stats_.sum_e;
         
         double slope = (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x + 1e-10);
         result.trend = std::clamp(slope * 10.0, -1.0, 1.0);  // Normalisation
@@ -224,24 +382,14 @@ std::optional<EmotionalSignature> MCT::extractSignature() const {
     }
     
     EmotionalSignature sig;
+    const size_t count = buffer_.size();
+    const double n = static_cast<double>(count);
     
-    // Moyenne des émotions
-    for (size_t i = 0; i < 24; ++i) {
-        double sum = 0.0;
-        for (const auto& ts : buffer_) {
-            sum += ts.state.emotions[i];
-        }
-        sig.mean_emotions[i] = sum / buffer_.size();
-    }
-    
-    // Écart-type par émotion
+    // Moyenne et écart-type par émotion (accumulateurs glissants)
     for (size_t i = 0; i < 24; ++i) {
-        double sum_sq = 0.0;
-        for (const auto& ts : buffer_) {
-            double diff = ts.state.emotions[i] - sig.mean_emotions[i];
-            sum_sq += diff * diff;
-        }
-        sig.std_dev[i] = std::sqrt(sum_sq / buffer_.size());
+        sig.mean_emotions[i] = stats_.sum[i] / n;
+        double var = stats_.sum_sq[i] / n - sig.mean_emotions[i] * sig.mean_emotions[i];
+        sig.std_dev[i] = std::sqrt(std::max(0.0, var));
     }
     
     // Tendance, accélération, position du pic, oscillations
@@ -250,57 +398,30 @@ std::optional<EmotionalSignature> MCT::extractSignature() const {
     sig.peak_position.fill(0.5);
     sig.oscillation_count.fill(0);
 
-    if (buffer_.size() >= 5) {
-        size_t quarter = buffer_.size() / 4;
-        size_t third = buffer_.size() / 3;
+    if (count >= 5) {
+        size_t third = count / 3;
+        size_t mid_start = count / 3;
+        size_t mid_end = 2 * count / 3;
 
         for (size_t i = 0; i < 24; ++i) {
-            // Tendance (1ère dérivée) : différence début/fin
-            double early_avg = 0.0, late_avg = 0.0;
-            for (size_t j = 0; j < third; ++j) {
-                early_avg += buffer_[j].state.emotions[i];
-            }
-            for (size_t j = buffer_.size() - third; j < buffer_.size(); ++j) {
-                late_avg += buffer_[j].state.emotions[i];
-            }
-            early_avg /= third;
-            late_avg /= third;
+            // Tendance (1ère dérivée) : différence début/fin (sommes préfixes)
+            double early_avg = segmentMean(i, 0, third);
+            double late_avg = segmentMean(i, count - third, count);
             sig.trend[i] = late_avg - early_avg;
 
             // Accélération (2ème dérivée) : différence des tendances
-            double mid_avg = 0.0;
-            size_t mid_start = buffer_.size() / 3;
-            size_t mid_end = 2 * buffer_.size() / 3;
-            for (size_t j = mid_start; j < mid_end; ++j) {
-                mid_avg += buffer_[j].state.emotions[i];
-            }
-            mid_avg /= (mid_end - mid_start);
+            double mid_avg = segmentMean(i, mid_start, mid_end);
             double early_trend = mid_avg - early_avg;
             double late_trend = late_avg - mid_avg;
             sig.acceleration[i] = late_trend - early_trend;
 
-            // Position du pic [0, 1]
-            double max_val = 0.0;
-            size_t max_pos = 0;
-            for (size_t j = 0; j < buffer_.size(); ++j) {
-                if (buffer_[j].state.emotions[i] > max_val) {
-                    max_val = buffer_[j].state.emotions[i];
-                    max_pos = j;
-                }
-            }
-            sig.peak_position[i] = static_cast<double>(max_pos) / buffer_.size();
+            // Position du pic [0, 1] (maximum glissant)
+            const auto& window = peak_windows_[i];
+            size_t max_pos = window.empty() ? 0 : static_cast<size_t>(window.front() - stats_.front_seq);
+            sig.peak_position[i] = static_cast<double>(max_pos) / n;
 
             // Oscillations (changements de direction)
-            int oscillations = 0;
-            double prev_diff = 0.0;
-            for (size_t j = 1; j < buffer_.size(); ++j) {
-                double diff = buffer_[j].state.emotions[i] - buffer_[j-1].state.emotions[i];
-                if (j > 1 && prev_diff * diff < 0 && std::abs(diff) > 0.01) {
-                    oscillations++;
-                }
-                prev_diff = diff;
-            }
-            sig.oscillation_count[i] = oscillations;
+            sig.oscillation_count[i] = stats_.oscillations[i];
         }
     }
     
@@ -325,20 +446,9 @@ std::optional<EmotionalSignature> MCT::extractSignature() const {
     sig.stability = std::max(0.0, 1.0 - avg_std * 2.0);
 
     // Fréquence dominante (estimation simple basée sur oscillations E_global)
-    if (buffer_.size() >= 10) {
-        int global_oscillations = 0;
-        double prev_e = buffer_[0].state.E_global;
-        double prev_diff = 0.0;
-        for (size_t j = 1; j < buffer_.size(); ++j) {
-            double diff = buffer_[j].state.E_global - prev_e;
-            if (j > 1 && prev_diff * diff < 0 && std::abs(diff) > 0.02) {
-                global_oscillations++;
-            }
-            prev_diff = diff;
-            prev_e = buffer_[j].state.E_global;
-        }
+    if (count >= 10) {
         // Fréquence = oscillations / durée en secondes
-        sig.dominant_frequency = global_oscillations / config_.time_window_seconds;
+        sig.dominant_frequency = stats_.global_oscillations / config_.time_window_seconds;
     } else {
         sig.dominant_frequency = 0.0;
     }
@@ -419,6 +529,20 @@ size_t MCT::size() const {
     return buffer_.size();
 }
 
+size_t MCT::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = sizeof(*this);
+    bytes += buffer_.capacity() * sizeof(TimestampedState);
+    bytes += entry_stats_.capacity() * sizeof(EntryStats);
+    for (const auto& window : peak_windows_) {
+        bytes += window.capacity() * sizeof(uint64_t);
+    }
+    for (size_t i = 0; i < buffer_.size(); ++i) {
+        bytes += buffer_[i].context.capacity();
+    }
+    return bytes;
+}
+
 bool MCT::empty() const {
     std::lock_guard<std::mutex> lock(mutex_);
     return buffer_.empty();
@@ -429,6 +553,10 @@ bool MCT::empty() const {
 // ═══════════════════════════════════════════════════════════════════════════
 
 nlohmann::json MCT::toJson() const {
+    // Calculés avant le verrou (integrate/extractSignature verrouillent eux-mêmes)
+    auto integration = integrate();
+    auto sig_opt = extractSignature();
+
     std::lock_guard<std::mutex> lock(mutex_);
     
     nlohmann::json j;
@@ -445,7 +573,6 @@ nlohmann::json MCT::toJson() const {
     j["buffer_size"] = buffer_.size();
     
     // Intégration actuelle
-    auto integration = integrate();
     j["integration"] = {
         {"stability", integration.stability},
         {"volatility", integration.volatility},
@@ -456,7 +583,6 @@ nlohmann::json MCT::toJson() const {
     };
     
     // Signature si disponible
-    auto sig_opt = extractSignature();
     if (sig_opt) {
         const auto& sig = *sig_opt;
         j["signature"] = {
@@ -472,7 +598,24 @@ nlohmann::json MCT::toJson() const {
         }
         j["signature"]["mean_emotions"] = emotions_json;
     }
-    
+
+    // Contenu du buffer, horodaté par son âge : steady_clock n'a de sens que
+    // dans le processus qui l'a produit (transfert de session entre nœuds)
+    const auto now = SessionClock::now();
+    nlohmann::json buffer_json = nlohmann::json::array();
+    for (const auto& ts : buffer_) {
+        buffer_json.push_back({
+            {"age_seconds", std::chrono::duration<double>(now - ts.timestamp).count()},
+            {"emotions", ts.state.emotions},
+            {"E_global", ts.state.E_global},
+            {"variance_global", ts.state.variance_global},
+            {"speech_sentiment", ts.speech_sentiment},
+            {"speech_arousal", ts.speech_arousal},
+            {"context", ts.context}
+        });
+    }
+    j["buffer"] = std::move(buffer_json);
+
     return j;
 }
 
@@ -488,6 +631,32 @@ void MCT::fromJson(const nlohmann::json& j) {
         if (c.contains("volatility_threshold")) config_.volatility_threshold = c["volatility_threshold"];
         if (c.contains("use_exponential_weighting")) config_.use_exponential_weighting = c["use_exponential_weighting"];
         if (c.contains("min_samples_for_signature")) config_.min_samples_for_signature = c["min_samples_for_signature"];
+        applyCapacityLocked();
+        resyncLocked();
+    }
+
+    if (j.contains("buffer")) {
+        const auto now = SessionClock::now();
+        buffer_.clear();
+        for (const auto& e : j["buffer"]) {
+            TimestampedState ts;
+            ts.timestamp = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(e.value("age_seconds", 0.0)));
+            if (e.contains("emotions")) {
+                const auto& emotions = e["emotions"];
+                for (size_t i = 0; i < 24 && i < emotions.size(); ++i) {
+                    ts.state.emotions[i] = emotions[i];
+                }
+            }
+            ts.state.E_global = e.value("E_global", 0.0);
+            ts.state.variance_global = e.value("variance_global", 0.0);
+            ts.state.timestamp = ts.timestamp;
+            ts.speech_sentiment = e.value("speech_sentiment", 0.0);
+            ts.speech_arousal = e.value("speech_arousal", 0.0);
+            ts.context = e.value("context", std::string());
+            buffer_.push_back(std::move(ts));
+        }
+        resyncLocked();  // Statistiques incrémentales et fenêtres de pics
     }
     
     invalidateCache();
@@ -507,7 +676,7 @@ double MCT::computeWeight(const std::chrono::steady_clock::time_point& timestamp
         return 1.0;
     }
     
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     double age = std::chrono::duration<double>(now - timestamp).count();
     
     // Poids exponentiel décroissant
@@ -1,9 +1,10 @@
 #include "MCTGraph.hpp"
+#include "Logger.hpp"
 #include <algorithm>
+#include <charconv>
 #include <numeric>
-#include <sstream>
-#include <iomanip>
 #include <cmath>
+#include <iterator>
 
 namespace mcee {
 
@@ -46,10 +47,10 @@ nlohmann::json WordNode::toJson() const {
     return {
         {"id", id},
         {"type", "WORD"},
-        {"lemma", lemma},
-        {"pos", pos},
+        {"lemma", lemmaText()},
+        {"pos", posText()},
         {"sentence_id", sentence_id},
-        {"original_form", original_form},
+        {"original_form", originalText()},
         {"timestamp_ms", ts},
         {"sentiment_score", sentiment_score},
         {"is_negation", is_negation},
@@ -60,10 +61,11 @@ nlohmann::json WordNode::toJson() const {
 WordNode WordNode::fromJson(const nlohmann::json& j) {
     WordNode node;
     node.id = j.value("id", "");
-    node.lemma = j.value("lemma", "");
-    node.pos = j.value("pos", "");
+    auto& lemmas = LemmaTable::instance();
+    node.lemma = lemmas.intern(j.value("lemma", ""));
+    node.pos = lemmas.intern(j.value("pos", ""));
     node.sentence_id = j.value("sentence_id", "");
-    node.original_form = j.value("original_form", "");
+    node.original_form = lemmas.intern(j.value("original_form", ""));
     node.sentiment_score = j.value("sentiment_score", 0.0);
     node.is_negation = j.value("is_negation", false);
     node.is_intensifier = j.value("is_intensifier", false);
@@ -73,7 +75,7 @@ WordNode WordNode::fromJson(const nlohmann::json& j) {
         node.timestamp = std::chrono::steady_clock::time_point(
             std::chrono::milliseconds(ms));
     } else {
-        node.timestamp = std::chrono::steady_clock::now();
+        node.timestamp = SessionClock::now();
     }
 
     return node;
@@ -129,7 +131,7 @@ EmotionNode EmotionNode::fromJson(const nlohmann::json& j) {
         node.timestamp = std::chrono::steady_clock::time_point(
             std::chrono::milliseconds(ms));
     } else {
-        node.timestamp = std::chrono::steady_clock::now();
+        node.timestamp = SessionClock::now();
     }
 
     if (j.contains("end_timestamp_ms")) {
@@ -196,7 +198,7 @@ GraphEdge GraphEdge::fromJson(const nlohmann::json& j) {
         edge.created_at = std::chrono::steady_clock::time_point(
             std::chrono::milliseconds(ms));
     } else {
-        edge.created_at = std::chrono::steady_clock::now();
+        edge.created_at = SessionClock::now();
     }
 
     return edge;
@@ -206,6 +208,50 @@ GraphEdge GraphEdge::fromJson(const nlohmann::json& j) {
 // MCTGraphSnapshot
 // ============================================================================
 
+namespace {
+
+nlohmann::json statisticsToJson(const MCTGraphSnapshot::Statistics& stats) {
+    return {
+        {"total_words", stats.total_words},
+        {"total_emotions", stats.total_emotions},
+        {"causal_edges", stats.causal_edges},
+        {"temporal_edges", stats.temporal_edges},
+        {"semantic_edges", stats.semantic_edges},
+        {"average_emotion_intensity", stats.average_emotion_intensity},
+        {"most_frequent_emotion", stats.most_frequent_emotion},
+        {"top_trigger_words", stats.top_trigger_words},
+        {"graph_density", stats.graph_density},
+        {"time_span_seconds", stats.time_span_seconds}
+    };
+}
+
+MCTGraphSnapshot::Statistics statisticsFromJson(const nlohmann::json& s) {
+    MCTGraphSnapshot::Statistics stats;
+    stats.total_words = s.value("total_words", size_t(0));
+    stats.total_emotions = s.value("total_emotions", size_t(0));
+    stats.causal_edges = s.value("causal_edges", size_t(0));
+    stats.temporal_edges = s.value("temporal_edges", size_t(0));
+    stats.semantic_edges = s.value("semantic_edges", size_t(0));
+    stats.average_emotion_intensity = s.value("average_emotion_intensity", 0.0);
+    stats.most_frequent_emotion = s.value("most_frequent_emotion", "");
+    stats.graph_density = s.value("graph_density", 0.0);
+    stats.time_span_seconds = s.value("time_span_seconds", 0.0);
+
+    if (s.contains("top_trigger_words")) {
+        for (const auto& w : s["top_trigger_words"]) {
+            stats.top_trigger_words.push_back(w.get<std::string>());
+        }
+    }
+    return stats;
+}
+
+/// Octets alloués hors de l'objet (0 sous le seuil SSO)
+size_t heapBytes(const std::string& s) {
+    return s.capacity() > std::string().capacity() ? s.capacity() + 1 : 0;
+}
+
+} // namespace
+
 nlohmann::json MCTGraphSnapshot::toJson() const {
     auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(
         timestamp.time_since_epoch()).count();
@@ -231,18 +277,7 @@ nlohmann::json MCTGraphSnapshot::toJson() const {
         {"word_nodes", words_json},
         {"emotion_nodes", emotions_json},
         {"edges", edges_json},
-        {"statistics", {
-            {"total_words", stats.total_words},
-            {"total_emotions", stats.total_emotions},
-            {"causal_edges", stats.causal_edges},
-            {"temporal_edges", stats.temporal_edges},
-            {"semantic_edges", stats.semantic_edges},
-            {"average_emotion_intensity", stats.average_emotion_intensity},
-            {"most_frequent_emotion", stats.most_frequent_emotion},
-            {"top_trigger_words", stats.top_trigger_words},
-            {"graph_density", stats.graph_density},
-            {"time_span_seconds", stats.time_span_seconds}
-        }}
+        {"statistics", statisticsToJson(stats)}
     };
 }
 
@@ -275,92 +310,647 @@ MCTGraphSnapshot MCTGraphSnapshot::fromJson(const nlohmann::json& j) {
     }
 
     if (j.contains("statistics")) {
-        const auto& s = j["statistics"];
-        snapshot.stats.total_words = s.value("total_words", size_t(0));
-        snapshot.stats.total_emotions = s.value("total_emotions", size_t(0));
-        snapshot.stats.causal_edges = s.value("causal_edges", size_t(0));
-        snapshot.stats.temporal_edges = s.value("temporal_edges", size_t(0));
-        snapshot.stats.semantic_edges = s.value("semantic_edges", size_t(0));
-        snapshot.stats.average_emotion_intensity = s.value("average_emotion_intensity", 0.0);
-        snapshot.stats.most_frequent_emotion = s.value("most_frequent_emotion", "");
-        snapshot.stats.graph_density = s.value("graph_density", 0.0);
-        snapshot.stats.time_span_seconds = s.value("time_span_seconds", 0.0);
-
-        if (s.contains("top_trigger_words")) {
-            for (const auto& w : s["top_trigger_words"]) {
-                snapshot.stats.top_trigger_words.push_back(w.get<std::string>());
-            }
-        }
+        snapshot.stats = statisticsFromJson(j["statistics"]);
     }
 
     return snapshot;
 }
 
+// ============================================================================
+// MCTGraphDelta
+// ============================================================================
+
+nlohmann::json MCTGraphDelta::toJson() const {
+    auto ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        timestamp.time_since_epoch()).count();
+
+    nlohmann::json words_json = nlohmann::json::array();
+    for (const auto& w : word_nodes) {
+        words_json.push_back(w.toJson());
+    }
+
+    nlohmann::json emotions_json = nlohmann::json::array();
+    for (const auto& e : emotion_nodes) {
+        emotions_json.push_back(e.toJson());
+    }
+
+    nlohmann::json edges_json = nlohmann::json::array();
+    for (const auto& e : edges) {
+        edges_json.push_back(e.toJson());
+    }
+
+    // Une keyframe reste lisible comme un MCTGraphSnapshot complet
+    return {
+        {"kind", keyframe ? "keyframe" : "delta"},
+        {"sequence", sequence},
+        {"base_sequence", base_sequence},
+        {"snapshot_id", snapshot_id},
+        {"timestamp_ms", ts},
+        {"word_nodes", words_json},
+        {"emotion_nodes", emotions_json},
+        {"edges", edges_json},
+        {"removed_node_ids", removed_node_ids},
+        {"removed_edge_ids", removed_edge_ids},
+        {"decay_epoch", decay_epoch},
+        {"edge_decay_factor", edge_decay_factor},
+        {"statistics", statisticsToJson(stats)}
+    };
+}
+
+MCTGraphDelta MCTGraphDelta::fromJson(const nlohmann::json& j) {
+    MCTGraphDelta delta;
+    delta.keyframe = j.value("kind", "keyframe") != "delta";
+    delta.sequence = j.value("sequence", uint64_t(0));
+    delta.base_sequence = j.value("base_sequence", uint64_t(0));
+    delta.snapshot_id = j.value("snapshot_id", "");
+    delta.decay_epoch = j.value("decay_epoch", uint32_t(0));
+    delta.edge_decay_factor = j.value("edge_decay_factor", 1.0);
+
+    if (j.contains("timestamp_ms")) {
+        auto ms = j["timestamp_ms"].get<int64_t>();
+        delta.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::milliseconds(ms));
+    }
+
+    if (j.contains("word_nodes")) {
+        for (const auto& w : j["word_nodes"]) {
+            delta.word_nodes.push_back(WordNode::fromJson(w));
+        }
+    }
+
+    if (j.contains("emotion_nodes")) {
+        for (const auto& e : j["emotion_nodes"]) {
+            delta.emotion_nodes.push_back(EmotionNode::fromJson(e));
+        }
+    }
+
+    if (j.contains("edges")) {
+        for (const auto& e : j["edges"]) {
+            delta.edges.push_back(GraphEdge::fromJson(e));
+        }
+    }
+
+    if (j.contains("removed_node_ids")) {
+        delta.removed_node_ids = j["removed_node_ids"].get<std::vector<std::string>>();
+    }
+
+    if (j.contains("removed_edge_ids")) {
+        delta.removed_edge_ids = j["removed_edge_ids"].get<std::vector<std::string>>();
+    }
+
+    if (j.contains("statistics")) {
+        delta.stats = statisticsFromJson(j["statistics"]);
+    }
+
+    return delta;
+}
+
 // ============================================================================
 // MCTGraph - Constructeur
 // ============================================================================
 
 MCTGraph::MCTGraph(const MCTGraphConfig& config)
     : config_(config)
-    , last_snapshot_time_(std::chrono::steady_clock::now()) {
+    , last_snapshot_time_(SessionClock::now()) {
 }
 
 // ============================================================================
 // Génération d'ID
 // ============================================================================
 
-std::string MCTGraph::generateId(const std::string& prefix) const {
-    auto now = std::chrono::steady_clock::now();
+std::string MCTGraph::generateId(std::string_view prefix) const {
+    auto now = SessionClock::now();
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()).count();
     uint64_t count = id_counter_.fetch_add(1);
 
-    std::ostringstream oss;
-    oss << prefix << "_" << ms << "_" << count;
-    return oss.str();
+    // Chiffres formatés sur la pile : une seule allocation, celle de l'ID conservé
+    char digits[48];
+    char* end = std::to_chars(digits, digits + sizeof(digits), ms).ptr;
+    *end++ = '_';
+    end = std::to_chars(end, digits + sizeof(digits), count).ptr;
+
+    std::string id;
+    id.reserve(prefix.size() + 1 + static_cast<size_t>(end - digits));
+    id.append(prefix).push_back('_');
+    id.append(digits, end);
+    return id;
+}
+
+uint32_t MCTGraph::StringTable::intern(const std::string& s) {
+    auto it = index.find(s);
+    if (it != index.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    strings.push_back(s);
+    index.emplace(s, id);
+    return id;
+}
+
+// ============================================================================
+// Cœur compact : slabs de nœuds et d'arêtes
+// ============================================================================
+
+MCTGraph::NodeHandle MCTGraph::findNode(const std::string& id) const {
+    auto it = node_ids_.find(id);
+    return it != node_ids_.end() ? it->second : INVALID_HANDLE;
+}
+
+MCTGraph::NodeHandle MCTGraph::allocateSlot(NodeType type, uint32_t payload) {
+    NodeHandle h;
+    if (!free_slots_.empty()) {
+        h = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        h = static_cast<NodeHandle>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    auto& slot = slots_[h];
+    slot.type = type;
+    slot.alive = true;
+    slot.payload = payload;
+    slot.edges.clear();
+    slot.causal_out = 0;
+    slot.rank_pos = INVALID_HANDLE;
+    slot.causal_weight = 0.0;
+    return h;
+}
+
+MCTGraph::NodeHandle MCTGraph::insertWordLocked(WordNode node) {
+    NodeHandle existing = findNode(node.id);
+    if (existing != INVALID_HANDLE) {
+        unindexTimeLocked(existing);
+        removeNodeLocked(existing);
+    }
+
+    NodeHandle h = allocateSlot(NodeType::WORD, static_cast<uint32_t>(words_.size()));
+    node_ids_[node.id] = h;
+    lemma_index_[node.lemma].push_back(h);
+    words_.push_back(std::move(node));
+    word_handles_.push_back(h);
+    indexTimeLocked(h);
+    markNodeDirty(h);
+    return h;
+}
+
+MCTGraph::NodeHandle MCTGraph::insertEmotionLocked(EmotionNode node) {
+    NodeHandle existing = findNode(node.id);
+    if (existing != INVALID_HANDLE) {
+        unindexTimeLocked(existing);
+        removeNodeLocked(existing);
+    }
+
+    NodeHandle h = allocateSlot(NodeType::EMOTION, static_cast<uint32_t>(emotions_.size()));
+    node_ids_[node.id] = h;
+    tallyEmotionLocked(node, true);
+    emotions_.push_back(std::move(node));
+    emotion_handles_.push_back(h);
+    indexTimeLocked(h);
+    markNodeDirty(h);
+    return h;
+}
+
+void MCTGraph::removeNodeLocked(NodeHandle h) {
+    auto& slot = slots_[h];
+
+    // Détacher les arêtes incidentes (la liste du nœud est vidée d'abord)
+    std::vector<EdgeHandle> incident;
+    incident.swap(slot.edges);
+    for (EdgeHandle e : incident) {
+        if (edges_[e].alive) {
+            releaseEdgeLocked(e);
+        }
+    }
+    incident.clear();
+    slot.edges.swap(incident);  // Conserver la capacité pour le recyclage du slot
+
+    if (!resync_) {
+        removed_node_ids_.push_back(nodeId(h));
+        checkChangeLogLocked();
+    }
+    node_ids_.erase(nodeId(h));
+
+    // Suppression par échange avec le dernier élément du pool dense
+    uint32_t idx = slot.payload;
+    if (slot.type == NodeType::WORD) {
+        auto occurrences = lemma_index_.find(words_[idx].lemma);
+        if (occurrences != lemma_index_.end()) {
+            auto& handles = occurrences->second;
+            auto pos = std::find(handles.begin(), handles.end(), h);
+            if (pos != handles.end()) {
+                *pos = handles.back();
+                handles.pop_back();
+            }
+            if (handles.empty()) lemma_index_.erase(occurrences);
+        }
+
+        uint32_t last = static_cast<uint32_t>(words_.size() - 1);
+        if (idx != last) {
+            WordNode moved = std::move(words_.mut(last));
+            words_.mut(idx) = std::move(moved);
+            word_handles_.mut(idx) = word_handles_[last];
+            slots_[word_handles_[idx]].payload = idx;
+        }
+        words_.pop_back();
+        word_handles_.pop_back();
+    } else {
+        tallyEmotionLocked(emotions_[idx], false);
+        uint32_t last = static_cast<uint32_t>(emotions_.size() - 1);
+        if (idx != last) {
+            EmotionNode moved = std::move(emotions_.mut(last));
+            emotions_.mut(idx) = std::move(moved);
+            emotion_handles_.mut(idx) = emotion_handles_[last];
+            slots_[emotion_handles_[idx]].payload = idx;
+        }
+        emotions_.pop_back();
+        emotion_handles_.pop_back();
+    }
+
+    slot.alive = false;
+    free_slots_.push_back(h);
+}
+
+void MCTGraph::indexTimeLocked(NodeHandle h) {
+    auto& timeline = timelineOf(h);
+    TimeEntry entry{nodeTimestamp(h), h};
+
+    // Cas courant : timestamps croissants → ajout en queue O(1)
+    if (timeline.empty() || timeline.back().timestamp <= entry.timestamp) {
+        timeline.push_back(entry);
+        return;
+    }
+
+    auto pos = std::upper_bound(timeline.begin(), timeline.end(), entry.timestamp,
+        [](const auto& ts, const TimeEntry& e) { return ts < e.timestamp; });
+    timeline.insert(pos, entry);
+}
+
+void MCTGraph::unindexTimeLocked(NodeHandle h) {
+    auto& timeline = timelineOf(h);
+    auto ts = nodeTimestamp(h);
+
+    auto it = std::lower_bound(timeline.begin(), timeline.end(), ts,
+        [](const TimeEntry& e, const auto& t) { return e.timestamp < t; });
+    for (; it != timeline.end() && it->timestamp == ts; ++it) {
+        if (it->handle == h) {
+            timeline.erase(it);
+            return;
+        }
+    }
+}
+
+const std::string& MCTGraph::nodeId(NodeHandle h) const {
+    return isWord(h) ? wordAt(h).id : emotionAt(h).id;
+}
+
+std::chrono::steady_clock::time_point MCTGraph::nodeTimestamp(NodeHandle h) const {
+    return isWord(h) ? wordAt(h).timestamp : emotionAt(h).timestamp;
+}
+
+MCTGraph::EdgeHandle MCTGraph::insertEdgeLocked(NodeHandle source, NodeHandle target,
+                                                EdgeType type, double weight,
+                                                double temporal_distance_ms) {
+    EdgeHandle e;
+    if (!free_edges_.empty()) {
+        e = free_edges_.back();
+        free_edges_.pop_back();
+    } else {
+        e = static_cast<EdgeHandle>(edges_.size());
+        edges_.push_back(EdgeRecord{});
+    }
+
+    auto& edge = edges_.mut(e);
+    edge = EdgeRecord{};
+    edge.source = source;
+    edge.target = target;
+    edge.type = type;
+    edge.alive = true;
+    edge.decay_epoch = decay_epoch_;
+    edge.seq = id_counter_.fetch_add(1);
+    edge.weight = weight;
+    edge.temporal_distance_ms = temporal_distance_ms;
+    edge.created_at = SessionClock::now();
+
+    slots_[source].edges.push_back(e);
+    slots_[target].edges.push_back(e);
+    ++edge_count_;
+    tallyEdgeLocked(edge, true);
+    markEdgeDirty(e);
+    return e;
+}
+
+void MCTGraph::releaseEdgeLocked(EdgeHandle e) {
+    if (!resync_) {
+        removed_edge_ids_.push_back(edgeId(e));
+        checkChangeLogLocked();
+    }
+
+    auto& edge = edges_.mut(e);
+    std::erase(slots_[edge.source].edges, e);
+    if (edge.target != edge.source) {
+        std::erase(slots_[edge.target].edges, e);
+    }
+    edge.alive = false;
+    free_edges_.push_back(e);
+    --edge_count_;
+    tallyEdgeLocked(edge, false);
+}
+
+// ============================================================================
+// Agrégats incrémentaux
+// ============================================================================
+
+void MCTGraph::tallyEdgeLocked(const EdgeRecord& edge, bool added) {
+    auto& type_count = edge_type_counts_[static_cast<size_t>(edge.type)];
+    type_count = added ? type_count + 1 : type_count - 1;
+    if (edge.type != EdgeType::CAUSAL) return;
+
+    auto& slot = slots_[edge.source];
+    if (added) {
+        slot.causal_out++;
+        slot.causal_weight += tallyWeight(edge);
+    } else {
+        slot.causal_out--;
+        // Dernière arête : remise à zéro exacte (pas de résidu d'arrondi)
+        slot.causal_weight = slot.causal_out == 0 ? 0.0 : slot.causal_weight - tallyWeight(edge);
+    }
+    rankUpdateLocked(edge.source);
+}
+
+void MCTGraph::tallyEmotionLocked(const EmotionNode& node, bool added) {
+    if (added) {
+        emotion_intensity_sum_ += node.intensity;
+        dominant_counts_[node.dominant_emotion]++;
+        return;
+    }
+
+    emotion_intensity_sum_ = emotions_.size() <= 1 ? 0.0 : emotion_intensity_sum_ - node.intensity;
+    auto it = dominant_counts_.find(node.dominant_emotion);
+    if (it != dominant_counts_.end() && --it->second == 0) {
+        dominant_counts_.erase(it);
+    }
+}
+
+double MCTGraph::tallyWeight(const EdgeRecord& edge) const {
+    // Poids de l'arête exprimé à l'époque tally_epoch_ (âge négatif : arête plus récente)
+    const auto age = static_cast<int32_t>(tally_epoch_ - edge.decay_epoch);
+    if (age == 0) return edge.weight;
+    if (config_.edge_decay_factor <= 0.0) return age > 0 ? 0.0 : edge.weight;
+    return edge.weight * std::pow(config_.edge_decay_factor, static_cast<double>(age));
+}
+
+double MCTGraph::tallyScale() const {
+    const uint32_t age = decay_epoch_ - tally_epoch_;
+    return age == 0 ? 1.0 : std::pow(config_.edge_decay_factor, static_cast<double>(age));
+}
+
+void MCTGraph::rebaseTalliesLocked() {
+    // Facteur commun : l'ordre du tas est inchangé
+    const double scale = tallyScale();
+    for (NodeHandle h : causal_rank_) {
+        slots_[h].causal_weight *= scale;
+    }
+    tally_epoch_ = decay_epoch_;
+}
+
+void MCTGraph::rankSwap(size_t a, size_t b) {
+    std::swap(causal_rank_[a], causal_rank_[b]);
+    slots_[causal_rank_[a]].rank_pos = static_cast<uint32_t>(a);
+    slots_[causal_rank_[b]].rank_pos = static_cast<uint32_t>(b);
+}
+
+void MCTGraph::rankUpdateLocked(NodeHandle h) {
+    auto& slot = slots_[h];
+
+    if (slot.causal_out == 0) {
+        if (slot.rank_pos == INVALID_HANDLE) return;
+        size_t pos = slot.rank_pos;
+        rankSwap(pos, causal_rank_.size() - 1);
+        causal_rank_.pop_back();
+        slot.rank_pos = INVALID_HANDLE;
+        if (pos == causal_rank_.size()) return;
+        h = causal_rank_[pos];   // L'ancien dernier, à replacer
+    } else if (slot.rank_pos == INVALID_HANDLE) {
+        slot.rank_pos = static_cast<uint32_t>(causal_rank_.size());
+        causal_rank_.push_back(h);
+    }
+
+    // Remontée puis descente : une seule des deux déplace le nœud
+    size_t pos = slots_[h].rank_pos;
+    const double key = causalKey(h);
+    while (pos > 0 && causalKey(causal_rank_[(pos - 1) / 2]) < key) {
+        rankSwap(pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+    while (true) {
+        size_t best = pos;
+        for (size_t child : {2 * pos + 1, 2 * pos + 2}) {
+            if (child < causal_rank_.size() && causalKey(causal_rank_[child]) > causalKey(causal_rank_[best])) {
+                best = child;
+            }
+        }
+        if (best == pos) break;
+        rankSwap(pos, best);
+        pos = best;
+    }
+}
+
+std::vector<MCTGraph::NodeHandle> MCTGraph::topCausalSourcesLocked(size_t k, double min_strength) const {
+    std::vector<NodeHandle> result;
+    if (k == 0 || causal_rank_.empty()) return result;
+
+    // Parcours best-first du tas (sans le modifier) : frontière de positions
+    const double scale = tallyScale();
+    auto weaker = [this](size_t a, size_t b) { return causalKey(causal_rank_[a]) < causalKey(causal_rank_[b]); };
+    std::vector<size_t> frontier{0};
+    while (!frontier.empty() && result.size() < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), weaker);
+        size_t pos = frontier.back();
+        frontier.pop_back();
+
+        NodeHandle h = causal_rank_[pos];
+        if (causalKey(h) * scale < min_strength) break;
+        result.push_back(h);
+
+        for (size_t child : {2 * pos + 1, 2 * pos + 2}) {
+            if (child < causal_rank_.size()) {
+                frontier.push_back(child);
+                std::push_heap(frontier.begin(), frontier.end(), weaker);
+            }
+        }
+    }
+    return result;
+}
+
+MCTGraphSnapshot::Statistics MCTGraph::statisticsLocked() const {
+    MCTGraphSnapshot::Statistics stats;
+
+    stats.total_words = words_.size();
+    stats.total_emotions = emotions_.size();
+    stats.causal_edges = edge_type_counts_[static_cast<size_t>(EdgeType::CAUSAL)];
+    stats.temporal_edges = edge_type_counts_[static_cast<size_t>(EdgeType::TEMPORAL)];
+    stats.semantic_edges = edge_type_counts_[static_cast<size_t>(EdgeType::SEMANTIC)];
+
+    if (!emotions_.empty()) {
+        stats.average_emotion_intensity = emotion_intensity_sum_ / emotions_.size();
+
+        size_t max_count = 0;
+        for (const auto& [name, count] : dominant_counts_) {
+            if (count > max_count) {
+                max_count = count;
+                stats.most_frequent_emotion = name;
+            }
+        }
+    }
+
+    // Mots de plus forte causalité moyenne, un par lemme
+    std::array<LemmaId, TOP_TRIGGER_WORDS> top_lemmas{};
+    size_t top_count = 0;
+    for (NodeHandle h : topCausalSourcesLocked(TOP_TRIGGER_SCAN, 0.0)) {
+        if (top_count >= TOP_TRIGGER_WORDS) break;
+        if (!isWord(h)) continue;
+        const LemmaId lemma = wordAt(h).lemma;
+        if (std::find(top_lemmas.begin(), top_lemmas.begin() + top_count, lemma) ==
+            top_lemmas.begin() + top_count) {
+            top_lemmas[top_count++] = lemma;
+            stats.top_trigger_words.emplace_back(wordAt(h).lemmaText());
+        }
+    }
+
+    size_t n = stats.total_words + stats.total_emotions;
+    if (n >= 2) {
+        size_t max_edges = n * (n - 1) / 2;
+        stats.graph_density = static_cast<double>(edge_count_) / max_edges;
+    }
+
+    // Les index temporels sont triés : extrémités en tête et en queue
+    auto min_time = std::chrono::steady_clock::time_point::max();
+    auto max_time = std::chrono::steady_clock::time_point::min();
+    for (const auto* timeline : {&word_timeline_, &emotion_timeline_}) {
+        if (timeline->empty()) continue;
+        min_time = std::min(min_time, timeline->front().timestamp);
+        max_time = std::max(max_time, timeline->back().timestamp);
+    }
+    if (min_time < max_time) {
+        stats.time_span_seconds = std::chrono::duration<double>(max_time - min_time).count();
+    }
+
+    return stats;
+}
+
+void MCTGraph::markNodeDirty(NodeHandle h) {
+    if (resync_) return;  // La keyframe à venir transmettra tout
+    if (node_marks_.size() <= h) {
+        node_marks_.resize(slots_.size(), 0);
+    }
+    // Génération = séquence du prochain delta
+    if (node_marks_[h] != delta_sequence_ + 1) {
+        node_marks_[h] = delta_sequence_ + 1;
+        dirty_nodes_.push_back(h);
+        checkChangeLogLocked();
+    }
+}
+
+void MCTGraph::markEdgeDirty(EdgeHandle e) {
+    if (resync_) return;
+    if (edge_marks_.size() <= e) {
+        edge_marks_.resize(edges_.size(), 0);
+    }
+    if (edge_marks_[e] != delta_sequence_ + 1) {
+        edge_marks_[e] = delta_sequence_ + 1;
+        dirty_edges_.push_back(e);
+        checkChangeLogLocked();
+    }
+}
+
+void MCTGraph::checkChangeLogLocked() {
+    // Un delta plus gros que le graphe ne vaut pas mieux qu'une keyframe :
+    // abandonner le journal (et sa mémoire) jusqu'à la prochaine capture
+    size_t logged = dirty_nodes_.size() + dirty_edges_.size() +
+                    removed_node_ids_.size() + removed_edge_ids_.size();
+    size_t graph = words_.size() + emotions_.size() + edge_count_;
+    if (logged > graph + 1024) {
+        resetChangeLogLocked();
+        resync_ = true;
+    }
+}
+
+void MCTGraph::resetChangeLogLocked() {
+    dirty_nodes_.clear();
+    dirty_edges_.clear();
+    removed_node_ids_.clear();
+    removed_edge_ids_.clear();
+}
+
+std::string MCTGraph::edgeId(EdgeHandle e) const {
+    return recordId(edges_[e], names_.strings);
+}
+
+std::string MCTGraph::recordId(const EdgeRecord& edge, const CowVector<std::string>& names) {
+    if (edge.name != NO_NAME) {
+        return names[edge.name];
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        edge.created_at.time_since_epoch()).count();
+    return "EDGE_" + std::to_string(ms) + "_" + std::to_string(edge.seq);
+}
+
+double MCTGraph::effectiveWeight(const EdgeRecord& edge, uint32_t epoch, double factor) {
+    uint32_t age = epoch - edge.decay_epoch;
+    return age == 0 ? edge.weight : edge.weight * std::pow(factor, static_cast<double>(age));
+}
+
+uint32_t MCTGraph::nextVisitEpoch() const {
+    if (visit_marks_.size() < slots_.size()) {
+        visit_marks_.resize(slots_.size(), 0);
+    }
+    if (++visit_epoch_ == 0) {
+        std::fill(visit_marks_.begin(), visit_marks_.end(), 0);
+        visit_epoch_ = 1;
+    }
+    return visit_epoch_;
 }
 
 // ============================================================================
 // Ajout de nœuds WORD
 // ============================================================================
 
-std::string MCTGraph::addWord(const std::string& lemma,
-                               const std::string& pos,
-                               const std::string& sentence_id,
-                               const std::string& original_form) {
+std::string MCTGraph::addWord(std::string_view lemma,
+                               std::string_view pos,
+                               std::string_view sentence_id,
+                               std::string_view original_form) {
+    // Internement et propriétés lexicales (hors verrou) : aucune copie de chaîne
+    auto& lemmas = LemmaTable::instance();
+    const LemmaId lemma_id = lemmas.intern(lemma);
+    const LemmaId pos_id = lemmas.intern(pos);
+    const LemmaId original_id = original_form.empty() || original_form == lemma
+        ? lemma_id : lemmas.intern(original_form);
+    const uint16_t flags = lemmas.flags(lemma_id);
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Vérification limite de nœuds
-    if (word_nodes_.size() + emotion_nodes_.size() >= config_.max_nodes) {
-        pruneExpiredNodes();
+    if (words_.size() + emotions_.size() >= config_.max_nodes) {
+        pruneExpiredLocked();
     }
 
     WordNode node;
     node.id = generateId("WORD");
-    node.lemma = lemma;
-    node.pos = pos;
+    node.lemma = lemma_id;
+    node.pos = pos_id;
     node.sentence_id = sentence_id;
-    node.original_form = original_form.empty() ? lemma : original_form;
-    node.timestamp = std::chrono::steady_clock::now();
-
-    // Détection automatique de négation/intensificateur
-    static const std::vector<std::string> negations = {
-        "ne", "pas", "jamais", "rien", "aucun", "personne", "non"
-    };
-    static const std::vector<std::string> intensifiers = {
-        "très", "vraiment", "extrêmement", "tellement", "super", "trop"
-    };
-
-    std::string lower_lemma = lemma;
-    std::transform(lower_lemma.begin(), lower_lemma.end(), lower_lemma.begin(), ::tolower);
-
-    node.is_negation = std::find(negations.begin(), negations.end(), lower_lemma) != negations.end();
-    node.is_intensifier = std::find(intensifiers.begin(), intensifiers.end(), lower_lemma) != intensifiers.end();
+    node.original_form = original_id;
+    node.timestamp = SessionClock::now();
+    node.sentiment_score = lemmas.emotionScore(lemma_id);   // Remplacé par le sentiment NLP s'il est fourni
+    node.is_negation = flags & LemmaTable::NEGATION;
+    node.is_intensifier = flags & LemmaTable::INTENSIFIER;
 
-    word_nodes_[node.id] = node;
-    adjacency_[node.id] = {};
+    std::string id = node.id;
+    insertWordLocked(std::move(node));
 
-    return node.id;
+    return id;
 }
 
 std::string MCTGraph::addWordFromJson(const nlohmann::json& word_data) {
@@ -374,8 +964,10 @@ std::string MCTGraph::addWordFromJson(const nlohmann::json& word_data) {
     // Mise à jour avec métadonnées supplémentaires si présentes
     if (word_data.contains("sentiment")) {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (word_nodes_.count(word_id)) {
-            word_nodes_[word_id].sentiment_score = word_data["sentiment"].get<double>();
+        NodeHandle h = findNode(word_id);
+        if (h != INVALID_HANDLE && isWord(h)) {
+            wordAt(h).sentiment_score = word_data["sentiment"].get<double>();
+            markNodeDirty(h);
         }
     }
 
@@ -395,8 +987,8 @@ std::string MCTGraph::addEmotion(const EmotionalState& state,
 
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (word_nodes_.size() + emotion_nodes_.size() >= config_.max_nodes) {
-        pruneExpiredNodes();
+    if (words_.size() + emotions_.size() >= config_.max_nodes) {
+        pruneExpiredLocked();
     }
 
     EmotionNode node;
@@ -409,10 +1001,10 @@ std::string MCTGraph::addEmotion(const EmotionalState& state,
     node.end_timestamp = state.timestamp + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
         std::chrono::duration<double>(persistence_duration));
 
-    emotion_nodes_[node.id] = node;
-    adjacency_[node.id] = {};
+    std::string id = node.id;
+    insertEmotionLocked(std::move(node));
 
-    return node.id;
+    return id;
 }
 
 std::string MCTGraph::addEmotionWithContext(const EmotionalState& state,
@@ -423,9 +1015,11 @@ std::string MCTGraph::addEmotionWithContext(const EmotionalState& state,
 
     if (!emotion_id.empty()) {
         std::lock_guard<std::mutex> lock(mutex_);
-        if (emotion_nodes_.count(emotion_id)) {
-            emotion_nodes_[emotion_id].valence = valence;
-            emotion_nodes_[emotion_id].arousal = arousal;
+        NodeHandle h = findNode(emotion_id);
+        if (h != INVALID_HANDLE && !isWord(h)) {
+            emotionAt(h).valence = valence;
+            emotionAt(h).arousal = arousal;
+            markNodeDirty(h);
         }
     }
 
@@ -441,39 +1035,27 @@ std::string MCTGraph::addCausalEdge(const std::string& word_id,
                                      double weight) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!word_nodes_.count(word_id) || !emotion_nodes_.count(emotion_id)) {
+    NodeHandle w = findNode(word_id);
+    NodeHandle em = findNode(emotion_id);
+    if (w == INVALID_HANDLE || em == INVALID_HANDLE || !isWord(w) || isWord(em)) {
         return "";
     }
 
-    const auto& word = word_nodes_.at(word_id);
-    const auto& emotion = emotion_nodes_.at(emotion_id);
-
-    GraphEdge edge;
-    edge.id = generateId("EDGE");
-    edge.source_id = word_id;
-    edge.target_id = emotion_id;
-    edge.type = EdgeType::CAUSAL;
-    edge.created_at = std::chrono::steady_clock::now();
-
-    // Calcul de la distance temporelle
-    edge.temporal_distance_ms = calculateTemporalDistance(word.timestamp, emotion.timestamp);
+    const auto& word = wordAt(w);
+    const auto& emotion = emotionAt(em);
 
     // Calcul du poids si non spécifié
-    if (weight < 0) {
-        edge.weight = calculateCausalWeight(word, emotion);
-    } else {
-        edge.weight = weight;
-    }
+    double edge_weight = weight < 0 ? calculateCausalWeight(word, emotion) : weight;
 
-    edges_[edge.id] = edge;
-    updateAdjacency(edge.id, word_id, emotion_id);
+    EdgeHandle e = insertEdgeLocked(w, em, EdgeType::CAUSAL, edge_weight,
+                                    calculateTemporalDistance(word.timestamp, emotion.timestamp));
 
     // Callback de détection causale
     if (causal_callback_) {
-        causal_callback_(word_id, emotion_id, edge.weight);
+        causal_callback_(word_id, emotion_id, edge_weight);
     }
 
-    return edge.id;
+    return edgeId(e);
 }
 
 std::string MCTGraph::addTemporalEdge(const std::string& node1_id,
@@ -481,42 +1063,16 @@ std::string MCTGraph::addTemporalEdge(const std::string& node1_id,
     std::lock_guard<std::mutex> lock(mutex_);
 
     // Vérifier que les nœuds existent
-    bool node1_exists = word_nodes_.count(node1_id) || emotion_nodes_.count(node1_id);
-    bool node2_exists = word_nodes_.count(node2_id) || emotion_nodes_.count(node2_id);
-
-    if (!node1_exists || !node2_exists) {
+    NodeHandle n1 = findNode(node1_id);
+    NodeHandle n2 = findNode(node2_id);
+    if (n1 == INVALID_HANDLE || n2 == INVALID_HANDLE) {
         return "";
     }
 
-    GraphEdge edge;
-    edge.id = generateId("EDGE");
-    edge.source_id = node1_id;
-    edge.target_id = node2_id;
-    edge.type = EdgeType::TEMPORAL;
-    edge.weight = config_.initial_temporal_weight;
-    edge.created_at = std::chrono::steady_clock::now();
-
-    // Calcul de la distance temporelle
-    std::chrono::steady_clock::time_point t1, t2;
-
-    if (word_nodes_.count(node1_id)) {
-        t1 = word_nodes_.at(node1_id).timestamp;
-    } else {
-        t1 = emotion_nodes_.at(node1_id).timestamp;
-    }
-
-    if (word_nodes_.count(node2_id)) {
-        t2 = word_nodes_.at(node2_id).timestamp;
-    } else {
-        t2 = emotion_nodes_.at(node2_id).timestamp;
-    }
-
-    edge.temporal_distance_ms = calculateTemporalDistance(t1, t2);
+    EdgeHandle e = insertEdgeLocked(n1, n2, EdgeType::TEMPORAL, config_.initial_temporal_weight,
+                                    calculateTemporalDistance(nodeTimestamp(n1), nodeTimestamp(n2)));
 
-    edges_[edge.id] = edge;
-    updateAdjacency(edge.id, node1_id, node2_id);
-
-    return edge.id;
+    return edgeId(e);
 }
 
 std::string MCTGraph::addSemanticEdge(const std::string& word1_id,
@@ -525,23 +1081,50 @@ std::string MCTGraph::addSemanticEdge(const std::string& word1_id,
                                        double weight) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!word_nodes_.count(word1_id) || !word_nodes_.count(word2_id)) {
+    NodeHandle w1 = findNode(word1_id);
+    NodeHandle w2 = findNode(word2_id);
+    if (w1 == INVALID_HANDLE || w2 == INVALID_HANDLE || !isWord(w1) || !isWord(w2)) {
         return "";
     }
 
-    GraphEdge edge;
-    edge.id = generateId("EDGE");
-    edge.source_id = word1_id;
-    edge.target_id = word2_id;
-    edge.type = EdgeType::SEMANTIC;
-    edge.weight = weight < 0 ? config_.initial_semantic_weight : weight;
-    edge.semantic_relation = relation_type;
-    edge.created_at = std::chrono::steady_clock::now();
+    EdgeHandle e = insertEdgeLocked(w1, w2, EdgeType::SEMANTIC,
+                                    weight < 0 ? config_.initial_semantic_weight : weight, 0.0);
+    edges_.mut(e).relation = names_.intern(relation_type);
+
+    return edgeId(e);
+}
+
+size_t MCTGraph::addSemanticEdgesByLemma(std::string_view lemma1,
+                                         std::string_view lemma2,
+                                         const std::string& relation_type,
+                                         double weight) {
+    auto& lemmas = LemmaTable::instance();
+    const LemmaId l1 = lemmas.find(lemma1);
+    const LemmaId l2 = lemmas.find(lemma2);
+    if (l1 == NO_LEMMA || l2 == NO_LEMMA) {
+        return 0;
+    }
 
-    edges_[edge.id] = edge;
-    updateAdjacency(edge.id, word1_id, word2_id);
+    std::lock_guard<std::mutex> lock(mutex_);
 
-    return edge.id;
+    auto first = lemma_index_.find(l1);
+    auto second = lemma_index_.find(l2);
+    if (first == lemma_index_.end() || second == lemma_index_.end()) {
+        return 0;
+    }
+
+    const double w = weight < 0 ? config_.initial_semantic_weight : weight;
+    const auto relation = names_.intern(relation_type);
+    size_t created = 0;
+    for (NodeHandle w1 : first->second) {
+        for (NodeHandle w2 : second->second) {
+            if (w1 == w2) continue;
+            EdgeHandle e = insertEdgeLocked(w1, w2, EdgeType::SEMANTIC, w, 0.0);
+            edges_.mut(e).relation = relation;
+            ++created;
+        }
+    }
+    return created;
 }
 
 // ============================================================================
@@ -551,30 +1134,34 @@ std::string MCTGraph::addSemanticEdge(const std::string& word1_id,
 void MCTGraph::detectCausality(const std::string& emotion_id) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!emotion_nodes_.count(emotion_id)) {
+    NodeHandle em = findNode(emotion_id);
+    if (em == INVALID_HANDLE || isWord(em)) {
         return;
     }
 
-    const auto& emotion = emotion_nodes_.at(emotion_id);
+    const auto& emotion = emotionAt(em);
+    double threshold_ms = emotion.isSlowEmotion()
+        ? config_.slow_emotion_causality_threshold_ms
+        : config_.causality_threshold_ms;
 
-    // Parcourir tous les mots et vérifier la fenêtre de causalité
-    for (const auto& [word_id, word] : word_nodes_) {
+    // Seuls les mots de [t_emotion - seuil, t_emotion] sont candidats : recherche
+    // dichotomique dans l'index temporel (marge d'un tick pour l'arrondi)
+    auto window = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(threshold_ms)) +
+        std::chrono::steady_clock::duration(1);
+    auto first = std::lower_bound(word_timeline_.begin(), word_timeline_.end(),
+        emotion.timestamp - window,
+        [](const TimeEntry& e, const auto& t) { return e.timestamp < t; });
+
+    for (auto it = first; it != word_timeline_.end() && it->timestamp <= emotion.timestamp; ++it) {
+        const auto& word = wordAt(it->handle);
         if (isWithinCausalityWindow(word, emotion)) {
-            // Créer l'arête causale (sans lock car déjà verrouillé)
-            GraphEdge edge;
-            edge.id = generateId("EDGE");
-            edge.source_id = word_id;
-            edge.target_id = emotion_id;
-            edge.type = EdgeType::CAUSAL;
-            edge.created_at = std::chrono::steady_clock::now();
-            edge.temporal_distance_ms = calculateTemporalDistance(word.timestamp, emotion.timestamp);
-            edge.weight = calculateCausalWeight(word, emotion);
-
-            edges_[edge.id] = edge;
-            updateAdjacency(edge.id, word_id, emotion_id);
+            double weight = calculateCausalWeight(word, emotion);
+            insertEdgeLocked(it->handle, em, EdgeType::CAUSAL, weight,
+                             calculateTemporalDistance(word.timestamp, emotion.timestamp));
 
             if (causal_callback_) {
-                causal_callback_(word_id, emotion_id, edge.weight);
+                causal_callback_(word.id, emotion_id, weight);
             }
         }
     }
@@ -583,84 +1170,52 @@ void MCTGraph::detectCausality(const std::string& emotion_id) {
 void MCTGraph::detectTemporalCooccurrences(const std::string& node_id) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    std::chrono::steady_clock::time_point node_time;
-    bool is_word = word_nodes_.count(node_id) > 0;
-
-    if (is_word) {
-        node_time = word_nodes_.at(node_id).timestamp;
-    } else if (emotion_nodes_.count(node_id)) {
-        node_time = emotion_nodes_.at(node_id).timestamp;
-    } else {
+    NodeHandle h = findNode(node_id);
+    if (h == INVALID_HANDLE) {
         return;
     }
+    auto node_time = nodeTimestamp(h);
 
     // Fenêtre de co-occurrence : 2 secondes
     const double cooccurrence_window_ms = 2000.0;
 
-    // Vérifier les mots
-    for (const auto& [other_id, word] : word_nodes_) {
-        if (other_id == node_id) continue;
-
-        double distance = calculateTemporalDistance(node_time, word.timestamp);
-        if (distance <= cooccurrence_window_ms) {
-            // Vérifier si l'arête existe déjà
-            bool exists = false;
-            for (const auto& edge_id : adjacency_[node_id]) {
-                const auto& edge = edges_.at(edge_id);
-                if ((edge.source_id == other_id || edge.target_id == other_id) &&
-                    edge.type == EdgeType::TEMPORAL) {
-                    exists = true;
-                    break;
-                }
-            }
-
-            if (!exists) {
-                GraphEdge edge;
-                edge.id = generateId("EDGE");
-                edge.source_id = node_id;
-                edge.target_id = other_id;
-                edge.type = EdgeType::TEMPORAL;
-                edge.weight = config_.initial_temporal_weight;
-                edge.temporal_distance_ms = distance;
-                edge.created_at = std::chrono::steady_clock::now();
-
-                edges_[edge.id] = edge;
-                updateAdjacency(edge.id, node_id, other_id);
-            }
+    // Marquer les nœuds déjà reliés par une arête temporelle (une passe sur l'adjacence)
+    uint32_t epoch = nextVisitEpoch();
+    for (EdgeHandle e : slots_[h].edges) {
+        const auto& edge = edges_[e];
+        if (edge.type == EdgeType::TEMPORAL) {
+            visit_marks_[edge.source] = epoch;
+            visit_marks_[edge.target] = epoch;
         }
     }
 
-    // Vérifier les émotions
-    for (const auto& [other_id, emotion] : emotion_nodes_) {
-        if (other_id == node_id) continue;
+    auto link = [&](NodeHandle other, std::chrono::steady_clock::time_point other_time) {
+        if (other == h || visit_marks_[other] == epoch) return;
 
-        double distance = calculateTemporalDistance(node_time, emotion.timestamp);
+        double distance = calculateTemporalDistance(node_time, other_time);
         if (distance <= cooccurrence_window_ms) {
-            bool exists = false;
-            for (const auto& edge_id : adjacency_[node_id]) {
-                const auto& edge = edges_.at(edge_id);
-                if ((edge.source_id == other_id || edge.target_id == other_id) &&
-                    edge.type == EdgeType::TEMPORAL) {
-                    exists = true;
-                    break;
-                }
-            }
+            insertEdgeLocked(h, other, EdgeType::TEMPORAL, config_.initial_temporal_weight, distance);
+            visit_marks_[other] = epoch;
+        }
+    };
 
-            if (!exists) {
-                GraphEdge edge;
-                edge.id = generateId("EDGE");
-                edge.source_id = node_id;
-                edge.target_id = other_id;
-                edge.type = EdgeType::TEMPORAL;
-                edge.weight = config_.initial_temporal_weight;
-                edge.temporal_distance_ms = distance;
-                edge.created_at = std::chrono::steady_clock::now();
-
-                edges_[edge.id] = edge;
-                updateAdjacency(edge.id, node_id, other_id);
-            }
+    // Plage [t - fenêtre, t + fenêtre] de chaque index temporel
+    auto window = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(cooccurrence_window_ms)) +
+        std::chrono::steady_clock::duration(1);
+    auto scan = [&](const std::deque<TimeEntry>& timeline) {
+        auto it = std::lower_bound(timeline.begin(), timeline.end(), node_time - window,
+            [](const TimeEntry& e, const auto& t) { return e.timestamp < t; });
+        for (; it != timeline.end() && it->timestamp <= node_time + window; ++it) {
+            link(it->handle, it->timestamp);
         }
-    }
+    };
+
+    // Vérifier les mots
+    scan(word_timeline_);
+
+    // Vérifier les émotions
+    scan(emotion_timeline_);
 }
 
 // ============================================================================
@@ -671,16 +1226,15 @@ std::vector<WordNode> MCTGraph::getTriggerWords(const std::string& emotion_id) c
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<WordNode> result;
 
-    if (!adjacency_.count(emotion_id)) {
+    NodeHandle h = findNode(emotion_id);
+    if (h == INVALID_HANDLE) {
         return result;
     }
 
-    for (const auto& edge_id : adjacency_.at(emotion_id)) {
-        const auto& edge = edges_.at(edge_id);
-        if (edge.type == EdgeType::CAUSAL && edge.target_id == emotion_id) {
-            if (word_nodes_.count(edge.source_id)) {
-                result.push_back(word_nodes_.at(edge.source_id));
-            }
+    for (EdgeHandle e : slots_[h].edges) {
+        const auto& edge = edges_[e];
+        if (edge.type == EdgeType::CAUSAL && edge.target == h && isWord(edge.source)) {
+            result.push_back(wordAt(edge.source));
         }
     }
 
@@ -691,60 +1245,48 @@ std::vector<EmotionNode> MCTGraph::getTriggeredEmotions(const std::string& word_
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<EmotionNode> result;
 
-    if (!adjacency_.count(word_id)) {
+    NodeHandle h = findNode(word_id);
+    if (h == INVALID_HANDLE) {
         return result;
     }
 
-    for (const auto& edge_id : adjacency_.at(word_id)) {
-        const auto& edge = edges_.at(edge_id);
-        if (edge.type == EdgeType::CAUSAL && edge.source_id == word_id) {
-            if (emotion_nodes_.count(edge.target_id)) {
-                result.push_back(emotion_nodes_.at(edge.target_id));
-            }
+    for (EdgeHandle e : slots_[h].edges) {
+        const auto& edge = edges_[e];
+        if (edge.type == EdgeType::CAUSAL && edge.source == h && !isWord(edge.target)) {
+            result.push_back(emotionAt(edge.target));
         }
     }
 
     return result;
 }
 
-std::vector<CausalAnalysis> MCTGraph::analyzeCausality() const {
+std::vector<CausalAnalysis> MCTGraph::analyzeCausality(size_t max_results, double min_strength) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    std::unordered_map<std::string, CausalAnalysis> analysis_map;
+    std::vector<CausalAnalysis> result;
 
-    for (const auto& [edge_id, edge] : edges_) {
-        if (edge.type != EdgeType::CAUSAL) continue;
+    // Sources ordonnées par le tas des agrégats : seule leur adjacence est parcourue
+    const double scale = tallyScale();
+    for (NodeHandle h : topCausalSourcesLocked(max_results, min_strength)) {
+        const auto& slot = slots_[h];
 
-        if (!analysis_map.count(edge.source_id)) {
-            CausalAnalysis ca;
-            ca.word_id = edge.source_id;
-            if (word_nodes_.count(edge.source_id)) {
-                ca.word_lemma = word_nodes_.at(edge.source_id).lemma;
-            }
-            ca.causal_strength = 0.0;
-            ca.trigger_count = 0;
-            analysis_map[edge.source_id] = ca;
+        CausalAnalysis ca;
+        ca.word_id = nodeId(h);
+        if (isWord(h)) {
+            ca.word_lemma = wordAt(h).lemmaText();
         }
-
-        analysis_map[edge.source_id].triggered_emotion_ids.push_back(edge.target_id);
-        analysis_map[edge.source_id].causal_strength += edge.weight;
-        analysis_map[edge.source_id].trigger_count++;
-    }
-
-    std::vector<CausalAnalysis> result;
-    for (auto& [id, ca] : analysis_map) {
-        // Normaliser la force causale
-        if (ca.trigger_count > 0) {
-            ca.causal_strength /= ca.trigger_count;
+        ca.causal_strength = std::max(0.0, causalKey(h) * scale);
+        ca.trigger_count = static_cast<int>(slot.causal_out);
+
+        ca.triggered_emotion_ids.reserve(slot.causal_out);
+        for (EdgeHandle e : slot.edges) {
+            const auto& edge = edges_[e];
+            if (edge.type == EdgeType::CAUSAL && edge.source == h) {
+                ca.triggered_emotion_ids.push_back(nodeId(edge.target));
+            }
         }
-        result.push_back(ca);
+        result.push_back(std::move(ca));
     }
 
-    // Trier par force causale décroissante
-    std::sort(result.begin(), result.end(),
-              [](const CausalAnalysis& a, const CausalAnalysis& b) {
-                  return a.causal_strength > b.causal_strength;
-              });
-
     return result;
 }
 
@@ -753,19 +1295,20 @@ std::vector<std::string> MCTGraph::getNeighbors(const std::string& node_id,
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<std::string> result;
 
-    if (!adjacency_.count(node_id)) {
+    NodeHandle h = findNode(node_id);
+    if (h == INVALID_HANDLE) {
         return result;
     }
 
-    for (const auto& edge_id : adjacency_.at(node_id)) {
-        const auto& edge = edges_.at(edge_id);
+    for (EdgeHandle e : slots_[h].edges) {
+        const auto& edge = edges_[e];
 
         if (edge_type && edge.type != *edge_type) {
             continue;
         }
 
-        std::string neighbor_id = (edge.source_id == node_id) ? edge.target_id : edge.source_id;
-        result.push_back(neighbor_id);
+        NodeHandle neighbor = (edge.source == h) ? edge.target : edge.source;
+        result.push_back(nodeId(neighbor));
     }
 
     return result;
@@ -773,192 +1316,387 @@ std::vector<std::string> MCTGraph::getNeighbors(const std::string& node_id,
 
 bool MCTGraph::hasNode(const std::string& node_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return word_nodes_.count(node_id) || emotion_nodes_.count(node_id);
+    return findNode(node_id) != INVALID_HANDLE;
 }
 
 std::optional<WordNode> MCTGraph::getWordNode(const std::string& id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (word_nodes_.count(id)) {
-        return word_nodes_.at(id);
+    NodeHandle h = findNode(id);
+    if (h != INVALID_HANDLE && isWord(h)) {
+        return wordAt(h);
     }
     return std::nullopt;
 }
 
 std::optional<EmotionNode> MCTGraph::getEmotionNode(const std::string& id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (emotion_nodes_.count(id)) {
-        return emotion_nodes_.at(id);
+    NodeHandle h = findNode(id);
+    if (h != INVALID_HANDLE && !isWord(h)) {
+        return emotionAt(h);
     }
     return std::nullopt;
 }
 
+std::vector<std::string> MCTGraph::findWordsByLemma(std::string_view lemma) const {
+    std::vector<std::string> result;
+    const LemmaId id = LemmaTable::instance().find(lemma);
+    if (id == NO_LEMMA) return result;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lemma_index_.find(id);
+    if (it != lemma_index_.end()) {
+        result.reserve(it->second.size());
+        for (NodeHandle h : it->second) {
+            result.push_back(wordAt(h).id);
+        }
+    }
+    return result;
+}
+
+size_t MCTGraph::getLemmaCount(std::string_view lemma) const {
+    const LemmaId id = LemmaTable::instance().find(lemma);
+    if (id == NO_LEMMA) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = lemma_index_.find(id);
+    return it != lemma_index_.end() ? it->second.size() : 0;
+}
+
 // ============================================================================
 // Maintenance du graphe
 // ============================================================================
 
-size_t MCTGraph::pruneExpiredNodes() {
+size_t MCTGraph::pruneExpiredNodes(size_t max_nodes) {
     std::lock_guard<std::mutex> lock(mutex_);
+    return pruneExpiredLocked(max_nodes);
+}
 
-    auto now = std::chrono::steady_clock::now();
+size_t MCTGraph::pruneExpiredLocked(size_t max_nodes) {
+    auto now = SessionClock::now();
     auto window = std::chrono::duration<double>(config_.time_window_seconds);
     size_t removed = 0;
 
-    // Collecter les IDs à supprimer
-    std::vector<std::string> words_to_remove;
-    std::vector<std::string> emotions_to_remove;
-
-    for (const auto& [id, node] : word_nodes_) {
-        if (now - node.timestamp > window) {
-            words_to_remove.push_back(id);
+    // Les index temporels sont triés : les nœuds expirés sont en tête,
+    // coût O(expirés) au lieu d'un balayage complet
+    for (auto* timeline : {&word_timeline_, &emotion_timeline_}) {
+        while (removed < max_nodes && !timeline->empty() &&
+               now - timeline->front().timestamp > window) {
+            NodeHandle h = timeline->front().handle;
+            timeline->pop_front();
+            removeNodeLocked(h);
+            removed++;
         }
     }
 
-    for (const auto& [id, node] : emotion_nodes_) {
-        if (now - node.timestamp > window) {
-            emotions_to_remove.push_back(id);
-        }
-    }
-
-    // Supprimer les nœuds et leurs arêtes
-    for (const auto& id : words_to_remove) {
-        removeEdgesForNode(id);
-        word_nodes_.erase(id);
-        adjacency_.erase(id);
-        removed++;
-    }
-
-    for (const auto& id : emotions_to_remove) {
-        removeEdgesForNode(id);
-        emotion_nodes_.erase(id);
-        adjacency_.erase(id);
-        removed++;
-    }
-
     return removed;
 }
 
 void MCTGraph::applyEdgeDecay() {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    for (auto& [id, edge] : edges_) {
-        edge.weight *= config_.edge_decay_factor;
+    // Aucune arête n'est réécrite (ni page dupliquée sous une vue vivante) :
+    // les poids effectifs se déduisent de l'époque
+    ++decay_epoch_;
+    if (decay_epoch_ - tally_epoch_ >= TALLY_REBASE_EPOCHS) {
+        rebaseTalliesLocked();
+    }
+    sweep_cursor_ = 0;
+    sweep_pending_ = true;
+}
 
-        // Supprimer les arêtes avec un poids trop faible
-        if (edge.weight < 0.01) {
-            adjacency_[edge.source_id].erase(
-                std::remove(adjacency_[edge.source_id].begin(),
-                           adjacency_[edge.source_id].end(), id),
-                adjacency_[edge.source_id].end());
+bool MCTGraph::maintenanceStep(size_t budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t pruned = pruneExpiredLocked(budget);
+    if (pruned == budget) {
+        return true;
+    }
 
-            adjacency_[edge.target_id].erase(
-                std::remove(adjacency_[edge.target_id].begin(),
-                           adjacency_[edge.target_id].end(), id),
-                adjacency_[edge.target_id].end());
+    // Libérer les arêtes passées sous le seuil, une tranche à la fois
+    size_t examined = 0;
+    while (sweep_pending_ && examined < budget) {
+        if (sweep_cursor_ >= edges_.size()) {
+            sweep_pending_ = false;
+            break;
         }
+        EdgeHandle e = sweep_cursor_++;
+        const auto& edge = edges_[e];
+        if (edge.alive && edgeWeight(edge) < EDGE_RELEASE_WEIGHT) {
+            releaseEdgeLocked(e);
+        }
+        ++examined;
     }
 
-    // Supprimer les arêtes avec poids < 0.01
-    std::erase_if(edges_, [](const auto& pair) {
-        return pair.second.weight < 0.01;
-    });
+    return sweep_pending_;
 }
 
 void MCTGraph::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
-    word_nodes_.clear();
-    emotion_nodes_.clear();
+    clearLocked();
+}
+
+void MCTGraph::clearLocked() {
+    slots_.clear();
+    free_slots_.clear();
+    words_.clear();
+    word_handles_.clear();
+    emotions_.clear();
+    emotion_handles_.clear();
+    node_ids_.clear();
+    lemma_index_.clear();
     edges_.clear();
-    adjacency_.clear();
+    free_edges_.clear();
+    edge_count_ = 0;
+    decay_epoch_ = 0;
+    sweep_cursor_ = 0;
+    sweep_pending_ = false;
+    edge_type_counts_ = {};
+    emotion_intensity_sum_ = 0.0;
+    dominant_counts_.clear();
+    causal_rank_.clear();
+    tally_epoch_ = 0;
+    resetChangeLogLocked();
+    node_marks_.clear();
+    edge_marks_.clear();
+    resync_ = true;
+    names_.clear();
+    word_timeline_.clear();
+    emotion_timeline_.clear();
+    visit_marks_.clear();
+    visit_epoch_ = 0;
 }
 
 // ============================================================================
 // Export et snapshots
 // ============================================================================
 
-MCTGraphSnapshot MCTGraph::createSnapshot() const {
+MCTGraph::View MCTGraph::captureView() const {
     std::lock_guard<std::mutex> lock(mutex_);
+    return captureViewLocked();
+}
 
-    MCTGraphSnapshot snapshot;
-    snapshot.snapshot_id = generateId("SNAP");
-    snapshot.timestamp = std::chrono::system_clock::now();
+MCTGraph::View MCTGraph::captureViewLocked() const {
+    View view;
+    view.snapshot_id_ = generateId("SNAP");
+    view.captured_at_ = std::chrono::system_clock::now();
+
+    // Copie des seules tables de pages : O(pages), aucun nœud copié
+    view.words_ = words_;
+    view.word_handles_ = word_handles_;
+    view.emotions_ = emotions_;
+    view.emotion_handles_ = emotion_handles_;
+    view.edges_ = edges_;
+    view.names_ = names_.strings;
+    view.slot_count_ = slots_.size();
+    view.edge_count_ = edge_count_;
+    view.decay_epoch_ = decay_epoch_;
+    view.decay_factor_ = config_.edge_decay_factor;
+    view.stats_ = statisticsLocked();
+
+    return view;
+}
+
+MCTGraphSnapshot MCTGraph::createSnapshot() const {
+    return captureView().toSnapshot();
+}
+
+MCTGraphDelta MCTGraph::captureDelta(bool force_keyframe) {
+    MCTGraphDelta delta;
+    std::optional<View> view;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        delta.base_sequence = delta_sequence_;
+        delta.sequence = ++delta_sequence_;
+        delta.keyframe = force_keyframe || resync_ || config_.delta_keyframe_interval == 0 ||
+                         delta.sequence - last_keyframe_sequence_ >= config_.delta_keyframe_interval;
+
+        if (delta.keyframe) {
+            delta.base_sequence = 0;
+            last_keyframe_sequence_ = delta.sequence;
+        } else {
+            // Les handles marqués puis libérés (ou recyclés) sont résolus ici
+            for (NodeHandle h : dirty_nodes_) {
+                if (!slots_[h].alive) continue;
+                if (isWord(h)) {
+                    delta.word_nodes.push_back(wordAt(h));
+                } else {
+                    delta.emotion_nodes.push_back(emotionAt(h));
+                }
+            }
+            for (EdgeHandle e : dirty_edges_) {
+                const auto& record = edges_[e];
+                if (!record.alive) continue;
+                delta.edges.push_back(materializeRecord(record, nodeId(record.source),
+                                                        nodeId(record.target), names_.strings,
+                                                        edgeWeight(record)));
+            }
+            delta.removed_node_ids = std::move(removed_node_ids_);
+            delta.removed_edge_ids = std::move(removed_edge_ids_);
+        }
+
+        resetChangeLogLocked();
+        resync_ = false;
+        view = captureViewLocked();
+    }
+
+    // Hors verrou : statistiques (et graphe entier pour une keyframe)
+    delta.snapshot_id = view->snapshot_id_;
+    delta.timestamp = view->captured_at_;
+    delta.decay_epoch = view->decay_epoch_;
+    delta.edge_decay_factor = view->decay_factor_;
+
+    if (delta.keyframe) {
+        MCTGraphSnapshot snapshot = view->toSnapshot();
+        delta.word_nodes = std::move(snapshot.word_nodes);
+        delta.emotion_nodes = std::move(snapshot.emotion_nodes);
+        delta.edges = std::move(snapshot.edges);
+        delta.stats = std::move(snapshot.stats);
+    } else {
+        delta.stats = view->statistics();
+    }
+
+    return delta;
+}
+
+nlohmann::json MCTGraph::toJson() const {
+    nlohmann::json j = captureView().toJson();
+    j["config"] = {
+        {"time_window_seconds", config_.time_window_seconds},
+        {"emotion_persistence_threshold_seconds", config_.emotion_persistence_threshold_seconds},
+        {"causality_threshold_ms", config_.causality_threshold_ms},
+        {"snapshot_interval_seconds", config_.snapshot_interval_seconds}
+    };
+    return j;
+}
 
-    // Copier les nœuds
-    for (const auto& [id, node] : word_nodes_) {
-        snapshot.word_nodes.push_back(node);
+std::vector<const std::string*> MCTGraph::View::nodeIds() const {
+    std::vector<const std::string*> ids(slot_count_, nullptr);
+    for (size_t i = 0; i < words_.size(); ++i) {
+        ids[word_handles_[i]] = &words_[i].id;
     }
+    for (size_t i = 0; i < emotions_.size(); ++i) {
+        ids[emotion_handles_[i]] = &emotions_[i].id;
+    }
+    return ids;
+}
 
-    for (const auto& [id, node] : emotion_nodes_) {
-        snapshot.emotion_nodes.push_back(node);
+GraphEdge MCTGraph::materializeRecord(const EdgeRecord& record, const std::string& source_id,
+                                      const std::string& target_id,
+                                      const CowVector<std::string>& names, double weight) {
+    GraphEdge edge;
+    edge.id = recordId(record, names);
+    edge.source_id = source_id;
+    edge.target_id = target_id;
+    edge.type = record.type;
+    edge.weight = weight;
+    edge.created_at = record.created_at;
+    edge.temporal_distance_ms = record.temporal_distance_ms;
+    if (record.relation != NO_NAME) {
+        edge.semantic_relation = names[record.relation];
     }
+    return edge;
+}
 
-    // Copier les arêtes
-    for (const auto& [id, edge] : edges_) {
-        snapshot.edges.push_back(edge);
+GraphEdge MCTGraph::View::materializeEdge(const EdgeRecord& record,
+                                          const std::vector<const std::string*>& ids) const {
+    return materializeRecord(record, *ids[record.source], *ids[record.target], names_,
+                             effectiveWeight(record, decay_epoch_, decay_factor_));
+}
+
+MCTGraphSnapshot MCTGraph::View::toSnapshot() const {
+    MCTGraphSnapshot snapshot;
+    snapshot.snapshot_id = snapshot_id_;
+    snapshot.timestamp = captured_at_;
+
+    // Copier les nœuds (pools denses)
+    snapshot.word_nodes = words_.toVector();
+    snapshot.emotion_nodes = emotions_.toVector();
+
+    // Résoudre les arêtes vers leurs IDs texte
+    auto ids = nodeIds();
+    snapshot.edges.reserve(edge_count_);
+    for (const auto& record : edges_) {
+        if (record.alive) {
+            snapshot.edges.push_back(materializeEdge(record, ids));
+        }
     }
 
     // Calculer les statistiques
-    computeSnapshotStatistics(snapshot);
+    snapshot.stats = statistics();
 
     return snapshot;
 }
 
-nlohmann::json MCTGraph::toJson() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-
+nlohmann::json MCTGraph::View::toJson() const {
     nlohmann::json words_json = nlohmann::json::array();
-    for (const auto& [id, node] : word_nodes_) {
+    for (const auto& node : words_) {
         words_json.push_back(node.toJson());
     }
 
     nlohmann::json emotions_json = nlohmann::json::array();
-    for (const auto& [id, node] : emotion_nodes_) {
+    for (const auto& node : emotions_) {
         emotions_json.push_back(node.toJson());
     }
 
+    auto ids = nodeIds();
     nlohmann::json edges_json = nlohmann::json::array();
-    for (const auto& [id, edge] : edges_) {
-        edges_json.push_back(edge.toJson());
+    for (const auto& record : edges_) {
+        if (record.alive) {
+            edges_json.push_back(materializeEdge(record, ids).toJson());
+        }
     }
 
     return {
         {"word_nodes", words_json},
         {"emotion_nodes", emotions_json},
-        {"edges", edges_json},
-        {"config", {
-            {"time_window_seconds", config_.time_window_seconds},
-            {"emotion_persistence_threshold_seconds", config_.emotion_persistence_threshold_seconds},
-            {"causality_threshold_ms", config_.causality_threshold_ms},
-            {"snapshot_interval_seconds", config_.snapshot_interval_seconds}
-        }}
+        {"edges", edges_json}
     };
 }
 
 void MCTGraph::loadFromJson(const nlohmann::json& j) {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    clear();
+    clearLocked();
 
     if (j.contains("word_nodes")) {
         for (const auto& w : j["word_nodes"]) {
-            WordNode node = WordNode::fromJson(w);
-            word_nodes_[node.id] = node;
-            adjacency_[node.id] = {};
+            insertWordLocked(WordNode::fromJson(w));
         }
     }
 
     if (j.contains("emotion_nodes")) {
         for (const auto& e : j["emotion_nodes"]) {
-            EmotionNode node = EmotionNode::fromJson(e);
-            emotion_nodes_[node.id] = node;
-            adjacency_[node.id] = {};
+            insertEmotionLocked(EmotionNode::fromJson(e));
         }
     }
 
     if (j.contains("edges")) {
+        size_t dropped = 0;
         for (const auto& e : j["edges"]) {
             GraphEdge edge = GraphEdge::fromJson(e);
-            edges_[edge.id] = edge;
-            updateAdjacency(edge.id, edge.source_id, edge.target_id);
+            NodeHandle source = findNode(edge.source_id);
+            NodeHandle target = findNode(edge.target_id);
+            if (source == INVALID_HANDLE || target == INVALID_HANDLE) {
+                dropped++;  // Arête orpheline : aucun nœud pour l'ancrer
+                continue;
+            }
+
+            EdgeHandle h = insertEdgeLocked(source, target, edge.type, edge.weight,
+                                            edge.temporal_distance_ms);
+            auto& record = edges_.mut(h);
+            record.created_at = edge.created_at;
+            if (!edge.id.empty()) {
+                record.name = names_.intern(edge.id);
+            }
+            if (!edge.semantic_relation.empty()) {
+                record.relation = names_.intern(edge.semantic_relation);
+            }
+        }
+
+        if (dropped > 0) {
+            MCEE_LOG_WARN("MCTGraph", dropped, " arête(s) ignorée(s) : nœud source/cible absent");
         }
     }
 }
@@ -978,7 +1716,7 @@ void MCTGraph::setCausalDetectionCallback(CausalDetectionCallback callback) {
 }
 
 void MCTGraph::triggerSnapshot() {
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     auto elapsed = std::chrono::duration<double>(now - last_snapshot_time_).count();
 
     if (elapsed >= config_.snapshot_interval_seconds) {
@@ -998,38 +1736,82 @@ void MCTGraph::triggerSnapshot() {
 
 size_t MCTGraph::getWordCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return word_nodes_.size();
+    return words_.size();
 }
 
 size_t MCTGraph::getEmotionCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return emotion_nodes_.size();
+    return emotions_.size();
 }
 
 size_t MCTGraph::getEdgeCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return edges_.size();
+    return edge_count_;
 }
 
 size_t MCTGraph::getCausalEdgeCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    size_t count = 0;
-    for (const auto& [id, edge] : edges_) {
-        if (edge.type == EdgeType::CAUSAL) {
-            count++;
-        }
+    return edge_type_counts_[static_cast<size_t>(EdgeType::CAUSAL)];
+}
+
+size_t MCTGraph::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Nœud de table de hachage ≈ valeur + chaînage
+    constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+    size_t bytes = sizeof(*this);
+    bytes += slots_.capacity() * sizeof(NodeSlot) + free_slots_.capacity() * sizeof(NodeHandle);
+    for (const auto& slot : slots_) {
+        bytes += slot.edges.capacity() * sizeof(EdgeHandle);
+    }
+
+    bytes += words_.capacity() * sizeof(WordNode) + word_handles_.capacity() * sizeof(NodeHandle);
+    for (const auto& word : words_) {
+        bytes += heapBytes(word.id) + heapBytes(word.sentence_id);
+    }
+    bytes += emotions_.capacity() * sizeof(EmotionNode) + emotion_handles_.capacity() * sizeof(NodeHandle);
+    for (const auto& emotion : emotions_) {
+        bytes += heapBytes(emotion.id) + heapBytes(emotion.dominant_emotion);
     }
-    return count;
+
+    bytes += node_ids_.bucket_count() * sizeof(void*);
+    for (const auto& [id, handle] : node_ids_) {
+        bytes += sizeof(id) + sizeof(handle) + HASH_NODE_OVERHEAD + heapBytes(id);
+    }
+
+    bytes += edges_.capacity() * sizeof(EdgeRecord) + free_edges_.capacity() * sizeof(EdgeHandle);
+    bytes += names_.strings.capacity() * sizeof(std::string);
+    for (const auto& name : names_.strings) {
+        bytes += heapBytes(name);
+    }
+    bytes += names_.index.bucket_count() * sizeof(void*);
+    bytes += names_.index.size() * (sizeof(std::string) + sizeof(uint32_t) + HASH_NODE_OVERHEAD);
+
+    bytes += lemma_index_.bucket_count() * sizeof(void*);
+    for (const auto& [lemma, handles] : lemma_index_) {
+        bytes += sizeof(lemma) + sizeof(handles) + HASH_NODE_OVERHEAD + handles.capacity() * sizeof(NodeHandle);
+    }
+
+    bytes += (word_timeline_.size() + emotion_timeline_.size()) * sizeof(TimeEntry);
+    bytes += visit_marks_.capacity() * sizeof(uint32_t);
+    bytes += causal_rank_.capacity() * sizeof(NodeHandle);
+    bytes += dominant_counts_.bucket_count() * sizeof(void*);
+    bytes += dominant_counts_.size() * (sizeof(std::string) + sizeof(size_t) + HASH_NODE_OVERHEAD);
+
+    bytes += dirty_nodes_.capacity() * sizeof(NodeHandle) + dirty_edges_.capacity() * sizeof(EdgeHandle);
+    bytes += (node_marks_.capacity() + edge_marks_.capacity()) * sizeof(uint64_t);
+    bytes += (removed_node_ids_.capacity() + removed_edge_ids_.capacity()) * sizeof(std::string);
+    return bytes;
 }
 
 double MCTGraph::getGraphDensity() const {
     std::lock_guard<std::mutex> lock(mutex_);
 
-    size_t n = word_nodes_.size() + emotion_nodes_.size();
+    size_t n = words_.size() + emotions_.size();
     if (n < 2) return 0.0;
 
     size_t max_edges = n * (n - 1) / 2;
-    return static_cast<double>(edges_.size()) / max_edges;
+    return static_cast<double>(edge_count_) / max_edges;
 }
 
 // ============================================================================
@@ -1086,131 +1868,6 @@ bool MCTGraph::isWithinCausalityWindow(const WordNode& word,
     return distance_ms <= threshold;
 }
 
-void MCTGraph::removeEdgesForNode(const std::string& node_id) {
-    // Collecter les IDs d'arêtes à supprimer
-    std::vector<std::string> edges_to_remove;
-
-    for (const auto& [edge_id, edge] : edges_) {
-        if (edge.source_id == node_id || edge.target_id == node_id) {
-            edges_to_remove.push_back(edge_id);
-        }
-    }
-
-    // Supprimer les arêtes et mettre à jour l'adjacence
-    for (const auto& edge_id : edges_to_remove) {
-        const auto& edge = edges_.at(edge_id);
-
-        // Retirer de l'adjacence de l'autre nœud
-        std::string other_id = (edge.source_id == node_id) ? edge.target_id : edge.source_id;
-        if (adjacency_.count(other_id)) {
-            adjacency_[other_id].erase(
-                std::remove(adjacency_[other_id].begin(),
-                           adjacency_[other_id].end(), edge_id),
-                adjacency_[other_id].end());
-        }
-
-        edges_.erase(edge_id);
-    }
-}
-
-void MCTGraph::updateAdjacency(const std::string& edge_id,
-                                const std::string& source_id,
-                                const std::string& target_id) {
-    if (adjacency_.count(source_id)) {
-        adjacency_[source_id].push_back(edge_id);
-    }
-    if (adjacency_.count(target_id)) {
-        adjacency_[target_id].push_back(edge_id);
-    }
-}
-
-void MCTGraph::computeSnapshotStatistics(MCTGraphSnapshot& snapshot) const {
-    auto& stats = snapshot.stats;
-
-    stats.total_words = snapshot.word_nodes.size();
-    stats.total_emotions = snapshot.emotion_nodes.size();
-
-    // Comptage des types d'arêtes
-    for (const auto& edge : snapshot.edges) {
-        switch (edge.type) {
-            case EdgeType::CAUSAL: stats.causal_edges++; break;
-            case EdgeType::TEMPORAL: stats.temporal_edges++; break;
-            case EdgeType::SEMANTIC: stats.semantic_edges++; break;
-        }
-    }
-
-    // Intensité moyenne des émotions
-    if (!snapshot.emotion_nodes.empty()) {
-        double total_intensity = 0.0;
-        std::unordered_map<std::string, int> emotion_counts;
-
-        for (const auto& emo : snapshot.emotion_nodes) {
-            total_intensity += emo.intensity;
-            emotion_counts[emo.dominant_emotion]++;
-        }
-
-        stats.average_emotion_intensity = total_intensity / snapshot.emotion_nodes.size();
-
-        // Émotion la plus fréquente
-        int max_count = 0;
-        for (const auto& [name, count] : emotion_counts) {
-            if (count > max_count) {
-                max_count = count;
-                stats.most_frequent_emotion = name;
-            }
-        }
-    }
-
-    // Top mots déclencheurs
-    std::unordered_map<std::string, int> word_trigger_counts;
-    for (const auto& edge : snapshot.edges) {
-        if (edge.type == EdgeType::CAUSAL) {
-            for (const auto& word : snapshot.word_nodes) {
-                if (word.id == edge.source_id) {
-                    word_trigger_counts[word.lemma]++;
-                    break;
-                }
-            }
-        }
-    }
-
-    std::vector<std::pair<std::string, int>> sorted_triggers(
-        word_trigger_counts.begin(), word_trigger_counts.end());
-    std::sort(sorted_triggers.begin(), sorted_triggers.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
-
-    for (size_t i = 0; i < std::min(size_t(5), sorted_triggers.size()); ++i) {
-        stats.top_trigger_words.push_back(sorted_triggers[i].first);
-    }
-
-    // Densité du graphe
-    size_t n = stats.total_words + stats.total_emotions;
-    if (n >= 2) {
-        size_t max_edges = n * (n - 1) / 2;
-        stats.graph_density = static_cast<double>(snapshot.edges.size()) / max_edges;
-    }
-
-    // Étendue temporelle
-    if (!snapshot.word_nodes.empty() || !snapshot.emotion_nodes.empty()) {
-        auto min_time = std::chrono::steady_clock::time_point::max();
-        auto max_time = std::chrono::steady_clock::time_point::min();
-
-        for (const auto& word : snapshot.word_nodes) {
-            min_time = std::min(min_time, word.timestamp);
-            max_time = std::max(max_time, word.timestamp);
-        }
-
-        for (const auto& emo : snapshot.emotion_nodes) {
-            min_time = std::min(min_time, emo.timestamp);
-            max_time = std::max(max_time, emo.timestamp);
-        }
-
-        if (min_time < max_time) {
-            stats.time_span_seconds = std::chrono::duration<double>(max_time - min_time).count();
-        }
-    }
-}
-
 std::string MCTGraph::findDominantEmotion(const std::array<double, 24>& emotions) const {
     size_t max_idx = 0;
     double max_val = emotions[0];
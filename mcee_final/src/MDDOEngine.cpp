@@ -6,10 +6,12 @@
  */
 
 #include "MDDOEngine.hpp"
-#include <iostream>
+#include "Logger.hpp"
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <iomanip>
+#include <sstream>
 
 namespace mcee {
 
@@ -32,9 +34,20 @@ MDDOEngine::MDDOEngine(const MDDOConfig& config)
         {"ENGAGE", "S'engager", "ENGAGE", 0.0, 0.2, 0.6, 0.3, {}, {}, 0.0}
     };
 
-    std::cout << "[MDDO] Moteur initialisé\n";
-    std::cout << "[MDDO] τ_max=" << config_.tau_max_ms << "ms, θ_conf="
-              << config_.theta_confidence << ", θ_veto=" << config_.theta_veto << "\n";
+    MCEE_LOG_INFO("MDDO", "Moteur initialisé");
+    MCEE_LOG_INFO("MDDO",
+        "τ_max=", config_.tau_max_ms, "ms, θ_conf=", config_.theta_confidence, ", θ_veto=",
+        config_.theta_veto);
+}
+
+MDDOEngine::~MDDOEngine() {
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        stop_ = true;
+        pending_.reset();
+    }
+    interrupt_epoch_.fetch_add(1, std::memory_order_acq_rel);
+    lane_.close();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -42,28 +55,71 @@ MDDOEngine::MDDOEngine(const MDDOConfig& config)
 // ═══════════════════════════════════════════════════════════════════════════
 
 ActionIntention MDDOEngine::deliberate(const SituationFrame& situation) {
+    uint64_t epoch = interrupt_epoch_.load(std::memory_order_acquire);
+    auto intention = runDeliberation(situation, epoch);
+    if (!intention) {
+        ActionOption emergency;
+        {
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            if (last_result_ && last_result_->was_interrupted) {
+                emergency = last_result_->selected_action;
+            }
+        }
+        return makeEmergencyIntention(emergency);
+    }
+    return *intention;
+}
+
+std::optional<ActionIntention> MDDOEngine::runDeliberation(
+    const SituationFrame& situation,
+    uint64_t epoch)
+{
     auto start_time = std::chrono::steady_clock::now();
 
+    auto abandon = [this]() -> std::optional<ActionIntention> {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.current_phase = MDDOState::Phase::IDLE;
+        state_.current_situation.reset();
+        return std::nullopt;
+    };
+
     // Phase 1: Perception
-    state_.current_phase = MDDOState::Phase::PERCEIVING;
     SituationFrame enriched_situation = perceive(situation);
-    state_.current_situation = enriched_situation;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.current_phase = MDDOState::Phase::PERCEIVING;
+        state_.current_situation = enriched_situation;
+    }
+    if (isCancelled(epoch)) return abandon();
 
     // Phase 2: Activation mémorielle
-    state_.current_phase = MDDOState::Phase::ACTIVATING;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.current_phase = MDDOState::Phase::ACTIVATING;
+    }
     std::vector<Memory> relevant_memories;
     if (memory_manager_) {
         relevant_memories = activateMemories(enriched_situation);
     }
+    if (isCancelled(epoch)) return abandon();
 
-    // Phase 3: Simulation
-    state_.current_phase = MDDOState::Phase::SIMULATING;
-    std::vector<ActionOption> options = simulate(enriched_situation, relevant_memories);
-    state_.generated_options = options;
+    // Phase 3: Simulation (point d'annulation à chaque option)
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.current_phase = MDDOState::Phase::SIMULATING;
+    }
+    auto simulated = simulate(enriched_situation, relevant_memories, epoch);
+    if (!simulated) return abandon();
+    std::vector<ActionOption> options = std::move(*simulated);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.generated_options = options;
+        state_.current_phase = MDDOState::Phase::ARBITRATING;
+    }
 
     // Phase 4: Arbitrage
-    state_.current_phase = MDDOState::Phase::ARBITRATING;
     ActionIntention intention = arbitrate(enriched_situation, options);
+    if (isCancelled(epoch)) return abandon();
 
     // Calculer le temps de délibération
     auto end_time = std::chrono::steady_clock::now();
@@ -71,58 +127,185 @@ ActionIntention MDDOEngine::deliberate(const SituationFrame& situation) {
         end_time - start_time).count();
     intention.timestamp = std::chrono::system_clock::now();
 
-    // Mettre à jour les statistiques
-    state_.decisions_made++;
-    state_.avg_deliberation_time_ms =
-        (state_.avg_deliberation_time_ms * (state_.decisions_made - 1) +
-         intention.deliberation_time_ms) / state_.decisions_made;
-    state_.avg_confidence =
-        (state_.avg_confidence * (state_.decisions_made - 1) +
-         intention.confidence) / state_.decisions_made;
-
-    // Ajouter à l'historique
-    decision_history_.push_back(intention);
-    if (decision_history_.size() > MAX_HISTORY_SIZE) {
-        decision_history_.erase(decision_history_.begin());
-    }
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+
+        // Mettre à jour les statistiques
+        state_.decisions_made++;
+        state_.avg_deliberation_time_ms =
+            (state_.avg_deliberation_time_ms * (state_.decisions_made - 1) +
+             intention.deliberation_time_ms) / state_.decisions_made;
+        state_.avg_confidence =
+            (state_.avg_confidence * (state_.decisions_made - 1) +
+             intention.confidence) / state_.decisions_made;
 
-    state_.current_phase = MDDOState::Phase::IDLE;
-    state_.current_situation.reset();
+        // Ajouter à l'historique
+        decision_history_.push_back(intention);
+
+        state_.current_phase = MDDOState::Phase::IDLE;
+        state_.current_situation.reset();
+    }
 
-    std::cout << "[MDDO] Décision: " << intention.selected_action.name
-              << " (conf=" << std::fixed << std::setprecision(2) << intention.confidence
-              << ", τ=" << intention.deliberation_time_ms << "ms)\n";
+    MCEE_LOG_INFO("MDDO",
+        "Décision: ", intention.selected_action.name, " (conf=", std::fixed, std::setprecision(2),
+        intention.confidence, ", τ=", intention.deliberation_time_ms, "ms)");
 
     return intention;
 }
 
-void MDDOEngine::deliberateAsync(const SituationFrame& situation, IntentionCallback callback) {
-    intention_callback_ = std::move(callback);
+uint64_t MDDOEngine::deliberateAsync(const SituationFrame& situation, IntentionCallback callback) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        intention_callback_ = std::move(callback);
+        id = ++next_request_id_;
+        if (pending_) {
+            completed_request_id_ = pending_->id;  // Remplacée par la plus récente
+        }
+        pending_ = PendingRequest{situation, id};
+        latest_budget_ms_ = computeDeliberationTime(situation.urgency);
+
+        if (drain_scheduled_) {
+            return id;  // La tâche en cours prendra la requête
+        }
+        drain_scheduled_ = true;
+    }
 
-    // Dans une implémentation réelle, ceci serait exécuté dans un thread séparé
-    ActionIntention intention = deliberate(situation);
+    if (!lane_.post([this]() { drainPending(); })) {
+        MCEE_LOG_WARN("MDDO", "Délibération asynchrone refusée par l'Executor");
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        drain_scheduled_ = false;
+        pending_.reset();
+    }
+    return id;
+}
 
-    if (intention_callback_) {
-        intention_callback_(intention);
+std::optional<ActionIntention> MDDOEngine::waitForIntention(
+    uint64_t request_id,
+    std::optional<double> timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    double budget = timeout_ms.value_or(latest_budget_ms_);
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(budget));
+
+    bool done = result_cv_.wait_until(lock, deadline, [&]() {
+        return completed_request_id_ >= request_id && last_result_.has_value();
+    });
+    if (!done) {
+        return std::nullopt;
     }
+    return last_result_;
 }
 
 void MDDOEngine::interrupt(const ActionOption& emergency_action) {
-    std::cout << "[MDDO] ⚡ INTERRUPTION - Action d'urgence: " << emergency_action.name << "\n";
+    MCEE_LOG_INFO("MDDO", "⚡ INTERRUPTION - Action d'urgence: ", emergency_action.name);
+
+    // Invalider la délibération en cours : elle s'arrête au prochain point
+    // d'annulation, sans que l'appelant ne l'attende
+    interrupt_epoch_.fetch_add(1, std::memory_order_acq_rel);
+
+    ActionIntention emergency_intention = makeEmergencyIntention(emergency_action);
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        state_.vetoes_received++;
+        state_.current_phase = MDDOState::Phase::IDLE;
+    }
 
-    // Créer une intention d'urgence
+    IntentionCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        pending_.reset();
+        completed_request_id_ = next_request_id_;
+        last_result_ = emergency_intention;
+        callback = intention_callback_;
+    }
+    result_cv_.notify_all();
+
+    if (callback) {
+        callback(emergency_intention);
+    }
+}
+
+bool MDDOEngine::isDeliberating() const {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    return in_flight_ || pending_.has_value();
+}
+
+MDDOState MDDOEngine::getState() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return state_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// DÉLIBÉRATION ASYNCHRONE
+// ═══════════════════════════════════════════════════════════════════════════
+
+ActionIntention MDDOEngine::makeEmergencyIntention(const ActionOption& emergency_action) {
     ActionIntention emergency_intention;
     emergency_intention.selected_action = emergency_action;
     emergency_intention.confidence = 1.0;
     emergency_intention.was_interrupted = true;
     emergency_intention.rationale = "Interruption d'urgence par Amyghaleon";
     emergency_intention.timestamp = std::chrono::system_clock::now();
+    return emergency_intention;
+}
 
-    state_.vetoes_received++;
-    state_.current_phase = MDDOState::Phase::IDLE;
+void MDDOEngine::publishResult(const ActionIntention& intention, uint64_t request_id, uint64_t epoch) {
+    IntentionCallback callback;
+    {
+        // Vérifié sous le verrou : un interrupt() concurrent publie son
+        // intention d'urgence après celle-ci, jamais avant
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        if (isCancelled(epoch)) {
+            return;
+        }
+        completed_request_id_ = std::max(completed_request_id_, request_id);
+        last_result_ = intention;
+        callback = intention_callback_;
+    }
+    result_cv_.notify_all();
 
-    if (intention_callback_) {
-        intention_callback_(emergency_intention);
+    if (callback) {
+        callback(intention);
+    }
+}
+
+void MDDOEngine::drainPending() {
+    while (true) {
+        PendingRequest request;
+        uint64_t epoch;
+        {
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            if (stop_ || !pending_) {
+                drain_scheduled_ = false;
+                return;
+            }
+            request = std::move(*pending_);
+            pending_.reset();
+            in_flight_ = true;
+            // Époque lue sous le verrou : un interrupt() antérieur à la prise
+            // de la requête l'aurait retirée de pending_
+            epoch = interrupt_epoch_.load(std::memory_order_acquire);
+        }
+
+        std::optional<ActionIntention> intention;
+        try {
+            intention = runDeliberation(request.situation, epoch);
+        } catch (const std::exception& e) {
+            MCEE_LOG_ERROR("MDDO", "Erreur délibération asynchrone: ", e.what());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            in_flight_ = false;
+        }
+
+        if (intention) {
+            publishResult(*intention, request.id, epoch);
+        }
     }
 }
 
@@ -183,9 +366,10 @@ std::vector<Memory> MDDOEngine::activateMemories(const SituationFrame& situation
     return activated;
 }
 
-std::vector<ActionOption> MDDOEngine::simulate(
+std::optional<std::vector<ActionOption>> MDDOEngine::simulate(
     const SituationFrame& situation,
-    const std::vector<Memory>& memories) {
+    const std::vector<Memory>& memories,
+    uint64_t epoch) {
 
     std::vector<ActionOption> options = generateOptions(situation);
 
@@ -195,6 +379,10 @@ std::vector<ActionOption> MDDOEngine::simulate(
     std::normal_distribution<> noise(0.0, 0.1);
 
     for (auto& option : options) {
+        if (isCancelled(epoch)) {
+            return std::nullopt;
+        }
+
         // Simulation Monte-Carlo simplifiée
         double total_reward = 0.0;
         double total_cost = 0.0;
@@ -281,7 +469,7 @@ ActionIntention MDDOEngine::arbitrate(
     ActionOption& best = options[0];
 
     // Vérifier le veto de l'Amyghaleon
-    if (checkVeto(best)) {
+    if (checkVeto(best, situation)) {
         // Chercher une alternative sûre
         for (auto& opt : options) {
             if (opt.category == "AVOID" || opt.category == "FLEE" || opt.category == "FREEZE") {
@@ -379,19 +567,17 @@ double MDDOEngine::computeUtility(const ActionOption& option) const {
     return std::clamp(utility, 0.0, 1.0);
 }
 
-bool MDDOEngine::checkVeto(const ActionOption& option) {
+bool MDDOEngine::checkVeto(const ActionOption& option, const SituationFrame& situation) {
     // Si callback de veto défini, l'utiliser
     if (veto_callback_) {
         return veto_callback_(option);
     }
 
     // Sinon, veto automatique si action risquée avec menace élevée
-    if (state_.current_situation) {
-        double threat = state_.current_situation->threat_level;
-        if (threat > config_.theta_veto &&
-            (option.category == "APPROACH" || option.category == "ENGAGE")) {
-            return true;
-        }
+    double threat = situation.threat_level;
+    if (threat > config_.theta_veto &&
+        (option.category == "APPROACH" || option.category == "ENGAGE")) {
+        return true;
     }
 
     return false;
@@ -4,6 +4,8 @@
  */
 
 #include "MLT.hpp"
+#include "Logger.hpp"
+#include "PatternSnapshot.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -11,6 +13,8 @@
 #include <sstream>
 #include <random>
 #include <iomanip>
+#include <tuple>
+#include <stdexcept>
 
 namespace mcee {
 
@@ -26,6 +30,88 @@ MLT::MLT(const MLTConfig& config) : config_(config) {
     initializeBasePatterns();
 }
 
+MLT::MLT(std::shared_ptr<const MLT> base) : base_(std::move(base)) {
+    if (!base_ || base_->base_) {
+        throw std::invalid_argument("MLT: la base d'une couche de session doit être une MLT racine");
+    }
+    config_ = base_->config_;
+    // Révisions de la couche au-delà de celles de la base : jamais confondues
+    revision_.store(base_->revision(), std::memory_order_relaxed);
+}
+
+MLT::~MLT() {
+    {
+        std::lock_guard<std::mutex> lock(learning_mutex_);
+        learning_stop_ = true;
+    }
+    learning_done_cv_.notify_all();
+    learning_lane_.close();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// VUE DE SESSION (couche puis base)
+// ═══════════════════════════════════════════════════════════════════════════
+
+const EmotionalPattern* MLT::findLocked(const std::string& id) const {
+    auto it = patterns_.find(id);
+    if (it != patterns_.end()) return &it->second;
+    if (!base_ || hidden_.count(id)) return nullptr;
+    auto base_it = base_->patterns_.find(id);
+    return base_it != base_->patterns_.end() ? &base_it->second : nullptr;
+}
+
+bool MLT::baseVisibleLocked(const std::string& id) const {
+    return !patterns_.count(id) && !hidden_.count(id);
+}
+
+template <typename Fn>
+void MLT::forEachLocked(Fn&& fn) const {
+    for (const auto& [id, pattern] : patterns_) fn(pattern);
+    if (!base_) return;
+    for (const auto& [id, pattern] : base_->patterns_) {
+        if (baseVisibleLocked(id)) fn(pattern);
+    }
+}
+
+size_t MLT::countLocked() const {
+    size_t count = 0;
+    forEachLocked([&](const EmotionalPattern&) { count++; });
+    return count;
+}
+
+EmotionalPattern* MLT::ownLocked(const std::string& id) {
+    auto it = patterns_.find(id);
+    if (it != patterns_.end()) return &it->second;
+    const EmotionalPattern* shared = findLocked(id);
+    if (!shared) return nullptr;
+
+    // Copie sur écriture, révisions comprises : inchangée, elle ne force aucun rematch
+    auto& own = patterns_.emplace(id, *shared).first->second;
+    matrix_.upsert(own);
+    return &own;
+}
+
+void MLT::eraseLocked(const std::string& id) {
+    if (patterns_.count(id)) {
+        matrix_.remove(id);
+        patterns_.erase(id);
+    }
+    if (base_ && base_->patterns_.count(id)) {
+        hidden_.insert(id);
+    }
+    revision_.fetch_add(1, std::memory_order_relaxed);
+}
+
+PatternMatrix MLT::viewMatrixLocked() const {
+    PatternMatrix view = matrix_;
+    if (base_) {
+        for (const auto& [id, pattern] : base_->patterns_) {
+            if (baseVisibleLocked(id)) view.upsert(pattern);
+        }
+    }
+    return view;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // INITIALISATION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -146,6 +232,8 @@ void MLT::initializeBasePatterns() {
         patterns_[pattern.id] = pattern;
     }
     
+    rebuildMatrix();
+    
     emitEvent(PatternEvent::Type::CREATED, "", "BASE_PATTERNS", 
               "8 patterns de base initialisés");
 }
@@ -196,6 +284,10 @@ EmotionalPattern MLT::createBasePattern(const std::string& name,
 }
 
 bool MLT::loadFromFile(const std::string& path) {
+    if (isPatternSnapshotFile(path)) {
+        return loadSnapshot(path);
+    }
+
     try {
         std::ifstream file(path);
         if (!file.is_open()) {
@@ -212,19 +304,97 @@ bool MLT::loadFromFile(const std::string& path) {
 }
 
 bool MLT::saveToFile(const std::string& path) const {
+    if (base_) {
+        return base_->saveToFile(path);
+    }
+    const std::string ext = ".json";
+    if (path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0) {
+        return exportJson(path);
+    }
+    return saveSnapshot(path);
+}
+
+bool MLT::exportJson(const std::string& path) const {
     try {
-        std::ofstream file(path);
-        if (!file.is_open()) {
+        std::string error;
+        if (!writeFileAtomic(path, toJson().dump(2) + "\n", &error)) {
+            MCEE_LOG_WARN("MLT", "Export JSON impossible (", path, "): ", error);
             return false;
         }
-        
-        file << std::setw(2) << toJson() << std::endl;
         return true;
     } catch (const std::exception& e) {
         return false;
     }
 }
 
+std::string MLT::encodeSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (base_) {
+        return encodePatternSnapshot(viewMatrixLocked(), config_);
+    }
+    return encodePatternSnapshot(matrix_, config_);
+}
+
+bool MLT::saveSnapshot(const std::string& path) const {
+    try {
+        const std::string data = encodeSnapshot();
+
+        // Écriture hors verrou : le matching continue pendant le checkpoint
+        std::string error;
+        if (!writeFileAtomic(path, data, &error)) {
+            MCEE_LOG_WARN("MLT", "Checkpoint impossible (", path, "): ", error);
+            return false;
+        }
+        return true;
+    } catch (const std::exception& e) {
+        MCEE_LOG_WARN("MLT", "Checkpoint impossible (", path, "): ", e.what());
+        return false;
+    }
+}
+
+bool MLT::loadSnapshot(const std::string& path) {
+    PatternSnapshotReader reader;
+    std::string error;
+    if (!reader.open(path, &error)) {
+        MCEE_LOG_WARN("MLT", "Snapshot refusé (", path, "): ", error);
+        return false;
+    }
+
+    // Matérialisation hors verrou ; les nœuds ne bougent plus ensuite
+    std::unordered_map<std::string, EmotionalPattern> loaded;
+    loaded.reserve(reader.size());
+    std::vector<const EmotionalPattern*> rows;
+    rows.reserve(reader.size());
+
+    for (size_t i = 0; i < reader.size(); ++i) {
+        EmotionalPattern pattern;
+        reader.readPattern(i, pattern);
+        std::string id = pattern.id;
+        auto [it, inserted] = loaded.emplace(std::move(id), std::move(pattern));
+        if (!inserted) {
+            MCEE_LOG_WARN("MLT", "Snapshot refusé (", path, "): id dupliqué ", it->first);
+            return false;
+        }
+        rows.push_back(&it->second);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    patterns_.swap(loaded);
+    matrix_.loadImage(reader.image(), rows);
+    // Couche de session : le snapshot est la vue complète, la base est masquée
+    hidden_.clear();
+    if (base_) {
+        for (const auto& [id, pattern] : base_->patterns_) hidden_.insert(id);
+    }
+    const uint64_t revision = revision_.fetch_add(1, std::memory_order_relaxed) + 1;
+    for (auto& [id, pattern] : patterns_) {
+        pattern.revision = revision;
+        pattern.coefficients_revision = revision;
+    }
+    reader.applyConfig(config_);
+    return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // MATCHING
 // ═══════════════════════════════════════════════════════════════════════════
@@ -242,33 +412,148 @@ std::vector<PatternMatch> MLT::findMatches(const EmotionalSignature& signature,
     
     std::vector<PatternMatch> matches;
     
-    for (const auto& [id, pattern] : patterns_) {
-        if (!pattern.is_active) continue;
-        
-        double similarity = computeSimilarity(signature, pattern);
-        
-        if (similarity >= config_.min_similarity_threshold) {
-            PatternMatch match;
-            match.pattern_id = id;
-            match.pattern_name = pattern.name;
-            match.similarity = similarity;
-            match.confidence = pattern.confidence;
-            match.pattern = &pattern;
-            matches.push_back(match);
+    // Une seule passe vectorisée sur toutes les lignes ; la table n'est lue
+    // que pour les candidats au-dessus du seuil
+    auto collect = [&](const PatternMatrix& matrix, std::vector<double>& scores, bool base) {
+        matrix.score(signature, scores);
+        for (size_t row = 0; row < matrix.size(); ++row) {
+            if (!matrix.isActive(row)) continue;
+            
+            double similarity = scores[row];
+            
+            if (similarity >= config_.min_similarity_threshold) {
+                // Base : les patterns copiés ou supprimés dans la couche sont masqués
+                if (base && !baseVisibleLocked(matrix.idAt(row))) continue;
+                const EmotionalPattern* pattern = matrix.patternAt(row);
+                PatternMatch match;
+                match.pattern_id = pattern->id;
+                match.pattern_name = pattern->name;
+                match.similarity = similarity;
+                match.confidence = pattern->confidence;
+                match.pattern = pattern;
+                matches.push_back(match);
+            }
         }
+    };
+    collect(matrix_, score_scratch_, false);
+    if (base_) {
+        collect(base_->matrix_, base_scratch_, true);
     }
     
     // Tri par score combiné (similarité * confiance)
-    std::sort(matches.begin(), matches.end());
-    
-    // Limite au nombre demandé
     if (matches.size() > n) {
+        std::partial_sort(matches.begin(), matches.begin() + n, matches.end());
         matches.resize(n);
+    } else {
+        std::sort(matches.begin(), matches.end());
+    }
+    
+    return matches;
+}
+
+std::vector<PatternMatch> MLT::findTransitionMatches(const EmotionalSignature& signature,
+                                                 const std::string& from_id,
+                                                 size_t k) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<PatternMatch> matches;
+    const EmotionalPattern* from = findLocked(from_id);
+    if (!from) {
+        return matches;
+    }
+    
+    // Le pattern courant d'abord (cas stationnaire), puis ses k successeurs
+    // les plus probables
+    std::vector<std::pair<double, const std::string*>> targets;
+    targets.reserve(from->transition_probabilities.size());
+    for (const auto& [id, prob] : from->transition_probabilities) {
+        if (id != from_id) targets.emplace_back(prob, &id);
+    }
+    size_t take = std::min(k, targets.size());
+    std::partial_sort(targets.begin(), targets.begin() + static_cast<std::ptrdiff_t>(take), targets.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    
+    auto consider = [&](const EmotionalPattern& pattern) {
+        if (!pattern.is_active) return;
+        double similarity = computeSimilarity(signature, pattern);
+        if (similarity < config_.min_similarity_threshold) return;
+        PatternMatch match;
+        match.pattern_id = pattern.id;
+        match.pattern_name = pattern.name;
+        match.similarity = similarity;
+        match.confidence = pattern.confidence;
+        match.pattern = &pattern;
+        matches.push_back(match);
+    };
+    
+    consider(*from);
+    for (size_t i = 0; i < take; ++i) {
+        if (const EmotionalPattern* target = findLocked(*targets[i].second)) consider(*target);
     }
     
+    std::sort(matches.begin(), matches.end());
     return matches;
 }
 
+void MLT::patternRevisions(const std::vector<std::string>& pattern_ids,
+                           std::vector<uint64_t>& revisions) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    revisions.clear();
+    for (const auto& id : pattern_ids) {
+        const EmotionalPattern* pattern = findLocked(id);
+        revisions.push_back(pattern ? pattern->revision : 0);
+    }
+}
+
+bool MLT::scorePattern(const EmotionalSignature& signature,
+                       const std::string& pattern_id,
+                       PatternScore& score) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const EmotionalPattern* pattern = findLocked(pattern_id);
+    if (!pattern || !pattern->is_active) return false;
+    score.similarity = computeSimilarity(signature, *pattern);
+    score.confidence = pattern->confidence;
+    score.coefficients_revision = pattern->coefficients_revision;
+    return true;
+}
+
+std::vector<TransitionForecast> MLT::predictTransitions(const std::string& from_id,
+                                                       size_t k,
+                                                       double min_probability) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<TransitionForecast> forecasts;
+    const EmotionalPattern* from = findLocked(from_id);
+    if (!from || k == 0) {
+        return forecasts;
+    }
+    
+    std::vector<std::pair<double, const EmotionalPattern*>> targets;
+    for (const auto& [id, prob] : from->transition_probabilities) {
+        if (id == from_id || prob < min_probability) continue;
+        const EmotionalPattern* target = findLocked(id);
+        if (target && target->is_active) targets.emplace_back(prob, target);
+    }
+    size_t take = std::min(k, targets.size());
+    std::partial_sort(targets.begin(), targets.begin() + static_cast<std::ptrdiff_t>(take), targets.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    
+    forecasts.reserve(take);
+    for (size_t i = 0; i < take; ++i) {
+        const EmotionalPattern& pattern = *targets[i].second;
+        TransitionForecast forecast;
+        forecast.pattern_id = pattern.id;
+        forecast.pattern_name = pattern.name;
+        forecast.probability = targets[i].first;
+        forecast.mean_emotions = pattern.signature.mean_emotions;
+        forecast.lemmas = pattern.trigger_words;
+        forecast.lemmas.insert(forecast.lemmas.end(), pattern.associated_contexts.begin(),
+                               pattern.associated_contexts.end());
+        forecasts.push_back(std::move(forecast));
+    }
+    return forecasts;
+}
+
 double MLT::computeSimilarity(const EmotionalSignature& signature, 
                               const EmotionalPattern& pattern) const {
     // Similarité cosinus sur les émotions moyennes
@@ -323,7 +608,9 @@ std::string MLT::createPattern(const EmotionalSignature& signature,
     pattern.emergency_threshold = 0.75;
     pattern.memory_trigger_threshold = 0.5;
     
+    touchLocked(pattern);
     patterns_[pattern.id] = pattern;
+    matrix_.upsert(patterns_[pattern.id]);
     
     emitEvent(PatternEvent::Type::CREATED, pattern.id, pattern.name, 
               "Nouveau pattern créé");
@@ -336,12 +623,12 @@ std::string MLT::createDerivedPattern(const std::string& parent_id,
                                        const std::string& name) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto parent_it = patterns_.find(parent_id);
-    if (parent_it == patterns_.end()) {
+    const EmotionalPattern* parent_pattern = findLocked(parent_id);
+    if (!parent_pattern) {
         return "";
     }
     
-    const auto& parent = parent_it->second;
+    const auto& parent = *parent_pattern;
     
     EmotionalPattern pattern;
     pattern.id = generatePatternId();
@@ -364,10 +651,12 @@ std::string MLT::createDerivedPattern(const std::string& parent_id,
     // Relations
     pattern.parent_ids.push_back(parent_id);
     
+    touchLocked(pattern);
     patterns_[pattern.id] = pattern;
+    matrix_.upsert(patterns_[pattern.id]);
     
-    // Met à jour le parent
-    patterns_[parent_id].child_ids.push_back(pattern.id);
+    // Met à jour le parent (sa copie de session s'il vient de la base)
+    ownLocked(parent_id)->child_ids.push_back(pattern.id);
     
     emitEvent(PatternEvent::Type::CREATED, pattern.id, pattern.name,
               "Pattern dérivé de " + parent.name);
@@ -380,12 +669,12 @@ void MLT::updatePattern(const std::string& pattern_id,
                         std::optional<double> feedback) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it == patterns_.end() || it->second.is_locked) {
+    const EmotionalPattern* target = findLocked(pattern_id);
+    if (!target || target->is_locked) {
         return;
     }
     
-    auto& pattern = it->second;
+    auto& pattern = *ownLocked(pattern_id);
     
     // Mise à jour de la signature (moyenne mobile)
     double learning_rate = config_.learning_rate;
@@ -421,6 +710,8 @@ void MLT::updatePattern(const std::string& pattern_id,
     }
     
     pattern.last_modified = std::chrono::system_clock::now();
+    matrix_.upsert(pattern);
+    touchLocked(pattern, false);
     
     emitEvent(PatternEvent::Type::MODIFIED, pattern_id, pattern.name,
               "Pattern mis à jour");
@@ -428,21 +719,24 @@ void MLT::updatePattern(const std::string& pattern_id,
 
 std::string MLT::mergePatterns(const std::string& id1, const std::string& id2) {
     std::lock_guard<std::mutex> lock(mutex_);
+    return mergeLocked(id1, id2);
+}
+
+std::string MLT::mergeLocked(const std::string& id1, const std::string& id2) {
+    const EmotionalPattern* source1 = findLocked(id1);
+    const EmotionalPattern* source2 = findLocked(id2);
     
-    auto it1 = patterns_.find(id1);
-    auto it2 = patterns_.find(id2);
-    
-    if (it1 == patterns_.end() || it2 == patterns_.end()) {
+    if (!source1 || !source2) {
         return "";
     }
     
-    if (it1->second.is_base_pattern || it2->second.is_base_pattern) {
+    if (source1->is_base_pattern || source2->is_base_pattern) {
         // Ne pas fusionner les patterns de base
         return "";
     }
     
-    const auto& p1 = it1->second;
-    const auto& p2 = it2->second;
+    const auto& p1 = *source1;
+    const auto& p2 = *source2;
     
     // Poids basé sur le nombre d'activations
     double weight1 = p1.activation_count / 
@@ -476,11 +770,19 @@ std::string MLT::mergePatterns(const std::string& id1, const std::string& id2) {
                                        p2.associated_contexts.begin(),
                                        p2.associated_contexts.end());
     
+    touchLocked(merged);
     patterns_[merged.id] = merged;
     
     // Désactive les patterns source
-    patterns_[id1].is_active = false;
-    patterns_[id2].is_active = false;
+    EmotionalPattern& own1 = *ownLocked(id1);
+    EmotionalPattern& own2 = *ownLocked(id2);
+    own1.is_active = false;
+    own2.is_active = false;
+    touchLocked(own1);
+    touchLocked(own2);
+    matrix_.upsert(patterns_[merged.id]);
+    matrix_.upsert(own1);
+    matrix_.upsert(own2);
     
     emitEvent(PatternEvent::Type::MERGED, merged.id, merged.name,
               "Fusion de " + id1 + " et " + id2);
@@ -491,17 +793,17 @@ std::string MLT::mergePatterns(const std::string& id1, const std::string& id2) {
 bool MLT::deletePattern(const std::string& pattern_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it == patterns_.end()) {
+    const EmotionalPattern* pattern = findLocked(pattern_id);
+    if (!pattern) {
         return false;
     }
     
-    if (it->second.is_base_pattern || it->second.is_locked) {
+    if (pattern->is_base_pattern || pattern->is_locked) {
         return false;
     }
     
-    std::string name = it->second.name;
-    patterns_.erase(it);
+    std::string name = pattern->name;
+    eraseLocked(pattern_id);
     
     emitEvent(PatternEvent::Type::DELETED, pattern_id, name,
               "Pattern supprimé");
@@ -512,20 +814,20 @@ bool MLT::deletePattern(const std::string& pattern_id) {
 void MLT::setPatternActive(const std::string& pattern_id, bool active) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it != patterns_.end()) {
-        it->second.is_active = active;
+    if (EmotionalPattern* pattern = ownLocked(pattern_id)) {
+        pattern->is_active = active;
+        matrix_.upsert(*pattern);
+        touchLocked(*pattern);
         emitEvent(active ? PatternEvent::Type::ACTIVATED : PatternEvent::Type::DEACTIVATED,
-                  pattern_id, it->second.name, "");
+                  pattern_id, pattern->name, "");
     }
 }
 
 void MLT::setPatternLocked(const std::string& pattern_id, bool locked) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it != patterns_.end()) {
-        it->second.is_locked = locked;
+    if (EmotionalPattern* pattern = ownLocked(pattern_id)) {
+        pattern->is_locked = locked;
     }
 }
 
@@ -536,10 +838,10 @@ void MLT::setPatternLocked(const std::string& pattern_id, bool locked) {
 void MLT::recordActivation(const std::string& pattern_id, double duration_seconds) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it == patterns_.end()) return;
+    EmotionalPattern* target = ownLocked(pattern_id);
+    if (!target) return;
     
-    auto& pattern = it->second;
+    auto& pattern = *target;
     pattern.activation_count++;
     pattern.last_activated = std::chrono::system_clock::now();
     
@@ -557,10 +859,10 @@ void MLT::recordActivation(const std::string& pattern_id, double duration_second
 void MLT::recordTransition(const std::string& from_id, const std::string& to_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(from_id);
-    if (it == patterns_.end()) return;
+    EmotionalPattern* target = ownLocked(from_id);
+    if (!target) return;
     
-    auto& pattern = it->second;
+    auto& pattern = *target;
     pattern.transition_probabilities[to_id] += 1.0;
     
     // Normalise les probabilités
@@ -580,10 +882,10 @@ void MLT::adjustCoefficients(const std::string& pattern_id,
                               const std::array<double, 24>* emotion_feedback) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = patterns_.find(pattern_id);
-    if (it == patterns_.end() || it->second.is_locked) return;
+    const EmotionalPattern* target = findLocked(pattern_id);
+    if (!target || target->is_locked) return;
     
-    auto& pattern = it->second;
+    auto& pattern = *ownLocked(pattern_id);
     double lr = config_.learning_rate * feedback;
     
     // Ajustement global des coefficients
@@ -606,6 +908,7 @@ void MLT::adjustCoefficients(const std::string& pattern_id,
     pattern.theta /= sum;
     
     pattern.last_modified = std::chrono::system_clock::now();
+    touchLocked(pattern);
 }
 
 void MLT::runLearningPass() {
@@ -614,37 +917,149 @@ void MLT::runLearningPass() {
     recalculateStatistics();
 }
 
+void MLT::runLearningPassAsync() {
+    if (!config_.background_learning) {
+        runLearningPass();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(learning_mutex_);
+        // Une passe déjà en file couvre aussi cette demande
+        if (learning_stop_ || learning_pending_) return;
+        learning_pending_ = true;
+    }
+
+    if (!learning_lane_.post([this]() { learningTask(); })) {
+        MCEE_LOG_WARN("MLT", "Passe d'apprentissage refusée par l'Executor");
+        {
+            std::lock_guard<std::mutex> lock(learning_mutex_);
+            learning_pending_ = false;
+        }
+        learning_done_cv_.notify_all();
+    }
+}
+
+bool MLT::isLearning() const {
+    std::lock_guard<std::mutex> lock(learning_mutex_);
+    return learning_pending_ || learning_in_flight_;
+}
+
+void MLT::waitForLearning() const {
+    std::unique_lock<std::mutex> lock(learning_mutex_);
+    learning_done_cv_.wait(lock, [this]() {
+        return learning_stop_ || (!learning_pending_ && !learning_in_flight_);
+    });
+}
+
+void MLT::learningTask() {
+    {
+        std::lock_guard<std::mutex> lock(learning_mutex_);
+        learning_pending_ = false;
+        if (learning_stop_) {
+            learning_done_cv_.notify_all();
+            return;
+        }
+        learning_in_flight_ = true;
+    }
+
+    try {
+        runLearningPass();
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("MLT", "Passe d'apprentissage interrompue: ", e.what());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(learning_mutex_);
+        learning_in_flight_ = false;
+    }
+    learning_done_cv_.notify_all();
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // MAINTENANCE
 // ═══════════════════════════════════════════════════════════════════════════
 
+std::vector<std::pair<std::string, std::string>> MLT::findMergeCandidates() const {
+    PatternMatrix snapshot;
+    std::vector<uint8_t> eligible;
+    double threshold;
+
+    // Copie de la matrice de scoring : seule étape sous le mutex. Les
+    // pointeurs de patterns qu'elle contient ne sont plus déréférencés ensuite.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threshold = config_.fusion_similarity_threshold;
+        snapshot = base_ ? viewMatrixLocked() : matrix_;
+
+        eligible.assign(snapshot.size(), 0);
+        for (size_t row = 0; row < snapshot.size(); ++row) {
+            const EmotionalPattern* pattern = snapshot.patternAt(row);
+            eligible[row] = !pattern->is_base_pattern && pattern->is_active &&
+                            pattern->activation_count >= static_cast<int>(config_.min_activations_for_fusion);
+        }
+    }
+
+    // Voisins de chaque pattern au-dessus du seuil, une ligne de scores
+    // vectorisée par pattern éligible
+    std::vector<std::tuple<double, size_t, size_t>> pairs;
+    std::vector<double> scores;
+    for (size_t row = 0; row < snapshot.size(); ++row) {
+        if (!eligible[row]) continue;
+        snapshot.scoreRow(row, scores);
+        for (size_t other = row + 1; other < snapshot.size(); ++other) {
+            if (eligible[other] && scores[other] >= threshold) {
+                pairs.emplace_back(scores[other], row, other);
+            }
+        }
+    }
+
+    // Appariement glouton : un pattern entre dans une seule fusion par passe
+    // (égalités départagées par identifiants : résultat indépendant de l'ordre de la table)
+    auto key = [&](const auto& pair) {
+        return std::minmax(snapshot.idAt(std::get<1>(pair)), snapshot.idAt(std::get<2>(pair)));
+    };
+    std::sort(pairs.begin(), pairs.end(), [&](const auto& x, const auto& y) {
+        if (std::get<0>(x) != std::get<0>(y)) return std::get<0>(x) > std::get<0>(y);
+        return key(x) < key(y);
+    });
+
+    std::vector<uint8_t> used(snapshot.size(), 0);
+    std::vector<std::pair<std::string, std::string>> result;
+    for (const auto& [sim, i, j] : pairs) {
+        if (used[i] || used[j]) continue;
+        used[i] = used[j] = 1;
+        result.emplace_back(snapshot.idAt(i), snapshot.idAt(j));
+    }
+    return result;
+}
+
 void MLT::autoMerge() {
+    const auto candidates = findMergeCandidates();
+    if (candidates.empty()) return;
+
+    // Les patterns ont pu changer depuis la copie : chaque paire est
+    // revalidée avant fusion
     std::lock_guard<std::mutex> lock(mutex_);
-    
-    std::vector<std::pair<std::string, std::string>> to_merge;
-    
-    // Trouve les paires de patterns similaires
-    for (auto it1 = patterns_.begin(); it1 != patterns_.end(); ++it1) {
-        if (it1->second.is_base_pattern || !it1->second.is_active) continue;
-        if (it1->second.activation_count < config_.min_activations_for_fusion) continue;
-        
-        for (auto it2 = std::next(it1); it2 != patterns_.end(); ++it2) {
-            if (it2->second.is_base_pattern || !it2->second.is_active) continue;
-            if (it2->second.activation_count < config_.min_activations_for_fusion) continue;
-            
-            double sim = computeSimilarity(it1->second.signature, it2->second);
-            if (sim >= config_.fusion_similarity_threshold) {
-                to_merge.emplace_back(it1->first, it2->first);
-            }
+    size_t merged = 0;
+    for (const auto& [id1, id2] : candidates) {
+        const EmotionalPattern* source1 = findLocked(id1);
+        const EmotionalPattern* source2 = findLocked(id2);
+        if (!source1 || !source2) continue;
+
+        const auto& p1 = *source1;
+        const auto& p2 = *source2;
+        if (!p1.is_active || !p2.is_active) continue;
+        if (computeSimilarity(p1.signature, p2) < config_.fusion_similarity_threshold) continue;
+
+        if (!mergeLocked(id1, id2).empty()) {
+            merged++;
         }
     }
-    
-    // Fusionne (sans le lock)
-    mutex_.unlock();
-    for (const auto& [id1, id2] : to_merge) {
-        mergePatterns(id1, id2);
+
+    if (merged > 0) {
+        MCEE_LOG_INFO("MLT", "Fusion automatique : ", merged, " paires de patterns");
     }
-    mutex_.lock();
 }
 
 void MLT::prune() {
@@ -655,40 +1070,41 @@ void MLT::prune() {
     
     std::vector<std::string> to_remove;
     
-    for (const auto& [id, pattern] : patterns_) {
-        if (pattern.is_base_pattern || pattern.is_locked) continue;
+    forEachLocked([&](const EmotionalPattern& pattern) {
+        if (pattern.is_base_pattern || pattern.is_locked) return;
         
         // Supprime si confiance trop basse ou inactif depuis longtemps
         if (pattern.confidence < config_.min_confidence_to_keep) {
-            to_remove.push_back(id);
+            to_remove.push_back(pattern.id);
         } else if (pattern.last_activated < cutoff && pattern.activation_count < 5) {
-            to_remove.push_back(id);
+            to_remove.push_back(pattern.id);
         }
-    }
+    });
     
     // Vérifie qu'on ne dépasse pas le max
-    if (patterns_.size() - to_remove.size() > config_.max_patterns) {
+    const size_t count = countLocked();
+    if (count - to_remove.size() > config_.max_patterns) {
         // Trie par score (confiance * activations)
         std::vector<std::pair<std::string, double>> scores;
-        for (const auto& [id, pattern] : patterns_) {
-            if (pattern.is_base_pattern || pattern.is_locked) continue;
-            if (std::find(to_remove.begin(), to_remove.end(), id) != to_remove.end()) continue;
+        forEachLocked([&](const EmotionalPattern& pattern) {
+            if (pattern.is_base_pattern || pattern.is_locked) return;
+            if (std::find(to_remove.begin(), to_remove.end(), pattern.id) != to_remove.end()) return;
             
             double score = pattern.confidence * std::log1p(pattern.activation_count);
-            scores.emplace_back(id, score);
-        }
+            scores.emplace_back(pattern.id, score);
+        });
         
         std::sort(scores.begin(), scores.end(),
                   [](const auto& a, const auto& b) { return a.second < b.second; });
         
-        size_t to_remove_count = patterns_.size() - config_.max_patterns;
+        size_t to_remove_count = count - config_.max_patterns;
         for (size_t i = 0; i < to_remove_count && i < scores.size(); ++i) {
             to_remove.push_back(scores[i].first);
         }
     }
     
     for (const auto& id : to_remove) {
-        patterns_.erase(id);
+        eraseLocked(id);
     }
 }
 
@@ -702,53 +1118,54 @@ void MLT::recalculateStatistics() {
 
 std::optional<EmotionalPattern> MLT::getPattern(const std::string& id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto it = patterns_.find(id);
-    if (it == patterns_.end()) return std::nullopt;
-    return it->second;
+    const EmotionalPattern* pattern = findLocked(id);
+    if (!pattern) return std::nullopt;
+    return *pattern;
 }
 
 std::optional<EmotionalPattern> MLT::getPatternByName(const std::string& name) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    for (const auto& [id, pattern] : patterns_) {
-        if (pattern.name == name) return pattern;
-    }
-    return std::nullopt;
+    std::optional<EmotionalPattern> result;
+    forEachLocked([&](const EmotionalPattern& pattern) {
+        if (!result && pattern.name == name) result = pattern;
+    });
+    return result;
 }
 
 std::vector<EmotionalPattern> MLT::getAllPatterns() const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<EmotionalPattern> result;
-    for (const auto& [id, pattern] : patterns_) {
+    forEachLocked([&](const EmotionalPattern& pattern) {
         result.push_back(pattern);
-    }
+    });
     return result;
 }
 
 std::vector<EmotionalPattern> MLT::getActivePatterns() const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<EmotionalPattern> result;
-    for (const auto& [id, pattern] : patterns_) {
+    forEachLocked([&](const EmotionalPattern& pattern) {
         if (pattern.is_active) {
             result.push_back(pattern);
         }
-    }
+    });
     return result;
 }
 
 std::vector<EmotionalPattern> MLT::getBasePatterns() const {
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<EmotionalPattern> result;
-    for (const auto& [id, pattern] : patterns_) {
+    forEachLocked([&](const EmotionalPattern& pattern) {
         if (pattern.is_base_pattern) {
             result.push_back(pattern);
         }
-    }
+    });
     return result;
 }
 
 size_t MLT::patternCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return patterns_.size();
+    return countLocked();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -771,7 +1188,8 @@ nlohmann::json MLT::toJson() const {
     };
     
     nlohmann::json patterns_json;
-    for (const auto& [id, pattern] : patterns_) {
+    size_t pattern_count = 0;
+    forEachLocked([&](const EmotionalPattern& pattern) {
         nlohmann::json p;
         p["id"] = pattern.id;
         p["name"] = pattern.name;
@@ -804,11 +1222,12 @@ nlohmann::json MLT::toJson() const {
         p["trigger_words"] = pattern.trigger_words;
         p["associated_contexts"] = pattern.associated_contexts;
         
-        patterns_json[id] = p;
-    }
+        patterns_json[pattern.id] = p;
+        pattern_count++;
+    });
     
     j["patterns"] = patterns_json;
-    j["pattern_count"] = patterns_.size();
+    j["pattern_count"] = pattern_count;
     
     return j;
 }
@@ -869,6 +1288,8 @@ void MLT::fromJson(const nlohmann::json& j) {
             patterns_[pattern.id] = pattern;
         }
     }
+    
+    rebuildMatrix();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -935,6 +1356,21 @@ EmotionalSignature MLT::averageSignatures(const EmotionalSignature& s1,
     return result;
 }
 
+void MLT::rebuildMatrix() {
+    const uint64_t revision = revision_.fetch_add(1, std::memory_order_relaxed) + 1;
+    matrix_.clear();
+    for (auto& [id, pattern] : patterns_) {
+        pattern.revision = revision;
+        pattern.coefficients_revision = revision;
+        matrix_.upsert(pattern);
+    }
+}
+
+void MLT::touchLocked(EmotionalPattern& pattern, bool coefficients) {
+    pattern.revision = revision_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (coefficients) pattern.coefficients_revision = pattern.revision;
+}
+
 void MLT::emitEvent(PatternEvent::Type type,
                     const std::string& id,
                     const std::string& name,
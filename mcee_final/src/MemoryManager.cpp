@@ -6,17 +6,346 @@
  */
 
 #include "MemoryManager.hpp"
+#include "Logger.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <chrono>
-#include <iostream>
 #include <iomanip>
+#include <limits>
 
 namespace mcee {
 
-MemoryManager::MemoryManager() {
-    std::cout << "[MemoryManager] Gestionnaire de mémoire initialisé (mode local)\n";
+namespace {
+
+constexpr double LN2 = 0.6931471805599453;
+constexpr double TRAUMA_DECAY_RATIO = 0.1;   // Les traumas s'oublient dix fois moins vite
+constexpr double MIN_WEIGHT_FLOOR = 1e-12;   // Évite log(0) dans les rangs
+
+int64_t toMillis(std::chrono::system_clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMillis(int64_t ms) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(ms)));
+}
+
+uint8_t quantize(double value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0, 1.0) * 255.0));
+}
+
+double dequantize(uint8_t value) {
+    return static_cast<double>(value) / 255.0;
+}
+
+} // namespace
+
+MemoryManager::MemoryManager(const MemoryTierConfig& config)
+    : tier_config_(config)
+{
+    tier_config_.hot_capacity = std::max<size_t>(1, tier_config_.hot_capacity);
+    MCEE_LOG_INFO("MemoryManager", "Gestionnaire de mémoire initialisé (mode local, ",
+                  tier_config_.hot_capacity, " chauds / ", tier_config_.warm_capacity, " tièdes)");
+}
+
+void MemoryManager::setTierConfig(const MemoryTierConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = std::chrono::system_clock::now();
+    const double old_clock = decayClockLocked(false, now);
+    const double old_trauma_clock = decayClockLocked(true, now);
+
+    tier_config_ = config;
+    tier_config_.hot_capacity = std::max<size_t>(1, tier_config_.hot_capacity);
+
+    // Nouvelle demi-vie : recaler les rangs pour conserver les poids effectifs actuels
+    const double shift = decayClockLocked(false, now) - old_clock;
+    const double trauma_shift = decayClockLocked(true, now) - old_trauma_clock;
+    for (auto& slot : hot_) {
+        slot.rank += slot.is_trauma ? trauma_shift : shift;
+    }
+    for (auto& warm : warm_) {
+        warm.rank += warm.is_trauma ? trauma_shift : shift;
+    }
+
+    // Niveau tiède réduit : les entrées hors de l'anneau ne restent que dans Neo4j
+    if (warm_.size() > tier_config_.warm_capacity) {
+        for (size_t pos = tier_config_.warm_capacity; pos < warm_.size(); ++pos) {
+            if (warm_[pos].used) {
+                releaseWarmLocked(pos);
+                tier_stats_.dropped_to_cold++;
+            }
+        }
+        warm_.resize(tier_config_.warm_capacity);
+        warm_head_ = 0;
+    }
+
+    // Niveau chaud réduit : rétrograder les plus faibles puis recompacter l'index
+    if (hot_.size() > tier_config_.hot_capacity) {
+        while (hot_count_ > tier_config_.hot_capacity) {
+            demoteLocked(weakestHotLocked());
+        }
+        std::vector<HotSlot> live;
+        live.reserve(hot_count_);
+        for (auto& slot : hot_) {
+            if (slot.memory) live.push_back(std::move(slot));
+        }
+        hot_.clear();
+        hot_free_.clear();
+        hot_count_ = 0;
+        index_.clear();
+        for (auto& slot : live) {
+            appendLocked(std::move(slot));
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// NIVEAUX CHAUD / TIÈDE
+// ═══════════════════════════════════════════════════════════════════════════
+
+double MemoryManager::decayClockLocked(bool is_trauma, std::chrono::system_clock::time_point now) const {
+    const double hours = std::chrono::duration<double, std::ratio<3600>>(now.time_since_epoch()).count();
+    const double rate = LN2 / std::max(1e-6, tier_config_.weight_half_life_hours);
+    if (is_trauma) {
+        return rate * TRAUMA_DECAY_RATIO * hours - trauma_forget_log_;
+    }
+    return rate * hours - forget_log_;
+}
+
+bool MemoryManager::forgetIfFadedLocked(size_t slot, double faded_rank) {
+    if (hot_[slot].is_trauma || hot_[slot].rank >= faded_rank) {
+        return false;
+    }
+    releaseHotLocked(slot);
+    tier_stats_.forgotten++;
+    return true;
+}
+
+MemoryRef MemoryManager::makeRefLocked(size_t slot, double clock, double trauma_clock) const {
+    const HotSlot& hot = hot_[slot];
+    MemoryRef ref;
+    ref.memory = hot.memory;
+    ref.weight = std::exp(hot.rank - (hot.is_trauma ? trauma_clock : clock));
+    ref.activation = hot.memory->activation;
+    ref.activation_count = hot.activation_count;
+    ref.last_activated = hot.last_activated;
+    return ref;
+}
+
+size_t MemoryManager::appendLocked(const Memory& memory) {
+    HotSlot slot;
+    slot.is_trauma = memory.is_trauma;
+    slot.rank = std::log(std::max(memory.weight, MIN_WEIGHT_FLOOR)) +
+                decayClockLocked(memory.is_trauma, std::chrono::system_clock::now());
+    slot.last_activated = memory.last_activated;
+    slot.activation_count = memory.activation_count;
+    slot.memory = std::make_shared<const Memory>(memory);
+    return appendLocked(std::move(slot));
+}
+
+size_t MemoryManager::appendLocked(HotSlot slot) {
+    if (hot_free_.empty() && hot_.size() >= tier_config_.hot_capacity) {
+        demoteLocked(weakestHotLocked());
+    }
+
+    const auto& emotions = slot.memory->emotions;
+    size_t row;
+    if (!hot_free_.empty()) {
+        row = hot_free_.back();
+        hot_free_.pop_back();
+        index_.set(row, emotions);
+        hot_[row] = std::move(slot);
+    } else {
+        row = index_.add(emotions);
+        hot_.push_back(std::move(slot));
+    }
+    hot_count_++;
+    return row;
+}
+
+size_t MemoryManager::weakestHotLocked() const {
+    // Rangs invariants dans le temps : pas de recalcul des poids effectifs
+    size_t weakest = hot_.size();
+    double weakest_rank = std::numeric_limits<double>::infinity();
+    bool weakest_trauma = true;
+
+    for (size_t i = 0; i < hot_.size(); ++i) {
+        const HotSlot& slot = hot_[i];
+        if (!slot.memory) continue;
+
+        // Un souvenir ordinaire est toujours rétrogradé avant un trauma
+        bool better = (weakest_trauma && !slot.is_trauma) ||
+                      (slot.is_trauma == weakest_trauma && slot.rank < weakest_rank);
+        if (better) {
+            weakest = i;
+            weakest_rank = slot.rank;
+            weakest_trauma = slot.is_trauma;
+        }
+    }
+    return weakest;
+}
+
+void MemoryManager::demoteLocked(size_t slot) {
+    if (slot >= hot_.size() || !hot_[slot].memory) return;
+
+    if (tier_config_.warm_capacity == 0) {
+        releaseHotLocked(slot);
+        tier_stats_.dropped_to_cold++;
+        return;
+    }
+
+    // Anneau : l'entrée la plus ancienne est écrasée (Neo4j la conserve depuis sa création)
+    size_t pos;
+    if (warm_.size() < tier_config_.warm_capacity) {
+        pos = warm_.size();
+        warm_.emplace_back();
+    } else {
+        pos = warm_head_;
+        warm_head_ = (warm_head_ + 1) % warm_.size();
+        if (warm_[pos].used) {
+            releaseWarmLocked(pos);
+            tier_stats_.dropped_to_cold++;
+        }
+    }
+
+    const HotSlot& hot = hot_[slot];
+    const Memory& memory = *hot.memory;
+    WarmMemory& warm = warm_[pos];
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+        warm.emotions[i] = quantize(memory.emotions[i]);
+    }
+    warm.name_id = internLocked(memory.name);
+    warm.dominant_id = internLocked(memory.dominant);
+    warm.valence = static_cast<float>(memory.valence);
+    warm.intensity = static_cast<float>(memory.intensity);
+    warm.rank = hot.rank;
+    warm.last_activated_ms = toMillis(hot.last_activated);
+    warm.activation_count = hot.activation_count;
+    warm.phase = static_cast<uint8_t>(memory.phase_at_creation);
+    warm.is_trauma = hot.is_trauma;
+    warm.used = true;
+    warm_count_++;
+    tier_stats_.demoted++;
+
+    releaseHotLocked(slot);
+}
+
+void MemoryManager::releaseHotLocked(size_t slot) {
+    hot_[slot] = HotSlot{};
+    index_.set(slot, std::array<double, NUM_EMOTIONS>{});
+    hot_free_.push_back(slot);
+    hot_count_--;
+}
+
+MemoryManager::HotSlot MemoryManager::takeWarmLocked(size_t warm_pos, std::chrono::system_clock::time_point now) {
+    const WarmMemory& warm = warm_[warm_pos];
+    HotSlot slot;
+    slot.memory = std::make_shared<const Memory>(materializeWarmLocked(warm, now));
+    slot.rank = warm.rank;
+    slot.last_activated = fromMillis(warm.last_activated_ms);
+    slot.activation_count = warm.activation_count;
+    slot.is_trauma = warm.is_trauma;
+
+    releaseWarmLocked(warm_pos);
+    tier_stats_.promoted++;
+    return slot;
+}
+
+void MemoryManager::releaseWarmLocked(size_t warm_pos) {
+    WarmMemory& warm = warm_[warm_pos];
+    releaseNameLocked(warm.name_id);
+    releaseNameLocked(warm.dominant_id);
+    warm = WarmMemory{};
+    warm_count_--;
+}
+
+Memory MemoryManager::materializeWarmLocked(
+    const WarmMemory& warm,
+    std::chrono::system_clock::time_point now) const
+{
+    Memory memory;
+    memory.name = names_[warm.name_id];
+    for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+        memory.emotions[i] = dequantize(warm.emotions[i]);
+    }
+    memory.dominant = names_[warm.dominant_id];
+    memory.valence = warm.valence;
+    memory.intensity = warm.intensity;
+    memory.weight = std::exp(warm.rank - decayClockLocked(warm.is_trauma, now));
+    memory.activation = warm.intensity;
+    memory.is_trauma = warm.is_trauma;
+    memory.phase_at_creation = static_cast<Phase>(warm.phase);
+    memory.last_activated = fromMillis(warm.last_activated_ms);
+    memory.activation_count = warm.activation_count;
+    return memory;
+}
+
+uint32_t MemoryManager::internLocked(const std::string& text) {
+    auto it = name_ids_.find(text);
+    if (it != name_ids_.end()) {
+        name_refs_[it->second]++;
+        return it->second;
+    }
+
+    uint32_t id;
+    if (!name_free_.empty()) {
+        id = name_free_.back();
+        name_free_.pop_back();
+        names_[id] = text;
+        name_refs_[id] = 1;
+    } else {
+        id = static_cast<uint32_t>(names_.size());
+        names_.push_back(text);
+        name_refs_.push_back(1);
+    }
+    name_ids_.emplace(text, id);
+    return id;
+}
+
+void MemoryManager::releaseNameLocked(uint32_t id) {
+    if (--name_refs_[id] > 0) return;
+    name_ids_.erase(names_[id]);
+    std::string().swap(names_[id]);
+    name_free_.push_back(id);
+}
+
+std::vector<Memory> MemoryManager::getAllMemories() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto now = std::chrono::system_clock::now();
+    const double clock = decayClockLocked(false, now);
+    const double trauma_clock = decayClockLocked(true, now);
+
+    std::vector<Memory> all;
+    all.reserve(hot_count_ + warm_count_);
+    for (const auto& slot : hot_) {
+        if (!slot.memory) continue;
+        Memory memory = *slot.memory;
+        memory.weight = std::exp(slot.rank - (slot.is_trauma ? trauma_clock : clock));
+        memory.activation_count = slot.activation_count;
+        memory.last_activated = slot.last_activated;
+        all.push_back(std::move(memory));
+    }
+    for (const auto& warm : warm_) {
+        if (warm.used) all.push_back(materializeWarmLocked(warm, now));
+    }
+    return all;
+}
+
+size_t MemoryManager::importMemories(std::span<const Memory> memories) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& memory : memories) {
+        appendLocked(memory);
+    }
+    return memories.size();
+}
+
+MemoryTierStats MemoryManager::getTierStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryTierStats stats = tier_stats_;
+    stats.hot = hot_count_;
+    stats.warm = warm_count_;
+    return stats;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -24,37 +353,48 @@ MemoryManager::MemoryManager() {
 // ═══════════════════════════════════════════════════════════════════════════
 
 bool MemoryManager::setNeo4jConfig(const Neo4jClientConfig& config) {
-    neo4j_client_ = std::make_unique<Neo4jClient>(config);
+    neo4j_client_ = std::make_shared<Neo4jClient>(config);
 
     if (neo4j_client_->connect()) {
         neo4j_enabled_ = true;
 
         // Créer une session dans Neo4j de manière asynchrone
         // pour ne pas bloquer le démarrage du MCEE
-        std::cout << "[MemoryManager] Neo4j connecté, création de session asynchrone...\n";
-
-        // Utiliser createSessionAsync pour créer la session sans bloquer
-        neo4j_client_->createSessionAsync("SERENITE",
-            [this](const Neo4jResponse& response) {
-                if (response.success && response.data.contains("id")) {
-                    neo4j_session_id_ = response.data["id"].get<std::string>();
-                    std::cout << "[MemoryManager] Session Neo4j créée: " << neo4j_session_id_ << "\n";
-                } else {
-                    std::cerr << "[MemoryManager] Échec création session Neo4j: " << response.error << "\n";
-                    // Générer un ID local en cas d'échec
-                    neo4j_session_id_ = "LOCAL_SESSION_" + std::to_string(
-                        std::chrono::system_clock::now().time_since_epoch().count());
-                }
-            });
-
+        MCEE_LOG_INFO("MemoryManager", "Neo4j connecté, création de session asynchrone...");
+        openNeo4jSession();
         return true;
     }
 
-    std::cerr << "[MemoryManager] Échec connexion Neo4j\n";
+    MCEE_LOG_ERROR("MemoryManager", "Échec connexion Neo4j");
     neo4j_enabled_ = false;
     return false;
 }
 
+bool MemoryManager::attachNeo4jClient(std::shared_ptr<Neo4jClient> client) {
+    neo4j_client_ = std::move(client);
+    neo4j_enabled_ = neo4j_client_ && neo4j_client_->isConnected();
+    if (neo4j_enabled_) {
+        openNeo4jSession();
+    }
+    return neo4j_enabled_;
+}
+
+void MemoryManager::openNeo4jSession() {
+    // Utiliser createSessionAsync pour créer la session sans bloquer
+    neo4j_client_->createSessionAsync("SERENITE",
+        [this](const Neo4jResponse& response) {
+            if (response.success && response.data.contains("id")) {
+                neo4j_session_id_ = response.data["id"].get<std::string>();
+                MCEE_LOG_INFO("MemoryManager", "Session Neo4j créée: ", neo4j_session_id_);
+            } else {
+                MCEE_LOG_ERROR("MemoryManager", "Échec création session Neo4j: ", response.error);
+                // Générer un ID local en cas d'échec
+                neo4j_session_id_ = "LOCAL_SESSION_" + std::to_string(
+                    std::chrono::system_clock::now().time_since_epoch().count());
+            }
+        });
+}
+
 bool MemoryManager::isNeo4jConnected() const {
     return neo4j_enabled_ && neo4j_client_ && neo4j_client_->isConnected();
 }
@@ -64,20 +404,12 @@ size_t MemoryManager::syncToNeo4j() {
         return 0;
     }
 
-    size_t synced = 0;
-
-    for (const auto& mem : memories_) {
-        std::string context = "Souvenir local synchronisé";
+    // Copie sous verrou, envoi hors verrou : les lots partent en quelques messages
+    std::vector<Memory> snapshot = getAllMemories();
 
-        if (mem.is_trauma) {
-            neo4j_client_->createTrauma(mem, {});
-        } else {
-            neo4j_client_->createMemory(mem, context);
-        }
-        synced++;
-    }
+    size_t synced = neo4j_client_->createMemoriesBatch(snapshot, "Souvenir local synchronisé");
 
-    std::cout << "[MemoryManager] " << synced << " souvenirs synchronisés vers Neo4j\n";
+    MCEE_LOG_INFO("MemoryManager", synced, " souvenirs synchronisés vers Neo4j");
     return synced;
 }
 
@@ -119,39 +451,150 @@ size_t MemoryManager::loadFromNeo4j(const std::string& pattern_filter) {
                     }
                 }
 
-                memories_.push_back(mem);
+                std::lock_guard<std::mutex> lock(mutex_);
+                appendLocked(mem);
                 loaded++;
             }
         }
     }
 
-    std::cout << "[MemoryManager] " << loaded << " souvenirs chargés depuis Neo4j\n";
+    MCEE_LOG_INFO("MemoryManager", loaded, " souvenirs chargés depuis Neo4j");
     return loaded;
 }
 
-std::vector<Memory> MemoryManager::findSimilarInNeo4j(
+std::vector<MemoryRef> MemoryManager::findSimilarInNeo4j(
     const EmotionalState& state,
     double threshold,
     size_t limit)
 {
-    std::vector<Memory> results;
+    std::vector<MemoryRef> results;
+    index_queries_.fetch_add(1, std::memory_order_relaxed);
 
-    if (!isNeo4jConnected()) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = std::chrono::system_clock::now();
+
+        // 1. Niveau chaud : top-k cosinus sans réseau
+        std::vector<size_t> rows;
+        for (const auto& hit : index_.topK(state.emotions, limit, threshold)) {
+            if (hot_[hit.row].memory) rows.push_back(hit.row);
+        }
+
+        // 2. Niveau tiède : balayage des émotions quantifiées, les trouvailles remontent au chaud
+        if (rows.size() < limit && warm_count_ > 0) {
+            std::vector<std::pair<double, size_t>> warm_hits;
+            std::array<double, NUM_EMOTIONS> emotions{};
+            const double faded_rank = std::log(std::max(tier_config_.min_weight, MIN_WEIGHT_FLOOR)) +
+                                      decayClockLocked(false, now);
+            for (size_t pos = 0; pos < warm_.size(); ++pos) {
+                if (!warm_[pos].used) continue;
+                if (!warm_[pos].is_trauma && warm_[pos].rank < faded_rank) {
+                    releaseWarmLocked(pos);
+                    tier_stats_.forgotten++;
+                    continue;
+                }
+                for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+                    emotions[i] = dequantize(warm_[pos].emotions[i]);
+                }
+                double similarity = computeEmotionalMatch(state, emotions);
+                if (similarity >= threshold) {
+                    warm_hits.emplace_back(similarity, pos);
+                }
+            }
+
+            size_t wanted = std::min(limit - rows.size(), warm_hits.size());
+            std::partial_sort(warm_hits.begin(), warm_hits.begin() + static_cast<std::ptrdiff_t>(wanted),
+                              warm_hits.end(),
+                              [](const auto& a, const auto& b) { return a.first > b.first; });
+
+            // Extraire d'abord : une insertion au chaud peut rétrograder vers l'anneau tiède
+            std::vector<HotSlot> promoted;
+            for (size_t i = 0; i < wanted; ++i) {
+                promoted.push_back(takeWarmLocked(warm_hits[i].second, now));
+            }
+            for (auto& slot : promoted) {
+                rows.push_back(appendLocked(std::move(slot)));
+            }
+            if (wanted > 0) {
+                tier_stats_.warm_hits++;
+            }
+        }
+
+        const double clock = decayClockLocked(false, now);
+        const double trauma_clock = decayClockLocked(true, now);
+        for (size_t row : rows) {
+            // Une remontée peut avoir rétrogradé un résultat chaud déjà retenu
+            if (hot_[row].memory) results.push_back(makeRefLocked(row, clock, trauma_clock));
+        }
+    }
+
+    if (results.size() >= limit || !isNeo4jConnected()) {
+        index_local_hits_.fetch_add(1, std::memory_order_relaxed);
         return results;
     }
 
+    // 2. Données froides : compléter depuis Neo4j
+    index_fallbacks_.fetch_add(1, std::memory_order_relaxed);
     auto similar = neo4j_client_->findSimilarMemories(state.emotions, threshold, limit);
 
     for (const auto& [id, similarity] : similar) {
+        if (results.size() >= limit) break;
+
+        bool known = std::any_of(results.begin(), results.end(),
+                                 [&id = id](const MemoryRef& m) { return m->name == id; });
+        if (known) continue;
+
         auto mem_opt = neo4j_client_->getMemory(id);
-        if (mem_opt.has_value()) {
-            results.push_back(mem_opt.value());
+        if (!mem_opt.has_value()) continue;
+
+        // Lecture traversante : le souvenir devient chaud pour les requêtes suivantes
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto cached = std::find_if(hot_.begin(), hot_.end(),
+                                   [&id = id](const HotSlot& s) { return s.memory && s.memory->name == id; });
+        size_t row = cached != hot_.end() ? static_cast<size_t>(cached - hot_.begin())
+                                          : appendLocked(mem_opt.value());
+        if (cached == hot_.end()) {
+            tier_stats_.promoted++;
         }
+        const auto now = std::chrono::system_clock::now();
+        results.push_back(makeRefLocked(row, decayClockLocked(false, now), decayClockLocked(true, now)));
     }
 
     return results;
 }
 
+MemoryIndexStats MemoryManager::getIndexStats() const {
+    MemoryIndexStats stats;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats.indexed = hot_count_;
+    }
+    stats.queries = index_queries_.load(std::memory_order_relaxed);
+    stats.local_hits = index_local_hits_.load(std::memory_order_relaxed);
+    stats.neo4j_fallbacks = index_fallbacks_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t MemoryManager::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = sizeof(*this);
+    bytes += hot_.capacity() * sizeof(HotSlot) + hot_free_.capacity() * sizeof(size_t);
+    for (const auto& slot : hot_) {
+        if (!slot.memory) continue;
+        bytes += sizeof(Memory) + slot.memory->name.capacity() + slot.memory->dominant.capacity();
+    }
+    bytes += index_.size() * MemoryVectorIndex::DIM * sizeof(float);
+    bytes += score_scratch_.capacity() * sizeof(float);
+
+    bytes += warm_.capacity() * sizeof(WarmMemory);
+    bytes += names_.capacity() * sizeof(std::string) + name_refs_.capacity() * sizeof(uint32_t);
+    for (const auto& name : names_) {
+        bytes += name.capacity();
+    }
+    bytes += name_ids_.size() * (sizeof(std::string) + sizeof(uint32_t) + 2 * sizeof(void*));
+    return bytes;
+}
+
 void MemoryManager::recordPatternTransition(
     const std::string& from_pattern,
     const std::string& to_pattern,
@@ -165,19 +608,46 @@ void MemoryManager::recordPatternTransition(
     neo4j_client_->recordPatternTransition(from_pattern, to_pattern, duration_s, trigger);
 }
 
-std::vector<Memory> MemoryManager::queryRelevantMemories(
+std::vector<MemoryRef> MemoryManager::queryRelevantMemories(
     Phase phase,
     const EmotionalState& state,
     size_t max_count) 
 {
-    std::vector<Memory> result;
+    std::pmr::vector<MemoryRef> refs(std::pmr::new_delete_resource());
+    queryRelevantMemories(phase, state, max_count, refs);
+    return std::vector<MemoryRef>(std::make_move_iterator(refs.begin()), std::make_move_iterator(refs.end()));
+}
+
+void MemoryManager::queryRelevantMemories(
+    Phase phase,
+    const EmotionalState& state,
+    size_t max_count,
+    std::pmr::vector<MemoryRef>& result)
+{
+    result.clear();
 
     // Filtrer et trier selon la phase
-    std::vector<std::pair<double, size_t>> scored_indices;
+    std::pmr::vector<std::pair<double, size_t>> scored_indices(result.get_allocator());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Oubli paresseux : un rang sous ce seuil est un poids effectif < min_weight
+    const auto now = std::chrono::system_clock::now();
+    const double clock = decayClockLocked(false, now);
+    const double trauma_clock = decayClockLocked(true, now);
+    const double faded_rank = std::log(std::max(tier_config_.min_weight, MIN_WEIGHT_FLOOR)) + clock;
+
+    // Phases sans filtre dédié : similarités cosinus calculées en une passe sur l'index
+    const bool use_index = phase != Phase::PEUR && phase != Phase::JOIE && phase != Phase::ANXIETE;
+    if (use_index) {
+        index_.cosineAll(state.emotions, score_scratch_);
+    }
+
+    for (size_t i = 0; i < hot_.size(); ++i) {
+        if (!hot_[i].memory || forgetIfFadedLocked(i, faded_rank)) continue;
 
-    for (size_t i = 0; i < memories_.size(); ++i) {
         double score = 0.0;
-        const auto& mem = memories_[i];
+        const auto& mem = *hot_[i].memory;
 
         switch (phase) {
             case Phase::PEUR:
@@ -204,13 +674,16 @@ std::vector<Memory> MemoryManager::queryRelevantMemories(
                 // Souvenirs négatifs récents
                 if (mem.dominant == "Anxiété" || mem.dominant == "Peur" || 
                     mem.dominant == "Confusion") {
-                    score = mem.activation_count * 0.1 + mem.intensity;
+                    score = hot_[i].activation_count * 0.1 + mem.intensity;
                 }
                 break;
 
             default:
                 // Requête équilibrée basée sur le poids
-                score = mem.weight * computeEmotionalMatch(state, mem);
+                if (score_scratch_[i] > 0.0f) {
+                    score = std::exp(hot_[i].rank - (hot_[i].is_trauma ? trauma_clock : clock)) *
+                            score_scratch_[i];
+                }
                 break;
         }
 
@@ -219,23 +692,21 @@ std::vector<Memory> MemoryManager::queryRelevantMemories(
         }
     }
 
-    // Trier par score décroissant
-    std::sort(scored_indices.begin(), scored_indices.end(),
-              [](const auto& a, const auto& b) { return a.first > b.first; });
-
-    // Collecter les résultats
+    // Trier par score décroissant (seuls les max_count premiers importent)
     size_t count = std::min(max_count, scored_indices.size());
-    result.reserve(count);
+    std::partial_sort(scored_indices.begin(), scored_indices.begin() + static_cast<std::ptrdiff_t>(count),
+                      scored_indices.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
 
+    // Collecter les références (contenu partagé, pas de copie)
+    result.reserve(count);
     for (size_t i = 0; i < count; ++i) {
-        result.push_back(memories_[scored_indices[i].second]);
+        result.push_back(makeRefLocked(scored_indices[i].second, clock, trauma_clock));
     }
-
-    return result;
 }
 
 std::array<double, NUM_EMOTIONS> MemoryManager::computeMemoryInfluences(
-    const std::vector<Memory>& memories,
+    std::span<const MemoryRef> memories,
     double delta_coeff) const 
 {
     std::array<double, NUM_EMOTIONS> influences{};
@@ -250,7 +721,7 @@ std::array<double, NUM_EMOTIONS> MemoryManager::computeMemoryInfluences(
         double weight = mem.weight * mem.activation * delta_coeff;
         
         for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-            influences[i] += mem.emotions[i] * weight;
+            influences[i] += mem->emotions[i] * weight;
         }
     }
 
@@ -266,16 +737,17 @@ std::array<double, NUM_EMOTIONS> MemoryManager::computeMemoryInfluences(
 Memory MemoryManager::recordMemory(
     const EmotionalState& state,
     Phase phase,
-    const std::string& context)
+    std::string_view context)
 {
     Memory mem;
     mem.name = context;
     mem.emotions = state.emotions;
 
-    auto [dominant_name, dominant_value] = state.getDominant();
+    const auto summary = state.summarize();
+    const std::string& dominant_name = summary.dominantName();
     mem.dominant = dominant_name;
-    mem.valence = state.getValence();
-    mem.intensity = state.getMeanIntensity();
+    mem.valence = summary.valence();
+    mem.intensity = summary.meanIntensity();
     mem.weight = computeInitialWeight(phase, mem.intensity, mem.valence);
     mem.activation = mem.intensity;
     mem.is_trauma = false;
@@ -283,31 +755,59 @@ Memory MemoryManager::recordMemory(
     mem.last_activated = std::chrono::system_clock::now();
     mem.activation_count = 1;
 
-    memories_.push_back(mem);
+    bool coalesced = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Trame quasi identique au souvenir chaud le plus proche : renforcer au lieu d'ajouter
+        for (const auto& hit : index_.topK(state.emotions, 4, tier_config_.coalesce_similarity)) {
+            HotSlot& slot = hot_[hit.row];
+            if (!slot.memory || slot.is_trauma || slot.memory->name != context) continue;
+
+            const double clock = decayClockLocked(false, mem.last_activated);
+            double current = std::exp(slot.rank - clock);
+            double reinforced = std::min(1.0, std::max(current, mem.weight) + tier_config_.reinforcement * mem.weight);
+            slot.rank = std::log(std::max(reinforced, MIN_WEIGHT_FLOOR)) + clock;
+            slot.activation_count++;
+            slot.last_activated = mem.last_activated;
+
+            mem = *slot.memory;
+            mem.weight = reinforced;
+            mem.activation_count = slot.activation_count;
+            mem.last_activated = slot.last_activated;
+            tier_stats_.coalesced++;
+            coalesced = true;
+            break;
+        }
 
-    // Synchroniser avec Neo4j si connecté
-    if (isNeo4jConnected()) {
-        neo4j_client_->createMemory(mem, context, [](const Neo4jResponse& resp) {
+        if (!coalesced) {
+            appendLocked(mem);
+        }
+    }
+
+    // Synchroniser avec Neo4j si connecté (un renforcement reste local : le nœud existe déjà)
+    if (!coalesced && isNeo4jConnected()) {
+        neo4j_client_->createMemory(mem, mem.name, [](const Neo4jResponse& resp) {
             if (resp.success) {
-                std::cout << "[MemoryManager] Souvenir synchronisé vers Neo4j\n";
+                MCEE_LOG_DEBUG("MemoryManager", "Souvenir synchronisé vers Neo4j");
             }
         });
     }
 
-    std::cout << "[MemoryManager] Souvenir enregistré: \"" << context
-              << "\" (phase=" << phaseToString(phase)
-              << ", dominant=" << dominant_name
-              << ", poids=" << std::fixed << std::setprecision(2) << mem.weight << ")\n";
+    MCEE_LOG_DEBUG("MemoryManager",
+        coalesced ? "Souvenir renforcé: \"" : "Souvenir enregistré: \"", context, "\" (phase=", phaseToString(phase), ", dominant=",
+        dominant_name, ", poids=", std::fixed, std::setprecision(2), mem.weight, ")");
 
     return mem;
 }
 
 std::optional<Memory> MemoryManager::createPotentialTrauma(const EmotionalState& state) {
     // Vérifier les critères de trauma
-    double peur = state.getEmotion("Peur");
-    double horreur = state.getEmotion("Horreur");
-    double intensity = state.getMeanIntensity();
-    double valence = state.getValence();
+    double peur = state.emotions[EMO_PEUR];
+    double horreur = state.emotions[EMO_HORREUR];
+    const auto summary = state.summarize();
+    double intensity = summary.meanIntensity();
+    double valence = summary.valence();
 
     // Critères: intensité > 0.85 ET valence < 0.2
     if (intensity > 0.85 && valence < 0.2) {
@@ -315,8 +815,7 @@ std::optional<Memory> MemoryManager::createPotentialTrauma(const EmotionalState&
         trauma.name = "Trauma_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
         trauma.emotions = state.emotions;
 
-        auto [dominant_name, dominant_value] = state.getDominant();
-        trauma.dominant = dominant_name;
+        trauma.dominant = summary.dominantName();
         trauma.valence = valence;
         trauma.intensity = intensity;
         trauma.weight = std::min(1.0, 0.7 + intensity * 0.3);  // Poids élevé
@@ -326,20 +825,23 @@ std::optional<Memory> MemoryManager::createPotentialTrauma(const EmotionalState&
         trauma.last_activated = std::chrono::system_clock::now();
         trauma.activation_count = 1;
 
-        memories_.push_back(trauma);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            appendLocked(trauma);
+        }
 
         // Synchroniser le trauma avec Neo4j si connecté
         if (isNeo4jConnected()) {
             std::vector<std::string> triggers = {trauma.dominant};
             neo4j_client_->createTrauma(trauma, triggers, [](const Neo4jResponse& resp) {
                 if (resp.success) {
-                    std::cout << "[MemoryManager] Trauma synchronisé vers Neo4j\n";
+                    MCEE_LOG_DEBUG("MemoryManager", "Trauma synchronisé vers Neo4j");
                 }
             });
         }
 
-        std::cout << "[MemoryManager] TRAUMA créé (intensité="
-                  << std::fixed << std::setprecision(3) << intensity << ")\n";
+        MCEE_LOG_WARN("MemoryManager",
+            "TRAUMA créé (intensité=", std::fixed, std::setprecision(3), intensity, ")");
 
         return trauma;
     }
@@ -351,9 +853,9 @@ double MemoryManager::updateActivation(Memory& memory, const EmotionalState& cur
     // Formule d'activation:
     // A(Si) = forget(Si,t) × (1 + R(Si)) × Match(Si, E_current)
     
-    double forget_factor = computeForgetFactor(memory);
+    double forget_factor = computeForgetFactor(memory.last_activated, memory.is_trauma);
     double reinforcement = memory.is_trauma ? 1.5 : 1.0;  // Traumas renforcés
-    double match = computeEmotionalMatch(current_state, memory);
+    double match = computeEmotionalMatch(current_state, memory.emotions);
 
     memory.activation = forget_factor * reinforcement * match;
     memory.activation = std::clamp(memory.activation, 0.0, 1.0);
@@ -366,6 +868,22 @@ double MemoryManager::updateActivation(Memory& memory, const EmotionalState& cur
     return memory.activation;
 }
 
+double MemoryManager::updateActivation(MemoryRef& memory, const EmotionalState& current_state) {
+    // Même formule, portée par la référence : le contenu partagé reste immuable
+    double forget_factor = computeForgetFactor(memory.last_activated, memory->is_trauma);
+    double reinforcement = memory->is_trauma ? 1.5 : 1.0;
+    double match = computeEmotionalMatch(current_state, memory->emotions);
+
+    memory.activation = std::clamp(forget_factor * reinforcement * match, 0.0, 1.0);
+
+    if (memory.activation > 0.3) {
+        memory.activation_count++;
+        memory.last_activated = std::chrono::system_clock::now();
+    }
+
+    return memory.activation;
+}
+
 std::string MemoryManager::shouldConsolidate(
     const Memory& memory,
     Phase phase_at_creation) const 
@@ -401,24 +919,23 @@ std::string MemoryManager::shouldConsolidate(
 }
 
 size_t MemoryManager::getTraumaCount() const {
-    return std::count_if(memories_.begin(), memories_.end(),
-                         [](const Memory& m) { return m.is_trauma; });
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = std::count_if(hot_.begin(), hot_.end(),
+                                 [](const HotSlot& s) { return s.memory && s.is_trauma; });
+    count += std::count_if(warm_.begin(), warm_.end(),
+                           [](const WarmMemory& w) { return w.used && w.is_trauma; });
+    return count;
 }
 
 void MemoryManager::applyForget(double decay_factor) {
-    for (auto& mem : memories_) {
-        // Les traumas ont un taux d'oubli réduit
-        double effective_decay = mem.is_trauma ? decay_factor * 0.1 : decay_factor;
-        mem.weight *= (1.0 - effective_decay);
+    {
+        // Oubli cumulé, appliqué à la lecture (les traumas ont un taux d'oubli réduit)
+        std::lock_guard<std::mutex> lock(mutex_);
+        double decay = std::clamp(decay_factor, 0.0, 1.0);
+        forget_log_ += std::log(std::max(1.0 - decay, MIN_WEIGHT_FLOOR));
+        trauma_forget_log_ += std::log(std::max(1.0 - decay * TRAUMA_DECAY_RATIO, MIN_WEIGHT_FLOOR));
     }
 
-    // Supprimer les souvenirs avec poids trop faible (sauf traumas)
-    memories_.erase(
-        std::remove_if(memories_.begin(), memories_.end(),
-                       [](const Memory& m) { return !m.is_trauma && m.weight < 0.01; }),
-        memories_.end()
-    );
-
     // Appliquer le decay dans Neo4j si connecté (async)
     if (isNeo4jConnected()) {
         // Convertir decay_factor en heures approximatives
@@ -429,7 +946,7 @@ void MemoryManager::applyForget(double decay_factor) {
 
 double MemoryManager::computeEmotionalMatch(
     const EmotionalState& state,
-    const Memory& memory) const 
+    const std::array<double, NUM_EMOTIONS>& emotions) const 
 {
     // Similarité cosinus entre vecteurs d'émotions
     double dot_product = 0.0;
@@ -437,9 +954,9 @@ double MemoryManager::computeEmotionalMatch(
     double norm_mem = 0.0;
 
     for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
-        dot_product += state.emotions[i] * memory.emotions[i];
+        dot_product += state.emotions[i] * emotions[i];
         norm_state += state.emotions[i] * state.emotions[i];
-        norm_mem += memory.emotions[i] * memory.emotions[i];
+        norm_mem += emotions[i] * emotions[i];
     }
 
     norm_state = std::sqrt(norm_state);
@@ -452,10 +969,13 @@ double MemoryManager::computeEmotionalMatch(
     return dot_product / (norm_state * norm_mem);
 }
 
-double MemoryManager::computeForgetFactor(const Memory& memory) const {
+double MemoryManager::computeForgetFactor(
+    std::chrono::system_clock::time_point last_activated,
+    bool is_trauma) const
+{
     auto now = std::chrono::system_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::hours>(
-        now - memory.last_activated
+        now - last_activated
     ).count();
 
     // Décroissance exponentielle avec demi-vie de 720 heures (30 jours)
@@ -463,7 +983,7 @@ double MemoryManager::computeForgetFactor(const Memory& memory) const {
     double forget = std::exp(-0.693 * duration / half_life);
 
     // Les traumas résistent à l'oubli
-    if (memory.is_trauma) {
+    if (is_trauma) {
         forget = std::max(forget, 0.5);
     }
 
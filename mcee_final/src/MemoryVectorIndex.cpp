@@ -0,0 +1,102 @@
+/**
+ * @file MemoryVectorIndex.cpp
+ * @brief Implémentation de l'index vectoriel local des souvenirs
+ * @version 1.0
+ * @date 2025-12-21
+ */
+
+#include "MemoryVectorIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace mcee {
+
+void MemoryVectorIndex::normalizeInto(const std::array<double, NUM_EMOTIONS>& in, float* out) {
+    double norm = 0.0;
+    for (size_t i = 0; i < DIM; ++i) {
+        norm += in[i] * in[i];
+    }
+    norm = std::sqrt(norm);
+
+    // Même convention que MemoryManager::computeEmotionalMatch : norme nulle → similarité 0
+    double inv = norm < 1e-6 ? 0.0 : 1.0 / norm;
+    for (size_t i = 0; i < DIM; ++i) {
+        out[i] = static_cast<float>(in[i] * inv);
+    }
+}
+
+size_t MemoryVectorIndex::add(const std::array<double, NUM_EMOTIONS>& emotions) {
+    size_t row = size();
+    vectors_.resize(vectors_.size() + DIM);
+    normalizeInto(emotions, vectors_.data() + row * DIM);
+    return row;
+}
+
+void MemoryVectorIndex::set(size_t row, const std::array<double, NUM_EMOTIONS>& emotions) {
+    if (row >= size()) return;
+    normalizeInto(emotions, vectors_.data() + row * DIM);
+}
+
+void MemoryVectorIndex::rebuild(const std::vector<Memory>& memories) {
+    vectors_.resize(memories.size() * DIM);
+    for (size_t row = 0; row < memories.size(); ++row) {
+        normalizeInto(memories[row].emotions, vectors_.data() + row * DIM);
+    }
+}
+
+void MemoryVectorIndex::cosineAll(
+    const std::array<double, NUM_EMOTIONS>& query,
+    std::vector<float>& out) const
+{
+    const size_t rows = size();
+    out.resize(rows);
+
+    alignas(32) float q[DIM];
+    normalizeInto(query, q);
+
+    const float* data = vectors_.data();
+    for (size_t row = 0; row < rows; ++row) {
+        const float* v = data + row * DIM;
+        float dot = 0.0f;
+        // Longueur fixe : boucle déroulée et vectorisée par le compilateur
+        for (size_t i = 0; i < DIM; ++i) {
+            dot += q[i] * v[i];
+        }
+        out[row] = dot;
+    }
+}
+
+std::vector<IndexHit> MemoryVectorIndex::topK(
+    const std::array<double, NUM_EMOTIONS>& query,
+    size_t k,
+    double threshold) const
+{
+    std::vector<IndexHit> hits;
+    if (k == 0 || empty()) {
+        return hits;
+    }
+
+    std::vector<float> scores;
+    cosineAll(query, scores);
+
+    for (size_t row = 0; row < scores.size(); ++row) {
+        if (scores[row] >= threshold) {
+            hits.push_back(IndexHit{row, static_cast<double>(scores[row])});
+        }
+    }
+
+    auto by_similarity = [](const IndexHit& a, const IndexHit& b) {
+        return a.similarity > b.similarity;
+    };
+
+    if (hits.size() > k) {
+        std::partial_sort(hits.begin(), hits.begin() + k, hits.end(), by_similarity);
+        hits.resize(k);
+    } else {
+        std::sort(hits.begin(), hits.end(), by_similarity);
+    }
+
+    return hits;
+}
+
+} // namespace mcee
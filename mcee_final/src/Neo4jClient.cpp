@@ -1,22 +1,28 @@
 /**
  * @file Neo4jClient.cpp
- * @brief Implémentation du client Neo4j via RabbitMQ
+ * @brief Implémentation du client Neo4j (RabbitMQ, Bolt natif)
  * @version 1.0
  * @date 2025-12-21
  */
 
 #include "Neo4jClient.hpp"
-#include <iostream>
+#include "Logger.hpp"
 #include <iomanip>
 #include <sstream>
 #include <chrono>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
 
 namespace mcee {
 
 Neo4jClient::Neo4jClient(const Neo4jClientConfig& config)
     : config_(config) {
-    std::cout << "[Neo4jClient] Client initialisé (host=" << config_.rabbitmq_host
-              << ", queue=" << config_.request_queue << ")\n";
+    const bool bolt = config_.transport == Neo4jTransport::BOLT;
+    MCEE_LOG_INFO("Neo4jClient",
+        "Client initialisé (transport=", bolt ? "bolt" : "rabbitmq",
+        ", host=", bolt ? config_.bolt.host : config_.rabbitmq_host,
+        ", queue=", config_.request_queue, ")");
 }
 
 Neo4jClient::~Neo4jClient() {
@@ -28,6 +34,50 @@ bool Neo4jClient::connect() {
         return true;
     }
 
+    running_.store(true);
+
+    const bool want_bolt = config_.transport == Neo4jTransport::BOLT;
+    const bool bolt_ok = want_bolt && connectBolt();
+    const bool bridge_ok = (!want_bolt || config_.bolt_fallback_rabbitmq) && connectBridge();
+
+    if (!bolt_ok && !bridge_ok) {
+        running_.store(false);
+        return false;
+    }
+
+    connected_.store(true);
+
+    if (config_.enable_write_batching) {
+        batch_source_ = CancellationSource();
+        flush_lane_.open();
+        batch_timer_ = Executor::shared()->schedulePeriodic(
+            std::chrono::milliseconds(std::max(1, config_.batch_flush_interval_ms)),
+            TaskClass::PIPELINE, [this]() { flush(false); }, batch_source_.token());
+    }
+    return true;
+}
+
+bool Neo4jClient::connectBolt() {
+    try {
+        auto pool = std::make_unique<bolt::Pool>(config_.bolt);
+        {
+            // Connexion de test : rendue au pool pour le premier appelant
+            auto lease = pool->acquire(std::chrono::milliseconds(config_.bolt.connect_timeout_ms));
+            MCEE_LOG_INFO("Neo4jClient", "Connecté en Bolt ", static_cast<int>(lease->majorVersion()),
+                          ".", static_cast<int>(lease->minorVersion()),
+                          " (", config_.bolt.host, ":", config_.bolt.port, ")");
+        }
+        bolt_pool_ = std::move(pool);
+        return true;
+
+    } catch (const bolt::BoltError& e) {
+        MCEE_LOG_WARN("Neo4jClient", "Bolt indisponible: ", e.what(),
+                      config_.bolt_fallback_rabbitmq ? " (repli sur RabbitMQ)" : "");
+        return false;
+    }
+}
+
+bool Neo4jClient::connectBridge() {
     try {
         // Créer le canal RabbitMQ avec Channel::Open (méthode recommandée)
         AmqpClient::Channel::OpenOpts opts;
@@ -41,10 +91,15 @@ bool Neo4jClient::connect() {
         // Timeout de connexion court pour ne pas bloquer en mode démo
         opts.frame_max = 131072;
 
+        // Deux canaux : le thread de réponses consomme sur channel_ pendant que
+        // les appelants publient sur publish_channel_ (un Channel n'est pas thread-safe)
         channel_ = AmqpClient::Channel::Open(opts);
+        publish_channel_ = AmqpClient::Channel::Open(opts);
 
-        if (!channel_) {
-            std::cerr << "[Neo4jClient] Échec création du canal RabbitMQ\n";
+        if (!channel_ || !publish_channel_) {
+            MCEE_LOG_ERROR("Neo4jClient", "Échec création du canal RabbitMQ");
+            channel_.reset();
+            publish_channel_.reset();
             return false;
         }
 
@@ -58,20 +113,23 @@ bool Neo4jClient::connect() {
         response_queue_ = channel_->DeclareQueue("");
         channel_->BindQueue(response_queue_, config_.response_exchange, response_queue_);
 
-        // Démarrer le consommateur de réponses
-        consumer_tag_ = channel_->BasicConsume(response_queue_, "", true, false);
+        // Démarrer le consommateur de réponses (acquittement manuel, prefetch large
+        // pour que de nombreuses requêtes puissent être en vol simultanément)
+        consumer_tag_ = channel_->BasicConsume(response_queue_, "", true, false, true,
+                                               config_.response_prefetch);
 
-        connected_.store(true);
-        running_.store(true);
+        bridge_connected_.store(true);
 
         // Lancer le thread de consommation des réponses
         response_thread_ = std::thread(&Neo4jClient::responseConsumerLoop, this);
 
-        std::cout << "[Neo4jClient] Connecté à RabbitMQ (response_queue=" << response_queue_ << ")\n";
+        MCEE_LOG_INFO("Neo4jClient", "Connecté à RabbitMQ (response_queue=", response_queue_, ")");
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << "[Neo4jClient] Erreur connexion: " << e.what() << "\n";
+        MCEE_LOG_ERROR("Neo4jClient", "Erreur connexion: ", e.what());
+        channel_.reset();
+        publish_channel_.reset();
         return false;
     }
 }
@@ -81,17 +139,28 @@ void Neo4jClient::disconnect() {
         return;
     }
 
+    // Publier les mutations encore en tampon avant de couper
+    flush(false);
+
     running_.store(false);
     connected_.store(false);
+    bridge_connected_.store(false);
 
-    // Réveiller les threads en attente
-    sync_cv_.notify_all();
+    // Arrêter la minuterie et attendre les flush en cours
+    batch_source_.cancel();
+    if (batch_timer_.valid()) {
+        batch_timer_.wait();
+    }
+    flush_lane_.close();
 
     // Attendre le thread de réponse
     if (response_thread_.joinable()) {
         response_thread_.join();
     }
 
+    // Débloquer les appelants encore en attente
+    failPending("Disconnected");
+
     try {
         if (channel_) {
             channel_->BasicCancel(consumer_tag_);
@@ -99,7 +168,15 @@ void Neo4jClient::disconnect() {
     } catch (...) {}
 
     channel_.reset();
-    std::cout << "[Neo4jClient] Déconnecté\n";
+    {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        publish_channel_.reset();
+    }
+    if (bolt_pool_) {
+        bolt_pool_->close();
+        bolt_pool_.reset();
+    }
+    MCEE_LOG_INFO("Neo4jClient", "Déconnecté");
 }
 
 std::string Neo4jClient::generateRequestId() {
@@ -114,13 +191,13 @@ std::string Neo4jClient::generateRequestId() {
     return oss.str();
 }
 
-std::string Neo4jClient::sendRequest(
+std::string Neo4jClient::submit(
     const std::string& request_type,
     const json& payload,
-    Neo4jCallback callback)
+    PendingRequest pending)
 {
-    if (!connected_.load()) {
-        std::cerr << "[Neo4jClient] Non connecté, requête ignorée\n";
+    if (!bridge_connected_.load()) {
+        MCEE_LOG_WARN("Neo4jClient", "Pont RabbitMQ non connecté, requête ignorée");
         return "";
     }
 
@@ -134,58 +211,106 @@ std::string Neo4jClient::sendRequest(
         {"timestamp", std::chrono::system_clock::now().time_since_epoch().count()}
     };
 
-    std::string body = request.dump();
+    const bool tracked = pending.callback || pending.promise;
 
     try {
-        // Enregistrer le callback si fourni
-        if (callback) {
-            std::lock_guard<std::mutex> lock(callbacks_mutex_);
-            pending_callbacks_[request_id] = callback;
+        // Enregistrer avant publication : la réponse peut arriver avant le retour
+        if (tracked) {
+            pending.sent_at = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_[request_id] = std::move(pending);
         }
 
         // Publier la requête
-        AmqpClient::BasicMessage::ptr_t message = AmqpClient::BasicMessage::Create(body);
+        AmqpClient::BasicMessage::ptr_t message = AmqpClient::BasicMessage::Create(request.dump());
         message->ContentType("application/json");
         message->ReplyTo(response_queue_);
         message->CorrelationId(request_id);
 
-        channel_->BasicPublish("", config_.request_queue, message);
+        {
+            std::lock_guard<std::mutex> lock(publish_mutex_);
+            if (!publish_channel_) {
+                throw std::runtime_error("canal de publication fermé");
+            }
+            publish_channel_->BasicPublish("", config_.request_queue, message);
+        }
 
         return request_id;
 
     } catch (const std::exception& e) {
-        std::cerr << "[Neo4jClient] Erreur envoi requête: " << e.what() << "\n";
+        MCEE_LOG_ERROR("Neo4jClient", "Erreur envoi requête: ", e.what());
 
-        // Retirer le callback en cas d'erreur
-        if (callback) {
-            std::lock_guard<std::mutex> lock(callbacks_mutex_);
-            pending_callbacks_.erase(request_id);
+        // Retirer la requête en vol en cas d'erreur
+        if (tracked) {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_.erase(request_id);
         }
         return "";
     }
 }
 
-Neo4jResponse Neo4jClient::waitForResponse(const std::string& request_id) {
-    std::unique_lock<std::mutex> lock(sync_mutex_);
+std::string Neo4jClient::sendRequest(
+    const std::string& request_type,
+    const json& payload,
+    Neo4jCallback callback)
+{
+    return submit(request_type, payload, PendingRequest{std::move(callback), nullptr});
+}
 
-    // Attendre la réponse avec timeout
-    auto deadline = std::chrono::steady_clock::now() +
-                    std::chrono::milliseconds(config_.request_timeout_ms);
+std::future<Neo4jResponse> Neo4jClient::sendRequestAwaitable(
+    const std::string& request_type,
+    const json& payload,
+    std::string& request_id)
+{
+    auto promise = std::make_shared<std::promise<Neo4jResponse>>();
+    auto future = promise->get_future();
 
-    while (running_.load()) {
-        auto it = sync_responses_.find(request_id);
-        if (it != sync_responses_.end()) {
-            Neo4jResponse response = std::move(it->second);
-            sync_responses_.erase(it);
-            return response;
-        }
+    request_id = submit(request_type, payload, PendingRequest{nullptr, promise});
+    if (request_id.empty()) {
+        promise->set_value(Neo4jResponse{"", false, {}, "Send failed", 0});
+    }
+    return future;
+}
 
-        if (sync_cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
-            return Neo4jResponse{request_id, false, {}, "Timeout", 0};
-        }
+Neo4jResponse Neo4jClient::waitForResponse(
+    const std::string& request_id,
+    std::future<Neo4jResponse>& future,
+    int timeout_ms)
+{
+    if (!future.valid()) {
+        return Neo4jResponse{request_id, false, {}, "Invalid request", 0};
     }
 
-    return Neo4jResponse{request_id, false, {}, "Disconnected", 0};
+    if (timeout_ms < 0) {
+        timeout_ms = config_.request_timeout_ms;
+    }
+
+    if (future.wait_for(std::chrono::milliseconds(timeout_ms)) != std::future_status::ready) {
+        // Oublier la requête : une réponse tardive sera simplement ignorée
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        pending_.erase(request_id);
+        return Neo4jResponse{request_id, false, {}, "Timeout", 0};
+    }
+
+    return future.get();
+}
+
+void Neo4jClient::failPending(const std::string& error) {
+    std::unordered_map<std::string, PendingRequest> orphans;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        orphans.swap(pending_);
+    }
+
+    for (auto& [request_id, pending] : orphans) {
+        Neo4jResponse response{request_id, false, {}, error, 0};
+        if (pending.callback) {
+            pending.callback(response);
+        }
+        if (pending.promise) {
+            pending.promise->set_value(std::move(response));
+        }
+    }
 }
 
 void Neo4jClient::responseConsumerLoop() {
@@ -194,68 +319,557 @@ void Neo4jClient::responseConsumerLoop() {
             AmqpClient::Envelope::ptr_t envelope;
 
             // Consommer avec timeout
-            if (channel_->BasicConsumeMessage(consumer_tag_, envelope, 100)) {
-                std::string body = envelope->Message()->Body();
-                json response_json = json::parse(body);
-
-                Neo4jResponse response;
-                // Gérer les valeurs null en vérifiant is_null() avant extraction
-                auto get_string = [&](const std::string& key, const std::string& def) -> std::string {
-                    if (response_json.contains(key) && !response_json[key].is_null()) {
-                        return response_json[key].get<std::string>();
-                    }
-                    return def;
-                };
-                auto get_bool = [&](const std::string& key, bool def) -> bool {
-                    if (response_json.contains(key) && !response_json[key].is_null()) {
-                        return response_json[key].get<bool>();
-                    }
-                    return def;
-                };
-                auto get_double = [&](const std::string& key, double def) -> double {
-                    if (response_json.contains(key) && !response_json[key].is_null()) {
-                        return response_json[key].get<double>();
-                    }
-                    return def;
-                };
-
-                response.request_id = get_string("request_id", "");
-                response.success = get_bool("success", false);
-                response.data = response_json.contains("data") && !response_json["data"].is_null()
-                                ? response_json["data"] : json{};
-                response.error = get_string("error", "");
-                response.execution_time_ms = get_double("execution_time_ms", 0.0);
-
-                // Vérifier si un callback attend cette réponse
-                {
-                    std::lock_guard<std::mutex> lock(callbacks_mutex_);
-                    auto it = pending_callbacks_.find(response.request_id);
-                    if (it != pending_callbacks_.end()) {
-                        // Appeler le callback
-                        it->second(response);
-                        pending_callbacks_.erase(it);
-                        continue;
-                    }
-                }
+            if (!channel_->BasicConsumeMessage(consumer_tag_, envelope, 100)) {
+                continue;
+            }
 
-                // Sinon, stocker pour une attente synchrone
-                {
-                    std::lock_guard<std::mutex> lock(sync_mutex_);
-                    sync_responses_[response.request_id] = response;
+            // Acquitter d'abord : une réponse mal formée ne doit pas bloquer le prefetch
+            channel_->BasicAck(envelope);
+
+            std::string body = envelope->Message()->Body();
+            json response_json = json::parse(body);
+
+            Neo4jResponse response;
+            // Gérer les valeurs null en vérifiant is_null() avant extraction
+            auto get_string = [&](const std::string& key, const std::string& def) -> std::string {
+                if (response_json.contains(key) && !response_json[key].is_null()) {
+                    return response_json[key].get<std::string>();
+                }
+                return def;
+            };
+            auto get_bool = [&](const std::string& key, bool def) -> bool {
+                if (response_json.contains(key) && !response_json[key].is_null()) {
+                    return response_json[key].get<bool>();
+                }
+                return def;
+            };
+            auto get_double = [&](const std::string& key, double def) -> double {
+                if (response_json.contains(key) && !response_json[key].is_null()) {
+                    return response_json[key].get<double>();
                 }
-                sync_cv_.notify_all();
+                return def;
+            };
+
+            response.request_id = get_string("request_id", "");
+            response.success = get_bool("success", false);
+            response.data = response_json.contains("data") && !response_json["data"].is_null()
+                            ? response_json["data"] : json{};
+            response.error = get_string("error", "");
+            response.execution_time_ms = get_double("execution_time_ms", 0.0);
+
+            // Retrouver la requête en vol correspondante
+            PendingRequest pending;
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                auto it = pending_.find(response.request_id);
+                if (it == pending_.end()) {
+                    continue;  // Requête fire-and-forget ou expirée
+                }
+                pending = std::move(it->second);
+                pending_.erase(it);
+            }
+            round_trip_latency_.recordSince(pending.sent_at);
 
-                channel_->BasicAck(envelope);
+            // Résoudre hors verrou : un callback peut émettre une nouvelle requête
+            if (pending.callback) {
+                pending.callback(response);
+            }
+            if (pending.promise) {
+                pending.promise->set_value(std::move(response));
             }
 
         } catch (const std::exception& e) {
             if (running_.load()) {
-                std::cerr << "[Neo4jClient] Erreur consommation: " << e.what() << "\n";
+                MCEE_LOG_ERROR("Neo4jClient", "Erreur consommation: ", e.what());
             }
         }
     }
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// BATCHING
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::string Neo4jClient::enqueueWrite(
+    const std::string& request_type,
+    const json& payload,
+    Neo4jCallback callback)
+{
+    if (!config_.enable_write_batching) {
+        if (isNative(request_type, payload)) {
+            std::vector<BufferedWrite> ops;
+            ops.push_back(BufferedWrite{generateRequestId(), request_type, payload, std::move(callback)});
+            std::string request_id = ops.front().request_id;
+            if (runNativeWrites(ops)) {
+                return request_id;
+            }
+            callback = std::move(ops.front().callback);
+        }
+        return sendRequest(request_type, payload, std::move(callback));
+    }
+
+    if (!connected_.load()) {
+        MCEE_LOG_WARN("Neo4jClient", "Non connecté, requête ignorée");
+        return "";
+    }
+
+    std::string request_id = generateRequestId();
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        write_buffer_.push_back(BufferedWrite{request_id, request_type, payload, std::move(callback)});
+        full = write_buffer_.size() >= config_.batch_max_size;
+    }
+
+    if (full) {
+        scheduleFlush();
+    }
+    return request_id;
+}
+
+std::future<Neo4jResponse> Neo4jClient::sendBatch(
+    std::vector<BufferedWrite> ops,
+    std::string& request_id)
+{
+    json operations = json::array();
+    auto callbacks = std::make_shared<std::unordered_map<std::string, Neo4jCallback>>();
+
+    for (auto& op : ops) {
+        operations.push_back({
+            {"request_id", op.request_id},
+            {"request_type", op.request_type},
+            {"payload", std::move(op.payload)}
+        });
+        if (op.callback) {
+            (*callbacks)[op.request_id] = std::move(op.callback);
+        }
+    }
+
+    // Redistribue les résultats du lot vers les callbacks de chaque mutation
+    Neo4jCallback dispatch = nullptr;
+    if (!callbacks->empty()) {
+        dispatch = [callbacks](const Neo4jResponse& batch) {
+            if (batch.success && batch.data.contains("results") && batch.data["results"].is_array()) {
+                for (const auto& r : batch.data["results"]) {
+                    std::string id = r.value("request_id", "");
+                    auto it = callbacks->find(id);
+                    if (it == callbacks->end()) continue;
+
+                    Neo4jResponse op_response;
+                    op_response.request_id = id;
+                    op_response.success = r.value("success", false);
+                    op_response.data = r.contains("data") && !r["data"].is_null() ? r["data"] : json{};
+                    op_response.error = r.contains("error") && r["error"].is_string()
+                                        ? r["error"].get<std::string>() : "";
+                    it->second(op_response);
+                    callbacks->erase(it);
+                }
+            }
+
+            // Mutations sans résultat (lot en échec ou réponse incomplète)
+            for (auto& [id, cb] : *callbacks) {
+                cb(Neo4jResponse{id, false, {}, batch.error.empty() ? "Missing batch result" : batch.error, 0});
+            }
+            callbacks->clear();
+        };
+    }
+
+    auto promise = std::make_shared<std::promise<Neo4jResponse>>();
+    auto future = promise->get_future();
+
+    request_id = submit("batch", json{{"operations", std::move(operations)}},
+                        PendingRequest{dispatch, promise});
+    if (request_id.empty()) {
+        Neo4jResponse failed{"", false, {}, "Send failed", 0};
+        if (dispatch) dispatch(failed);
+        promise->set_value(std::move(failed));
+    }
+    return future;
+}
+
+bool Neo4jClient::flush(bool wait) {
+    std::vector<BufferedWrite> ops;
+    {
+        std::lock_guard<std::mutex> lock(batch_mutex_);
+        ops.swap(write_buffer_);
+    }
+
+    if (ops.empty()) {
+        return true;
+    }
+
+    if (!bolt_pool_) {
+        return publishBatches(std::move(ops), wait);
+    }
+
+    // Segments consécutifs de même transport, traités dans l'ordre du tampon :
+    // un segment du pont est confirmé avant le segment Bolt qui le suit
+    bool ok = true;
+    size_t begin = 0;
+    while (begin < ops.size()) {
+        const bool native = isNative(ops[begin].request_type, ops[begin].payload);
+        size_t end = begin + 1;
+        while (end < ops.size() && isNative(ops[end].request_type, ops[end].payload) == native) {
+            ++end;
+        }
+
+        std::vector<BufferedWrite> segment(std::make_move_iterator(ops.begin() + begin),
+                                           std::make_move_iterator(ops.begin() + end));
+        if (!native || !runNativeWrites(segment)) {
+            ok = publishBatches(std::move(segment), wait || end < ops.size()) && ok;
+        }
+        begin = end;
+    }
+    return ok;
+}
+
+bool Neo4jClient::publishBatches(std::vector<BufferedWrite> ops, bool wait) {
+    // Découper en lots de batch_max_size, tous publiés avant toute attente
+    const size_t chunk = std::max<size_t>(1, config_.batch_max_size);
+    std::vector<std::pair<std::string, std::future<Neo4jResponse>>> inflight;
+    bool published = true;
+
+    for (size_t begin = 0; begin < ops.size(); begin += chunk) {
+        size_t end = std::min(ops.size(), begin + chunk);
+        std::vector<BufferedWrite> part(std::make_move_iterator(ops.begin() + begin),
+                                        std::make_move_iterator(ops.begin() + end));
+        std::string request_id;
+        auto future = sendBatch(std::move(part), request_id);
+        published = published && !request_id.empty();
+        inflight.emplace_back(std::move(request_id), std::move(future));
+    }
+
+    if (!wait) {
+        return published;
+    }
+
+    bool ok = published;
+    for (auto& [request_id, future] : inflight) {
+        ok = waitForResponse(request_id, future, config_.batch_timeout_ms).success && ok;
+    }
+    return ok;
+}
+
+size_t Neo4jClient::pendingWrites() const {
+    std::lock_guard<std::mutex> lock(batch_mutex_);
+    return write_buffer_.size();
+}
+
+size_t Neo4jClient::inFlightRequests() const {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    return pending_.size();
+}
+
+void Neo4jClient::scheduleFlush() {
+    if (flush_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    bool posted = flush_lane_.post([this]() {
+        // Relâché avant le flush : un tampon de nouveau plein pendant
+        // l'envoi soumet le flush suivant
+        flush_scheduled_.store(false, std::memory_order_release);
+        if (running_.load()) {
+            flush(false);
+        }
+    });
+    if (!posted) {
+        flush_scheduled_.store(false, std::memory_order_release);
+    }
+}
+
+size_t Neo4jClient::createMemoriesBatch(
+    const std::vector<Memory>& memories,
+    const std::string& context)
+{
+    if (memories.empty() || !connected_.load()) {
+        return 0;
+    }
+
+    const size_t chunk = std::max<size_t>(1, config_.batch_max_size);
+    std::vector<std::pair<std::string, std::future<Neo4jResponse>>> inflight;
+
+    for (size_t begin = 0; begin < memories.size(); begin += chunk) {
+        size_t end = std::min(memories.size(), begin + chunk);
+        std::vector<BufferedWrite> ops;
+        ops.reserve(end - begin);
+
+        for (size_t i = begin; i < end; ++i) {
+            const Memory& mem = memories[i];
+            json payload = memoryToJson(mem);
+            if (mem.is_trauma) {
+                payload["trigger_keywords"] = json::array();
+                ops.push_back({generateRequestId(), "create_trauma", std::move(payload), nullptr});
+            } else {
+                payload["context"] = context;
+                ops.push_back({generateRequestId(), "create_memory", std::move(payload), nullptr});
+            }
+        }
+
+        std::string request_id;
+        auto future = sendBatch(std::move(ops), request_id);
+        inflight.emplace_back(std::move(request_id), std::move(future));
+    }
+
+    size_t created = 0;
+    for (auto& [request_id, future] : inflight) {
+        Neo4jResponse response = waitForResponse(request_id, future, config_.batch_timeout_ms);
+        if (!response.success) {
+            MCEE_LOG_ERROR("Neo4jClient", "Erreur lot de création: ", response.error);
+            continue;
+        }
+        if (response.data.contains("results") && response.data["results"].is_array()) {
+            for (const auto& r : response.data["results"]) {
+                if (r.value("success", false)) created++;
+            }
+        }
+    }
+
+    MCEE_LOG_INFO("Neo4jClient",
+        "Lot de création: ", created, "/", memories.size(), " souvenirs en ", inflight.size(),
+        " message(s)");
+    return created;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TRANSPORT BOLT
+// ═══════════════════════════════════════════════════════════════════════════
+
+namespace {
+
+// Requêtes identiques à celles du service Python (neo4j/neo4j_service.py)
+const bolt::Statement CREATE_MEMORY_CYPHER{R"(
+    CREATE (m:Memory {
+        id: $id, type: $type, emotional_states: $emotional_states,
+        dominant: $dominant, intensity: $intensity, valence: $valence,
+        weight: $weight, context: $context, keywords: $keywords,
+        created_at: datetime(), last_activated: datetime(), activation_count: 1
+    })
+    RETURN m.id AS id)"};
+
+const bolt::Statement FIND_SIMILAR_CYPHER{R"(
+    MATCH (m:Memory)
+    WHERE m.intensity IS NOT NULL AND m.valence IS NOT NULL
+    WITH m,
+         1 - abs(m.intensity - $query_intensity) AS intensity_sim,
+         1 - abs(m.valence - $query_valence) AS valence_sim
+    WITH m, (intensity_sim + valence_sim) / 2 AS similarity
+    WHERE similarity >= $threshold
+    RETURN m.id AS id, m.dominant AS dominant, m.weight AS weight,
+           similarity, m.trauma AS trauma, m.emotional_states AS emotional_states
+    ORDER BY similarity DESC
+    LIMIT $limit)"};
+
+const bolt::Statement REACTIVATE_CYPHER{R"(
+    MATCH (m:Memory {id: $id})
+    WITH m, $strength AS strength, $boost AS boost
+    SET m.weight = CASE
+            WHEN m.weight + boost * strength * (1 - m.weight) > 1.0 THEN 1.0
+            ELSE m.weight + boost * strength * (1 - m.weight)
+        END,
+        m.activation_count = COALESCE(m.activation_count, 0) + 1,
+        m.last_activated = datetime()
+    RETURN m.id AS id, m.weight AS new_weight, m.activation_count AS activations,
+           m.emotional_states AS emotional_states)"};
+
+// Schéma de STRUCTURE_NEO4J.md : (:Pattern)-[:TRANSITION_TO]->(:Pattern)
+const bolt::Statement RECORD_TRANSITION_CYPHER{R"(
+    MERGE (a:Pattern {name: $from})
+    MERGE (b:Pattern {name: $to})
+    MERGE (a)-[t:TRANSITION_TO]->(b)
+    ON CREATE SET t.count = 0, t.total_duration_s = 0.0, t.contexts = []
+    SET t.count = t.count + 1,
+        t.total_duration_s = COALESCE(t.total_duration_s, 0.0) + $duration_s,
+        t.last_transition = datetime(),
+        t.contexts = CASE
+            WHEN $trigger = '' OR $trigger IN COALESCE(t.contexts, []) THEN t.contexts
+            ELSE COALESCE(t.contexts, []) + $trigger
+        END
+    WITH a, t
+    MATCH (a)-[out:TRANSITION_TO]->()
+    WITH t, sum(out.count) AS total
+    SET t.probability = toFloat(t.count) / total
+    RETURN t.count AS count, t.probability AS probability)"};
+
+/// emotional_states sérialisé comme serialize_emotional_states (Python)
+std::string emotionalStatesJson(const json& payload) {
+    if (payload.contains("emotional_states") && payload["emotional_states"].is_object()
+        && !payload["emotional_states"].empty()) {
+        return payload["emotional_states"].dump();
+    }
+    if (payload.contains("sentence_id") && !payload["sentence_id"].is_null()) {
+        const json& id = payload["sentence_id"];
+        const std::string key = id.is_string() ? id.get<std::string>() : id.dump();
+        return json{{key, payload.value("emotions", json::array())}}.dump();
+    }
+    return "{}";
+}
+
+/// Clés d'un emotional_states sérialisé (deserialize_emotional_states)
+json sentenceIds(const json& emotional_states, json* parsed = nullptr) {
+    json ids = json::array();
+    if (!emotional_states.is_string()) return ids;
+    json states = json::parse(emotional_states.get<std::string>(), nullptr, false);
+    if (!states.is_object()) return ids;
+    for (const auto& item : states.items()) ids.push_back(item.key());
+    if (parsed) *parsed = std::move(states);
+    return ids;
+}
+
+} // namespace
+
+bool Neo4jClient::isNative(const std::string& request_type, const json& payload) const {
+    if (!bolt_pool_) {
+        return false;
+    }
+    if (request_type == "create_memory") {
+        // Un contexte passe par l'extraction de relations du service Python
+        return payload.value("context", "").empty();
+    }
+    return request_type == "reactivate" || request_type == "record_transition";
+}
+
+bolt::Query Neo4jClient::nativeQuery(
+    const std::string& request_type,
+    const json& payload,
+    json& data) const
+{
+    bolt::Query query;
+    data = json::object();
+
+    if (request_type == "create_memory") {
+        query.statement = &CREATE_MEMORY_CYPHER;
+        query.params = {
+            {"id", payload.value("id", "")},
+            {"type", payload.value("type", "Episodic")},
+            {"emotional_states", emotionalStatesJson(payload)},
+            {"dominant", payload.value("dominant", "Neutre")},
+            {"intensity", payload.value("intensity", 0.0)},
+            {"valence", payload.value("valence", 0.5)},
+            {"weight", payload.value("weight", 0.5)},
+            {"context", payload.value("context", "")},
+            {"keywords", payload.value("keywords", json::array())}
+        };
+        query.on_record = [&data](const std::vector<std::string>&, std::vector<json>& values) {
+            data = {{"id", std::move(values[0])}};
+        };
+
+    } else if (request_type == "reactivate") {
+        query.statement = &REACTIVATE_CYPHER;
+        query.params = {
+            {"id", payload.value("id", "")},
+            {"strength", payload.value("strength", 1.0)},
+            {"boost", payload.value("boost_factor", 0.1)}
+        };
+        data = {{"error", "Memory not found"}};
+        query.on_record = [&data](const std::vector<std::string>&, std::vector<json>& values) {
+            json states = json::object();
+            json ids = sentenceIds(values[3], &states);
+            data = {
+                {"id", std::move(values[0])},
+                {"new_weight", std::move(values[1])},
+                {"activations", std::move(values[2])},
+                {"sentence_ids", std::move(ids)},
+                {"emotional_states", std::move(states)}
+            };
+        };
+
+    } else if (request_type == "record_transition") {
+        query.statement = &RECORD_TRANSITION_CYPHER;
+        query.params = {
+            {"from", payload.value("from", "")},
+            {"to", payload.value("to", "")},
+            {"duration_s", payload.value("duration_s", 0.0)},
+            {"trigger", payload.value("trigger", "")}
+        };
+        query.on_record = [&data](const std::vector<std::string>&, std::vector<json>& values) {
+            data = {{"count", std::move(values[0])}, {"probability", std::move(values[1])}};
+        };
+
+    } else {
+        throw std::invalid_argument("requête sans équivalent Bolt: " + request_type);
+    }
+    return query;
+}
+
+std::optional<bolt::QueryResult> Neo4jClient::runNative(const bolt::Query& query) {
+    bolt::Pool::Lease lease;
+    try {
+        lease = bolt_pool_->acquire(std::chrono::milliseconds(config_.request_timeout_ms));
+    } catch (const bolt::BoltError& e) {
+        MCEE_LOG_WARN("Neo4jClient", "Connexion Bolt indisponible: ", e.what());
+        return std::nullopt;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    bolt::QueryResult result;
+    try {
+        result = lease->run(query);
+    } catch (const bolt::BoltError& e) {
+        // Requête peut-être exécutée : pas de rejeu par le pont
+        result.error = std::string("Bolt: ") + e.what();
+    }
+    round_trip_latency_.recordSince(start);
+    return result;
+}
+
+bool Neo4jClient::runNativeWrites(std::vector<BufferedWrite>& ops) {
+    bolt::Pool::Lease lease;
+    try {
+        lease = bolt_pool_->acquire(std::chrono::milliseconds(config_.request_timeout_ms));
+    } catch (const bolt::BoltError& e) {
+        MCEE_LOG_WARN("Neo4jClient", "Connexion Bolt indisponible: ", e.what());
+        return false;
+    }
+
+    std::vector<json> data;
+    std::vector<bolt::Query> queries;
+    std::vector<BufferedWrite> retry;
+
+    while (!ops.empty()) {
+        data.assign(ops.size(), json{});
+        queries.clear();
+        queries.reserve(ops.size());
+        for (size_t i = 0; i < ops.size(); ++i) {
+            queries.push_back(nativeQuery(ops[i].request_type, ops[i].payload, data[i]));
+        }
+
+        std::vector<bolt::QueryResult> results;
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            results = lease->pipeline(queries);
+        } catch (const bolt::BoltError& e) {
+            // Issue inconnue pour tout le lot : échec signalé, pas de rejeu
+            MCEE_LOG_ERROR("Neo4jClient", "Erreur pipeline Bolt: ", e.what());
+            const std::string error = std::string("Bolt: ") + e.what();
+            for (auto& op : ops) {
+                if (op.callback) op.callback(Neo4jResponse{op.request_id, false, {}, error, 0});
+            }
+            ops.clear();
+            return true;
+        }
+        const double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        round_trip_latency_.recordSince(start);
+
+        retry.clear();
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (results[i].ignored) {
+                retry.push_back(std::move(ops[i]));
+                continue;
+            }
+            if (!results[i].success) {
+                MCEE_LOG_WARN("Neo4jClient", ops[i].request_type, " refusé: ", results[i].error);
+            }
+            if (ops[i].callback) {
+                ops[i].callback(Neo4jResponse{ops[i].request_id, results[i].success,
+                                              std::move(data[i]), results[i].error, elapsed_ms});
+            }
+        }
+        ops.swap(retry);
+    }
+    return true;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONVERSIONS JSON
 // ═══════════════════════════════════════════════════════════════════════════
@@ -300,13 +914,13 @@ Memory Neo4jClient::jsonToMemory(const json& j) const {
 
 json Neo4jClient::stateToJson(const EmotionalState& state) const {
     std::vector<double> emotions_vec(state.emotions.begin(), state.emotions.end());
-    auto [dominant_name, dominant_value] = state.getDominant();
+    const auto summary = state.summarize();
 
     return {
         {"emotions", emotions_vec},
-        {"dominant", dominant_name},
-        {"valence", state.getValence()},
-        {"intensity", state.getMeanIntensity()}
+        {"dominant", summary.dominantName()},
+        {"valence", summary.valence()},
+        {"intensity", summary.meanIntensity()}
     };
 }
 
@@ -323,18 +937,32 @@ std::string Neo4jClient::createMemory(
     payload["context"] = context;
 
     if (config_.async_mode && callback) {
-        return sendRequest("create_memory", payload, callback);
+        return enqueueWrite("create_memory", payload, callback);
     } else {
-        std::string request_id = sendRequest("create_memory", payload);
+        if (isNative("create_memory", payload)) {
+            json data;
+            const bolt::Query query = nativeQuery("create_memory", payload, data);
+            if (auto result = runNative(query)) {
+                if (result->success && data.contains("id") && data["id"].is_string()) {
+                    MCEE_LOG_DEBUG("Neo4jClient", "Souvenir créé: ", data["id"]);
+                    return data["id"].get<std::string>();
+                }
+                MCEE_LOG_ERROR("Neo4jClient", "Erreur création souvenir: ", result->error);
+                return "";
+            }
+        }
+
+        std::string request_id;
+        auto future = sendRequestAwaitable("create_memory", payload, request_id);
         if (request_id.empty()) return "";
 
-        Neo4jResponse response = waitForResponse(request_id);
+        Neo4jResponse response = waitForResponse(request_id, future);
         if (response.success && response.data.contains("id")) {
-            std::cout << "[Neo4jClient] Souvenir créé: " << response.data["id"] << "\n";
+            MCEE_LOG_DEBUG("Neo4jClient", "Souvenir créé: ", response.data["id"]);
             return response.data["id"].get<std::string>();
         }
 
-        std::cerr << "[Neo4jClient] Erreur création souvenir: " << response.error << "\n";
+        MCEE_LOG_ERROR("Neo4jClient", "Erreur création souvenir: ", response.error);
         return "";
     }
 }
@@ -348,18 +976,19 @@ std::string Neo4jClient::createTrauma(
     payload["trigger_keywords"] = trigger_keywords;
 
     if (config_.async_mode && callback) {
-        return sendRequest("create_trauma", payload, callback);
+        return enqueueWrite("create_trauma", payload, callback);
     } else {
-        std::string request_id = sendRequest("create_trauma", payload);
+        std::string request_id;
+        auto future = sendRequestAwaitable("create_trauma", payload, request_id);
         if (request_id.empty()) return "";
 
-        Neo4jResponse response = waitForResponse(request_id);
+        Neo4jResponse response = waitForResponse(request_id, future);
         if (response.success && response.data.contains("id")) {
-            std::cout << "[Neo4jClient] Trauma créé: " << response.data["id"] << "\n";
+            MCEE_LOG_INFO("Neo4jClient", "Trauma créé: ", response.data["id"]);
             return response.data["id"].get<std::string>();
         }
 
-        std::cerr << "[Neo4jClient] Erreur création trauma: " << response.error << "\n";
+        MCEE_LOG_ERROR("Neo4jClient", "Erreur création trauma: ", response.error);
         return "";
     }
 }
@@ -377,16 +1006,17 @@ void Neo4jClient::mergeMemory(
         {"transfer_weight", transfer_weight}
     };
 
-    sendRequest("merge_memory", payload, callback);
+    enqueueWrite("merge_memory", payload, callback);
 }
 
 std::optional<Memory> Neo4jClient::getMemory(const std::string& memory_id) {
     json payload = {{"id", memory_id}};
 
-    std::string request_id = sendRequest("get_memory", payload);
+    std::string request_id;
+    auto future = sendRequestAwaitable("get_memory", payload, request_id);
     if (request_id.empty()) return std::nullopt;
 
-    Neo4jResponse response = waitForResponse(request_id);
+    Neo4jResponse response = waitForResponse(request_id, future);
     if (response.success && !response.data.is_null()) {
         return jsonToMemory(response.data);
     }
@@ -399,6 +1029,38 @@ std::vector<std::pair<std::string, double>> Neo4jClient::findSimilarMemories(
     double threshold,
     size_t limit)
 {
+    if (bolt_pool_) {
+        // Intensité et valence de la requête calculées comme le service Python
+        static constexpr size_t POSITIVE[] = {0, 1, 8, 9, 10, 16, 17};
+        static constexpr size_t NEGATIVE[] = {2, 4, 5, 6, 11, 13, 20, 21, 22};
+        double pos = 0.0, neg = 0.0;
+        for (size_t i : POSITIVE) pos += emotions[i];
+        for (size_t i : NEGATIVE) neg += emotions[i];
+        const double total = pos + neg;
+
+        std::vector<std::pair<std::string, double>> results;
+        bolt::Query query;
+        query.statement = &FIND_SIMILAR_CYPHER;
+        query.params = {
+            {"query_intensity", *std::max_element(emotions.begin(), emotions.end())},
+            {"query_valence", total > 0.0 ? (pos - neg) / total : 0.5},
+            {"threshold", threshold},
+            {"limit", limit}
+        };
+        query.on_record = [&results](const std::vector<std::string>&, std::vector<json>& values) {
+            if (values[0].is_string() && values[3].is_number()) {
+                results.emplace_back(values[0].get<std::string>(), values[3].get<double>());
+            }
+        };
+
+        if (auto result = runNative(query)) {
+            if (!result->success) {
+                MCEE_LOG_ERROR("Neo4jClient", "Erreur recherche similaire: ", result->error);
+            }
+            return results;
+        }
+    }
+
     std::vector<double> emotions_vec(emotions.begin(), emotions.end());
     json payload = {
         {"emotions", emotions_vec},
@@ -406,10 +1068,11 @@ std::vector<std::pair<std::string, double>> Neo4jClient::findSimilarMemories(
         {"limit", limit}
     };
 
-    std::string request_id = sendRequest("find_similar", payload);
+    std::string request_id;
+    auto future = sendRequestAwaitable("find_similar", payload, request_id);
     if (request_id.empty()) return {};
 
-    Neo4jResponse response = waitForResponse(request_id);
+    Neo4jResponse response = waitForResponse(request_id, future);
     std::vector<std::pair<std::string, double>> results;
 
     if (response.success && response.data.is_array()) {
@@ -433,7 +1096,7 @@ void Neo4jClient::reactivateMemory(
         {"strength", strength}
     };
 
-    sendRequest("reactivate", payload, callback);
+    enqueueWrite("reactivate", payload, callback);
 }
 
 void Neo4jClient::applyDecay(double elapsed_hours, Neo4jCallback callback) {
@@ -451,7 +1114,7 @@ void Neo4jClient::deleteMemory(
         {"archive", archive}
     };
 
-    sendRequest("delete_memory", payload, callback);
+    enqueueWrite("delete_memory", payload, callback);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -472,7 +1135,7 @@ void Neo4jClient::recordPatternTransition(
         {"trigger", trigger}
     };
 
-    sendRequest("record_transition", payload, callback);
+    enqueueWrite("record_transition", payload, callback);
 }
 
 std::vector<std::pair<std::string, double>> Neo4jClient::getPatternTransitions(
@@ -480,10 +1143,11 @@ std::vector<std::pair<std::string, double>> Neo4jClient::getPatternTransitions(
 {
     json payload = {{"from", from_pattern}};
 
-    std::string request_id = sendRequest("get_transitions", payload);
+    std::string request_id;
+    auto future = sendRequestAwaitable("get_transitions", payload, request_id);
     if (request_id.empty()) return {};
 
-    Neo4jResponse response = waitForResponse(request_id);
+    Neo4jResponse response = waitForResponse(request_id, future);
     std::vector<std::pair<std::string, double>> results;
 
     if (response.success && response.data.is_array()) {
@@ -504,12 +1168,13 @@ std::vector<std::pair<std::string, double>> Neo4jClient::getPatternTransitions(
 std::string Neo4jClient::createSession(const std::string& pattern) {
     json payload = {{"pattern", pattern}};
 
-    std::string request_id = sendRequest("create_session", payload);
+    std::string request_id;
+    auto future = sendRequestAwaitable("create_session", payload, request_id);
     if (request_id.empty()) return "";
 
-    Neo4jResponse response = waitForResponse(request_id);
+    Neo4jResponse response = waitForResponse(request_id, future);
     if (response.success && response.data.contains("id")) {
-        std::cout << "[Neo4jClient] Session créée: " << response.data["id"] << "\n";
+        MCEE_LOG_INFO("Neo4jClient", "Session créée: ", response.data["id"]);
         return response.data["id"].get<std::string>();
     }
 
@@ -531,7 +1196,7 @@ void Neo4jClient::updateSession(
         {"emotional_state", stateToJson(state)}
     };
 
-    sendRequest("update_session", payload, callback);
+    enqueueWrite("update_session", payload, callback);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -539,20 +1204,43 @@ void Neo4jClient::updateSession(
 // ═══════════════════════════════════════════════════════════════════════════
 
 json Neo4jClient::executeCypher(const std::string& query, const json& params) {
+    if (bolt_pool_) {
+        json rows = json::array();
+        bolt::Query native;
+        native.cypher = query;
+        native.params = params.is_object() ? params : json::object();
+        native.on_record = [&rows](const std::vector<std::string>& fields, std::vector<json>& values) {
+            json row = json::object();
+            for (size_t i = 0; i < fields.size() && i < values.size(); ++i) {
+                row[fields[i]] = std::move(values[i]);
+            }
+            rows.push_back(std::move(row));
+        };
+
+        if (auto result = runNative(native)) {
+            if (result->success) {
+                return rows;
+            }
+            MCEE_LOG_ERROR("Neo4jClient", "Erreur Cypher: ", result->error);
+            return {};
+        }
+    }
+
     json payload = {
         {"query", query},
         {"params", params}
     };
 
-    std::string request_id = sendRequest("cypher_query", payload);
+    std::string request_id;
+    auto future = sendRequestAwaitable("cypher_query", payload, request_id);
     if (request_id.empty()) return {};
 
-    Neo4jResponse response = waitForResponse(request_id);
+    Neo4jResponse response = waitForResponse(request_id, future);
     if (response.success) {
         return response.data;
     }
 
-    std::cerr << "[Neo4jClient] Erreur Cypher: " << response.error << "\n";
+    MCEE_LOG_ERROR("Neo4jClient", "Erreur Cypher: ", response.error);
     return {};
 }
 
@@ -27,12 +27,16 @@ PatternMatcher::PatternMatcher(std::shared_ptr<MCT> mct,
 // ═══════════════════════════════════════════════════════════════════════════
 
 MatchResult PatternMatcher::match() {
+    return *matchShared();
+}
+
+std::shared_ptr<const MatchResult> PatternMatcher::matchShared() {
     if (!mct_ || !mlt_) {
         MatchResult empty;
         empty.pattern_name = "UNKNOWN";
         empty.similarity = 0.0;
         empty.confidence = 0.0;
-        return empty;
+        return std::make_shared<const MatchResult>(std::move(empty));
     }
     
     // Extrait la signature de la MCT
@@ -55,7 +59,7 @@ MatchResult PatternMatcher::match() {
                 result.theta = pattern_opt->theta;
                 result.emergency_threshold = pattern_opt->emergency_threshold;
                 result.memory_trigger_threshold = pattern_opt->memory_trigger_threshold;
-                return result;
+                return std::make_shared<const MatchResult>(std::move(result));
             }
         }
         
@@ -74,7 +78,7 @@ MatchResult PatternMatcher::match() {
             result.theta = serenity->theta;
             result.emergency_threshold = serenity->emergency_threshold;
             result.memory_trigger_threshold = serenity->memory_trigger_threshold;
-            return result;
+            return std::make_shared<const MatchResult>(std::move(result));
         }
         
         // Fallback ultime
@@ -87,17 +91,32 @@ MatchResult PatternMatcher::match() {
         fallback.theta = 0.25;
         fallback.emergency_threshold = 0.75;
         fallback.memory_trigger_threshold = 0.5;
-        return fallback;
+        return std::make_shared<const MatchResult>(std::move(fallback));
     }
     
-    return matchSignature(*signature_opt);
+    if (canReuseLastMatch(*signature_opt)) {
+        return reuseLastMatch();
+    }
+    
+    MatchResult result = matchSignature(*signature_opt);
+    
+    // Seul un match confirmé (USE_EXISTING) est réutilisé : sous le seuil
+    // haut, chaque frame continue d'adapter le pattern
+    has_last_match_ = config_.incremental_matching &&
+                      !current_pattern_id_.empty() &&
+                      result.pattern_id == current_pattern_id_ &&
+                      result.similarity >= config_.high_match_threshold;
+    if (has_last_match_) {
+        anchorLastMatch(*signature_opt, result);
+    }
+    return std::make_shared<const MatchResult>(std::move(result));
 }
 
 MatchResult PatternMatcher::matchSignature(const EmotionalSignature& signature) {
     total_matches_++;
     
-    // Trouve les meilleurs matches en MLT
-    auto matches = mlt_->findMatches(signature, config_.max_matches_returned);
+    // Trouve les meilleurs matches en MLT (successeurs probables d'abord)
+    auto matches = findCandidates(signature);
     
     if (matches.empty()) {
         // Aucun match - créer un nouveau pattern ?
@@ -108,7 +127,7 @@ MatchResult PatternMatcher::matchSignature(const EmotionalSignature& signature)
     sum_similarities_ += best_match.similarity;
     
     // Décision basée sur la similarité
-    MatchDecision decision = getDecision(signature);
+    MatchDecision decision = decide(matches);
     
     switch (decision) {
         case MatchDecision::USE_EXISTING: {
@@ -194,8 +213,10 @@ MatchResult PatternMatcher::matchSignature(const EmotionalSignature& signature)
 }
 
 MatchDecision PatternMatcher::getDecision(const EmotionalSignature& signature) const {
-    auto matches = mlt_->findMatches(signature, 3);
-    
+    return decide(mlt_->findMatches(signature, 3));
+}
+
+MatchDecision PatternMatcher::decide(const std::vector<PatternMatch>& matches) const {
     if (matches.empty()) {
         // Vérifie si on a assez de stabilité pour créer
         if (mct_ && mct_->getStability() >= config_.min_stability_for_creation) {
@@ -221,6 +242,119 @@ MatchDecision PatternMatcher::getDecision(const EmotionalSignature& signature) c
     }
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// MATCHING INCRÉMENTAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::vector<PatternMatch> PatternMatcher::findCandidates(const EmotionalSignature& signature) {
+    if (config_.incremental_matching && config_.transition_candidates > 0 &&
+        !current_pattern_id_.empty()) {
+        auto candidates = mlt_->findTransitionMatches(signature, current_pattern_id_,
+                                                      config_.transition_candidates);
+        if (!candidates.empty() && candidates[0].similarity >= config_.high_match_threshold) {
+            early_exits_.fetch_add(1, std::memory_order_relaxed);
+            if (candidates.size() > config_.max_matches_returned) {
+                candidates.resize(config_.max_matches_returned);
+            }
+            return candidates;
+        }
+    }
+    
+    full_scans_.fetch_add(1, std::memory_order_relaxed);
+    return mlt_->findMatches(signature, config_.max_matches_returned);
+}
+
+namespace {
+
+double signatureNorm(const EmotionalSignature& signature) {
+    double sum = 0.0;
+    for (double v : signature.mean_emotions) sum += v * v;
+    return std::sqrt(sum);
+}
+
+} // namespace
+
+void PatternMatcher::anchorLastMatch(const EmotionalSignature& signature, const MatchResult& result) {
+    // Ancre : la signature de ce matching (pas celle de la frame suivante),
+    // pour qu'une dérive lente finisse par rematcher
+    last_signature_ = signature;
+    last_signature_norm_ = signatureNorm(signature);
+
+    auto anchor = std::make_shared<MatchResult>(result);
+    anchor->is_new_pattern = false;
+    anchor->is_transition = false;
+    anchor->previous_pattern_id.clear();
+    anchor->transition_probability = 0.0;
+    last_result_ = std::move(anchor);
+
+    PatternScore retained;
+    if (!mlt_->scorePattern(signature, result.pattern_id, retained)) {
+        has_last_match_ = false;
+        return;
+    }
+    last_coefficients_revision_ = retained.coefficients_revision;
+
+    last_alternative_score_ = 0.0;
+    last_alternatives_.clear();
+    for (const auto& alternative : result.alternatives) {
+        last_alternatives_.push_back(alternative.pattern_id);
+        last_alternative_score_ = std::max(last_alternative_score_,
+                                           alternative.similarity * alternative.confidence);
+    }
+    mlt_->patternRevisions(last_alternatives_, last_alternative_revisions_);
+}
+
+bool PatternMatcher::canReuseLastMatch(const EmotionalSignature& signature) const {
+    if (!has_last_match_ || !config_.incremental_matching) return false;
+    if (current_pattern_id_ != last_result_->pattern_id) return false;
+    
+    // Tolérance : borne de la variation de similarité de tout pattern
+    // (MLT::computeSimilarity) entre la signature du dernier match et
+    // celle-ci. Le cosinus varie au plus de l'angle entre les deux
+    // signatures, les bonus de valence et d'arousal de 0.1 × leur écart
+    const double norm = signatureNorm(signature);
+    if (norm < 1e-10 || last_signature_norm_ < 1e-10) return false;
+    double dot = 0.0;
+    for (size_t i = 0; i < signature.mean_emotions.size(); ++i) {
+        dot += signature.mean_emotions[i] * last_signature_.mean_emotions[i];
+    }
+    const double angle = std::acos(std::clamp(dot / (norm * last_signature_norm_), -1.0, 1.0));
+    const double drift = angle +
+        0.1 * (std::abs(signature.global_valence - last_signature_.global_valence) +
+               std::abs(signature.global_arousal - last_signature_.global_arousal));
+    if (drift > config_.signature_skip_epsilon) return false;
+
+    // Alternatives inchangées : leur score ne peut avoir monté que de la dérive
+    mlt_->patternRevisions(last_alternatives_, revision_scratch_);
+    if (revision_scratch_ != last_alternative_revisions_) return false;
+
+    // Retenu rescoré seul : même décision (USE_EXISTING, en tête), mêmes coefficients
+    PatternScore retained;
+    if (!mlt_->scorePattern(signature, current_pattern_id_, retained)) return false;
+    if (retained.coefficients_revision != last_coefficients_revision_) return false;
+    if (retained.similarity < config_.high_match_threshold) return false;
+    if (!last_alternatives_.empty() &&
+        retained.similarity * retained.confidence <= last_alternative_score_ + drift) {
+        return false;
+    }
+    reuse_similarity_ = retained.similarity;
+    return true;
+}
+
+std::shared_ptr<const MatchResult> PatternMatcher::reuseLastMatch() {
+    // Mêmes effets qu'un USE_EXISTING sans changement de pattern
+    total_matches_++;
+    skipped_matches_.fetch_add(1, std::memory_order_relaxed);
+    sum_similarities_ += reuse_similarity_;
+    frames_in_current_pattern_++;
+    mlt_->recordActivation(current_pattern_id_);
+    
+    if (match_callback_) {
+        match_callback_(*last_result_);
+    }
+    return last_result_;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // GESTION DES TRANSITIONS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -247,7 +381,7 @@ std::vector<std::pair<std::string, double>> PatternMatcher::getPatternHistory(si
     for (size_t i = 0; i < count; ++i) {
         auto duration = std::chrono::duration<double>(
             (i + 1 < pattern_history_.size() ? 
-             pattern_history_[i + 1].second : std::chrono::steady_clock::now()) -
+             pattern_history_[i + 1].second : SessionClock::now()) -
             pattern_history_[i].second
         ).count();
         result.emplace_back(pattern_history_[i].first, duration);
@@ -326,6 +460,20 @@ double PatternMatcher::getAverageMatchSimilarity() const {
     return sum_similarities_ / total_matches_;
 }
 
+double PatternMatcher::getSkipRate() const {
+    size_t skipped = getSkippedMatches();
+    size_t total = skipped + getEarlyExits() + getFullScans();
+    if (total == 0) return 0.0;
+    return static_cast<double>(skipped) / total;
+}
+
+double PatternMatcher::getEarlyExitRate() const {
+    size_t early = getEarlyExits();
+    size_t searched = early + getFullScans();
+    if (searched == 0) return 0.0;
+    return static_cast<double>(early) / searched;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // SÉRIALISATION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -339,7 +487,10 @@ nlohmann::json PatternMatcher::toJson() const {
         {"low_match_threshold", config_.low_match_threshold},
         {"hysteresis_margin", config_.hysteresis_margin},
         {"min_frames_before_switch", config_.min_frames_before_switch},
-        {"min_stability_for_creation", config_.min_stability_for_creation}
+        {"min_stability_for_creation", config_.min_stability_for_creation},
+        {"incremental_matching", config_.incremental_matching},
+        {"signature_skip_epsilon", config_.signature_skip_epsilon},
+        {"transition_candidates", config_.transition_candidates}
     };
     
     j["state"] = {
@@ -352,7 +503,10 @@ nlohmann::json PatternMatcher::toJson() const {
         {"total_matches", total_matches_},
         {"patterns_created", patterns_created_},
         {"transitions_recorded", transitions_recorded_},
-        {"average_similarity", getAverageMatchSimilarity()}
+        {"average_similarity", getAverageMatchSimilarity()},
+        {"skipped_matches", skipped_matches_.load()},
+        {"early_exits", early_exits_.load()},
+        {"full_scans", full_scans_.load()}
     };
     
     return j;
@@ -371,7 +525,14 @@ void PatternMatcher::fromJson(const nlohmann::json& j) {
             config_.hysteresis_margin = c["hysteresis_margin"];
         if (c.contains("min_frames_before_switch")) 
             config_.min_frames_before_switch = c["min_frames_before_switch"];
+        if (c.contains("incremental_matching"))
+            config_.incremental_matching = c["incremental_matching"];
+        if (c.contains("signature_skip_epsilon"))
+            config_.signature_skip_epsilon = c["signature_skip_epsilon"];
+        if (c.contains("transition_candidates"))
+            config_.transition_candidates = c["transition_candidates"];
     }
+    has_last_match_ = false;
     
     if (j.contains("state")) {
         const auto& s = j["state"];
@@ -382,6 +543,22 @@ void PatternMatcher::fromJson(const nlohmann::json& j) {
         if (s.contains("current_similarity"))
             current_match_similarity_ = s["current_similarity"];
     }
+
+    if (j.contains("statistics")) {
+        const auto& st = j["statistics"];
+        if (st.contains("total_matches"))
+            total_matches_ = st["total_matches"];
+        if (st.contains("patterns_created"))
+            patterns_created_ = st["patterns_created"];
+        if (st.contains("transitions_recorded"))
+            transitions_recorded_ = st["transitions_recorded"];
+        if (st.contains("skipped_matches"))
+            skipped_matches_ = st["skipped_matches"].get<size_t>();
+        if (st.contains("early_exits"))
+            early_exits_ = st["early_exits"].get<size_t>();
+        if (st.contains("full_scans"))
+            full_scans_ = st["full_scans"].get<size_t>();
+    }
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -505,11 +682,8 @@ bool PatternMatcher::shouldSwitchPattern(const PatternMatch& new_match) const {
 }
 
 void PatternMatcher::updateHistory(const std::string& pattern_id) {
-    pattern_history_.emplace_back(pattern_id, std::chrono::steady_clock::now());
-    
-    while (pattern_history_.size() > max_history_size_) {
-        pattern_history_.pop_front();
-    }
+    // Tampon plein : l'entrée la plus ancienne est écrasée
+    pattern_history_.push_back({pattern_id, SessionClock::now()});
 }
 
 void PatternMatcher::analyzeUnmatchedSignatures() {
@@ -0,0 +1,294 @@
+/**
+ * @file PatternMatrix.cpp
+ * @brief Implémentation du stockage colonnaire des signatures MLT
+ */
+
+#include "PatternMatrix.hpp"
+#include "MLT.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace mcee {
+
+namespace {
+
+constexpr double BONUS_WEIGHT = 0.1;   // Bonus valence / arousal (cf. MLT::computeSimilarity)
+
+size_t paddedRows(size_t rows) {
+    return (rows + PatternMatrix::LANES - 1) / PatternMatrix::LANES * PatternMatrix::LANES;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MISE À JOUR
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PatternMatrix::resizePadded(size_t rows) {
+    size_t padded = paddedRows(rows);
+    for (size_t i = 0; i < DIM; ++i) {
+        mean_cols_[i].resize(padded, 0.0);
+        std_cols_[i].resize(padded, 0.0);
+    }
+    valence_.resize(padded, 0.0);
+    arousal_.resize(padded, 0.0);
+    valid_.resize(padded, 0.0);
+}
+
+void PatternMatrix::writeRow(size_t row, const EmotionalPattern& pattern) {
+    const auto& sig = pattern.signature;
+
+    double norm = 0.0;
+    for (size_t i = 0; i < DIM; ++i) {
+        norm += sig.mean_emotions[i] * sig.mean_emotions[i];
+    }
+    bool valid = norm >= 1e-10;
+    double inv = valid ? 1.0 / std::sqrt(norm) : 0.0;
+
+    for (size_t i = 0; i < DIM; ++i) {
+        mean_cols_[i][row] = sig.mean_emotions[i] * inv;
+        std_cols_[i][row] = sig.std_dev[i];
+    }
+    valence_[row] = sig.global_valence;
+    arousal_[row] = sig.global_arousal;
+    valid_[row] = valid ? 1.0 : 0.0;
+
+    active_[row] = pattern.is_active ? 1 : 0;
+    patterns_[row] = &pattern;
+    ids_[row] = pattern.id;
+}
+
+void PatternMatrix::moveRow(size_t from, size_t to) {
+    for (size_t i = 0; i < DIM; ++i) {
+        mean_cols_[i][to] = mean_cols_[i][from];
+        std_cols_[i][to] = std_cols_[i][from];
+    }
+    valence_[to] = valence_[from];
+    arousal_[to] = arousal_[from];
+    valid_[to] = valid_[from];
+    active_[to] = active_[from];
+    patterns_[to] = patterns_[from];
+    ids_[to] = std::move(ids_[from]);
+    row_of_[ids_[to]] = to;
+}
+
+void PatternMatrix::upsert(const EmotionalPattern& pattern) {
+    auto it = row_of_.find(pattern.id);
+    if (it != row_of_.end()) {
+        writeRow(it->second, pattern);
+        return;
+    }
+
+    size_t row = rows_++;
+    resizePadded(rows_);
+    active_.resize(rows_);
+    patterns_.resize(rows_);
+    ids_.resize(rows_);
+    row_of_[pattern.id] = row;
+    writeRow(row, pattern);
+}
+
+void PatternMatrix::remove(const std::string& pattern_id) {
+    auto it = row_of_.find(pattern_id);
+    if (it == row_of_.end()) return;
+
+    size_t row = it->second;
+    size_t last = rows_ - 1;
+    row_of_.erase(it);
+
+    if (row != last) {
+        moveRow(last, row);
+    }
+
+    // La ligne libérée redevient du padding neutre
+    for (size_t i = 0; i < DIM; ++i) {
+        mean_cols_[i][last] = 0.0;
+        std_cols_[i][last] = 0.0;
+    }
+    valence_[last] = arousal_[last] = valid_[last] = 0.0;
+
+    rows_ = last;
+    active_.resize(rows_);
+    patterns_.resize(rows_);
+    ids_.resize(rows_);
+    resizePadded(rows_);
+}
+
+void PatternMatrix::clear() {
+    rows_ = 0;
+    for (size_t i = 0; i < DIM; ++i) {
+        mean_cols_[i].clear();
+        std_cols_[i].clear();
+    }
+    valence_.clear();
+    arousal_.clear();
+    valid_.clear();
+    active_.clear();
+    patterns_.clear();
+    ids_.clear();
+    row_of_.clear();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// IMAGE BINAIRE
+// ═══════════════════════════════════════════════════════════════════════════
+
+size_t PatternMatrix::imageSize(size_t rows) {
+    return (2 * DIM + 3) * paddedRows(rows);
+}
+
+void PatternMatrix::writeImage(double* out) const {
+    const size_t padded = paddedRows(rows_);
+    auto put = [&](const std::vector<double>& col) {
+        std::copy(col.begin(), col.begin() + static_cast<std::ptrdiff_t>(padded), out);
+        out += padded;
+    };
+
+    for (size_t i = 0; i < DIM; ++i) put(mean_cols_[i]);
+    for (size_t i = 0; i < DIM; ++i) put(std_cols_[i]);
+    put(valence_);
+    put(arousal_);
+    put(valid_);
+}
+
+void PatternMatrix::loadImage(const double* image, const std::vector<const EmotionalPattern*>& patterns) {
+    clear();
+    rows_ = patterns.size();
+    const size_t padded = paddedRows(rows_);
+    auto take = [&](std::vector<double>& col) {
+        col.assign(image, image + padded);
+        image += padded;
+    };
+
+    for (size_t i = 0; i < DIM; ++i) take(mean_cols_[i]);
+    for (size_t i = 0; i < DIM; ++i) take(std_cols_[i]);
+    take(valence_);
+    take(arousal_);
+    take(valid_);
+
+    active_.resize(rows_);
+    patterns_.resize(rows_);
+    ids_.resize(rows_);
+    row_of_.reserve(rows_);
+    for (size_t row = 0; row < rows_; ++row) {
+        active_[row] = patterns[row]->is_active ? 1 : 0;
+        patterns_[row] = patterns[row];
+        ids_[row] = patterns[row]->id;
+        row_of_[ids_[row]] = row;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SCORING
+// ═══════════════════════════════════════════════════════════════════════════
+
+void PatternMatrix::scoreRow(size_t row, std::vector<double>& out) const {
+    // Colonnes normalisées : score() renormalise sans changer la direction
+    EmotionalSignature query{};
+    if (valid_[row] != 0.0) {
+        for (size_t i = 0; i < DIM; ++i) {
+            query.mean_emotions[i] = mean_cols_[i][row];
+        }
+    }
+    query.global_valence = valence_[row];
+    query.global_arousal = arousal_[row];
+    score(query, out, row + 1);
+}
+
+void PatternMatrix::score(const EmotionalSignature& signature, std::vector<double>& out,
+                          size_t first_row) const {
+    const size_t padded = paddedRows(rows_);
+    out.assign(padded, 0.0);
+    if (rows_ == 0) return;
+
+    double qnorm = 0.0;
+    for (size_t i = 0; i < DIM; ++i) {
+        qnorm += signature.mean_emotions[i] * signature.mean_emotions[i];
+    }
+    if (qnorm < 1e-10) {
+        out.resize(rows_);
+        return;  // Requête nulle : similarité 0 partout
+    }
+
+    alignas(32) double q[DIM];
+    double qinv = 1.0 / std::sqrt(qnorm);
+    for (size_t i = 0; i < DIM; ++i) {
+        q[i] = signature.mean_emotions[i] * qinv;
+    }
+    const double qv = signature.global_valence;
+    const double qa = signature.global_arousal;
+
+    size_t p = first_row / LANES * LANES;
+
+#if defined(__AVX2__)
+    const __m256d v_qv = _mm256_set1_pd(qv);
+    const __m256d v_qa = _mm256_set1_pd(qa);
+    const __m256d v_one = _mm256_set1_pd(1.0);
+    const __m256d v_zero = _mm256_setzero_pd();
+    const __m256d v_bonus = _mm256_set1_pd(BONUS_WEIGHT);
+    const __m256d v_sign = _mm256_set1_pd(-0.0);
+
+    for (; p + 4 <= padded; p += 4) {
+        __m256d acc = _mm256_setzero_pd();
+        for (size_t i = 0; i < DIM; ++i) {
+            __m256d col = _mm256_loadu_pd(mean_cols_[i].data() + p);
+#if defined(__FMA__)
+            acc = _mm256_fmadd_pd(_mm256_set1_pd(q[i]), col, acc);
+#else
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_set1_pd(q[i]), col));
+#endif
+        }
+
+        __m256d dv = _mm256_andnot_pd(v_sign, _mm256_sub_pd(v_qv, _mm256_loadu_pd(valence_.data() + p)));
+        __m256d da = _mm256_andnot_pd(v_sign, _mm256_sub_pd(v_qa, _mm256_loadu_pd(arousal_.data() + p)));
+        __m256d bonus = _mm256_mul_pd(v_bonus,
+            _mm256_add_pd(_mm256_sub_pd(v_one, dv), _mm256_sub_pd(v_one, da)));
+
+        __m256d sim = _mm256_min_pd(v_one, _mm256_max_pd(v_zero, _mm256_add_pd(acc, bonus)));
+        sim = _mm256_mul_pd(sim, _mm256_loadu_pd(valid_.data() + p));
+        _mm256_storeu_pd(out.data() + p, sim);
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float64x2_t v_qv = vdupq_n_f64(qv);
+    const float64x2_t v_qa = vdupq_n_f64(qa);
+    const float64x2_t v_one = vdupq_n_f64(1.0);
+    const float64x2_t v_zero = vdupq_n_f64(0.0);
+    const float64x2_t v_bonus = vdupq_n_f64(BONUS_WEIGHT);
+
+    for (; p + 2 <= padded; p += 2) {
+        float64x2_t acc = vdupq_n_f64(0.0);
+        for (size_t i = 0; i < DIM; ++i) {
+            acc = vfmaq_n_f64(acc, vld1q_f64(mean_cols_[i].data() + p), q[i]);
+        }
+
+        float64x2_t dv = vabdq_f64(v_qv, vld1q_f64(valence_.data() + p));
+        float64x2_t da = vabdq_f64(v_qa, vld1q_f64(arousal_.data() + p));
+        float64x2_t bonus = vmulq_f64(v_bonus, vaddq_f64(vsubq_f64(v_one, dv), vsubq_f64(v_one, da)));
+
+        float64x2_t sim = vminq_f64(v_one, vmaxq_f64(v_zero, vaddq_f64(acc, bonus)));
+        sim = vmulq_f64(sim, vld1q_f64(valid_.data() + p));
+        vst1q_f64(out.data() + p, sim);
+    }
+#endif
+
+    // Version scalaire (et reste éventuel)
+    for (; p < padded; ++p) {
+        double cosine = 0.0;
+        for (size_t i = 0; i < DIM; ++i) {
+            cosine += q[i] * mean_cols_[i][p];
+        }
+        double bonus = BONUS_WEIGHT * ((1.0 - std::abs(qv - valence_[p])) +
+                                       (1.0 - std::abs(qa - arousal_[p])));
+        out[p] = std::clamp(cosine + bonus, 0.0, 1.0) * valid_[p];
+    }
+
+    out.resize(rows_);
+}
+
+} // namespace mcee
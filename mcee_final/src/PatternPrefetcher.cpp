@@ -0,0 +1,186 @@
+/**
+ * @file PatternPrefetcher.cpp
+ * @brief Préchargement des successeurs probables du pattern courant
+ */
+
+#include "PatternPrefetcher.hpp"
+#include "MemoryManager.hpp"
+#include "HybridSearchEngine.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace mcee {
+
+PatternPrefetcher::PatternPrefetcher(std::shared_ptr<const MLT> mlt, MemoryManager& memory,
+                                     const PrefetchConfig& config)
+    : mlt_(std::move(mlt))
+    , memory_(memory)
+    , config_(config)
+    , lane_(TaskClass::BACKGROUND, 1, std::max<size_t>(1, config.max_pending))
+{
+}
+
+PatternPrefetcher::~PatternPrefetcher() {
+    stop();
+}
+
+void PatternPrefetcher::setHybridSearch(std::shared_ptr<HybridSearchEngine> search) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    search_ = std::move(search);
+}
+
+void PatternPrefetcher::setConfig(const PrefetchConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    lane_.setLimits(1, std::max<size_t>(1, config.max_pending));
+}
+
+PrefetchConfig PatternPrefetcher::getConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void PatternPrefetcher::onPattern(const std::string& pattern_id) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (pattern_id == current_) {
+        return;
+    }
+
+    // Bilan de la prédiction précédente
+    if (!current_.empty() && !targets_.empty()) {
+        auto it = std::find_if(targets_.begin(), targets_.end(),
+                               [&](const Target& t) { return t.pattern_id == pattern_id; });
+        if (it == targets_.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+        } else if (it->warmed) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            late_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    current_ = pattern_id;
+
+    if (!config_.enabled || !mlt_) {
+        targets_.clear();
+        return;
+    }
+
+    const PrefetchConfig config = config_;
+    lock.unlock();
+    auto forecasts = mlt_->predictTransitions(pattern_id, config.max_targets, config.min_probability);
+    lock.lock();
+
+    // Prédiction inchangée : le préchargement en cours reste valable
+    const bool same = forecasts.size() == targets_.size() &&
+        std::equal(forecasts.begin(), forecasts.end(), targets_.begin(),
+                   [](const TransitionForecast& f, const Target& t) { return f.pattern_id == t.pattern_id; });
+    if (same) {
+        return;
+    }
+
+    source_.cancel();
+    source_ = CancellationSource();
+    const uint64_t generation = ++generation_;
+    const CancellationToken token = source_.token();
+
+    targets_.clear();
+    for (const auto& forecast : forecasts) {
+        targets_.push_back(Target{forecast.pattern_id, false});
+    }
+    lock.unlock();
+
+    if (forecasts.empty()) {
+        return;
+    }
+    predictions_.fetch_add(1, std::memory_order_relaxed);
+
+    for (auto& forecast : forecasts) {
+        bool posted = lane_.post([this, forecast = std::move(forecast), generation, token]() {
+            warm(forecast, generation, token);
+        });
+        if (!posted) {
+            cancelled_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void PatternPrefetcher::warm(const TransitionForecast& forecast, uint64_t generation,
+                             const CancellationToken& token) {
+    if (token.isCancelled()) {
+        cancelled_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    PrefetchConfig config;
+    std::shared_ptr<HybridSearchEngine> search;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config = config_;
+        search = search_;
+    }
+
+    try {
+        // 1. Souvenirs proches de la signature cible → niveau chaud
+        if (config.memories_per_target > 0) {
+            EmotionalState state;
+            state.emotions = forecast.mean_emotions;
+            memory_.findSimilarInNeo4j(state, config.memory_threshold, config.memories_per_target);
+        }
+
+        // 2. Réponse HybridSearch (et son LLMContext) pour les mots du pattern → cache
+        if (config.warm_search && search && !forecast.lemmas.empty()) {
+            if (token.isCancelled()) {
+                cancelled_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            search->searchByLemmas(forecast.lemmas);
+        }
+    } catch (const std::exception& e) {
+        MCEE_LOG_WARN("PatternPrefetcher", "Préchargement de ", forecast.pattern_name, " interrompu: ",
+                      e.what());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_) {
+        return;  // Prédiction remplacée entre-temps : ce préchargement reste utile mais n'est plus suivi
+    }
+    for (auto& target : targets_) {
+        if (target.pattern_id == forecast.pattern_id) {
+            target.warmed = true;
+            warmed_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+void PatternPrefetcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        source_.cancel();
+    }
+    const size_t dropped = lane_.close();
+    cancelled_.fetch_add(dropped, std::memory_order_relaxed);
+    lane_.open();
+}
+
+std::vector<std::string> PatternPrefetcher::predictedTargets() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> ids;
+    ids.reserve(targets_.size());
+    for (const auto& target : targets_) ids.push_back(target.pattern_id);
+    return ids;
+}
+
+PrefetchStats PatternPrefetcher::getStats() const {
+    PrefetchStats stats;
+    stats.predictions = predictions_.load(std::memory_order_relaxed);
+    stats.warmed = warmed_.load(std::memory_order_relaxed);
+    stats.cancelled = cancelled_.load(std::memory_order_relaxed);
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.late = late_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace mcee
@@ -0,0 +1,385 @@
+/**
+ * @file PatternSnapshot.cpp
+ * @brief Implémentation du format binaire des patterns MLT
+ */
+
+#include "PatternSnapshot.hpp"
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+namespace mcee {
+
+static_assert(std::endian::native == std::endian::little,
+              "le snapshot MLT est lu en place : architecture little-endian requise");
+
+using namespace snapshot_format;
+
+namespace {
+
+constexpr char MAGIC[4] = {'M', 'L', 'T', 'P'};
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t{7};
+}
+
+// FNV-1a par mots de 64 bits (puis octets restants)
+uint64_t checksum(const unsigned char* data, size_t size) {
+    uint64_t h = 1469598103934665603ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h ^= word;
+        h *= 1099511628211ull;
+    }
+    for (; i < size; ++i) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+int64_t toMs(std::chrono::system_clock::time_point tp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count();
+}
+
+std::chrono::system_clock::time_point fromMs(int64_t ms) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(ms)));
+}
+
+/**
+ * @brief Sections variables en cours de construction
+ */
+struct Builder {
+    std::vector<PatternRecord> records;
+    std::vector<StringRef> refs;
+    std::vector<TransitionRecord> transitions;
+    std::string strings;
+
+    StringRef add(const std::string& s) {
+        if (strings.size() + s.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("table des chaînes du snapshot > 4 Go");
+        }
+        StringRef ref{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(s.size())};
+        strings.append(s);
+        return ref;
+    }
+
+    RangeRef addList(const std::vector<std::string>& list) {
+        RangeRef range{static_cast<uint32_t>(refs.size()), static_cast<uint32_t>(list.size())};
+        for (const auto& s : list) {
+            refs.push_back(add(s));
+        }
+        return range;
+    }
+
+    RangeRef addTransitions(const std::unordered_map<std::string, double>& probabilities) {
+        RangeRef range{static_cast<uint32_t>(transitions.size()),
+                       static_cast<uint32_t>(probabilities.size())};
+        for (const auto& [target, probability] : probabilities) {
+            transitions.push_back(TransitionRecord{add(target), probability});
+        }
+        return range;
+    }
+};
+
+template <typename T>
+void appendSection(std::string& out, uint64_t offset, const T* data, size_t count) {
+    out.resize(offset, '\0');  // Padding d'alignement
+    out.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉCRITURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool isPatternSnapshotFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::string encodePatternSnapshot(const PatternMatrix& matrix, const MLTConfig& config) {
+    const size_t n = matrix.size();
+
+    Builder builder;
+    builder.records.resize(n);
+    for (size_t row = 0; row < n; ++row) {
+        const EmotionalPattern& pattern = *matrix.patternAt(row);
+        const EmotionalSignature& sig = pattern.signature;
+        PatternRecord& rec = builder.records[row];
+        std::memset(&rec, 0, sizeof(rec));
+
+        rec.id = builder.add(pattern.id);
+        rec.name = builder.add(pattern.name);
+        rec.description = builder.add(pattern.description);
+
+        std::memcpy(rec.mean_emotions, sig.mean_emotions.data(), sizeof(rec.mean_emotions));
+        std::memcpy(rec.std_dev, sig.std_dev.data(), sizeof(rec.std_dev));
+        std::memcpy(rec.trend, sig.trend.data(), sizeof(rec.trend));
+        std::memcpy(rec.acceleration, sig.acceleration.data(), sizeof(rec.acceleration));
+        std::memcpy(rec.peak_position, sig.peak_position.data(), sizeof(rec.peak_position));
+        for (size_t i = 0; i < 24; ++i) {
+            rec.oscillation_count[i] = static_cast<int32_t>(sig.oscillation_count[i]);
+        }
+        rec.global_intensity = sig.global_intensity;
+        rec.global_valence = sig.global_valence;
+        rec.global_arousal = sig.global_arousal;
+        rec.stability = sig.stability;
+        rec.dominant_frequency = sig.dominant_frequency;
+
+        rec.alpha = pattern.alpha;
+        rec.beta = pattern.beta;
+        rec.gamma = pattern.gamma;
+        rec.delta = pattern.delta;
+        rec.theta = pattern.theta;
+        rec.emergency_threshold = pattern.emergency_threshold;
+        rec.memory_trigger_threshold = pattern.memory_trigger_threshold;
+        rec.confidence = pattern.confidence;
+        rec.average_duration_seconds = pattern.average_duration_seconds;
+
+        rec.created_at_ms = toMs(pattern.created_at);
+        rec.last_activated_ms = toMs(pattern.last_activated);
+        rec.last_modified_ms = toMs(pattern.last_modified);
+        rec.activation_count = pattern.activation_count;
+        rec.flags = (pattern.is_base_pattern ? FLAG_BASE : 0u)
+                  | (pattern.is_active ? FLAG_ACTIVE : 0u)
+                  | (pattern.is_locked ? FLAG_LOCKED : 0u);
+
+        rec.parent_ids = builder.addList(pattern.parent_ids);
+        rec.child_ids = builder.addList(pattern.child_ids);
+        rec.associated_contexts = builder.addList(pattern.associated_contexts);
+        rec.trigger_words = builder.addList(pattern.trigger_words);
+        rec.transitions = builder.addTransitions(pattern.transition_probabilities);
+    }
+
+    std::vector<double> image(PatternMatrix::imageSize(n));
+    matrix.writeImage(image.data());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = PATTERN_SNAPSHOT_VERSION;
+    header.dim = PatternMatrix::DIM;
+    header.record_size = sizeof(PatternRecord);
+    header.pattern_count = n;
+    header.image_offset = sizeof(SnapshotHeader);
+    header.records_offset = align8(header.image_offset + image.size() * sizeof(double));
+    header.refs_offset = align8(header.records_offset + n * sizeof(PatternRecord));
+    header.ref_count = builder.refs.size();
+    header.transitions_offset = align8(header.refs_offset + builder.refs.size() * sizeof(StringRef));
+    header.transition_count = builder.transitions.size();
+    header.strings_offset = align8(header.transitions_offset
+                                   + builder.transitions.size() * sizeof(TransitionRecord));
+    header.strings_size = builder.strings.size();
+    header.file_size = header.strings_offset + header.strings_size;
+    header.min_similarity_threshold = config.min_similarity_threshold;
+    header.high_similarity_threshold = config.high_similarity_threshold;
+    header.learning_rate = config.learning_rate;
+
+    std::string out;
+    out.reserve(header.file_size);
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendSection(out, header.image_offset, image.data(), image.size());
+    appendSection(out, header.records_offset, builder.records.data(), builder.records.size());
+    appendSection(out, header.refs_offset, builder.refs.data(), builder.refs.size());
+    appendSection(out, header.transitions_offset, builder.transitions.data(), builder.transitions.size());
+    appendSection(out, header.strings_offset, builder.strings.data(), builder.strings.size());
+
+    header.checksum = checksum(reinterpret_cast<const unsigned char*>(out.data()) + sizeof(header),
+                               out.size() - sizeof(header));
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LECTURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool PatternSnapshotReader::open(const std::string& path, std::string* error) {
+    header_ = SnapshotHeader{};
+    if (!file_.open(path, error)) {
+        return false;
+    }
+    if (!validate(error)) {
+        file_.close();
+        header_ = SnapshotHeader{};
+        return false;
+    }
+    return true;
+}
+
+bool PatternSnapshotReader::validate(std::string* error) {
+    auto reject = [error](const char* reason) {
+        if (error) *error = reason;
+        return false;
+    };
+
+    if (file_.size() < sizeof(SnapshotHeader)) {
+        return reject("fichier plus court que l'en-tête");
+    }
+    std::memcpy(&header_, file_.data(), sizeof(header_));
+    const SnapshotHeader& header = header_;
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return reject("signature MLTP absente");
+    }
+    if (header.version != PATTERN_SNAPSHOT_VERSION) {
+        return reject("version de snapshot non supportée");
+    }
+    if (header.dim != PatternMatrix::DIM || header.record_size != sizeof(PatternRecord)) {
+        return reject("disposition des records incompatible");
+    }
+    if (header.file_size != file_.size()) {
+        return reject("taille de fichier incohérente (tronqué ?)");
+    }
+
+    // Sections alignées, dans l'ordre, sans débordement
+    const uint64_t n = header.pattern_count;
+    const uint64_t max = file_.size();
+    auto fits = [max](uint64_t offset, uint64_t count, uint64_t item) {
+        return offset % 8 == 0 && offset <= max && count <= (max - offset) / item;
+    };
+    if (n > max / sizeof(PatternRecord) ||
+        !fits(header.image_offset, PatternMatrix::imageSize(n), sizeof(double)) ||
+        !fits(header.records_offset, n, sizeof(PatternRecord)) ||
+        !fits(header.refs_offset, header.ref_count, sizeof(StringRef)) ||
+        !fits(header.transitions_offset, header.transition_count, sizeof(TransitionRecord)) ||
+        header.strings_offset > max || header.strings_size != max - header.strings_offset) {
+        return reject("sections hors du fichier");
+    }
+
+    if (checksum(file_.data() + sizeof(SnapshotHeader), file_.size() - sizeof(SnapshotHeader))
+        != header.checksum) {
+        return reject("checksum invalide");
+    }
+
+    // Références : tout est vérifié ici, les accesseurs lisent sans contrôle
+    auto string_ok = [&](const StringRef& s) {
+        return uint64_t{s.offset} + s.length <= header.strings_size;
+    };
+    auto range_ok = [](const RangeRef& r, uint64_t total) {
+        return uint64_t{r.first} + r.count <= total;
+    };
+    for (uint64_t i = 0; i < header.ref_count; ++i) {
+        if (!string_ok(ref(static_cast<uint32_t>(i)))) {
+            return reject("référence de chaîne invalide");
+        }
+    }
+    for (uint64_t i = 0; i < header.transition_count; ++i) {
+        TransitionRecord t;
+        std::memcpy(&t, at(header.transitions_offset + i * sizeof(TransitionRecord)), sizeof(t));
+        if (!string_ok(t.target)) {
+            return reject("cible de transition invalide");
+        }
+    }
+    for (uint64_t i = 0; i < n; ++i) {
+        PatternRecord rec = record(static_cast<size_t>(i));
+        if (!string_ok(rec.id) || !string_ok(rec.name) || !string_ok(rec.description) ||
+            !range_ok(rec.parent_ids, header.ref_count) ||
+            !range_ok(rec.child_ids, header.ref_count) ||
+            !range_ok(rec.associated_contexts, header.ref_count) ||
+            !range_ok(rec.trigger_words, header.ref_count) ||
+            !range_ok(rec.transitions, header.transition_count)) {
+            return reject("record de pattern invalide");
+        }
+    }
+    return true;
+}
+
+const double* PatternSnapshotReader::image() const {
+    return reinterpret_cast<const double*>(at(header_.image_offset));
+}
+
+PatternRecord PatternSnapshotReader::record(size_t index) const {
+    PatternRecord rec;
+    std::memcpy(&rec, at(header_.records_offset + index * sizeof(PatternRecord)), sizeof(rec));
+    return rec;
+}
+
+StringRef PatternSnapshotReader::ref(uint32_t index) const {
+    StringRef s;
+    std::memcpy(&s, at(header_.refs_offset + uint64_t{index} * sizeof(StringRef)), sizeof(s));
+    return s;
+}
+
+std::string_view PatternSnapshotReader::string(const StringRef& s) const {
+    return std::string_view(reinterpret_cast<const char*>(at(header_.strings_offset + s.offset)), s.length);
+}
+
+std::vector<std::string> PatternSnapshotReader::strings(const RangeRef& range) const {
+    std::vector<std::string> out;
+    out.reserve(range.count);
+    for (uint32_t i = 0; i < range.count; ++i) {
+        out.emplace_back(string(ref(range.first + i)));
+    }
+    return out;
+}
+
+void PatternSnapshotReader::readPattern(size_t index, EmotionalPattern& out) const {
+    const PatternRecord rec = record(index);
+    EmotionalSignature& sig = out.signature;
+
+    out.id = string(rec.id);
+    out.name = string(rec.name);
+    out.description = string(rec.description);
+
+    std::memcpy(sig.mean_emotions.data(), rec.mean_emotions, sizeof(rec.mean_emotions));
+    std::memcpy(sig.std_dev.data(), rec.std_dev, sizeof(rec.std_dev));
+    std::memcpy(sig.trend.data(), rec.trend, sizeof(rec.trend));
+    std::memcpy(sig.acceleration.data(), rec.acceleration, sizeof(rec.acceleration));
+    std::memcpy(sig.peak_position.data(), rec.peak_position, sizeof(rec.peak_position));
+    for (size_t i = 0; i < 24; ++i) {
+        sig.oscillation_count[i] = rec.oscillation_count[i];
+    }
+    sig.global_intensity = rec.global_intensity;
+    sig.global_valence = rec.global_valence;
+    sig.global_arousal = rec.global_arousal;
+    sig.stability = rec.stability;
+    sig.dominant_frequency = rec.dominant_frequency;
+
+    out.alpha = rec.alpha;
+    out.beta = rec.beta;
+    out.gamma = rec.gamma;
+    out.delta = rec.delta;
+    out.theta = rec.theta;
+    out.emergency_threshold = rec.emergency_threshold;
+    out.memory_trigger_threshold = rec.memory_trigger_threshold;
+    out.confidence = rec.confidence;
+    out.average_duration_seconds = rec.average_duration_seconds;
+
+    out.created_at = fromMs(rec.created_at_ms);
+    out.last_activated = fromMs(rec.last_activated_ms);
+    out.last_modified = fromMs(rec.last_modified_ms);
+    out.activation_count = rec.activation_count;
+    out.is_base_pattern = (rec.flags & FLAG_BASE) != 0;
+    out.is_active = (rec.flags & FLAG_ACTIVE) != 0;
+    out.is_locked = (rec.flags & FLAG_LOCKED) != 0;
+
+    out.parent_ids = strings(rec.parent_ids);
+    out.child_ids = strings(rec.child_ids);
+    out.associated_contexts = strings(rec.associated_contexts);
+    out.trigger_words = strings(rec.trigger_words);
+
+    out.transition_probabilities.clear();
+    out.transition_probabilities.reserve(rec.transitions.count);
+    for (uint32_t i = 0; i < rec.transitions.count; ++i) {
+        TransitionRecord t;
+        std::memcpy(&t, at(header_.transitions_offset
+                           + uint64_t{rec.transitions.first + i} * sizeof(TransitionRecord)), sizeof(t));
+        out.transition_probabilities.emplace(std::string(string(t.target)), t.probability);
+    }
+}
+
+void PatternSnapshotReader::applyConfig(MLTConfig& config) const {
+    config.min_similarity_threshold = header_.min_similarity_threshold;
+    config.high_similarity_threshold = header_.high_similarity_threshold;
+    config.learning_rate = header_.learning_rate;
+}
+
+} // namespace mcee
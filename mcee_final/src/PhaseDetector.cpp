@@ -6,9 +6,9 @@
  */
 
 #include "PhaseDetector.hpp"
+#include "Logger.hpp"
 #include <nlohmann/json.hpp>
 #include <fstream>
-#include <iostream>
 #include <algorithm>
 #include <cmath>
 
@@ -19,11 +19,13 @@ using json = nlohmann::json;
 PhaseDetector::PhaseDetector(double hysteresis_margin, double min_phase_duration)
     : hysteresis_margin_(hysteresis_margin)
     , min_phase_duration_s_(min_phase_duration)
-    , phase_start_time_(std::chrono::steady_clock::now())
+    , phase_start_time_(SessionClock::now())
     , phase_configs_(DEFAULT_PHASE_CONFIGS)
 {
-    std::cout << "[PhaseDetector] Initialisé avec hystérésis=" << hysteresis_margin_
-              << ", durée min=" << min_phase_duration_s_ << "s\n";
+    refreshPriorityWeights();
+    MCEE_LOG_INFO("PhaseDetector",
+        "Initialisé avec hystérésis=", hysteresis_margin_, ", durée min=", min_phase_duration_s_,
+        "s");
 }
 
 Phase PhaseDetector::detectPhase(const EmotionalState& state) {
@@ -36,20 +38,10 @@ Phase PhaseDetector::detectPhase(const EmotionalState& state) {
     }
 
     // 2. Calculer les scores de chaque phase
-    auto scores = computePhaseScores(state);
+    const PhaseScores scores = scorePhases(state);
 
-    // 3. Trouver la meilleure phase
-    Phase best_phase = Phase::SERENITE;
-    double best_score = -1.0;
-    
-    for (const auto& [phase, score] : scores) {
-        // Pondérer par la priorité
-        double weighted_score = score * (1.0 + phase_configs_.at(phase).priority * 0.1);
-        if (weighted_score > best_score) {
-            best_score = weighted_score;
-            best_phase = phase;
-        }
-    }
+    // 3. Trouver la meilleure phase (pondérée par la priorité)
+    const Phase best_phase = bestPhase(scores);
 
     // 4. Vérifier si on peut changer de phase
     if (best_phase != current_phase_) {
@@ -61,76 +53,61 @@ Phase PhaseDetector::detectPhase(const EmotionalState& state) {
     return current_phase_;
 }
 
-std::unordered_map<Phase, double> PhaseDetector::computePhaseScores(
-    const EmotionalState& state) const 
-{
-    std::unordered_map<Phase, double> scores;
-
-    // Extraire les émotions clés
-    double peur = state.getEmotion("Peur");
-    double horreur = state.getEmotion("Horreur");
-    double anxiete = state.getEmotion("Anxiété");
-    double joie = state.getEmotion("Joie");
-    double calme = state.getEmotion("Calme");
-    double tristesse = state.getEmotion("Tristesse");
-    double degout = state.getEmotion("Dégoût");
-    double confusion = state.getEmotion("Confusion");
-    double interet = state.getEmotion("Intérêt");
-    double fascination = state.getEmotion("Fascination");
-    double excitation = state.getEmotion("Excitation");
-    double satisfaction = state.getEmotion("Satisfaction");
-
-    // Score SÉRÉNITÉ: calme élevé, émotions équilibrées
-    scores[Phase::SERENITE] = calme * 0.4 + satisfaction * 0.3 
-                            + (1.0 - anxiete) * 0.2 + (1.0 - peur) * 0.1;
-
-    // Score JOIE: joie et excitation élevées
-    scores[Phase::JOIE] = joie * 0.5 + excitation * 0.25 
-                        + satisfaction * 0.15 + (1.0 - tristesse) * 0.1;
-
-    // Score EXPLORATION: intérêt et fascination élevés
-    scores[Phase::EXPLORATION] = interet * 0.35 + fascination * 0.35 
-                               + excitation * 0.2 + (1.0 - peur) * 0.1;
-
-    // Score ANXIÉTÉ: anxiété élevée sans peur extrême
-    scores[Phase::ANXIETE] = anxiete * 0.5 + confusion * 0.2 
-                           + (1.0 - calme) * 0.2 + peur * 0.1;
-
-    // Score PEUR: peur et horreur élevées
-    scores[Phase::PEUR] = peur * 0.4 + horreur * 0.4 
-                        + anxiete * 0.15 + (1.0 - calme) * 0.05;
-
-    // Score TRISTESSE: tristesse élevée
-    double nostalgie = state.getEmotion("Nostalgie");
-    scores[Phase::TRISTESSE] = tristesse * 0.5 + nostalgie * 0.25 
-                             + (1.0 - joie) * 0.15 + (1.0 - excitation) * 0.1;
-
-    // Score DÉGOÛT: dégoût élevé
-    scores[Phase::DEGOUT] = degout * 0.6 + (1.0 - satisfaction) * 0.2 
-                          + horreur * 0.2;
-
-    // Score CONFUSION: confusion élevée
-    scores[Phase::CONFUSION] = confusion * 0.5 + anxiete * 0.2 
-                             + (1.0 - calme) * 0.2 + (1.0 - satisfaction) * 0.1;
-
-    // Normaliser les scores
-    double maxScore = 0.0;
-    for (const auto& [_, score] : scores) {
-        maxScore = std::max(maxScore, score);
-    }
-    
-    if (maxScore > 0.0) {
-        for (auto& [_, score] : scores) {
-            score /= maxScore;
+PhaseDetector::PhaseScores PhaseDetector::computePhaseScores(const EmotionalState& state) noexcept {
+    const auto& matrix = DEFAULT_PHASE_SCORE_MATRIX;
+    PhaseScores scores;
+    for (size_t p = 0; p < NUM_PHASES; ++p) {
+        // Quatre accumulateurs indépendants par ligne (chaîne de dépendance courte)
+        double acc[4] = {0.0, 0.0, 0.0, 0.0};
+        for (size_t e = 0; e < NUM_EMOTIONS; e += 4) {
+            for (size_t k = 0; k < 4; ++k) {
+                acc[k] += state.emotions[e + k] * matrix.weights[p][e + k];
+            }
         }
+        scores.values[p] = matrix.bias[p] + ((acc[0] + acc[1]) + (acc[2] + acc[3]));
     }
+    return scores;
+}
+
+PhaseDetector::PhaseScores PhaseDetector::scorePhases(const EmotionalState& state) noexcept {
+    PhaseScores scores = computePhaseScores(state);
+
+    // Normaliser les scores (inchangés si aucun n'est positif)
+    double max_score = 0.0;
+    for (double score : scores.values) max_score = std::max(max_score, score);
+    const double scale = max_score > 0.0 ? 1.0 / max_score : 1.0;
+    for (double& score : scores.values) score *= scale;
 
     return scores;
 }
 
+void PhaseDetector::scorePhases(std::span<const EmotionalState> states,
+                                std::span<PhaseScores> out) noexcept {
+    for (size_t i = 0; i < states.size(); ++i) {
+        out[i] = scorePhases(states[i]);
+    }
+}
+
+Phase PhaseDetector::bestPhase(const PhaseScores& scores) const noexcept {
+    size_t best = 0;
+    double best_score = -1.0;
+    for (size_t p = 0; p < NUM_PHASES; ++p) {
+        const double weighted = scores.values[p] * priority_weights_.values[p];
+        best = weighted > best_score ? p : best;
+        best_score = std::max(best_score, weighted);
+    }
+    return static_cast<Phase>(best);
+}
+
+void PhaseDetector::refreshPriorityWeights() noexcept {
+    for (size_t p = 0; p < NUM_PHASES; ++p) {
+        priority_weights_.values[p] = 1.0 + phase_configs_.values[p].priority * 0.1;
+    }
+}
+
 bool PhaseDetector::checkEmergencyTransition(const EmotionalState& state) const {
-    double peur = state.getEmotion("Peur");
-    double horreur = state.getEmotion("Horreur");
+    double peur = state.emotions[EMO_PEUR];
+    double horreur = state.emotions[EMO_HORREUR];
 
     // Transition immédiate si seuils d'urgence dépassés
     return (peur > EmergencyThresholds::PEUR_IMMEDIATE || 
@@ -138,24 +115,21 @@ bool PhaseDetector::checkEmergencyTransition(const EmotionalState& state) const
 }
 
 bool PhaseDetector::canTransition() const {
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     auto duration = std::chrono::duration<double>(now - phase_start_time_).count();
     return duration >= min_phase_duration_s_;
 }
 
-bool PhaseDetector::applyHysteresis(
-    const std::unordered_map<Phase, double>& scores,
-    Phase best_phase) const 
-{
-    double current_score = scores.at(current_phase_);
-    double best_score = scores.at(best_phase);
+bool PhaseDetector::applyHysteresis(const PhaseScores& scores, Phase best_phase) const noexcept {
+    const double current_score = scores[current_phase_];
+    const double best_score = scores[best_phase];
 
     // La nouvelle phase doit dépasser l'actuelle + marge d'hystérésis
     return (best_score > current_score + hysteresis_margin_);
 }
 
 void PhaseDetector::transitionTo(Phase new_phase, const std::string& reason) {
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     double duration = std::chrono::duration<double>(now - phase_start_time_).count();
 
     previous_phase_ = current_phase_;
@@ -163,11 +137,10 @@ void PhaseDetector::transitionTo(Phase new_phase, const std::string& reason) {
     phase_start_time_ = now;
     transition_count_++;
 
-    std::cout << "[PhaseDetector] Transition: " << phaseToString(previous_phase_)
-              << " -> " << phaseToString(current_phase_)
-              << " (raison: " << reason 
-              << ", durée précédente: " << std::fixed << std::setprecision(1) 
-              << duration << "s)\n";
+    MCEE_LOG_INFO("PhaseDetector",
+        "Transition: ", phaseToString(previous_phase_), " -> ", phaseToString(current_phase_),
+        " (raison: ", reason, ", durée précédente: ", std::fixed, std::setprecision(1), duration,
+        "s)");
 
     if (on_transition_) {
         on_transition_(previous_phase_, current_phase_, duration);
@@ -179,11 +152,11 @@ void PhaseDetector::forceTransition(Phase phase, const std::string& reason) {
 }
 
 const PhaseConfig& PhaseDetector::getCurrentConfig() const {
-    return phase_configs_.at(current_phase_);
+    return phase_configs_[current_phase_];
 }
 
 double PhaseDetector::getPhaseDuration() const {
-    auto now = std::chrono::steady_clock::now();
+    auto now = SessionClock::now();
     return std::chrono::duration<double>(now - phase_start_time_).count();
 }
 
@@ -195,7 +168,7 @@ bool PhaseDetector::loadConfig(const std::string& config_path) {
     try {
         std::ifstream file(config_path);
         if (!file) {
-            std::cerr << "[PhaseDetector] Fichier config introuvable: " << config_path << "\n";
+            MCEE_LOG_ERROR("PhaseDetector", "Fichier config introuvable: ", config_path);
             return false;
         }
 
@@ -232,13 +205,14 @@ bool PhaseDetector::loadConfig(const std::string& config_path) {
 
                 phase_configs_[phase] = pc;
             }
+            refreshPriorityWeights();
         }
 
-        std::cout << "[PhaseDetector] Configuration chargée depuis " << config_path << "\n";
+        MCEE_LOG_INFO("PhaseDetector", "Configuration chargée depuis ", config_path);
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << "[PhaseDetector] Erreur chargement config: " << e.what() << "\n";
+        MCEE_LOG_ERROR("PhaseDetector", "Erreur chargement config: ", e.what());
         return false;
     }
 }
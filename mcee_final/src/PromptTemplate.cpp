@@ -0,0 +1,106 @@
+/**
+ * @file PromptTemplate.cpp
+ * @brief Compilation et rendu des gabarits de prompt
+ */
+
+#include "PromptTemplate.hpp"
+#include <algorithm>
+
+namespace mcee {
+
+std::optional<PromptTemplate> PromptTemplate::compile(std::string_view text,
+                                                      const std::vector<std::string>& slots,
+                                                      std::string* error) {
+    PromptTemplate tpl;
+    tpl.slot_count_ = slots.size();
+
+    auto fail = [&](std::string message) -> std::optional<PromptTemplate> {
+        if (error) *error = std::move(message);
+        return std::nullopt;
+    };
+
+    auto slotIndex = [&](std::string_view name) -> std::optional<uint32_t> {
+        auto it = std::find(slots.begin(), slots.end(), name);
+        if (it == slots.end()) return std::nullopt;
+        return static_cast<uint32_t>(it - slots.begin());
+    };
+
+    auto addLiteral = [&](std::string_view literal) {
+        if (literal.empty()) return;
+        tpl.segments_.push_back({Segment::Kind::LITERAL, 0,
+                                 static_cast<uint32_t>(tpl.literals_.size()),
+                                 static_cast<uint32_t>(literal.size())});
+        tpl.literals_.append(literal);
+    };
+
+    // Sections ouvertes : (emplacement, index du segment SECTION)
+    std::vector<std::pair<uint32_t, size_t>> open;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t start = text.find("{{", pos);
+        if (start == std::string_view::npos) {
+            addLiteral(text.substr(pos));
+            break;
+        }
+        addLiteral(text.substr(pos, start - pos));
+
+        size_t end = text.find("}}", start + 2);
+        if (end == std::string_view::npos) {
+            return fail("balise non fermée à la position " + std::to_string(start));
+        }
+
+        std::string_view tag = text.substr(start + 2, end - start - 2);
+        char marker = tag.empty() ? '\0' : tag.front();
+        std::string_view name = (marker == '#' || marker == '/') ? tag.substr(1) : tag;
+
+        auto slot = slotIndex(name);
+        if (!slot) {
+            return fail("emplacement inconnu : " + std::string(name));
+        }
+
+        if (marker == '#') {
+            open.emplace_back(*slot, tpl.segments_.size());
+            tpl.segments_.push_back({Segment::Kind::SECTION, *slot, 0, 0});
+        } else if (marker == '/') {
+            if (open.empty() || open.back().first != *slot) {
+                return fail("fermeture inattendue : " + std::string(name));
+            }
+            size_t index = open.back().second;
+            tpl.segments_[index].length = static_cast<uint32_t>(tpl.segments_.size() - index - 1);
+            open.pop_back();
+        } else {
+            tpl.segments_.push_back({Segment::Kind::SLOT, *slot, 0, 0});
+        }
+
+        pos = end + 2;
+    }
+
+    if (!open.empty()) {
+        return fail("section non fermée : " + slots[open.back().first]);
+    }
+    return tpl;
+}
+
+void PromptTemplate::render(std::span<const std::string_view> values, std::string& out) const {
+    out.clear();
+
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        const Segment& seg = segments_[i];
+        switch (seg.kind) {
+            case Segment::Kind::LITERAL:
+                out.append(literals_, seg.offset, seg.length);
+                break;
+            case Segment::Kind::SLOT:
+                if (seg.slot < values.size()) out.append(values[seg.slot]);
+                break;
+            case Segment::Kind::SECTION:
+                if (seg.slot >= values.size() || values[seg.slot].empty()) {
+                    i += seg.length;
+                }
+                break;
+        }
+    }
+}
+
+} // namespace mcee
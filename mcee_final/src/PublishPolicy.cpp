@@ -0,0 +1,148 @@
+/**
+ * @file PublishPolicy.cpp
+ * @brief Publication de l'état pilotée par les changements, à débit borné
+ */
+
+#include "PublishPolicy.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace mcee {
+
+StatePublishPolicy::StatePublishPolicy(const PublishPolicyConfig& config)
+    : config_(config)
+{
+}
+
+void StatePublishPolicy::setConfig(const PublishPolicyConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+PublishPolicyConfig StatePublishPolicy::getConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+void StatePublishPolicy::offer(const EmotionalState& state, size_t dominant,
+                               std::shared_ptr<const MatchResult> match, Clock::time_point now,
+                               std::vector<PublishItem>& out, int64_t trace) {
+    offered_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!config_.enabled) {
+        out.push_back(PublishItem{state, std::move(match), trace});
+        published_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Changement de pattern (ou premier état) : immédiat, lot en cours compris
+    if (!has_published_ || match->pattern_id != last_pattern_id_) {
+        if (has_held_) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            has_held_ = false;
+        }
+        admit(PublishItem{state, std::move(match), trace}, dominant, now);
+        emitBatch(out);
+        immediate_.fetch_add(1, std::memory_order_relaxed);
+        updatePending();
+        return;
+    }
+
+    const bool significant =
+        std::abs(state.E_global - last_e_global_) >= config_.min_e_global_delta ||
+        (config_.on_dominant_change && dominant != last_dominant_) ||
+        (config_.heartbeat_seconds > 0.0 &&
+         now - last_admit_ >= std::chrono::duration<double>(config_.heartbeat_seconds));
+
+    if (!significant) {
+        // Revenu près du dernier état publié : celui en attente n'est plus à jour
+        suppressed_.fetch_add(has_held_ ? 2 : 1, std::memory_order_relaxed);
+        has_held_ = false;
+    } else {
+        if (has_held_) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            if (held_.trace != 0) trace = held_.trace;  // Estampille de la plus ancienne remplacée
+        }
+        held_ = PublishItem{state, std::move(match), trace};
+        held_dominant_ = dominant;
+        has_held_ = true;
+    }
+
+    if (has_held_ && rateAllows(now)) {
+        admit(std::move(held_), held_dominant_, now);
+    }
+    if (!batch_.empty() && (batch_.size() >= std::max<size_t>(1, config_.batch_max) ||
+                            now - batch_start_ >= std::chrono::milliseconds(config_.batch_delay_ms))) {
+        emitBatch(out);
+    }
+    updatePending();
+}
+
+void StatePublishPolicy::flush(Clock::time_point now, std::vector<PublishItem>& out, bool force) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_held_ && (force || rateAllows(now))) {
+        admit(std::move(held_), held_dominant_, now);
+    }
+    if (!batch_.empty() && (force || batch_.size() >= std::max<size_t>(1, config_.batch_max) ||
+                            now - batch_start_ >= std::chrono::milliseconds(config_.batch_delay_ms))) {
+        emitBatch(out);
+    }
+    updatePending();
+}
+
+StatePublishPolicy::Clock::duration StatePublishPolicy::flushInterval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock::duration interval = std::chrono::milliseconds(100);
+    if (config_.max_rate_hz > 0.0) {
+        interval = std::min(interval, std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / config_.max_rate_hz)));
+    }
+    if (config_.batch_max > 1) {
+        interval = std::min<Clock::duration>(interval, std::chrono::milliseconds(config_.batch_delay_ms));
+    }
+    return std::max<Clock::duration>(interval, std::chrono::milliseconds(1));
+}
+
+bool StatePublishPolicy::rateAllows(Clock::time_point now) const {
+    return config_.max_rate_hz <= 0.0 ||
+           now - last_admit_ >= std::chrono::duration<double>(1.0 / config_.max_rate_hz);
+}
+
+void StatePublishPolicy::admit(PublishItem&& item, size_t dominant, Clock::time_point now) {
+    if (batch_.empty()) {
+        batch_start_ = now;
+    }
+    has_published_ = true;
+    has_held_ = false;
+    last_e_global_ = item.state.E_global;
+    last_dominant_ = dominant;
+    last_pattern_id_ = item.match->pattern_id;
+    last_admit_ = now;
+    batch_.push_back(std::move(item));
+}
+
+void StatePublishPolicy::emitBatch(std::vector<PublishItem>& out) {
+    published_.fetch_add(batch_.size(), std::memory_order_relaxed);
+    for (auto& item : batch_) {
+        out.push_back(std::move(item));
+    }
+    batch_.clear();
+}
+
+void StatePublishPolicy::updatePending() {
+    has_pending_.store(has_held_ || !batch_.empty(), std::memory_order_release);
+}
+
+PublishStats StatePublishPolicy::getStats() const {
+    PublishStats stats;
+    stats.offered = offered_.load(std::memory_order_relaxed);
+    stats.published = published_.load(std::memory_order_relaxed);
+    stats.suppressed = suppressed_.load(std::memory_order_relaxed);
+    stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+    stats.immediate = immediate_.load(std::memory_order_relaxed);
+    stats.messages = messages_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace mcee
@@ -0,0 +1,343 @@
+/**
+ * @file ReplayEngine.cpp
+ * @brief Implémentation du rejeu hors ligne
+ */
+
+#include "ReplayEngine.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace mcee {
+
+namespace {
+
+SessionClock::duration secondsToDuration(double seconds) {
+    return std::chrono::duration_cast<SessionClock::duration>(
+        std::chrono::duration<double>(std::max(0.0, seconds)));
+}
+
+} // namespace
+
+bool readReplayConfig(const std::string& path, ReplayConfig& config) {
+    try {
+        std::ifstream file(path);
+        if (!file) {
+            MCEE_LOG_ERROR("ReplayEngine", "Impossible d'ouvrir ", path);
+            return false;
+        }
+        nlohmann::json j = nlohmann::json::parse(file);
+
+        if (j.contains("replay")) {
+            const auto& r = j["replay"];
+            config.threads = r.value("threads", config.threads);
+            config.shared_mlt = r.value("shared_mlt", config.shared_mlt);
+            config.patterns_path = r.value("patterns_path", config.patterns_path);
+            config.graph_ticks = r.value("graph_ticks", config.graph_ticks);
+        }
+
+        if (j.contains("mlt")) {
+            const auto& m = j["mlt"];
+            auto& c = config.mlt;
+            c.min_similarity_threshold = m.value("min_similarity_threshold", c.min_similarity_threshold);
+            c.high_similarity_threshold = m.value("high_similarity_threshold", c.high_similarity_threshold);
+            c.max_matches_returned = m.value("max_matches_returned", c.max_matches_returned);
+            c.min_confidence_for_creation = m.value("min_confidence_for_creation", c.min_confidence_for_creation);
+            c.min_activations_for_learning = m.value("min_activations_for_learning", c.min_activations_for_learning);
+            c.learning_rate = m.value("learning_rate", c.learning_rate);
+            c.fusion_similarity_threshold = m.value("fusion_similarity_threshold", c.fusion_similarity_threshold);
+            c.min_activations_for_fusion = m.value("min_activations_for_fusion", c.min_activations_for_fusion);
+            c.max_patterns = m.value("max_patterns", c.max_patterns);
+            c.min_confidence_to_keep = m.value("min_confidence_to_keep", c.min_confidence_to_keep);
+        }
+
+        if (j.contains("pattern_matcher")) {
+            const auto& p = j["pattern_matcher"];
+            auto& c = config.pattern_matcher;
+            c.high_match_threshold = p.value("high_match_threshold", c.high_match_threshold);
+            c.medium_match_threshold = p.value("medium_match_threshold", c.medium_match_threshold);
+            c.low_match_threshold = p.value("low_match_threshold", c.low_match_threshold);
+            c.hysteresis_margin = p.value("hysteresis_margin", c.hysteresis_margin);
+            c.min_frames_before_switch = p.value("min_frames_before_switch", c.min_frames_before_switch);
+            c.min_stability_for_creation = p.value("min_stability_for_creation", c.min_stability_for_creation);
+            c.min_confidence_for_creation = p.value("min_confidence_for_creation", c.min_confidence_for_creation);
+            c.max_matches_returned = p.value("max_matches_returned", c.max_matches_returned);
+            c.incremental_matching = p.value("incremental_matching", c.incremental_matching);
+            c.signature_skip_epsilon = p.value("signature_skip_epsilon", c.signature_skip_epsilon);
+            c.transition_candidates = p.value("transition_candidates", c.transition_candidates);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        MCEE_LOG_ERROR("ReplayEngine", "Configuration de rejeu invalide (", path, "): ", e.what());
+        return false;
+    }
+}
+
+nlohmann::json ReplayStats::toJson() const {
+    return {
+        {"sessions", sessions},
+        {"messages", {{"total", messages}, {"emotions", emotion_messages},
+                      {"speech", speech_messages}, {"tokens", token_messages}}},
+        {"frames", frames},
+        {"pattern_switches", pattern_switches},
+        {"new_patterns", new_patterns},
+        {"emergencies", emergencies},
+        {"mean_similarity", mean_similarity},
+        {"mean_confidence", mean_confidence},
+        {"pattern_frames", pattern_frames},
+        {"trace_seconds", trace_seconds},
+        {"wall_seconds", wall_seconds},
+        {"speedup", speedup()}
+    };
+}
+
+ReplayEngine::ReplayEngine(ReplayConfig config)
+    : config_(std::move(config))
+{
+    config_.mlt.auto_save = false;  // Le rejeu ne touche jamais aux patterns enregistrés
+    config_.mlt.background_learning = false;  // Passes synchrones : rejeu reproductible
+}
+
+std::shared_ptr<MLT> ReplayEngine::createMLT() const {
+    auto mlt = std::make_shared<MLT>(config_.mlt);
+    if (!config_.patterns_path.empty() && !mlt->loadFromFile(config_.patterns_path)) {
+        MCEE_LOG_WARN("ReplayEngine", "Patterns non chargés (", config_.patterns_path,
+                      ") : patterns de base");
+    }
+    return mlt;
+}
+
+ReplayStats ReplayEngine::run(const TraceReader& trace) {
+    const auto wall_start = std::chrono::steady_clock::now();
+    const auto& records = trace.records();
+    session_results_.clear();
+
+    ReplayStats stats;
+    if (records.empty()) return stats;
+
+    // Messages regroupés par session, dans l'ordre du temps de réception
+    std::unordered_map<std::string_view, std::vector<size_t>> by_session;
+    double t0 = records.front().time;
+    for (size_t i = 0; i < records.size(); ++i) {
+        by_session[records[i].session].push_back(i);
+        t0 = std::min(t0, records[i].time);
+
+        switch (records[i].input) {
+            case MCEEInput::EMOTIONS: stats.emotion_messages++; break;
+            case MCEEInput::SPEECH: stats.speech_messages++; break;
+            case MCEEInput::TOKENS: stats.token_messages++; break;
+        }
+    }
+    stats.messages = records.size();
+
+    std::vector<std::vector<size_t>> sessions;
+    sessions.reserve(by_session.size());
+    for (auto& [id, events] : by_session) {
+        std::stable_sort(events.begin(), events.end(),
+                         [&](size_t a, size_t b) { return records[a].time < records[b].time; });
+        sessions.push_back(std::move(events));
+    }
+    // Plus longues d'abord : la dernière session démarrée ne retarde pas la fin
+    std::sort(sessions.begin(), sessions.end(),
+              [](const auto& a, const auto& b) { return a.size() > b.size(); });
+
+    // Lexique et transport LLM communs ; LLM jamais initialisé (rejeu hors ligne)
+    SharedEngineResources shared;
+    shared.lexicon = SpeechLexicon::createDefault();
+    shared.llm_client = std::make_shared<LLMClient>();
+    if (config_.shared_mlt) {
+        shared.mlt = createMLT();
+    }
+
+    std::ofstream decisions_out;
+    if (!config_.output_path.empty()) {
+        decisions_out.open(config_.output_path, std::ios::trunc);
+        if (!decisions_out) {
+            MCEE_LOG_ERROR("ReplayEngine", "Trace des décisions impossible: ", config_.output_path);
+        }
+    }
+    const bool write_decisions = decisions_out.is_open();
+
+    const size_t thread_count = std::clamp<size_t>(
+        config_.threads > 0 ? config_.threads : std::thread::hardware_concurrency(),
+        1, sessions.size());
+
+    MCEE_LOG_INFO("ReplayEngine", "Rejeu de ", sessions.size(), " sessions (", records.size(),
+                  " messages) sur ", thread_count, " threads");
+
+    std::vector<ReplaySessionResult> results(sessions.size());
+    std::vector<SessionStats> session_stats(sessions.size());
+    std::atomic<size_t> next{0};
+    std::mutex output_mutex;
+
+    auto worker = [&]() {
+        std::string decisions;
+        for (size_t s = next.fetch_add(1); s < sessions.size(); s = next.fetch_add(1)) {
+            decisions.clear();
+            try {
+                results[s] = replaySession(trace, sessions[s], shared, t0, session_stats[s],
+                                           write_decisions ? &decisions : nullptr);
+            } catch (const std::exception& e) {
+                MCEE_LOG_ERROR("ReplayEngine", "Session ", records[sessions[s].front()].session,
+                               " interrompue: ", e.what());
+            }
+            // Lignes d'une session contiguës dans la trace des décisions
+            if (write_decisions && !decisions.empty()) {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                decisions_out << decisions;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (size_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) t.join();
+
+    double similarity_sum = 0.0;
+    double confidence_sum = 0.0;
+    for (size_t s = 0; s < sessions.size(); ++s) {
+        const auto& r = results[s];
+        const auto& st = session_stats[s];
+        stats.frames += st.frames;
+        stats.pattern_switches += st.pattern_switches;
+        stats.new_patterns += st.new_patterns;
+        stats.emergencies += r.emergencies;
+        stats.trace_seconds += r.trace_seconds;
+        similarity_sum += st.similarity_sum;
+        confidence_sum += st.confidence_sum;
+        for (const auto& [pattern, count] : st.pattern_frames) {
+            stats.pattern_frames[pattern] += count;
+        }
+    }
+    stats.sessions = sessions.size();
+    if (stats.frames > 0) {
+        stats.mean_similarity = similarity_sum / static_cast<double>(stats.frames);
+        stats.mean_confidence = confidence_sum / static_cast<double>(stats.frames);
+    }
+    stats.wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_start).count();
+
+    session_results_ = std::move(results);
+
+    MCEE_LOG_INFO("ReplayEngine", "Rejeu terminé : ", stats.frames, " trames, ",
+                  stats.new_patterns, " nouveaux patterns, ", stats.emergencies,
+                  " urgences en ", stats.wall_seconds, "s (×", stats.speedup(), ")");
+    return stats;
+}
+
+ReplaySessionResult ReplayEngine::replaySession(const TraceReader& trace, const std::vector<size_t>& events,
+                                                const SharedEngineResources& shared, double t0,
+                                                SessionStats& stats, std::string* decisions) const {
+    const auto& records = trace.records();
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    ReplaySessionResult result;
+    result.session_id = std::string(records[events.front()].session);
+    result.messages = events.size();
+
+    // Temps de trace : l'instant t0 du rejeu est ancré sur l'horloge réelle
+    const auto base = SessionClock::clock::now();
+    auto traceTime = [&](double t) { return base + secondsToDuration(t - t0); };
+    SessionClock::VirtualScope clock(traceTime(records[events.front()].time));
+
+    SharedEngineResources session_shared = shared;
+    if (!session_shared.mlt) {
+        session_shared.mlt = createMLT();
+    }
+
+    MCEEEngine engine(result.session_id, session_shared);
+    if (!config_.config_path.empty()) {
+        engine.loadConfig(config_.config_path, true);
+    }
+    engine.getPatternMatcher()->setConfig(config_.pattern_matcher);
+
+    double current_time = records[events.front()].time;
+    std::string previous_pattern;
+
+    engine.setStateCallback([&](const EmotionalState& state, const std::string&) {
+        const MatchResult match = engine.getCurrentMatchResult();
+
+        stats.frames++;
+        stats.similarity_sum += match.similarity;
+        stats.confidence_sum += match.confidence;
+        stats.pattern_frames[match.pattern_id]++;
+        if (match.is_new_pattern) stats.new_patterns++;
+        if (!previous_pattern.empty() && match.pattern_id != previous_pattern) {
+            stats.pattern_switches++;
+        }
+        previous_pattern = match.pattern_id;
+
+        if (decisions) {
+            const EmotionSummary summary = state.summarize();
+            nlohmann::json line = {
+                {"t", current_time},
+                {"session", result.session_id},
+                {"pattern_id", match.pattern_id},
+                {"pattern", match.pattern_name},
+                {"similarity", match.similarity},
+                {"confidence", match.confidence},
+                {"new_pattern", match.is_new_pattern},
+                {"transition", match.is_transition},
+                {"dominant", summary.dominantName()},
+                {"valence", summary.valence()},
+                {"E_global", state.E_global}
+            };
+            decisions->append(line.dump());
+            decisions->push_back('\n');
+        }
+    });
+
+    const std::atomic<bool> keep_going{true};
+    const auto tick_interval = secondsToDuration(
+        engine.getMCTGraph()->getConfig().snapshot_interval_seconds);
+    auto next_tick = clock.now() + tick_interval;
+
+    size_t emergencies_seen = 0;
+    for (size_t index : events) {
+        const TraceRecord& record = records[index];
+        current_time = record.time;
+        clock.set(traceTime(record.time));
+
+        if (config_.graph_ticks && clock.now() >= next_tick) {
+            engine.graphTick(keep_going);
+            next_tick = clock.now() + tick_interval;
+        }
+
+        engine.handleInput(record.input, std::string(record.body), std::string(record.content_type));
+
+        const size_t emergencies = engine.getEmergencyTriggers();
+        if (decisions && emergencies > emergencies_seen) {
+            nlohmann::json line = {
+                {"t", current_time},
+                {"session", result.session_id},
+                {"emergency", true},
+                {"count", emergencies - emergencies_seen}
+            };
+            decisions->append(line.dump());
+            decisions->push_back('\n');
+        }
+        emergencies_seen = emergencies;
+    }
+
+    const MCEEStats engine_stats = engine.getStats();
+    result.frames = stats.frames;
+    result.pattern_switches = stats.pattern_switches;
+    result.new_patterns = stats.new_patterns;
+    result.emergencies = engine_stats.emergency_triggers;
+    result.final_pattern = engine.getCurrentMatchResult().pattern_name;
+    result.final_wisdom = engine_stats.wisdom;
+    result.trace_seconds = records[events.back()].time - records[events.front()].time;
+    result.wall_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_start).count();
+    return result;
+}
+
+} // namespace mcee
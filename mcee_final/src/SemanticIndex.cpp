@@ -0,0 +1,336 @@
+/**
+ * @file SemanticIndex.cpp
+ * @brief Implémentation des embeddings quantifiés et de l'index sémantique local
+ * @version 3.0
+ * @date 2024
+ */
+
+#include "SemanticIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace mcee {
+
+namespace {
+
+// Conversions float32 ↔ float16 (arrondi au plus proche, pair en cas d'égalité)
+uint16_t floatToHalf(float value) {
+    uint32_t x;
+    std::memcpy(&x, &value, sizeof(x));
+    const uint16_t sign = static_cast<uint16_t>((x >> 16) & 0x8000u);
+    x &= 0x7fffffffu;
+
+    if (x >= 0x7f800000u) {                     // Inf / NaN
+        return sign | (x > 0x7f800000u ? 0x7e00u : 0x7c00u);
+    }
+    if (x >= 0x477ff000u) {                     // ≥ 65520 : hors plage
+        return sign | 0x7c00u;
+    }
+    if (x < 0x38800000u) {                      // Sous-normal en demi-précision
+        if (x < 0x33000000u) return sign;       // < 2^-25 : zéro
+        const uint32_t exponent = x >> 23;
+        const uint32_t mantissa = (x & 0x7fffffu) | 0x800000u;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+        return sign | static_cast<uint16_t>(half);
+    }
+
+    uint32_t half = (x - 0x38000000u) >> 13;    // Rebiaisage de l'exposant 127 → 15
+    const uint32_t rest = x & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+    return sign | static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t half) {
+    // Exposant et mantisse recalés, puis multiplication par 2^112 : rebiaise
+    // l'exposant et normalise les sous-normaux sans branche
+    constexpr uint32_t MAGIC_BITS = 0x77800000u;   // 2^112
+    float magic;
+    std::memcpy(&magic, &MAGIC_BITS, sizeof(magic));
+
+    uint32_t bits = static_cast<uint32_t>(half & 0x7fffu) << 13;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    value *= magic;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (value >= 65536.0f) bits |= 0x7f800000u;    // Inf / NaN
+    bits |= static_cast<uint32_t>(half & 0x8000u) << 16;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+const char* quantizationName(EmbeddingQuantization mode) noexcept {
+    switch (mode) {
+        case EmbeddingQuantization::NONE:    return "float32";
+        case EmbeddingQuantization::FLOAT16: return "float16";
+        case EmbeddingQuantization::INT8:    return "int8";
+    }
+    return "?";
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// QUANTIZEDEMBEDDING
+// ═══════════════════════════════════════════════════════════════════════════
+
+QuantizedEmbedding QuantizedEmbedding::encode(const std::vector<double>& values,
+                                              EmbeddingQuantization mode) {
+    QuantizedEmbedding q;
+    q.mode_ = mode;
+    q.dim_ = static_cast<uint32_t>(values.size());
+
+    double norm = 0.0;
+    switch (mode) {
+        case EmbeddingQuantization::NONE: {
+            q.data_.resize(values.size() * sizeof(float));
+            for (size_t i = 0; i < values.size(); ++i) {
+                const float v = static_cast<float>(values[i]);
+                std::memcpy(q.data_.data() + i * sizeof(float), &v, sizeof(float));
+                norm += static_cast<double>(v) * v;
+            }
+            break;
+        }
+        case EmbeddingQuantization::FLOAT16: {
+            q.data_.resize(values.size() * sizeof(uint16_t));
+            for (size_t i = 0; i < values.size(); ++i) {
+                const uint16_t h = floatToHalf(static_cast<float>(values[i]));
+                std::memcpy(q.data_.data() + i * sizeof(uint16_t), &h, sizeof(uint16_t));
+                const double v = halfToFloat(h);
+                norm += v * v;
+            }
+            break;
+        }
+        case EmbeddingQuantization::INT8: {
+            double max_abs = 0.0;
+            for (double v : values) max_abs = std::max(max_abs, std::abs(v));
+            q.scale_ = max_abs > 0.0 ? static_cast<float>(max_abs / 127.0) : 1.0f;
+
+            q.data_.resize(values.size());
+            const double inv = 1.0 / q.scale_;
+            for (size_t i = 0; i < values.size(); ++i) {
+                const long code = std::clamp(std::lround(values[i] * inv), -127L, 127L);
+                q.data_[i] = static_cast<uint8_t>(static_cast<int8_t>(code));
+                const double v = static_cast<double>(code) * q.scale_;
+                norm += v * v;
+            }
+            break;
+        }
+    }
+    q.norm_ = std::sqrt(norm);
+    return q;
+}
+
+std::vector<double> QuantizedEmbedding::decode() const {
+    std::vector<double> out(dim_);
+    switch (mode_) {
+        case EmbeddingQuantization::NONE:
+            for (size_t i = 0; i < dim_; ++i) {
+                float v;
+                std::memcpy(&v, data_.data() + i * sizeof(float), sizeof(float));
+                out[i] = v;
+            }
+            break;
+        case EmbeddingQuantization::FLOAT16:
+            for (size_t i = 0; i < dim_; ++i) {
+                uint16_t h;
+                std::memcpy(&h, data_.data() + i * sizeof(uint16_t), sizeof(uint16_t));
+                out[i] = halfToFloat(h);
+            }
+            break;
+        case EmbeddingQuantization::INT8: {
+            const int8_t* codes = int8Codes();
+            for (size_t i = 0; i < dim_; ++i) {
+                out[i] = static_cast<double>(codes[i]) * scale_;
+            }
+            break;
+        }
+    }
+    return out;
+}
+
+double QuantizedEmbedding::dot(const float* query) const {
+    // Sommes partielles indépendantes : la réduction flottante n'est pas
+    // réordonnée par le compilateur, elle l'est ici explicitement
+    constexpr size_t LANES = 8;
+    float lanes[LANES] = {};
+    auto accumulate = [&](auto value_at) {
+        size_t i = 0;
+        for (; i + LANES <= dim_; i += LANES) {
+            for (size_t j = 0; j < LANES; ++j) lanes[j] += value_at(i + j) * query[i + j];
+        }
+        for (; i < dim_; ++i) lanes[0] += value_at(i) * query[i];
+        float sum = 0.0f;
+        for (float l : lanes) sum += l;
+        return static_cast<double>(sum);
+    };
+
+    switch (mode_) {
+        case EmbeddingQuantization::NONE:
+            return accumulate([this](size_t i) {
+                float v;
+                std::memcpy(&v, data_.data() + i * sizeof(float), sizeof(float));
+                return v;
+            });
+        case EmbeddingQuantization::FLOAT16:
+            return accumulate([this](size_t i) {
+                uint16_t h;
+                std::memcpy(&h, data_.data() + i * sizeof(uint16_t), sizeof(uint16_t));
+                return halfToFloat(h);
+            });
+        case EmbeddingQuantization::INT8: {
+            const int8_t* codes = int8Codes();
+            return accumulate([codes](size_t i) { return static_cast<float>(codes[i]); }) * scale_;
+        }
+    }
+    return 0.0;
+}
+
+double QuantizedEmbedding::dot(const QuantizedEmbedding& other) const {
+    if (mode_ != EmbeddingQuantization::INT8 || other.mode_ != EmbeddingQuantization::INT8) {
+        std::vector<double> values = other.decode();
+        std::vector<float> query(values.begin(), values.end());
+        return dot(query.data());
+    }
+
+    // Somme entière exacte, par blocs de 16 : vectorisée dès -O2
+    constexpr size_t LANES = 16;
+    const int8_t* a = int8Codes();
+    const int8_t* b = other.int8Codes();
+    int32_t lanes[LANES] = {};
+    size_t i = 0;
+    for (; i + LANES <= dim_; i += LANES) {
+        for (size_t j = 0; j < LANES; ++j) {
+            lanes[j] += static_cast<int32_t>(a[i + j]) * static_cast<int32_t>(b[i + j]);
+        }
+    }
+    int32_t sum = 0;
+    for (; i < dim_; ++i) sum += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    for (int32_t l : lanes) sum += l;
+    return static_cast<double>(sum) * scale_ * other.scale_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SEMANTICINDEX
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool SemanticIndex::upsert(const std::string& id, const std::vector<double>& embedding) {
+    if (embedding.empty() || (dim_ != 0 && embedding.size() != dim_)) {
+        return false;
+    }
+
+    QuantizedEmbedding row = QuantizedEmbedding::encode(embedding, mode_);
+    if (row.norm() < 1e-9) {
+        return false;   // Vecteur nul : cosinus indéfini
+    }
+    dim_ = embedding.size();
+
+    auto it = rows_by_id_.find(id);
+    if (it != rows_by_id_.end()) {
+        rows_[it->second] = std::move(row);
+        return true;
+    }
+
+    rows_by_id_.emplace(id, rows_.size());
+    rows_.push_back(std::move(row));
+    ids_.push_back(id);
+    return true;
+}
+
+void SemanticIndex::erase(const std::string& id) {
+    auto it = rows_by_id_.find(id);
+    if (it == rows_by_id_.end()) {
+        return;
+    }
+
+    const size_t row = it->second;
+    rows_by_id_.erase(it);
+    const size_t last = rows_.size() - 1;
+    if (row != last) {
+        rows_[row] = std::move(rows_[last]);
+        ids_[row] = std::move(ids_[last]);
+        rows_by_id_[ids_[row]] = row;
+    }
+    rows_.pop_back();
+    ids_.pop_back();
+}
+
+void SemanticIndex::clear() {
+    rows_.clear();
+    ids_.clear();
+    rows_by_id_.clear();
+    dim_ = 0;
+}
+
+std::vector<SemanticHit> SemanticIndex::topK(
+    const std::vector<double>& query,
+    size_t k,
+    double threshold) const
+{
+    std::vector<SemanticHit> hits;
+    if (k == 0 || rows_.empty() || query.size() != dim_) {
+        return hits;
+    }
+
+    double norm = 0.0;
+    for (double v : query) norm += v * v;
+    norm = std::sqrt(norm);
+    if (norm < 1e-9) {
+        return hits;
+    }
+
+    // INT8 : requête quantifiée elle aussi, produits scalaires entiers
+    std::vector<float> unit;
+    QuantizedEmbedding quantized;
+    if (mode_ == EmbeddingQuantization::INT8) {
+        quantized = QuantizedEmbedding::encode(query, EmbeddingQuantization::INT8);
+        norm = quantized.norm();
+    } else {
+        unit.resize(dim_);
+        for (size_t i = 0; i < dim_; ++i) {
+            unit[i] = static_cast<float>(query[i] / norm);
+        }
+        norm = 1.0;
+    }
+
+    for (size_t row = 0; row < rows_.size(); ++row) {
+        const double dot = unit.empty() ? rows_[row].dot(quantized) : rows_[row].dot(unit.data());
+        const double similarity = dot / (norm * rows_[row].norm());
+        if (similarity >= threshold) {
+            hits.push_back(SemanticHit{ids_[row], similarity});
+        }
+    }
+
+    auto by_similarity = [](const SemanticHit& a, const SemanticHit& b) {
+        return a.similarity > b.similarity;
+    };
+
+    if (hits.size() > k) {
+        std::partial_sort(hits.begin(), hits.begin() + k, hits.end(), by_similarity);
+        hits.resize(k);
+    } else {
+        std::sort(hits.begin(), hits.end(), by_similarity);
+    }
+
+    return hits;
+}
+
+size_t SemanticIndex::memoryUsage() const {
+    // Nœud de table de hachage ≈ clé + valeur + chaînage
+    constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+    size_t bytes = sizeof(*this);
+    for (const auto& row : rows_) bytes += row.bytes();
+    for (const auto& id : ids_) bytes += sizeof(std::string) + id.capacity();
+    bytes += rows_by_id_.bucket_count() * sizeof(void*);
+    for (const auto& [id, row] : rows_by_id_) {
+        bytes += sizeof(std::string) + id.capacity() + sizeof(row) + HASH_NODE_OVERHEAD;
+    }
+    return bytes;
+}
+
+} // namespace mcee
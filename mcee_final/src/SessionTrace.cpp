@@ -0,0 +1,247 @@
+/**
+ * @file SessionTrace.cpp
+ * @brief Implémentation des traces de sessions (.mctr et JSONL)
+ */
+
+#include "SessionTrace.hpp"
+#include "EmotionWire.hpp"
+#include "Logger.hpp"
+#include "Types.hpp"
+#include <nlohmann/json.hpp>
+#include <bit>
+#include <chrono>
+#include <cstring>
+
+namespace mcee {
+
+static_assert(std::endian::native == std::endian::little,
+              "la trace binaire est lue en place : architecture little-endian requise");
+
+namespace {
+
+constexpr char MAGIC[4] = {'M', 'C', 'T', 'R'};
+constexpr size_t FILE_HEADER_SIZE = 8;
+constexpr size_t RECORD_HEADER_SIZE = 24;
+
+bool endsWith(const std::string& s, std::string_view suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void putU32(std::string& out, uint32_t v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+uint32_t getU32(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+bool fail(std::string* error, std::string what) {
+    if (error) *error = std::move(what);
+    return false;
+}
+
+} // namespace
+
+bool isBinaryTraceFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TraceWriter
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool TraceWriter::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (out_.is_open()) out_.close();
+
+    binary_ = endsWith(path, ".mctr");
+    const bool fresh = binary_ && !isBinaryTraceFile(path);
+
+    out_.open(path, binary_ ? std::ios::binary | (fresh ? std::ios::trunc : std::ios::app)
+                            : std::ios::app);
+    if (!out_) {
+        MCEE_LOG_ERROR("TraceWriter", "Impossible d'ouvrir la trace: ", path);
+        return false;
+    }
+
+    if (fresh) {
+        std::string header(MAGIC, sizeof(MAGIC));
+        putU32(header, SESSION_TRACE_VERSION);
+        out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+    recorded_ = 0;
+    MCEE_LOG_INFO("TraceWriter", "Enregistrement des sessions dans ", path,
+                  binary_ ? " (binaire)" : " (JSONL)");
+    return true;
+}
+
+void TraceWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (out_.is_open()) {
+        out_.flush();
+        out_.close();
+    }
+}
+
+void TraceWriter::record(std::string_view session, MCEEInput input, std::string_view body,
+                         std::string_view content_type) {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    write({std::chrono::duration<double>(now).count(), input, session, content_type, body});
+}
+
+void TraceWriter::write(const TraceRecord& record) {
+    std::string line;
+
+    if (binary_) {
+        line.reserve(RECORD_HEADER_SIZE + record.session.size() +
+                     record.content_type.size() + record.body.size());
+        line.append(reinterpret_cast<const char*>(&record.time), sizeof(double));
+        line.push_back(static_cast<char>(record.input));
+        line.append(3, '\0');
+        putU32(line, static_cast<uint32_t>(record.session.size()));
+        putU32(line, static_cast<uint32_t>(record.content_type.size()));
+        putU32(line, static_cast<uint32_t>(record.body.size()));
+        line.append(record.session);
+        line.append(record.content_type);
+        line.append(record.body);
+    } else {
+        nlohmann::json entry = {
+            {"t", record.time},
+            {"session", record.session},
+            {"input", mceeInputName(record.input)},
+            {"content_type", record.content_type}
+        };
+
+        // Une trame binaire n'a pas sa place dans du texte : elle est
+        // réécrite au format JSON que handleEmotionMessage accepte aussi
+        EmotionFrame frame;
+        if (isEmotionFrameContentType(std::string(record.content_type)) &&
+            decodeEmotionFrame(std::string(record.body), frame)) {
+            nlohmann::json emotions = nlohmann::json::object();
+            for (size_t i = 0; i < NUM_EMOTIONS; ++i) {
+                emotions[EMOTION_NAMES[i]] = frame.emotions[i];
+            }
+            entry["content_type"] = WIRE_CONTENT_TYPE_JSON;
+            entry["body"] = std::move(emotions);
+        } else {
+            entry["body"] = record.body;
+        }
+        line = entry.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+        line.push_back('\n');
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!out_.is_open()) return;
+    out_.write(line.data(), static_cast<std::streamsize>(line.size()));
+    ++recorded_;
+}
+
+void TraceWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (out_.is_open()) out_.flush();
+}
+
+size_t TraceWriter::recorded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recorded_;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TraceReader
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool TraceReader::open(const std::string& path, std::string* error) {
+    records_.clear();
+    storage_.clear();
+    file_.close();
+
+    if (isBinaryTraceFile(path)) {
+        if (!file_.open(path, error)) return false;
+        return parseBinary(error);
+    }
+    return parseJsonl(path, error);
+}
+
+bool TraceReader::parseBinary(std::string* error) {
+    const unsigned char* data = file_.data();
+    const size_t size = file_.size();
+
+    if (size < FILE_HEADER_SIZE || getU32(data + 4) != SESSION_TRACE_VERSION) {
+        return fail(error, "version de trace non supportée");
+    }
+
+    size_t offset = FILE_HEADER_SIZE;
+    while (offset < size) {
+        if (size - offset < RECORD_HEADER_SIZE) {
+            return fail(error, "enregistrement tronqué à l'octet " + std::to_string(offset));
+        }
+        const unsigned char* p = data + offset;
+
+        TraceRecord record;
+        std::memcpy(&record.time, p, sizeof(double));
+        if (p[8] > static_cast<uint8_t>(MCEEInput::TOKENS)) {
+            return fail(error, "flux inconnu à l'octet " + std::to_string(offset));
+        }
+        record.input = static_cast<MCEEInput>(p[8]);
+
+        const size_t session_len = getU32(p + 12);
+        const size_t ct_len = getU32(p + 16);
+        const size_t body_len = getU32(p + 20);
+        const size_t payload = session_len + ct_len + body_len;
+        if (size - offset - RECORD_HEADER_SIZE < payload) {
+            return fail(error, "enregistrement tronqué à l'octet " + std::to_string(offset));
+        }
+
+        const char* s = reinterpret_cast<const char*>(p + RECORD_HEADER_SIZE);
+        record.session = {s, session_len};
+        record.content_type = {s + session_len, ct_len};
+        record.body = {s + session_len + ct_len, body_len};
+        records_.push_back(record);
+
+        offset += RECORD_HEADER_SIZE + payload;
+    }
+    return true;
+}
+
+bool TraceReader::parseJsonl(const std::string& path, std::string* error) {
+    std::ifstream file(path);
+    if (!file) {
+        return fail(error, "impossible d'ouvrir " + path);
+    }
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        if (line.empty()) continue;
+
+        try {
+            auto entry = nlohmann::json::parse(line);
+            auto input = parseMCEEInput(entry.value("input", std::string("emotions")));
+            if (!input) {
+                return fail(error, "flux inconnu ligne " + std::to_string(line_number));
+            }
+
+            TraceRecord record;
+            record.time = entry.at("t").get<double>();
+            record.input = *input;
+            record.session = storage_.emplace_back(entry.value("session", std::string()));
+            record.content_type = storage_.emplace_back(entry.value("content_type", std::string()));
+
+            const auto& body = entry.at("body");
+            record.body = storage_.emplace_back(body.is_string() ? body.get<std::string>()
+                                                                 : body.dump());
+            records_.push_back(record);
+        } catch (const std::exception& e) {
+            return fail(error, "ligne " + std::to_string(line_number) + ": " + e.what());
+        }
+    }
+    return true;
+}
+
+} // namespace mcee
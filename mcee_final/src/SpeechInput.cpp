@@ -6,11 +6,11 @@
  */
 
 #include "SpeechInput.hpp"
+#include "Logger.hpp"
 #include <nlohmann/json.hpp>
 #include <algorithm>
 #include <sstream>
 #include <fstream>
-#include <iostream>
 #include <iomanip>
 #include <cctype>
 #include <regex>
@@ -19,14 +19,21 @@ namespace mcee {
 
 using json = nlohmann::json;
 
-SpeechInput::SpeechInput() {
-    initDefaultDictionaries();
-    std::cout << "[SpeechInput] Gestionnaire d'entrées textuelles initialisé\n";
-}
+namespace {
+
+constexpr size_t MAX_KEYWORDS = 10;
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// LEXIQUE
+// ═══════════════════════════════════════════════════════════════════════════
+
+std::shared_ptr<const SpeechLexicon> SpeechLexicon::createDefault() {
+    auto lexicon = std::make_shared<SpeechLexicon>();
 
-void SpeechInput::initDefaultDictionaries() {
     // Mots de menace / danger (français)
-    threat_words_ = {
+    lexicon->threat_words = {
         "danger", "menace", "attaque", "mort", "tuer", "mourir", "peur",
         "terrifiant", "horrible", "catastrophe", "urgence", "aide", "secours",
         "feu", "accident", "violence", "agression", "blessure", "douleur",
@@ -36,7 +43,7 @@ void SpeechInput::initDefaultDictionaries() {
     };
 
     // Mots positifs (français)
-    positive_words_ = {
+    lexicon->positive_words = {
         "bien", "bon", "super", "génial", "excellent", "parfait", "magnifique",
         "merveilleux", "fantastique", "incroyable", "heureux", "content", "joie",
         "amour", "aimer", "adorer", "plaisir", "bonheur", "succès", "victoire",
@@ -47,7 +54,7 @@ void SpeechInput::initDefaultDictionaries() {
     };
 
     // Mots négatifs (français)
-    negative_words_ = {
+    lexicon->negative_words = {
         "mal", "mauvais", "nul", "horrible", "terrible", "affreux", "détestable",
         "triste", "malheureux", "déprimé", "anxieux", "stressé", "inquiet",
         "colère", "furieux", "énervé", "agacé", "frustré", "déçu", "déception",
@@ -58,7 +65,7 @@ void SpeechInput::initDefaultDictionaries() {
     };
 
     // Mots à haute activation (arousal élevé)
-    high_arousal_words_ = {
+    lexicon->high_arousal_words = {
         "excité", "enthousiaste", "exalté", "électrisé", "survolté", "explosif",
         "intense", "passionné", "fougueux", "ardent", "vif", "dynamique",
         "urgent", "immédiat", "maintenant", "vite", "rapide", "cours", "fonce",
@@ -68,7 +75,7 @@ void SpeechInput::initDefaultDictionaries() {
     };
 
     // Mots à basse activation (arousal faible)
-    low_arousal_words_ = {
+    lexicon->low_arousal_words = {
         "calme", "tranquille", "paisible", "serein", "détendu", "relaxé",
         "lent", "doux", "tendre", "léger", "subtil", "discret", "silencieux",
         "fatigué", "épuisé", "las", "somnolent", "endormi", "assoupi",
@@ -76,40 +83,106 @@ void SpeechInput::initDefaultDictionaries() {
         "ennuyé", "monotone", "routinier", "ordinaire", "banal"
     };
 
-    // Scores émotionnels par mot (valence)
-    emotion_word_scores_ = {
-        // Très positif (+0.8 à +1.0)
-        {"adore", 0.9}, {"aime", 0.8}, {"bonheur", 0.95}, {"joie", 0.9},
-        {"merveilleux", 0.85}, {"fantastique", 0.85}, {"excellent", 0.8},
-        
-        // Positif (+0.4 à +0.7)
-        {"bien", 0.5}, {"bon", 0.5}, {"content", 0.6}, {"heureux", 0.7},
-        {"satisfait", 0.6}, {"agréable", 0.5}, {"plaisant", 0.5},
-        
-        // Légèrement positif (+0.1 à +0.3)
-        {"ok", 0.2}, {"correct", 0.2}, {"acceptable", 0.1},
-        
-        // Neutre (0)
-        {"peut-être", 0.0}, {"normal", 0.0}, {"ordinaire", 0.0},
-        
-        // Légèrement négatif (-0.1 à -0.3)
-        {"bof", -0.2}, {"moyen", -0.1}, {"passable", -0.2},
-        
-        // Négatif (-0.4 à -0.7)
-        {"mal", -0.5}, {"mauvais", -0.5}, {"triste", -0.6}, {"déçu", -0.5},
-        {"ennuyé", -0.4}, {"fatigué", -0.4}, {"stressé", -0.5},
-        
-        // Très négatif (-0.8 à -1.0)
-        {"déteste", -0.9}, {"horrible", -0.85}, {"terrible", -0.8},
-        {"catastrophe", -0.9}, {"mort", -0.95}, {"peur", -0.7},
-        {"terreur", -0.9}, {"horreur", -0.9}, {"panique", -0.8}
+    // Scores émotionnels par mot (valence), communs avec la LemmaTable
+    for (const auto& [word, score] : LemmaTable::defaultEmotionScores()) {
+        lexicon->emotion_word_scores.emplace(word, score);
+    }
+
+    lexicon->compile();
+
+    MCEE_LOG_INFO("SpeechInput",
+        "Dictionnaires initialisés: ", lexicon->threat_words.size(), " menaces, ",
+        lexicon->positive_words.size(), " positifs, ", lexicon->negative_words.size(), " négatifs, ",
+        lexicon->emotion_word_scores.size(), " scores émotionnels");
+    return lexicon;
+}
+
+void SpeechLexicon::compile() {
+    auto& lemmas = LemmaTable::instance();
+    compiled.clear();
+    auto entry = [&](LemmaId id) -> Entry& {
+        auto& e = compiled[lemmas.text(id)];
+        e.lemma = id;
+        e.lemma_flags = lemmas.flags(id);
+        return e;
     };
+    auto mark = [&](const auto& words, uint16_t flag) {
+        for (const auto& w : words) {
+            entry(lemmas.intern(w)).flags |= flag;
+        }
+    };
+    mark(threat_words, Entry::THREAT);
+    mark(positive_words, Entry::POSITIVE);
+    mark(negative_words, Entry::NEGATIVE);
+    mark(high_arousal_words, Entry::HIGH_AROUSAL);
+    mark(low_arousal_words, Entry::LOW_AROUSAL);
+    for (const auto& [word, score] : emotion_word_scores) {
+        auto& e = entry(lemmas.intern(word));
+        e.flags |= Entry::SCORED;
+        e.score = score;
+    }
 
-    std::cout << "[SpeechInput] Dictionnaires initialisés:\n"
-              << "  - Mots de menace: " << threat_words_.size() << "\n"
-              << "  - Mots positifs: " << positive_words_.size() << "\n"
-              << "  - Mots négatifs: " << negative_words_.size() << "\n"
-              << "  - Scores émotionnels: " << emotion_word_scores_.size() << "\n";
+    // Mots vides et d'urgence : internés dès la construction de la table
+    constexpr uint16_t CLASSES = LemmaTable::STOP_WORD | LemmaTable::URGENCY;
+    for (size_t id = 0, n = lemmas.size(); id < n; ++id) {
+        if (lemmas.flags(static_cast<LemmaId>(id)) & CLASSES) {
+            entry(static_cast<LemmaId>(id));
+        }
+    }
+}
+
+size_t SpeechLexicon::memoryUsage() const {
+    // Nœud de table de hachage ≈ valeur + chaînage + tampon de la chaîne
+    auto words = [](const auto& set) {
+        size_t bytes = set.bucket_count() * sizeof(void*);
+        for (const auto& w : set) bytes += sizeof(w) + 2 * sizeof(void*) + w.capacity();
+        return bytes;
+    };
+    size_t bytes = sizeof(*this);
+    bytes += words(threat_words) + words(positive_words) + words(negative_words);
+    bytes += words(high_arousal_words) + words(low_arousal_words);
+    bytes += emotion_word_scores.bucket_count() * sizeof(void*);
+    for (const auto& [w, score] : emotion_word_scores) {
+        bytes += sizeof(w) + sizeof(score) + 2 * sizeof(void*) + w.capacity();
+    }
+    bytes += compiled.bucket_count() * sizeof(void*);
+    bytes += compiled.size() * (sizeof(std::string_view) + sizeof(Entry) + 2 * sizeof(void*));
+    return bytes;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// SPEECH INPUT
+// ═══════════════════════════════════════════════════════════════════════════
+
+SpeechInput::SpeechInput()
+    : SpeechInput(SpeechLexicon::createDefault())
+{
+}
+
+SpeechInput::SpeechInput(std::shared_ptr<const SpeechLexicon> lexicon)
+    : lexicon_(std::move(lexicon))
+{
+    MCEE_LOG_INFO("SpeechInput", "Gestionnaire d'entrées textuelles initialisé");
+}
+
+size_t SpeechInput::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    size_t bytes = sizeof(*this);
+    bytes += analysis_history_.capacity() * sizeof(SpeechAnalysis);
+    for (const auto& analysis : analysis_history_) {
+        bytes += analysis.raw_text.capacity() + analysis.normalized_text.capacity();
+        for (const auto& w : analysis.keywords) bytes += sizeof(w) + w.capacity();
+        for (const auto& w : analysis.emotion_words) bytes += sizeof(w) + w.capacity();
+    }
+    return bytes;
+}
+
+void SpeechInput::updateLexicon(const std::function<void(SpeechLexicon&)>& edit) {
+    // Les autres détenteurs gardent l'ancien lexique, intact
+    auto next = std::make_shared<SpeechLexicon>(*lexicon_);
+    edit(*next);
+    next->compile();
+    lexicon_ = std::move(next);
 }
 
 SpeechAnalysis SpeechInput::processText(const TextInput& input) {
@@ -118,44 +191,21 @@ SpeechAnalysis SpeechInput::processText(const TextInput& input) {
     analysis.timestamp = input.timestamp;
 
     // Normaliser le texte
-    analysis.normalized_text = normalizeText(input.text);
-
-    // Tokenizer
-    auto tokens = tokenize(analysis.normalized_text);
+    bool has_question_mark = false;
+    analysis.normalized_text = normalizeText(input.text, &has_question_mark);
 
-    if (tokens.empty()) {
+    // Analyse en une passe sur le lexique compilé
+    size_t urgency_keywords = 0;
+    if (analyzeTokens(analysis.normalized_text, analysis, urgency_keywords) == 0) {
         updateHistory(analysis);
         return analysis;
     }
 
-    // Analyser le sentiment
-    analysis.sentiment_score = analyzeSentiment(tokens);
-
-    // Analyser l'arousal
-    analysis.arousal_score = analyzeArousal(tokens);
-
-    // Détecter les menaces
-    analysis.contains_threat = detectThreats(tokens);
-
-    // Détecter le positif
-    analysis.contains_positive = std::any_of(tokens.begin(), tokens.end(),
-        [this](const std::string& t) { return positive_words_.count(t) > 0; });
-
     // Détecter les questions
-    analysis.contains_question = (input.text.find('?') != std::string::npos) ||
-        (analysis.normalized_text.find("pourquoi") != std::string::npos) ||
-        (analysis.normalized_text.find("comment") != std::string::npos) ||
-        (analysis.normalized_text.find("quoi") != std::string::npos) ||
-        (analysis.normalized_text.find("qui") != std::string::npos);
-
-    // Extraire les mots-clés
-    analysis.keywords = extractKeywords(tokens);
-
-    // Extraire les mots émotionnels
-    analysis.emotion_words = extractEmotionWords(tokens);
+    analysis.contains_question = analysis.contains_question || has_question_mark;
 
     // Calculer le score d'urgence
-    analysis.urgency_score = computeUrgencyScore(analysis);
+    analysis.urgency_score = computeUrgencyScore(analysis, urgency_keywords);
 
     // Mettre à jour les statistiques
     processed_count_++;
@@ -175,12 +225,11 @@ SpeechAnalysis SpeechInput::processText(const TextInput& input) {
     }
 
     // Log
-    std::cout << "[SpeechInput] Texte traité:\n"
-              << "  Texte: \"" << (input.text.length() > 50 ? input.text.substr(0, 50) + "..." : input.text) << "\"\n"
-              << "  Sentiment: " << std::fixed << std::setprecision(2) << analysis.sentiment_score << "\n"
-              << "  Arousal: " << analysis.arousal_score << "\n"
-              << "  Urgence: " << analysis.urgency_score << "\n"
-              << "  Menace: " << (analysis.contains_threat ? "OUI" : "non") << "\n";
+    MCEE_LOG_DEBUG("SpeechInput",
+        "Texte traité: \"", (input.text.length() > 50 ? input.text.substr(0, 50) + "..." : input.text),
+        "\" sentiment=", std::fixed, std::setprecision(2), analysis.sentiment_score,
+        " arousal=", analysis.arousal_score, " urgence=", analysis.urgency_score,
+        " menace=", (analysis.contains_threat ? "OUI" : "non"));
 
     return analysis;
 }
@@ -275,227 +324,188 @@ void SpeechInput::setUrgencyCallback(UrgencyCallback callback) {
 
 void SpeechInput::addCustomKeywords(const std::string& category, 
                                      const std::vector<std::string>& words) {
-    if (category == "threat") {
-        for (const auto& w : words) threat_words_.insert(w);
-    } else if (category == "positive") {
-        for (const auto& w : words) positive_words_.insert(w);
-    } else if (category == "negative") {
-        for (const auto& w : words) negative_words_.insert(w);
-    } else if (category == "high_arousal") {
-        for (const auto& w : words) high_arousal_words_.insert(w);
-    } else if (category == "low_arousal") {
-        for (const auto& w : words) low_arousal_words_.insert(w);
-    }
+    updateLexicon([&](SpeechLexicon& lexicon) {
+        if (category == "threat") {
+            for (const auto& w : words) lexicon.threat_words.insert(w);
+        } else if (category == "positive") {
+            for (const auto& w : words) lexicon.positive_words.insert(w);
+        } else if (category == "negative") {
+            for (const auto& w : words) lexicon.negative_words.insert(w);
+        } else if (category == "high_arousal") {
+            for (const auto& w : words) lexicon.high_arousal_words.insert(w);
+        } else if (category == "low_arousal") {
+            for (const auto& w : words) lexicon.low_arousal_words.insert(w);
+        }
+    });
 }
 
 bool SpeechInput::loadEmotionalDictionary(const std::string& path) {
     try {
         std::ifstream file(path);
         if (!file) {
-            std::cerr << "[SpeechInput] Fichier non trouvé: " << path << "\n";
+            MCEE_LOG_ERROR("SpeechInput", "Fichier non trouvé: ", path);
             return false;
         }
 
         json dict;
         file >> dict;
 
-        if (dict.contains("threat_words")) {
-            for (const auto& w : dict["threat_words"]) {
-                threat_words_.insert(w.get<std::string>());
+        updateLexicon([&](SpeechLexicon& lexicon) {
+            if (dict.contains("threat_words")) {
+                for (const auto& w : dict["threat_words"]) {
+                    lexicon.threat_words.insert(w.get<std::string>());
+                }
             }
-        }
 
-        if (dict.contains("positive_words")) {
-            for (const auto& w : dict["positive_words"]) {
-                positive_words_.insert(w.get<std::string>());
+            if (dict.contains("positive_words")) {
+                for (const auto& w : dict["positive_words"]) {
+                    lexicon.positive_words.insert(w.get<std::string>());
+                }
             }
-        }
 
-        if (dict.contains("negative_words")) {
-            for (const auto& w : dict["negative_words"]) {
-                negative_words_.insert(w.get<std::string>());
+            if (dict.contains("negative_words")) {
+                for (const auto& w : dict["negative_words"]) {
+                    lexicon.negative_words.insert(w.get<std::string>());
+                }
             }
-        }
 
-        if (dict.contains("emotion_scores")) {
-            for (auto& [word, score] : dict["emotion_scores"].items()) {
-                emotion_word_scores_[word] = score.get<double>();
+            if (dict.contains("emotion_scores")) {
+                for (auto& [word, score] : dict["emotion_scores"].items()) {
+                    lexicon.emotion_word_scores[word] = score.get<double>();
+                }
             }
-        }
+        });
 
-        std::cout << "[SpeechInput] Dictionnaire chargé depuis " << path << "\n";
+        MCEE_LOG_INFO("SpeechInput", "Dictionnaire chargé depuis ", path);
         return true;
 
     } catch (const std::exception& e) {
-        std::cerr << "[SpeechInput] Erreur chargement dictionnaire: " << e.what() << "\n";
+        MCEE_LOG_ERROR("SpeechInput", "Erreur chargement dictionnaire: ", e.what());
         return false;
     }
 }
 
-std::string SpeechInput::normalizeText(const std::string& text) const {
+std::string SpeechInput::normalizeText(const std::string& text, bool* has_question_mark) const {
     std::string normalized;
     normalized.reserve(text.size());
 
+    // Espaces multiples fusionnés et rognés au fil de l'eau
+    bool pending_space = false;
     for (unsigned char c : text) {
-        if (std::isalpha(c) || c == ' ' || c == '\'') {
-            normalized += std::tolower(c);
+        char out;
+        if (std::isalpha(c) || c == '\'') {
+            out = static_cast<char>(std::tolower(c));
         } else if (std::isspace(c)) {
-            normalized += ' ';
+            pending_space = true;
+            continue;
         }
         // Gérer les caractères accentués (UTF-8 simplifié)
         else if (c >= 0xC0) {
-            normalized += c;  // Garder les caractères UTF-8
-        }
-    }
-
-    // Supprimer les espaces multiples
-    auto new_end = std::unique(normalized.begin(), normalized.end(),
-        [](char a, char b) { return a == ' ' && b == ' '; });
-    normalized.erase(new_end, normalized.end());
-
-    // Trim
-    size_t start = normalized.find_first_not_of(' ');
-    size_t end = normalized.find_last_not_of(' ');
-    if (start != std::string::npos && end != std::string::npos) {
-        return normalized.substr(start, end - start + 1);
-    }
-
-    return normalized;
-}
-
-std::vector<std::string> SpeechInput::tokenize(const std::string& text) const {
-    std::vector<std::string> tokens;
-    std::istringstream stream(text);
-    std::string word;
-
-    while (stream >> word) {
-        // Supprimer les apostrophes en début/fin
-        while (!word.empty() && (word.front() == '\'' || word.front() == ' ')) {
-            word.erase(0, 1);
-        }
-        while (!word.empty() && (word.back() == '\'' || word.back() == ' ')) {
-            word.pop_back();
+            out = static_cast<char>(c);  // Garder les caractères UTF-8
+        } else {
+            if (c == '?' && has_question_mark) {
+                *has_question_mark = true;
+            }
+            continue;
         }
 
-        if (!word.empty() && word.length() > 1) {
-            tokens.push_back(word);
+        if (pending_space && !normalized.empty()) {
+            normalized += ' ';
         }
+        pending_space = false;
+        normalized += out;
     }
 
-    return tokens;
+    return normalized;
 }
 
-double SpeechInput::analyzeSentiment(const std::vector<std::string>& tokens) const {
-    if (tokens.empty()) return 0.0;
-
+size_t SpeechInput::analyzeTokens(std::string_view normalized, SpeechAnalysis& analysis,
+                                  size_t& urgency_keywords) const {
+    size_t token_count = 0;
     double total_score = 0.0;
     int scored_words = 0;
+    int high_count = 0;
+    int low_count = 0;
+    bool question = false;
+
+    size_t pos = 0;
+    while (pos < normalized.size()) {
+        size_t end = normalized.find(' ', pos);
+        if (end == std::string_view::npos) end = normalized.size();
+        std::string_view word = normalized.substr(pos, end - pos);
+        pos = end + 1;
+
+        // Interrogatifs (sous-chaînes : "pourquoi" contient "quoi")
+        if (!question &&
+            (word.find("qui") != std::string_view::npos ||
+             word.find("quoi") != std::string_view::npos ||
+             word.find("comment") != std::string_view::npos)) {
+            question = true;
+        }
 
-    for (const auto& token : tokens) {
-        // Vérifier le dictionnaire de scores
-        auto it = emotion_word_scores_.find(token);
-        if (it != emotion_word_scores_.end()) {
-            total_score += it->second;
-            scored_words++;
+        // Supprimer les apostrophes en début/fin
+        while (!word.empty() && word.front() == '\'') word.remove_prefix(1);
+        while (!word.empty() && word.back() == '\'') word.remove_suffix(1);
+        if (word.length() <= 1) {
             continue;
         }
+        ++token_count;
+
+        // Aucun internement depuis le texte libre : hors lexique, aucune classe
+        const SpeechLexicon::Entry* entry = lexicon_->lookup(word);
+        const uint16_t flags = entry ? entry->flags : 0;
+        const uint16_t lemma_flags = entry ? entry->lemma_flags : 0;
 
-        // Vérifier les listes positives/négatives
-        if (positive_words_.count(token) > 0) {
+        // Sentiment : score explicite, sinon listes positives/négatives
+        if (flags & SpeechLexicon::Entry::SCORED) {
+            total_score += entry->score;
+            scored_words++;
+        } else if (flags & SpeechLexicon::Entry::POSITIVE) {
             total_score += 0.5;
             scored_words++;
-        } else if (negative_words_.count(token) > 0) {
+        } else if (flags & SpeechLexicon::Entry::NEGATIVE) {
             total_score -= 0.5;
             scored_words++;
         }
-    }
-
-    if (scored_words == 0) return 0.0;
 
-    return std::clamp(total_score / scored_words, -1.0, 1.0);
-}
-
-double SpeechInput::analyzeArousal(const std::vector<std::string>& tokens) const {
-    if (tokens.empty()) return 0.5;
-
-    int high_count = 0;
-    int low_count = 0;
-
-    for (const auto& token : tokens) {
-        if (high_arousal_words_.count(token) > 0) {
+        // Arousal
+        if (flags & SpeechLexicon::Entry::HIGH_AROUSAL) {
             high_count++;
-        } else if (low_arousal_words_.count(token) > 0) {
+        } else if (flags & SpeechLexicon::Entry::LOW_AROUSAL) {
             low_count++;
         }
-    }
 
-    if (high_count == 0 && low_count == 0) return 0.5;
+        if (flags & SpeechLexicon::Entry::THREAT) analysis.contains_threat = true;
+        if (flags & SpeechLexicon::Entry::POSITIVE) analysis.contains_positive = true;
 
-    double ratio = static_cast<double>(high_count) / (high_count + low_count);
-    return ratio;
-}
-
-bool SpeechInput::detectThreats(const std::vector<std::string>& tokens) const {
-    for (const auto& token : tokens) {
-        if (threat_words_.count(token) > 0) {
-            return true;
+        // Mots-clés : 10 premiers mots distincts hors stop words
+        if (word.length() > 2 && !(lemma_flags & LemmaTable::STOP_WORD) &&
+            analysis.keywords.size() < MAX_KEYWORDS &&
+            std::find(analysis.keywords.begin(), analysis.keywords.end(), word) == analysis.keywords.end()) {
+            analysis.keywords.emplace_back(word);
+            if (lemma_flags & LemmaTable::URGENCY) urgency_keywords++;
         }
-    }
-    return false;
-}
-
-std::vector<std::string> SpeechInput::extractKeywords(
-    const std::vector<std::string>& tokens) const 
-{
-    std::vector<std::string> keywords;
-    
-    // Mots à ignorer (stop words français)
-    static const std::unordered_set<std::string> stop_words = {
-        "le", "la", "les", "un", "une", "des", "du", "de", "et", "ou",
-        "je", "tu", "il", "elle", "nous", "vous", "ils", "elles",
-        "ce", "cette", "ces", "mon", "ma", "mes", "ton", "ta", "tes",
-        "son", "sa", "ses", "notre", "votre", "leur", "leurs",
-        "qui", "que", "quoi", "dont", "où", "est", "sont", "suis",
-        "ai", "as", "avons", "avez", "ont", "être", "avoir",
-        "pour", "avec", "sans", "dans", "sur", "sous", "par",
-        "ne", "pas", "plus", "moins", "très", "trop", "aussi"
-    };
 
-    for (const auto& token : tokens) {
-        if (token.length() > 2 && stop_words.count(token) == 0) {
-            // Vérifier si pas déjà présent
-            if (std::find(keywords.begin(), keywords.end(), token) == keywords.end()) {
-                keywords.push_back(token);
-            }
+        // Mots émotionnels
+        if (flags & (SpeechLexicon::Entry::SCORED | SpeechLexicon::Entry::POSITIVE |
+                     SpeechLexicon::Entry::NEGATIVE | SpeechLexicon::Entry::THREAT)) {
+            analysis.emotion_words.emplace_back(word);
         }
     }
 
-    // Limiter à 10 mots-clés
-    if (keywords.size() > 10) {
-        keywords.resize(10);
-    }
-
-    return keywords;
-}
-
-std::vector<std::string> SpeechInput::extractEmotionWords(
-    const std::vector<std::string>& tokens) const 
-{
-    std::vector<std::string> emotion_words;
-
-    for (const auto& token : tokens) {
-        if (emotion_word_scores_.count(token) > 0 ||
-            positive_words_.count(token) > 0 ||
-            negative_words_.count(token) > 0 ||
-            threat_words_.count(token) > 0) {
-            emotion_words.push_back(token);
-        }
+    if (token_count == 0) {
+        return 0;
     }
 
-    return emotion_words;
+    analysis.sentiment_score = scored_words == 0 ? 0.0
+        : std::clamp(total_score / scored_words, -1.0, 1.0);
+    analysis.arousal_score = (high_count == 0 && low_count == 0) ? 0.5
+        : static_cast<double>(high_count) / (high_count + low_count);
+    analysis.contains_question = question;
+    return token_count;
 }
 
-double SpeechInput::computeUrgencyScore(const SpeechAnalysis& analysis) const {
+double SpeechInput::computeUrgencyScore(const SpeechAnalysis& analysis, size_t urgency_keywords) const {
     double urgency = 0.0;
 
     // Menace détectée = urgence élevée
@@ -512,15 +522,8 @@ double SpeechInput::computeUrgencyScore(const SpeechAnalysis& analysis) const {
     }
 
     // Mots d'urgence spécifiques
-    static const std::unordered_set<std::string> urgency_words = {
-        "urgence", "urgent", "vite", "maintenant", "immédiatement",
-        "aide", "secours", "sos", "danger", "alerte", "attention"
-    };
-
-    for (const auto& kw : analysis.keywords) {
-        if (urgency_words.count(kw) > 0) {
-            urgency += 0.2;
-        }
+    for (size_t i = 0; i < urgency_keywords; ++i) {
+        urgency += 0.2;
     }
 
     return std::clamp(urgency, 0.0, 1.0);
@@ -0,0 +1,524 @@
+/**
+ * @file StateJournal.cpp
+ * @brief WAL à validation groupée et checkpoints de l'état du moteur
+ */
+
+#include "StateJournal.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mcee {
+
+static_assert(std::endian::native == std::endian::little,
+              "le journal est relu en place : architecture little-endian requise");
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char WAL_MAGIC[4] = {'M', 'C', 'W', 'L'};
+constexpr char CHECKPOINT_MAGIC[4] = {'M', 'C', 'K', 'P'};
+constexpr size_t SEGMENT_HEADER_SIZE = 16;      // magic, version u32, premier seq u64
+constexpr size_t RECORD_HEADER_SIZE = 24;       // taille u32, type u8, 3 nuls, seq u64, checksum u64
+constexpr size_t CHECKSUMMED_HEADER_SIZE = 16;  // Champs couverts par le checksum (hors checksum)
+constexpr size_t CHECKPOINT_HEADER_SIZE = 32;   // magic, version u32, seq u64, taille u64, checksum u64
+constexpr const char* CHECKPOINT_FILE = "checkpoint.bin";
+
+// FNV-1a par mots de 64 bits (puis octets restants), chaînable
+uint64_t checksum(const unsigned char* data, size_t size, uint64_t h = 1469598103934665603ull) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h ^= word;
+        h *= 1099511628211ull;
+    }
+    for (; i < size; ++i) {
+        h ^= data[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T get(const unsigned char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+std::string seqName(const char* prefix, uint64_t seq, const char* suffix) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s%020llu%s", prefix, static_cast<unsigned long long>(seq), suffix);
+    return name;
+}
+
+/**
+ * @brief Segments du répertoire, par premier numéro croissant
+ */
+std::vector<std::pair<uint64_t, std::string>> listSegments(const std::string& directory) {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() != 28 || name.rfind("wal-", 0) != 0 || name.compare(24, 4, ".log") != 0) {
+            continue;
+        }
+        segments.emplace_back(std::stoull(name.substr(4, 20)), entry.path().string());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool fail(std::string* error, std::string what) {
+    if (error) *error = std::move(what);
+    return false;
+}
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════════
+// REPRISE
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool StateJournal::readCheckpoint(const std::string& directory, JournalRecovery& recovery,
+                                  std::string* error) {
+    const std::string path = (fs::path(directory) / CHECKPOINT_FILE).string();
+    std::error_code ec;
+    if (!fs::exists(path, ec)) {
+        return true;  // Premier démarrage
+    }
+
+    MappedFile file;
+    std::string open_error;
+    if (!file.open(path, &open_error)) {
+        return fail(error, path + ": " + open_error);
+    }
+    const unsigned char* data = file.data();
+    if (file.size() < CHECKPOINT_HEADER_SIZE || std::memcmp(data, CHECKPOINT_MAGIC, 4) != 0) {
+        return fail(error, path + ": signature invalide");
+    }
+    if (get<uint32_t>(data + 4) != STATE_JOURNAL_VERSION) {
+        return fail(error, path + ": version non supportée");
+    }
+    const uint64_t seq = get<uint64_t>(data + 8);
+    const uint64_t size = get<uint64_t>(data + 16);
+    if (size != file.size() - CHECKPOINT_HEADER_SIZE ||
+        checksum(data + CHECKPOINT_HEADER_SIZE, size) != get<uint64_t>(data + 24)) {
+        return fail(error, path + ": checksum invalide");
+    }
+
+    try {
+        recovery.state = nlohmann::json::from_cbor(data + CHECKPOINT_HEADER_SIZE,
+                                                   data + CHECKPOINT_HEADER_SIZE + size);
+    } catch (const std::exception& e) {
+        return fail(error, path + ": " + e.what());
+    }
+
+    recovery.has_checkpoint = true;
+    recovery.checkpoint_seq = seq;
+    recovery.last_seq = std::max(recovery.last_seq, seq);
+    const std::string patterns = recovery.state.value("patterns", std::string());
+    recovery.patterns_path = patterns.empty() ? std::string() : (fs::path(directory) / patterns).string();
+    return true;
+}
+
+void StateJournal::replay(const std::string& directory, JournalRecovery& recovery,
+                          const std::function<void(const JournalRecord&)>& apply) {
+    for (const auto& [first_seq, path] : listSegments(directory)) {
+        MappedFile file;
+        if (!file.open(path)) continue;  // Segment vide
+        const unsigned char* data = file.data();
+        const size_t size = file.size();
+        if (size < SEGMENT_HEADER_SIZE || std::memcmp(data, WAL_MAGIC, 4) != 0 ||
+            get<uint32_t>(data + 4) != STATE_JOURNAL_VERSION) {
+            MCEE_LOG_WARN("StateJournal", "Segment ignoré (en-tête invalide): ", path);
+            continue;
+        }
+
+        size_t offset = SEGMENT_HEADER_SIZE;
+        while (offset < size) {
+            const unsigned char* header = data + offset;
+            const uint32_t payload_size = offset + RECORD_HEADER_SIZE <= size ? get<uint32_t>(header) : 0;
+            if (offset + RECORD_HEADER_SIZE > size ||
+                payload_size > size - offset - RECORD_HEADER_SIZE ||
+                checksum(header + RECORD_HEADER_SIZE, payload_size,
+                         checksum(header, CHECKSUMMED_HEADER_SIZE)) != get<uint64_t>(header + 16)) {
+                // Écriture interrompue : la suite du segment n'a jamais été validée
+                recovery.truncated_segments++;
+                MCEE_LOG_WARN("StateJournal", "Fin de segment invalide ignorée: ", path,
+                              " (", size - offset, " octets)");
+                break;
+            }
+
+            JournalRecord record;
+            record.type = static_cast<JournalRecordType>(header[4]);
+            record.seq = get<uint64_t>(header + 8);
+            record.payload = std::string_view(reinterpret_cast<const char*>(header + RECORD_HEADER_SIZE),
+                                              payload_size);
+            // last_seq part du checkpoint : seuls les enregistrements postérieurs sont rejoués
+            if (record.seq > recovery.last_seq) {
+                apply(record);
+                recovery.replayed++;
+                recovery.last_seq = record.seq;
+            }
+            offset += RECORD_HEADER_SIZE + payload_size;
+        }
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// OUVERTURE / FERMETURE
+// ═══════════════════════════════════════════════════════════════════════════
+
+StateJournal::~StateJournal() {
+    close();
+}
+
+bool StateJournal::open(const JournalConfig& config, uint64_t last_seq) {
+    close();
+    config_ = config;
+
+    std::error_code ec;
+    fs::create_directories(config_.directory, ec);
+    if (ec) {
+        MCEE_LOG_ERROR("StateJournal", "Répertoire inutilisable ", config_.directory, ": ", ec.message());
+        return false;
+    }
+
+    segments_ = listSegments(config_.directory);
+    seq_ = last_seq;
+    durable_seq_ = last_seq;
+    pending_.clear();
+    if (!openSegment(last_seq + 1)) {
+        return false;
+    }
+
+    since_checkpoint_.store(0, std::memory_order_relaxed);
+    next_checkpoint_ns_.store(
+        (std::chrono::steady_clock::now().time_since_epoch() +
+         std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::duration<double>(config_.checkpoint_interval_seconds))).count(),
+        std::memory_order_relaxed);
+
+    stopping_ = false;
+    open_.store(true, std::memory_order_release);
+    thread_ = std::thread(&StateJournal::commitLoop, this);
+
+    MCEE_LOG_INFO("StateJournal", "Journal ouvert dans ", config_.directory, " (seq ", last_seq,
+                  ", lot ", config_.commit_interval_ms, " ms", config_.sync ? ", fdatasync" : "", ")");
+    return true;
+}
+
+void StateJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_.load(std::memory_order_acquire)) return;
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) thread_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_.store(false, std::memory_order_release);
+    committed_.notify_all();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool StateJournal::openSegment(uint64_t first_seq) {
+    const std::string path = (fs::path(config_.directory) / seqName("wal-", first_seq, ".log")).string();
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        MCEE_LOG_ERROR("StateJournal", "Segment impossible à créer ", path, ": ", std::strerror(errno));
+        return false;
+    }
+
+    std::string header(WAL_MAGIC, sizeof(WAL_MAGIC));
+    put(header, STATE_JOURNAL_VERSION);
+    put(header, first_seq);
+    if (::write(fd, header.data(), header.size()) != static_cast<ssize_t>(header.size())) {
+        MCEE_LOG_ERROR("StateJournal", "En-tête de segment non écrit ", path, ": ", std::strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = fd;
+    std::erase_if(segments_, [&](const auto& segment) { return segment.first == first_seq; });
+    segments_.emplace_back(first_seq, path);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// AJOUT ET VALIDATION GROUPÉE
+// ═══════════════════════════════════════════════════════════════════════════
+
+uint64_t StateJournal::append(JournalRecordType type, std::string_view payload) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_.load(std::memory_order_relaxed) || stopping_) return 0;
+
+    const uint64_t seq = ++seq_;
+    const size_t start = pending_.size();
+    put(pending_, static_cast<uint32_t>(payload.size()));
+    pending_.push_back(static_cast<char>(type));
+    pending_.append(3, '\0');
+    put(pending_, seq);
+    put(pending_, uint64_t{0});
+    pending_.append(payload);
+
+    auto* header = reinterpret_cast<unsigned char*>(pending_.data() + start);
+    const uint64_t sum = checksum(header + RECORD_HEADER_SIZE, payload.size(),
+                                  checksum(header, CHECKSUMMED_HEADER_SIZE));
+    std::memcpy(header + 16, &sum, sizeof(sum));
+
+    const bool full = pending_.size() >= config_.group_commit_bytes;
+    lock.unlock();
+
+    appended_.fetch_add(1, std::memory_order_relaxed);
+    since_checkpoint_.fetch_add(1, std::memory_order_relaxed);
+    if (full) wake_.notify_one();
+    return seq;
+}
+
+void StateJournal::commit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!open_.load(std::memory_order_relaxed)) return;
+    const uint64_t target = seq_;
+    commit_requested_ = true;
+    wake_.notify_one();
+    committed_.wait(lock, [&] { return durable_seq_ >= target || !open_.load(std::memory_order_relaxed); });
+}
+
+uint64_t StateJournal::lastSeq() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return seq_;
+}
+
+void StateJournal::commitLoop() {
+    const auto interval = std::chrono::milliseconds(std::max(1, config_.commit_interval_ms));
+    std::string batch;
+
+    for (;;) {
+        PendingCheckpoint checkpoint;
+        bool has_checkpoint = false;
+        bool stopping = false;
+        uint64_t batch_seq = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, interval, [&] {
+                return stopping_ || commit_requested_ || has_checkpoint_ ||
+                       pending_.size() >= config_.group_commit_bytes;
+            });
+            batch.swap(pending_);
+            batch_seq = seq_;
+            commit_requested_ = false;
+            if (has_checkpoint_) {
+                checkpoint = std::move(checkpoint_);
+                has_checkpoint_ = false;
+                has_checkpoint = true;
+            }
+            stopping = stopping_;
+        }
+
+        // Un seul write + fdatasync pour tout le lot
+        if (!batch.empty()) {
+            writeBatch(batch);
+            batch.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            durable_seq_ = batch_seq;
+        }
+        committed_.notify_all();
+
+        if (has_checkpoint) {
+            writeCheckpoint(checkpoint);
+        }
+
+        if (stopping) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty() && !has_checkpoint_) break;
+        }
+    }
+}
+
+bool StateJournal::writeBatch(const std::string& batch) {
+    const char* p = batch.data();
+    size_t remaining = batch.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(fd_, p, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            MCEE_LOG_ERROR("StateJournal", "Écriture du journal impossible: ", std::strerror(errno));
+            return false;
+        }
+        p += written;
+        remaining -= static_cast<size_t>(written);
+    }
+
+    if (config_.sync && ::fdatasync(fd_) != 0) {
+        MCEE_LOG_ERROR("StateJournal", "Synchronisation du journal impossible: ", std::strerror(errno));
+        return false;
+    }
+    commits_.fetch_add(1, std::memory_order_relaxed);
+    bytes_written_.fetch_add(batch.size(), std::memory_order_relaxed);
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// CHECKPOINTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool StateJournal::checkpointDue(bool force) const {
+    if (!open_.load(std::memory_order_acquire) || checkpoint_in_flight_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    const uint64_t since = since_checkpoint_.load(std::memory_order_relaxed);
+    if (since == 0) return false;
+    if (force) return true;
+    if (config_.checkpoint_every_records > 0 && since >= config_.checkpoint_every_records) return true;
+    return std::chrono::steady_clock::now().time_since_epoch().count() >=
+           next_checkpoint_ns_.load(std::memory_order_relaxed);
+}
+
+bool StateJournal::beginCheckpoint(bool force) {
+    if (!checkpointDue(force)) return false;
+
+    bool expected = false;
+    if (!checkpoint_in_flight_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return false;
+    }
+    since_checkpoint_.store(0, std::memory_order_relaxed);
+    next_checkpoint_ns_.store(
+        (std::chrono::steady_clock::now().time_since_epoch() +
+         std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::duration<double>(config_.checkpoint_interval_seconds))).count(),
+        std::memory_order_relaxed);
+    return true;
+}
+
+void StateJournal::abandonCheckpoint() {
+    uint64_t uncovered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uncovered = seq_ - last_checkpoint_seq_.load(std::memory_order_relaxed);
+    }
+    since_checkpoint_.store(uncovered, std::memory_order_relaxed);
+    next_checkpoint_ns_.store(0, std::memory_order_relaxed);
+    checkpoint_failures_.fetch_add(1, std::memory_order_relaxed);
+    checkpoint_in_flight_.store(false, std::memory_order_release);
+}
+
+void StateJournal::checkpoint(uint64_t seq, nlohmann::json state, PatternSnapshotWriter write_patterns) {
+    if (!open_.load(std::memory_order_acquire)) {
+        checkpoint_in_flight_.store(false, std::memory_order_release);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkpoint_ = PendingCheckpoint{seq, std::move(state), std::move(write_patterns)};
+        has_checkpoint_ = true;
+    }
+    wake_.notify_one();
+}
+
+void StateJournal::writeCheckpoint(PendingCheckpoint& checkpoint) {
+    const auto start = std::chrono::steady_clock::now();
+    const fs::path directory(config_.directory);
+    auto failed = [&](const std::string& why) {
+        checkpoint_failures_.fetch_add(1, std::memory_order_relaxed);
+        checkpoint_in_flight_.store(false, std::memory_order_release);
+        MCEE_LOG_WARN("StateJournal", "Checkpoint #", checkpoint.seq, " abandonné: ", why);
+    };
+
+    // 1. Snapshot MLT d'abord : le checkpoint ne référence qu'un fichier complet
+    std::string patterns;
+    if (checkpoint.write_patterns) {
+        patterns = seqName("patterns-", checkpoint.seq, ".mltp");
+        if (!checkpoint.write_patterns((directory / patterns).string())) {
+            failed("snapshot MLT non écrit");
+            return;
+        }
+    }
+    checkpoint.state["patterns"] = patterns;
+
+    // 2. État CBOR derrière un en-tête vérifié, remplacé atomiquement
+    std::vector<uint8_t> body = nlohmann::json::to_cbor(checkpoint.state);
+    std::string data(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    data.reserve(CHECKPOINT_HEADER_SIZE + body.size());
+    put(data, STATE_JOURNAL_VERSION);
+    put(data, checkpoint.seq);
+    put(data, static_cast<uint64_t>(body.size()));
+    put(data, checksum(body.data(), body.size()));
+    data.append(reinterpret_cast<const char*>(body.data()), body.size());
+
+    std::string error;
+    if (!writeFileAtomic((directory / CHECKPOINT_FILE).string(), data, &error)) {
+        failed(error);
+        return;
+    }
+
+    // 3. Nouveau segment : les précédents ne contiennent plus que des enregistrements couverts,
+    //    hormis ceux validés entre la capture et maintenant (gardés jusqu'au checkpoint suivant)
+    uint64_t first_seq;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        first_seq = durable_seq_ + 1;
+    }
+    openSegment(first_seq);
+    removeCovered(checkpoint.seq, patterns);
+
+    checkpoints_.fetch_add(1, std::memory_order_relaxed);
+    last_checkpoint_seq_.store(checkpoint.seq, std::memory_order_relaxed);
+    checkpoint_in_flight_.store(false, std::memory_order_release);
+
+    MCEE_LOG_INFO("StateJournal", "Checkpoint #", checkpoint.seq, " écrit (", data.size(), " octets, ",
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start).count(), " ms)");
+}
+
+void StateJournal::removeCovered(uint64_t checkpoint_seq, const std::string& keep_patterns) {
+    std::error_code ec;
+
+    // Segment i couvert si le suivant commence au plus tard juste après le checkpoint
+    while (segments_.size() > 1 && segments_[1].first <= checkpoint_seq + 1) {
+        fs::remove(segments_.front().second, ec);
+        segments_.erase(segments_.begin());
+    }
+
+    for (const auto& entry : fs::directory_iterator(config_.directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("patterns-", 0) == 0 && name != keep_patterns) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+JournalStats StateJournal::getStats() const {
+    JournalStats stats;
+    stats.appended = appended_.load(std::memory_order_relaxed);
+    stats.commits = commits_.load(std::memory_order_relaxed);
+    stats.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    stats.checkpoints = checkpoints_.load(std::memory_order_relaxed);
+    stats.checkpoint_failures = checkpoint_failures_.load(std::memory_order_relaxed);
+    stats.last_checkpoint_seq = last_checkpoint_seq_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace mcee
@@ -10,10 +10,15 @@
  */
 
 #include "MCEEEngine.hpp"
+#include "MCEEHost.hpp"
+#include "ReplayEngine.hpp"
+#include "Executor.hpp"
+#include "Logger.hpp"
 #include <iostream>
 #include <csignal>
 #include <atomic>
 #include <fstream>
+#include <optional>
 
 using namespace mcee;
 
@@ -34,6 +39,35 @@ void printUsage(const char* program) {
               << "  --port <port>         Port RabbitMQ (défaut: 5672)\n"
               << "  --user <user>         Utilisateur RabbitMQ (défaut: virtus)\n"
               << "  --pass <password>     Mot de passe RabbitMQ\n"
+              << "  --prefetch <n>        Prefetch QoS par consommateur (défaut: 64)\n"
+              << "  --batch <n>           Messages drainés par réveil (défaut: 32)\n"
+              << "  --no-multi-ack        Acquitter chaque message individuellement\n"
+              << "  --coalesce-depth <n>  File [match] déclenchant la fusion des trames (défaut: 8, 0 = jamais)\n"
+              << "  --coalesce-age <ms>   Âge de trame déclenchant la fusion (défaut: 250, 0 = jamais)\n"
+              << "  --coalesce-mode <m>   latest|average : trame la plus récente ou moyenne pondérée (défaut: latest)\n"
+              << "  --no-shed             Garder tout le travail secondaire sous surcharge\n"
+              << "  --wire <json|f32|f64> Format de l'état publié (défaut: json)\n"
+              << "  --log-level <niveau>  trace|debug|info|warn|error|off (défaut: MCEE_LOG_LEVEL ou info)\n"
+              << "  --log-json            Journal en lignes JSON\n"
+              << "  --state-every <n>     Dump de l'état une trame sur n (défaut: 50, 0 = jamais)\n"
+              << "  --metrics-every <s>   Publication des métriques Prometheus (défaut: 15, 0 = jamais)\n"
+              << "  --patterns <file>     Patterns MLT chargés au démarrage et sauvés à l'arrêt\n"
+              << "  --state-dir <dir>     Journal d'état (WAL + checkpoints) : reprise au démarrage\n"
+              << "  --export-patterns <in> <out.json>  Convertit un fichier de patterns en JSON\n"
+              << "  --multi-session       Hôte multi-session (sessions routées par l'en-tête AMQP)\n"
+              << "  --workers <n>         Workers de l'hôte multi-session (défaut: 4)\n"
+              << "  --max-sessions <n>    Sessions simultanées de l'hôte (défaut: 10000)\n"
+              << "  --session-header <k>  En-tête AMQP portant la clé de session (défaut: session_id)\n"
+              << "  --trace-header <k>    En-tête d'estampille renvoyé sur l'état publié (défaut: mcee_trace)\n"
+              << "  --cluster             Hôte en grappe (sessions réparties par hachage cohérent)\n"
+              << "  --node-id <id>        Identifiant du nœud en grappe (défaut: <hostname>-<pid>)\n"
+              << "  --node-weight <n>     Part relative des sessions du nœud (défaut: 1)\n"
+              << "  --record-trace <file> Enregistre les messages traités (.mctr binaire, sinon JSONL)\n"
+              << "  --replay <trace>      Rejoue une trace hors ligne (sans RabbitMQ) puis quitte\n"
+              << "  --replay-out <file>   Trace JSONL des décisions du rejeu\n"
+              << "  --replay-threads <n>  Sessions rejouées en parallèle (défaut: cœurs disponibles)\n"
+              << "  --replay-config <f>   Sections replay / mlt / pattern_matcher du rejeu (JSON)\n"
+              << "  --executor-threads <n> Workers de l'exécuteur partagé (défaut: cœurs disponibles)\n"
               << "  --demo                Mode démonstration (sans RabbitMQ)\n"
               << "\n";
 }
@@ -121,7 +155,8 @@ void runDemo(MCEEEngine& engine) {
     engine.processSpeechText("C'est fini, tout va bien maintenant. On peut se détendre.", "user");
     std::this_thread::sleep_for(std::chrono::seconds(2));
 
-    // Statistiques finales
+    // Statistiques finales (après les messages du journal encore en file)
+    Logger::instance().flush();
     std::cout << "\n╔══════════════════════════════════════════════════════════════╗\n";
     std::cout << "║                    STATISTIQUES DEMO                          ║\n";
     std::cout << "╚══════════════════════════════════════════════════════════════╝\n";
@@ -134,14 +169,89 @@ void runDemo(MCEEEngine& engine) {
     std::cout << "  Sentiment moyen      : " << std::fixed << std::setprecision(2) 
               << engine.getSpeechInput().getAverageSentiment() << "\n";
     std::cout << "  Sagesse accumulée    : " << std::fixed << std::setprecision(3) 
-              << stats.wisdom << "\n\n";
+              << stats.wisdom << "\n";
+    std::cout << "  Latence p50 / p99    : " << std::setprecision(3) << stats.end_to_end_p50_ms
+              << " / " << stats.end_to_end_p99_ms << " ms\n\n";
+}
+
+int runHost(const RabbitMQConfig& config, MCEEHostConfig host_config,
+            const std::string& config_file, const std::string& patterns_file) {
+    if (std::ifstream(config_file).good()) {
+        host_config.config_path = config_file;
+    } else {
+        MCEE_LOG_WARN("Main", "Fichier config non trouvé, sessions avec les valeurs par défaut");
+    }
+
+    MCEEHost host(config, host_config);
+
+    if (!patterns_file.empty() && std::ifstream(patterns_file).good()) {
+        if (host.loadPatterns(patterns_file)) {
+            MCEE_LOG_INFO("Main", "Patterns MLT partagés chargés depuis ", patterns_file);
+        } else {
+            MCEE_LOG_WARN("Main", "Patterns illisibles, patterns de base conservés: ", patterns_file);
+        }
+    }
+
+    if (!host.start()) {
+        MCEE_LOG_ERROR("Main", "Échec du démarrage de l'hôte multi-session");
+        return 1;
+    }
+
+    MCEE_LOG_INFO("Main", "Hôte MCEE prêt. Appuyez sur Ctrl+C pour arrêter.");
+    while (g_running.load() && host.isRunning()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    host.stop();
+
+    if (!patterns_file.empty() && !host.savePatterns(patterns_file)) {
+        MCEE_LOG_WARN("Main", "Checkpoint des patterns impossible: ", patterns_file);
+    }
+
+    MCEE_LOG_INFO("Main", "Hôte MCEE terminé proprement.");
+    return 0;
+}
+
+int runReplay(const std::string& trace_path, ReplayConfig replay_config,
+              const std::string& config_file, const std::string& patterns_file) {
+    if (std::ifstream(config_file).good()) {
+        replay_config.config_path = config_file;
+    }
+    if (replay_config.patterns_path.empty()) {
+        replay_config.patterns_path = patterns_file;
+    }
+
+    TraceReader trace;
+    std::string error;
+    if (!trace.open(trace_path, &error)) {
+        MCEE_LOG_ERROR("Main", "Trace illisible (", trace_path, "): ", error);
+        return 1;
+    }
+
+    ReplayEngine replay(replay_config);
+    ReplayStats stats = replay.run(trace);
+    Logger::instance().flush();
+
+    std::cout << stats.toJson().dump(2) << "\n";
+    return 0;
 }
 
 int main(int argc, char* argv[]) {
     // Configuration par défaut
     RabbitMQConfig config;
+    PipelineConfig pipeline_config;
+    LoggerConfig log_config;
+    MCEEHostConfig host_config;
     std::string config_file = "phase_config.json";
     bool demo_mode = false;
+    bool host_mode = false;
+    std::string patterns_file;                       // Snapshot MLT chargé au démarrage, sauvé à l'arrêt
+    std::string export_source, export_target;        // Outil : snapshot → JSON
+    std::string record_trace_path;                   // Trace des messages reçus
+    std::string replay_trace;                        // Outil : rejeu hors ligne
+    std::string replay_config_file;
+    ReplayConfig replay_config;
+    std::optional<size_t> executor_threads;          // Prime sur la section "executor" du fichier
+    std::optional<std::string> state_dir;            // Active le journal (prime sur la section "journal")
 
     // Parser les arguments
     for (int i = 1; i < argc; ++i) {
@@ -170,26 +280,200 @@ int main(int argc, char* argv[]) {
             if (i + 1 < argc) {
                 config.password = argv[++i];
             }
+        } else if (arg == "--prefetch") {
+            if (i + 1 < argc) {
+                config.consumer_prefetch = static_cast<uint16_t>(std::stoi(argv[++i]));
+            }
+        } else if (arg == "--batch") {
+            if (i + 1 < argc) {
+                config.consumer_batch_max = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--no-multi-ack") {
+            config.consumer_multi_ack = false;
+        } else if (arg == "--coalesce-depth") {
+            if (i + 1 < argc) {
+                config.ingest_coalesce_depth = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--coalesce-age") {
+            if (i + 1 < argc) {
+                config.ingest_coalesce_age_ms = std::stoi(argv[++i]);
+            }
+        } else if (arg == "--coalesce-mode") {
+            if (i + 1 < argc) {
+                config.ingest_coalesce_mode = std::string(argv[++i]) == "average"
+                    ? CoalesceMode::TIME_WEIGHTED : CoalesceMode::LATEST;
+            }
+        } else if (arg == "--no-shed") {
+            config.ingest_shed = false;
+        } else if (arg == "--wire") {
+            if (i + 1 < argc) {
+                std::string format = argv[++i];
+                config.binary_state_output = (format == "f32" || format == "f64");
+                config.wire_precision = format == "f64" ? WirePrecision::FLOAT64 : WirePrecision::FLOAT32;
+            }
+        } else if (arg == "--log-level") {
+            if (i + 1 < argc) {
+                log_config.level = parseLogLevel(argv[++i]);
+            }
+        } else if (arg == "--log-json") {
+            log_config.format = LogFormat::JSON;
+        } else if (arg == "--state-every") {
+            if (i + 1 < argc) {
+                pipeline_config.state_log_interval = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--metrics-every") {
+            if (i + 1 < argc) {
+                config.metrics_interval_seconds = std::stod(argv[++i]);
+            }
+        } else if (arg == "--patterns") {
+            if (i + 1 < argc) {
+                patterns_file = argv[++i];
+            }
+        } else if (arg == "--state-dir") {
+            if (i + 1 < argc) {
+                state_dir = argv[++i];
+            }
+        } else if (arg == "--export-patterns") {
+            if (i + 2 < argc) {
+                export_source = argv[++i];
+                export_target = argv[++i];
+            }
+        } else if (arg == "--multi-session") {
+            host_mode = true;
+        } else if (arg == "--workers") {
+            if (i + 1 < argc) {
+                host_config.worker_count = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--max-sessions") {
+            if (i + 1 < argc) {
+                host_config.max_sessions = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--session-header") {
+            if (i + 1 < argc) {
+                config.session_header = argv[++i];
+            }
+        } else if (arg == "--trace-header") {
+            if (i + 1 < argc) {
+                config.trace_header = argv[++i];
+            }
+        } else if (arg == "--cluster") {
+            host_mode = true;
+            host_config.cluster.enabled = true;
+        } else if (arg == "--node-id") {
+            if (i + 1 < argc) {
+                host_config.cluster.node_id = argv[++i];
+            }
+        } else if (arg == "--node-weight") {
+            if (i + 1 < argc) {
+                host_config.cluster.weight = static_cast<unsigned>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--record-trace") {
+            if (i + 1 < argc) {
+                record_trace_path = argv[++i];
+            }
+        } else if (arg == "--replay") {
+            if (i + 1 < argc) {
+                replay_trace = argv[++i];
+            }
+        } else if (arg == "--replay-out") {
+            if (i + 1 < argc) {
+                replay_config.output_path = argv[++i];
+            }
+        } else if (arg == "--replay-threads") {
+            if (i + 1 < argc) {
+                replay_config.threads = static_cast<size_t>(std::stoul(argv[++i]));
+            }
+        } else if (arg == "--replay-config") {
+            if (i + 1 < argc) {
+                replay_config_file = argv[++i];
+            }
+        } else if (arg == "--executor-threads") {
+            if (i + 1 < argc) {
+                executor_threads = static_cast<size_t>(std::stoul(argv[++i]));
+            }
         } else if (arg == "--demo") {
             demo_mode = true;
         }
     }
 
+    // Les variables MCEE_LOG_* complètent la configuration de la ligne de commande
+    Logger::instance().configureFromEnv(log_config);
+
+    // L'exécuteur partagé est créé au premier usage : le configurer avant
+    // tout moteur
+    ExecutorConfig executor_config;
+    readExecutorConfig(config_file, executor_config);
+    if (executor_threads) {
+        executor_config.threads = *executor_threads;
+    }
+    Executor::configureShared(executor_config);
+
+    if (!export_source.empty()) {
+        MLT mlt;
+        bool ok = mlt.loadFromFile(export_source) && mlt.exportJson(export_target);
+        if (ok) {
+            MCEE_LOG_INFO("Main", mlt.patternCount(), " patterns exportés vers ", export_target);
+        } else {
+            MCEE_LOG_ERROR("Main", "Export impossible: ", export_source, " → ", export_target);
+        }
+        Logger::instance().flush();
+        return ok ? 0 : 1;
+    }
+
+    if (!replay_trace.empty()) {
+        if (!replay_config_file.empty() && !readReplayConfig(replay_config_file, replay_config)) {
+            return 1;
+        }
+        return runReplay(replay_trace, replay_config, config_file, patterns_file);
+    }
+
     // Installer le signal handler
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
 
     try {
+        if (host_mode && !demo_mode) {
+            host_config.record_trace_path = record_trace_path;
+            return runHost(config, host_config, config_file, patterns_file);
+        }
+
         // Créer le moteur MCEE
-        MCEEEngine engine(config);
+        MCEEEngine engine(config, pipeline_config);
 
         // Charger la configuration de base (SANS Neo4j pour ne pas bloquer)
-        std::cout << "[Main] Chargement configuration (phase)..." << std::endl << std::flush;
+        MCEE_LOG_INFO("Main", "Chargement configuration (phase)...");
         if (std::ifstream(config_file).good()) {
             engine.loadConfig(config_file, true);  // skip_neo4j = true pour l'instant
-            std::cout << "[Main] Configuration de base chargée" << std::endl << std::flush;
+            MCEE_LOG_INFO("Main", "Configuration de base chargée");
         } else {
-            std::cout << "[Main] Fichier config non trouvé, utilisation des valeurs par défaut" << std::endl;
+            MCEE_LOG_WARN("Main", "Fichier config non trouvé, utilisation des valeurs par défaut");
+        }
+
+        if (!patterns_file.empty() && std::ifstream(patterns_file).good()) {
+            if (engine.loadPatterns(patterns_file)) {
+                MCEE_LOG_INFO("Main", "Patterns MLT chargés depuis ", patterns_file);
+            } else {
+                MCEE_LOG_WARN("Main", "Patterns illisibles, patterns de base conservés: ", patterns_file);
+            }
+        }
+
+        // Reprise de l'état journalisé, avant l'enregistrement d'une trace (le rejeu n'y figure pas)
+        JournalConfig journal_config;
+        MCEEEngine::readJournalConfig(config_file, journal_config);
+        if (state_dir) {
+            journal_config.enabled = true;
+            journal_config.directory = *state_dir;
+        }
+        if (journal_config.enabled && !engine.enableJournal(journal_config)) {
+            MCEE_LOG_ERROR("Main", "Journal d'état inutilisable: ", journal_config.directory);
+            return 1;
+        }
+
+        if (!record_trace_path.empty()) {
+            auto writer = std::make_shared<TraceWriter>();
+            if (writer->open(record_trace_path)) {
+                engine.setTraceWriter(std::move(writer));
+            }
         }
 
         // Définir un callback pour afficher les changements d'état
@@ -203,21 +487,21 @@ int main(int argc, char* argv[]) {
         } else {
             // Mode normal avec RabbitMQ
             // IMPORTANT: Démarrer le consumer RabbitMQ EN PREMIER
-            std::cout << "[Main] Démarrage du moteur (RabbitMQ)..." << std::endl << std::flush;
+            MCEE_LOG_INFO("Main", "Démarrage du moteur (RabbitMQ)...");
 
             if (!engine.start()) {
-                std::cerr << "[Main] Échec du démarrage du moteur MCEE" << std::endl;
+                MCEE_LOG_ERROR("Main", "Échec du démarrage du moteur MCEE");
                 return 1;
             }
 
-            std::cout << "[Main] MCEE actif et en écoute RabbitMQ" << std::endl;
+            MCEE_LOG_INFO("Main", "MCEE actif et en écoute RabbitMQ");
 
             // ENSUITE initialiser Neo4j (peut bloquer, mais MCEE consomme déjà)
-            std::cout << "[Main] Initialisation Neo4j en arrière-plan..." << std::endl << std::flush;
+            MCEE_LOG_INFO("Main", "Initialisation Neo4j en arrière-plan...");
             engine.loadConfig(config_file, false);  // Maintenant charger Neo4j
-            std::cout << "[Main] Neo4j initialisé" << std::endl << std::flush;
+            MCEE_LOG_INFO("Main", "Neo4j initialisé");
 
-            std::cout << "[Main] MCEE prêt. Appuyez sur Ctrl+C pour arrêter." << std::endl;
+            MCEE_LOG_INFO("Main", "MCEE prêt. Appuyez sur Ctrl+C pour arrêter.");
 
             // Boucle principale
             while (g_running.load() && engine.isRunning()) {
@@ -227,11 +511,15 @@ int main(int argc, char* argv[]) {
             engine.stop();
         }
 
-        std::cout << "[Main] MCEE terminé proprement.\n";
+        if (!patterns_file.empty() && !engine.savePatterns(patterns_file)) {
+            MCEE_LOG_WARN("Main", "Checkpoint des patterns impossible: ", patterns_file);
+        }
+
+        MCEE_LOG_INFO("Main", "MCEE terminé proprement.");
         return 0;
 
     } catch (const std::exception& e) {
-        std::cerr << "[Main] Erreur fatale: " << e.what() << "\n";
+        MCEE_LOG_ERROR("Main", "Erreur fatale: ", e.what());
         return 1;
     }
 }
@@ -0,0 +1,180 @@
+/**
+ * @file EmotionWireTest.cpp
+ * @brief Tests unitaires de la trame binaire des émotions (trame et lot)
+ */
+
+#include "EmotionWire.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace mcee;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+EmotionFrame sampleFrame(int seed) {
+    EmotionFrame frame;
+    frame.timestamp_ms = 1700000000000 + seed;
+    frame.e_global = 0.125 * seed;
+    frame.pattern_id = "PATTERN_" + std::to_string(seed);
+    for (size_t i = 0; i < WIRE_EMOTION_COUNT; ++i) {
+        frame.emotions[i] = static_cast<double>(i + seed) / 64.0;   // Exact en float32
+    }
+    return frame;
+}
+
+bool sameFrame(const EmotionFrame& a, const EmotionFrame& b) {
+    return a.timestamp_ms == b.timestamp_ms && a.e_global == b.e_global &&
+           a.pattern_id == b.pattern_id && a.emotions == b.emotions;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_FrameRoundTripFloat32() {
+    const EmotionFrame frame = sampleFrame(3);
+    const std::string body = encodeEmotionFrame(frame);
+    ASSERT_EQ(body.size(), WIRE_HEADER_SIZE + frame.pattern_id.size() + WIRE_EMOTION_COUNT * 4);
+
+    EmotionFrame decoded;
+    ASSERT_TRUE(decodeEmotionFrame(body, decoded));
+    ASSERT_TRUE(sameFrame(frame, decoded));
+}
+
+void test_FrameRoundTripFloat64() {
+    EmotionFrame frame = sampleFrame(5);
+    frame.emotions[7] = 0.1;   // Non représentable en float32
+    frame.pattern_id.clear();
+    const std::string body = encodeEmotionFrame(frame, WirePrecision::FLOAT64);
+
+    EmotionFrame decoded;
+    ASSERT_TRUE(decodeEmotionFrame(body, decoded));
+    ASSERT_TRUE(sameFrame(frame, decoded));
+}
+
+void test_BatchRoundTrip() {
+    const std::vector<EmotionFrame> frames = {sampleFrame(1), sampleFrame(2), sampleFrame(9)};
+    std::vector<EmotionFrame> decoded;
+    ASSERT_TRUE(decodeEmotionBatch(encodeEmotionBatch(frames), decoded));
+    ASSERT_EQ(decoded.size(), frames.size());
+    for (size_t i = 0; i < frames.size(); ++i) {
+        ASSERT_TRUE(sameFrame(frames[i], decoded[i]));
+    }
+
+    ASSERT_TRUE(decodeEmotionBatch(encodeEmotionBatch({}), decoded));
+    ASSERT_TRUE(decoded.empty());
+}
+
+void test_MalformedFrameRejected() {
+    const std::string body = encodeEmotionFrame(sampleFrame(4));
+    EmotionFrame decoded;
+
+    ASSERT_FALSE(decodeEmotionFrame("", decoded));
+    ASSERT_FALSE(decodeEmotionFrame(body.substr(0, body.size() - 1), decoded));   // Tronquée
+    ASSERT_FALSE(decodeEmotionFrame(body + '\0', decoded));                        // Octet en trop
+
+    std::string bad_magic = body;
+    bad_magic[0] = 'X';
+    ASSERT_FALSE(decodeEmotionFrame(bad_magic, decoded));
+
+    std::string bad_version = body;
+    bad_version[4] = static_cast<char>(WIRE_VERSION + 1);
+    ASSERT_FALSE(decodeEmotionFrame(bad_version, decoded));
+
+    std::string bad_precision = body;
+    bad_precision[5] = 7;
+    ASSERT_FALSE(decodeEmotionFrame(bad_precision, decoded));
+
+    std::string bad_count = body;
+    bad_count[6] = 23;
+    ASSERT_FALSE(decodeEmotionFrame(bad_count, decoded));
+
+    std::string bad_id_length = body;
+    bad_id_length[24] = static_cast<char>(0xFF);   // Identifiant au-delà du message
+    ASSERT_FALSE(decodeEmotionFrame(bad_id_length, decoded));
+}
+
+void test_MalformedBatchRejected() {
+    const std::string body = encodeEmotionBatch({sampleFrame(1), sampleFrame(2)});
+    std::vector<EmotionFrame> decoded;
+
+    ASSERT_FALSE(decodeEmotionBatch("MCEB", decoded));
+    ASSERT_FALSE(decodeEmotionBatch(body.substr(0, body.size() - 1), decoded));   // Dernière trame tronquée
+    ASSERT_TRUE(decoded.size() <= 1);
+    ASSERT_FALSE(decodeEmotionBatch(body + "xx", decoded));                         // Octets après le lot
+    ASSERT_FALSE(decodeEmotionBatch(encodeEmotionFrame(sampleFrame(1)), decoded));   // Trame seule
+
+    std::string overcount = body;
+    overcount[6] = 3;   // Annonce une trame absente
+    ASSERT_FALSE(decodeEmotionBatch(overcount, decoded));
+
+    std::string oversized = body;
+    oversized[8] = static_cast<char>(0xFF);   // Longueur de trame au-delà du lot
+    oversized[9] = static_cast<char>(0xFF);
+    ASSERT_FALSE(decodeEmotionBatch(oversized, decoded));
+
+    std::string corrupt_inner = body;
+    corrupt_inner[12] = 'X';   // Signature de la première trame
+    ASSERT_FALSE(decodeEmotionBatch(corrupt_inner, decoded));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests EmotionWire ===\n";
+
+    std::cout << "\n>> Aller-retour\n";
+    RUN_TEST(FrameRoundTripFloat32);
+    RUN_TEST(FrameRoundTripFloat64);
+    RUN_TEST(BatchRoundTrip);
+
+    std::cout << "\n>> Messages mal formés\n";
+    RUN_TEST(MalformedFrameRejected);
+    RUN_TEST(MalformedBatchRejected);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file IngestCoalesceTest.cpp
+ * @brief Tests unitaires de la politique d'ingestion sous surcharge (étage [match])
+ */
+
+#include "MCEEEngine.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace mcee;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+#define ASSERT_NEAR(a, b, eps) \
+    if (std::abs((a) - (b)) > (eps)) throw std::runtime_error("ASSERT_NEAR failed: " #a " != " #b)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+using Clock = std::chrono::steady_clock;
+using FrameQueue = BoundedMPSCQueue<PipelineFrame>;
+
+/**
+ * @brief Trame émotions : joie = value, peur = 1 - value, trace = id
+ */
+PipelineFrame emotionsFrame(double value, Clock::time_point ingest_time, int64_t trace) {
+    PipelineFrame frame;
+    frame.kind = PipelineFrame::Kind::EMOTIONS;
+    frame.state.emotions[0] = value;
+    frame.state.emotions[1] = 1.0 - value;
+    frame.ingest_time = ingest_time;
+    frame.trace = trace;
+    return frame;
+}
+
+PipelineFrame kindFrame(PipelineFrame::Kind kind, Clock::time_point ingest_time, int64_t trace) {
+    PipelineFrame frame;
+    frame.kind = kind;
+    frame.ingest_time = ingest_time;
+    frame.trace = trace;
+    return frame;
+}
+
+/**
+ * @brief Fusion dès deux trames en attente, jamais sur l'âge
+ */
+RabbitMQConfig overloadConfig(CoalesceMode mode = CoalesceMode::LATEST) {
+    RabbitMQConfig config;
+    config.ingest_coalesce_depth = 2;
+    config.ingest_coalesce_age_ms = 0;
+    config.ingest_coalesce_max = 64;
+    config.ingest_coalesce_mode = mode;
+    config.ingest_shed = true;
+    return config;
+}
+
+void push(FrameQueue& queue, PipelineFrame frame) {
+    ASSERT_TRUE(queue.tryPush(std::move(frame)));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_TimeWeightedMergeIsWeightedMean() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    const RabbitMQConfig config = overloadConfig(CoalesceMode::TIME_WEIGHTED);
+
+    // 0.2 valide 10 ms, 0.5 valide 20 ms, 0.9 valide 30 ms (jusqu'à now)
+    PipelineFrame frame = emotionsFrame(0.2, t0, 1);
+    push(queue, emotionsFrame(0.5, t0 + std::chrono::milliseconds(10), 2));
+    push(queue, emotionsFrame(0.9, t0 + std::chrono::milliseconds(30), 3));
+
+    PipelineFrame next;
+    ASSERT_FALSE(MCEEEngine::coalesceBacklog(frame, next, queue, config, t0 + std::chrono::milliseconds(60)));
+    ASSERT_EQ(frame.coalesced, 3u);
+
+    const double joy = (10.0 * 0.2 + 20.0 * 0.5 + 30.0 * 0.9) / 60.0;
+    const double fear = (10.0 * 0.8 + 20.0 * 0.5 + 30.0 * 0.1) / 60.0;
+    ASSERT_NEAR(frame.state.emotions[0], joy, 1e-9);
+    ASSERT_NEAR(frame.state.emotions[1], fear, 1e-9);
+    ASSERT_NEAR(frame.state.E_global, (joy + fear) / static_cast<double>(NUM_EMOTIONS), 1e-9);
+
+    // La trame fusionnée garde l'arrivée et la trace de la plus ancienne
+    ASSERT_TRUE(frame.ingest_time == t0);
+    ASSERT_EQ(frame.trace, 1);
+}
+
+void test_LatestMergeKeepsNewestState() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    PipelineFrame frame = emotionsFrame(0.2, t0, 1);
+    push(queue, emotionsFrame(0.5, t0, 2));
+    push(queue, emotionsFrame(0.9, t0, 3));
+
+    PipelineFrame next;
+    ASSERT_FALSE(MCEEEngine::coalesceBacklog(frame, next, queue, overloadConfig(), t0));
+    ASSERT_EQ(frame.coalesced, 3u);
+    ASSERT_NEAR(frame.state.emotions[0], 0.9, 1e-12);
+    ASSERT_EQ(queue.size(), 0u);
+}
+
+void test_MergeStopsAtFeedbackAndReflex() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    PipelineFrame frame = emotionsFrame(0.2, t0, 1);
+    push(queue, emotionsFrame(0.5, t0, 2));
+    push(queue, kindFrame(PipelineFrame::Kind::FEEDBACK, t0, 3));
+    push(queue, emotionsFrame(0.9, t0, 4));
+
+    PipelineFrame next;
+    ASSERT_TRUE(MCEEEngine::coalesceBacklog(frame, next, queue, overloadConfig(), t0));
+    ASSERT_EQ(frame.coalesced, 2u);
+    ASSERT_TRUE(next.kind == PipelineFrame::Kind::FEEDBACK);
+    ASSERT_EQ(queue.size(), 1u);
+
+    // Une trame d'urgence déjà publiée n'est jamais absorbée
+    PipelineFrame reflex = emotionsFrame(1.0, t0, 5);
+    reflex.reflex = true;
+    push(queue, std::move(reflex));
+    PipelineFrame second;
+    ASSERT_TRUE(queue.tryPop(second));
+    ASSERT_TRUE(MCEEEngine::coalesceBacklog(second, next, queue, overloadConfig(), t0));
+    ASSERT_EQ(second.coalesced, 1u);
+    ASSERT_TRUE(next.reflex);
+    ASSERT_EQ(next.trace, 5);
+}
+
+void test_MergeCappedAtMaxFrames() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    RabbitMQConfig config = overloadConfig();
+    config.ingest_coalesce_max = 3;
+
+    PipelineFrame frame = emotionsFrame(0.1, t0, 1);
+    for (int64_t i = 2; i <= 5; ++i) push(queue, emotionsFrame(0.1 * i, t0, i));
+
+    PipelineFrame next;
+    ASSERT_FALSE(MCEEEngine::coalesceBacklog(frame, next, queue, config, t0));
+    ASSERT_EQ(frame.coalesced, 3u);
+    ASSERT_EQ(queue.size(), 2u);
+}
+
+void test_SpeechBehindBacklogProcessedAfterMerge() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    const RabbitMQConfig config = overloadConfig();
+    std::atomic<bool> running{true};
+
+    push(queue, emotionsFrame(0.1, t0, 1));
+    push(queue, emotionsFrame(0.2, t0, 2));
+    push(queue, emotionsFrame(0.3, t0, 3));
+    push(queue, kindFrame(PipelineFrame::Kind::SPEECH, t0, 4));
+    push(queue, emotionsFrame(0.4, t0, 5));
+
+    PendingFrame pending;
+    PipelineFrame frame;
+
+    // 1. Les trois trames émotions en retard, fusionnées et délestées
+    ASSERT_TRUE(MCEEEngine::takeMatchFrame(frame, pending, queue, config, running));
+    ASSERT_TRUE(frame.kind == PipelineFrame::Kind::EMOTIONS);
+    ASSERT_EQ(frame.coalesced, 3u);
+    ASSERT_TRUE(frame.shed);
+    ASSERT_NEAR(frame.state.emotions[0], 0.3, 1e-12);
+    ASSERT_TRUE(pending.present);
+
+    // 2. La parole lue au-delà de la fusion, servie avant la file
+    ASSERT_TRUE(MCEEEngine::takeMatchFrame(frame, pending, queue, config, running));
+    ASSERT_TRUE(frame.kind == PipelineFrame::Kind::SPEECH);
+    ASSERT_EQ(frame.trace, 4);
+    ASSERT_EQ(frame.coalesced, 1u);
+    ASSERT_FALSE(pending.present);
+
+    // 3. La trame émotions suivante, seule en file : plus de surcharge
+    ASSERT_TRUE(MCEEEngine::takeMatchFrame(frame, pending, queue, config, running));
+    ASSERT_TRUE(frame.kind == PipelineFrame::Kind::EMOTIONS);
+    ASSERT_EQ(frame.trace, 5);
+    ASSERT_EQ(frame.coalesced, 1u);
+    ASSERT_FALSE(frame.shed);
+    ASSERT_EQ(queue.size(), 0u);
+
+    // Étage arrêté, file vide : plus rien à servir
+    running.store(false);
+    ASSERT_FALSE(MCEEEngine::takeMatchFrame(frame, pending, queue, config, running));
+}
+
+void test_NoMergeWithoutOverload() {
+    const auto now = Clock::now();
+    RabbitMQConfig config = overloadConfig();
+    config.ingest_coalesce_depth = 8;
+    config.ingest_coalesce_age_ms = 250;
+
+    PipelineFrame frame = emotionsFrame(0.5, now, 1);
+    ASSERT_FALSE(MCEEEngine::ingestOverloaded(frame, 7, config, now));
+    ASSERT_TRUE(MCEEEngine::ingestOverloaded(frame, 8, config, now));
+    ASSERT_TRUE(MCEEEngine::ingestOverloaded(frame, 0, config, now + std::chrono::milliseconds(250)));
+
+    // Seuils à 0 : jamais de fusion
+    config.ingest_coalesce_depth = 0;
+    config.ingest_coalesce_age_ms = 0;
+    ASSERT_FALSE(MCEEEngine::ingestOverloaded(frame, 1000, config, now + std::chrono::hours(1)));
+}
+
+void test_ShedDisabledStillMerges() {
+    const auto t0 = Clock::now();
+    FrameQueue queue(16);
+    RabbitMQConfig config = overloadConfig();
+    config.ingest_shed = false;
+    std::atomic<bool> running{true};
+
+    push(queue, emotionsFrame(0.1, t0, 1));
+    push(queue, emotionsFrame(0.2, t0, 2));
+    push(queue, emotionsFrame(0.3, t0, 3));
+
+    PendingFrame pending;
+    PipelineFrame frame;
+    ASSERT_TRUE(MCEEEngine::takeMatchFrame(frame, pending, queue, config, running));
+    ASSERT_EQ(frame.coalesced, 3u);
+    ASSERT_FALSE(frame.shed);
+}
+
+void test_StalePublishSkippedOnlyWhenShedAndBacklogged() {
+    PipelineFrame frame = emotionsFrame(0.5, Clock::now(), 1);
+    ASSERT_FALSE(MCEEEngine::publishIsStale(frame, 3));
+
+    frame.shed = true;
+    ASSERT_TRUE(MCEEEngine::publishIsStale(frame, 1));
+    // Dernier état en attente : toujours publié
+    ASSERT_FALSE(MCEEEngine::publishIsStale(frame, 0));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests Ingestion sous surcharge ===\n";
+
+    std::cout << "\n>> Fusion du retard\n";
+    RUN_TEST(TimeWeightedMergeIsWeightedMean);
+    RUN_TEST(LatestMergeKeepsNewestState);
+    RUN_TEST(MergeStopsAtFeedbackAndReflex);
+    RUN_TEST(MergeCappedAtMaxFrames);
+
+    std::cout << "\n>> Ordre des trames\n";
+    RUN_TEST(SpeechBehindBacklogProcessedAfterMerge);
+
+    std::cout << "\n>> Seuils et délestage\n";
+    RUN_TEST(NoMergeWithoutOverload);
+    RUN_TEST(ShedDisabledStillMerges);
+    RUN_TEST(StalePublishSkippedOnlyWhenShedAndBacklogged);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
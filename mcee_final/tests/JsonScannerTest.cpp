@@ -0,0 +1,263 @@
+/**
+ * @file JsonScannerTest.cpp
+ * @brief Tests unitaires de la lecture JSON sans DOM (JsonScanner)
+ */
+
+#include "JsonScanner.hpp"
+#include "JsonWriter.hpp"
+
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace mcee;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+#define ASSERT_THROWS(expr) \
+    { bool thrown = false; \
+      try { expr; } catch (const JsonScanError&) { thrown = true; } \
+      if (!thrown) throw std::runtime_error("ASSERT_THROWS failed: " #expr); }
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Parcourt tout le document (valeur unique puis fin)
+ */
+void scanAll(std::string_view text) {
+    JsonScanner scan(text);
+    scan.skipValue();
+    scan.expectEnd();
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_WriterRoundTrip() {
+    const std::string text_in = "ligne \"1\"\n\tchemin C:\\tmp \x01 été";
+    const std::vector<double> values = {0.1, -2.5e-7, 1e300, 42.0};
+
+    std::string body;
+    JsonWriter<std::string> out(body);
+    out.beginObject();
+    out.field("text", std::string_view(text_in));
+    out.field("count", 7);
+    out.field("urgent", true);
+    out.key("values");
+    out.beginArray();
+    for (double v : values) out.value(v);
+    out.endArray();
+    out.key("nested");
+    out.beginObject();
+    out.field("empty", std::string_view());
+    out.key("list");
+    out.beginArray();
+    out.endArray();
+    out.endObject();
+    out.endObject();
+
+    std::string scratch;
+    std::string text_out;
+    double count = 0.0;
+    bool urgent = false;
+    std::vector<double> values_out;
+    std::string_view nested;
+
+    JsonScanner scan(body);
+    scan.beginObject();
+    std::string_view key;
+    while (scan.nextField(key)) {
+        if (key == "text") text_out = std::string(scan.readString(scratch));
+        else if (key == "count") count = scan.readNumber();
+        else if (key == "urgent") urgent = scan.readBool();
+        else if (key == "values") {
+            scan.beginArray();
+            while (scan.nextElement()) values_out.push_back(scan.readNumber());
+        }
+        else if (key == "nested") nested = scan.captureValue();
+        else throw std::runtime_error("clé inattendue");
+    }
+    scan.expectEnd();
+
+    ASSERT_EQ(text_out, text_in);
+    ASSERT_EQ(count, 7.0);
+    ASSERT_TRUE(urgent);
+    ASSERT_EQ(values_out, values);   // Forme courte relue à l'identique
+    ASSERT_EQ(nested, std::string_view("{\"empty\":\"\",\"list\":[]}"));
+
+    // Valeur capturée relue par un second scanner
+    JsonScanner inner(nested);
+    inner.beginObject();
+    ASSERT_TRUE(inner.nextField(key));
+    ASSERT_EQ(key, std::string_view("empty"));
+    ASSERT_TRUE(inner.readString(scratch).empty());
+    ASSERT_TRUE(inner.nextField(key));
+    ASSERT_EQ(inner.peek(), JsonType::ARRAY);
+    inner.skipValue();
+    ASSERT_FALSE(inner.nextField(key));
+    inner.expectEnd();
+}
+
+void test_NlohmannRoundTrip() {
+    const nlohmann::json doc = {
+        {"texte", "\u00e9l\u00e8ve \U0001F600 \\ / \b\f\r"},
+        {"emotions", {0.0, 0.25, 1.0}},
+        {"absent", nullptr},
+        {"drapeaux", {{"a", true}, {"b", false}}}
+    };
+    const std::string body = doc.dump();
+    const std::string ascii = doc.dump(-1, ' ', true);   // \uXXXX, paires de substitution comprises
+
+    for (const std::string& text : {body, ascii}) {
+        std::string scratch;
+        nlohmann::json rebuilt = nlohmann::json::object();
+        JsonScanner scan(text);
+        scan.beginObject();
+        std::string_view key;
+        while (scan.nextField(key)) {
+            const std::string name(key);
+            switch (scan.peek()) {
+                case JsonType::STRING: rebuilt[name] = std::string(scan.readString(scratch)); break;
+                case JsonType::NUL: ASSERT_TRUE(scan.readNull()); rebuilt[name] = nullptr; break;
+                case JsonType::ARRAY:
+                    rebuilt[name] = nlohmann::json::array();
+                    scan.beginArray();
+                    while (scan.nextElement()) rebuilt[name].push_back(scan.readNumber());
+                    break;
+                case JsonType::OBJECT: {
+                    rebuilt[name] = nlohmann::json::object();
+                    scan.beginObject();
+                    std::string_view inner;
+                    while (scan.nextField(inner)) rebuilt[name][std::string(inner)] = scan.readBool();
+                    break;
+                }
+                default: throw std::runtime_error("type inattendu");
+            }
+        }
+        scan.expectEnd();
+        ASSERT_TRUE(rebuilt == doc);
+    }
+}
+
+void test_MalformedDocumentsRejected() {
+    const std::vector<std::string_view> malformed = {
+        "",                         // Document vide
+        "{",                        // Objet non fermé
+        "{\"a\":1,}",                // Virgule finale
+        "[1,]",
+        "[1 2]",                    // Séparateur manquant
+        "{\"a\" 1}",                 // ':' manquant
+        "{a:1}",                    // Clé non entre guillemets
+        "\"non terminée",
+        "\"ctrl\x01\"",            // Caractère de contrôle brut
+        "tru",
+        "nul",
+        "truex",
+        "-",
+        "1.5x",
+        "inf",
+        "nan",
+        "{} {}",                    // Données après la fin
+    };
+    for (std::string_view text : malformed) {
+        ASSERT_THROWS(scanAll(text));
+    }
+
+    // Échappements vérifiés au décodage (une valeur sautée n'est pas décodée)
+    const std::vector<std::string_view> bad_escapes = {
+        "\"\\x\"",                  // Échappement inconnu
+        "\"\\u12\"",                // \u tronqué
+        "\"\\uZZZZ\"",              // \u non hexadécimal
+    };
+    for (std::string_view text : bad_escapes) {
+        std::string scratch;
+        JsonScanner scan(text);
+        ASSERT_THROWS(scan.readString(scratch));
+    }
+
+    // Imbrication au-delà de la limite
+    ASSERT_THROWS(scanAll(std::string(300, '[') + std::string(300, ']')));
+    scanAll(std::string(200, '[') + std::string(200, ']'));
+}
+
+void test_TypeMismatchRejected() {
+    std::string scratch;
+    {
+        JsonScanner scan("{\"n\":\"7\"}");
+        scan.beginObject();
+        std::string_view key;
+        ASSERT_TRUE(scan.nextField(key));
+        ASSERT_THROWS(scan.readNumber());
+    }
+    {
+        JsonScanner scan("[1]");
+        ASSERT_THROWS(scan.beginObject());
+    }
+    {
+        JsonScanner scan("42");
+        ASSERT_FALSE(scan.readNull());   // Rien consommé
+        ASSERT_THROWS(scan.readString(scratch));
+        ASSERT_THROWS(scan.readBool());
+        ASSERT_EQ(scan.readNumber(), 42.0);
+        scan.expectEnd();
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests JsonScanner ===\n";
+
+    std::cout << "\n>> Aller-retour\n";
+    RUN_TEST(WriterRoundTrip);
+    RUN_TEST(NlohmannRoundTrip);
+
+    std::cout << "\n>> Documents mal formés\n";
+    RUN_TEST(MalformedDocumentsRejected);
+    RUN_TEST(TypeMismatchRejected);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file MLTOverlayTest.cpp
+ * @brief Tests unitaires des couches de session de la MLT (base partagée en lecture seule)
+ */
+
+#include "PatternMatcher.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace mcee;
+namespace fs = std::filesystem;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+EmotionalState calmState() {
+    EmotionalState state;
+    state.emotions[23] = 0.8;
+    state.emotions[6] = 0.6;
+    state.emotions[14] = 0.5;
+    state.emotions[0] = 0.4;
+    return state;
+}
+
+// Amour, envie, embarras : loin des 8 patterns de base
+EmotionalState novelState() {
+    EmotionalState state;
+    state.emotions[8] = 0.9;
+    state.emotions[12] = 0.8;
+    state.emotions[21] = 0.7;
+    return state;
+}
+
+MLTConfig syncMlt() {
+    MLTConfig config;
+    config.background_learning = false;
+    config.auto_save = false;
+    return config;
+}
+
+/**
+ * @brief Une session hébergée : sa MCT, sa couche MLT et son matcher
+ */
+struct Session {
+    std::shared_ptr<MCT> mct;
+    std::shared_ptr<MLT> mlt;
+    PatternMatcher matcher;
+
+    explicit Session(std::shared_ptr<const MLT> base)
+        : mct(std::make_shared<MCT>(quietMct())),
+          mlt(std::make_shared<MLT>(std::move(base))),
+          matcher(mct, mlt) {}
+
+    void fill(const EmotionalState& state, size_t frames = 60) {
+        for (size_t i = 0; i < frames; ++i) mct->push(state);
+    }
+
+    EmotionalSignature signature() const {
+        auto signature = mct->extractSignature();
+        if (!signature) throw std::runtime_error("signature MCT absente");
+        return *signature;
+    }
+
+    static MCTConfig quietMct() {
+        MCTConfig config;
+        config.log_validation_errors = false;
+        return config;
+    }
+};
+
+EmotionalSignature signatureOf(const EmotionalState& state) {
+    Session probe(std::make_shared<const MLT>(syncMlt()));
+    probe.fill(state);
+    return probe.signature();
+}
+
+bool containsMatch(const std::vector<PatternMatch>& matches, const std::string& id) {
+    return std::any_of(matches.begin(), matches.end(),
+                       [&](const PatternMatch& match) { return match.pattern_id == id; });
+}
+
+/**
+ * @brief Fichier de patterns propre à un test, supprimé à la destruction
+ */
+struct TempPatternsFile {
+    fs::path path;
+
+    explicit TempPatternsFile(const std::string& name, const std::string& extension = ".mltp")
+        : path(fs::temp_directory_path() /
+               ("mcee_mlt_" + name + "_" + std::to_string(::getpid()) + extension)) {
+        fs::remove(path);
+    }
+    ~TempPatternsFile() {
+        std::error_code ec;
+        fs::remove(path, ec);
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_PatternLearnedInSessionANotMatchedInSessionB() {
+    auto base = std::make_shared<const MLT>(syncMlt());
+    Session a(base);
+    Session b(base);
+
+    a.fill(novelState());
+    b.fill(novelState());
+    const std::string learned = a.matcher.forceCreatePattern("SESSION_A_ONLY");
+    ASSERT_FALSE(learned.empty());
+
+    ASSERT_TRUE(containsMatch(a.mlt->findMatches(a.signature(), 20), learned));
+    ASSERT_FALSE(containsMatch(b.mlt->findMatches(b.signature(), 20), learned));
+    ASSERT_FALSE(b.mlt->getPattern(learned).has_value());
+    ASSERT_FALSE(b.mlt->getPatternByName("SESSION_A_ONLY").has_value());
+    ASSERT_EQ(a.mlt->patternCount(), base->patternCount() + 1);
+    ASSERT_EQ(b.mlt->patternCount(), base->patternCount());
+
+    // Le matcher de B ne retient jamais le pattern de A (il crée le sien au besoin)
+    ASSERT_TRUE(b.matcher.match().pattern_id != learned);
+    ASSERT_EQ(a.mlt->patternCount(), base->patternCount() + 1);
+}
+
+void test_BasePatternLearningStaysInSession() {
+    auto base = std::make_shared<const MLT>(syncMlt());
+    const auto original = *base->getPattern("BASE_SERENITE");
+    Session a(base);
+    Session b(base);
+
+    // La session A tire SERENITE vers un état étranger et l'active souvent
+    a.fill(novelState());
+    for (int i = 0; i < 30; ++i) {
+        a.mlt->updatePattern("BASE_SERENITE", a.signature(), -1.0);
+        a.mlt->recordActivation("BASE_SERENITE", 1.0);
+    }
+    a.mlt->recordTransition("BASE_SERENITE", "BASE_JOIE");
+
+    const auto in_a = *a.mlt->getPattern("BASE_SERENITE");
+    ASSERT_EQ(in_a.activation_count, 30);
+    ASSERT_TRUE(in_a.signature.mean_emotions[8] > 0.5);
+
+    for (const MLT* view : {static_cast<const MLT*>(b.mlt.get()), base.get()}) {
+        const auto untouched = *view->getPattern("BASE_SERENITE");
+        ASSERT_EQ(untouched.activation_count, original.activation_count);
+        ASSERT_TRUE(untouched.signature.mean_emotions == original.signature.mean_emotions);
+        ASSERT_TRUE(untouched.confidence == original.confidence);
+        ASSERT_TRUE(untouched.transition_probabilities.empty());
+    }
+
+    // B matche toujours SERENITE contre son propre état calme, sans influence de A
+    b.fill(calmState());
+    const auto matches = b.mlt->findMatches(b.signature(), 1);
+    ASSERT_FALSE(matches.empty());
+    ASSERT_EQ(matches.front().pattern_id, std::string("BASE_SERENITE"));
+    ASSERT_TRUE(matches.front().confidence == original.confidence);
+}
+
+void test_DeletionInSessionOnlyHidesBasePattern() {
+    // Base chargée avec un pattern appris (supprimable, contrairement aux 8 de base)
+    auto root = std::make_shared<MLT>(syncMlt());
+    const std::string stored = root->createPattern(signatureOf(novelState()), "STORED");
+    std::shared_ptr<const MLT> base = std::move(root);
+
+    Session a(base);
+    Session b(base);
+    a.fill(novelState());
+    b.fill(novelState());
+
+    ASSERT_TRUE(a.mlt->deletePattern(stored));
+    ASSERT_FALSE(a.mlt->getPattern(stored).has_value());
+    ASSERT_FALSE(containsMatch(a.mlt->findMatches(a.signature(), 20), stored));
+
+    ASSERT_TRUE(b.mlt->getPattern(stored).has_value());
+    ASSERT_TRUE(containsMatch(b.mlt->findMatches(b.signature(), 20), stored));
+    ASSERT_TRUE(base->getPattern(stored).has_value());
+}
+
+void test_SaveToFileWritesBaseOnly() {
+    auto base = std::make_shared<const MLT>(syncMlt());
+    Session a(base);
+    a.fill(novelState());
+    const std::string learned = a.matcher.forceCreatePattern("SESSION_A_ONLY");
+
+    for (const char* extension : {".json", ".mltp"}) {
+        TempPatternsFile file("base", extension);
+        ASSERT_TRUE(a.mlt->saveToFile(file.path.string()));
+
+        MLT reloaded(syncMlt());
+        ASSERT_TRUE(reloaded.loadFromFile(file.path.string()));
+        ASSERT_EQ(reloaded.patternCount(), base->patternCount());
+        ASSERT_FALSE(reloaded.getPattern(learned).has_value());
+    }
+}
+
+void test_SessionSnapshotRestoresFullView() {
+    auto base = std::make_shared<const MLT>(syncMlt());
+    Session a(base);
+    a.fill(novelState());
+    const std::string learned = a.matcher.forceCreatePattern("SESSION_A_ONLY");
+    a.mlt->recordActivation("BASE_JOIE");
+
+    TempPatternsFile file("snapshot");
+    ASSERT_TRUE(a.mlt->saveSnapshot(file.path.string()));
+
+    // Reprise de la session (journal, transfert de grappe) au-dessus de la même base
+    MLT restored(base);
+    ASSERT_TRUE(restored.loadSnapshot(file.path.string()));
+    ASSERT_EQ(restored.patternCount(), a.mlt->patternCount());
+    ASSERT_TRUE(restored.getPattern(learned).has_value());
+    ASSERT_EQ(restored.getPattern("BASE_JOIE")->activation_count, 1);
+    ASSERT_EQ(base->getPattern("BASE_JOIE")->activation_count, 0);
+}
+
+void test_SessionLayerCannotBeABase() {
+    auto base = std::make_shared<const MLT>(syncMlt());
+    auto layer = std::make_shared<const MLT>(base);
+
+    bool rejected = false;
+    try {
+        MLT nested(layer);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    ASSERT_TRUE(rejected);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests MLT (couches de session) ===\n";
+
+    std::cout << "\n>> Isolation des sessions\n";
+    RUN_TEST(PatternLearnedInSessionANotMatchedInSessionB);
+    RUN_TEST(BasePatternLearningStaysInSession);
+    RUN_TEST(DeletionInSessionOnlyHidesBasePattern);
+
+    std::cout << "\n>> Persistance\n";
+    RUN_TEST(SaveToFileWritesBaseOnly);
+    RUN_TEST(SessionSnapshotRestoresFullView);
+    RUN_TEST(SessionLayerCannotBeABase);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file PatternMatcherTest.cpp
+ * @brief Tests unitaires du matching incrémental (réutilisation du dernier match)
+ */
+
+#include "PatternMatcher.hpp"
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace mcee;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+EmotionalState calmState() {
+    EmotionalState state;
+    state.emotions[23] = 0.8;
+    state.emotions[6] = 0.6;
+    state.emotions[14] = 0.5;
+    state.emotions[0] = 0.4;
+    return state;
+}
+
+EmotionalState alarmedState() {
+    EmotionalState state;
+    state.emotions[2] = 0.9;
+    state.emotions[4] = 0.7;
+    state.emotions[22] = 0.6;
+    return state;
+}
+
+/**
+ * @brief MCT, MLT et matcher, MCT remplie d'un état constant
+ */
+struct MatcherFixture {
+    std::shared_ptr<MCT> mct;
+    std::shared_ptr<MLT> mlt;
+    PatternMatcher matcher;
+
+    MatcherFixture()
+        : mct(std::make_shared<MCT>(quietMct())),
+          mlt(std::make_shared<MLT>(syncMlt())),
+          matcher(mct, mlt) {
+        fill(calmState(), 60);
+    }
+
+    void fill(const EmotionalState& state, size_t frames) {
+        for (size_t i = 0; i < frames; ++i) mct->push(state);
+    }
+
+    size_t searched() const { return matcher.getEarlyExits() + matcher.getFullScans(); }
+
+    static MCTConfig quietMct() {
+        MCTConfig config;
+        config.log_validation_errors = false;
+        return config;
+    }
+
+    static MLTConfig syncMlt() {
+        MLTConfig config;
+        config.background_learning = false;
+        config.auto_save = false;
+        return config;
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_IdenticalFramesReusedAfterFirstMatch() {
+    MatcherFixture f;
+
+    const MatchResult first = f.matcher.match();
+    ASSERT_FALSE(first.pattern_id.empty());
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 0u);
+    ASSERT_EQ(f.searched(), 1u);
+
+    for (int i = 0; i < 20; ++i) {
+        f.fill(calmState(), 1);
+        auto result = f.matcher.matchShared();
+        ASSERT_EQ(result->pattern_id, first.pattern_id);
+    }
+
+    // Un seul matching complet, les 20 frames identiques sont servies par lui
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 20u);
+    ASSERT_EQ(f.searched(), 1u);
+}
+
+void test_ConsolidationOfRetainedPatternKeepsReuse() {
+    MatcherFixture f;
+    const MatchResult first = f.matcher.match();
+
+    // Renforcement du pattern retenu vers la signature (consolidateToMLT)
+    auto signature = f.mct->extractSignature();
+    ASSERT_TRUE(signature.has_value());
+    f.mlt->updatePattern(first.pattern_id, *signature, 1.0);
+
+    f.fill(calmState(), 1);
+    f.matcher.match();
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 1u);
+    ASSERT_EQ(f.searched(), 1u);
+}
+
+void test_ChangedTopKPatternForcesRematch() {
+    MatcherFixture f;
+    const MatchResult first = f.matcher.match();
+
+    // Coefficients du retenu modifiés : le résultat copié n'est plus valable
+    f.mlt->adjustCoefficients(first.pattern_id, 1.0);
+    f.fill(calmState(), 1);
+    f.matcher.match();
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 0u);
+    ASSERT_EQ(f.searched(), 2u);
+
+    // Le nouveau match est à son tour réutilisé
+    f.fill(calmState(), 1);
+    f.matcher.match();
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 1u);
+    ASSERT_EQ(f.searched(), 2u);
+}
+
+void test_UnrelatedPatternChangeKeepsReuse() {
+    MatcherFixture f;
+    const MatchResult first = f.matcher.match();
+
+    std::string unrelated;
+    for (const auto& pattern : f.mlt->getAllPatterns()) {
+        bool in_top_k = pattern.id == first.pattern_id;
+        for (const auto& alternative : first.alternatives) {
+            in_top_k = in_top_k || alternative.pattern_id == pattern.id;
+        }
+        if (!in_top_k) {
+            unrelated = pattern.id;
+            break;
+        }
+    }
+    ASSERT_FALSE(unrelated.empty());
+
+    f.mlt->adjustCoefficients(unrelated, -1.0);
+    f.fill(calmState(), 1);
+    f.matcher.match();
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 1u);
+    ASSERT_EQ(f.searched(), 1u);
+}
+
+void test_SignatureMovePastToleranceRematches() {
+    MatcherFixture f;
+    f.matcher.match();
+
+    f.fill(alarmedState(), 60);
+    f.matcher.match();
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 0u);
+    ASSERT_EQ(f.searched(), 2u);
+}
+
+void test_IncrementalMatchingDisabledNeverReuses() {
+    MatcherFixture f;
+    PatternMatcherConfig config;
+    config.incremental_matching = false;
+    f.matcher.setConfig(config);
+
+    for (int i = 0; i < 5; ++i) {
+        f.fill(calmState(), 1);
+        f.matcher.match();
+    }
+    ASSERT_EQ(f.matcher.getSkippedMatches(), 0u);
+    ASSERT_EQ(f.matcher.getFullScans(), 5u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests PatternMatcher ===\n";
+
+    std::cout << "\n>> Réutilisation du dernier match\n";
+    RUN_TEST(IdenticalFramesReusedAfterFirstMatch);
+    RUN_TEST(ConsolidationOfRetainedPatternKeepsReuse);
+    RUN_TEST(IncrementalMatchingDisabledNeverReuses);
+
+    std::cout << "\n>> Invalidation\n";
+    RUN_TEST(ChangedTopKPatternForcesRematch);
+    RUN_TEST(UnrelatedPatternChangeKeepsReuse);
+    RUN_TEST(SignatureMovePastToleranceRematches);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
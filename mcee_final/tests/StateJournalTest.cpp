@@ -0,0 +1,273 @@
+/**
+ * @file StateJournalTest.cpp
+ * @brief Tests unitaires du journal d'état (WAL, checkpoints, reprise)
+ */
+
+#include "StateJournal.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace mcee;
+namespace fs = std::filesystem;
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FRAMEWORK DE TEST MINIMAL
+// ═══════════════════════════════════════════════════════════════════════════
+
+static int g_testsRun = 0;
+static int g_testsPassed = 0;
+static int g_testsFailed = 0;
+
+#define RUN_TEST(name) runTest(#name, test_##name)
+
+void runTest(const char* name, void (*func)()) {
+    std::cout << "  - " << name << "... ";
+    g_testsRun++;
+    try {
+        func();
+        std::cout << "OK\n";
+        g_testsPassed++;
+    } catch (const std::exception& e) {
+        std::cout << "ECHEC: " << e.what() << "\n";
+        g_testsFailed++;
+    }
+}
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) throw std::runtime_error("ASSERT_TRUE failed: " #expr)
+
+#define ASSERT_FALSE(expr) \
+    if (expr) throw std::runtime_error("ASSERT_FALSE failed: " #expr)
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) throw std::runtime_error("ASSERT_EQ failed: " #a " != " #b)
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HELPERS
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * @brief Répertoire de journal propre à un test, supprimé à la destruction
+ */
+struct TempJournalDir {
+    fs::path path;
+
+    explicit TempJournalDir(const std::string& name)
+        : path(fs::temp_directory_path() /
+               ("mcee_journal_" + name + "_" + std::to_string(::getpid()))) {
+        fs::remove_all(path);
+    }
+    ~TempJournalDir() {
+        std::error_code ec;
+        fs::remove_all(path, ec);
+    }
+};
+
+JournalConfig testConfig(const TempJournalDir& dir) {
+    JournalConfig config;
+    config.enabled = true;
+    config.directory = dir.path.string();
+    config.commit_interval_ms = 1;
+    config.sync = false;
+    config.checkpoint_interval_seconds = 3600.0;   // Checkpoints déclenchés par les tests seuls
+    config.checkpoint_every_records = 0;
+    return config;
+}
+
+std::string feedbackPayload(double external) {
+    std::string payload;
+    JournalPayloadWriter out(payload);
+    out.put(external);
+    out.put(0.25);
+    return payload;
+}
+
+void waitForCheckpoints(const StateJournal& journal, uint64_t count) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (journal.getStats().checkpoints < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("checkpoint non écrit");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+fs::path lastSegment(const TempJournalDir& dir) {
+    fs::path last;
+    for (const auto& entry : fs::directory_iterator(dir.path)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("wal-", 0) == 0 && (last.empty() || name > last.filename().string())) {
+            last = entry.path();
+        }
+    }
+    return last;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void test_RecoveryAfterCheckpointAndTruncatedRecord() {
+    TempJournalDir dir("recovery");
+    const JournalConfig config = testConfig(dir);
+
+    {
+        StateJournal journal;
+        ASSERT_TRUE(journal.open(config, 0));
+        for (int i = 1; i <= 10; ++i) {
+            ASSERT_EQ(journal.append(JournalRecordType::FEEDBACK, feedbackPayload(i)), static_cast<uint64_t>(i));
+        }
+        journal.commit();
+
+        ASSERT_TRUE(journal.beginCheckpoint(true));
+        nlohmann::json state = {{"marker", "etat_10"}};
+        journal.checkpoint(journal.lastSeq(), std::move(state), [](const std::string& path) {
+            std::ofstream(path, std::ios::binary) << "MLTP";
+            return true;
+        });
+        waitForCheckpoints(journal, 1);
+
+        for (int i = 11; i <= 15; ++i) {
+            journal.append(JournalRecordType::FEEDBACK, feedbackPayload(i));
+        }
+        journal.commit();
+        journal.close();
+    }
+
+    // Arrêt brutal pendant l'écriture du dernier enregistrement
+    const fs::path segment = lastSegment(dir);
+    ASSERT_FALSE(segment.empty());
+    fs::resize_file(segment, fs::file_size(segment) - 3);
+
+    JournalRecovery recovery;
+    std::string error;
+    ASSERT_TRUE(StateJournal::readCheckpoint(config.directory, recovery, &error));
+    ASSERT_TRUE(recovery.has_checkpoint);
+    ASSERT_EQ(recovery.checkpoint_seq, 10u);
+    ASSERT_EQ(recovery.state.value("marker", std::string()), "etat_10");
+    ASSERT_FALSE(recovery.patterns_path.empty());
+    ASSERT_TRUE(fs::exists(recovery.patterns_path));
+
+    std::vector<uint64_t> applied;
+    std::vector<double> externals;
+    StateJournal::replay(config.directory, recovery, [&](const JournalRecord& record) {
+        applied.push_back(record.seq);
+        JournalPayloadReader in(record.payload);
+        double external = 0.0;
+        if (record.type == JournalRecordType::FEEDBACK && in.get(external)) {
+            externals.push_back(external);
+        }
+    });
+
+    ASSERT_EQ(recovery.last_seq, 14u);
+    ASSERT_EQ(recovery.replayed, 4u);
+    ASSERT_EQ(recovery.truncated_segments, 1u);
+    ASSERT_EQ(applied, (std::vector<uint64_t>{11, 12, 13, 14}));
+    ASSERT_EQ(externals, (std::vector<double>{11.0, 12.0, 13.0, 14.0}));
+}
+
+void test_ReopenContinuesSequence() {
+    TempJournalDir dir("reopen");
+    const JournalConfig config = testConfig(dir);
+
+    {
+        StateJournal journal;
+        ASSERT_TRUE(journal.open(config, 0));
+        for (int i = 1; i <= 3; ++i) journal.append(JournalRecordType::URGENCY, feedbackPayload(i));
+        journal.close();
+    }
+
+    JournalRecovery first;
+    ASSERT_TRUE(StateJournal::readCheckpoint(config.directory, first));
+    ASSERT_FALSE(first.has_checkpoint);
+    StateJournal::replay(config.directory, first, [](const JournalRecord&) {});
+    ASSERT_EQ(first.last_seq, 3u);
+    ASSERT_EQ(first.truncated_segments, 0u);
+
+    {
+        StateJournal journal;
+        ASSERT_TRUE(journal.open(config, first.last_seq));
+        ASSERT_EQ(journal.append(JournalRecordType::URGENCY, feedbackPayload(4)), 4u);
+        journal.close();
+    }
+
+    JournalRecovery second;
+    ASSERT_TRUE(StateJournal::readCheckpoint(config.directory, second));
+    StateJournal::replay(config.directory, second, [](const JournalRecord&) {});
+    ASSERT_EQ(second.last_seq, 4u);
+    ASSERT_EQ(second.replayed, 4u);
+}
+
+void test_CheckpointReservedUntilWritten() {
+    TempJournalDir dir("gate");
+    StateJournal journal;
+    ASSERT_TRUE(journal.open(testConfig(dir), 0));
+
+    ASSERT_FALSE(journal.checkpointDue(true));   // Rien à couvrir
+    journal.append(JournalRecordType::FEEDBACK, feedbackPayload(1));
+    ASSERT_TRUE(journal.checkpointDue(true));
+
+    // Réservé : les trames suivantes ne redemandent pas de checkpoint
+    ASSERT_TRUE(journal.beginCheckpoint(true));
+    journal.append(JournalRecordType::FEEDBACK, feedbackPayload(2));
+    ASSERT_FALSE(journal.checkpointDue(true));
+    ASSERT_FALSE(journal.beginCheckpoint(true));
+
+    // Abandon : les enregistrements non couverts redeviennent dus
+    journal.abandonCheckpoint();
+    ASSERT_TRUE(journal.checkpointDue());
+    ASSERT_EQ(journal.getStats().checkpoint_failures, 1u);
+
+    ASSERT_TRUE(journal.beginCheckpoint(true));
+    journal.checkpoint(journal.lastSeq(), nlohmann::json::object());
+    waitForCheckpoints(journal, 1);
+    ASSERT_FALSE(journal.checkpointDue(true));
+    ASSERT_EQ(journal.getStats().last_checkpoint_seq, 2u);
+
+    journal.append(JournalRecordType::FEEDBACK, feedbackPayload(3));
+    ASSERT_TRUE(journal.checkpointDue(true));
+    journal.close();
+}
+
+void test_CorruptCheckpointRejected() {
+    TempJournalDir dir("corrupt");
+    fs::create_directories(dir.path);
+    std::ofstream(dir.path / "checkpoint.bin", std::ios::binary) << "MCKP garbage";
+
+    JournalRecovery recovery;
+    std::string error;
+    ASSERT_FALSE(StateJournal::readCheckpoint(dir.path.string(), recovery, &error));
+    ASSERT_FALSE(recovery.has_checkpoint);
+    ASSERT_FALSE(error.empty());
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MAIN
+// ═══════════════════════════════════════════════════════════════════════════
+
+int main() {
+    std::cout << "=== Tests StateJournal ===\n";
+
+    std::cout << "\n>> Reprise\n";
+    RUN_TEST(RecoveryAfterCheckpointAndTruncatedRecord);
+    RUN_TEST(ReopenContinuesSequence);
+    RUN_TEST(CorruptCheckpointRejected);
+
+    std::cout << "\n>> Checkpoints\n";
+    RUN_TEST(CheckpointReservedUntilWritten);
+
+    std::cout << "\n";
+    std::cout << "  Total:   " << g_testsRun << " tests\n";
+    std::cout << "  Reussis: " << g_testsPassed << "\n";
+    std::cout << "  Echecs:  " << g_testsFailed << "\n";
+
+    return g_testsFailed == 0 ? 0 : 1;
+}
@@ -89,10 +89,15 @@ class RequestType(Enum):
     CONSOLIDATE_ALL_MCT = "consolidate_all_mct"
     CLEANUP_MCT = "cleanup_mct"
     DREAM_CYCLE = "dream_cycle"
+    CONSOLIDATE_BATCH = "consolidate_batch"    # Lots du module reves (mcee.mlt.*)
+    CREATE_EDGE_BATCH = "create_edge_batch"
+    REINFORCE_BATCH = "reinforce_batch"
+    FORGET_BATCH = "forget_batch"
 
     # Requêtes génériques
     CYPHER_QUERY = "cypher_query"
     BATCH_QUERY = "batch_query"
+    BATCH = "batch"                            # Lot de mutations (client MCEE)
 
 
 class MemoryType(Enum):
@@ -147,7 +152,9 @@ class Neo4jService:
                  rabbitmq_user: str = "guest",
                  rabbitmq_pass: str = "guest",
                  request_queue: str = "neo4j.requests.queue",
-                 response_exchange: str = "neo4j.responses"):
+                 response_exchange: str = "neo4j.responses",
+                 dream_queues: Tuple[str, ...] = ("mcee.mlt.consolidate", "mcee.mlt.create_edge",
+                                                  "mcee.mlt.reinforce", "mcee.mlt.forget")):
 
         # Neo4j - connect without auth if password is empty (NEO4J_AUTH=none)
         if neo4j_password:
@@ -162,6 +169,7 @@ class Neo4jService:
         self.rabbitmq_pass = rabbitmq_pass
         self.request_queue = request_queue
         self.response_exchange = response_exchange
+        self.dream_queues = dream_queues
 
         # Extracteur de relations
         self.relation_extractor = RelationExtractor()
@@ -207,9 +215,14 @@ class Neo4jService:
             RequestType.CONSOLIDATE_ALL_MCT.value: self._handle_consolidate_all_mct,
             RequestType.CLEANUP_MCT.value: self._handle_cleanup_mct,
             RequestType.DREAM_CYCLE.value: self._handle_dream_cycle,
+            RequestType.CONSOLIDATE_BATCH.value: self._handle_consolidate_batch,
+            RequestType.CREATE_EDGE_BATCH.value: self._handle_create_edge_batch,
+            RequestType.REINFORCE_BATCH.value: self._handle_reinforce_batch,
+            RequestType.FORGET_BATCH.value: self._handle_forget_batch,
             # Requêtes génériques
             RequestType.CYPHER_QUERY.value: self._handle_cypher_query,
             RequestType.BATCH_QUERY.value: self._handle_batch_query,
+            RequestType.BATCH.value: self._handle_batch,
         }
 
         logger.info(f"Neo4jService initialisé - Neo4j: {neo4j_uri}, RabbitMQ: {rabbitmq_host}")
@@ -281,10 +294,33 @@ class Neo4jService:
                 logger.error(f"Erreur traitement requête: {e}")
                 ch.basic_nack(delivery_tag=method.delivery_tag, requeue=False)
 
+        # Lots d'écriture MLT du module reves : sans réponse, aiguillés sur 'action'
+        def dream_callback(ch, method, properties, body):
+            try:
+                message = json.loads(body.decode())
+                handler = self.handlers.get(message.get('action'))
+                if not handler:
+                    logger.warning(f"Lot de rêve inconnu: {message.get('action')}")
+                    ch.basic_nack(delivery_tag=method.delivery_tag, requeue=False)
+                    return
+
+                result = handler(message)
+                logger.info(f"Lot de rêve #{result['batch']} ({message.get('action')}): "
+                            f"{result['applied']}/{result['unique']} opérations appliquées")
+                ch.basic_ack(delivery_tag=method.delivery_tag)
+
+            except Exception as e:
+                # Les lots sont idempotents : une seule nouvelle livraison après un échec
+                logger.error(f"Erreur traitement lot de rêve: {e}")
+                ch.basic_nack(delivery_tag=method.delivery_tag, requeue=not method.redelivered)
+
         channel.basic_qos(prefetch_count=10)
         channel.basic_consume(queue=self.request_queue, on_message_callback=callback)
+        for queue in self.dream_queues:
+            channel.queue_declare(queue=queue, durable=True)
+            channel.basic_consume(queue=queue, on_message_callback=dream_callback)
 
-        logger.info(f"Écoute sur {self.request_queue}...")
+        logger.info(f"Écoute sur {self.request_queue}, {', '.join(self.dream_queues)}...")
 
         while self.running:
             connection.process_data_events(time_limit=1)
@@ -329,27 +365,22 @@ class Neo4jService:
     # HANDLERS MÉMOIRE
     # ═══════════════════════════════════════════════════════════════════════════
 
-    def _handle_create_memory(self, payload: Dict) -> Dict:
-        """Crée un nouveau souvenir avec support emotional_states {sentence_id: [24 emotions]}"""
-        memory_id = payload.get('id', f"MEM_{datetime.now().timestamp()}")
+    def _prepare_memory(self, payload: Dict) -> Dict:
+        """
+        Normalise le payload d'un create_memory : valeurs par défaut,
+        emotional_states sérialisés et extraction des relations du contexte.
+        Partagé par le handler unitaire et par le lot UNWIND.
+        """
         emotions = payload.get('emotions', [0.0] * 24)
-        dominant = payload.get('dominant', 'Neutre')
-        intensity = payload.get('intensity', 0.0)
-        valence = payload.get('valence', 0.5)
-        weight = payload.get('weight', 0.5)
         context = payload.get('context', '')
         keywords = payload.get('keywords', [])
-        memory_type = payload.get('type', 'Episodic')
         sentence_id = payload.get('sentence_id')
-        
+
         # Support du nouveau format emotional_states
         emotional_states = payload.get('emotional_states', {})
         if sentence_id and not emotional_states:
             # Rétrocompatibilité: créer emotional_states à partir de sentence_id + emotions
             emotional_states = {str(sentence_id): emotions}
-        
-        # Sérialiser en JSON pour Neo4j (Neo4j ne supporte pas les Maps comme propriétés)
-        emotional_states_json = serialize_emotional_states(emotional_states)
 
         # Extraire les relations du contexte avec émotions
         relations = []
@@ -361,6 +392,48 @@ class Neo4jService:
             if not keywords:
                 keywords = [m['word'] for m in mots]
 
+        return {
+            'id': payload.get('id', f"MEM_{datetime.now().timestamp()}"),
+            'type': payload.get('type', 'Episodic'),
+            'emotions': emotions,
+            'dominant': payload.get('dominant', 'Neutre'),
+            'intensity': payload.get('intensity', 0.0),
+            'valence': payload.get('valence', 0.5),
+            'weight': payload.get('weight', 0.5),
+            'context': context,
+            'keywords': keywords,
+            'sentence_id': sentence_id,
+            # Sérialisé en JSON pour Neo4j (Neo4j ne supporte pas les Maps comme propriétés)
+            'emotional_states': serialize_emotional_states(emotional_states),
+            'words': words_with_emotions,
+            'relations': relations
+        }
+
+    @staticmethod
+    def _item_emotional_states(item, sentence_id, emotions) -> str:
+        """emotional_states (JSON) d'un mot ou d'une relation extraits du contexte"""
+        default = {str(sentence_id): emotions} if sentence_id else {}
+        if isinstance(item, dict):
+            return serialize_emotional_states(item.get('emotional_states', default))
+        return serialize_emotional_states(default)
+
+    def _handle_create_memory(self, payload: Dict) -> Dict:
+        """Crée un nouveau souvenir avec support emotional_states {sentence_id: [24 emotions]}"""
+        prepared = self._prepare_memory(payload)
+        memory_id = prepared['id']
+        emotions = prepared['emotions']
+        dominant = prepared['dominant']
+        intensity = prepared['intensity']
+        valence = prepared['valence']
+        weight = prepared['weight']
+        context = prepared['context']
+        keywords = prepared['keywords']
+        memory_type = prepared['type']
+        sentence_id = prepared['sentence_id']
+        emotional_states_json = prepared['emotional_states']
+        words_with_emotions = prepared['words']
+        relations = prepared['relations']
+
         with self.driver.session() as session:
             # Créer le souvenir avec emotional_states en JSON
             result = session.run("""
@@ -396,8 +469,7 @@ class Neo4jService:
             # Créer les concepts avec emotional_states (JSON)
             for word_info in words_with_emotions:
                 word = word_info['word'] if isinstance(word_info, dict) else word_info
-                word_emotional_states = word_info.get('emotional_states', {str(sentence_id): emotions} if sentence_id else {}) if isinstance(word_info, dict) else ({str(sentence_id): emotions} if sentence_id else {})
-                word_es_json = serialize_emotional_states(word_emotional_states)
+                word_es_json = self._item_emotional_states(word_info, sentence_id, emotions)
                 
                 # Lire l'état actuel, fusionner, puis écrire
                 result = session.run("""
@@ -436,8 +508,7 @@ class Neo4jService:
                 w1 = rel_info['source'] if isinstance(rel_info, dict) else rel_info[0]
                 rel_type = rel_info['relation'] if isinstance(rel_info, dict) else rel_info[1]
                 w2 = rel_info['target'] if isinstance(rel_info, dict) else rel_info[2]
-                rel_emotional_states = rel_info.get('emotional_states', {str(sentence_id): emotions} if sentence_id else {}) if isinstance(rel_info, dict) else ({str(sentence_id): emotions} if sentence_id else {})
-                rel_es_json = serialize_emotional_states(rel_emotional_states)
+                rel_es_json = self._item_emotional_states(rel_info, sentence_id, emotions)
                 
                 session.run("""
                     MERGE (c1:Concept {name: $w1})
@@ -533,28 +604,48 @@ class Neo4jService:
                 'sentence_ids': list(emotional_states.keys())
             }
 
-    def _handle_create_trauma(self, payload: Dict) -> Dict:
-        """Crée un trauma avec emotional_states"""
-        trauma_id = payload.get('id', f"TRAUMA_{datetime.now().timestamp()}")
+    def _prepare_trauma(self, payload: Dict) -> Dict:
+        """Normalise le payload d'un create_trauma (partagé avec le lot UNWIND)"""
         emotions = payload.get('emotions', [0.0] * 24)
-        dominant = payload.get('dominant', 'Peur')
-        intensity = payload.get('intensity', 0.9)
-        valence = payload.get('valence', 0.1)
         context = payload.get('context', '')
         trigger_keywords = payload.get('trigger_keywords', [])
         sentence_id = payload.get('sentence_id')
-        
+
         # Support emotional_states
         emotional_states = payload.get('emotional_states', {})
         if sentence_id and not emotional_states:
             emotional_states = {str(sentence_id): emotions}
-        emotional_states_json = serialize_emotional_states(emotional_states)
 
         # Extraire les relations du contexte
         if context and not trigger_keywords:
             mots, _ = self.relation_extractor.extract(context, sentence_id=sentence_id, emotions=emotions)
             trigger_keywords = [m['word'] if isinstance(m, dict) else m for m in mots]
 
+        return {
+            'id': payload.get('id', f"TRAUMA_{datetime.now().timestamp()}"),
+            'dominant': payload.get('dominant', 'Peur'),
+            'intensity': payload.get('intensity', 0.9),
+            'valence': payload.get('valence', 0.1),
+            'context': context,
+            'keywords': trigger_keywords,
+            'sentence_id': sentence_id,
+            'emotional_states': emotional_states,
+            'emotional_states_json': serialize_emotional_states(emotional_states)
+        }
+
+    def _handle_create_trauma(self, payload: Dict) -> Dict:
+        """Crée un trauma avec emotional_states"""
+        prepared = self._prepare_trauma(payload)
+        trauma_id = prepared['id']
+        dominant = prepared['dominant']
+        intensity = prepared['intensity']
+        valence = prepared['valence']
+        context = prepared['context']
+        trigger_keywords = prepared['keywords']
+        sentence_id = prepared['sentence_id']
+        emotional_states = prepared['emotional_states']
+        emotional_states_json = prepared['emotional_states_json']
+
         with self.driver.session() as session:
             result = session.run("""
                 CREATE (t:Memory:Trauma {
@@ -1675,6 +1766,115 @@ class Neo4jService:
             'reinforced_mlt_links': reinforced
         }
 
+    # ═══════════════════════════════════════════════════════════════════════════
+    # HANDLERS LOTS DU MODULE REVES
+    # ═══════════════════════════════════════════════════════════════════════════
+
+    @staticmethod
+    def _dedupe_dream_ops(ops: List[Dict]) -> List[Dict]:
+        """
+        Dédoublonne les opérations d'un lot sur leur clé d'idempotence : la
+        dernière occurrence d'une clé l'emporte, à la position de la première.
+        """
+        unique = {}
+        for op in ops:
+            unique[op['key']] = op
+        return list(unique.values())
+
+    def _run_dream_batch(self, payload: Dict, field: str, query: str) -> Dict:
+        """
+        Applique un lot du module reves en une seule requête UNWIND.
+
+        Les requêtes n'écrivent que des valeurs absolues (MERGE + SET), si bien
+        qu'un lot renvoyé avec le même numéro après un échec de publication,
+        ou relivré par RabbitMQ, laisse le graphe inchangé.
+        """
+        received = payload.get(field, [])
+        ops = self._dedupe_dream_ops(received)
+        applied = 0
+
+        if ops:
+            with self.driver.session() as session:
+                record = session.run(query, ops=ops, batch=payload.get('batch', 0)).single()
+                applied = record['applied'] if record else 0
+
+        return {
+            'batch': payload.get('batch', 0),
+            'phase': payload.get('phase'),
+            'received': len(received),
+            'unique': len(ops),
+            'applied': applied
+        }
+
+    def _handle_consolidate_batch(self, payload: Dict) -> Dict:
+        """Consolide en MLT les souvenirs retenus par la phase de consolidation"""
+        return self._run_dream_batch(payload, 'memories', """
+            UNWIND $ops AS op
+            MERGE (m:Memory {id: op.id})
+            ON CREATE SET
+                m.created_at = datetime(),
+                m.emotional_vector = op.emotional_vector,
+                m.trauma = op.is_trauma,
+                m.is_social = op.is_social,
+                m.weight = op.score,
+                m.activation_count = 1
+            SET m.type = 'MLT',
+                m.consolidated = true,
+                m.consolidated_at = COALESCE(m.consolidated_at, datetime()),
+                m.consolidation_score = op.score,
+                m.dream_key = op.key,
+                m.dream_batch = $batch
+            RETURN count(m) AS applied
+        """)
+
+    def _handle_create_edge_batch(self, payload: Dict) -> Dict:
+        """Crée les liens associatifs découverts pendant le rêve"""
+        # La force d'un lien existant (déjà renforcé, même par un lot arrivé
+        # plus tôt sur mcee.mlt.reinforce) n'est pas ramenée au poids initial
+        return self._run_dream_batch(payload, 'edges', """
+            UNWIND $ops AS op
+            MATCH (s:Memory {id: op.source})
+            MATCH (t:Memory {id: op.target})
+            MERGE (s)-[r:ASSOCIE {type: op.type}]->(t)
+            ON CREATE SET
+                r.created_at = datetime(),
+                r.strength = op.weight,
+                r.activation_count = 1
+            SET r.dream_key = op.key,
+                r.dream_batch = $batch
+            RETURN count(r) AS applied
+        """)
+
+    def _handle_reinforce_batch(self, payload: Dict) -> Dict:
+        """Fixe la force des liens renforcés (poids absolu calculé par le rêve)"""
+        return self._run_dream_batch(payload, 'edges', """
+            UNWIND $ops AS op
+            MATCH (s:Memory {id: op.source})
+            MATCH (t:Memory {id: op.target})
+            MERGE (s)-[r:ASSOCIE {type: op.type}]->(t)
+            ON CREATE SET
+                r.created_at = datetime(),
+                r.activation_count = 1
+            SET r.strength = op.weight,
+                r.dream_key = op.key,
+                r.dream_batch = $batch
+            RETURN count(r) AS applied
+        """)
+
+    def _handle_forget_batch(self, payload: Dict) -> Dict:
+        """Archive puis supprime les souvenirs oubliés"""
+        return self._run_dream_batch(payload, 'memories', """
+            UNWIND $ops AS op
+            MATCH (m:Memory {id: op.memory_id})
+            CREATE (a:ArchivedMemory)
+            SET a = properties(m),
+                a.archived_at = datetime(),
+                a.dream_key = op.key,
+                a.dream_batch = $batch
+            DETACH DELETE m
+            RETURN count(*) AS applied
+        """)
+
     # ═══════════════════════════════════════════════════════════════════════════
     # HANDLERS GÉNÉRIQUES
     # ═══════════════════════════════════════════════════════════════════════════
@@ -1700,6 +1900,364 @@ class Neo4jService:
 
         return results
 
+    def _handle_batch(self, payload: Dict) -> Dict:
+        """
+        Exécute un lot de mutations envoyé par le tampon d'écriture du client.
+
+        L'ordre des opérations est conservé. Les séquences contiguës de
+        réactivations, de créations de souvenirs et de créations de traumas
+        sont regroupées en requêtes UNWIND (une transaction par séquence) ;
+        les autres opérations passent par leur handler habituel. Chaque
+        opération reçoit son propre résultat, corrélé par request_id.
+        """
+        operations = payload.get('operations', [])
+        results = []
+
+        grouped = {
+            RequestType.REACTIVATE.value: self._batch_reactivate,
+            RequestType.CREATE_MEMORY.value: self._batch_create_memory,
+            RequestType.CREATE_TRAUMA.value: self._batch_create_trauma,
+        }
+
+        i = 0
+        while i < len(operations):
+            op = operations[i]
+            op_type = op.get('request_type')
+
+            if op_type in grouped:
+                j = i
+                while j < len(operations) and operations[j].get('request_type') == op_type:
+                    j += 1
+                results.extend(grouped[op_type](operations[i:j]))
+                i = j
+                continue
+
+            response = self._process_request(Neo4jRequest(
+                request_id=op.get('request_id', ''),
+                request_type=op_type,
+                payload=op.get('payload', {})
+            ))
+            results.append({
+                'request_id': response.request_id,
+                'success': response.success,
+                'data': response.data,
+                'error': response.error
+            })
+            i += 1
+
+        return {'results': results}
+
+    def _batch_reactivate(self, operations: List[Dict]) -> List[Dict]:
+        """Réactive plusieurs souvenirs en une seule requête UNWIND"""
+        rows = [{
+            'request_id': op.get('request_id', ''),
+            'id': op['payload']['id'],
+            'strength': op['payload'].get('strength', 1.0),
+            'boost': op['payload'].get('boost_factor', 0.1)
+        } for op in operations]
+
+        found = {}
+        try:
+            with self.driver.session() as session:
+                result = session.run("""
+                    UNWIND $rows AS row
+                    MATCH (m:Memory {id: row.id})
+                    SET m.weight = CASE
+                        WHEN m.weight + row.boost * row.strength * (1 - m.weight) > 1.0 THEN 1.0
+                        ELSE m.weight + row.boost * row.strength * (1 - m.weight)
+                    END,
+                    m.activation_count = COALESCE(m.activation_count, 0) + 1,
+                    m.last_activated = datetime()
+                    RETURN row.request_id AS request_id, m.id AS id,
+                           m.weight AS new_weight, m.activation_count AS activations
+                """, rows=rows)
+                for record in result:
+                    found[record['request_id']] = {
+                        'id': record['id'],
+                        'new_weight': record['new_weight'],
+                        'activations': record['activations']
+                    }
+        except Exception as e:
+            logger.error(f"Erreur batch reactivate: {e}")
+            return [{'request_id': r['request_id'], 'success': False,
+                     'data': None, 'error': str(e)} for r in rows]
+
+        return [{
+            'request_id': r['request_id'],
+            'success': r['request_id'] in found,
+            'data': found.get(r['request_id'], {'error': 'Memory not found'}),
+            'error': None if r['request_id'] in found else 'Memory not found'
+        } for r in rows]
+
+
+    def _batch_create_memory(self, operations: List[Dict]) -> List[Dict]:
+        """
+        Crée plusieurs souvenirs en une transaction de quatre requêtes UNWIND
+        (souvenirs, concepts, liens EVOQUE, relations sémantiques) au lieu de
+        deux à trois allers-retours par mot et par relation.
+
+        Les emotional_states des concepts sont fusionnés côté Python dans
+        l'ordre du lot, comme le ferait une suite d'appels à
+        _handle_create_memory. Seule différence : tous les mots du lot sont
+        écrits avant ses relations, si bien qu'un concept créé par une
+        relation ne reçoit pas les emotional_states de cette relation quand
+        un mot du même lot le crée déjà. Un échec annule toute la séquence.
+        """
+        request_ids = [op.get('request_id', '') for op in operations]
+        try:
+            prepared = [self._prepare_memory(op.get('payload', {})) for op in operations]
+        except Exception as e:
+            logger.error(f"Erreur batch create_memory: {e}")
+            return [{'request_id': rid, 'success': False,
+                     'data': None, 'error': str(e)} for rid in request_ids]
+
+        memories = [{
+            'id': p['id'],
+            'type': p['type'],
+            'emotional_states': p['emotional_states'],
+            'dominant': p['dominant'],
+            'intensity': p['intensity'],
+            'valence': p['valence'],
+            'weight': p['weight'],
+            'context': p['context'],
+            'keywords': p['keywords']
+        } for p in prepared]
+
+        # Concepts : nouveaux emotional_states fusionnés dans l'ordre du lot
+        concepts = {}
+        links = []
+        relations = []
+        for p in prepared:
+            for word_info in p['words']:
+                word = word_info['word'] if isinstance(word_info, dict) else word_info
+                name = word.lower()
+                word_es = deserialize_emotional_states(
+                    self._item_emotional_states(word_info, p['sentence_id'], p['emotions']))
+                concept = concepts.setdefault(name, {'es': {}, 'mem_ids': []})
+                for k, v in word_es.items():
+                    concept['es'][str(k)] = v
+                if p['id'] not in concept['mem_ids']:
+                    concept['mem_ids'].append(p['id'])
+                links.append({'mem_id': p['id'], 'name': name})
+
+            for rel_info in p['relations']:
+                relations.append({
+                    'w1': (rel_info['source'] if isinstance(rel_info, dict) else rel_info[0]).lower(),
+                    'rel_type': rel_info['relation'] if isinstance(rel_info, dict) else rel_info[1],
+                    'w2': (rel_info['target'] if isinstance(rel_info, dict) else rel_info[2]).lower(),
+                    'mem_id': p['id'],
+                    'emotional_states': self._item_emotional_states(rel_info, p['sentence_id'], p['emotions'])
+                })
+
+        try:
+            with self.driver.session() as session:
+                tx = session.begin_transaction()
+                try:
+                    tx.run("""
+                        UNWIND $rows AS row
+                        CREATE (m:Memory {
+                            id: row.id,
+                            type: row.type,
+                            emotional_states: row.emotional_states,
+                            dominant: row.dominant,
+                            intensity: row.intensity,
+                            valence: row.valence,
+                            weight: row.weight,
+                            context: row.context,
+                            keywords: row.keywords,
+                            created_at: datetime(),
+                            last_activated: datetime(),
+                            activation_count: 1
+                        })
+                    """, rows=memories).consume()
+
+                    if concepts:
+                        existing = tx.run("""
+                            UNWIND $names AS name
+                            MATCH (c:Concept {name: name})
+                            RETURN c.name AS name, c.emotional_states AS current_es
+                        """, names=list(concepts.keys()))
+                        for record in existing:
+                            current_es = deserialize_emotional_states(record['current_es'])
+                            current_es.update(concepts[record['name']]['es'])
+                            concepts[record['name']]['es'] = current_es
+
+                        tx.run("""
+                            UNWIND $rows AS row
+                            MERGE (c:Concept {name: row.name})
+                            ON CREATE SET
+                                c.created_at = datetime(),
+                                c.memory_ids = row.mem_ids
+                            ON MATCH SET
+                                c.memory_ids = c.memory_ids +
+                                    [x IN row.mem_ids WHERE NOT x IN c.memory_ids]
+                            SET c.emotional_states = row.es
+                        """, rows=[{
+                            'name': name,
+                            'mem_ids': c['mem_ids'],
+                            'es': serialize_emotional_states(c['es'])
+                        } for name, c in concepts.items()]).consume()
+
+                        tx.run("""
+                            UNWIND $rows AS row
+                            MATCH (m:Memory {id: row.mem_id})
+                            MATCH (c:Concept {name: row.name})
+                            MERGE (m)-[:EVOQUE]->(c)
+                        """, rows=links).consume()
+
+                    if relations:
+                        tx.run("""
+                            UNWIND $rows AS row
+                            MERGE (c1:Concept {name: row.w1})
+                            ON CREATE SET
+                                c1.created_at = datetime(),
+                                c1.memory_ids = [row.mem_id],
+                                c1.emotional_states = row.emotional_states
+                            ON MATCH SET
+                                c1.memory_ids = CASE
+                                    WHEN row.mem_id IN c1.memory_ids THEN c1.memory_ids
+                                    ELSE c1.memory_ids + row.mem_id
+                                END
+                            MERGE (c2:Concept {name: row.w2})
+                            ON CREATE SET
+                                c2.created_at = datetime(),
+                                c2.memory_ids = [row.mem_id],
+                                c2.emotional_states = row.emotional_states
+                            ON MATCH SET
+                                c2.memory_ids = CASE
+                                    WHEN row.mem_id IN c2.memory_ids THEN c2.memory_ids
+                                    ELSE c2.memory_ids + row.mem_id
+                                END
+                            MERGE (c1)-[r:SEMANTIQUE {type: row.rel_type}]->(c2)
+                            ON CREATE SET
+                                r.count = 1,
+                                r.memory_ids = [row.mem_id],
+                                r.emotional_states = row.emotional_states
+                            ON MATCH SET
+                                r.count = r.count + 1,
+                                r.memory_ids = CASE
+                                    WHEN row.mem_id IN r.memory_ids THEN r.memory_ids
+                                    ELSE r.memory_ids + row.mem_id
+                                END
+                        """, rows=relations).consume()
+
+                    tx.commit()
+                finally:
+                    if not tx.closed():
+                        tx.rollback()
+        except Exception as e:
+            logger.error(f"Erreur batch create_memory: {e}")
+            return [{'request_id': rid, 'success': False,
+                     'data': None, 'error': str(e)} for rid in request_ids]
+
+        return [{
+            'request_id': rid,
+            'success': True,
+            'data': {
+                'id': p['id'],
+                'keywords_extracted': p['keywords'],
+                'relations_created': len(p['relations']),
+                'sentence_id': p['sentence_id'],
+                'emotional_states': deserialize_emotional_states(p['emotional_states'])
+            },
+            'error': None
+        } for rid, p in zip(request_ids, prepared)]
+
+    def _batch_create_trauma(self, operations: List[Dict]) -> List[Dict]:
+        """
+        Crée plusieurs traumas et leurs concepts déclencheurs en une
+        transaction de deux requêtes UNWIND. Un échec annule toute la séquence.
+        """
+        request_ids = [op.get('request_id', '') for op in operations]
+        try:
+            prepared = [self._prepare_trauma(op.get('payload', {})) for op in operations]
+        except Exception as e:
+            logger.error(f"Erreur batch create_trauma: {e}")
+            return [{'request_id': rid, 'success': False,
+                     'data': None, 'error': str(e)} for rid in request_ids]
+
+        traumas = [{
+            'id': p['id'],
+            'emotional_states': p['emotional_states_json'],
+            'dominant': p['dominant'],
+            'intensity': p['intensity'],
+            'valence': p['valence'],
+            'context': p['context'],
+            'keywords': p['keywords']
+        } for p in prepared]
+        triggers = [{
+            'trauma_id': p['id'],
+            'name': keyword.lower(),
+            'emotional_states': p['emotional_states_json']
+        } for p in prepared for keyword in p['keywords']]
+
+        try:
+            with self.driver.session() as session:
+                tx = session.begin_transaction()
+                try:
+                    tx.run("""
+                        UNWIND $rows AS row
+                        CREATE (t:Memory:Trauma {
+                            id: row.id,
+                            emotional_states: row.emotional_states,
+                            dominant: row.dominant,
+                            intensity: row.intensity,
+                            valence: row.valence,
+                            weight: 0.95,
+                            trauma: true,
+                            reinforced: true,
+                            forget_rate: 0.001,
+                            context: row.context,
+                            trigger_keywords: row.keywords,
+                            avoidance_behaviors: [],
+                            coping_strategies: [],
+                            therapy_progress: 0.0,
+                            created_at: datetime(),
+                            last_activated: datetime(),
+                            activation_count: 1
+                        })
+                    """, rows=traumas).consume()
+
+                    if triggers:
+                        tx.run("""
+                            UNWIND $rows AS row
+                            MERGE (c:Concept {name: row.name})
+                            ON CREATE SET
+                                c.created_at = datetime(),
+                                c.memory_ids = [row.trauma_id],
+                                c.emotional_states = row.emotional_states
+                            ON MATCH SET
+                                c.memory_ids = CASE
+                                    WHEN row.trauma_id IN c.memory_ids THEN c.memory_ids
+                                    ELSE c.memory_ids + row.trauma_id
+                                END
+                            WITH c, row
+                            MATCH (t:Trauma {id: row.trauma_id})
+                            MERGE (t)-[:TRIGGERED_BY {strength: 0.9}]->(c)
+                            SET c.trauma_associated = true,
+                                c.emotional_valence_personal = -0.5
+                        """, rows=triggers).consume()
+
+                    tx.commit()
+                finally:
+                    if not tx.closed():
+                        tx.rollback()
+        except Exception as e:
+            logger.error(f"Erreur batch create_trauma: {e}")
+            return [{'request_id': rid, 'success': False,
+                     'data': None, 'error': str(e)} for rid in request_ids]
+
+        return [{
+            'request_id': rid,
+            'success': True,
+            'data': {
+                'id': p['id'],
+                'trigger_keywords': p['keywords'],
+                'sentence_id': p['sentence_id'],
+                'emotional_states': p['emotional_states']
+            },
+            'error': None
+        } for rid, p in zip(request_ids, prepared)]
 
 # ═══════════════════════════════════════════════════════════════════════════
 # POINT D'ENTRÉE
@@ -584,6 +584,84 @@ class Neo4jFullTest:
         print(f"  → Erreur: {response}")
         return False
 
+    def test_dream_write_batches(self):
+        """Test lots d'écriture du module reves (dédoublonnage et rejeu)"""
+        source_id = f"TEST_DREAM_{uuid.uuid4().hex[:8]}"
+        target_id = f"TEST_DREAM_{uuid.uuid4().hex[:8]}"
+        self.test_ids.extend([source_id, target_id])
+
+        def memory(memory_id, score):
+            return {'key': f"consolidate:{memory_id}", 'id': memory_id, 'type': 'episodic',
+                    'score': score, 'is_trauma': False, 'is_social': False,
+                    'emotional_vector': self.generate_emotions(0, 0.7)}
+
+        def edge(prefix, weight):
+            return {'key': f"{prefix}:EMOTIONAL:{source_id}>{target_id}",
+                    'source': source_id, 'target': target_id,
+                    'weight': weight, 'type': 'EMOTIONAL'}
+
+        # Clé en double dans le lot : seule la dernière occurrence est appliquée
+        response = self.client.send_request('consolidate_batch', {
+            'action': 'consolidate_batch', 'batch': 1, 'phase': 'DREAM_CONSOLIDATE',
+            'memories': [memory(source_id, 0.5), memory(target_id, 0.8), memory(source_id, 0.7)]
+        })
+        if not response or not response.get('success'):
+            print(f"  → Erreur consolidation: {response}")
+            return False
+        data = response.get('data', {})
+        print(f"  → Consolidation: {data.get('applied')}/{data.get('received')} reçues")
+        if data.get('unique') != 2 or data.get('applied') != 2:
+            return False
+
+        response = self.client.send_request('create_edge_batch', {
+            'action': 'create_edge_batch', 'batch': 2, 'phase': 'DREAM_EXPLORE',
+            'edges': [edge('edge', 0.4)]
+        })
+        if not response or response.get('data', {}).get('applied') != 1:
+            print(f"  → Erreur création d'arête: {response}")
+            return False
+
+        # Lot renvoyé avec le même numéro : le graphe ne change pas
+        reinforce = {
+            'action': 'reinforce_batch', 'batch': 3, 'phase': 'DREAM_EXPLORE',
+            'edges': [edge('reinforce', 0.6)]
+        }
+        for _ in range(2):
+            response = self.client.send_request('reinforce_batch', reinforce)
+            if not response or response.get('data', {}).get('applied') != 1:
+                print(f"  → Erreur renforcement: {response}")
+                return False
+
+        response = self.client.send_request('cypher_query', {
+            'query': """
+                MATCH (s:Memory {id: $source})-[r:ASSOCIE {type: 'EMOTIONAL'}]->(t:Memory {id: $target})
+                RETURN count(r) AS edges, max(r.strength) AS strength,
+                       s.consolidation_score AS score, s.type AS type
+            """,
+            'params': {'source': source_id, 'target': target_id}
+        })
+        rows = response.get('data', []) if response and response.get('success') else []
+        if not rows:
+            print(f"  → Erreur vérification: {response}")
+            return False
+        row = rows[0]
+        print(f"  → Arêtes: {row.get('edges')}, force: {row.get('strength')}, "
+              f"score: {row.get('score')}, type: {row.get('type')}")
+        if row.get('edges') != 1 or row.get('strength') != 0.6:
+            return False
+        if row.get('score') != 0.7 or row.get('type') != 'MLT':
+            return False
+
+        response = self.client.send_request('forget_batch', {
+            'action': 'forget_batch', 'batch': 4, 'phase': 'DREAM_CLEANUP',
+            'memories': [{'key': f"forget:{target_id}", 'memory_id': target_id}]
+        })
+        if not response or response.get('data', {}).get('applied') != 1:
+            print(f"  → Erreur oubli: {response}")
+            return False
+        print(f"  → Oubliés: {response.get('data', {}).get('applied')}")
+        return True
+
     # ═══════════════════════════════════════════════════════════════════════════
     # TESTS RELATIONS SÉMANTIQUES
     # ═══════════════════════════════════════════════════════════════════════════
@@ -1108,6 +1186,7 @@ class Neo4jFullTest:
         self.run_test("Consolidation MCT → MLT", self.test_consolidation)
         self.run_test("Nettoyage MCT", self.test_cleanup_mct)
         self.run_test("Cycle de rêve complet", self.test_dream_cycle)
+        self.run_test("Lots d'écriture du module reves", self.test_dream_write_batches)
 
         # Relations sémantiques
         self.run_test("Extraction de relations", self.test_extract_relations)
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 
 namespace MCEE {
 
@@ -86,6 +87,32 @@ struct DreamConfig {
     
     /// Protection trauma (multiplicateur de rétention)
     double traumaRetentionMultiplier = 10.0;
+
+    // ═══════════════════════════════════════════════════════════
+    // EXÉCUTION INCRÉMENTALE DES PHASES
+    // ═══════════════════════════════════════════════════════════
+
+    /// Souvenirs par unité de travail (scan, consolidation, nettoyage)
+    size_t phaseChunkSize = 256;
+
+    /// Budget de calcul par appel à update() en ms (≤ 0 : phase exécutée d'un bloc)
+    double tickBudget_ms = 10.0;
+
+    /// Threads de scoring pendant le scan (1 : séquentiel)
+    size_t scanThreads = 4;
+
+    // ═══════════════════════════════════════════════════════════
+    // ÉCRITURES NEO4J GROUPÉES (Neo4jBatchCallback)
+    // ═══════════════════════════════════════════════════════════
+
+    /// Taille à partir de laquelle un lot est livré sans attendre la fin de phase
+    size_t writeBatchMaxOps = 5000;
+
+    /// Renvois d'un lot en échec avant abandon
+    int writeBatchMaxRetries = 8;
+
+    /// Attente avant le premier renvoi, doublée à chaque échec (s)
+    double writeRetryBackoff_s = 1.0;
     
     // ═══════════════════════════════════════════════════════════
     // HELPERS
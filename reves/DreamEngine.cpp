@@ -4,6 +4,7 @@
 #include <numeric>
 #include <cmath>
 #include <unordered_map>
+#include <future>
 
 namespace MCEE {
 
@@ -33,6 +34,11 @@ void DreamEngine::update(const std::array<double, 24>& currentEmotionalState,
     activePattern_ = activePattern;
     
     auto now = std::chrono::steady_clock::now();
+
+    // Hors rêve : livrer ce qu'un rêve interrompu n'a pas encore écrit
+    if (!isDreaming(currentState_) && (pendingBatch_ || !writeBatch_.empty())) {
+        deliverWrites(now);
+    }
     
     // Gestion interruption Amyghaleon
     if (amyghaleonAlert && isDreaming(currentState_)) {
@@ -57,43 +63,54 @@ void DreamEngine::update(const std::array<double, 24>& currentEmotionalState,
         return;
     }
     
-    // États de RÊVE - gérer la progression des phases
+    // États de RÊVE - le travail de la phase avance par tranches bornées
+    // (budget par tick), la transition a lieu quand la fenêtre de la phase
+    // est écoulée et son travail terminé
     if (isDreaming(currentState_)) {
+        Deadline deadline;
+        if (config_.tickBudget_ms > 0.0) {
+            deadline = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::milli>(config_.tickBudget_ms));
+        }
+
+        if (!phaseWorkDone_) {
+            phaseWorkDone_ = runPhaseWork(deadline);
+        }
+        if (!phaseWorkDone_) {
+            return;
+        }
+
+        // Frontière de phase : le lot de la phase doit être livré (ou abandonné)
+        if (!deliverWrites(now)) {
+            return;
+        }
+
         auto phaseElapsed = std::chrono::duration<double>(now - currentPhaseStartTime_).count();
         
-        double phaseDuration = 0.0;
         switch (currentState_) {
             case DreamState::DREAM_SCAN:
-                phaseDuration = config_.scanDuration_s();
-                if (phaseElapsed >= phaseDuration) {
-                    executeScanPhase();
+                if (phaseElapsed >= config_.scanDuration_s()) {
                     transitionTo(DreamState::DREAM_CONSOLIDATE);
                     currentPhaseStartTime_ = now;
                 }
                 break;
                 
             case DreamState::DREAM_CONSOLIDATE:
-                phaseDuration = config_.consolidateDuration_s();
-                if (phaseElapsed >= phaseDuration) {
-                    executeConsolidatePhase();
+                if (phaseElapsed >= config_.consolidateDuration_s()) {
                     transitionTo(DreamState::DREAM_EXPLORE);
                     currentPhaseStartTime_ = now;
                 }
                 break;
                 
             case DreamState::DREAM_EXPLORE:
-                phaseDuration = config_.exploreDuration_s();
-                if (phaseElapsed >= phaseDuration) {
-                    executeExplorePhase();
+                if (phaseElapsed >= config_.exploreDuration_s()) {
                     transitionTo(DreamState::DREAM_CLEANUP);
                     currentPhaseStartTime_ = now;
                 }
                 break;
                 
             case DreamState::DREAM_CLEANUP:
-                phaseDuration = config_.cleanupDuration_s();
-                if (phaseElapsed >= phaseDuration) {
-                    executeCleanupPhase();
+                if (phaseElapsed >= config_.cleanupDuration_s()) {
                     transitionTo(DreamState::AWAKE);
                     lastDreamEndTime_ = now;
                     cycleStartTime_ = now;  // Nouveau cycle
@@ -127,47 +144,211 @@ void DreamEngine::interruptDream() {
 // PHASES DU RÊVE
 // ═══════════════════════════════════════════════════════════════════════════
 
-void DreamEngine::executeScanPhase() {
+namespace {
+
+bool deadlinePassed(const std::optional<std::chrono::steady_clock::time_point>& deadline) {
+    return deadline && std::chrono::steady_clock::now() >= *deadline;
+}
+
+} // namespace
+
+void DreamEngine::resetPhaseWork() {
+    phaseCursor_ = 0;
+    phaseWorkDone_ = false;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// ÉCRITURES NEO4J
+// ═══════════════════════════════════════════════════════════════════════════
+
+void DreamEngine::emitConsolidate(const Memory& memory) {
+    if (!batchCallback_) {
+        if (consolidateCallback_) consolidateCallback_(memory);
+        return;
+    }
+    writeBatch_.consolidations.push_back(memory);
+    writeBatch_.phase = currentState_;
+    if (writeBatch_.size() >= config_.writeBatchMaxOps) deliverWrites(std::chrono::steady_clock::now());
+}
+
+void DreamEngine::emitReinforce(const MemoryEdge& edge, double newWeight) {
+    if (!batchCallback_) {
+        if (reinforceCallback_) reinforceCallback_(edge, newWeight);
+        return;
+    }
+    writeBatch_.reinforcements.push_back({edge, newWeight});
+    writeBatch_.phase = currentState_;
+    if (writeBatch_.size() >= config_.writeBatchMaxOps) deliverWrites(std::chrono::steady_clock::now());
+}
+
+void DreamEngine::emitCreateEdge(const MemoryEdge& edge) {
+    if (!batchCallback_) {
+        if (createEdgeCallback_) createEdgeCallback_(edge);
+        return;
+    }
+    writeBatch_.newEdges.push_back(edge);
+    writeBatch_.phase = currentState_;
+    if (writeBatch_.size() >= config_.writeBatchMaxOps) deliverWrites(std::chrono::steady_clock::now());
+}
+
+void DreamEngine::emitDelete(const std::string& memoryId) {
+    if (!batchCallback_) {
+        if (deleteCallback_) deleteCallback_(memoryId);
+        return;
+    }
+    writeBatch_.deletions.push_back(memoryId);
+    writeBatch_.phase = currentState_;
+    if (writeBatch_.size() >= config_.writeBatchMaxOps) deliverWrites(std::chrono::steady_clock::now());
+}
+
+bool DreamEngine::deliverWrites(std::chrono::steady_clock::time_point now) {
+    // Un lot en échec passe avant le suivant : l'ordre des écritures est conservé
+    if (pendingBatch_) {
+        if (now < nextRetryTime_) return false;
+        stats_.writeBatchRetries++;
+        sendPendingBatch(now);
+        if (pendingBatch_) return false;
+    }
+
+    if (writeBatch_.empty()) return true;
+    if (!batchCallback_) {
+        writeBatch_.clear();                 // Callback retiré entre-temps
+        return true;
+    }
+
+    pendingBatch_ = std::move(writeBatch_);
+    pendingBatch_->sequence = ++writeBatchSequence_;
+    pendingAttempts_ = 0;
+    writeBatch_ = DreamWriteBatch{};
+    sendPendingBatch(now);
+    return !pendingBatch_;
+}
+
+void DreamEngine::sendPendingBatch(std::chrono::steady_clock::time_point now) {
+    if (batchCallback_ && batchCallback_(*pendingBatch_)) {
+        stats_.writeBatchesSent++;
+        pendingBatch_.reset();
+        return;
+    }
+
+    if (++pendingAttempts_ > config_.writeBatchMaxRetries) {
+        stats_.writeBatchesDropped++;
+        pendingBatch_.reset();
+        return;
+    }
+
+    // Attente exponentielle : backoff, 2·backoff, 4·backoff...
+    const double wait_s = config_.writeRetryBackoff_s * std::ldexp(1.0, pendingAttempts_ - 1);
+    nextRetryTime_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(wait_s));
+}
+
+bool DreamEngine::runPhaseWork(const Deadline& deadline) {
+    switch (currentState_) {
+        case DreamState::DREAM_SCAN:        return executeScanPhase(deadline);
+        case DreamState::DREAM_CONSOLIDATE: return executeConsolidatePhase(deadline);
+        case DreamState::DREAM_EXPLORE:     return executeExplorePhase(deadline);
+        case DreamState::DREAM_CLEANUP:     return executeCleanupPhase(deadline);
+        default:                            return true;
+    }
+}
+
+bool DreamEngine::executeScanPhase(const Deadline& deadline) {
     // Phase 1: Scanner la MCT et calculer les scores Csocial(t)
-    scoredMemories_.clear();
-    
-    for (auto& memory : mctBuffer_) {
-        memory.consolidationScore = calculateConsolidationScore(memory, currentEmotionalState_);
-        scoredMemories_.push_back(memory);
+    if (phaseCursor_ == 0) {
+        // Les souvenirs arrivés pendant le rêve attendent le cycle suivant
+        scanCount_ = mctBuffer_.size();
+        scoredMemories_.assign(scanCount_, Memory{});
+        scoredIntensity_.clear();
     }
-    
+    scanCount_ = std::min(scanCount_, mctBuffer_.size());  // clearMCT() pendant le scan
+    scoredMemories_.resize(scanCount_);
+
+    const size_t chunk = std::max<size_t>(1, config_.phaseChunkSize);
+    const size_t threads = std::max<size_t>(1, config_.scanThreads);
+
+    auto scoreRange = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            mctBuffer_[i].consolidationScore = calculateConsolidationScore(mctBuffer_[i], currentEmotionalState_);
+            scoredMemories_[i] = mctBuffer_[i];
+        }
+    };
+
+    // Tranches indépendantes : jusqu'à `threads` tranches scorées en parallèle par tour
+    while (phaseCursor_ < scanCount_) {
+        std::vector<std::future<void>> pending;
+        size_t begin = phaseCursor_;
+        for (size_t t = 1; t < threads && begin + chunk < scanCount_; ++t) {
+            size_t end = std::min(begin + chunk, scanCount_);
+            pending.push_back(std::async(std::launch::async, scoreRange, begin, end));
+            begin = end;
+        }
+        size_t end = std::min(begin + chunk, scanCount_);
+        scoreRange(begin, end);
+        for (auto& f : pending) {
+            f.get();
+        }
+        phaseCursor_ = end;
+
+        if (phaseCursor_ < scanCount_ && deadlinePassed(deadline)) {
+            return false;
+        }
+    }
+
     // Trier par score décroissant
-    std::sort(scoredMemories_.begin(), scoredMemories_.end(),
-              [](const Memory& a, const Memory& b) {
-                  return a.consolidationScore > b.consolidationScore;
-              });
+    std::vector<size_t> order(scanCount_);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return scoredMemories_[a].consolidationScore > scoredMemories_[b].consolidationScore;
+    });
+
+    std::vector<Memory> sorted;
+    sorted.reserve(scanCount_);
+    scoredIntensity_.resize(scanCount_);
+    for (size_t k = 0; k < order.size(); ++k) {
+        sorted.push_back(std::move(scoredMemories_[order[k]]));
+        scoredIntensity_[k] = mctIntensity_[order[k]];
+    }
+    scoredMemories_ = std::move(sorted);
+    return true;
 }
 
-void DreamEngine::executeConsolidatePhase() {
+bool DreamEngine::executeConsolidatePhase(const Deadline& deadline) {
     // Phase 2: Transférer les souvenirs significatifs vers MLT
-    double totalScore = 0.0;
-    int consolidated = 0;
-    
-    for (const auto& memory : scoredMemories_) {
-        // Toujours consolider les traumas
-        bool shouldConsolidate = memory.isTrauma || 
-                                 memory.consolidationScore >= config_.consolidationThreshold;
-        
-        if (shouldConsolidate) {
-            // Appeler le callback Neo4j pour persistance
-            if (consolidateCallback_) {
-                consolidateCallback_(memory);
+    if (phaseCursor_ == 0) {
+        consolidatedScore_ = 0.0;
+        consolidatedCount_ = 0;
+    }
+
+    const size_t chunk = std::max<size_t>(1, config_.phaseChunkSize);
+    while (phaseCursor_ < scoredMemories_.size()) {
+        size_t end = std::min(phaseCursor_ + chunk, scoredMemories_.size());
+        for (size_t i = phaseCursor_; i < end; ++i) {
+            const auto& memory = scoredMemories_[i];
+
+            // Toujours consolider les traumas
+            bool shouldConsolidate = memory.isTrauma || 
+                                     memory.consolidationScore >= config_.consolidationThreshold;
+            
+            if (shouldConsolidate) {
+                // Appeler le callback Neo4j pour persistance
+                emitConsolidate(memory);
+                consolidatedScore_ += memory.consolidationScore;
+                consolidatedCount_++;
             }
-            totalScore += memory.consolidationScore;
-            consolidated++;
+        }
+        phaseCursor_ = end;
+
+        if (phaseCursor_ < scoredMemories_.size() && deadlinePassed(deadline)) {
+            return false;
         }
     }
     
     // Mettre à jour les stats
-    if (consolidated > 0) {
-        stats_.totalMemoriesConsolidated += consolidated;
+    if (consolidatedCount_ > 0) {
+        stats_.totalMemoriesConsolidated += consolidatedCount_;
         stats_.averageConsolidationScore = 
-            (stats_.averageConsolidationScore * (stats_.totalMemoriesConsolidated - consolidated) + totalScore) 
+            (stats_.averageConsolidationScore * (stats_.totalMemoriesConsolidated - consolidatedCount_) + consolidatedScore_) 
             / stats_.totalMemoriesConsolidated;
     }
     
@@ -190,28 +371,30 @@ void DreamEngine::executeConsolidatePhase() {
     
     // Appliquer le renforcement
     for (const auto& edge : edgesToReinforce_) {
-        double newWeight = edge.weight * config_.reinforcementFactor;
-        if (reinforceCallback_) {
-            reinforceCallback_(edge, newWeight);
-        }
+        emitReinforce(edge, edge.weight * config_.reinforcementFactor);
     }
+    return true;
 }
 
-void DreamEngine::executeExplorePhase() {
+bool DreamEngine::executeExplorePhase(const Deadline& deadline) {
     // Phase 3: Associations stochastiques - créer des liens inédits
-    edgesToCreate_.clear();
+    if (phaseCursor_ == 0) {
+        // 3a: Explorer les associations causales (basées sur MCTGraph)
+        exploreCausalAssociations();
 
-    // 3a: Explorer les associations causales (basées sur MCTGraph)
-    exploreCausalAssociations();
+        // 3b: Associations stochastiques classiques (ligne par ligne, reprise au curseur)
+        exploreSigma_ = generateStochasticNoise(activePattern_);
+        exploreNoise_ = std::normal_distribution<double>(0.0, exploreSigma_);
+    }
 
-    // 3b: Associations stochastiques classiques
-    double sigma = generateStochasticNoise(activePattern_);
-    std::normal_distribution<double> noise(0.0, sigma);
+    const double sigma = exploreSigma_;
 
     // Explorer des associations entre souvenirs non évidemment liés
-    for (size_t i = 0; i < scoredMemories_.size(); ++i) {
+    while (phaseCursor_ < scoredMemories_.size()) {
+        const size_t i = phaseCursor_++;
+
         for (size_t j = i + 2; j < scoredMemories_.size(); ++j) {  // Skip voisins directs
-            double randomFactor = std::abs(noise(rng_));
+            double randomFactor = std::abs(exploreNoise_(rng_));
 
             // Association probabiliste basée sur le bruit
             if (randomFactor > sigma * 0.5) {
@@ -230,16 +413,17 @@ void DreamEngine::executeExplorePhase() {
                     newEdge.relationType = "stochastic";
                     newEdge.lastActivation = std::chrono::steady_clock::now();
 
-                    edgesToCreate_.push_back(newEdge);
-
-                    if (createEdgeCallback_) {
-                        createEdgeCallback_(newEdge);
-                    }
+                    emitCreateEdge(newEdge);
                     stats_.totalEdgesCreated++;
                 }
             }
         }
+
+        if (phaseCursor_ < scoredMemories_.size() && deadlinePassed(deadline)) {
+            return false;
+        }
     }
+    return true;
 }
 
 void DreamEngine::exploreCausalAssociations() {
@@ -247,114 +431,100 @@ void DreamEngine::exploreCausalAssociations() {
     // Si deux souvenirs partagent un mot déclencheur commun, ils sont liés
 
     if (causalLinks_.empty()) return;
-
-    // Construire un index: mot→liste de souvenirs ayant cette émotion dominante
-    std::unordered_map<std::string, std::vector<size_t>> wordToMemories;
-
-    for (const auto& link : causalLinks_) {
-        // Trouver les souvenirs ayant la même émotion dominante
-        for (size_t i = 0; i < scoredMemories_.size(); ++i) {
-            // Trouver l'émotion dominante du souvenir
-            auto& emotions = scoredMemories_[i].emotionalVector;
-            size_t maxIdx = 0;
-            double maxVal = emotions[0];
-            for (size_t j = 1; j < 24; ++j) {
-                if (emotions[j] > maxVal) {
-                    maxVal = emotions[j];
-                    maxIdx = j;
-                }
-            }
-
-            // Correspondance approximative avec l'émotion du lien causal
-            // (on utilise le nom de l'émotion dominante du lien)
-            if (maxVal > 0.1) {
-                wordToMemories[link.wordLemma].push_back(i);
-            }
+    rebuildCausalWordIndexLocked();
+
+    // Souvenirs éligibles (émotion dominante > 0.1), dans l'ordre du scan.
+    // Chaque lien causal d'un mot y rattache tous les souvenirs éligibles :
+    // l'entrée d'un mot est donc cette liste répétée une fois par lien, dont
+    // seules les 5 premières positions servent aux paires.
+    constexpr size_t MAX_PAIRS = 5;
+    std::vector<size_t> eligible;
+    for (size_t i = 0; i < scoredMemories_.size() && eligible.size() < MAX_PAIRS; ++i) {
+        if (scoredIntensity_[i] > 0.1) {
+            eligible.push_back(i);
         }
     }
+    if (eligible.empty()) return;
 
-    // Créer des arêtes entre souvenirs partageant un mot déclencheur
-    for (const auto& [word, memoryIndices] : wordToMemories) {
-        if (memoryIndices.size() < 2) continue;
+    std::vector<size_t> memoryIndices;
+    for (const auto& word : causalWordOrder_) {
+        const auto& entry = causalWordIndex_.at(word);
 
-        // Trouver le lien causal correspondant pour obtenir la force
-        double causalStrength = 0.5;
-        for (const auto& link : causalLinks_) {
-            if (link.wordLemma == word) {
-                causalStrength = link.causalStrength;
-                break;
+        memoryIndices.clear();
+        for (size_t rep = 0; rep < entry.linkCount && memoryIndices.size() < MAX_PAIRS; ++rep) {
+            for (size_t idx : eligible) {
+                if (memoryIndices.size() >= MAX_PAIRS) break;
+                memoryIndices.push_back(idx);
             }
         }
+        if (entry.linkCount * eligible.size() < 2) continue;
 
         // Créer des arêtes entre toutes les paires (limité à 5 pour éviter explosion)
-        size_t maxPairs = std::min(memoryIndices.size(), (size_t)5);
-        for (size_t i = 0; i < maxPairs; ++i) {
-            for (size_t j = i + 1; j < maxPairs; ++j) {
+        for (size_t i = 0; i < memoryIndices.size(); ++i) {
+            for (size_t j = i + 1; j < memoryIndices.size(); ++j) {
                 const auto& m1 = scoredMemories_[memoryIndices[i]];
                 const auto& m2 = scoredMemories_[memoryIndices[j]];
 
                 MemoryEdge newEdge;
                 newEdge.sourceId = m1.id;
                 newEdge.targetId = m2.id;
-                newEdge.weight = causalStrength * 0.8;  // Poids basé sur force causale
+                newEdge.weight = entry.strength * 0.8;  // Poids basé sur force causale
                 newEdge.relationType = "causal_association";
                 newEdge.lastActivation = std::chrono::steady_clock::now();
 
-                edgesToCreate_.push_back(newEdge);
-
-                if (createEdgeCallback_) {
-                    createEdgeCallback_(newEdge);
-                }
+                emitCreateEdge(newEdge);
                 stats_.totalEdgesCreated++;
             }
         }
     }
-
-    // Bonus: Créer des arêtes directement depuis les top trigger words
-    for (const auto& triggerWord : causalStats_.topTriggerWords) {
-        // Chercher les liens causaux avec ce mot
-        std::vector<std::string> emotionIds;
-        for (const auto& link : causalLinks_) {
-            if (link.wordLemma == triggerWord) {
-                emotionIds.push_back(link.dominantEmotion);
-            }
-        }
-
-        // Signaler les mots déclencheurs importants (pour debug/log)
-        if (!emotionIds.empty()) {
-            // Le mot déclencheur crée des associations plus fortes
-            // (logique métier: ces mots sont significatifs pour Clara)
-        }
-    }
 }
 
-void DreamEngine::executeCleanupPhase() {
+bool DreamEngine::executeCleanupPhase(const Deadline& deadline) {
     // Phase 4: Supprimer les souvenirs sous le seuil (sauf traumas)
-    memoriesToDelete_.clear();
-    
-    for (const auto& memory : scoredMemories_) {
-        // Ne jamais supprimer les traumas
-        if (memory.isTrauma) {
-            continue;
-        }
-        
-        // Appliquer l'oubli exponentiel
-        double decayedScore = memory.consolidationScore * 
-                              std::exp(-config_.forgetDecayRate);
-        
-        if (decayedScore < config_.minWeightBeforeDeletion) {
-            memoriesToDelete_.push_back(memory.id);
+    if (phaseCursor_ == 0) {
+        memoriesToDelete_.clear();
+    }
+
+    const size_t chunk = std::max<size_t>(1, config_.phaseChunkSize);
+    while (phaseCursor_ < scoredMemories_.size()) {
+        size_t end = std::min(phaseCursor_ + chunk, scoredMemories_.size());
+        for (size_t i = phaseCursor_; i < end; ++i) {
+            const auto& memory = scoredMemories_[i];
+
+            // Ne jamais supprimer les traumas
+            if (memory.isTrauma) {
+                continue;
+            }
             
-            if (deleteCallback_) {
-                deleteCallback_(memory.id);
+            // Appliquer l'oubli exponentiel
+            double decayedScore = memory.consolidationScore * 
+                                  std::exp(-config_.forgetDecayRate);
+            
+            if (decayedScore < config_.minWeightBeforeDeletion) {
+                memoriesToDelete_.push_back(memory.id);
+                emitDelete(memory.id);
+                stats_.totalMemoriesForgotten++;
             }
-            stats_.totalMemoriesForgotten++;
+        }
+        phaseCursor_ = end;
+
+        if (phaseCursor_ < scoredMemories_.size() && deadlinePassed(deadline)) {
+            return false;
         }
     }
     
-    // Vider la MCT des éléments traités
-    mctBuffer_.clear();
+    // Vider la MCT des éléments traités (les arrivées pendant le rêve restent)
+    size_t processed = std::min(scanCount_, mctBuffer_.size());
+    mctBuffer_.erase(mctBuffer_.begin(), mctBuffer_.begin() + static_cast<std::ptrdiff_t>(processed));
+    mctIntensity_.erase(mctIntensity_.begin(), mctIntensity_.begin() + static_cast<std::ptrdiff_t>(processed));
+    scanCount_ = 0;
     scoredMemories_.clear();
+    scoredIntensity_.clear();
+    return true;
+}
+
+double DreamEngine::dominantIntensity(const std::array<double, 24>& emotions) {
+    return *std::max_element(emotions.begin(), emotions.end());
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -470,6 +640,10 @@ bool DreamEngine::canCreateAssociation(const Memory& m1, const Memory& m2) const
 void DreamEngine::transitionTo(DreamState newState) {
     DreamState oldState = currentState_;
     currentState_ = newState;
+
+    if (isDreaming(newState) && oldState != newState) {
+        resetPhaseWork();
+    }
     
     if (stateChangeCallback_ && oldState != newState) {
         stateChangeCallback_(oldState, newState);
@@ -553,6 +727,20 @@ bool DreamEngine::canStartDream() const {
 void DreamEngine::addMemoryToMCT(const Memory& memory) {
     std::lock_guard<std::mutex> lock(mutex_);
     mctBuffer_.push_back(memory);
+    mctIntensity_.push_back(dominantIntensity(memory.emotionalVector));
+}
+
+void DreamEngine::addMemoriesToMCT(const std::vector<Memory>& memories) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mctBuffer_.insert(mctBuffer_.end(), memories.begin(), memories.end());
+    for (const auto& memory : memories) {
+        mctIntensity_.push_back(dominantIntensity(memory.emotionalVector));
+    }
+}
+
+size_t DreamEngine::getMCTSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mctBuffer_.size();
 }
 
 const std::vector<Memory>& DreamEngine::getMCTMemories() const {
@@ -564,6 +752,7 @@ const std::vector<Memory>& DreamEngine::getMCTMemories() const {
 void DreamEngine::clearMCT() {
     std::lock_guard<std::mutex> lock(mutex_);
     mctBuffer_.clear();
+    mctIntensity_.clear();
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -576,11 +765,146 @@ void DreamEngine::processMCTGraphSnapshot(
     const CausalStats& stats) {
 
     std::lock_guard<std::mutex> lock(mutex_);
+    replaceCausalGraphLocked(words, causalLinks, stats);
+}
+
+void DreamEngine::replaceCausalGraphLocked(
+    const std::vector<WordNodeSnapshot>& words,
+    const std::vector<CausalLink>& causalLinks,
+    const CausalStats& stats) {
 
     // Stocker les nouvelles données
     wordNodes_ = words;
     causalLinks_ = causalLinks;
     causalStats_ = stats;
+
+    wordNodeIndex_.clear();
+    for (size_t i = 0; i < wordNodes_.size(); ++i) {
+        wordNodeIndex_[wordNodes_[i].id] = i;
+    }
+    causalLinkIndex_.clear();
+    for (size_t i = 0; i < causalLinks_.size(); ++i) {
+        if (!causalLinks_[i].id.empty()) {
+            causalLinkIndex_[causalLinks_[i].id] = i;
+        }
+    }
+    causalIndexDirty_ = true;
+}
+
+bool DreamEngine::applyMCTGraphDelta(const MCTGraphDelta& delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (delta.keyframe) {
+        emotionDominant_.clear();
+        for (const auto& [id, dominant] : delta.emotions) {
+            emotionDominant_[id] = dominant;
+        }
+        replaceCausalGraphLocked(delta.words, delta.causalLinks, delta.stats);
+        for (auto& link : causalLinks_) {
+            resolveCausalLinkLocked(link);
+        }
+        mctGraphSequence_ = delta.sequence;
+        mctDecayEpoch_ = delta.decayEpoch;
+        return true;
+    }
+
+    if (delta.baseSequence != mctGraphSequence_) {
+        return false;
+    }
+
+    // Décroissance des liens non retransmis (époques écoulées côté MCEE)
+    if (delta.decayEpoch != mctDecayEpoch_) {
+        double factor = std::pow(delta.decayFactor,
+                                 static_cast<double>(delta.decayEpoch - mctDecayEpoch_));
+        for (auto& link : causalLinks_) {
+            link.causalStrength *= factor;
+        }
+        mctDecayEpoch_ = delta.decayEpoch;
+    }
+
+    // Retraits : échange avec le dernier élément, index corrigé
+    auto removeAt = [](auto& items, auto& index, const std::string& id, auto idOf) {
+        auto it = index.find(id);
+        if (it == index.end()) return;
+        size_t pos = it->second;
+        index.erase(it);
+        if (pos + 1 != items.size()) {
+            items[pos] = std::move(items.back());
+            index[idOf(items[pos])] = pos;
+        }
+        items.pop_back();
+    };
+
+    for (const auto& id : delta.removedEdgeIds) {
+        removeAt(causalLinks_, causalLinkIndex_, id, [](const CausalLink& l) { return l.id; });
+    }
+    for (const auto& id : delta.removedNodeIds) {
+        removeAt(wordNodes_, wordNodeIndex_, id, [](const WordNodeSnapshot& w) { return w.id; });
+        emotionDominant_.erase(id);
+    }
+
+    // Ajouts / mises à jour
+    for (const auto& word : delta.words) {
+        auto [it, inserted] = wordNodeIndex_.try_emplace(word.id, wordNodes_.size());
+        if (inserted) {
+            wordNodes_.push_back(word);
+        } else {
+            wordNodes_[it->second] = word;
+        }
+    }
+    for (const auto& [id, dominant] : delta.emotions) {
+        emotionDominant_[id] = dominant;
+    }
+    for (const auto& incoming : delta.causalLinks) {
+        CausalLink link = incoming;
+        resolveCausalLinkLocked(link);
+
+        auto [it, inserted] = causalLinkIndex_.try_emplace(link.id, causalLinks_.size());
+        if (inserted) {
+            causalLinks_.push_back(std::move(link));
+        } else {
+            causalLinks_[it->second] = std::move(link);
+        }
+    }
+
+    causalStats_ = delta.stats;
+    mctGraphSequence_ = delta.sequence;
+    causalIndexDirty_ = true;
+    return true;
+}
+
+uint64_t DreamEngine::getMCTGraphSequence() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mctGraphSequence_;
+}
+
+void DreamEngine::resolveCausalLinkLocked(CausalLink& link) const {
+    auto word = wordNodeIndex_.find(link.wordId);
+    if (word != wordNodeIndex_.end()) {
+        link.wordLemma = wordNodes_[word->second].lemma;
+        link.wordPos = wordNodes_[word->second].pos;
+    }
+    auto emotion = emotionDominant_.find(link.emotionId);
+    if (emotion != emotionDominant_.end()) {
+        link.dominantEmotion = emotion->second;
+    }
+}
+
+void DreamEngine::rebuildCausalWordIndexLocked() {
+    if (!causalIndexDirty_) return;
+    causalIndexDirty_ = false;
+
+    // Index mot → liens (nombre de liens, force du premier)
+    causalWordIndex_.clear();
+    causalWordOrder_.clear();
+    for (const auto& link : causalLinks_) {
+        auto [it, inserted] = causalWordIndex_.try_emplace(link.wordLemma);
+        if (inserted) {
+            it->second.strength = link.causalStrength;
+            causalWordOrder_.push_back(link.wordLemma);
+        }
+        it->second.linkCount++;
+    }
 }
 
 const std::vector<CausalLink>& DreamEngine::getCausalLinks() const {
@@ -596,6 +920,14 @@ void DreamEngine::clearCausalLinks() {
     causalLinks_.clear();
     wordNodes_.clear();
     causalStats_ = CausalStats{};
+    causalWordIndex_.clear();
+    causalWordOrder_.clear();
+    causalIndexDirty_ = false;
+    wordNodeIndex_.clear();
+    causalLinkIndex_.clear();
+    emotionDominant_.clear();
+    mctGraphSequence_ = 0;
+    mctDecayEpoch_ = 0;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -627,6 +959,16 @@ void DreamEngine::setNeo4jCreateEdgeCallback(Neo4jCreateEdgeCallback callback) {
     createEdgeCallback_ = std::move(callback);
 }
 
+void DreamEngine::setNeo4jBatchCallback(Neo4jBatchCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batchCallback_ = std::move(callback);
+}
+
+size_t DreamEngine::getPendingWriteCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writeBatch_.size() + (pendingBatch_ ? pendingBatch_->size() : 0);
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONFIGURATION & STATS
 // ═══════════════════════════════════════════════════════════════════════════
@@ -12,6 +12,7 @@
 #include <random>
 #include <optional>
 #include <array>
+#include <unordered_map>
 
 namespace MCEE {
 
@@ -61,6 +62,7 @@ struct MemoryEdge {
  * Lien causal mot→émotion (issu du MCTGraph)
  */
 struct CausalLink {
+    std::string id;                       // ID de l'arête MCTGraph (vide : ancien format)
     std::string wordId;
     std::string wordLemma;
     std::string wordPos;                  // NOUN, VERB, ADJ...
@@ -95,6 +97,30 @@ struct CausalStats {
     double graphDensity = 0.0;
 };
 
+/**
+ * Delta MCTGraph (publication incrémentale de mcee.mct.snapshot)
+ *
+ * Appliqué à l'état de baseSequence : retraits, puis ajouts / mises à jour.
+ * Une keyframe remplace tout le miroir. Les forces sont exprimées à
+ * l'époque decayEpoch ; les liens absents du delta ont perdu
+ * decayFactor^(écart d'époques).
+ */
+struct MCTGraphDelta {
+    uint64_t sequence = 0;
+    uint64_t baseSequence = 0;
+    bool keyframe = false;
+
+    std::vector<WordNodeSnapshot> words;                 // Mots ajoutés / modifiés
+    std::vector<std::pair<std::string, std::string>> emotions;  // ID émotion → émotion dominante
+    std::vector<CausalLink> causalLinks;                 // Lemme / émotion résolus par le moteur
+    std::vector<std::string> removedNodeIds;
+    std::vector<std::string> removedEdgeIds;
+
+    uint32_t decayEpoch = 0;
+    double decayFactor = 1.0;
+    CausalStats stats;
+};
+
 /**
  * Callback pour notifier les changements d'état
  */
@@ -108,6 +134,65 @@ using Neo4jReinforceCallback = std::function<void(const MemoryEdge& edge, double
 using Neo4jDeleteCallback = std::function<void(const std::string& memoryId)>;
 using Neo4jCreateEdgeCallback = std::function<void(const MemoryEdge& edge)>;
 
+/**
+ * Lot d'écritures Neo4j émis par les phases du rêve
+ *
+ * Avec un Neo4jBatchCallback, les phases remplissent ce lot au lieu
+ * d'appeler un callback par souvenir ou par arête. Il est livré à chaque
+ * fin de phase (et dès qu'il atteint DreamConfig::writeBatchMaxOps), pour
+ * être appliqué en requêtes UNWIND groupées par type d'opération.
+ *
+ * Chaque opération porte une clé d'idempotence tirée de son contenu : un
+ * lot rejoué après un échec, ou réémis par un rêve interrompu puis repris,
+ * se dédoublonne côté service (MERGE sur la clé).
+ */
+struct DreamWriteBatch {
+    struct Reinforcement {
+        MemoryEdge edge;
+        double newWeight = 0.0;
+    };
+
+    uint64_t sequence = 0;                   // Numéro du lot (inchangé sur rejeu)
+    DreamState phase = DreamState::AWAKE;    // Dernière phase ayant écrit dans le lot
+
+    std::vector<Memory> consolidations;
+    std::vector<Reinforcement> reinforcements;
+    std::vector<MemoryEdge> newEdges;
+    std::vector<std::string> deletions;      // IDs des souvenirs oubliés
+
+    [[nodiscard]] size_t size() const {
+        return consolidations.size() + reinforcements.size() + newEdges.size() + deletions.size();
+    }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    void clear() {
+        consolidations.clear();
+        reinforcements.clear();
+        newEdges.clear();
+        deletions.clear();
+    }
+
+    // Clés d'idempotence
+    [[nodiscard]] static std::string consolidateKey(const Memory& memory) {
+        return "consolidate:" + memory.id;
+    }
+    [[nodiscard]] static std::string edgeKey(const MemoryEdge& edge) {
+        return "edge:" + edge.relationType + ":" + edge.sourceId + ">" + edge.targetId;
+    }
+    [[nodiscard]] static std::string reinforceKey(const MemoryEdge& edge) {
+        return "reinforce:" + edge.relationType + ":" + edge.sourceId + ">" + edge.targetId;
+    }
+    [[nodiscard]] static std::string forgetKey(const std::string& memoryId) {
+        return "forget:" + memoryId;
+    }
+};
+
+/**
+ * Livre un lot d'écritures ; false signale un échec transitoire
+ * (le même lot, même séquence, sera renvoyé après DreamConfig::writeRetryBackoff_s)
+ */
+using Neo4jBatchCallback = std::function<bool(const DreamWriteBatch& batch)>;
+
 /**
  * ═══════════════════════════════════════════════════════════════════════════
  * DreamEngine - Module de consolidation nocturne/off-line
@@ -172,6 +257,16 @@ public:
      * Ajoute un souvenir à la MCT (appelé pendant l'éveil)
      */
     void addMemoryToMCT(const Memory& memory);
+
+    /**
+     * Ajoute un lot de souvenirs à la MCT (un seul verrouillage)
+     */
+    void addMemoriesToMCT(const std::vector<Memory>& memories);
+
+    /**
+     * Nombre de souvenirs en attente dans la MCT (lecture verrouillée)
+     */
+    [[nodiscard]] size_t getMCTSize() const;
     
     /**
      * Récupère les souvenirs en attente dans la MCT
@@ -195,6 +290,20 @@ public:
                                   const std::vector<CausalLink>& causalLinks,
                                   const CausalStats& stats);
 
+    /**
+     * Applique un delta MCTGraph au miroir local
+     * Coût proportionnel au nombre de changements (plus un facteur de
+     * décroissance par lien quand l'époque avance)
+     * @return false si le delta ne suit pas la séquence du miroir
+     *         (ignoré : attendre la keyframe suivante)
+     */
+    bool applyMCTGraphDelta(const MCTGraphDelta& delta);
+
+    /**
+     * Séquence du dernier delta appliqué (0 : aucun)
+     */
+    [[nodiscard]] uint64_t getMCTGraphSequence() const;
+
     /**
      * Récupère les liens causaux actifs
      */
@@ -219,6 +328,18 @@ public:
     void setNeo4jReinforceCallback(Neo4jReinforceCallback callback);
     void setNeo4jDeleteCallback(Neo4jDeleteCallback callback);
     void setNeo4jCreateEdgeCallback(Neo4jCreateEdgeCallback callback);
+
+    /**
+     * Regroupe les écritures des phases en lots (remplace alors les quatre
+     * callbacks unitaires ci-dessus). La transition vers la phase suivante
+     * attend que le lot de la phase soit livré ou abandonné.
+     */
+    void setNeo4jBatchCallback(Neo4jBatchCallback callback);
+
+    /**
+     * Opérations en attente de livraison (lot en cours + lot à rejouer)
+     */
+    [[nodiscard]] size_t getPendingWriteCount() const;
     
     // ═══════════════════════════════════════════════════════════
     // CONFIGURATION
@@ -238,6 +359,9 @@ public:
         int totalEdgesCreated = 0;
         int totalInterruptions = 0;
         double averageConsolidationScore = 0.0;
+        int writeBatchesSent = 0;            // Lots livrés
+        int writeBatchRetries = 0;           // Renvois après échec
+        int writeBatchesDropped = 0;         // Lots abandonnés (writeBatchMaxRetries)
     };
     
     [[nodiscard]] Stats getStats() const;
@@ -248,16 +372,68 @@ private:
     // PHASES DU RÊVE
     // ═══════════════════════════════════════════════════════════
     
-    void executeScanPhase();
-    void executeConsolidatePhase();
-    void executeExplorePhase();
-    void executeCleanupPhase();
+    using Deadline = std::optional<std::chrono::steady_clock::time_point>;
+
+    /**
+     * Avance le travail de la phase courante jusqu'à l'échéance
+     * @return true quand la phase a terminé son travail
+     */
+    bool runPhaseWork(const Deadline& deadline);
+
+    bool executeScanPhase(const Deadline& deadline);
+    bool executeConsolidatePhase(const Deadline& deadline);
+    bool executeExplorePhase(const Deadline& deadline);
+    bool executeCleanupPhase(const Deadline& deadline);
+
+    /**
+     * Remet à zéro le travail incrémental (entrée dans une phase de rêve)
+     */
+    void resetPhaseWork();
+
+    // Écritures Neo4j : lot si un Neo4jBatchCallback est défini, sinon callbacks unitaires
+    void emitConsolidate(const Memory& memory);
+    void emitReinforce(const MemoryEdge& edge, double newWeight);
+    void emitCreateEdge(const MemoryEdge& edge);
+    void emitDelete(const std::string& memoryId);
+
+    /**
+     * Livre le lot à rejouer puis le lot en cours
+     * @return true quand plus rien n'attend (tout livré ou abandonné)
+     */
+    bool deliverWrites(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Tente l'envoi de pendingBatch_ (succès, échec avec attente, abandon)
+     */
+    void sendPendingBatch(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Intensité de l'émotion dominante (index incrémental de la MCT)
+     */
+    static double dominantIntensity(const std::array<double, 24>& emotions);
 
     /**
      * Génère des associations basées sur les liens causaux
      * Relie les souvenirs partageant des mots déclencheurs communs
      */
     void exploreCausalAssociations();
+
+    /**
+     * Remplace le miroir MCTGraph (snapshot complet ou keyframe)
+     */
+    void replaceCausalGraphLocked(const std::vector<WordNodeSnapshot>& words,
+                                  const std::vector<CausalLink>& causalLinks,
+                                  const CausalStats& stats);
+
+    /**
+     * Lemme / nature du mot et émotion dominante d'un lien, depuis le miroir
+     */
+    void resolveCausalLinkLocked(CausalLink& link) const;
+
+    /**
+     * Reconstruit causalWordIndex_ / causalWordOrder_ si le miroir a changé
+     */
+    void rebuildCausalWordIndexLocked();
     
     // ═══════════════════════════════════════════════════════════
     // CALCULS
@@ -317,18 +493,45 @@ private:
     
     // MCT buffer
     std::vector<Memory> mctBuffer_;
+    std::vector<double> mctIntensity_;       // Émotion dominante, parallèle à mctBuffer_
 
     // Souvenirs scorés pendant le scan
     std::vector<Memory> scoredMemories_;
+    std::vector<double> scoredIntensity_;    // Parallèle à scoredMemories_
 
     // Données MCTGraph (liens causaux mot→émotion)
     std::vector<CausalLink> causalLinks_;
     std::vector<WordNodeSnapshot> wordNodes_;
     CausalStats causalStats_;
+
+    // Index mot déclencheur → liens causaux (reconstruit à la demande
+    // après un snapshot ou un delta)
+    struct CausalWord {
+        size_t linkCount = 0;
+        double strength = 0.5;               // Force du premier lien portant ce mot
+    };
+    std::unordered_map<std::string, CausalWord> causalWordIndex_;
+    std::vector<std::string> causalWordOrder_;  // Ordre de première apparition
+    bool causalIndexDirty_ = false;
+
+    // Miroir MCTGraph : positions par ID pour appliquer les deltas
+    std::unordered_map<std::string, size_t> wordNodeIndex_;
+    std::unordered_map<std::string, size_t> causalLinkIndex_;
+    std::unordered_map<std::string, std::string> emotionDominant_;
+    uint64_t mctGraphSequence_ = 0;
+    uint32_t mctDecayEpoch_ = 0;
+
+    // Travail incrémental de la phase courante
+    size_t phaseCursor_ = 0;
+    bool phaseWorkDone_ = false;
+    size_t scanCount_ = 0;                   // Souvenirs de mctBuffer_ couverts par ce rêve
+    double consolidatedScore_ = 0.0;
+    int consolidatedCount_ = 0;
+    double exploreSigma_ = 0.0;
+    std::normal_distribution<double> exploreNoise_;
     
     // Arêtes à traiter
     std::vector<MemoryEdge> edgesToReinforce_;
-    std::vector<MemoryEdge> edgesToCreate_;
     std::vector<std::string> memoriesToDelete_;
     
     // Callbacks
@@ -337,6 +540,14 @@ private:
     Neo4jReinforceCallback reinforceCallback_;
     Neo4jDeleteCallback deleteCallback_;
     Neo4jCreateEdgeCallback createEdgeCallback_;
+    Neo4jBatchCallback batchCallback_;
+
+    // Lots d'écritures : en cours de remplissage, et livré sans succès
+    DreamWriteBatch writeBatch_;
+    std::optional<DreamWriteBatch> pendingBatch_;
+    uint64_t writeBatchSequence_ = 0;
+    int pendingAttempts_ = 0;
+    std::chrono::steady_clock::time_point nextRetryTime_{};
     
     // Stats
     Stats stats_;
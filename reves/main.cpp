@@ -14,11 +14,14 @@
  * Sorties (RabbitMQ):
  *   - mcee.mlt.consolidate
  *   - mcee.mlt.create_edge
+ *   - mcee.mlt.reinforce
  *   - mcee.mlt.forget
  *   - mcee.dream.status
  */
 
 #include "DreamEngine.hpp"
+#include "EmotionWire.hpp"
+#include "Logger.hpp"
 #include <SimpleAmqpClient/SimpleAmqpClient.h>
 #include <nlohmann/json.hpp>
 #include <iostream>
@@ -26,6 +29,12 @@
 #include <atomic>
 #include <csignal>
 #include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace MCEE;
 using json = nlohmann::json;
@@ -53,12 +62,19 @@ struct Config {
     // Queues sortie
     std::string q_consolidate = "mcee.mlt.consolidate";
     std::string q_create_edge = "mcee.mlt.create_edge";
+    std::string q_reinforce = "mcee.mlt.reinforce";
     std::string q_forget = "mcee.mlt.forget";
     std::string q_status = "mcee.dream.status";
     
     // Cycle
     double cycle_hours = 12.0;
     double awake_hours = 9.0;
+
+    // Ingestion (consommateur multiplexé + pool de workers)
+    int consume_timeout_ms = 100;        // Attente d'un message, toutes queues confondues
+    size_t ingest_workers = 2;           // Threads de parsing / alimentation du DreamEngine
+    size_t ingest_batch_max = 64;        // Messages traités par lot et par worker
+    size_t ingest_queue_capacity = 4096; // Au-delà, le consommateur attend les workers
 };
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -106,6 +122,28 @@ Memory parseMemory(const json& j) {
     return m;
 }
 
+/**
+ * Statistiques globales d'un snapshot / delta ("statistics", anciennement "stats")
+ */
+CausalStats parseCausalStats(const json& j) {
+    CausalStats stats;
+    const char* key = j.contains("statistics") ? "statistics" : "stats";
+    if (!j.contains(key)) return stats;
+
+    const auto& s = j[key];
+    stats.mostFrequentEmotion = s.value("most_frequent_emotion", "");
+    stats.averageEmotionIntensity = s.value("average_emotion_intensity", 0.0);
+    stats.graphDensity = s.value("graph_density", 0.0);
+    stats.totalCausalEdges = s.value("causal_edges", size_t(0));
+
+    if (s.contains("top_trigger_words") && s["top_trigger_words"].is_array()) {
+        for (const auto& tw : s["top_trigger_words"]) {
+            stats.topTriggerWords.push_back(tw.get<std::string>());
+        }
+    }
+    return stats;
+}
+
 /**
  * Parse un snapshot MCTGraph enrichi
  */
@@ -174,42 +212,320 @@ void parseMCTGraphSnapshot(const json& j, DreamEngine& engine) {
     }
 
     // Parser les statistiques globales
-    if (j.contains("stats")) {
-        const auto& s = j["stats"];
-        stats.mostFrequentEmotion = s.value("most_frequent_emotion", "");
-        stats.averageEmotionIntensity = s.value("average_emotion_intensity", 0.0);
-        stats.graphDensity = s.value("graph_density", 0.0);
-
-        if (s.contains("top_trigger_words") && s["top_trigger_words"].is_array()) {
-            for (const auto& tw : s["top_trigger_words"]) {
-                stats.topTriggerWords.push_back(tw.get<std::string>());
-            }
-        }
-    }
+    CausalStats parsed = parseCausalStats(j);
+    parsed.totalCausalEdges = stats.totalCausalEdges;
+    stats = std::move(parsed);
 
     // Envoyer au DreamEngine
     engine.processMCTGraphSnapshot(words, causalLinks, stats);
 
-    std::cout << "[Consumer] MCTGraph snapshot: " << words.size() << " mots, "
-              << causalLinks.size() << " liens causaux\n";
+    MCEE_LOG_DEBUG("Consumer",
+        "MCTGraph snapshot: ", words.size(), " mots, ", causalLinks.size(), " liens causaux");
+}
+
+/**
+ * Parse un message MCTGraph incrémental ("kind": "delta" | "keyframe")
+ * Seuls les nœuds mot, les émotions dominantes et les arêtes CAUSAL sont
+ * conservés ; lemmes et émotions des liens sont résolus par le DreamEngine.
+ */
+MCTGraphDelta parseMCTGraphDelta(const json& j) {
+    MCTGraphDelta delta;
+    delta.keyframe = j.value("kind", "keyframe") == "keyframe";
+    delta.sequence = j.value("sequence", uint64_t(0));
+    delta.baseSequence = j.value("base_sequence", uint64_t(0));
+    delta.decayEpoch = j.value("decay_epoch", uint32_t(0));
+    delta.decayFactor = j.value("edge_decay_factor", 1.0);
+
+    if (j.contains("word_nodes") && j["word_nodes"].is_array()) {
+        for (const auto& wn : j["word_nodes"]) {
+            WordNodeSnapshot w;
+            w.id = wn.value("id", "");
+            w.lemma = wn.value("lemma", "");
+            w.pos = wn.value("pos", "");
+            w.sentenceId = wn.value("sentence_id", "");
+            w.sentimentScore = wn.value("sentiment_score", 0.0);
+            w.isNegation = wn.value("is_negation", false);
+            w.isIntensifier = wn.value("is_intensifier", false);
+            delta.words.push_back(std::move(w));
+        }
+    }
+
+    if (j.contains("emotion_nodes") && j["emotion_nodes"].is_array()) {
+        for (const auto& en : j["emotion_nodes"]) {
+            delta.emotions.emplace_back(en.value("id", ""), en.value("dominant_emotion", ""));
+        }
+    }
+
+    if (j.contains("edges") && j["edges"].is_array()) {
+        for (const auto& edge : j["edges"]) {
+            if (edge.value("type", "") != "CAUSAL") continue;
+
+            CausalLink link;
+            link.id = edge.value("id", "");
+            link.wordId = edge.value("source_id", "");
+            link.emotionId = edge.value("target_id", "");
+            link.causalStrength = edge.value("weight", 0.5);
+            link.temporalDistanceMs = edge.value("temporal_distance_ms", 0.0);
+            link.timestamp = std::chrono::steady_clock::now();
+            delta.causalLinks.push_back(std::move(link));
+        }
+    }
+
+    if (j.contains("removed_node_ids")) {
+        delta.removedNodeIds = j["removed_node_ids"].get<std::vector<std::string>>();
+    }
+    if (j.contains("removed_edge_ids")) {
+        delta.removedEdgeIds = j["removed_edge_ids"].get<std::vector<std::string>>();
+    }
+
+    delta.stats = parseCausalStats(j);
+    return delta;
 }
 
-void publish(const std::string& queue, const json& payload) {
-    if (!g_channel) return;
+bool publish(const std::string& queue, const json& payload) {
+    if (!g_channel) return false;
     try {
         auto msg = AmqpClient::BasicMessage::Create(payload.dump());
         msg->ContentType("application/json");
         g_channel->BasicPublish("", queue, msg);
+        return true;
     } catch (const std::exception& e) {
-        std::cerr << "[RMQ] Erreur publish: " << e.what() << "\n";
+        MCEE_LOG_ERROR("RMQ", "Erreur publish: ", e.what());
+        return false;
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// FILE D'INGESTION
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Message brut en attente de parsing par un worker
+ */
+struct IngestItem {
+    enum class Kind { MEMORY, MCT };
+
+    Kind kind = Kind::MEMORY;
+    std::string memoryType;   // Type de souvenir (MEMORY)
+    std::string body;
+    uint64_t seq = 0;         // Ordre d'arrivée (snapshots : le plus récent l'emporte)
+};
+
+/**
+ * File bornée multi-producteurs / multi-consommateurs, dépilée par lots
+ */
+class IngestQueue {
+public:
+    explicit IngestQueue(size_t capacity) : capacity_(capacity < 1 ? 1 : capacity) {}
+
+    /**
+     * Empile un message ; attend si la file est pleine
+     * @return false si la file est fermée
+     */
+    bool push(IngestItem item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) return false;
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * Dépile jusqu'à max messages ; attend qu'il y en ait au moins un
+     * @return Nombre de messages (0 : file fermée et vide)
+     */
+    size_t popBatch(std::vector<IngestItem>& out, size_t max) {
+        out.clear();
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        while (!items_.empty() && out.size() < max) {
+            out.push_back(std::move(items_.front()));
+            items_.pop_front();
+        }
+        notFull_.notify_all();
+        return out.size();
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::deque<IngestItem> items_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+};
+
+// Dernier snapshot appliqué (les workers peuvent finir dans le désordre)
+std::mutex g_snapshotMutex;
+uint64_t g_lastSnapshotSeq = 0;
+
+// Deltas MCTGraph arrivés avant leur prédécesseur (séquence MCEE → delta)
+constexpr size_t MAX_PENDING_DELTAS = 16;
+std::map<uint64_t, MCTGraphDelta> g_pendingDeltas;
+
+/**
+ * Applique un delta (sous g_snapshotMutex), puis ceux qu'il débloque
+ * Un delta en avance est mis de côté ; au-delà de MAX_PENDING_DELTAS la
+ * séquence est perdue et le miroir attend la keyframe suivante.
+ */
+void applyGraphDelta(MCTGraphDelta delta, DreamEngine& engine) {
+    if (delta.sequence <= engine.getMCTGraphSequence()) {
+        return;  // Déjà couvert (keyframe plus récente)
+    }
+    if (delta.keyframe) {
+        // Les deltas antérieurs à la keyframe sont devenus inutiles
+        g_pendingDeltas.erase(g_pendingDeltas.begin(), g_pendingDeltas.upper_bound(delta.sequence));
+    }
+
+    if (!engine.applyMCTGraphDelta(delta)) {
+        if (g_pendingDeltas.size() >= MAX_PENDING_DELTAS) {
+            MCEE_LOG_WARN("Consumer",
+                "Deltas MCTGraph manquants avant seq ", delta.sequence, " : attente d'une keyframe");
+            g_pendingDeltas.clear();
+        }
+        g_pendingDeltas.emplace(delta.sequence, std::move(delta));
+        return;
+    }
+
+    MCEE_LOG_DEBUG("Consumer",
+        "MCTGraph ", (delta.keyframe ? "keyframe" : "delta"), " seq ", delta.sequence, ": ",
+        delta.words.size(), " mots, ", delta.causalLinks.size(), " liens causaux, ",
+        delta.removedNodeIds.size() + delta.removedEdgeIds.size(), " retraits");
+
+    // Débloquer les suivants déjà arrivés
+    auto next = g_pendingDeltas.find(engine.getMCTGraphSequence() + 1);
+    while (next != g_pendingDeltas.end() && engine.applyMCTGraphDelta(next->second)) {
+        g_pendingDeltas.erase(next);
+        next = g_pendingDeltas.find(engine.getMCTGraphSequence() + 1);
+    }
+}
+
+/**
+ * Worker : parse les messages par lots et alimente le DreamEngine
+ */
+void ingestWorker(DreamEngine& engine, IngestQueue& queue) {
+    std::vector<IngestItem> batch;
+    std::vector<Memory> memories;
+
+    while (queue.popBatch(batch, g_config.ingest_batch_max) > 0) {
+        memories.clear();
+
+        for (const auto& item : batch) {
+            try {
+                json j = json::parse(item.body);
+
+                if (item.kind == IngestItem::Kind::MEMORY) {
+                    Memory m = parseMemory(j);
+                    m.type = item.memoryType;
+                    memories.push_back(std::move(m));
+                } else if (j.contains("kind")) {
+                    // Publication MCTGraph incrémentale (delta / keyframe)
+                    MCTGraphDelta delta = parseMCTGraphDelta(j);
+                    std::lock_guard<std::mutex> lock(g_snapshotMutex);
+                    applyGraphDelta(std::move(delta), engine);
+                } else if (j.contains("word_nodes") && j.contains("edges")) {
+                    // Snapshot MCTGraph enrichi : ignoré si un plus récent est déjà appliqué
+                    std::lock_guard<std::mutex> lock(g_snapshotMutex);
+                    if (item.seq > g_lastSnapshotSeq) {
+                        g_lastSnapshotSeq = item.seq;
+                        parseMCTGraphSnapshot(j, engine);
+                    }
+                } else {
+                    // Format ancien: traiter comme mémoire simple
+                    Memory m = parseMemory(j);
+                    m.type = "mct";
+                    memories.push_back(std::move(m));
+                }
+            } catch (const std::exception& e) {
+                MCEE_LOG_ERROR("Consumer",
+                    "Erreur parsing ",
+                    (item.kind == IngestItem::Kind::MCT ? "MCT" : item.memoryType), ": ", e.what());
+            }
+        }
+
+        if (!memories.empty()) {
+            engine.addMemoriesToMCT(memories);
+            MCEE_LOG_DEBUG("Consumer", "+ ", memories.size(), " souvenir(s) (lot de ", batch.size(), ")");
+        }
     }
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// VOIE PRIORITAIRE (traitée directement par le consommateur)
+// ═══════════════════════════════════════════════════════════════════════════
+
+void handleAmyghaleonMessage(const AmqpClient::BasicMessage::ptr_t& message) {
+    try {
+        json j = json::parse(message->Body());
+        bool alert = j.value("alert", false);
+        if (alert) {
+            g_amyghaleonAlert = true;
+            MCEE_LOG_WARN("Consumer", "Alerte Amyghaleon!");
+        }
+    } catch (...) {}
+}
+
+void handlePatternMessage(const AmqpClient::BasicMessage::ptr_t& message) {
+    try {
+        if (message->ContentTypeIsSet() && mcee::isEmotionFrameContentType(message->ContentType())) {
+            // Trame binaire : pattern + 24 émotions sans parsing JSON
+            mcee::EmotionFrame frame;
+            if (mcee::decodeEmotionFrame(message->Body(), frame)) {
+                std::lock_guard<std::mutex> lock(g_stateMutex);
+                g_activePattern = frame.pattern_id.empty() ? "SERENITE" : frame.pattern_id;
+                for (size_t i = 0; i < mcee::WIRE_EMOTION_COUNT; ++i) {
+                    g_currentEmotions[i] = frame.emotions[i];
+                }
+            }
+            return;
+        }
+        if (message->ContentTypeIsSet() && mcee::isEmotionBatchContentType(message->ContentType())) {
+            // Lot de trames : seul l'état le plus récent compte ici
+            std::vector<mcee::EmotionFrame> frames;
+            if (mcee::decodeEmotionBatch(message->Body(), frames) && !frames.empty()) {
+                const mcee::EmotionFrame& frame = frames.back();
+                std::lock_guard<std::mutex> lock(g_stateMutex);
+                g_activePattern = frame.pattern_id.empty() ? "SERENITE" : frame.pattern_id;
+                for (size_t i = 0; i < mcee::WIRE_EMOTION_COUNT; ++i) {
+                    g_currentEmotions[i] = frame.emotions[i];
+                }
+            }
+            return;
+        }
+
+        json j = json::parse(message->Body());
+        std::lock_guard<std::mutex> lock(g_stateMutex);
+        g_activePattern = j.value("pattern", "SERENITE");
+        if (j.contains("emotions") && j["emotions"].is_array()) {
+            for (size_t i = 0; i < std::min(j["emotions"].size(), (size_t)24); ++i) {
+                g_currentEmotions[i] = j["emotions"][i].get<double>();
+            }
+        }
+    } catch (...) {}
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CONSUMER THREAD
 // ═══════════════════════════════════════════════════════════════════════════
 
+/**
+ * Consommateur unique : les sept queues partagent un channel, chaque
+ * message est aiguillé d'après son consumer tag. Alertes et pattern actif
+ * sont traités immédiatement ; souvenirs et snapshots partent en lots vers
+ * le pool de workers.
+ */
 void consumerThread(DreamEngine& engine) {
+    IngestQueue queue(g_config.ingest_queue_capacity);
+    std::vector<std::thread> workers;
+
     try {
         auto channel = AmqpClient::Channel::Create(
             g_config.rabbitmq_host, g_config.rabbitmq_port,
@@ -225,85 +541,68 @@ void consumerThread(DreamEngine& engine) {
         channel->DeclareQueue(g_config.q_pattern, false, true, false, false);
         channel->DeclareQueue(g_config.q_amyghaleon, false, true, false, false);
         
-        // Consumers
-        auto tagEpi = channel->BasicConsume(g_config.q_episodic, "", true, true, false);
-        auto tagSem = channel->BasicConsume(g_config.q_semantic, "", true, true, false);
-        auto tagProc = channel->BasicConsume(g_config.q_procedural, "", true, true, false);
-        auto tagAuto = channel->BasicConsume(g_config.q_autobio, "", true, true, false);
-        auto tagMct = channel->BasicConsume(g_config.q_mct, "", true, true, false);
-        auto tagPat = channel->BasicConsume(g_config.q_pattern, "", true, true, false);
-        auto tagAmy = channel->BasicConsume(g_config.q_amyghaleon, "", true, true, false);
-        
-        std::cout << "[Consumer] Écoute des queues...\n";
+        // Consumers (un seul channel, aiguillage par tag)
+        enum class Route { MEMORY, MCT, PATTERN, AMYGHALEON };
+        struct RouteInfo { Route route; std::string memoryType; };
+        std::unordered_map<std::string, RouteInfo> routes;
+
+        auto consume = [&](const std::string& queueName, Route route, const std::string& memoryType = "") {
+            routes[channel->BasicConsume(queueName, "", true, true, false)] = RouteInfo{route, memoryType};
+        };
+        consume(g_config.q_episodic, Route::MEMORY, "episodic");
+        consume(g_config.q_semantic, Route::MEMORY, "semantic");
+        consume(g_config.q_procedural, Route::MEMORY, "procedural");
+        consume(g_config.q_autobio, Route::MEMORY, "autobiographic");
+        consume(g_config.q_mct, Route::MCT);
+        consume(g_config.q_pattern, Route::PATTERN);
+        consume(g_config.q_amyghaleon, Route::AMYGHALEON);
+
+        for (size_t i = 0; i < std::max<size_t>(1, g_config.ingest_workers); ++i) {
+            workers.emplace_back(ingestWorker, std::ref(engine), std::ref(queue));
+        }
         
+        MCEE_LOG_INFO("Consumer", "Écoute des queues (", workers.size(), " worker(s))...");
+
+        uint64_t seq = 0;
         while (g_running) {
             AmqpClient::Envelope::ptr_t env;
-            
-            // Mémoires
-            auto processMemory = [&](const std::string& tag, const std::string& type) {
-                if (channel->BasicConsumeMessage(tag, env, 10)) {
-                    try {
-                        json j = json::parse(env->Message()->Body());
-                        Memory m = parseMemory(j);
-                        m.type = type;
-                        engine.addMemoryToMCT(m);
-                        std::cout << "[Consumer] + " << type << ": " << m.id << "\n";
-                    } catch (...) {}
-                }
-            };
-            
-            processMemory(tagEpi, "episodic");
-            processMemory(tagSem, "semantic");
-            processMemory(tagProc, "procedural");
-            processMemory(tagAuto, "autobiographic");
-
-            // Traitement spécial pour MCTGraph snapshots
-            if (channel->BasicConsumeMessage(tagMct, env, 10)) {
-                try {
-                    json j = json::parse(env->Message()->Body());
-                    // Vérifier si c'est un snapshot MCTGraph enrichi
-                    if (j.contains("word_nodes") && j.contains("edges")) {
-                        parseMCTGraphSnapshot(j, engine);
-                    } else {
-                        // Format ancien: traiter comme mémoire simple
-                        Memory m = parseMemory(j);
-                        m.type = "mct";
-                        engine.addMemoryToMCT(m);
-                        std::cout << "[Consumer] + mct (legacy): " << m.id << "\n";
-                    }
-                } catch (const std::exception& e) {
-                    std::cerr << "[Consumer] Erreur parsing MCT: " << e.what() << "\n";
-                }
+            if (!channel->BasicConsumeMessage(env, g_config.consume_timeout_ms) || !env) {
+                continue;
             }
-            
-            // Pattern
-            if (channel->BasicConsumeMessage(tagPat, env, 10)) {
-                try {
-                    json j = json::parse(env->Message()->Body());
-                    std::lock_guard<std::mutex> lock(g_stateMutex);
-                    g_activePattern = j.value("pattern", "SERENITE");
-                    if (j.contains("emotions") && j["emotions"].is_array()) {
-                        for (size_t i = 0; i < std::min(j["emotions"].size(), (size_t)24); ++i) {
-                            g_currentEmotions[i] = j["emotions"][i].get<double>();
-                        }
-                    }
-                } catch (...) {}
+
+            auto it = routes.find(env->ConsumerTag());
+            if (it == routes.end()) {
+                continue;
             }
-            
-            // Amyghaleon
-            if (channel->BasicConsumeMessage(tagAmy, env, 10)) {
-                try {
-                    json j = json::parse(env->Message()->Body());
-                    g_amyghaleonAlert = j.value("alert", false);
-                    if (g_amyghaleonAlert) {
-                        std::cout << "[Consumer] ⚠️ Alerte Amyghaleon!\n";
-                    }
-                } catch (...) {}
+
+            switch (it->second.route) {
+                case Route::AMYGHALEON:
+                    handleAmyghaleonMessage(env->Message());
+                    break;
+                case Route::PATTERN:
+                    handlePatternMessage(env->Message());
+                    break;
+                case Route::MEMORY:
+                case Route::MCT: {
+                    IngestItem item;
+                    item.kind = it->second.route == Route::MCT ? IngestItem::Kind::MCT : IngestItem::Kind::MEMORY;
+                    item.memoryType = it->second.memoryType;
+                    item.body = env->Message()->Body();
+                    item.seq = ++seq;
+                    queue.push(std::move(item));
+                    break;
+                }
             }
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "[Consumer] Erreur: " << e.what() << "\n";
+        MCEE_LOG_ERROR("Consumer", "Erreur: ", e.what());
+    }
+
+    // Les workers terminent les messages déjà reçus
+    queue.close();
+    for (auto& worker : workers) {
+        worker.join();
     }
 }
 
@@ -335,10 +634,12 @@ int main(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--cycle") == 0 && i+1 < argc)
             g_config.cycle_hours = std::stod(argv[++i]);
     }
+
+    // Journal asynchrone : MCEE_LOG_LEVEL / MCEE_LOG_FORMAT / MCEE_LOG_FILE
+    mcee::Logger::instance().configureFromEnv();
     
-    std::cout << "[Config] RabbitMQ: " << g_config.rabbitmq_host 
-              << ":" << g_config.rabbitmq_port << "\n";
-    std::cout << "[Config] Cycle: " << g_config.cycle_hours << "h\n\n";
+    MCEE_LOG_INFO("Config", "RabbitMQ: ", g_config.rabbitmq_host, ":", g_config.rabbitmq_port);
+    MCEE_LOG_INFO("Config", "Cycle: ", g_config.cycle_hours, "h");
     
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
@@ -352,6 +653,7 @@ int main(int argc, char* argv[]) {
         
         g_channel->DeclareQueue(g_config.q_consolidate, false, true, false, false);
         g_channel->DeclareQueue(g_config.q_create_edge, false, true, false, false);
+        g_channel->DeclareQueue(g_config.q_reinforce, false, true, false, false);
         g_channel->DeclareQueue(g_config.q_forget, false, true, false, false);
         g_channel->DeclareQueue(g_config.q_status, false, true, false, false);
         
@@ -363,48 +665,86 @@ int main(int argc, char* argv[]) {
         DreamEngine engine(cfg);
         
         // Callbacks vers MLT
-        engine.setNeo4jConsolidateCallback([](const Memory& m) {
-            json payload;
-            payload["action"] = "consolidate";
-            payload["memory"] = {
-                {"id", m.id}, {"type", m.type}, {"score", m.consolidationScore},
-                {"is_trauma", m.isTrauma}, {"is_social", m.isSocial}
+        // Écritures vers MLT : un message groupé par type d'opération et par lot,
+        // chaque élément portant sa clé d'idempotence (appliqué en UNWIND côté MLT)
+        engine.setNeo4jBatchCallback([](const DreamWriteBatch& batch) {
+            const auto header = [&batch](const char* action) {
+                json payload;
+                payload["action"] = action;
+                payload["batch"] = batch.sequence;
+                payload["phase"] = dreamStateToString(batch.phase);
+                return payload;
             };
-            json ev = json::array();
-            for (double e : m.emotionalVector) ev.push_back(e);
-            payload["memory"]["emotional_vector"] = ev;
-            publish(g_config.q_consolidate, payload);
-            std::cout << "[MLT] → Consolidate: " << m.id << "\n";
-        });
-        
-        engine.setNeo4jCreateEdgeCallback([](const MemoryEdge& e) {
-            json payload;
-            payload["action"] = "create_edge";
-            payload["edge"] = {
-                {"source", e.sourceId}, {"target", e.targetId},
-                {"weight", e.weight}, {"type", e.relationType}
-            };
-            publish(g_config.q_create_edge, payload);
-            std::cout << "[MLT] → Edge: " << e.sourceId << " → " << e.targetId << "\n";
-        });
-        
-        engine.setNeo4jDeleteCallback([](const std::string& id) {
-            json payload;
-            payload["action"] = "forget";
-            payload["memory_id"] = id;
-            publish(g_config.q_forget, payload);
-            std::cout << "[MLT] → Forget: " << id << "\n";
+            bool ok = true;
+
+            if (!batch.consolidations.empty()) {
+                json payload = header("consolidate_batch");
+                json items = json::array();
+                for (const auto& m : batch.consolidations) {
+                    json ev = json::array();
+                    for (double e : m.emotionalVector) ev.push_back(e);
+                    items.push_back({
+                        {"key", DreamWriteBatch::consolidateKey(m)},
+                        {"id", m.id}, {"type", m.type}, {"score", m.consolidationScore},
+                        {"is_trauma", m.isTrauma}, {"is_social", m.isSocial},
+                        {"emotional_vector", ev}
+                    });
+                }
+                payload["memories"] = std::move(items);
+                ok = publish(g_config.q_consolidate, payload) && ok;
+            }
+
+            if (!batch.newEdges.empty()) {
+                json payload = header("create_edge_batch");
+                json items = json::array();
+                for (const auto& e : batch.newEdges) {
+                    items.push_back({
+                        {"key", DreamWriteBatch::edgeKey(e)},
+                        {"source", e.sourceId}, {"target", e.targetId},
+                        {"weight", e.weight}, {"type", e.relationType}
+                    });
+                }
+                payload["edges"] = std::move(items);
+                ok = publish(g_config.q_create_edge, payload) && ok;
+            }
+
+            if (!batch.reinforcements.empty()) {
+                json payload = header("reinforce_batch");
+                json items = json::array();
+                for (const auto& r : batch.reinforcements) {
+                    items.push_back({
+                        {"key", DreamWriteBatch::reinforceKey(r.edge)},
+                        {"source", r.edge.sourceId}, {"target", r.edge.targetId},
+                        {"weight", r.newWeight}, {"type", r.edge.relationType}
+                    });
+                }
+                payload["edges"] = std::move(items);
+                ok = publish(g_config.q_reinforce, payload) && ok;
+            }
+
+            if (!batch.deletions.empty()) {
+                json payload = header("forget_batch");
+                json items = json::array();
+                for (const auto& id : batch.deletions) {
+                    items.push_back({{"key", DreamWriteBatch::forgetKey(id)}, {"memory_id", id}});
+                }
+                payload["memories"] = std::move(items);
+                ok = publish(g_config.q_forget, payload) && ok;
+            }
+
+            MCEE_LOG_DEBUG("MLT", "→ Lot #", batch.sequence, " (", batch.size(), " ops",
+                           ok ? "" : ", échec", ")");
+            return ok;
         });
         
         engine.setStateChangeCallback([](DreamState from, DreamState to) {
-            std::cout << "[Dream] " << dreamStateToString(from) 
-                      << " → " << dreamStateToString(to) << "\n";
+            MCEE_LOG_INFO("Dream", dreamStateToString(from), " → ", dreamStateToString(to));
         });
         
         // Lancer consumer
         std::thread consumer(consumerThread, std::ref(engine));
         
-        std::cout << "[Main] Module démarré. Ctrl+C pour arrêter.\n\n";
+        MCEE_LOG_INFO("Main", "Module démarré. Ctrl+C pour arrêter.");
         
         // Boucle principale
         int tick = 0;
@@ -432,7 +772,7 @@ int main(int argc, char* argv[]) {
                 status["state"] = dreamStateToString(engine.getCurrentState());
                 status["pattern"] = pattern;
                 status["cycle_progress"] = engine.getCycleProgress();
-                status["mct_size"] = engine.getMCTMemories().size();
+                status["mct_size"] = engine.getMCTSize();
                 status["causal_links"] = causalLinks.size();
                 status["stats"] = {
                     {"cycles", stats.totalCyclesCompleted},
@@ -450,10 +790,9 @@ int main(int argc, char* argv[]) {
 
                 publish(g_config.q_status, status);
 
-                std::cout << "[Status] " << dreamStateToString(engine.getCurrentState())
-                          << " | MCT: " << engine.getMCTMemories().size()
-                          << " | Causal: " << causalLinks.size()
-                          << " | Cycles: " << stats.totalCyclesCompleted << "\n";
+                MCEE_LOG_INFO("Status",
+                    dreamStateToString(engine.getCurrentState()), " | MCT: ", engine.getMCTSize(),
+                    " | Causal: ", causalLinks.size(), " | Cycles: ", stats.totalCyclesCompleted);
             }
             
             std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -463,15 +802,15 @@ int main(int argc, char* argv[]) {
         
         // Stats finales
         auto stats = engine.getStats();
-        std::cout << "\n[Stats] Cycles: " << stats.totalCyclesCompleted
-                  << " | Consolidés: " << stats.totalMemoriesConsolidated
-                  << " | Arêtes: " << stats.totalEdgesCreated << "\n";
+        MCEE_LOG_INFO("Stats",
+            "Cycles: ", stats.totalCyclesCompleted, " | Consolidés: ",
+            stats.totalMemoriesConsolidated, " | Arêtes: ", stats.totalEdgesCreated);
         
     } catch (const std::exception& e) {
-        std::cerr << "[Erreur] " << e.what() << "\n";
+        MCEE_LOG_ERROR("Erreur", e.what());
         return 1;
     }
     
-    std::cout << "[Main] Arrêté.\n";
+    MCEE_LOG_INFO("Main", "Arrêté.");
     return 0;
 }
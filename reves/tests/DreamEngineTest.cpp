@@ -15,6 +15,8 @@
 #include <vector>
 #include <atomic>
 #include <sstream>
+#include <algorithm>
+#include <tuple>
 
 using namespace MCEE;
 
@@ -151,6 +153,19 @@ void test_AddMultipleMemories() {
     ASSERT_EQ(engine.getMCTMemories().size(), 10u);
 }
 
+void test_AddMemoryBatch() {
+    DreamEngine engine;
+    engine.addMemoryToMCT(createTestMemory("mem_first"));
+    std::vector<Memory> batch;
+    for (int i = 0; i < 5; ++i) {
+        batch.push_back(createTestMemory("batch_" + std::to_string(i)));
+    }
+    engine.addMemoriesToMCT(batch);
+    ASSERT_EQ(engine.getMCTSize(), 6u);
+    ASSERT_EQ(engine.getMCTMemories()[0].id, "mem_first");
+    ASSERT_EQ(engine.getMCTMemories()[5].id, "batch_4");
+}
+
 void test_ClearMCT() {
     DreamEngine engine;
     engine.addMemoryToMCT(createTestMemory("mem_001"));
@@ -297,6 +312,72 @@ void test_CycleCountIncrement() {
     ASSERT_EQ(engine.getStats().totalCyclesCompleted, 1);
 }
 
+void test_BudgetedPhasesMatchSingleShot() {
+    // Phases découpées en tranches minuscules : même consolidation/oubli qu'en un bloc
+    auto runCycle = [](double budgetMs, size_t chunk) {
+        DreamConfig cfg = createFastConfig();
+        cfg.cyclePeriod_s = 0.0;
+        cfg.tickBudget_ms = budgetMs;
+        cfg.phaseChunkSize = chunk;
+        cfg.scanThreads = 3;
+        DreamEngine engine(cfg);
+
+        std::vector<std::string> consolidated, deleted;
+        engine.setNeo4jConsolidateCallback([&](const Memory& m) { consolidated.push_back(m.id); });
+        engine.setNeo4jDeleteCallback([&](const std::string& id) { deleted.push_back(id); });
+
+        for (int i = 0; i < 300; ++i) {
+            Memory m = createTestMemory("mem_" + std::to_string(i));
+            m.feedback = (i % 10) / 10.0;
+            m.usageCount = i % 5;
+            m.decisionalInfluence = 0.0;
+            engine.addMemoryToMCT(m);
+        }
+
+        auto emotions = createEmotionalVector(0.05);
+        engine.forceDreamStart();
+        int ticks = 0;
+        while (engine.getCurrentState() != DreamState::AWAKE && ticks < 100000) {
+            engine.update(emotions, "SERENITE", false);
+            ticks++;
+        }
+        std::sort(consolidated.begin(), consolidated.end());
+        std::sort(deleted.begin(), deleted.end());
+        return std::make_tuple(consolidated, deleted, ticks, engine.getMCTSize());
+    };
+
+    auto [c1, d1, ticks1, left1] = runCycle(0.0, 256);
+    auto [c2, d2, ticks2, left2] = runCycle(1e-6, 8);
+
+    ASSERT_TRUE(c1 == c2);
+    ASSERT_TRUE(d1 == d2);
+    ASSERT_GT(ticks2, ticks1);
+    ASSERT_EQ(left1, 0u);
+    ASSERT_EQ(left2, 0u);
+}
+
+void test_MemoriesAddedDuringDreamKept() {
+    DreamConfig cfg = createFastConfig();
+    cfg.cyclePeriod_s = 0.1;
+    DreamEngine engine(cfg);
+    engine.addMemoryToMCT(createTestMemory("mem_before"));
+
+    auto emotions = createEmotionalVector(0.05);
+    engine.forceDreamStart();
+    engine.update(emotions, "SERENITE", false);   // Scan du souvenir initial
+    engine.addMemoryToMCT(createTestMemory("mem_during"));
+
+    int maxIterations = 1000;
+    while (engine.getCurrentState() != DreamState::AWAKE && maxIterations-- > 0) {
+        engine.update(emotions, "SERENITE", false);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    ASSERT_EQ(engine.getCurrentState(), DreamState::AWAKE);
+    ASSERT_EQ(engine.getMCTSize(), 1u);
+    ASSERT_EQ(engine.getMCTMemories()[0].id, "mem_during");
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TESTS: CONSOLIDATION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -660,6 +741,202 @@ void test_TimeSinceLastDream() {
     ASSERT_GE(timeSince, 0.0);
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS: DELTAS MCTGRAPH
+// ═══════════════════════════════════════════════════════════════════════════
+
+CausalLink createCausalLink(const std::string& id, const std::string& wordId,
+                            const std::string& emotionId, double strength) {
+    CausalLink link;
+    link.id = id;
+    link.wordId = wordId;
+    link.emotionId = emotionId;
+    link.causalStrength = strength;
+    link.temporalDistanceMs = 100.0;
+    return link;
+}
+
+MCTGraphDelta createKeyframe() {
+    MCTGraphDelta keyframe;
+    keyframe.sequence = 1;
+    keyframe.keyframe = true;
+    keyframe.decayFactor = 0.5;
+    keyframe.words = {{"w1", "projet", "NOUN"}, {"w2", "retard", "NOUN"}};
+    keyframe.emotions = {{"e1", "Peur"}};
+    keyframe.causalLinks = {createCausalLink("c1", "w1", "e1", 0.8),
+                            createCausalLink("c2", "w2", "e1", 0.6)};
+    return keyframe;
+}
+
+void test_MCTGraphKeyframeResolvesLinks() {
+    DreamEngine engine;
+    ASSERT_TRUE(engine.applyMCTGraphDelta(createKeyframe()));
+
+    ASSERT_EQ(engine.getMCTGraphSequence(), 1u);
+    const auto& links = engine.getCausalLinks();
+    ASSERT_EQ(links.size(), 2u);
+    ASSERT_EQ(links[0].wordLemma, "projet");
+    ASSERT_EQ(links[0].dominantEmotion, "Peur");
+}
+
+void test_MCTGraphDeltaAppliesChanges() {
+    DreamEngine engine;
+    engine.applyMCTGraphDelta(createKeyframe());
+
+    MCTGraphDelta delta;
+    delta.sequence = 2;
+    delta.baseSequence = 1;
+    delta.decayEpoch = 1;                // Une époque : les liens non retransmis sont divisés par 2
+    delta.decayFactor = 0.5;
+    delta.words = {{"w3", "client", "NOUN"}};
+    delta.causalLinks = {createCausalLink("c3", "w3", "e1", 0.9)};
+    delta.removedEdgeIds = {"c1"};
+    delta.removedNodeIds = {"w1"};
+    ASSERT_TRUE(engine.applyMCTGraphDelta(delta));
+
+    const auto& links = engine.getCausalLinks();
+    ASSERT_EQ(links.size(), 2u);
+    for (const auto& link : links) {
+        ASSERT_TRUE(link.id != "c1");
+        if (link.id == "c2") ASSERT_NEAR(link.causalStrength, 0.3, 1e-9);
+        if (link.id == "c3") {
+            ASSERT_NEAR(link.causalStrength, 0.9, 1e-9);
+            ASSERT_EQ(link.wordLemma, "client");
+            ASSERT_EQ(link.dominantEmotion, "Peur");
+        }
+    }
+    ASSERT_EQ(engine.getMCTGraphSequence(), 2u);
+}
+
+void test_MCTGraphDeltaGapRejected() {
+    DreamEngine engine;
+    engine.applyMCTGraphDelta(createKeyframe());
+
+    MCTGraphDelta delta;
+    delta.sequence = 3;
+    delta.baseSequence = 2;              // Le delta 2 n'a pas été reçu
+    delta.removedEdgeIds = {"c1"};
+    ASSERT_FALSE(engine.applyMCTGraphDelta(delta));
+
+    ASSERT_EQ(engine.getCausalLinks().size(), 2u);
+    ASSERT_EQ(engine.getMCTGraphSequence(), 1u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// TESTS: ÉCRITURES NEO4J GROUPÉES
+// ═══════════════════════════════════════════════════════════════════════════
+
+void runDreamToAwake(DreamEngine& engine, int maxIterations = 1000) {
+    auto emotions = createEmotionalVector();
+    engine.forceDreamStart();
+    while (engine.getCurrentState() != DreamState::AWAKE && maxIterations-- > 0) {
+        engine.update(emotions, "SERENITE", false);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    // Livraison du lot de la dernière phase
+    engine.update(emotions, "SERENITE", false);
+}
+
+void test_BatchCallbackGroupsWrites() {
+    DreamConfig cfg = createFastConfig();
+    cfg.cyclePeriod_s = 0.1;
+    cfg.consolidationThreshold = 0.0;
+    DreamEngine engine(cfg);
+
+    int unitCalls = 0;
+    engine.setNeo4jConsolidateCallback([&](const Memory&) { unitCalls++; });
+    engine.setNeo4jDeleteCallback([&](const std::string&) { unitCalls++; });
+
+    std::vector<DreamWriteBatch> batches;
+    engine.setNeo4jBatchCallback([&](const DreamWriteBatch& batch) {
+        batches.push_back(batch);
+        return true;
+    });
+
+    for (int i = 0; i < 5; ++i) {
+        engine.addMemoryToMCT(createTestMemory("mem_" + std::to_string(i)));
+    }
+    runDreamToAwake(engine);
+
+    ASSERT_EQ(unitCalls, 0);
+    ASSERT_GE(batches.size(), 1u);
+    size_t consolidations = 0;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        ASSERT_FALSE(batches[i].empty());
+        ASSERT_EQ(batches[i].sequence, i + 1);
+        consolidations += batches[i].consolidations.size();
+    }
+    ASSERT_EQ(consolidations, 5u);
+    ASSERT_EQ(engine.getPendingWriteCount(), 0u);
+    ASSERT_EQ(engine.getStats().writeBatchesSent, static_cast<int>(batches.size()));
+}
+
+void test_FailedBatchRetriedWithSameSequence() {
+    DreamConfig cfg = createFastConfig();
+    cfg.cyclePeriod_s = 0.1;
+    cfg.consolidationThreshold = 0.0;
+    cfg.writeRetryBackoff_s = 0.0;
+    DreamEngine engine(cfg);
+
+    std::vector<uint64_t> attempts;
+    engine.setNeo4jBatchCallback([&](const DreamWriteBatch& batch) {
+        attempts.push_back(batch.sequence);
+        return attempts.size() > 2;          // Deux échecs puis succès
+    });
+
+    engine.addMemoryToMCT(createTestMemory("mem_001"));
+    runDreamToAwake(engine);
+
+    ASSERT_GE(attempts.size(), 3u);
+    ASSERT_EQ(attempts[0], attempts[1]);
+    ASSERT_EQ(attempts[1], attempts[2]);
+    auto stats = engine.getStats();
+    ASSERT_EQ(stats.writeBatchRetries, 2);
+    ASSERT_EQ(stats.writeBatchesDropped, 0);
+    ASSERT_EQ(stats.totalCyclesCompleted, 1);
+}
+
+void test_BatchDroppedAfterMaxRetries() {
+    DreamConfig cfg = createFastConfig();
+    cfg.cyclePeriod_s = 0.1;
+    cfg.consolidationThreshold = 0.0;
+    cfg.writeRetryBackoff_s = 0.0;
+    cfg.writeBatchMaxRetries = 2;
+    DreamEngine engine(cfg);
+
+    int calls = 0;
+    engine.setNeo4jBatchCallback([&](const DreamWriteBatch&) {
+        calls++;
+        return false;
+    });
+
+    engine.addMemoryToMCT(createTestMemory("mem_001"));
+    runDreamToAwake(engine);
+
+    auto stats = engine.getStats();
+    ASSERT_GE(stats.writeBatchesDropped, 1);
+    ASSERT_EQ(stats.writeBatchesSent, 0);
+    ASSERT_EQ(calls, stats.writeBatchesDropped * (cfg.writeBatchMaxRetries + 1));
+    ASSERT_EQ(engine.getCurrentState(), DreamState::AWAKE);
+}
+
+void test_WriteBatchIdempotencyKeys() {
+    Memory m = createTestMemory("mem_42");
+    MemoryEdge e;
+    e.sourceId = "a";
+    e.targetId = "b";
+    e.relationType = "stochastic";
+
+    ASSERT_EQ(DreamWriteBatch::consolidateKey(m), std::string("consolidate:mem_42"));
+    ASSERT_EQ(DreamWriteBatch::edgeKey(e), std::string("edge:stochastic:a>b"));
+    ASSERT_EQ(DreamWriteBatch::reinforceKey(e), std::string("reinforce:stochastic:a>b"));
+    ASSERT_EQ(DreamWriteBatch::forgetKey("mem_42"), std::string("forget:mem_42"));
+
+    // Le sens de l'arête fait partie de la clé
+    std::swap(e.sourceId, e.targetId);
+    ASSERT_EQ(DreamWriteBatch::edgeKey(e), std::string("edge:stochastic:b>a"));
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 // TESTS: THREAD SAFETY
 // ═══════════════════════════════════════════════════════════════════════════
@@ -738,6 +1015,7 @@ int main() {
     std::cout << "\n>> Gestion MCT\n";
     RUN_TEST(AddMemoryToMCT);
     RUN_TEST(AddMultipleMemories);
+    RUN_TEST(AddMemoryBatch);
     RUN_TEST(ClearMCT);
     RUN_TEST(MemoryTypes);
 
@@ -753,6 +1031,8 @@ int main() {
     RUN_TEST(CompleteDreamCycle);
     RUN_TEST(DreamPhaseProgression);
     RUN_TEST(CycleCountIncrement);
+    RUN_TEST(BudgetedPhasesMatchSingleShot);
+    RUN_TEST(MemoriesAddedDuringDreamKept);
 
     std::cout << "\n>> Consolidation\n";
     RUN_TEST(ConsolidationCallback);
@@ -791,6 +1071,17 @@ int main() {
     RUN_TEST(DreamPhaseProgressZeroWhenAwake);
     RUN_TEST(TimeSinceLastDream);
 
+    std::cout << "\n>> Deltas MCTGraph\n";
+    RUN_TEST(MCTGraphKeyframeResolvesLinks);
+    RUN_TEST(MCTGraphDeltaAppliesChanges);
+    RUN_TEST(MCTGraphDeltaGapRejected);
+
+    std::cout << "\n>> Ecritures Neo4j groupees\n";
+    RUN_TEST(BatchCallbackGroupsWrites);
+    RUN_TEST(FailedBatchRetriedWithSameSequence);
+    RUN_TEST(BatchDroppedAfterMaxRetries);
+    RUN_TEST(WriteBatchIdempotencyKeys);
+
     std::cout << "\n>> Thread Safety\n";
     RUN_TEST(ConcurrentAddMemories);
     RUN_TEST(ConcurrentStateQueries);